@@ -14,6 +14,7 @@ set(
   ${CMAKE_BINARY_DIR}/lib/core/include/irods_default_paths.hpp
   ${CMAKE_BINARY_DIR}/lib/core/include/irods_version.h
   ${CMAKE_BINARY_DIR}/lib/core/include/rodsVersion.h
+  ${CMAKE_BINARY_DIR}/lib/core/include/server_config_snapshot.hpp
   ${CMAKE_BINARY_DIR}/lib/core/include/server_control_plane_command.hpp
   )
 
@@ -33,6 +34,7 @@ set(
   ${CMAKE_SOURCE_DIR}/lib/core/include/entity.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/experimental_plugin_framework.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/fsckUtil.h
+  ${CMAKE_SOURCE_DIR}/lib/core/include/fsck_snapshot.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/future.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/getRodsEnv.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/getUtil.h
@@ -54,6 +56,7 @@ set(
   ${CMAKE_SOURCE_DIR}/lib/core/include/irods_client_server_negotiation.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/irods_configuration_keywords.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/irods_configuration_parser.hpp
+  ${CMAKE_SOURCE_DIR}/lib/core/include/irods_encrypted_frame_writer.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/irods_environment_properties.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/irods_error.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/irods_exception.hpp
@@ -149,6 +152,7 @@ set(
   ${CMAKE_SOURCE_DIR}/lib/core/include/rodsType.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/rodsUser.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/rsyncUtil.h
+  ${CMAKE_SOURCE_DIR}/lib/core/include/rsync_manifest.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/scanUtil.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/shared_memory_object.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/sockComm.h
@@ -158,6 +162,7 @@ set(
   ${CMAKE_SOURCE_DIR}/lib/core/include/stringOpr.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/termiosUtil.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/thread_pool.hpp
+  ${CMAKE_SOURCE_DIR}/lib/core/include/transfer_scheduler.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/trimUtil.h
   ${CMAKE_SOURCE_DIR}/lib/core/include/user.hpp
   ${CMAKE_SOURCE_DIR}/lib/core/include/user_administration.hpp
@@ -192,6 +197,7 @@ set(
   ${CMAKE_SOURCE_DIR}/lib/api/include/authenticate.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/bulkDataObjPut.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/bulkDataObjReg.h
+  ${CMAKE_SOURCE_DIR}/lib/api/include/catalog_export.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/chkNVPathPerm.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/chkObjPermAndStat.h
   ${CMAKE_SOURCE_DIR}/lib/api/include/client_hints.h
@@ -339,6 +345,7 @@ set(
   IRODS_SERVER_API_INCLUDE_HEADERS
   ${CMAKE_SOURCE_DIR}/server/api/include/rs_atomic_apply_acl_operations.hpp
   ${CMAKE_SOURCE_DIR}/server/api/include/rs_atomic_apply_metadata_operations.hpp
+  ${CMAKE_SOURCE_DIR}/server/api/include/rs_catalog_export.hpp
   ${CMAKE_SOURCE_DIR}/server/api/include/rs_get_file_descriptor_info.hpp
   ${CMAKE_SOURCE_DIR}/server/api/include/rs_replica_open.hpp
   ${CMAKE_SOURCE_DIR}/server/api/include/rs_replica_close.hpp
@@ -486,9 +493,18 @@ set(
   ${CMAKE_SOURCE_DIR}/server/core/include/dataObjOpr.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/replica_access_table.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/replica_state_table.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/server_load_table.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/agent_registry.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/resource_hierarchy.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/resource_hierarchy_cache.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/access_verdict_cache.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/inline_checksum_table.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/local_file_copy.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/directory_scanner.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/fileOpr.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/finalize_utilities.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/initServer.hpp
+  ${CMAKE_SOURCE_DIR}/server/core/include/pam_auth_helper.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/irodsReServer.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/irods_api_calling_functions.hpp
   ${CMAKE_SOURCE_DIR}/server/core/include/irods_collection_object.hpp
@@ -655,6 +671,7 @@ install(
   DESTINATION ${CMAKE_INSTALL_INCLUDEDIR}/irods/transport
   COMPONENT ${IRODS_PACKAGE_COMPONENT_DEVELOPMENT_NAME}
   FILES_MATCHING
+    PATTERN */transport/async_transport.hpp
     PATTERN */transport/transport.hpp
     PATTERN */transport/default_transport.hpp
   )
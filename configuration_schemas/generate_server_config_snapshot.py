@@ -0,0 +1,140 @@
+from __future__ import print_function
+
+import json
+import os
+import re
+import sys
+
+# Generates the irods::server_config_snapshot struct from the server_config.json
+# schema. Every scalar property of the schema becomes a member of the struct,
+# and every object property with "properties" becomes a nested struct. Arrays,
+# maps, and references to other schemas are not part of the snapshot.
+
+CPP_TYPES = {
+    'boolean': 'bool',
+    'integer': 'int',
+    'number': 'double',
+    'string': 'std::string',
+}
+
+IDENTIFIER = re.compile(r'^[A-Za-z_][A-Za-z0-9_]*$')
+
+def cpp_type(property_schema):
+    if property_schema.get('type') in CPP_TYPES:
+        return CPP_TYPES[property_schema['type']]
+    if 'type' not in property_schema and property_schema.get('enum'):
+        if all(isinstance(v, type(u'')) or isinstance(v, str) for v in property_schema['enum']):
+            return 'std::string'
+    return None
+
+def members(object_schema, key_path):
+    result = []
+    for name in sorted(object_schema.get('properties', {})):
+        if not IDENTIFIER.match(name):
+            continue
+        property_schema = object_schema['properties'][name]
+        if property_schema.get('type') == 'object' and 'properties' in property_schema:
+            nested = members(property_schema, key_path + [name])
+            if nested:
+                result.append(('struct', name, nested))
+            continue
+        type_name = cpp_type(property_schema)
+        if type_name:
+            result.append(('value', name, (type_name, key_path + [name])))
+    return result
+
+def declarations(member_list, indent):
+    lines = []
+    for kind, name, detail in member_list:
+        if kind == 'struct':
+            lines.append('{0}struct {1}_type'.format(indent, name))
+            lines.append('{0}{{'.format(indent))
+            lines.extend(declarations(detail, indent + '    '))
+            lines.append('{0}}} {1};'.format(indent, name))
+            lines.append('')
+        else:
+            lines.append('{0}configuration_value<{1}> {2};'.format(indent, detail[0], name))
+    while lines and not lines[-1]:
+        lines.pop()
+    return lines
+
+def assignments(member_list, prefix, indent):
+    lines = []
+    for kind, name, detail in member_list:
+        if kind == 'struct':
+            lines.extend(assignments(detail, prefix + name + '.', indent))
+        else:
+            keys = ', '.join('"{0}"'.format(k) for k in detail[1])
+            lines.append('{0}snapshot.{1}{2} = configuration_value<{3}>::read(_parser, {{{4}}});'.format(
+                indent, prefix, name, detail[0], keys))
+    return lines
+
+def generate(schema_file):
+    with open(schema_file) as f:
+        schema = json.load(f)
+
+    member_list = members(schema, [])
+
+    lines = [
+        '// Generated from {0} by generate_server_config_snapshot.py. Do not edit.'.format(os.path.basename(schema_file)),
+        '',
+        '#ifndef IRODS_SERVER_CONFIG_SNAPSHOT_HPP',
+        '#define IRODS_SERVER_CONFIG_SNAPSHOT_HPP',
+        '',
+        '#include "irods_configuration_parser.hpp"',
+        '',
+        '#include <string>',
+        '',
+        'namespace irods',
+        '{',
+        '    /// An immutable, strongly typed copy of the server configuration.',
+        '    ///',
+        '    /// Members mirror the properties of server_config.json. Reading a member does',
+        '    /// not search the property map, but get() reports a missing or mistyped',
+        '    /// property with the same error as configuration_parser::get().',
+        '    ///',
+        '    /// \\since 4.3.0',
+        '    struct server_config_snapshot',
+        '    {',
+    ]
+    lines.extend(declarations(member_list, ' ' * 8))
+    lines.extend([
+        '',
+        '        /// Reads every member of the snapshot from \\p _parser.',
+        '        static auto read(configuration_parser& _parser) -> server_config_snapshot',
+        '        {',
+        '            server_config_snapshot snapshot;',
+    ])
+    lines.extend(assignments(member_list, '', ' ' * 12))
+    lines.extend([
+        '            return snapshot;',
+        '        } // read',
+        '    }; // struct server_config_snapshot',
+        '} // namespace irods',
+        '',
+        '#endif // IRODS_SERVER_CONFIG_SNAPSHOT_HPP',
+        '',
+    ])
+    return '\n'.join(lines)
+
+def main(schema_file, output_file):
+    content = generate(schema_file)
+
+    # Leave the header untouched when nothing changed so dependent sources are not rebuilt.
+    if os.path.exists(output_file):
+        with open(output_file) as f:
+            if f.read() == content:
+                return
+
+    output_directory = os.path.dirname(output_file)
+    if output_directory and not os.path.isdir(output_directory):
+        os.makedirs(output_directory)
+
+    with open(output_file, 'w') as f:
+        f.write(content)
+
+if __name__ == '__main__':
+    if len(sys.argv) != 3:
+        print('Call as {0} <server_config.json schema> <output header>'.format(sys.argv[0]), file=sys.stderr)
+        sys.exit(1)
+    main(os.path.normpath(sys.argv[1]), os.path.normpath(sys.argv[2]))
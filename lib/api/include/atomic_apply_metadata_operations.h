@@ -9,11 +9,11 @@ struct RcComm;
 extern "C" {
 #endif
 
-/// Executes a list of metadata operations on a single object atomically.
+/// Executes a list of metadata operations on one or more objects atomically.
 ///
-/// Sequentially executes all \p operations on \p entity_name as a single transaction. If an
-/// error occurs, all updates are rolled back and an error is returned. \p json_output will
-/// contain specific information about the error.
+/// Executes all \p operations on \p entity_name as a single transaction. If an error occurs,
+/// all updates are rolled back and an error is returned. \p json_output will contain specific
+/// information about the error.
 ///
 /// \p json_input must have the following JSON structure:
 /// \code{.js}
@@ -43,8 +43,9 @@ extern "C" {
 /// - resource
 /// - user
 ///
-/// \p operations is the list of metadata operations to execute atomically. They will be
-/// executed in order.
+/// \p operations is the list of metadata operations to execute atomically. The result is
+/// the same as executing them in order. All operations are validated before any of them is
+/// applied, and operations of the same kind are applied together.
 ///
 /// \p operation must be one of the following:
 /// - add
@@ -52,6 +53,20 @@ extern "C" {
 ///
 /// \p units are optional.
 ///
+/// Metadata on many objects can be updated in a single transaction by listing them under
+/// "entities" instead:
+/// \code{.js}
+/// {
+///   "entities": [
+///     {
+///       "entity_name": string,
+///       "entity_type": string,
+///       "operations": [ ... ]
+///     }
+///   ]
+/// }
+/// \endcode
+///
 /// On error, \p json_output will have the following JSON structure:
 /// \code{.js}
 /// {
@@ -61,6 +76,9 @@ extern "C" {
 /// }
 /// \endcode
 ///
+/// Errors for requests using "entities" also contain an "entity_index" property identifying
+/// the entity the error relates to.
+///
 /// \param[in]  _comm        A pointer to a RcComm.
 /// \param[in]  _json_input  A JSON string containing the batch of metadata operations.
 /// \param[out] _json_output A JSON string containing the error information on failure.
@@ -0,0 +1,85 @@
+#ifndef IRODS_CATALOG_EXPORT_H
+#define IRODS_CATALOG_EXPORT_H
+
+/// \file
+
+struct RcComm;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Writes a consistent snapshot of catalog tables to a columnar zip archive.
+///
+/// The file is written by the catalog service provider, to a path on its local filesystem.
+/// All tables are read from the same snapshot of the database. On PostgreSQL, the tables are
+/// read in parallel through server-side cursors. Other databases read the tables one after
+/// the other. MySQL Connector/ODBC holds the whole result of each table in memory unless the
+/// data source sets NO_CACHE=1. Requires rodsadmin level privileges.
+///
+/// The zip archive holds a \p manifest.json describing the tables, their columns and row
+/// counts, and one entry per column of every row group, named
+/// \p <table>/<row_group>/<column>.gz. Each column entry is compressed on its own with gzip.
+/// The central directory of the archive lists every entry, so a reader can open the entries
+/// of the columns it needs without reading the others. Once decompressed, a column entry is a
+/// sequence of values, each a 32-bit little-endian length followed by that many bytes. A
+/// length of 0xFFFFFFFF denotes NULL.
+///
+/// \p json_input must have the following JSON structure:
+/// \code{.js}
+/// {
+///   "output_path": string,
+///   "tables": [string],
+///   "number_of_threads": integer,
+///   "rows_per_row_group": integer,
+///   "overwrite": boolean
+/// }
+/// \endcode
+///
+/// \p output_path must be an absolute path on the catalog service provider.
+///
+/// \p tables is optional. It defaults to all supported tables: R_COLL_MAIN, R_DATA_MAIN,
+/// R_META_MAIN, R_OBJT_METAMAP and R_OBJT_ACCESS.
+///
+/// \p number_of_threads is optional. It defaults to the number of tables.
+///
+/// \p rows_per_row_group is optional. It defaults to 65536.
+///
+/// \p overwrite is optional. It defaults to false.
+///
+/// On success, \p json_output will have the following JSON structure:
+/// \code{.js}
+/// {
+///   "output_path": string,
+///   "tables": {
+///     "<table>": {"rows": integer}
+///   },
+///   "rows": integer,
+///   "seconds": number,
+///   "rows_per_second": number
+/// }
+/// \endcode
+///
+/// On error, \p json_output will have the following JSON structure:
+/// \code{.js}
+/// {
+///   "error_message": string
+/// }
+/// \endcode
+///
+/// \param[in]  _comm        A pointer to a RcComm.
+/// \param[in]  _json_input  A JSON string describing the export.
+/// \param[out] _json_output A JSON string describing the result.
+///
+/// \return An integer.
+/// \retval 0        On success.
+/// \retval non-zero On failure.
+///
+/// \since 4.3.0
+int rc_catalog_export(struct RcComm* _comm, const char* _json_input, char** _json_output);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // IRODS_CATALOG_EXPORT_H
@@ -195,6 +195,7 @@ typedef struct PortalOpr {
 /* definition for flags */
 #define STREAMING_FLAG          0x1
 #define NO_CHK_COPY_LEN_FLAG    0x2
+#define KERNEL_COPY_FLAG        0x4     /* server only - copy between local files in the kernel */
 
 typedef struct TransferHeader {
     int oprType;
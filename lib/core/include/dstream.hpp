@@ -6,7 +6,7 @@
 
 #include <streambuf>
 #include <type_traits>
-#include <array>
+#include <vector>
 #include <string>
 #include <stdexcept>
 #include <algorithm>
@@ -40,7 +40,7 @@ namespace irods::experimental::io
         using base_type = std::basic_streambuf<CharT, Traits>;
 
         // clang-format off
-        inline static constexpr auto buffer_size          = 4096;
+        inline static constexpr auto default_buffer_size  = 4096;
 
         // Errors
         inline static constexpr auto external_write_error = -1;
@@ -50,7 +50,9 @@ namespace irods::experimental::io
     public:
         basic_data_object_buf()
             : base_type{}
-            , buf_{}
+            , owned_buf_(default_buffer_size)
+            , buf_{owned_buf_.data()}
+            , buf_size_{default_buffer_size}
             , transport_{}
         {
         }
@@ -79,7 +81,9 @@ namespace irods::experimental::io
 
             base_type::swap(_other);
             swap(transport_, _other.transport_);
+            swap(owned_buf_, _other.owned_buf_);
             swap(buf_, _other.buf_);
+            swap(buf_size_, _other.buf_size_);
         }
 
         friend void swap(basic_data_object_buf& _lhs, basic_data_object_buf& _rhs)
@@ -247,14 +251,13 @@ namespace irods::experimental::io
             // The "Get" area has been consumed. Fill the internal buffer with
             // new data from the data object.
 
-            const auto bytes_read = transport_->receive(buf_.data(), buf_.size() * sizeof(char_type));
+            const auto bytes_read = transport_->receive(buf_, buf_size_ * sizeof(char_type));
 
             if (bytes_read <= 0) {
                 return traits_type::eof();
             }
 
-            auto* pbase = buf_.data();
-            this->setg(pbase, pbase, pbase + bytes_read);
+            this->setg(buf_, buf_, buf_ + bytes_read);
 
             return traits_type::to_int_type(*this->gptr());
         }
@@ -278,29 +281,106 @@ namespace irods::experimental::io
         {
             prepare_for_input();
 
-            const auto bytes_to_copy = this->egptr() - this->gptr(); 
+            std::streamsize bytes_copied = 0;
+
+            while (bytes_copied < _buffer_size) {
+                const auto bytes_remaining = _buffer_size - bytes_copied;
+
+                // If there are bytes in the internal buffer that haven't been consumed,
+                // then copy those bytes from the internal buffer into "_buffer".
+                if (const auto bytes_available = this->egptr() - this->gptr(); bytes_available > 0) {
+                    const auto bytes_to_copy = std::min<std::streamsize>(bytes_available, bytes_remaining);
+                    std::memcpy(_buffer + bytes_copied, this->gptr(), bytes_to_copy * sizeof(char_type));
+                    this->gbump(static_cast<int>(bytes_to_copy));
+                    bytes_copied += bytes_to_copy;
+                    continue;
+                }
+
+                // Requests that would not fit in the internal buffer bypass it.
+                if (bytes_remaining >= buf_size_) {
+                    const auto bytes_read = transport_->receive(_buffer + bytes_copied, bytes_remaining * sizeof(char_type));
+
+                    if (bytes_read > 0) {
+                        bytes_copied += bytes_read;
+                    }
+
+                    break;
+                }
 
-            // If there are bytes in the internal buffer that haven't been consumed,
-            // then copy those bytes from the internal buffer into "_buffer".
-            if (bytes_to_copy > 0) {
-                std::memcpy(_buffer, this->gptr(), bytes_to_copy * sizeof(char_type));
-                this->gbump(bytes_to_copy);
+                if (traits_type::eq_int_type(underflow(), traits_type::eof())) {
+                    break;
+                }
             }
 
-            return transport_->receive(_buffer + bytes_to_copy, (_buffer_size - bytes_to_copy) * sizeof(char_type));
+            return bytes_copied;
         }
 
         std::streamsize xsputn(const char_type* _buffer, std::streamsize _buffer_size) override
         {
             prepare_for_output();
 
+            // Gather small writes in the "Put" area so that they reach the server together.
+            if (_buffer_size <= this->epptr() - this->pptr()) {
+                std::memcpy(this->pptr(), _buffer, _buffer_size * sizeof(char_type));
+                this->pbump(static_cast<int>(_buffer_size));
+                return _buffer_size;
+            }
+
             if (flush_buffer() == external_write_error) {
                 return external_write_error;
             }
 
+            if (_buffer_size < buf_size_) {
+                std::memcpy(this->pptr(), _buffer, _buffer_size * sizeof(char_type));
+                this->pbump(static_cast<int>(_buffer_size));
+                return _buffer_size;
+            }
+
             return transport_->send(_buffer, _buffer_size * sizeof(char_type));
         }
 
+        // Replaces the internal buffer with the one provided.
+        //
+        // If "_buffer" is null, a buffer holding "_buffer_size" characters is allocated and
+        // owned by this object. Larger buffers reduce the number of requests sent to the server.
+        // Pending output is written and unread input is discarded before the buffer is replaced.
+        base_type* setbuf(char_type* _buffer, std::streamsize _buffer_size) override
+        {
+            if (_buffer_size <= 0) {
+                return nullptr;
+            }
+
+            const bool input_mode = this->gptr();
+            const bool output_mode = this->pptr();
+
+            if (this->sync() != 0 || !discard_unread_input()) {
+                return nullptr;
+            }
+
+            if (_buffer) {
+                std::vector<char_type>{}.swap(owned_buf_);
+                buf_ = _buffer;
+            }
+            else {
+                std::vector<char_type>(_buffer_size).swap(owned_buf_);
+                buf_ = owned_buf_.data();
+            }
+
+            buf_size_ = _buffer_size;
+
+            this->setg(nullptr, nullptr, nullptr);
+            this->setp(nullptr, nullptr);
+
+            if (input_mode) {
+                prepare_for_input();
+            }
+            else if (output_mode) {
+                prepare_for_output();
+            }
+
+            return this;
+        }
+
         int sync() override
         {
             if (this->pptr()) {
@@ -338,6 +418,16 @@ namespace irods::experimental::io
                 return seek_error;
             }
 
+            // The transport is ahead of the stream by the number of bytes in
+            // the "Get" area that have not been consumed.
+            if (this->gptr()) {
+                if (std::ios_base::cur == _dir) {
+                    _off -= this->egptr() - this->gptr();
+                }
+
+                this->setg(buf_, buf_, buf_);
+            }
+
             return transport_->seekpos(_off, _dir);
         }
 
@@ -347,6 +437,10 @@ namespace irods::experimental::io
                 return seek_error;
             }
 
+            if (this->gptr()) {
+                this->setg(buf_, buf_, buf_);
+            }
+
             return transport_->seekpos(_pos, std::ios_base::beg);
         }
 
@@ -363,8 +457,7 @@ namespace irods::experimental::io
             this->setp(nullptr, nullptr);
 
             // Setup the "Get" area.
-            auto* pbase = buf_.data();
-            this->setg(pbase, pbase, pbase);
+            this->setg(buf_, buf_, buf_);
         }
 
         void prepare_for_output()
@@ -374,12 +467,25 @@ namespace irods::experimental::io
                 return;
             }
 
-            // Clear the contents of the "Get" area.
+            // Clear the contents of the "Get" area. Writing must begin where
+            // reading stopped, not where the transport stopped.
+            discard_unread_input();
             this->setg(nullptr, nullptr, nullptr);
 
             // Setup the "Put" area.
-            auto* pbase = buf_.data();
-            this->setp(pbase, pbase + buf_.size());
+            this->setp(buf_, buf_ + buf_size_);
+        }
+
+        bool discard_unread_input()
+        {
+            if (!this->gptr() || this->gptr() == this->egptr()) {
+                return true;
+            }
+
+            const auto bytes_unread = this->egptr() - this->gptr();
+            this->setg(buf_, buf_, buf_);
+
+            return transport_->seekpos(-bytes_unread, std::ios_base::cur) != seek_error;
         }
 
         void init_get_or_put_area(std::ios_base::openmode _mode) noexcept
@@ -404,7 +510,7 @@ namespace irods::experimental::io
                 return 0;
             }
 
-            const auto bytes_written = transport_->send(buf_.data(), bytes_to_send * sizeof(char_type));
+            const auto bytes_written = transport_->send(buf_, bytes_to_send * sizeof(char_type));
 
             if (bytes_written < 0) {
                 return external_write_error;
@@ -415,7 +521,9 @@ namespace irods::experimental::io
             return 0;
         }
 
-        std::array<char_type, buffer_size> buf_;
+        std::vector<char_type> owned_buf_;
+        char_type* buf_;
+        std::streamsize buf_size_;
         transport<char_type>* transport_;
     }; // basic_data_object_buf
 
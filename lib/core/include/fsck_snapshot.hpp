@@ -0,0 +1,142 @@
+#ifndef IRODS_FSCK_SNAPSHOT_HPP
+#define IRODS_FSCK_SNAPSHOT_HPP
+
+/// \file
+
+#include "fsckUtil.h"
+#include "rcConnect.h"
+#include "rodsType.h"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace irods::experimental::fsck
+{
+    /// What the catalog knows about a replica stored at a physical path.
+    struct replica
+    {
+        std::string logical_path;
+        rodsLong_t size;
+        std::string checksum;
+    }; // struct replica
+
+    /// The replicas stored under a vault directory, keyed by physical path.
+    using snapshot = std::unordered_map<std::string, replica>;
+
+    /// Fetches every replica stored under \p _dir in batches of paged GenQuery results.
+    ///
+    /// The query is built by \p _strategy for \p _dir, so it selects the same replicas
+    /// the per-file check would (e.g. only those on the local host), and its condition on
+    /// DATA_PATH is then replaced with a prefix match.
+    ///
+    /// \param[in] _conn      The connection to the catalog.
+    /// \param[in] _dir       The vault directory, without a trailing slash.
+    /// \param[in] _recursive Whether to include replicas in subdirectories.
+    /// \param[in] _strategy  The function that builds the per-file query.
+    /// \param[in] _argument  The argument passed to \p _strategy.
+    ///
+    /// \throws irods::exception If \p _strategy does not produce a DATA_PATH condition or
+    ///                          a query fails.
+    ///
+    /// \since 4.3.0
+    auto fetch_snapshot(rcComm_t& _conn,
+                        const std::string& _dir,
+                        bool _recursive,
+                        SetGenQueryInpFromPhysicalPath _strategy,
+                        const char* _argument) -> snapshot;
+
+    /// A regular file found by walking a vault directory.
+    struct local_file
+    {
+        std::string path;
+        rodsLong_t size;
+        std::int64_t mtime;
+    }; // struct local_file
+
+    /// The result of walking a vault directory.
+    struct walk_result
+    {
+        /// Regular files, sorted by path.
+        std::vector<local_file> files;
+
+        /// Directories whose entries were all listed, sorted.
+        std::vector<std::string> directories;
+
+        /// Entries that were not checked (e.g. symbolic links), sorted.
+        std::vector<std::string> skipped;
+
+        /// Directories that could not be listed and the error, sorted by path.
+        std::vector<std::pair<std::string, int>> errors;
+    }; // struct walk_result
+
+    /// Walks \p _dir using up to \p _threads threads. Symbolic links are not followed.
+    ///
+    /// \since 4.3.0
+    auto walk(const std::string& _dir, bool _recursive, int _threads) -> walk_result;
+
+    /// Limits the rate at which files are read. Each file is accounted for in full
+    /// before it is read.
+    ///
+    /// \since 4.3.0
+    class throttle
+    {
+    public:
+        /// \param[in] _bytes_per_second The maximum average rate. Zero means unlimited.
+        explicit throttle(rodsLong_t _bytes_per_second);
+
+        /// Blocks until \p _size more bytes may be read.
+        auto acquire(rodsLong_t _size) -> void;
+
+    private:
+        rodsLong_t bytes_per_second_;
+        std::mutex mutex_;
+        std::chrono::steady_clock::time_point next_start_;
+    }; // class throttle
+
+    /// The outcome of checking one physical path.
+    struct record
+    {
+        rodsLong_t size;
+        std::int64_t mtime;
+
+        /// The catalog checksum the file was verified against, if any.
+        std::string checksum;
+
+        /// One of "ok", "not_registered", "size_mismatch", "checksum_mismatch",
+        /// "no_checksum", "missing" or "error".
+        std::string status;
+    }; // struct record
+
+    /// A machine-readable record of the outcome of each check, stored as one JSON object
+    /// per line. Files whose size and modification time have not changed since they were
+    /// verified against the same catalog checksum need not be hashed again.
+    ///
+    /// \since 4.3.0
+    class state_file
+    {
+    public:
+        /// Loads \p _path if it exists. Malformed lines are ignored.
+        explicit state_file(std::string _path);
+
+        /// Returns whether \p _path was verified against \p _checksum and has not changed.
+        auto verified(const std::string& _path, const local_file& _file, const std::string& _checksum) const -> bool;
+
+        auto update(const std::string& _path, record _record) -> void;
+
+        /// Writes all records, replacing the file atomically.
+        ///
+        /// \return Zero or an iRODS error code.
+        auto save() const -> int;
+
+    private:
+        std::string path_;
+        std::map<std::string, record> records_;
+    }; // class state_file
+} // namespace irods::experimental::fsck
+
+#endif // IRODS_FSCK_SNAPSHOT_HPP
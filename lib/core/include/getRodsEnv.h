@@ -52,6 +52,12 @@ typedef struct RodsEnvironment {
     int irodsDefaultNumberTransferThreads;
     int irodsTransBufferSizeForParaTrans;
     int irodsConnectionPoolRefreshTime;
+    int irodsParallelTransferFiles;
+    int irodsTransferThreadBudget;
+    int irodsMaxBandwidthForTransfer;
+    int irodsFsckThreads;
+    int irodsFsckMaxReadBandwidth;
+    char irodsFsckStateFile[MAX_NAME_LEN];
 
     // =-=-=-=-=-=-=-
     // override of plugin installation directory
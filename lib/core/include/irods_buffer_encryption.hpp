@@ -16,12 +16,24 @@
 // ssl includes
 #include <openssl/evp.h>
 
+#include <cstdint>
+#include <memory>
+
 namespace irods {
 
 /// =-=-=-=-=-=-=-
 /// @brief functor which manages buffer encryption
 ///        used for parallel transfers.  based on
 ///        SSL EVP library
+///
+///        an instance reuses one cipher context for all
+///        of its buffers, so each transfer thread should
+///        own its own instance.
+///
+///        AEAD algorithms (e.g. aes-256-gcm and
+///        chacha20-poly1305) append an authentication tag
+///        to the cipher text and use a counter based nonce
+///        in place of a random initialization vector.
     class buffer_crypt {
 
         public:
@@ -29,6 +41,10 @@ namespace irods {
             // typedef for bounded array
             typedef std::vector< unsigned char > array_t;
 
+            // =-=-=-=-=-=-=-
+            // size of the tag appended by AEAD algorithms
+            static const int aead_tag_size = 16;
+
             // =-=-=-=-=-=-=-
             // con/de structors
             buffer_crypt();
@@ -37,6 +53,8 @@ namespace irods {
                 int,           // salt size in bytes
                 int,           // num hash rounds
                 const char* ); // algorithm
+            buffer_crypt( const buffer_crypt& );
+            buffer_crypt& operator=( const buffer_crypt& );
             ~buffer_crypt();
 
             /// =-=-=-=-=-=-=-
@@ -47,6 +65,15 @@ namespace irods {
                 const array_t&, // plaintext buffer
                 array_t& );     // encrypted buffer
 
+            /// =-=-=-=-=-=-=-
+            /// @brief given a buffer, encrypt it
+            irods::error encrypt(
+                const array_t&,       // key
+                const array_t&,       // initialization vector
+                const unsigned char*, // plaintext buffer
+                int,                  // plaintext length
+                array_t& );           // encrypted buffer
+
             /// =-=-=-=-=-=-=-
             /// @brief given a string, decrypt it
             irods::error decrypt(
@@ -56,10 +83,18 @@ namespace irods {
                 array_t& );     // plaintext buffer
 
             /// =-=-=-=-=-=-=-
-            /// @brief given a key, create a hashed key and IV
+            /// @brief create an initialization vector of key_size()
+            ///        bytes for the next buffer.  for AEAD algorithms
+            ///        the leading bytes hold a nonce which is never
+            ///        repeated by this instance
             irods::error initialization_vector(
                 array_t& );     // initialization vector
 
+            /// =-=-=-=-=-=-=-
+            /// @brief true if the algorithm authenticates the
+            ///        cipher text
+            bool is_aead();
+
             /// =-=-=-=-=-=-=-
             /// @brief generate a random byte key
             static irods::error generate_key(
@@ -90,6 +125,21 @@ namespace irods {
             static std::string gen_hash( unsigned char*, int );
 
         private:
+            struct context_deleter {
+                void operator()( EVP_CIPHER_CTX* _ctx ) const {
+                    EVP_CIPHER_CTX_free( _ctx );
+                }
+            };
+
+            // =-=-=-=-=-=-=-
+            // resolve the cipher and prepare the context for
+            // the next buffer
+            const EVP_CIPHER* cipher();
+            irods::error init_context(
+                const array_t&, // key
+                const array_t&, // initialization vector
+                int );          // 1 to encrypt, 0 to decrypt
+
             // =-=-=-=-=-=-=-
             // attributes
             int         key_size_;
@@ -97,6 +147,13 @@ namespace irods {
             int         num_hash_rounds_;
             std::string algorithm_;
 
+            // =-=-=-=-=-=-=-
+            // reusable cipher state, not copied
+            const EVP_CIPHER* cipher_;
+            std::unique_ptr< EVP_CIPHER_CTX, context_deleter > context_;
+            array_t       nonce_prefix_;
+            std::uint32_t nonce_counter_;
+
     }; // class buffer_crypt
 
 }; // namespace irods
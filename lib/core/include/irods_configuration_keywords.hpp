@@ -12,6 +12,7 @@ namespace irods
     extern const std::string CFG_PAM_NO_EXTEND_KW;
     extern const std::string CFG_PAM_PASSWORD_MIN_TIME_KW;
     extern const std::string CFG_PAM_PASSWORD_MAX_TIME_KW;
+    extern const std::string CFG_PAM_HELPER_WORKER_COUNT_KW;
 
     extern const std::string CFG_DB_USERNAME_KW;
     extern const std::string CFG_DB_PASSWORD_KW;
@@ -64,6 +65,10 @@ namespace irods
     extern const std::string CFG_MAX_TEMP_PASSWORD_LIFETIME;
     extern const std::string CFG_MAX_NUMBER_OF_CONCURRENT_RE_PROCS;
     extern const std::string DEFAULT_LOG_ROTATION_IN_DAYS;
+    extern const std::string CFG_BULK_DELETE_BATCH_SIZE;
+    extern const std::string CFG_BULK_DELETE_NUMBER_OF_THREADS;
+    extern const std::string CFG_BULK_REGISTRATION_BATCH_SIZE;
+    extern const std::string CFG_BULK_REGISTRATION_NUMBER_OF_THREADS;
 
     extern const std::string CFG_RE_CACHE_SALT_KW;
     extern const std::string CFG_RE_SERVER_SLEEP_TIME;
@@ -71,9 +76,16 @@ namespace irods
 
     extern const std::string CFG_DNS_CACHE_KW;
     extern const std::string CFG_HOSTNAME_CACHE_KW;
+    extern const std::string CFG_SERVER_LOAD_TABLE_KW;
+    extern const std::string CFG_RESOURCE_HIERARCHY_CACHE_KW;
+    extern const std::string CFG_ACCESS_VERDICT_CACHE_KW;
 
     extern const std::string CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW;
     extern const std::string CFG_EVICTION_AGE_IN_SECONDS_KW;
+    extern const std::string CFG_SAMPLE_INTERVAL_IN_SECONDS_KW;
+    extern const std::string CFG_REFRESH_INTERVAL_IN_SECONDS_KW;
+    extern const std::string CFG_TIME_TO_LIVE_IN_SECONDS_KW;
+    extern const std::string CFG_MAXIMUM_ENTRIES_PER_AGENT_KW;
 
     // service_account_environment.json keywords
     extern const std::string CFG_IRODS_USER_NAME_KW;
@@ -113,6 +125,12 @@ namespace irods
     extern const std::string CFG_IRODS_MAX_NUMBER_TRANSFER_THREADS;
     extern const std::string CFG_IRODS_TRANS_BUFFER_SIZE_FOR_PARA_TRANS;
     extern const std::string CFG_IRODS_CONNECTION_POOL_REFRESH_TIME;
+    extern const std::string CFG_IRODS_PARALLEL_TRANSFER_FILES;
+    extern const std::string CFG_IRODS_TRANSFER_THREAD_BUDGET;
+    extern const std::string CFG_IRODS_MAX_BANDWIDTH_FOR_TRANSFER;
+    extern const std::string CFG_IRODS_FSCK_THREADS;
+    extern const std::string CFG_IRODS_FSCK_MAX_READ_BANDWIDTH;
+    extern const std::string CFG_IRODS_FSCK_STATE_FILE;
 
     // legacy ssl environment variables
     extern const std::string CFG_IRODS_SSL_CA_CERTIFICATE_PATH;
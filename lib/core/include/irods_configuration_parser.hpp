@@ -10,6 +10,7 @@
 #include <vector>
 #include <string>
 #include <string_view>
+#include <optional>
 
 #include <unordered_map>
 #include <boost/format.hpp>
@@ -148,6 +149,60 @@ namespace irods {
 
     }; // class configuration_parser
 
+    /// A value read from a configuration_parser ahead of time.
+    ///
+    /// Holds either the value or the exception thrown while reading it, so get() reports
+    /// a missing or mistyped key exactly as configuration_parser::get() would have.
+    ///
+    /// \since 4.3.0
+    template <typename T>
+    class configuration_value
+    {
+    public:
+        /// Reads the value at \p _keys from \p _parser.
+        static auto read(configuration_parser& _parser, const configuration_parser::key_path_t& _keys) -> configuration_value
+        {
+            configuration_value value;
+
+            try {
+                value.value_ = _parser.get<T>(_keys);
+            }
+            catch (const irods::exception& e) {
+                value.error_.emplace(e);
+            }
+
+            return value;
+        } // read
+
+        auto has_value() const noexcept -> bool
+        {
+            return value_.has_value();
+        } // has_value
+
+        /// Returns the value, or throws the exception raised while reading it.
+        auto get() const -> const T&
+        {
+            if (!value_) {
+                if (error_) {
+                    throw *error_;
+                }
+
+                THROW(KEY_NOT_FOUND, "configuration value was never read");
+            }
+
+            return *value_;
+        } // get
+
+        auto value_or(const T& _default) const -> T
+        {
+            return value_.value_or(_default);
+        } // value_or
+
+    private:
+        std::optional<T> value_;
+        std::optional<irods::exception> error_;
+    }; // class configuration_value
+
     std::string to_env( const std::string& );
 
 }; // namespace irods
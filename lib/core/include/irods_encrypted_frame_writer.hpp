@@ -0,0 +1,81 @@
+#ifndef IRODS_ENCRYPTED_FRAME_WRITER_HPP
+#define IRODS_ENCRYPTED_FRAME_WRITER_HPP
+
+#include "irods_buffer_encryption.hpp"
+#include "irods_error.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace irods
+{
+    /// \brief Encrypts buffers and writes them to a socket for a parallel transfer.
+    ///
+    /// Each buffer is sent as a frame holding the size of the rest of the frame, the
+    /// initialization vector (key_size() bytes), and the cipher text. This is the format
+    /// read by the receiving side of an encrypted parallel transfer.
+    ///
+    /// Frames are written by a writer thread, which runs for the lifetime of the object, while
+    /// the caller reads and encrypts the next buffer, so encryption overlaps with socket I/O.
+    /// The frames waiting to be written are held in a bounded queue; write() blocks while it
+    /// is full.
+    ///
+    /// \since 4.3.0
+    class encrypted_frame_writer
+    {
+    public:
+        /// \param[in] _socket      The socket to write frames to.
+        /// \param[in] _crypt       The encryption context. It must outlive this object.
+        /// \param[in] _key         The shared secret. It must outlive this object.
+        /// \param[in] _queue_depth The number of frames which may be queued or being written.
+        encrypted_frame_writer(int _socket,
+                               buffer_crypt& _crypt,
+                               const buffer_crypt::array_t& _key,
+                               std::size_t _queue_depth = 2);
+
+        encrypted_frame_writer(const encrypted_frame_writer&) = delete;
+        auto operator=(const encrypted_frame_writer&) -> encrypted_frame_writer& = delete;
+
+        /// Writes the queued frames and stops the writer thread.
+        ~encrypted_frame_writer();
+
+        /// Encrypts a buffer and queues it for writing.
+        ///
+        /// Returns an error if encryption fails or if a previous frame could not be written.
+        auto write(const unsigned char* _buffer, int _length) -> irods::error;
+
+        /// Waits until every queued frame has been written.
+        ///
+        /// Returns the error of the first frame which could not be written.
+        auto flush() -> irods::error;
+
+    private:
+        struct frame
+        {
+            int size;
+            buffer_crypt::array_t iv;
+            buffer_crypt::array_t cipher;
+        };
+
+        auto run() -> void;
+
+        int socket_;
+        buffer_crypt& crypt_;
+        const buffer_crypt::array_t& key_;
+
+        // A ring of frames. The writer thread owns the queued frames, starting at head_.
+        std::vector<frame> frames_;
+        std::size_t head_;
+        std::size_t queued_;
+        bool stopping_;
+        irods::error error_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::thread thread_;
+    }; // class encrypted_frame_writer
+} // namespace irods
+
+#endif // IRODS_ENCRYPTED_FRAME_WRITER_HPP
@@ -7,7 +7,12 @@
 #include "irods_configuration_keywords.hpp"
 #include "irods_error.hpp"
 #include "irods_exception.hpp"
+#include "server_config_snapshot.hpp"
 
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 
@@ -88,6 +93,15 @@ namespace irods
 
         void remove( const std::string& _key );
 
+        /// @brief Returns the snapshot published by the most recent capture().  Changes
+        ///        made through set_property() and remove() are not part of it.
+        ///
+        /// Does not lock.  Published snapshots are kept until the process exits, so the
+        /// pointer loaded here never dangles.
+        std::shared_ptr<const server_config_snapshot> snapshot() const noexcept {
+            return *snapshot_.load( std::memory_order_acquire );
+        }
+
     private:
         server_properties();
 
@@ -96,6 +110,16 @@ namespace irods
 
         /// @brief properties lookup table
         configuration_parser config_props_;
+
+        /// @brief every snapshot published by capture(), oldest first.  a configuration
+        ///        reload adds one, so the list stays short.
+        std::list<std::shared_ptr<const server_config_snapshot>> published_snapshots_;
+
+        /// @brief serializes capture() calls that publish a snapshot.
+        std::mutex publish_mutex_;
+
+        /// @brief the element of published_snapshots_ returned by snapshot().
+        std::atomic<const std::shared_ptr<const server_config_snapshot>*> snapshot_;
     }; // class server_properties
 
     inline bool server_property_exists(const std::string_view _prop) {
@@ -134,6 +158,19 @@ namespace irods
         return irods::get_server_property<T>(configuration_parser::key_path_t{CFG_ADVANCED_SETTINGS_KW, _prop});
     } // get_advanced_setting
 
+    /// Returns the typed snapshot of the server configuration published by the most
+    /// recent load of server_config.json.
+    ///
+    /// Prefer this over get_server_property() and get_advanced_setting() on hot paths. It
+    /// does not search the property map. Hold on to the returned pointer for as long as
+    /// the values are needed.
+    ///
+    /// \since 4.3.0
+    inline auto get_server_config_snapshot() noexcept -> std::shared_ptr<const server_config_snapshot>
+    {
+        return server_properties::instance().snapshot();
+    } // get_server_config_snapshot
+
     /// Returns the amount of shared memory that should be allocated for the DNS cache.
     ///
     /// \return An integer representing the size in bytes.
@@ -170,6 +207,85 @@ namespace irods
     /// \since 4.2.9
     auto get_hostname_cache_eviction_age() noexcept -> int;
 
+    /// Returns the amount of shared memory that should be allocated for the server load table.
+    ///
+    /// \return An integer representing the size in bytes.
+    /// \retval 1000000          If an error occurred or the size was less than or equal to zero.
+    /// \retval Configured-Value Otherwise.
+    ///
+    /// \since 4.3.0
+    auto get_server_load_table_shared_memory_size() noexcept -> int;
+
+    /// Returns the number of seconds between server load samples from server_config.json.
+    ///
+    /// \return An integer representing seconds.
+    /// \retval 15               If an error occurred or the interval was less than or equal to zero.
+    /// \retval Configured-Value Otherwise.
+    ///
+    /// \since 4.3.0
+    auto get_server_load_sample_interval() noexcept -> int;
+
+    /// Returns the amount of shared memory that should be allocated for the resource
+    /// hierarchy cache.
+    ///
+    /// \return An integer representing the size in bytes.
+    /// \retval 5000000          If an error occurred or the size was less than or equal to zero.
+    /// \retval Configured-Value Otherwise.
+    ///
+    /// \since 4.3.0
+    auto get_resource_hierarchy_cache_shared_memory_size() noexcept -> int;
+
+    /// Returns the number of seconds a cached resource hierarchy is used before it is
+    /// compared against the catalog again, from server_config.json.
+    ///
+    /// \return An integer representing seconds.
+    /// \retval 10               If an error occurred or the interval was less than zero.
+    /// \retval Configured-Value Otherwise.
+    ///
+    /// \since 4.3.0
+    auto get_resource_hierarchy_cache_refresh_interval() noexcept -> int;
+
+    /// Returns the amount of shared memory that should be allocated for sharing access
+    /// verdicts between agents.
+    ///
+    /// \return An integer representing the size in bytes.
+    /// \retval 0                If an error occurred or the size was less than zero.
+    /// \retval Configured-Value Otherwise.
+    ///
+    /// \since 4.3.0
+    auto get_access_verdict_cache_shared_memory_size() noexcept -> int;
+
+    /// Returns the number of seconds a granted access verdict is reused without consulting
+    /// the catalog, from server_config.json.
+    ///
+    /// \return An integer representing seconds.
+    /// \retval 0                If an error occurred or the value was less than zero. The
+    ///                          cache is disabled.
+    /// \retval Configured-Value Otherwise.
+    ///
+    /// \since 4.3.0
+    auto get_access_verdict_cache_time_to_live() noexcept -> int;
+
+    /// Returns the maximum number of access verdicts an agent keeps when they are not shared,
+    /// from server_config.json.
+    ///
+    /// \return An integer representing the number of verdicts.
+    /// \retval 10000            If an error occurred or the value was less than or equal to zero.
+    /// \retval Configured-Value Otherwise.
+    ///
+    /// \since 4.3.0
+    auto get_access_verdict_cache_maximum_entries() noexcept -> int;
+
+    /// Returns the number of workers of the persistent PAM authentication helper from
+    /// server_config.json.
+    ///
+    /// \return An integer representing the number of workers.
+    /// \retval 0                If an error occurred or the helper is not configured.
+    /// \retval Configured-Value Otherwise.
+    ///
+    /// \since 4.3.0
+    auto get_pam_auth_helper_worker_count() noexcept -> int;
+
     /// Parses hosts_config.json into a JSON object if available and stores it in the server
     /// property map with key \p irods::HOSTS_CONFIG_JSON_OBJECT_KW.
     ///
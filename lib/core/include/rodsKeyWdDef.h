@@ -76,6 +76,7 @@
 #define VERY_VERBOSE_KW                             "veryVerbose"
 #define RBUDP_SEND_RATE_KW                          "rbudpSendRate"
 #define RBUDP_PACK_SIZE_KW                          "rbudpPackSize"
+#define RBUDP_NUM_STREAMS_KW                        "rbudpNumStreams"
 #define ZONE_KW                                     "zone"
 #define REMOTE_ZONE_OPR_KW                          "remoteZoneOpr"
 #define REPL_DATA_OBJ_INP_KW                        "replDataObjInp"
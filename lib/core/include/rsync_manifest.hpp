@@ -0,0 +1,103 @@
+#ifndef IRODS_RSYNC_MANIFEST_HPP
+#define IRODS_RSYNC_MANIFEST_HPP
+
+/// \file
+
+#include "parseCommandLine.h"
+#include "rcConnect.h"
+#include "rodsType.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace irods::experimental::rsync_manifest
+{
+    /// What the catalog knows about a data object in the destination collection.
+    struct remote_entry
+    {
+        rodsLong_t size;
+        std::int64_t mtime;
+        std::string checksum;
+    }; // struct remote_entry
+
+    /// The data objects and collections under a collection, keyed by logical path.
+    struct manifest
+    {
+        std::unordered_map<std::string, remote_entry> data_objects;
+        std::unordered_set<std::string> collections;
+    }; // struct manifest
+
+    /// A regular file found by scanning the source directory.
+    struct local_entry
+    {
+        std::string path;
+        std::string logical_path;
+        rodsLong_t size;
+        std::int64_t mtime;
+        int mode;
+    }; // struct local_entry
+
+    /// The result of scanning a source directory.
+    struct scan_result
+    {
+        /// Regular files, sorted by logical path.
+        std::vector<local_entry> files;
+
+        /// Logical paths of the subdirectories, sorted so parents precede children.
+        std::vector<std::string> collections;
+
+        /// The last error encountered, or zero. Entries that caused errors are skipped.
+        int status;
+    }; // struct scan_result
+
+    /// What must be done to bring a data object up to date with a local file.
+    enum class action
+    {
+        none,             ///< The data object matches.
+        put,              ///< The data object is missing or differs.
+        compare_checksum, ///< Compare the local checksum with the one in the catalog.
+        sync_on_server    ///< The catalog has no checksum. Let the server compare.
+    }; // enum class action
+
+    /// Fetches the manifest of \p _collection and everything under it.
+    ///
+    /// Uses a fixed number of paged GenQuery calls regardless of the size of the tree.
+    /// Of multiple replicas, a good one is described.
+    ///
+    /// \throws irods::exception If a query fails.
+    ///
+    /// \since 4.3.0
+    auto fetch(rcComm_t& _conn, const std::string& _collection) -> manifest;
+
+    /// Scans \p _dir recursively using up to \p _threads threads.
+    ///
+    /// Symbolic links are followed and paths are filtered the same way iput -r does.
+    ///
+    /// \param[in] _args       The command line arguments.
+    /// \param[in] _dir        The directory to scan.
+    /// \param[in] _collection The collection \p _dir maps to.
+    /// \param[in] _threads    The maximum number of threads.
+    ///
+    /// \since 4.3.0
+    auto scan(const rodsArguments_t& _args,
+              const std::string& _dir,
+              const std::string& _collection,
+              int _threads) -> scan_result;
+
+    /// Decides what to do with a local file given its data object, if any.
+    ///
+    /// A data object of the same size whose catalog modification time is not older than
+    /// the local file is considered up to date without computing the local checksum.
+    ///
+    /// \param[in] _local     The local file.
+    /// \param[in] _remote    The data object, or nullptr if it does not exist.
+    /// \param[in] _size_only Whether to compare sizes only (irsync -s).
+    ///
+    /// \since 4.3.0
+    auto classify(const local_entry& _local, const remote_entry* _remote, bool _size_only) noexcept -> action;
+} // namespace irods::experimental::rsync_manifest
+
+#endif // IRODS_RSYNC_MANIFEST_HPP
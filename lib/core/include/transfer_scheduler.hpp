@@ -0,0 +1,180 @@
+#ifndef IRODS_TRANSFER_SCHEDULER_HPP
+#define IRODS_TRANSFER_SCHEDULER_HPP
+
+/// \file
+
+#include "connection_pool.hpp"
+#include "getRodsEnv.h"
+#include "guiProgressCallback.h"
+#include "rcConnect.h"
+#include "rodsType.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace irods
+{
+    class thread_pool;
+} // namespace irods
+
+namespace irods::experimental
+{
+    /// Runs the file transfers of a recursive put or get.
+    ///
+    /// By default, every transfer runs synchronously on the caller's connection, exactly
+    /// as if the transfer function had been called directly. When more than one file may
+    /// be transferred at a time, transfers are queued and run by a fixed set of workers,
+    /// each with its own pooled connection. While files are in flight:
+    /// - The number of portal threads requested for each file is limited by a budget
+    ///   shared by all files, so large files are split across fewer threads when many
+    ///   files are being transferred and across more threads when few are.
+    /// - Files are started no faster than the bandwidth limit allows.
+    /// - Commit functions (e.g. writing the restart file) run on the caller's thread in
+    ///   the order the transfers were scheduled, and only for the unbroken run of
+    ///   successful transfers from the first one. A restart file therefore never names a
+    ///   file that follows one which has not been transferred.
+    /// - If a progress callback is installed, it is invoked with the caller's connection's
+    ///   progress, which accumulates the progress of all workers.
+    ///
+    /// \since 4.3.0
+    class transfer_scheduler
+    {
+    public:
+        struct options
+        {
+            /// The number of files transferred at the same time.
+            int max_files = 1;
+
+            /// The number of portal threads shared by all files in flight.
+            int max_threads = 1;
+
+            /// The maximum average transfer rate. Zero means unlimited.
+            rodsLong_t max_bytes_per_second = 0;
+
+            /// Files up to this size are sent in-band and never use portal threads.
+            rodsLong_t max_size_for_single_buffer = 0;
+
+            /// The number of portal threads used for a large file when the user did not
+            /// request a specific number.
+            int default_threads = 1;
+
+            /// The number of threads requested by the user (dataObjInp_t::numThreads).
+            int requested_threads = 0;
+
+            /// Stop starting transfers after the first failure.
+            bool stop_on_error = false;
+        }; // struct options
+
+        /// Transfers one file over \p _conn using at most \p _num_threads portal threads,
+        /// which is to be stored in dataObjInp_t::numThreads. Returns an iRODS status code.
+        using transfer_function = std::function<int(rcComm_t& _conn, int _num_threads)>;
+
+        /// Records the completion of a transfer. Returns an iRODS status code.
+        using commit_function = std::function<int()>;
+
+        /// Prepares a newly connected worker connection (e.g. sets a session ticket).
+        using connect_function = std::function<void(rcComm_t& _conn)>;
+
+        /// Returns the options described by the client environment.
+        ///
+        /// \param[in] _env               The client environment.
+        /// \param[in] _requested_threads The number of threads requested by the user.
+        static auto make_options(const rodsEnv& _env, int _requested_threads) -> options;
+
+        /// Returns the number of portal threads a transfer of \p _size bytes would like to use.
+        static auto thread_cost(const options& _opts, rodsLong_t _size) noexcept -> int;
+
+        /// Constructs a scheduler whose workers connect to the same server as \p _conn.
+        ///
+        /// Falls back to running synchronously if the worker connections cannot be
+        /// established.
+        ///
+        /// \param[in] _conn       The caller's connection. It is dereferenced whenever a
+        ///                        transfer runs synchronously, so it may be reconnected.
+        /// \param[in] _opts       The scheduling options.
+        /// \param[in] _on_connect Invoked once for each worker connection.
+        transfer_scheduler(rcComm_t** _conn, const options& _opts, connect_function _on_connect = {});
+
+        /// Constructs a scheduler whose workers use the given connections, one worker per
+        /// connection. The connections must outlive the scheduler.
+        transfer_scheduler(rcComm_t** _conn, std::vector<rcComm_t*> _workers, const options& _opts);
+
+        transfer_scheduler(const transfer_scheduler&) = delete;
+        auto operator=(const transfer_scheduler&) -> transfer_scheduler& = delete;
+
+        /// Waits for all transfers and restores the progress callback.
+        ~transfer_scheduler();
+
+        /// Returns whether transfers run on workers rather than synchronously.
+        auto concurrent() const noexcept -> bool;
+
+        /// Schedules a transfer of \p _size bytes.
+        ///
+        /// When running synchronously, returns the status of the transfer, or of the commit
+        /// function if the transfer succeeded. Otherwise, blocks while the queue is full and
+        /// returns zero, or the status of the first failed transfer if transfers have been
+        /// stopped because of it.
+        auto schedule(rodsLong_t _size, transfer_function _transfer, commit_function _commit = {}) -> int;
+
+        /// Waits for all scheduled transfers and runs their commit functions.
+        ///
+        /// \return The status of the first failure since the previous call, or zero.
+        auto wait() -> int;
+
+    private:
+        struct job
+        {
+            std::uint64_t sequence;
+            rodsLong_t size;
+            transfer_function transfer;
+        }; // struct job
+
+        struct result
+        {
+            rodsLong_t size;
+            commit_function commit;
+            bool done;
+            int status;
+        }; // struct result
+
+        auto start(std::vector<rcComm_t*> _workers) -> void;
+
+        auto run_worker(rcComm_t& _conn) -> void;
+
+        auto run_job(rcComm_t& _conn, job& _job, int _num_threads) -> int;
+
+        auto num_threads_for(rodsLong_t _size, int _granted) const noexcept -> int;
+
+        auto reserve_bandwidth(rodsLong_t _size) -> std::chrono::steady_clock::time_point;
+
+        auto run_commits(std::unique_lock<std::mutex>& _lock) -> void;
+
+        rcComm_t** conn_;
+        options opts_;
+        std::unique_ptr<connection_pool> conn_pool_;
+        std::vector<connection_pool::connection_proxy> conn_proxies_;
+        std::unique_ptr<thread_pool> thread_pool_;
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::deque<job> queue_;
+        std::deque<result> results_;
+        std::uint64_t next_sequence_;
+        std::uint64_t first_result_sequence_;
+        int available_threads_;
+        int error_;
+        bool commits_stopped_;
+        bool stopping_;
+        std::chrono::steady_clock::time_point next_start_;
+
+        guiProgressCallback saved_progress_callback_;
+    }; // class transfer_scheduler
+} // namespace irods::experimental
+
+#endif // IRODS_TRANSFER_SCHEDULER_HPP
@@ -0,0 +1,492 @@
+#ifndef IRODS_IO_ASYNC_TRANSPORT_HPP
+#define IRODS_IO_ASYNC_TRANSPORT_HPP
+
+/// \file
+
+#include "transport/transport.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace irods::experimental::io
+{
+    /// \brief A transport that overlaps network round trips with the work of the caller.
+    ///
+    /// This transport wraps another transport and moves all reads and writes onto a
+    /// background thread. While reading, the next chunks of the replica are requested
+    /// before the caller asks for them (read-ahead). While writing, the caller's bytes are
+    /// gathered into chunks and sent while the caller produces the next chunk (write-behind).
+    ///
+    /// The wrapped transport is only ever used by one thread at a time, so the transport
+    /// does not need to be thread-safe and the connection carries one request at a time.
+    ///
+    /// Because writes complete in the background, send() reports that all bytes were sent
+    /// once they have been queued. A failed write is reported by the next call to send(),
+    /// receive(), seekpos(), or close().
+    ///
+    /// Instances of this class are not thread-safe.
+    ///
+    /// \since 4.3.0
+    template <typename CharT>
+    class basic_async_transport : public transport<CharT>
+    {
+    public:
+        // clang-format off
+        using char_type   = typename transport<CharT>::char_type;
+        using traits_type = typename transport<CharT>::traits_type;
+        using int_type    = typename traits_type::int_type;
+        using pos_type    = typename traits_type::pos_type;
+        using off_type    = typename traits_type::off_type;
+        // clang-format on
+
+    private:
+        // clang-format off
+        inline static constexpr std::streamsize default_chunk_size = 4 * 1024 * 1024;
+        inline static constexpr std::size_t default_queue_depth    = 2;
+
+        // Errors
+        inline static constexpr auto io_error                      = -1;
+        inline static const     auto seek_error                    = pos_type{off_type{-1}};
+        // clang-format on
+
+        struct chunk
+        {
+            std::vector<char_type> data;
+            std::streamsize size;
+        }; // struct chunk
+
+    public:
+        /// Constructs the transport.
+        ///
+        /// \param[in] _transport   The transport used to communicate with the server. It must
+        ///                         outlive this object.
+        /// \param[in] _chunk_size  The number of bytes transferred by each background request.
+        /// \param[in] _queue_depth The maximum number of chunks read ahead or waiting to be written.
+        explicit basic_async_transport(transport<char_type>& _transport,
+                                       std::streamsize _chunk_size = default_chunk_size,
+                                       std::size_t _queue_depth = default_queue_depth)
+            : transport<char_type>{}
+            , tp_{_transport}
+            , chunk_size_{_chunk_size > 0 ? _chunk_size : default_chunk_size}
+            , queue_depth_{_queue_depth > 0 ? _queue_depth : default_queue_depth}
+            , reads_{}
+            , read_buf_{}
+            , read_buf_pos_{}
+            , read_eof_{}
+            , writes_{}
+            , write_buf_{}
+            , write_error_{}
+            , spare_bufs_{}
+            , mutex_{}
+            , cond_{}
+            , jobs_{}
+            , stop_{}
+            , worker_{[this] { run(); }}
+        {
+        }
+
+        basic_async_transport(const basic_async_transport&) = delete;
+        auto operator=(const basic_async_transport&) -> basic_async_transport& = delete;
+
+        ~basic_async_transport()
+        {
+            try {
+                flush_writes();
+                discard_reads();
+            }
+            catch (...) {
+            }
+
+            {
+                std::lock_guard lock{mutex_};
+                stop_ = true;
+            }
+
+            cond_.notify_one();
+            worker_.join();
+        }
+
+        bool open(const irods::experimental::filesystem::path& _path,
+                  std::ios_base::openmode _mode) override
+        {
+            reset();
+            return tp_.open(_path, _mode);
+        }
+
+        bool open(const irods::experimental::filesystem::path& _path,
+                  const io::replica_number& _replica_number,
+                  std::ios_base::openmode _mode) override
+        {
+            reset();
+            return tp_.open(_path, _replica_number, _mode);
+        }
+
+        bool open(const irods::experimental::filesystem::path& _path,
+                  const io::root_resource_name& _root_resource_name,
+                  std::ios_base::openmode _mode) override
+        {
+            reset();
+            return tp_.open(_path, _root_resource_name, _mode);
+        }
+
+        bool open(const irods::experimental::filesystem::path& _path,
+                  const io::leaf_resource_name& _leaf_resource_name,
+                  std::ios_base::openmode _mode) override
+        {
+            reset();
+            return tp_.open(_path, _leaf_resource_name, _mode);
+        }
+
+        bool open(const io::replica_token& _replica_token,
+                  const irods::experimental::filesystem::path& _path,
+                  const io::replica_number& _replica_number,
+                  std::ios_base::openmode _mode) override
+        {
+            reset();
+            return tp_.open(_replica_token, _path, _replica_number, _mode);
+        }
+
+        bool open(const io::replica_token& _replica_token,
+                  const irods::experimental::filesystem::path& _path,
+                  const io::leaf_resource_name& _leaf_resource_name,
+                  std::ios_base::openmode _mode) override
+        {
+            reset();
+            return tp_.open(_replica_token, _path, _leaf_resource_name, _mode);
+        }
+
+        bool close(const on_close_success* _on_close_success = nullptr) override
+        {
+            const auto flushed = flush_writes();
+            discard_reads();
+
+            // Always close the replica, even if a write failed.
+            const auto closed = tp_.close(_on_close_success);
+
+            return flushed && closed;
+        }
+
+        std::streamsize receive(char_type* _buffer, std::streamsize _buffer_size) override
+        {
+            if (!flush_writes()) {
+                return io_error;
+            }
+
+            std::streamsize bytes_copied = 0;
+
+            while (bytes_copied < _buffer_size) {
+                const auto bytes_available = read_buf_.size - read_buf_pos_;
+
+                if (bytes_available > 0) {
+                    const auto bytes_to_copy = std::min(bytes_available, _buffer_size - bytes_copied);
+                    std::memcpy(_buffer + bytes_copied, read_buf_.data.data() + read_buf_pos_, bytes_to_copy * sizeof(char_type));
+                    read_buf_pos_ += bytes_to_copy;
+                    bytes_copied += bytes_to_copy;
+                    continue;
+                }
+
+                if (read_eof_ && reads_.empty()) {
+                    break;
+                }
+
+                fill_read_queue();
+
+                recycle(std::move(read_buf_.data));
+                read_buf_ = reads_.front().get();
+                read_buf_pos_ = 0;
+                reads_.pop_front();
+
+                if (read_buf_.size < 0) {
+                    const auto ec = read_buf_.size;
+                    read_buf_.size = 0;
+                    read_eof_ = true;
+                    return bytes_copied > 0 ? bytes_copied : ec;
+                }
+
+                // A short read means the end of the replica was reached.
+                if (read_buf_.size < chunk_size_) {
+                    read_eof_ = true;
+                }
+            }
+
+            // Request the next chunks while the caller processes these bytes.
+            fill_read_queue();
+
+            return bytes_copied;
+        }
+
+        std::streamsize send(const char_type* _buffer, std::streamsize _buffer_size) override
+        {
+            if (!discard_reads() || write_error_) {
+                return io_error;
+            }
+
+            std::streamsize bytes_queued = 0;
+
+            while (bytes_queued < _buffer_size) {
+                if (write_buf_.data.empty()) {
+                    write_buf_ = {make_buffer(), 0};
+                }
+
+                const auto bytes_to_copy = std::min(chunk_size_ - write_buf_.size, _buffer_size - bytes_queued);
+                std::memcpy(write_buf_.data.data() + write_buf_.size, _buffer + bytes_queued, bytes_to_copy * sizeof(char_type));
+                write_buf_.size += bytes_to_copy;
+                bytes_queued += bytes_to_copy;
+
+                if (write_buf_.size == chunk_size_ && !queue_write()) {
+                    return io_error;
+                }
+            }
+
+            return bytes_queued;
+        }
+
+        pos_type seekpos(off_type _offset, std::ios_base::seekdir _dir) override
+        {
+            if (!flush_writes()) {
+                return seek_error;
+            }
+
+            // The wrapped transport is ahead of the caller by the number of bytes that
+            // were read ahead. Relative seeks must account for them.
+            const auto bytes_unconsumed = stop_reads();
+
+            if (bytes_unconsumed < 0) {
+                return seek_error;
+            }
+
+            if (std::ios_base::cur == _dir) {
+                _offset -= bytes_unconsumed;
+            }
+
+            return tp_.seekpos(_offset, _dir);
+        }
+
+        bool is_open() const noexcept override
+        {
+            return tp_.is_open();
+        }
+
+        int file_descriptor() const noexcept override
+        {
+            return tp_.file_descriptor();
+        }
+
+        const io::root_resource_name& root_resource_name() const override
+        {
+            return tp_.root_resource_name();
+        }
+
+        const io::leaf_resource_name& leaf_resource_name() const override
+        {
+            return tp_.leaf_resource_name();
+        }
+
+        const io::replica_number& replica_number() const override
+        {
+            return tp_.replica_number();
+        }
+
+        const io::replica_token& replica_token() const override
+        {
+            return tp_.replica_token();
+        }
+
+    private:
+        void run()
+        {
+            while (true) {
+                std::function<void()> job;
+
+                {
+                    std::unique_lock lock{mutex_};
+                    cond_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+
+                    if (jobs_.empty()) {
+                        return;
+                    }
+
+                    job = std::move(jobs_.front());
+                    jobs_.pop_front();
+                }
+
+                job();
+            }
+        }
+
+        template <typename Function>
+        auto submit(Function _func) -> std::future<chunk>
+        {
+            auto task = std::make_shared<std::packaged_task<chunk()>>(std::move(_func));
+            auto future = task->get_future();
+
+            {
+                std::lock_guard lock{mutex_};
+                jobs_.emplace_back([task] { (*task)(); });
+            }
+
+            cond_.notify_one();
+
+            return future;
+        }
+
+        auto make_buffer() -> std::vector<char_type>
+        {
+            if (spare_bufs_.empty()) {
+                return std::vector<char_type>(chunk_size_);
+            }
+
+            auto buf = std::move(spare_bufs_.back());
+            spare_bufs_.pop_back();
+
+            return buf;
+        }
+
+        void recycle(std::vector<char_type>&& _buffer)
+        {
+            if (!_buffer.empty() && spare_bufs_.size() <= queue_depth_) {
+                spare_bufs_.push_back(std::move(_buffer));
+            }
+        }
+
+        void fill_read_queue()
+        {
+            while (!read_eof_ && reads_.size() < queue_depth_) {
+                reads_.push_back(submit([this, buf = make_buffer()]() mutable {
+                    const auto bytes_read = tp_.receive(buf.data(), chunk_size_ * sizeof(char_type));
+                    return chunk{std::move(buf), bytes_read};
+                }));
+            }
+        }
+
+        // Waits for outstanding reads and returns the number of bytes that were read from
+        // the wrapped transport but not consumed by the caller. Returns a negative value if
+        // the wrapped transport could not be moved back to the caller's position.
+        auto stop_reads() -> off_type
+        {
+            off_type bytes_unconsumed = read_buf_.size - read_buf_pos_;
+
+            for (auto& f : reads_) {
+                auto c = f.get();
+
+                if (c.size > 0) {
+                    bytes_unconsumed += c.size;
+                }
+
+                recycle(std::move(c.data));
+            }
+
+            reads_.clear();
+            recycle(std::move(read_buf_.data));
+            read_buf_ = {};
+            read_buf_pos_ = 0;
+            read_eof_ = false;
+
+            return bytes_unconsumed;
+        }
+
+        // Stops reading ahead and moves the wrapped transport back to the caller's position.
+        auto discard_reads() -> bool
+        {
+            const auto bytes_unconsumed = stop_reads();
+
+            if (bytes_unconsumed == 0) {
+                return true;
+            }
+
+            return bytes_unconsumed > 0 && tp_.seekpos(-bytes_unconsumed, std::ios_base::cur) != seek_error;
+        }
+
+        // Queues the write buffer and waits for the oldest write if too many are in flight.
+        auto queue_write() -> bool
+        {
+            writes_.push_back(submit([this, c = std::move(write_buf_)]() mutable {
+                const auto bytes_written = tp_.send(c.data.data(), c.size * sizeof(char_type));
+
+                if (bytes_written != c.size) {
+                    c.size = bytes_written < 0 ? bytes_written : io_error;
+                }
+
+                return std::move(c);
+            }));
+
+            write_buf_ = {};
+
+            while (writes_.size() > queue_depth_) {
+                wait_for_oldest_write();
+            }
+
+            return !write_error_;
+        }
+
+        void wait_for_oldest_write()
+        {
+            auto c = writes_.front().get();
+            writes_.pop_front();
+
+            if (c.size < 0) {
+                write_error_ = true;
+            }
+
+            recycle(std::move(c.data));
+        }
+
+        // Sends any buffered bytes and waits for all writes to complete.
+        auto flush_writes() -> bool
+        {
+            if (write_buf_.size > 0) {
+                queue_write();
+            }
+
+            while (!writes_.empty()) {
+                wait_for_oldest_write();
+            }
+
+            return !std::exchange(write_error_, false);
+        }
+
+        void reset()
+        {
+            flush_writes();
+            stop_reads();
+        }
+
+        transport<char_type>& tp_;
+        const std::streamsize chunk_size_;
+        const std::size_t queue_depth_;
+
+        // Read-ahead state.
+        std::deque<std::future<chunk>> reads_;
+        chunk read_buf_;
+        std::streamsize read_buf_pos_;
+        bool read_eof_;
+
+        // Write-behind state.
+        std::deque<std::future<chunk>> writes_;
+        chunk write_buf_;
+        bool write_error_;
+
+        std::vector<std::vector<char_type>> spare_bufs_;
+
+        // Background thread state.
+        std::mutex mutex_;
+        std::condition_variable cond_;
+        std::deque<std::function<void()>> jobs_;
+        bool stop_;
+        std::thread worker_;
+    }; // class basic_async_transport
+
+    using async_transport = basic_async_transport<char>;
+} // namespace irods::experimental::io
+
+#endif // IRODS_IO_ASYNC_TRANSPORT_HPP
+
@@ -7,13 +7,21 @@
 #include "scanUtil.h"
 #include "checksum.h"
 #include "rcGlobalExtern.h"
+#include "fsck_snapshot.hpp"
+#include "irods_exception.hpp"
+#include "thread_pool.hpp"
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/convenience.hpp>
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <optional>
 #include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 
 namespace fs = boost::filesystem;
 
@@ -73,6 +81,8 @@ int fsckObjDir(rcComm_t* conn,
                SetGenQueryInpFromPhysicalPath strategy,
                const char* argument_for_SetGenQueryInpFromPhysicalPath)
 {
+    namespace fsck = irods::experimental::fsck;
+
     fs::path srcDirPath(inpPath);
 
     if (is_symlink(srcDirPath)) {
@@ -83,40 +93,179 @@ int fsckObjDir(rcComm_t* conn,
         return chkObjConsistency(conn, myRodsArgs, inpPath, strategy, argument_for_SetGenQueryInpFromPhysicalPath);
     }
 
-    char fullPath[MAX_PATH_ALLOWED] = "\0";
-    int status = 0;
+    rodsEnv env;
+    if (const int ec = getRodsEnv(&env); ec < 0) {
+        rodsLogError(LOG_ERROR, ec, "fsckObjDir: getRodsEnv failed");
+        return ec;
+    }
+
+    const int numThreads = env.irodsFsckThreads > 0
+                           ? env.irodsFsckThreads
+                           : std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, 8);
 
+    // Walk the directory and fetch every replica stored under it up front, instead of
+    // querying the catalog once per file.
+    const auto local = fsck::walk(inpPath, myRodsArgs->recursive == True, numThreads);
+
+    fsck::snapshot remote;
     try {
-        for (const auto& e : fs::directory_iterator{srcDirPath}) {
-            std::snprintf(fullPath, MAX_PATH_ALLOWED, "%s", e.path().c_str());
+        remote = fsck::fetch_snapshot(*conn, inpPath, myRodsArgs->recursive == True,
+                                      strategy, argument_for_SetGenQueryInpFromPhysicalPath);
+    }
+    catch (const irods::exception& e) {
+        rodsLog(LOG_ERROR, "fsckObjDir: %s", e.client_display_what());
+        return e.code();
+    }
+
+    int status = 0;
+
+    for (const auto& [path, ec] : local.errors) {
+        if (ec == static_cast<int>(std::errc::permission_denied)) {
+            rodsLog(LOG_ERROR, "Permission denied: \"%s\"", path.c_str());
+        }
+        else {
+            rodsLog(LOG_ERROR, "fsckObjDir: could not read directory \"%s\", errno = %d", path.c_str(), ec);
+        }
+
+        if (status == 0) {
+            status = ec;
+        }
+    }
+
+    std::optional<fsck::state_file> state;
+    if (std::strlen(env.irodsFsckStateFile) > 0) {
+        state.emplace(env.irodsFsckStateFile);
+    }
+
+    // Compare sizes in memory, and hash the files that still need it in parallel.
+    std::vector<std::string> outcomes(local.files.size());
+    std::vector<int> verifyStatus(local.files.size(), 0);
 
-            // Don't do anything if it is symlink.
-            if (fs::is_symlink(e.path())) {
+    {
+        irods::thread_pool pool{numThreads};
+        fsck::throttle readThrottle{static_cast<rodsLong_t>(env.irodsFsckMaxReadBandwidth) * 1024 * 1024};
+
+        for (std::size_t i = 0; i < local.files.size(); ++i) {
+            const auto& file = local.files[i];
+            const auto entry = remote.find(file.path);
+
+            if (entry == remote.end()) {
+                outcomes[i] = "not_registered";
                 continue;
             }
 
-            if (fs::is_directory(e.path())) {
-                if (myRodsArgs->recursive == True) {
-                    const int tmp_status = fsckObjDir(conn, myRodsArgs, fullPath, strategy, argument_for_SetGenQueryInpFromPhysicalPath);
-                    if (status == 0) {
-                        status = tmp_status;
-                    }
-                }
+            const auto& replica = entry->second;
+
+            if (file.size != replica.size) {
+                outcomes[i] = "size_mismatch";
+            }
+            else if (myRodsArgs->verifyChecksum != True) {
+                outcomes[i] = "ok";
+            }
+            else if (replica.checksum.empty()) {
+                outcomes[i] = "no_checksum";
+            }
+            else if (state && state->verified(file.path, file, replica.checksum)) {
+                outcomes[i] = "ok";
             }
             else {
-                const int tmp_status = chkObjConsistency(conn, myRodsArgs, fullPath, strategy, argument_for_SetGenQueryInpFromPhysicalPath);
-                if (status == 0) {
-                    status = tmp_status;
-                }
+                irods::thread_pool::post(pool, [&, i] {
+                    readThrottle.acquire(local.files[i].size);
+
+                    std::string path = local.files[i].path;
+                    verifyStatus[i] = verifyChksumLocFile(path.data(), remote.at(path).checksum.c_str(), nullptr);
+
+                    if (verifyStatus[i] == 0) {
+                        outcomes[i] = "ok";
+                    }
+                    else if (verifyStatus[i] == USER_CHKSUM_MISMATCH) {
+                        outcomes[i] = "checksum_mismatch";
+                    }
+                    else {
+                        outcomes[i] = "error";
+                    }
+                });
             }
         }
+
+        pool.join();
+    }
+
+    for (std::size_t i = 0; i < local.files.size(); ++i) {
+        const auto& file = local.files[i];
+        const auto& outcome = outcomes[i];
+        const auto entry = remote.find(file.path);
+        const char* objPath = entry == remote.end() ? "" : entry->second.logical_path.c_str();
+        int tmp_status = 0;
+
+        if (outcome == "not_registered") {
+            std::printf("ERROR: local file [%s] is not registered in iRODS.\n", file.path.c_str());
+            tmp_status = CAT_NO_ROWS_FOUND;
+        }
+        else if (outcome == "size_mismatch") {
+            std::printf("CORRUPTION: local file [%s] size [%ji] not consistent with iRODS object [%s] size [%ji].\n",
+                        file.path.c_str(), static_cast<intmax_t>(file.size), objPath, static_cast<intmax_t>(entry->second.size));
+            tmp_status = SYS_INTERNAL_ERR;
+        }
+        else if (outcome == "no_checksum") {
+            std::printf("WARNING: checksum not available for iRODS object [%s], no checksum comparison possible with local file [%s] .\n",
+                        objPath, file.path.c_str());
+        }
+        else if (outcome == "checksum_mismatch") {
+            std::printf("CORRUPTION: local file [%s] checksum not consistent with iRODS object [%s] checksum.\n", file.path.c_str(), objPath);
+            tmp_status = USER_CHKSUM_MISMATCH;
+        }
+        else if (outcome == "error") {
+            std::printf("ERROR chkObjConsistency: verifyChksumLocFile failed: status [%d] file [%s] objPath [%s] objChksum [%s]\n",
+                        verifyStatus[i], file.path.c_str(), objPath, entry->second.checksum.c_str());
+            tmp_status = verifyStatus[i];
+        }
+
+        if (state) {
+            const bool verified = outcome == "ok" && myRodsArgs->verifyChecksum == True;
+            state->update(file.path, {file.size, file.mtime, verified ? entry->second.checksum : "", outcome});
+        }
+
+        if (status == 0) {
+            status = tmp_status;
+        }
+    }
+
+    // Report replicas whose physical file is gone from a directory that was fully listed.
+    std::unordered_set<std::string> present;
+    for (const auto& file : local.files) {
+        present.insert(file.path);
+    }
+    for (const auto& path : local.skipped) {
+        present.insert(path);
     }
-    catch (const fs::filesystem_error& e) {
-        if (e.code() == std::errc::permission_denied) {
-            rodsLog(LOG_ERROR, "Permission denied: \"%s\"", e.path1().c_str());
+
+    const std::unordered_set<std::string> listed(local.directories.begin(), local.directories.end());
+
+    std::vector<std::string> missing;
+    for (const auto& [path, replica] : remote) {
+        if (present.count(path) == 0 && listed.count(fs::path{path}.parent_path().string()) > 0) {
+            missing.push_back(path);
         }
+    }
+    std::sort(missing.begin(), missing.end());
+
+    for (const auto& path : missing) {
+        std::printf("CORRUPTION: local file [%s] of iRODS object [%s] does not exist.\n", path.c_str(), remote.at(path).logical_path.c_str());
 
-        return e.code().value();
+        if (state) {
+            state->update(path, {0, 0, "", "missing"});
+        }
+
+        if (status == 0) {
+            status = SYS_INTERNAL_ERR;
+        }
+    }
+
+    if (state) {
+        if (const int ec = state->save(); ec < 0 && status == 0) {
+            status = ec;
+        }
     }
 
     return status;
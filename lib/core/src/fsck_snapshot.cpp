@@ -0,0 +1,306 @@
+#include "fsck_snapshot.hpp"
+
+#include "irods_exception.hpp"
+#include "rcMisc.h"
+#include "rodsErrorTable.h"
+#include "rodsGenQuery.h"
+#include "rodsLog.h"
+#include "thread_pool.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <json.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+namespace fs = boost::filesystem;
+
+using json = nlohmann::json;
+
+namespace
+{
+    namespace fsck = irods::experimental::fsck;
+
+    // Replaces the strategy's "= 'path'" condition on DATA_PATH with a prefix match.
+    auto replace_data_path_condition(genQueryInp_t& _input, const std::string& _dir) -> bool
+    {
+        for (int i = 0; i < _input.sqlCondInp.len; ++i) {
+            if (COL_D_DATA_PATH == _input.sqlCondInp.inx[i]) {
+                std::free(_input.sqlCondInp.value[i]);
+                _input.sqlCondInp.value[i] = strdup(("like '" + _dir + "/%'").c_str());
+                return true;
+            }
+        }
+
+        return false;
+    } // replace_data_path_condition
+
+    // Visits the entries of one directory. Subdirectories are posted to the pool so they
+    // are walked in parallel.
+    class walker
+    {
+    public:
+        walker(bool _recursive, int _threads)
+            : recursive_{_recursive}
+            , pool_{_threads}
+            , mutex_{}
+            , result_{}
+        {
+        }
+
+        auto run(const fs::path& _dir) -> fsck::walk_result
+        {
+            irods::thread_pool::post(pool_, [this, _dir] { visit(_dir); });
+            pool_.join();
+
+            std::sort(result_.files.begin(), result_.files.end(), [](const auto& _lhs, const auto& _rhs) {
+                return _lhs.path < _rhs.path;
+            });
+            std::sort(result_.directories.begin(), result_.directories.end());
+            std::sort(result_.skipped.begin(), result_.skipped.end());
+            std::sort(result_.errors.begin(), result_.errors.end());
+
+            return std::move(result_);
+        } // run
+
+    private:
+        auto visit(const fs::path& _dir) -> void
+        {
+            std::vector<fsck::local_file> files;
+            std::vector<std::string> skipped;
+
+            try {
+                for (const auto& e : fs::directory_iterator{_dir}) {
+                    const auto& p = e.path();
+
+                    if (fs::is_symlink(p)) {
+                        skipped.push_back(p.string());
+                    }
+                    else if (fs::is_directory(p)) {
+                        if (recursive_) {
+                            irods::thread_pool::post(pool_, [this, p] { visit(p); });
+                        }
+                        else {
+                            skipped.push_back(p.string());
+                        }
+                    }
+                    else if (fs::is_regular_file(p)) {
+                        files.push_back({p.string(),
+                                         static_cast<rodsLong_t>(fs::file_size(p)),
+                                         static_cast<std::int64_t>(fs::last_write_time(p))});
+                    }
+                    else {
+                        skipped.push_back(p.string());
+                    }
+                }
+            }
+            catch (const fs::filesystem_error& e) {
+                std::lock_guard<std::mutex> lock{mutex_};
+                result_.errors.emplace_back(e.path1().string(), e.code().value());
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock{mutex_};
+            result_.directories.push_back(_dir.string());
+            std::move(files.begin(), files.end(), std::back_inserter(result_.files));
+            std::move(skipped.begin(), skipped.end(), std::back_inserter(result_.skipped));
+        } // visit
+
+        const bool recursive_;
+        irods::thread_pool pool_;
+        std::mutex mutex_;
+        fsck::walk_result result_;
+    }; // class walker
+} // anonymous namespace
+
+namespace irods::experimental::fsck
+{
+    auto fetch_snapshot(rcComm_t& _conn,
+                        const std::string& _dir,
+                        bool _recursive,
+                        SetGenQueryInpFromPhysicalPath _strategy,
+                        const char* _argument) -> snapshot
+    {
+        genQueryInp_t input{};
+        _strategy(&input, _dir.c_str(), _argument);
+
+        if (!replace_data_path_condition(input, _dir)) {
+            clearGenQueryInp(&input);
+            THROW(SYS_INVALID_INPUT_PARAM, "fetch_snapshot: query has no condition on DATA_PATH");
+        }
+
+        if (std::none_of(input.selectInp.inx, input.selectInp.inx + input.selectInp.len, [](int _inx) { return COL_D_DATA_PATH == _inx; })) {
+            addInxIval(&input.selectInp, COL_D_DATA_PATH, 1);
+        }
+
+        input.maxRows = MAX_SQL_ROWS;
+
+        const auto prefix = _dir + '/';
+        snapshot s;
+        genQueryOut_t* output = nullptr;
+        int status = 0;
+
+        while (true) {
+            status = rcGenQuery(&_conn, &input, &output);
+
+            if (status < 0 || !output) {
+                break;
+            }
+
+            auto* path = getSqlResultByInx(output, COL_D_DATA_PATH);
+            auto* data_name = getSqlResultByInx(output, COL_DATA_NAME);
+            auto* coll_name = getSqlResultByInx(output, COL_COLL_NAME);
+            auto* size = getSqlResultByInx(output, COL_DATA_SIZE);
+            auto* checksum = getSqlResultByInx(output, COL_D_DATA_CHECKSUM);
+
+            if (!path || !data_name || !coll_name || !size) {
+                status = SYS_INVALID_INPUT_PARAM;
+                break;
+            }
+
+            for (int i = 0; i < output->rowCnt; ++i) {
+                std::string p = path->value + i * path->len;
+
+                // LIKE treats '_' as a wildcard, so filter out paths outside the directory.
+                if (0 != p.compare(0, prefix.size(), prefix) ||
+                    (!_recursive && std::string::npos != p.find('/', prefix.size()))) {
+                    continue;
+                }
+
+                s.insert_or_assign(std::move(p), replica{std::string{coll_name->value + i * coll_name->len} + '/' + (data_name->value + i * data_name->len),
+                                                         std::strtoll(size->value + i * size->len, nullptr, 10),
+                                                         checksum ? checksum->value + i * checksum->len : ""});
+            }
+
+            input.continueInx = output->continueInx;
+            freeGenQueryOut(&output);
+
+            if (0 == input.continueInx) {
+                break;
+            }
+        }
+
+        // Close the statement on the server if the loop ended early.
+        if (input.continueInx > 0) {
+            input.maxRows = 0;
+            if (0 == rcGenQuery(&_conn, &input, &output)) {
+                freeGenQueryOut(&output);
+            }
+        }
+
+        freeGenQueryOut(&output);
+        clearGenQueryInp(&input);
+
+        if (status < 0 && CAT_NO_ROWS_FOUND != status) {
+            THROW(status, "fetch_snapshot: query failed for " + _dir);
+        }
+
+        return s;
+    } // fetch_snapshot
+
+    auto walk(const std::string& _dir, bool _recursive, int _threads) -> walk_result
+    {
+        return walker{_recursive, std::max(1, _threads)}.run(_dir);
+    } // walk
+
+    throttle::throttle(rodsLong_t _bytes_per_second)
+        : bytes_per_second_{_bytes_per_second}
+        , mutex_{}
+        , next_start_{std::chrono::steady_clock::now()}
+    {
+    }
+
+    auto throttle::acquire(rodsLong_t _size) -> void
+    {
+        if (bytes_per_second_ <= 0) {
+            return;
+        }
+
+        using namespace std::chrono;
+
+        steady_clock::time_point start;
+
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            start = std::max(next_start_, steady_clock::now());
+            next_start_ = start + duration_cast<steady_clock::duration>(duration<double>(double(_size) / bytes_per_second_));
+        }
+
+        std::this_thread::sleep_until(start);
+    } // throttle::acquire
+
+    state_file::state_file(std::string _path)
+        : path_{std::move(_path)}
+        , records_{}
+    {
+        std::ifstream in{path_};
+
+        for (std::string line; std::getline(in, line);) {
+            try {
+                const auto j = json::parse(line);
+                records_.insert_or_assign(j.at("path").get<std::string>(),
+                                          record{j.at("size").get<rodsLong_t>(),
+                                                 j.at("mtime").get<std::int64_t>(),
+                                                 j.at("checksum").get<std::string>(),
+                                                 j.at("status").get<std::string>()});
+            }
+            catch (const json::exception&) {
+                rodsLog(LOG_DEBUG, "state_file: ignoring malformed line in %s", path_.c_str());
+            }
+        }
+    } // state_file::state_file
+
+    auto state_file::verified(const std::string& _path, const local_file& _file, const std::string& _checksum) const -> bool
+    {
+        const auto iter = records_.find(_path);
+
+        if (iter == records_.end()) {
+            return false;
+        }
+
+        const auto& r = iter->second;
+
+        return "ok" == r.status && !_checksum.empty() && _checksum == r.checksum &&
+               _file.size == r.size && _file.mtime == r.mtime;
+    } // state_file::verified
+
+    auto state_file::update(const std::string& _path, record _record) -> void
+    {
+        records_.insert_or_assign(_path, std::move(_record));
+    } // state_file::update
+
+    auto state_file::save() const -> int
+    {
+        const auto tmp = path_ + ".tmp";
+
+        {
+            std::ofstream out{tmp, std::ios::trunc};
+
+            for (const auto& [path, r] : records_) {
+                out << json{{"path", path},
+                            {"size", r.size},
+                            {"mtime", r.mtime},
+                            {"checksum", r.checksum},
+                            {"status", r.status}}.dump() << '\n';
+            }
+
+            if (!out.flush()) {
+                rodsLog(LOG_ERROR, "state_file: could not write %s", tmp.c_str());
+                return UNIX_FILE_WRITE_ERR;
+            }
+        }
+
+        if (std::rename(tmp.c_str(), path_.c_str()) != 0) {
+            rodsLog(LOG_ERROR, "state_file: could not rename %s to %s, errno = %d", tmp.c_str(), path_.c_str(), errno);
+            return UNIX_FILE_RENAME_ERR - errno;
+        }
+
+        return 0;
+    } // state_file::save
+} // namespace irods::experimental::fsck
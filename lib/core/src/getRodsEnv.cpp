@@ -186,6 +186,11 @@ extern "C" {
         _env->irodsDefaultNumberTransferThreads = 4;
         _env->irodsTransBufferSizeForParaTrans  = 4;
         _env->irodsConnectionPoolRefreshTime    = 300;
+        _env->irodsParallelTransferFiles        = 1;
+        _env->irodsTransferThreadBudget         = 0;
+        _env->irodsMaxBandwidthForTransfer      = 0;
+        _env->irodsFsckThreads                  = 0;
+        _env->irodsFsckMaxReadBandwidth         = 0;
 
         // default auth scheme
         snprintf(
@@ -345,6 +350,30 @@ extern "C" {
             irods::CFG_IRODS_CONNECTION_POOL_REFRESH_TIME,
             _env->irodsConnectionPoolRefreshTime );
 
+        capture_integer_property(
+            irods::CFG_IRODS_PARALLEL_TRANSFER_FILES,
+            _env->irodsParallelTransferFiles );
+
+        capture_integer_property(
+            irods::CFG_IRODS_TRANSFER_THREAD_BUDGET,
+            _env->irodsTransferThreadBudget );
+
+        capture_integer_property(
+            irods::CFG_IRODS_MAX_BANDWIDTH_FOR_TRANSFER,
+            _env->irodsMaxBandwidthForTransfer );
+
+        capture_integer_property(
+            irods::CFG_IRODS_FSCK_THREADS,
+            _env->irodsFsckThreads );
+
+        capture_integer_property(
+            irods::CFG_IRODS_FSCK_MAX_READ_BANDWIDTH,
+            _env->irodsFsckMaxReadBandwidth );
+
+        capture_string_property(
+            irods::CFG_IRODS_FSCK_STATE_FILE,
+            _env->irodsFsckStateFile );
+
         capture_string_property(
             irods::CFG_IRODS_PLUGINS_HOME_KW,
             _env->irodsPluginHome );
@@ -621,6 +650,36 @@ extern "C" {
             env_var,
             _env->irodsTransBufferSizeForParaTrans );
 
+        env_var = irods::CFG_IRODS_PARALLEL_TRANSFER_FILES;
+        capture_integer_env_var(
+            env_var,
+            _env->irodsParallelTransferFiles );
+
+        env_var = irods::CFG_IRODS_TRANSFER_THREAD_BUDGET;
+        capture_integer_env_var(
+            env_var,
+            _env->irodsTransferThreadBudget );
+
+        env_var = irods::CFG_IRODS_MAX_BANDWIDTH_FOR_TRANSFER;
+        capture_integer_env_var(
+            env_var,
+            _env->irodsMaxBandwidthForTransfer );
+
+        env_var = irods::CFG_IRODS_FSCK_THREADS;
+        capture_integer_env_var(
+            env_var,
+            _env->irodsFsckThreads );
+
+        env_var = irods::CFG_IRODS_FSCK_MAX_READ_BANDWIDTH;
+        capture_integer_env_var(
+            env_var,
+            _env->irodsFsckMaxReadBandwidth );
+
+        env_var = irods::CFG_IRODS_FSCK_STATE_FILE;
+        capture_string_env_var(
+            env_var,
+            _env->irodsFsckStateFile );
+
         env_var = irods::CFG_IRODS_PLUGINS_HOME_KW;
         capture_string_env_var(
             env_var,
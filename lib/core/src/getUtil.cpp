@@ -12,6 +12,59 @@
 #include "rcPortalOpr.h"
 #include "sockComm.h"
 #include "rcGlobalExtern.h"
+#include "transfer_scheduler.hpp"
+
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace
+{
+    int getCollUtilImpl( rcComm_t **myConn, char *srcColl, char *targDir,
+                         rodsEnv *myRodsEnv, rodsArguments_t *rodsArgs, dataObjInp_t *dataObjOprInp,
+                         rodsRestart_t *rodsRestart,
+                         irods::experimental::transfer_scheduler& scheduler );
+
+    // Hands one data object of a collection walk to the scheduler. The transfer works
+    // on its own copy of dataObjOprInp because it may run on another thread after the
+    // walk has moved on.
+    int scheduleGetDataObj( irods::experimental::transfer_scheduler& scheduler,
+                            const char *srcPath, const char *targPath, rodsLong_t srcSize,
+                            uint dataMode, rodsArguments_t *rodsArgs,
+                            dataObjInp_t *dataObjOprInp, rodsRestart_t *rodsRestart )
+    {
+        std::shared_ptr<dataObjInp_t> dataObjInp{new dataObjInp_t{}, []( dataObjInp_t *p ) {
+            clearDataObjInp( p );
+            delete p;
+        }};
+        replDataObjInp( dataObjOprInp, dataObjInp.get() );
+
+        std::string src = srcPath;
+        std::string targ = targPath;
+
+        auto transfer = [=]( rcComm_t& conn, int numThreads ) mutable {
+            dataObjInp->numThreads = numThreads;
+            int status = getDataObjUtil( &conn, src.data(), targ.data(), srcSize,
+                                         dataMode, rodsArgs, dataObjInp.get() );
+            if ( status < 0 ) {
+                rodsLogError( LOG_ERROR, status,
+                              "getCollUtil: getDataObjUtil failed for %s. status = %d",
+                              src.c_str(), status );
+            }
+            return status;
+        };
+
+        return scheduler.schedule( srcSize, transfer, [rodsRestart, targ]() mutable {
+            int status = procAndWriteRestartFile( rodsRestart, targ.data() );
+            if ( status < 0 ) {
+                rodsLogError( LOG_ERROR, status,
+                              "getCollUtil: procAndWriteRestartFile failed for %s. status = %d",
+                              targ.c_str(), status );
+            }
+            return status;
+        } );
+    }
+} // anonymous namespace
 
 int
 setSessionTicket( rcComm_t *myConn, char *ticket ) {
@@ -109,6 +162,23 @@ getUtil( rcComm_t **myConn, rodsEnv *myRodsEnv, rodsArguments_t *myRodsArgs,
         }
     }
 
+    // Data objects found by walking collections may be transferred concurrently.
+    // Redirected connections and large file restarts are tied to the caller's
+    // connection, so they keep transferring one file at a time.
+    auto schedulerOptions = irods::experimental::transfer_scheduler::make_options(
+                                *myRodsEnv, dataObjOprInp.numThreads );
+    if ( conn->fileRestart.flags == FILE_RESTART_ON || myRodsArgs->redirectConn == True ) {
+        schedulerOptions.max_files = 1;
+    }
+    schedulerOptions.stop_on_error = rodsRestart.fd > 0;
+
+    std::optional<irods::experimental::transfer_scheduler> scheduler;
+    scheduler.emplace( myConn, schedulerOptions, [myRodsArgs]( rcComm_t& workerConn ) {
+        if ( myRodsArgs->ticket == True ) {
+            setSessionTicket( &workerConn, myRodsArgs->ticketString );
+        }
+    } );
+
     for ( i = 0; i < rodsPathInp->numSrc; i++ ) {
         targPath = &rodsPathInp->targPath[i];
 
@@ -130,9 +200,13 @@ getUtil( rcComm_t **myConn, rodsEnv *myRodsEnv, rodsArguments_t *myRodsArgs,
         else if ( targPath->objType ==  LOCAL_DIR_T ) {
             setStateForRestart( &rodsRestart, targPath, myRodsArgs );
             addKeyVal( &dataObjOprInp.condInput, TRANSLATED_PATH_KW, "" );
-            status = getCollUtil( myConn, rodsPathInp->srcPath[i].outPath,
-                                  targPath->outPath, myRodsEnv, myRodsArgs, &dataObjOprInp,
-                                  &rodsRestart );
+            status = getCollUtilImpl( myConn, rodsPathInp->srcPath[i].outPath,
+                                      targPath->outPath, myRodsEnv, myRodsArgs, &dataObjOprInp,
+                                      &rodsRestart, *scheduler );
+            int transferStatus = scheduler->wait();
+            if ( transferStatus < 0 && status >= 0 ) {
+                status = transferStatus;
+            }
         }
         else {
             /* should not be here */
@@ -151,6 +225,8 @@ getUtil( rcComm_t **myConn, rodsEnv *myRodsEnv, rodsArguments_t *myRodsArgs,
         }
     }
 
+    scheduler.reset();
+
     if ( rodsRestart.fd > 0 ) {
         close( rodsRestart.fd );
     }
@@ -413,6 +489,22 @@ int
 getCollUtil( rcComm_t **myConn, char *srcColl, char *targDir,
              rodsEnv *myRodsEnv, rodsArguments_t *rodsArgs, dataObjInp_t *dataObjOprInp,
              rodsRestart_t *rodsRestart ) {
+    /* one file at a time on the caller's connection */
+    irods::experimental::transfer_scheduler::options options;
+    options.requested_threads = dataObjOprInp->numThreads;
+    irods::experimental::transfer_scheduler scheduler{ myConn, options };
+
+    return getCollUtilImpl( myConn, srcColl, targDir, myRodsEnv, rodsArgs,
+                            dataObjOprInp, rodsRestart, scheduler );
+}
+
+namespace
+{
+int
+getCollUtilImpl( rcComm_t **myConn, char *srcColl, char *targDir,
+                 rodsEnv *myRodsEnv, rodsArguments_t *rodsArgs, dataObjInp_t *dataObjOprInp,
+                 rodsRestart_t *rodsRestart,
+                 irods::experimental::transfer_scheduler& scheduler ) {
     int status = 0;
     int savedStatus = 0;
     char srcChildPath[MAX_NAME_LEN], targChildPath[MAX_NAME_LEN];
@@ -481,26 +573,15 @@ getCollUtil( rcComm_t **myConn, char *srcColl, char *targDir,
                 continue;
             }
 
-            status = getDataObjUtil( conn, srcChildPath, targChildPath, mySize,
-                                     collEnt.dataMode, rodsArgs, dataObjOprInp );
+            /* failures are reported by the transfer */
+            status = scheduleGetDataObj( scheduler, srcChildPath, targChildPath, mySize,
+                                         collEnt.dataMode, rodsArgs, dataObjOprInp, rodsRestart );
             if ( status < 0 ) {
-                rodsLogError( LOG_ERROR, status,
-                              "getCollUtil: getDataObjUtil failed for %s. status = %d",
-                              srcChildPath, status );
                 savedStatus = status;
                 if ( rodsRestart->fd > 0 ) {
                     break;
                 }
             }
-            else {
-                status = procAndWriteRestartFile( rodsRestart, targChildPath );
-                if ( status < 0 ) {
-                    rodsLogError( LOG_ERROR, status,
-                                "getCollUtil: procAndWriteRestartFile failed for %s. status = %d",
-                                targChildPath, status );
-                    savedStatus = status;
-                }
-            }
         }
         else if ( collEnt.objType == COLL_OBJ_T ) {
             if ( ( status = splitPathByKey(
@@ -523,8 +604,9 @@ getCollUtil( rcComm_t **myConn, char *srcColl, char *targDir,
             else {
                 childDataObjInp.specColl = NULL;
             }
-            int status = getCollUtil( myConn, collEnt.collName, targChildPath,
-                                  myRodsEnv, rodsArgs, &childDataObjInp, rodsRestart );
+            int status = getCollUtilImpl( myConn, collEnt.collName, targChildPath,
+                                          myRodsEnv, rodsArgs, &childDataObjInp, rodsRestart,
+                                          scheduler );
             if ( status < 0 && status != CAT_NO_ROWS_FOUND ) {
                 rodsLogError( LOG_ERROR, status,
                               "getCollUtil: getCollUtil failed for %s. status = %d",
@@ -549,4 +631,4 @@ getCollUtil( rcComm_t **myConn, char *srcColl, char *targDir,
         return status;
     }
 }
-
+} // anonymous namespace
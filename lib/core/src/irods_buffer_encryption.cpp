@@ -1,6 +1,7 @@
 // =-=-=-=-=-=-=-
 #include "irods_buffer_encryption.hpp"
 #include "irods_log.hpp"
+#include "rodsErrorTable.h"
 
 // =-=-=-=-=-=-=-
 // ssl includes
@@ -9,11 +10,29 @@
 #include <openssl/aes.h>
 #include <openssl/md5.h>
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <memory>
 
+namespace {
+    // =-=-=-=-=-=-=-
+    // AEAD nonces are a random prefix followed by a big
+    // endian counter.  the prefix is wide enough that the
+    // many instances sharing one connection key do not
+    // collide, the counter is renewed with the prefix.
+    const int nonce_prefix_size  = 8;
+    const int nonce_counter_size = 4;
+
+    irods::error openssl_error( const std::string& _function ) {
+        const auto code = ERR_get_error();
+        char err[ 256 ];
+        ERR_error_string_n( code, err, sizeof( err ) );
+        return ERROR( code, "failed in " + _function + " - " + err );
+    }
+}
+
 namespace irods {
     class evp_lifetime_mgr {
     public:
@@ -50,7 +69,9 @@ namespace irods {
         key_size_( 32 ),
         salt_size_( 8 ),
         num_hash_rounds_( 16 ),
-        algorithm_( "aes-256-cbc" ) {
+        algorithm_( "aes-256-cbc" ),
+        cipher_( nullptr ),
+        nonce_counter_( 0 ) {
     }
 
     buffer_crypt::buffer_crypt(
@@ -61,7 +82,9 @@ namespace irods {
         key_size_( _key_sz ),
         salt_size_( _salt_sz ),
         num_hash_rounds_( _num_rnds ),
-        algorithm_( _algo ) {
+        algorithm_( _algo ),
+        cipher_( nullptr ),
+        nonce_counter_( 0 ) {
 
         std::transform(
             algorithm_.begin(),
@@ -88,11 +111,93 @@ namespace irods {
         }
     } // ctor
 
+    buffer_crypt::buffer_crypt( const buffer_crypt& _rhs ) :
+        key_size_( _rhs.key_size_ ),
+        salt_size_( _rhs.salt_size_ ),
+        num_hash_rounds_( _rhs.num_hash_rounds_ ),
+        algorithm_( _rhs.algorithm_ ),
+        cipher_( nullptr ),
+        nonce_counter_( 0 ) {
+    } // cctor
+
+    buffer_crypt& buffer_crypt::operator=( const buffer_crypt& _rhs ) {
+        if ( this != &_rhs ) {
+            key_size_        = _rhs.key_size_;
+            salt_size_       = _rhs.salt_size_;
+            num_hash_rounds_ = _rhs.num_hash_rounds_;
+            algorithm_       = _rhs.algorithm_;
+            cipher_          = nullptr;
+            context_.reset();
+            nonce_prefix_.clear();
+            nonce_counter_   = 0;
+        }
+
+        return *this;
+    } // operator=
+
 // =-=-=-=-=-=-=-
 // public - destructor
     buffer_crypt::~buffer_crypt() {
     } // dtor
 
+// =-=-=-=-=-=-=-
+// private - look up the cipher once per instance
+    const EVP_CIPHER* buffer_crypt::cipher() {
+        if ( !cipher_ ) {
+            cipher_ = EVP_get_cipherbyname( algorithm_.c_str() );
+            if ( !cipher_ ) {
+                rodsLog(
+                    LOG_NOTICE,
+                    "buffer_crypt - algorithm not supported [%s]",
+                    algorithm_.c_str() );
+                // default to aes 256 cbc
+                cipher_ = EVP_aes_256_cbc();
+            }
+        }
+
+        return cipher_;
+    } // cipher
+
+// =-=-=-=-=-=-=-
+// public - true if the cipher carries an authentication tag
+    bool buffer_crypt::is_aead() {
+        return 0 != ( EVP_CIPHER_flags( cipher() ) & EVP_CIPH_FLAG_AEAD_CIPHER );
+    } // is_aead
+
+// =-=-=-=-=-=-=-
+// private - prepare the context for the next buffer.  the cipher
+//           is only bound once so that its state is not rebuilt
+//           for every buffer of a transfer
+    irods::error buffer_crypt::init_context(
+        const array_t& _key,
+        const array_t& _iv,
+        int            _encrypt ) {
+        const EVP_CIPHER* algo = cipher();
+
+        if ( _key.size() < static_cast< size_t >( EVP_CIPHER_key_length( algo ) ) ||
+             _iv.size()  < static_cast< size_t >( EVP_CIPHER_iv_length( algo ) ) ) {
+            return ERROR( SYS_INVALID_INPUT_PARAM, "key or initialization vector too short for " + algorithm_ );
+        }
+
+        if ( !context_ ) {
+            context_.reset( EVP_CIPHER_CTX_new() );
+            if ( !context_ ) {
+                return openssl_error( "EVP_CIPHER_CTX_new" );
+            }
+
+            if ( 0 == EVP_CipherInit_ex( context_.get(), algo, NULL, NULL, NULL, _encrypt ) ) {
+                context_.reset();
+                return openssl_error( "EVP_CipherInit_ex" );
+            }
+        }
+
+        if ( 0 == EVP_CipherInit_ex( context_.get(), NULL, NULL, &_key[0], &_iv[0], _encrypt ) ) {
+            return openssl_error( "EVP_CipherInit_ex" );
+        }
+
+        return SUCCESS();
+    } // init_context
+
 // =-=-=-=-=-=-=-
 // public static - generate a random key
     irods::error buffer_crypt::generate_key(
@@ -130,34 +235,45 @@ namespace irods {
     } // buffer_crypt::hex_encode
 
 // =-=-=-=-=-=-=-
-// public - create a hashed key and initialization vector
+// public - create an initialization vector for the next buffer
     irods::error buffer_crypt::initialization_vector(
         array_t& _out_iv ) {
-        // =-=-=-=-=-=-=-
-        // generate a random initialization vector
-        unsigned char* iv = new unsigned char[ key_size_ ];
-        int rnd_err = RAND_bytes(
-                          iv,
-                          key_size_ );
-        if ( 1 != rnd_err ) {
-            delete [] iv;
-            char err[ 256 ];
-            ERR_error_string_n( ERR_get_error(), err, 256 );
-            std::string msg( "failed in RAND_bytes - " );
-            msg += err;
-            return ERROR( ERR_get_error(), msg );
+        if ( !is_aead() ) {
+            // =-=-=-=-=-=-=-
+            // generate a random initialization vector
+            _out_iv.resize( key_size_ );
+            if ( 1 != RAND_bytes( &_out_iv[0], key_size_ ) ) {
+                return openssl_error( "RAND_bytes" );
+            }
+
+            return SUCCESS();
+        }
 
+        if ( key_size_ < nonce_prefix_size + nonce_counter_size ) {
+            return ERROR( SYS_INVALID_INPUT_PARAM, "key size too small for the nonce of " + algorithm_ );
         }
 
         // =-=-=-=-=-=-=-
-        // copy the iv to the out variable
-        _out_iv.assign(
-            &iv[0],
-            &iv[ key_size_ ] );
+        // a nonce must never repeat under the same key, so draw
+        // a new prefix before the counter wraps
+        if ( nonce_prefix_.empty() || 0 == nonce_counter_ ) {
+            nonce_prefix_.resize( nonce_prefix_size );
+            if ( 1 != RAND_bytes( &nonce_prefix_[0], nonce_prefix_size ) ) {
+                nonce_prefix_.clear();
+                return openssl_error( "RAND_bytes" );
+            }
+        }
 
         // =-=-=-=-=-=-=-
-        // clean up
-        delete [] iv;
+        // the vector keeps its key_size() length so that the
+        // framing of the transfer does not depend on the algorithm
+        _out_iv.assign( key_size_, 0 );
+        std::copy( nonce_prefix_.begin(), nonce_prefix_.end(), _out_iv.begin() );
+        for ( int i = 0; i < nonce_counter_size; ++i ) {
+            _out_iv[ nonce_prefix_size + i ] = static_cast< unsigned char >( nonce_counter_ >> ( 8 * ( nonce_counter_size - 1 - i ) ) );
+        }
+
+        ++nonce_counter_;
 
         return SUCCESS();
 
@@ -170,86 +286,73 @@ namespace irods {
         const array_t& _iv,
         const array_t& _in_buf,
         array_t&       _out_buf ) {
+        return encrypt(
+                   _key,
+                   _iv,
+                   _in_buf.empty() ? NULL : &_in_buf[0],
+                   _in_buf.size(),
+                   _out_buf );
 
-        // =-=-=-=-=-=-=-
-        // create an encryption context
-        auto* context = EVP_CIPHER_CTX_new();
-
-        auto* algo = EVP_get_cipherbyname( algorithm_.c_str() );
-        if ( !algo ) {
-            rodsLog(
-                LOG_NOTICE,
-                "buffer_crypt::encrypt - algorithm not supported [%s]",
-                algorithm_.c_str() );
-            // default to aes 256 cbc
-            algo = EVP_aes_256_cbc();
-        }
+    } // encrypt
 
-        int ret = EVP_EncryptInit_ex(
-                      context,
-                      algo,
-                      NULL,
-                      &_key[0],
-                      &_iv[0] );
-        if ( 0 == ret ) {
-            char err[ 256 ];
-            ERR_error_string_n( ERR_get_error(), err, 256 );
-            std::string msg( "failed in EVP_EncryptInit_ex - " );
-            msg += err;
-            return ERROR( ERR_get_error(), msg );
+    irods::error buffer_crypt::encrypt(
+        const array_t&       _key,
+        const array_t&       _iv,
+        const unsigned char* _in_buf,
+        int                  _in_len,
+        array_t&             _out_buf ) {
+
+        irods::error ret = init_context( _key, _iv, 1 );
+        if ( !ret.ok() ) {
+            return PASS( ret );
         }
 
+        const bool aead = is_aead();
 
         // =-=-=-=-=-=-=-
-        // max ciphertext len for a n bytes of plaintext is n + AES_BLOCK_SIZE -1 bytes
-        int            cipher_len  = _in_buf.size() + AES_BLOCK_SIZE;
-        unsigned char* cipher_text = new unsigned char[ cipher_len ] ;
+        // max ciphertext len for a n bytes of plaintext is n + AES_BLOCK_SIZE -1 bytes,
+        // AEAD algorithms add their tag
+        _out_buf.resize( _in_len + AES_BLOCK_SIZE + ( aead ? aead_tag_size : 0 ) );
+
         // =-=-=-=-=-=-=-
         // update ciphertext, cipher_len is filled with the length of ciphertext generated,
-        ret = EVP_EncryptUpdate(
-                  context,
-                  cipher_text,
-                  &cipher_len,
-                  &_in_buf[0],
-                  _in_buf.size() );
-        if ( 0 == ret ) {
-            delete [] cipher_text;
-            char err[ 256 ];
-            ERR_error_string_n( ERR_get_error(), err, 256 );
-            std::string msg( "failed in EVP_EncryptUpdate - " );
-            msg += err;
-            return ERROR( ERR_get_error(), msg );
+        int cipher_len = 0;
+        if ( 0 == EVP_EncryptUpdate(
+                    context_.get(),
+                    &_out_buf[0],
+                    &cipher_len,
+                    _in_buf,
+                    _in_len ) ) {
+            return openssl_error( "EVP_EncryptUpdate" );
         }
 
         // =-=-=-=-=-=-=-
         // update ciphertext with the final remaining bytes
         int final_len = 0;
-        ret = EVP_EncryptFinal_ex(
-                  context,
-                  cipher_text + cipher_len,
-                  &final_len );
-        if ( 0 == ret ) {
-            delete [] cipher_text;
-            char err[ 256 ];
-            ERR_error_string_n( ERR_get_error(), err, 256 );
-            std::string msg( "failed in EVP_EncryptFinal_ex - " );
-            msg += err;
-            return ERROR( ERR_get_error(), msg );
+        if ( 0 == EVP_EncryptFinal_ex(
+                    context_.get(),
+                    &_out_buf[ cipher_len ],
+                    &final_len ) ) {
+            return openssl_error( "EVP_EncryptFinal_ex" );
         }
 
-        // =-=-=-=-=-=-=-
-        // clean up and assign out variables before exit
-        _out_buf.resize( cipher_len + final_len );
+        cipher_len += final_len;
 
         // =-=-=-=-=-=-=-
-        // copy the iv to the out variable
-        _out_buf.assign(
-            &cipher_text[0],
-            &cipher_text[ cipher_len + final_len ] );
-
-        delete [] cipher_text;
+        // append the authentication tag
+        if ( aead ) {
+            if ( 0 == EVP_CIPHER_CTX_ctrl(
+                        context_.get(),
+                        EVP_CTRL_GCM_GET_TAG,
+                        aead_tag_size,
+                        &_out_buf[ cipher_len ] ) ) {
+                return openssl_error( "EVP_CIPHER_CTX_ctrl" );
+            }
+
+            cipher_len += aead_tag_size;
+        }
 
-        EVP_CIPHER_CTX_free( context );
+        _out_buf.resize( cipher_len );
 
         return SUCCESS();
 
@@ -262,83 +365,61 @@ namespace irods {
         const array_t& _iv,
         const array_t& _in_buf,
         array_t&       _out_buf ) {
-        // =-=-=-=-=-=-=-
-        // create an decryption context
-        auto* context = EVP_CIPHER_CTX_new();
-
-        auto* algo = EVP_get_cipherbyname( algorithm_.c_str() );
-        if ( !algo ) {
-            rodsLog(
-                LOG_NOTICE,
-                "buffer_crypt::decrypt - algorithm not supported [%s]",
-                algorithm_.c_str() );
-            // default to aes 256 cbc
-            algo = EVP_aes_256_cbc();
+
+        irods::error ret = init_context( _key, _iv, 0 );
+        if ( !ret.ok() ) {
+            return PASS( ret );
         }
 
-        int ret = EVP_DecryptInit_ex(
-                      context,
-                      algo,
-                      NULL,
-                      &_key[0],
-                      &_iv [0] );
-        if ( 0 == ret ) {
-            char err[ 256 ];
-            ERR_error_string_n( ERR_get_error(), err, 256 );
-            std::string msg( "failed in EVP_DecryptInit_ex - " );
-            msg += err;
-            return ERROR( ERR_get_error(), msg );
+        // =-=-=-=-=-=-=-
+        // split off the authentication tag
+        int cipher_len = _in_buf.size();
+        if ( is_aead() ) {
+            if ( cipher_len < aead_tag_size ) {
+                return ERROR( SYS_COPY_LEN_ERR, "cipher text is shorter than the authentication tag" );
+            }
+
+            cipher_len -= aead_tag_size;
+
+            if ( 0 == EVP_CIPHER_CTX_ctrl(
+                        context_.get(),
+                        EVP_CTRL_GCM_SET_TAG,
+                        aead_tag_size,
+                        const_cast< unsigned char* >( &_in_buf[ cipher_len ] ) ) ) {
+                return openssl_error( "EVP_CIPHER_CTX_ctrl" );
+            }
         }
 
         // =-=-=-=-=-=-=-
         // allocate a plain text buffer
         // because we have padding ON, we must allocate an extra cipher block size of memory
-        int            plain_len  = 0;
-        auto plain_text = std::make_unique<unsigned char[]>(_in_buf.size() + AES_BLOCK_SIZE);
+        _out_buf.resize( cipher_len + AES_BLOCK_SIZE );
 
         // =-=-=-=-=-=-=-
         // update the plain text, plain_len is filled with the length of the plain text
-        ret = EVP_DecryptUpdate(
-                  context,
-                  plain_text.get(),
-                  &plain_len,
-                  &_in_buf[0],
-                  _in_buf.size() );
-        if ( 0 == ret ) {
-            char err[ 256 ];
-            ERR_error_string_n( ERR_get_error(), err, 256 );
-            std::string msg( "failed in EVP_DecryptUpdate - " );
-            msg += err;
-            return ERROR( ERR_get_error(), msg );
+        int plain_len = 0;
+        if ( 0 == EVP_DecryptUpdate(
+                    context_.get(),
+                    &_out_buf[0],
+                    &plain_len,
+                    _in_buf.empty() ? NULL : &_in_buf[0],
+                    cipher_len ) ) {
+            return openssl_error( "EVP_DecryptUpdate" );
         }
 
         // =-=-=-=-=-=-=-
-        // finalize the plain text, final_len is filled with the resulting length of the plain text
+        // finalize the plain text, final_len is filled with the resulting length of the plain text.
+        // for AEAD algorithms this is where the tag is verified
         int final_len = 0;
-        ret = EVP_DecryptFinal_ex(
-                  context,
-                  plain_text.get() + plain_len,
-                  &final_len );
-        if ( 0 == ret ) {
-            char err[ 256 ];
-            ERR_error_string_n( ERR_get_error(), err, 256 );
-            std::string msg( "failed in EVP_DecryptFinal_ex - " );
-            msg += err;
-            return ERROR( ERR_get_error(), msg );
+        if ( 0 == EVP_DecryptFinal_ex(
+                    context_.get(),
+                    &_out_buf[ plain_len ],
+                    &final_len ) ) {
+            return openssl_error( "EVP_DecryptFinal_ex" );
         }
 
-        // =-=-=-=-=-=-=-
-        // assign the plain text to the outvariable and clean up
         _out_buf.resize( plain_len + final_len );
 
-        // =-=-=-=-=-=-=-
-        // copy the iv to the out variable
-        _out_buf.assign(
-            plain_text.get(),
-            plain_text.get() + plain_len + final_len );
-
-        EVP_CIPHER_CTX_free( context );
-
         return SUCCESS();
 
     } // decrypt
@@ -9,6 +9,7 @@ namespace irods
     const std::string CFG_PAM_NO_EXTEND_KW( "no_extend" );
     const std::string CFG_PAM_PASSWORD_MIN_TIME_KW( "password_min_time" );
     const std::string CFG_PAM_PASSWORD_MAX_TIME_KW( "password_max_time" );
+    const std::string CFG_PAM_HELPER_WORKER_COUNT_KW( "helper_worker_count" );
 
     const std::string CFG_DB_USERNAME_KW( "db_username" );
     const std::string CFG_DB_PASSWORD_KW( "db_password" );
@@ -61,6 +62,10 @@ namespace irods
     const std::string CFG_MAX_TEMP_PASSWORD_LIFETIME( "maximum_temporary_password_lifetime_in_seconds" );
     const std::string CFG_MAX_NUMBER_OF_CONCURRENT_RE_PROCS( "maximum_number_of_concurrent_rule_engine_server_processes" );
     const std::string DEFAULT_LOG_ROTATION_IN_DAYS("default_log_rotation_in_days");
+    const std::string CFG_BULK_DELETE_BATCH_SIZE("bulk_delete_batch_size_in_data_objects");
+    const std::string CFG_BULK_DELETE_NUMBER_OF_THREADS("bulk_delete_number_of_threads");
+    const std::string CFG_BULK_REGISTRATION_BATCH_SIZE("bulk_registration_batch_size_in_data_objects");
+    const std::string CFG_BULK_REGISTRATION_NUMBER_OF_THREADS("bulk_registration_number_of_threads");
 
     const std::string CFG_RE_CACHE_SALT_KW("reCacheSalt");
     const std::string CFG_RE_SERVER_SLEEP_TIME( "rule_engine_server_sleep_time_in_seconds");
@@ -68,9 +73,16 @@ namespace irods
 
     const std::string CFG_DNS_CACHE_KW("dns_cache");
     const std::string CFG_HOSTNAME_CACHE_KW("hostname_cache");
+    const std::string CFG_SERVER_LOAD_TABLE_KW("server_load_table");
+    const std::string CFG_RESOURCE_HIERARCHY_CACHE_KW("resource_hierarchy_cache");
+    const std::string CFG_ACCESS_VERDICT_CACHE_KW("access_verdict_cache");
 
     const std::string CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW("shared_memory_size_in_bytes");
     const std::string CFG_EVICTION_AGE_IN_SECONDS_KW("eviction_age_in_seconds");
+    const std::string CFG_SAMPLE_INTERVAL_IN_SECONDS_KW("sample_interval_in_seconds");
+    const std::string CFG_REFRESH_INTERVAL_IN_SECONDS_KW("refresh_interval_in_seconds");
+    const std::string CFG_TIME_TO_LIVE_IN_SECONDS_KW("time_to_live_in_seconds");
+    const std::string CFG_MAXIMUM_ENTRIES_PER_AGENT_KW("maximum_entries_per_agent");
 
     // service_account_environment.json keywords
     const std::string CFG_IRODS_USER_NAME_KW( "irods_user_name" );
@@ -110,6 +122,12 @@ namespace irods
     const std::string CFG_IRODS_MAX_NUMBER_TRANSFER_THREADS( "irods_maximum_number_of_transfer_threads" );
     const std::string CFG_IRODS_TRANS_BUFFER_SIZE_FOR_PARA_TRANS( "irods_transfer_buffer_size_for_parallel_transfer_in_megabytes" );
     const std::string CFG_IRODS_CONNECTION_POOL_REFRESH_TIME( "irods_connection_pool_refresh_time_in_seconds");
+    const std::string CFG_IRODS_PARALLEL_TRANSFER_FILES( "irods_number_of_files_to_transfer_in_parallel" );
+    const std::string CFG_IRODS_TRANSFER_THREAD_BUDGET( "irods_maximum_number_of_transfer_threads_for_all_files" );
+    const std::string CFG_IRODS_MAX_BANDWIDTH_FOR_TRANSFER( "irods_maximum_transfer_bandwidth_in_megabytes_per_second" );
+    const std::string CFG_IRODS_FSCK_THREADS( "irods_fsck_number_of_threads" );
+    const std::string CFG_IRODS_FSCK_MAX_READ_BANDWIDTH( "irods_fsck_maximum_read_bandwidth_in_megabytes_per_second" );
+    const std::string CFG_IRODS_FSCK_STATE_FILE( "irods_fsck_state_file" );
 
     // legacy ssl environment variables
     const std::string CFG_IRODS_SSL_CA_CERTIFICATE_PATH( "irods_ssl_ca_certificate_path" );
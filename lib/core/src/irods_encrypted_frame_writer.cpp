@@ -0,0 +1,145 @@
+#include "irods_encrypted_frame_writer.hpp"
+
+#include "rcMisc.h"
+#include "rodsErrorTable.h"
+
+#include <algorithm>
+#include <cerrno>
+
+namespace
+{
+    auto write_all(int _socket, const void* _buffer, int _length) -> irods::error
+    {
+        int bytes_written = 0;
+
+        if (myWrite(_socket, const_cast<void*>(_buffer), _length, &bytes_written) != _length) {
+            return ERROR(SYS_COPY_LEN_ERR - errno, "failed to write encrypted frame");
+        }
+
+        return SUCCESS();
+    } // write_all
+} // anonymous namespace
+
+namespace irods
+{
+    encrypted_frame_writer::encrypted_frame_writer(int _socket,
+                                                   buffer_crypt& _crypt,
+                                                   const buffer_crypt::array_t& _key,
+                                                   std::size_t _queue_depth)
+        : socket_{_socket}
+        , crypt_{_crypt}
+        , key_{_key}
+        , frames_(std::max<std::size_t>(1, _queue_depth))
+        , head_{}
+        , queued_{}
+        , stopping_{}
+        , error_{SUCCESS()}
+        , mutex_{}
+        , cv_{}
+        , thread_{[this] { run(); }}
+    {
+    }
+
+    encrypted_frame_writer::~encrypted_frame_writer()
+    {
+        {
+            std::lock_guard lock{mutex_};
+            stopping_ = true;
+        }
+
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    auto encrypted_frame_writer::write(const unsigned char* _buffer, int _length) -> irods::error
+    {
+        std::size_t index{};
+
+        {
+            std::unique_lock lock{mutex_};
+            cv_.wait(lock, [this] { return queued_ < frames_.size() || !error_.ok(); });
+
+            if (!error_.ok()) {
+                return PASS(error_);
+            }
+
+            index = (head_ + queued_) % frames_.size();
+        }
+
+        // The writer thread does not touch a frame until it is queued.
+        auto& f = frames_[index];
+
+        if (auto ret = crypt_.initialization_vector(f.iv); !ret.ok()) {
+            return PASS(ret);
+        }
+
+        if (auto ret = crypt_.encrypt(key_, f.iv, _buffer, _length, f.cipher); !ret.ok()) {
+            return PASS(ret);
+        }
+
+        f.size = f.iv.size() + f.cipher.size();
+
+        {
+            std::lock_guard lock{mutex_};
+            ++queued_;
+        }
+
+        cv_.notify_all();
+
+        return SUCCESS();
+    } // write
+
+    auto encrypted_frame_writer::flush() -> irods::error
+    {
+        std::unique_lock lock{mutex_};
+        cv_.wait(lock, [this] { return 0 == queued_; });
+
+        return error_.ok() ? SUCCESS() : PASS(error_);
+    } // flush
+
+    auto encrypted_frame_writer::run() -> void
+    {
+        while (true) {
+            std::size_t index{};
+
+            {
+                std::unique_lock lock{mutex_};
+                cv_.wait(lock, [this] { return queued_ > 0 || stopping_; });
+
+                if (0 == queued_) {
+                    return;
+                }
+
+                index = head_;
+            }
+
+            const auto& f = frames_[index];
+
+            auto ret = write_all(socket_, &f.size, sizeof(f.size));
+
+            if (ret.ok()) {
+                ret = write_all(socket_, f.iv.data(), f.iv.size());
+            }
+
+            if (ret.ok()) {
+                ret = write_all(socket_, f.cipher.data(), f.cipher.size());
+            }
+
+            {
+                std::lock_guard lock{mutex_};
+
+                // After a failed write, the queued frames are dropped; the stream is broken.
+                if (!ret.ok()) {
+                    error_ = ret;
+                    queued_ = 0;
+                }
+                else {
+                    head_ = (head_ + 1) % frames_.size();
+                    --queued_;
+                }
+            }
+
+            cv_.notify_all();
+        }
+    } // run
+} // namespace irods
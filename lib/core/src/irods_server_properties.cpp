@@ -30,6 +30,9 @@ namespace irods
     } // instance
 
     server_properties::server_properties()
+        : published_snapshots_{std::make_shared<const server_config_snapshot>()}
+        , publish_mutex_{}
+        , snapshot_{&published_snapshots_.back()}
     {
         capture();
     } // ctor
@@ -46,6 +49,13 @@ namespace irods
         if ( ret.ok() ) {
             capture_json( db_cfg );
         }
+
+        // Readers may still be copying the previous snapshot, so it is kept.
+        auto snapshot = std::make_shared<const server_config_snapshot>( server_config_snapshot::read( config_props_ ) );
+
+        std::lock_guard<std::mutex> lock{publish_mutex_};
+        published_snapshots_.push_back( std::move( snapshot ) );
+        snapshot_.store( &published_snapshots_.back(), std::memory_order_release );
     } // capture
 
     void server_properties::capture_json( const std::string& _filename )
@@ -158,6 +168,189 @@ namespace irods
         return 3600;
     } // get_hostname_cache_eviction_age
 
+    auto get_server_load_table_shared_memory_size() noexcept -> int
+    {
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto wrapped = get_advanced_setting<map_type&>(CFG_SERVER_LOAD_TABLE_KW).at(CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW);
+            const auto bytes = boost::any_cast<int>(wrapped);
+
+            if (bytes > 0) {
+                return bytes;
+            }
+
+            rodsLog(LOG_ERROR, "Invalid shared memory size for server load table [size=%d].", bytes);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s.%s].",
+                    CFG_ADVANCED_SETTINGS_KW.data(), CFG_SERVER_LOAD_TABLE_KW.data(), CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW.data());
+        }
+
+        rodsLog(LOG_DEBUG, "Returning default shared memory size for server load table [default=1000000].");
+
+        return 1'000'000;
+    } // get_server_load_table_shared_memory_size
+
+    auto get_server_load_sample_interval() noexcept -> int
+    {
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto wrapped = get_advanced_setting<map_type&>(CFG_SERVER_LOAD_TABLE_KW).at(CFG_SAMPLE_INTERVAL_IN_SECONDS_KW);
+            const auto seconds = boost::any_cast<int>(wrapped);
+
+            if (seconds > 0) {
+                return seconds;
+            }
+
+            rodsLog(LOG_ERROR, "Invalid sample interval for server load table [seconds=%d].", seconds);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s.%s].",
+                    CFG_ADVANCED_SETTINGS_KW.data(), CFG_SERVER_LOAD_TABLE_KW.data(), CFG_SAMPLE_INTERVAL_IN_SECONDS_KW.data());
+        }
+
+        rodsLog(LOG_DEBUG, "Returning default sample interval for server load table [default=15].");
+
+        return 15;
+    } // get_server_load_sample_interval
+
+    auto get_resource_hierarchy_cache_shared_memory_size() noexcept -> int
+    {
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto wrapped = get_advanced_setting<map_type&>(CFG_RESOURCE_HIERARCHY_CACHE_KW).at(CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW);
+            const auto bytes = boost::any_cast<int>(wrapped);
+
+            if (bytes > 0) {
+                return bytes;
+            }
+
+            rodsLog(LOG_ERROR, "Invalid shared memory size for resource hierarchy cache [size=%d].", bytes);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s.%s].",
+                    CFG_ADVANCED_SETTINGS_KW.data(), CFG_RESOURCE_HIERARCHY_CACHE_KW.data(), CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW.data());
+        }
+
+        rodsLog(LOG_DEBUG, "Returning default shared memory size for resource hierarchy cache [default=5000000].");
+
+        return 5'000'000;
+    } // get_resource_hierarchy_cache_shared_memory_size
+
+    auto get_resource_hierarchy_cache_refresh_interval() noexcept -> int
+    {
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto wrapped = get_advanced_setting<map_type&>(CFG_RESOURCE_HIERARCHY_CACHE_KW).at(CFG_REFRESH_INTERVAL_IN_SECONDS_KW);
+            const auto seconds = boost::any_cast<int>(wrapped);
+
+            if (seconds >= 0) {
+                return seconds;
+            }
+
+            rodsLog(LOG_ERROR, "Invalid refresh interval for resource hierarchy cache [seconds=%d].", seconds);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s.%s].",
+                    CFG_ADVANCED_SETTINGS_KW.data(), CFG_RESOURCE_HIERARCHY_CACHE_KW.data(), CFG_REFRESH_INTERVAL_IN_SECONDS_KW.data());
+        }
+
+        rodsLog(LOG_DEBUG, "Returning default refresh interval for resource hierarchy cache [default=10].");
+
+        return 10;
+    } // get_resource_hierarchy_cache_refresh_interval
+
+    auto get_access_verdict_cache_shared_memory_size() noexcept -> int
+    {
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto wrapped = get_advanced_setting<map_type&>(CFG_ACCESS_VERDICT_CACHE_KW).at(CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW);
+            const auto value = boost::any_cast<int>(wrapped);
+
+            if (value >= 0) {
+                return value;
+            }
+
+            rodsLog(LOG_ERROR, "Invalid shared memory size for access verdict cache [size=%d].", value);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s.%s].",
+                    CFG_ADVANCED_SETTINGS_KW.data(), CFG_ACCESS_VERDICT_CACHE_KW.data(), CFG_SHARED_MEMORY_SIZE_IN_BYTES_KW.data());
+        }
+
+        rodsLog(LOG_DEBUG, "Returning default shared memory size for access verdict cache [default=0].");
+
+        return 0;
+    } // get_access_verdict_cache_shared_memory_size
+
+    auto get_access_verdict_cache_time_to_live() noexcept -> int
+    {
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto wrapped = get_advanced_setting<map_type&>(CFG_ACCESS_VERDICT_CACHE_KW).at(CFG_TIME_TO_LIVE_IN_SECONDS_KW);
+            const auto value = boost::any_cast<int>(wrapped);
+
+            if (value >= 0) {
+                return value;
+            }
+
+            rodsLog(LOG_ERROR, "Invalid time to live for access verdict cache [seconds=%d].", value);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s.%s].",
+                    CFG_ADVANCED_SETTINGS_KW.data(), CFG_ACCESS_VERDICT_CACHE_KW.data(), CFG_TIME_TO_LIVE_IN_SECONDS_KW.data());
+        }
+
+        rodsLog(LOG_DEBUG, "Returning default time to live for access verdict cache [default=0].");
+
+        return 0;
+    } // get_access_verdict_cache_time_to_live
+
+    auto get_access_verdict_cache_maximum_entries() noexcept -> int
+    {
+        try {
+            using map_type = std::unordered_map<std::string, boost::any>;
+            const auto wrapped = get_advanced_setting<map_type&>(CFG_ACCESS_VERDICT_CACHE_KW).at(CFG_MAXIMUM_ENTRIES_PER_AGENT_KW);
+            const auto value = boost::any_cast<int>(wrapped);
+
+            if (value > 0) {
+                return value;
+            }
+
+            rodsLog(LOG_ERROR, "Invalid maximum number of entries for access verdict cache [entries=%d].", value);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.%s.%s].",
+                    CFG_ADVANCED_SETTINGS_KW.data(), CFG_ACCESS_VERDICT_CACHE_KW.data(), CFG_MAXIMUM_ENTRIES_PER_AGENT_KW.data());
+        }
+
+        rodsLog(LOG_DEBUG, "Returning default maximum number of entries for access verdict cache [default=10000].");
+
+        return 10'000;
+    } // get_access_verdict_cache_maximum_entries
+
+    auto get_pam_auth_helper_worker_count() noexcept -> int
+    {
+        try {
+            const auto workers = get_server_property<const int>(
+                configuration_parser::key_path_t{PLUGIN_TYPE_AUTHENTICATION, "pam", CFG_PAM_HELPER_WORKER_COUNT_KW});
+
+            if (workers >= 0) {
+                return workers;
+            }
+
+            rodsLog(LOG_ERROR, "Invalid worker count for PAM authentication helper [workers=%d].", workers);
+        }
+        catch (...) {
+            rodsLog(LOG_DEBUG, "Could not read server configuration property [%s.pam.%s].",
+                    PLUGIN_TYPE_AUTHENTICATION.data(), CFG_PAM_HELPER_WORKER_COUNT_KW.data());
+        }
+
+        rodsLog(LOG_DEBUG, "Returning default worker count for PAM authentication helper [default=0].");
+
+        return 0;
+    } // get_pam_auth_helper_worker_count
+
     void parse_and_store_hosts_configuration_file_as_json() noexcept
     {
         try {
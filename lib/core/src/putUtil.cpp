@@ -16,12 +16,65 @@
 #include "irods_exception.hpp"
 #include "irods_random.hpp"
 #include "irods_log.hpp"
+#include "transfer_scheduler.hpp"
 
 #include "sockComm.h"
 #include <boost/filesystem/operations.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/filesystem/convenience.hpp>
 
+#include <memory>
+#include <optional>
+
+namespace
+{
+    int putDirUtilImpl( rcComm_t **myConn, char *srcDir, char *targColl,
+                        rodsEnv *myRodsEnv, rodsArguments_t *rodsArgs, dataObjInp_t *dataObjOprInp,
+                        bulkOprInp_t *bulkOprInp, rodsRestart_t *rodsRestart,
+                        bulkOprInfo_t *bulkOprInfo,
+                        irods::experimental::transfer_scheduler& scheduler );
+
+    // Hands one file of a directory walk to the scheduler. The transfer works on its
+    // own copy of dataObjOprInp because it may run on another thread after the walk
+    // has moved on.
+    int schedulePutFile( irods::experimental::transfer_scheduler& scheduler,
+                         const char *srcPath, const char *targPath, rodsLong_t srcSize,
+                         rodsArguments_t *rodsArgs, dataObjInp_t *dataObjOprInp,
+                         rodsRestart_t *rodsRestart )
+    {
+        namespace fs = boost::filesystem;
+
+        std::shared_ptr<dataObjInp_t> dataObjInp{new dataObjInp_t{}, []( dataObjInp_t *p ) {
+            clearDataObjInp( p );
+            delete p;
+        }};
+        replDataObjInp( dataObjOprInp, dataObjInp.get() );
+
+        std::string src = srcPath;
+        std::string targ = targPath;
+
+        auto transfer = [=]( rcComm_t& conn, int numThreads ) mutable {
+            int status;
+            dataObjInp->numThreads = numThreads;
+            try {
+                status = putFileUtil( &conn, src.data(), targ.data(), srcSize, rodsArgs, dataObjInp.get() );
+            } catch ( const fs::filesystem_error& e ) {
+                rodsLog( LOG_ERROR, e.what() );
+                status = e.code().value();
+            }
+            if ( status < 0 && status != CAT_NO_ROWS_FOUND ) {
+                rodsLogError( LOG_ERROR, status, "putDirUtil: put %s failed. status = %d", src.c_str(), status );
+            }
+            return status;
+        };
+
+        /* write the restart file */
+        return scheduler.schedule( srcSize, transfer, [rodsRestart, targ]() mutable {
+            return procAndWriteRestartFile( rodsRestart, targ.data() );
+        } );
+    }
+} // anonymous namespace
+
 
 /* checkStateForResume - check the state for resume operation
  * return 0 - skip
@@ -259,6 +312,25 @@ putUtil( rcComm_t **myConn, rodsEnv *myRodsEnv,
             free( info );
         }
     }
+
+    // Files found by walking directories may be transferred concurrently. Bulk
+    // uploads, redirected connections, and large file restarts are tied to the
+    // caller's connection, so they keep transferring one file at a time.
+    auto schedulerOptions = irods::experimental::transfer_scheduler::make_options(
+                                *myRodsEnv, dataObjOprInp.numThreads );
+    if ( conn->fileRestart.flags == FILE_RESTART_ON ||
+            myRodsArgs->redirectConn == True || myRodsArgs->bulk == True ) {
+        schedulerOptions.max_files = 1;
+    }
+    schedulerOptions.stop_on_error = rodsRestart.fd > 0;
+
+    std::optional<irods::experimental::transfer_scheduler> scheduler;
+    scheduler.emplace( myConn, schedulerOptions, [myRodsArgs]( rcComm_t& workerConn ) {
+        if ( myRodsArgs->ticket == True ) {
+            setSessionTicket( &workerConn, myRodsArgs->ticketString );
+        }
+    } );
+
     for ( i = 0; i < rodsPathInp->numSrc; i++ ) {
         targPath = &rodsPathInp->targPath[i];
 
@@ -292,9 +364,13 @@ putUtil( rcComm_t **myConn, rodsEnv *myRodsEnv,
                                          &rodsRestart );
             }
             else {
-                status = putDirUtil( myConn, rodsPathInp->srcPath[i].outPath,
-                                     targPath->outPath, myRodsEnv, myRodsArgs, &dataObjOprInp,
-                                     &bulkOprInp, &rodsRestart, NULL );
+                status = putDirUtilImpl( myConn, rodsPathInp->srcPath[i].outPath,
+                                         targPath->outPath, myRodsEnv, myRodsArgs, &dataObjOprInp,
+                                         &bulkOprInp, &rodsRestart, NULL, *scheduler );
+                int transferStatus = scheduler->wait();
+                if ( transferStatus < 0 && ( status >= 0 || status == CAT_NO_ROWS_FOUND ) ) {
+                    status = transferStatus;
+                }
                 if (status == USER_INPUT_PATH_ERR || status == SYS_INVALID_INPUT_PARAM)
                 {
                     return status;
@@ -319,6 +395,8 @@ putUtil( rcComm_t **myConn, rodsEnv *myRodsEnv,
         }
     }
 
+    scheduler.reset();
+
     if ( rodsRestart.fd > 0 ) {
         close( rodsRestart.fd );
     }
@@ -707,6 +785,24 @@ putDirUtil( rcComm_t **myConn, char *srcDir, char *targColl,
             rodsEnv *myRodsEnv, rodsArguments_t *rodsArgs, dataObjInp_t *dataObjOprInp,
             bulkOprInp_t *bulkOprInp, rodsRestart_t *rodsRestart,
             bulkOprInfo_t *bulkOprInfo )
+{
+    /* one file at a time on the caller's connection */
+    irods::experimental::transfer_scheduler::options options;
+    options.requested_threads = dataObjOprInp->numThreads;
+    irods::experimental::transfer_scheduler scheduler{ myConn, options };
+
+    return putDirUtilImpl( myConn, srcDir, targColl, myRodsEnv, rodsArgs, dataObjOprInp,
+                           bulkOprInp, rodsRestart, bulkOprInfo, scheduler );
+}
+
+namespace
+{
+int
+putDirUtilImpl( rcComm_t **myConn, char *srcDir, char *targColl,
+                rodsEnv *myRodsEnv, rodsArguments_t *rodsArgs, dataObjInp_t *dataObjOprInp,
+                bulkOprInp_t *bulkOprInp, rodsRestart_t *rodsRestart,
+                bulkOprInfo_t *bulkOprInfo,
+                irods::experimental::transfer_scheduler& scheduler )
 {
     namespace fs = boost::filesystem;
 
@@ -866,33 +962,24 @@ putDirUtil( rcComm_t **myConn, char *srcDir, char *targColl,
                     status = bulkPutFileUtil( conn, srcChildPath, targChildPath,
                                             dataSize,  dataObjOprInp->createMode, rodsArgs,
                                             bulkOprInp, bulkOprInfo );
-                }
-                else {
-                    /* normal put */
-                    try {
-                        status = putFileUtil( conn, srcChildPath, targChildPath,
-                                            dataSize, rodsArgs, dataObjOprInp );
-                    } catch ( const fs::filesystem_error& e ) {
-                        rodsLog( LOG_ERROR, e.what() );
-                        status = e.code().value();
+                    if ( rodsRestart->fd > 0 && status > 0 ) {
+                        /* status is the number of files bulk loaded */
+                        rodsRestart->curCnt += status;
+                        status = writeRestartFile( rodsRestart,
+                                                targChildPath );
                     }
                 }
-                if ( rodsRestart->fd > 0 ) {
-                    if ( status >= 0 ) {
-                        if ( bulkFlag == BULK_OPR_SMALL_FILES ) {
-                            if ( status > 0 ) {
-                                /* status is the number of files bulk loaded */
-                                rodsRestart->curCnt += status;
-                                status = writeRestartFile( rodsRestart,
-                                                        targChildPath );
-                            }
-                        }
-                        else {
-                            /* write the restart file */
-                            rodsRestart->curCnt ++;
-                            status = writeRestartFile( rodsRestart, targChildPath );
+                else {
+                    /* normal put. failures are reported by the transfer */
+                    status = schedulePutFile( scheduler, srcChildPath, targChildPath,
+                                              dataSize, rodsArgs, dataObjOprInp, rodsRestart );
+                    if ( status < 0 && status != CAT_NO_ROWS_FOUND ) {
+                        savedStatus = status;
+                        if ( rodsRestart->fd > 0 ) {
+                            break;
                         }
                     }
+                    continue;
                 }
             }
             else {        /* a directory */
@@ -904,9 +991,9 @@ putDirUtil( rcComm_t **myConn, char *srcDir, char *targColl,
                         return status;
                     }
                 }
-                status = putDirUtil( myConn, srcChildPath, targChildPath,
-                                    myRodsEnv, rodsArgs, dataObjOprInp, bulkOprInp,
-                                    rodsRestart, bulkOprInfo );
+                status = putDirUtilImpl( myConn, srcChildPath, targChildPath,
+                                        myRodsEnv, rodsArgs, dataObjOprInp, bulkOprInp,
+                                        rodsRestart, bulkOprInfo, scheduler );
 
             }
 
@@ -921,6 +1008,7 @@ putDirUtil( rcComm_t **myConn, char *srcDir, char *targColl,
     }
     return savedStatus;
 }
+} // anonymous namespace
 
 int
 bulkPutDirUtil( rcComm_t **myConn, char *srcDir, char *targColl,
@@ -16,6 +16,7 @@
 // =-=-=-=-=-=-=-
 #include "irods_stacktrace.hpp"
 #include "irods_buffer_encryption.hpp"
+#include "irods_encrypted_frame_writer.hpp"
 #include "irods_client_server_negotiation.hpp"
 
 #include <openssl/md5.h>
@@ -26,6 +27,7 @@
 #include <boost/thread/condition.hpp>
 #include <iomanip>
 #include <fstream>
+#include <optional>
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/convenience.hpp>
 using namespace boost::filesystem;
@@ -335,25 +337,23 @@ rcPartialDataPut( rcPortalTransferInp_t *myInput ) {
     }
 
     // =-=-=-=-=-=-=-
-    // create an encryption context
-    int iv_size = 0;
-    irods::buffer_crypt::array_t iv;
-    irods::buffer_crypt::array_t cipher;
-    irods::buffer_crypt::array_t in_buf;
+    // create an encryption context using the parameters
+    // negotiated for this connection
     irods::buffer_crypt::array_t shared_secret;
     irods::buffer_crypt crypt(
-        rods_env.rodsEncryptionKeySize,
-        rods_env.rodsEncryptionSaltSize,
-        rods_env.rodsEncryptionNumHashRounds,
-        rods_env.rodsEncryptionAlgorithm );
+        conn->key_size,
+        conn->salt_size,
+        conn->num_hash_rounds,
+        conn->encryption_algorithm );
 
     // =-=-=-=-=-=-=-
-    // set iv size
+    // buffers are encrypted while the previous one is sent
+    std::optional<irods::encrypted_frame_writer> writer;
     if ( use_encryption_flg ) {
-        iv_size = crypt.key_size();
         shared_secret.assign(
             &myInput->shared_secret[0],
-            &myInput->shared_secret[iv_size] );
+            &myInput->shared_secret[crypt.key_size()] );
+        writer.emplace( destFd, crypt, shared_secret );
     }
 
     // =-=-=-=-=-=-=-
@@ -415,73 +415,28 @@ rcPartialDataPut( rcPortalTransferInp_t *myInput ) {
                 break;
             }
 
-            // =-=-=-=-=-=-=-
-            // compute an iv for this particular transmission and use
-            // it to encrypt this buffer
-            int new_size = bytesRead;
-            if ( use_encryption_flg ) {
-                irods::error ret = crypt.initialization_vector( iv );
-                if ( !ret.ok() ) {
-                    ret = PASS( ret );
-                    printf( "%s", ret.result().c_str() );
-                    break;
-                }
-
-                // =-=-=-=-=-=-=-
-                // encrypt
-                in_buf.assign(
-                    &buf[0],
-                    &buf[ bytesRead ] );
-                ret = crypt.encrypt(
-                          shared_secret,
-                          iv,
-                          in_buf,
-                          cipher );
+            if ( writer ) {
+                irods::error ret = writer->write( buf, bytesRead );
                 if ( !ret.ok() ) {
-                    ret = PASS( ret );
-                    printf( "%s", ret.result().c_str() );
+                    irods::log( PASS( ret ) );
+                    myInput->status = ret.code();
                     break;
                 }
-
-                // =-=-=-=-=-=-=-
-                // capture the iv with the cipher text
-                memset( buf, 0,  buf_size );
-                std::copy(
-                    iv.begin(),
-                    iv.end(),
-                    &buf[0] );
-                std::copy(
-                    cipher.begin(),
-                    cipher.end(),
-                    &buf[iv_size] );
-
-                new_size = iv_size + cipher.size();
-
-                // =-=-=-=-=-=-=-
-                // need to send the incoming size as encryption might change
-                // the size of the data from the written values
+            }
+            else {
                 bytesWritten = myWrite(
                                    destFd,
-                                   &new_size,
-                                   sizeof( int ),
+                                   buf,
+                                   bytesRead,
                                    &bytesWritten );
 
-            }
-
-            // =-=-=-=-=-=-=-
-            // then write the actual buffer
-            bytesWritten = myWrite(
-                               destFd,
-                               buf,
-                               new_size,
-                               &bytesWritten );
-
-            if ( bytesWritten != new_size ) {
-                myInput->status = SYS_COPY_LEN_ERR - errno;
-                rodsLogError( LOG_ERROR, myInput->status,
-                              "rcPartialDataPut: toWrite %d, bytesWritten %d, errno = %d",
-                              bytesRead, bytesWritten, errno );
-                break;
+                if ( bytesWritten != bytesRead ) {
+                    myInput->status = SYS_COPY_LEN_ERR - errno;
+                    rodsLogError( LOG_ERROR, myInput->status,
+                                  "rcPartialDataPut: toWrite %d, bytesWritten %d, errno = %d",
+                                  bytesRead, bytesWritten, errno );
+                    break;
+                }
             }
 
             toPut -= bytesRead;
@@ -505,6 +460,20 @@ rcPartialDataPut( rcPortalTransferInp_t *myInput ) {
 
         } // while
 
+        // =-=-=-=-=-=-=-
+        // the server reads the whole chunk before sending the next header
+        if ( writer && myInput->status >= 0 ) {
+            irods::error ret = writer->flush();
+            if ( !ret.ok() ) {
+                irods::log( PASS( ret ) );
+                myInput->status = ret.code();
+            }
+        }
+
+        if ( myInput->status < 0 ) {
+            break;
+        }
+
         curOffset += myHeader.length;
         myInput->bytesWritten += myHeader.length;
         /* should lock this. But window browser is the only one using it */
@@ -519,6 +488,7 @@ rcPartialDataPut( rcPortalTransferInp_t *myInput ) {
     }
 
 
+    writer.reset();
     free( buf );
     close( srcFd );
     mySockClose( destFd );
@@ -1031,10 +1001,10 @@ rcPartialDataGet( rcPortalTransferInp_t *myInput ) {
     irods::buffer_crypt::array_t plain;
     irods::buffer_crypt::array_t shared_secret;
     irods::buffer_crypt crypt(
-        rods_env.rodsEncryptionKeySize,
-        rods_env.rodsEncryptionSaltSize,
-        rods_env.rodsEncryptionNumHashRounds,
-        rods_env.rodsEncryptionAlgorithm );
+        conn->key_size,
+        conn->salt_size,
+        conn->num_hash_rounds,
+        conn->encryption_algorithm );
 
     // =-=-=-=-=-=-=-
     // set iv size
@@ -1142,7 +1112,6 @@ rcPartialDataGet( rcPortalTransferInp_t *myInput ) {
                     break;
                 }
 
-                memset( buf, 0, buf_size );
                 std::copy(
                     plain.begin(),
                     plain.end(),
@@ -1248,6 +1217,9 @@ int putFileToPortalRbudp(
               ( mypacketSize = atoi( tmpStr ) ) < 1 ) ) {
         mypacketSize = DEF_UDP_PACKET_SIZE;
     }
+    if ( ( tmpStr = getenv( RBUDP_NUM_STREAMS_KW ) ) != NULL ) {
+        rbudpSender.numStreams = atoi( tmpStr );
+    }
 
     if ( locFilePath == NULL ) {
         status = sendfileByFd(
@@ -10,20 +10,286 @@
 #include "irods_hasher_factory.hpp"
 #include "irods_path_recursion.hpp"
 #include "irods_exception.hpp"
+#include "rsync_manifest.hpp"
+#include "thread_pool.hpp"
+#include "transfer_scheduler.hpp"
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/convenience.hpp>
 
 #include <sys/time.h>
 
+#include <algorithm>
 #include <cstdlib>
+#include <memory>
 #include <sstream>
+#include <thread>
 
 static int CurrentTime = 0;
 int
 ageExceeded( int ageLimit, int myTime, char *objPath,
              rodsLong_t fileSize );
 
+namespace
+{
+    namespace rm = irods::experimental::rsync_manifest;
+
+    // The number of threads used to scan the source directory and hash local files.
+    int localThreadCount()
+    {
+        return std::clamp( static_cast<int>( std::thread::hardware_concurrency() ), 1, 8 );
+    }
+
+    // Puts one local file that is known to be missing from, or different than, its
+    // data object. Runs on a transfer_scheduler worker.
+    int rsyncPutFile( rcComm_t& conn, const rm::local_entry& file, const std::string& chksum,
+                      rodsArguments_t *rodsArgs, dataObjInp_t *dataObjInp )
+    {
+        struct timeval startTime, endTime;
+
+        if ( rodsArgs->verifyChecksum == True ) {
+            std::string verify = chksum;
+            if ( verify.empty() ) {
+                rodsEnv env;
+                int status = getRodsEnv( &env );
+                if ( status < 0 ) {
+                    rodsLogError( LOG_ERROR, status, "rsyncPutFile: getRodsEnv failed" );
+                    return status;
+                }
+
+                char buf[NAME_LEN]{};
+                status = chksumLocFile( file.path.c_str(), buf, env.rodsDefaultHashScheme );
+                if ( status < 0 ) {
+                    rodsLogError( LOG_ERROR, status,
+                                  "rsyncPutFile: chksumLocFile error for %s, status = %d",
+                                  file.path.c_str(), status );
+                    return status;
+                }
+                verify = buf;
+            }
+            addKeyVal( &dataObjInp->condInput, VERIFY_CHKSUM_KW, verify.c_str() );
+        }
+
+        rstrcpy( dataObjInp->objPath, file.logical_path.c_str(), MAX_NAME_LEN );
+        dataObjInp->dataSize = file.size;
+        dataObjInp->openFlags = O_WRONLY;
+        dataObjInp->createMode = file.mode;
+
+        if ( rodsArgs->verbose == True ) {
+            ( void ) gettimeofday( &startTime, ( struct timezone * )0 );
+            bzero( &conn.transStat, sizeof( transStat_t ) );
+        }
+
+        std::string path = file.path;
+        const int status = rcDataObjPut( &conn, dataObjInp, path.data() );
+
+        if ( status >= 0 && rodsArgs->verbose == True ) {
+            std::string logicalPath = file.logical_path;
+            ( void ) gettimeofday( &endTime, ( struct timezone * )0 );
+            printTiming( &conn, path.data(), file.size, logicalPath.data(), &startTime, &endTime );
+        }
+
+        return status;
+    }
+
+    // Lets the server compare a local file with a data object that has no checksum in
+    // the catalog. Runs on a transfer_scheduler worker.
+    int rsyncOnServer( rcComm_t& conn, const rm::local_entry& file,
+                       rodsArguments_t *rodsArgs, dataObjInp_t *dataObjInp )
+    {
+        rodsPath_t srcPath{};
+        rodsPath_t targPath{};
+
+        rstrcpy( srcPath.outPath, file.path.c_str(), MAX_NAME_LEN );
+        srcPath.objType = LOCAL_FILE_T;
+        srcPath.objState = EXIST_ST;
+        srcPath.size = file.size;
+
+        rstrcpy( targPath.outPath, file.logical_path.c_str(), MAX_NAME_LEN );
+        targPath.objType = DATA_OBJ_T;
+        targPath.objState = EXIST_ST;
+        targPath.size = file.size;
+
+        dataObjInp->createMode = file.mode;
+
+        return rsyncFileToDataUtil( &conn, &srcPath, &targPath, rodsArgs, dataObjInp );
+    }
+
+    // Synchronizes a local directory into a collection by comparing a scan of the
+    // directory with a manifest of the collection fetched in a few bulk queries,
+    // instead of stat'ing every data object. Local checksums are only computed for
+    // files whose size matches but which are newer than their data object, and are
+    // computed in parallel. Transfers go through a transfer_scheduler.
+    int rsyncDirToCollWithManifest( rcComm_t *conn, rodsPath_t *srcPath,
+                                    rodsPath_t *targPath, rodsEnv *myRodsEnv, rodsArguments_t *rodsArgs,
+                                    dataObjInp_t *dataObjOprInp )
+    {
+        char *srcDir = srcPath->outPath;
+        char *targColl = targPath->outPath;
+
+        if ( rodsArgs->recursive != True ) {
+            rodsLog( LOG_ERROR,
+                     "rsyncDirToCollUtil: -r option must be used for putting %s directory",
+                     srcDir );
+            return USER_INPUT_OPTION_ERR;
+        }
+
+        if ( !boost::filesystem::is_directory( srcDir ) ) {
+            rodsLog( LOG_ERROR,
+                     "rsyncDirToCollUtil: opendir local dir error for %s, errno = %d\n",
+                     srcDir, errno );
+            return USER_INPUT_PATH_ERR;
+        }
+
+        try {
+            if ( !irods::is_path_valid_for_recursion( rodsArgs, srcDir ) ) {
+                return 0;
+            }
+        }
+        catch ( const irods::exception& _e ) {
+            rodsLog( LOG_ERROR, _e.client_display_what() );
+            return USER_INPUT_PATH_ERR;
+        }
+
+        if ( rodsArgs->verbose == True ) {
+            fprintf( stdout, "C- %s:\n", targColl );
+        }
+
+        auto local = rm::scan( *rodsArgs, srcDir, targColl, localThreadCount() );
+        int savedStatus = local.status;
+
+        rm::manifest remote;
+        try {
+            remote = rm::fetch( *conn, targColl );
+        }
+        catch ( const irods::exception& _e ) {
+            rodsLog( LOG_ERROR, _e.client_display_what() );
+            return _e.code();
+        }
+
+        for ( auto& coll : local.collections ) {
+            if ( rodsArgs->verbose == True ) {
+                fprintf( stdout, "C- %s:\n", coll.c_str() );
+            }
+
+            /* only do the sync if no -l option specified */
+            if ( rodsArgs->longOption == True || remote.collections.count( coll ) > 0 ) {
+                continue;
+            }
+
+            const int status = mkCollR( conn, targColl, coll.data() );
+            if ( status < 0 ) {
+                rodsLogError( LOG_ERROR, status, "rsyncDirToCollUtil: mkColl error for %s", coll.c_str() );
+                savedStatus = status;
+            }
+        }
+
+        // Decide what to do with every file. ageExceeded prints, so it is only called here.
+        std::vector<rm::action> actions( local.files.size(), rm::action::none );
+        std::vector<std::string> chksums( local.files.size() );
+
+        for ( std::size_t i = 0; i < local.files.size(); ++i ) {
+            auto& file = local.files[i];
+
+            if ( rodsArgs->age == True &&
+                    ageExceeded( rodsArgs->agevalue, file.mtime, file.path.data(), file.size ) ) {
+                continue;
+            }
+
+            const auto entry = remote.data_objects.find( file.logical_path );
+            const auto* remoteEntry = entry == remote.data_objects.end() ? nullptr : &entry->second;
+            actions[i] = rm::classify( file, remoteEntry, rodsArgs->sizeFlag == True );
+        }
+
+        {
+            irods::thread_pool pool{ localThreadCount() };
+
+            for ( std::size_t i = 0; i < local.files.size(); ++i ) {
+                if ( actions[i] != rm::action::compare_checksum ) {
+                    continue;
+                }
+
+                irods::thread_pool::post( pool, [&, i] {
+                    const auto& file = local.files[i];
+                    const auto& remoteChksum = remote.data_objects.at( file.logical_path ).checksum;
+
+                    std::string scheme;
+                    irods::error ret = irods::get_hash_scheme_from_checksum( remoteChksum, scheme );
+                    if ( !ret.ok() ) {
+                        printf( "%s", ret.result().c_str() );
+                    }
+
+                    char buf[NAME_LEN]{};
+                    const int status = chksumLocFile( file.path.c_str(), buf, scheme.c_str() );
+                    if ( status < 0 ) {
+                        rodsLogError( LOG_ERROR, status,
+                                      "rsyncDirToCollUtil: chksumLocFile error for %s, status = %d",
+                                      file.path.c_str(), status );
+                    }
+                    chksums[i] = buf;
+                    actions[i] = remoteChksum == chksums[i] ? rm::action::none : rm::action::put;
+                } );
+            }
+
+            pool.join();
+        }
+
+        auto options = irods::experimental::transfer_scheduler::make_options( *myRodsEnv, dataObjOprInp->numThreads );
+        irods::experimental::transfer_scheduler scheduler{ &conn, options };
+
+        for ( std::size_t i = 0; i < local.files.size(); ++i ) {
+            const auto& file = local.files[i];
+            const auto action = actions[i];
+
+            if ( action == rm::action::none ) {
+                if ( rodsArgs->verbose == True ) {
+                    std::string path = file.path;
+                    printNoSync( path.data(), file.size, const_cast<char*>( "a match" ) );
+                }
+                continue;
+            }
+
+            /* only do the sync if no -l option specified */
+            if ( rodsArgs->longOption == True ) {
+                if ( action == rm::action::put ) {
+                    printf( "%s   %lld   N\n", file.path.c_str(), file.size );
+                }
+                continue;
+            }
+
+            std::shared_ptr<dataObjInp_t> dataObjInp{ new dataObjInp_t{}, []( dataObjInp_t *p ) {
+                clearDataObjInp( p );
+                delete p;
+            } };
+            replDataObjInp( dataObjOprInp, dataObjInp.get() );
+
+            const int status = scheduler.schedule( file.size, [&file, chksum = chksums[i], action, rodsArgs, dataObjInp]( rcComm_t& workerConn, int numThreads ) {
+                dataObjInp->numThreads = numThreads;
+                const int status = action == rm::action::put
+                                   ? rsyncPutFile( workerConn, file, chksum, rodsArgs, dataObjInp.get() )
+                                   : rsyncOnServer( workerConn, file, rodsArgs, dataObjInp.get() );
+                if ( status < 0 && status != CAT_NO_ROWS_FOUND && status != SYS_SPEC_COLL_OBJ_NOT_EXIST ) {
+                    rodsLogError( LOG_ERROR, status,
+                                  "rsyncDirToCollUtil: put %s failed. status = %d",
+                                  file.path.c_str(), status );
+                }
+                return status;
+            } );
+
+            if ( status < 0 && status != CAT_NO_ROWS_FOUND && status != SYS_SPEC_COLL_OBJ_NOT_EXIST ) {
+                savedStatus = status;
+            }
+        }
+
+        const int status = scheduler.wait();
+        if ( status < 0 && status != CAT_NO_ROWS_FOUND && status != SYS_SPEC_COLL_OBJ_NOT_EXIST ) {
+            savedStatus = status;
+        }
+
+        return savedStatus;
+    }
+} // anonymous namespace
+
 int
 rsyncUtil( rcComm_t *conn, rodsEnv *myRodsEnv, rodsArguments_t *myRodsArgs,
            rodsPathInp_t *rodsPathInp ) {
@@ -135,8 +401,16 @@ rsyncUtil( rcComm_t *conn, rodsEnv *myRodsEnv, rodsArguments_t *myRodsArgs,
         }
         else if ( srcType == LOCAL_DIR_T && targType == COLL_OBJ_T )
         {
-            status = rsyncDirToCollUtil( conn, srcPath, targPath,
-                                 myRodsEnv, myRodsArgs, &dataObjOprInp );
+            // Special collections cannot be described by a catalog query, so they are
+            // synchronized one entry at a time.
+            if ( targPath->rodsObjStat == NULL || targPath->rodsObjStat->specColl == NULL ) {
+                status = rsyncDirToCollWithManifest( conn, srcPath, targPath,
+                                                     myRodsEnv, myRodsArgs, &dataObjOprInp );
+            }
+            else {
+                status = rsyncDirToCollUtil( conn, srcPath, targPath,
+                                     myRodsEnv, myRodsArgs, &dataObjOprInp );
+            }
         }
         else if ( srcType == COLL_OBJ_T && targType == COLL_OBJ_T ) {
             addKeyVal( &dataObjCopyInp.srcDataObjInp.condInput,
@@ -0,0 +1,249 @@
+#include "rsync_manifest.hpp"
+
+#include "genQuery.h"
+#include "irods_at_scope_exit.hpp"
+#include "irods_exception.hpp"
+#include "irods_path_recursion.hpp"
+#include "rcMisc.h"
+#include "rodsErrorTable.h"
+#include "rodsLog.h"
+#include "thread_pool.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <mutex>
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+    namespace rm = irods::experimental::rsync_manifest;
+
+    // Replicas with this status are preferred when describing a data object.
+    const std::string good_replica_status = "1";
+
+    // Calls _func with each row of a general query on the selected columns. The condition
+    // on COLL_NAME is passed as a condition value, which the catalog binds as a parameter, so
+    // quotes in a collection name cannot change the query.
+    auto for_each_row(rcComm_t& _conn,
+                      const std::vector<int>& _columns,
+                      const std::string& _coll_name_condition,
+                      const std::function<void(const std::vector<std::string>&)>& _func) -> void
+    {
+        genQueryInp_t input{};
+        const irods::at_scope_exit clear_input{[&input] { clearGenQueryInp(&input); }};
+
+        for (const int column : _columns) {
+            addInxIval(&input.selectInp, column, 1);
+        }
+
+        addInxVal(&input.sqlCondInp, COL_COLL_NAME, _coll_name_condition.c_str());
+        input.maxRows = MAX_SQL_ROWS;
+
+        std::vector<std::string> row(_columns.size());
+
+        while (true) {
+            genQueryOut_t* output{};
+            const irods::at_scope_exit free_output{[&output] { freeGenQueryOut(&output); }};
+
+            if (const int ec = rcGenQuery(&_conn, &input, &output); ec < 0) {
+                if (CAT_NO_ROWS_FOUND == ec) {
+                    return;
+                }
+
+                THROW(ec, "general query failed");
+            }
+
+            for (int i = 0; i < output->rowCnt; ++i) {
+                for (int j = 0; j < output->attriCnt; ++j) {
+                    const auto& result = output->sqlResult[j];
+                    row[j] = &result.value[result.len * i];
+                }
+
+                _func(row);
+            }
+
+            if (output->continueInx <= 0) {
+                return;
+            }
+
+            input.continueInx = output->continueInx;
+        }
+    } // for_each_row
+
+    auto add_data_objects(rcComm_t& _conn,
+                          const std::string& _coll_name_condition,
+                          const std::string& _collection,
+                          rm::manifest& _manifest) -> void
+    {
+        const auto prefix = _collection + '/';
+
+        // Whether each path in the manifest came from a good replica.
+        std::unordered_set<std::string> good;
+
+        const std::vector<int> columns{COL_COLL_NAME, COL_DATA_NAME, COL_DATA_SIZE, COL_D_MODIFY_TIME, COL_D_DATA_CHECKSUM, COL_D_REPL_STATUS};
+
+        for_each_row(_conn, columns, _coll_name_condition, [&](const std::vector<std::string>& row) {
+            // LIKE treats '_' as a wildcard, so filter out paths outside the collection.
+            if (row[0] != _collection && 0 != row[0].compare(0, prefix.size(), prefix)) {
+                return;
+            }
+
+            auto path = row[0] + '/' + row[1];
+            const bool is_good = good_replica_status == row[5];
+
+            if (_manifest.data_objects.count(path) > 0 && (!is_good || good.count(path) > 0)) {
+                return;
+            }
+
+            _manifest.data_objects[path] = {std::stoll(row[2]), std::stoll(row[3]), row[4]};
+
+            if (is_good) {
+                good.insert(std::move(path));
+            }
+        });
+    } // add_data_objects
+
+    // Visits the entries of one directory. Subdirectories are posted to the pool so they
+    // are scanned in parallel.
+    class scanner
+    {
+    public:
+        scanner(const rodsArguments_t& _args, int _threads)
+            : args_{_args}
+            , pool_{_threads}
+            , mutex_{}
+            , result_{{}, {}, 0}
+        {
+        }
+
+        auto run(const fs::path& _dir, const std::string& _collection) -> rm::scan_result
+        {
+            irods::thread_pool::post(pool_, [this, _dir, _collection] { visit(_dir, _collection); });
+            pool_.join();
+
+            std::sort(result_.files.begin(), result_.files.end(), [](const auto& _lhs, const auto& _rhs) {
+                return _lhs.logical_path < _rhs.logical_path;
+            });
+            std::sort(result_.collections.begin(), result_.collections.end());
+
+            return std::move(result_);
+        } // run
+
+    private:
+        auto visit(const fs::path& _dir, const std::string& _collection) -> void
+        {
+            std::vector<rm::local_entry> files;
+            boost::system::error_code ec;
+
+            for (fs::directory_iterator it{_dir, ec}, end; !ec && it != end; it.increment(ec)) {
+                fs::path p = it->path();
+                const auto logical_path = _collection + '/' + p.filename().string();
+
+                try {
+                    if (!irods::is_path_valid_for_recursion(&args_, p.c_str())) {
+                        continue;
+                    }
+                }
+                catch (const irods::exception& e) {
+                    rodsLog(LOG_ERROR, e.client_display_what());
+                    set_status(USER_INPUT_PATH_ERR);
+                    continue;
+                }
+
+                if (fs::is_symlink(p)) {
+                    const auto target = fs::read_symlink(p, ec);
+                    p = target.is_relative() ? _dir / target : target;
+                }
+
+                if (fs::is_regular_file(p, ec)) {
+                    const auto size = fs::file_size(p, ec);
+                    const auto mtime = fs::last_write_time(p, ec);
+
+                    if (ec) {
+                        break;
+                    }
+
+                    files.push_back({p.string(), logical_path, static_cast<rodsLong_t>(size), mtime, getPathStMode(p.c_str())});
+                }
+                else if (fs::is_directory(p, ec)) {
+                    {
+                        std::lock_guard<std::mutex> lock{mutex_};
+                        result_.collections.push_back(logical_path);
+                    }
+
+                    irods::thread_pool::post(pool_, [this, p, logical_path] { visit(p, logical_path); });
+                }
+                else {
+                    rodsLog(LOG_ERROR, "rsync_manifest: unknown local path %s", p.c_str());
+                    set_status(USER_INPUT_PATH_ERR);
+                }
+            }
+
+            if (ec) {
+                rodsLog(LOG_ERROR, "rsync_manifest: error scanning %s: %s", _dir.c_str(), ec.message().c_str());
+                set_status(USER_INPUT_PATH_ERR);
+            }
+
+            std::lock_guard<std::mutex> lock{mutex_};
+            std::move(files.begin(), files.end(), std::back_inserter(result_.files));
+        } // visit
+
+        auto set_status(int _status) -> void
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            result_.status = _status;
+        } // set_status
+
+        const rodsArguments_t& args_;
+        irods::thread_pool pool_;
+        std::mutex mutex_;
+        rm::scan_result result_;
+    }; // class scanner
+} // anonymous namespace
+
+namespace irods::experimental::rsync_manifest
+{
+    auto fetch(rcComm_t& _conn, const std::string& _collection) -> manifest
+    {
+        manifest m;
+
+        const auto prefix = _collection + '/';
+
+        add_data_objects(_conn, "= '" + _collection + "'", _collection, m);
+        add_data_objects(_conn, "like '" + prefix + "%'", _collection, m);
+
+        for_each_row(_conn, {COL_COLL_NAME}, "like '" + prefix + "%'", [&m, &prefix](const std::vector<std::string>& row) {
+            if (0 == row[0].compare(0, prefix.size(), prefix)) {
+                m.collections.insert(row[0]);
+            }
+        });
+
+        return m;
+    } // fetch
+
+    auto scan(const rodsArguments_t& _args,
+              const std::string& _dir,
+              const std::string& _collection,
+              int _threads) -> scan_result
+    {
+        return scanner{_args, std::max(1, _threads)}.run(_dir, _collection);
+    } // scan
+
+    auto classify(const local_entry& _local, const remote_entry* _remote, bool _size_only) noexcept -> action
+    {
+        if (!_remote || _remote->size != _local.size) {
+            return action::put;
+        }
+
+        if (_size_only || _local.mtime <= _remote->mtime) {
+            return action::none;
+        }
+
+        return _remote->checksum.empty() ? action::sync_on_server : action::compare_checksum;
+    } // classify
+} // namespace irods::experimental::rsync_manifest
+
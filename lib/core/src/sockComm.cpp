@@ -25,6 +25,7 @@
 #endif  /* _WIN32 */
 
 #include "irods_stacktrace.hpp"
+#include "irods_buffer_encryption.hpp"
 #include "irods_client_server_negotiation.hpp"
 #include "irods_network_plugin.hpp"
 #include "irods_network_manager.hpp"
@@ -800,6 +801,20 @@ connectToRhost( rcComm_t *conn, int connectCnt, int reconnFlag ) {
     rodsEnv rods_env;
     getRodsEnv( &rods_env );
 
+    // =-=-=-=-=-=-=-
+    // servers before 4.3.0 do not send or verify the tag of
+    // AEAD algorithms, so parallel transfers with them must use
+    // the default algorithm
+    int major = 0, minor = 0;
+    if ( sscanf( conn->svrVersion->relVersion, "rods%d.%d", &major, &minor ) == 2 &&
+         ( major < 4 || ( major == 4 && minor < 3 ) ) &&
+         irods::buffer_crypt( 0, 0, 0, rods_env.rodsEncryptionAlgorithm ).is_aead() ) {
+        rodsLog( LOG_DEBUG,
+                 "connectToRhost: server version %s does not support %s, using %s",
+                 conn->svrVersion->relVersion, rods_env.rodsEncryptionAlgorithm, "AES-256-CBC" );
+        snprintf( rods_env.rodsEncryptionAlgorithm, sizeof( rods_env.rodsEncryptionAlgorithm ), "%s", "AES-256-CBC" );
+    }
+
     ret = sockClientStart( new_net_obj, &rods_env );
     if ( !ret.ok() ) {
         irods::log( PASS( ret ) );
@@ -0,0 +1,423 @@
+#include "transfer_scheduler.hpp"
+
+#include "connection_pool.hpp"
+#include "irods_exception.hpp"
+#include "rcGlobalExtern.h"
+#include "rcMisc.h"
+#include "rodsDef.h"
+#include "rodsErrorTable.h"
+#include "rodsLog.h"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <utility>
+
+namespace
+{
+    // The number of transfers queued per worker before schedule() blocks. Keeps the
+    // directory walk slightly ahead of the workers without holding the whole tree in
+    // memory.
+    constexpr std::size_t queued_jobs_per_worker = 2;
+
+    // The progress callback is a plain function pointer, so the state needed to
+    // aggregate the progress of all workers lives here. Only one scheduler runs
+    // concurrently at a time (one per iput/iget invocation).
+    std::mutex progress_mutex;
+    guiProgressCallback user_progress_callback = nullptr;
+    operProgress_t* aggregate_progress = nullptr;
+
+    // Installed as gGuiProgressCB while workers run. Reports the file a worker is
+    // working on along with the totals of all workers.
+    void report_progress(operProgress_t* _progress)
+    {
+        std::lock_guard<std::mutex> lock{progress_mutex};
+
+        if (!aggregate_progress || !user_progress_callback) {
+            return;
+        }
+
+        rstrcpy(aggregate_progress->curFileName, _progress->curFileName, MAX_NAME_LEN);
+        aggregate_progress->curFileSize = _progress->curFileSize;
+        aggregate_progress->curFileSizeDone = _progress->curFileSizeDone;
+        aggregate_progress->flag = _progress->flag;
+
+        user_progress_callback(aggregate_progress);
+    } // report_progress
+} // anonymous namespace
+
+namespace irods::experimental
+{
+    auto transfer_scheduler::make_options(const rodsEnv& _env, int _requested_threads) -> options
+    {
+        options opts;
+
+        opts.max_files = std::max(1, _env.irodsParallelTransferFiles);
+        opts.default_threads = std::max(1, _env.irodsDefaultNumberTransferThreads);
+        opts.max_threads = _env.irodsTransferThreadBudget > 0
+                         ? _env.irodsTransferThreadBudget
+                         : opts.max_files * opts.default_threads;
+        opts.max_bytes_per_second = static_cast<rodsLong_t>(std::max(0, _env.irodsMaxBandwidthForTransfer)) * 1024 * 1024;
+        opts.max_size_for_single_buffer = static_cast<rodsLong_t>(_env.irodsMaxSizeForSingleBuffer) * 1024 * 1024;
+        opts.requested_threads = _requested_threads;
+
+        return opts;
+    } // make_options
+
+    auto transfer_scheduler::thread_cost(const options& _opts, rodsLong_t _size) noexcept -> int
+    {
+        if (NO_THREADING == _opts.requested_threads || _size <= _opts.max_size_for_single_buffer) {
+            return 1;
+        }
+
+        if (_opts.requested_threads > 0) {
+            return _opts.requested_threads;
+        }
+
+        // Mirrors the server's default of one thread per TRANS_SZ bytes.
+        const auto threads = (_size + TRANS_SZ - 1) / TRANS_SZ;
+
+        return static_cast<int>(std::clamp<rodsLong_t>(threads, 1, _opts.default_threads));
+    } // thread_cost
+
+    transfer_scheduler::transfer_scheduler(rcComm_t** _conn, const options& _opts, connect_function _on_connect)
+        : conn_{_conn}
+        , opts_{_opts}
+        , conn_pool_{}
+        , conn_proxies_{}
+        , thread_pool_{}
+        , mutex_{}
+        , cv_{}
+        , queue_{}
+        , results_{}
+        , next_sequence_{}
+        , first_result_sequence_{}
+        , available_threads_{}
+        , error_{}
+        , commits_stopped_{}
+        , stopping_{}
+        , next_start_{}
+        , saved_progress_callback_{}
+    {
+        if (opts_.max_files < 2) {
+            return;
+        }
+
+        rodsEnv env{};
+        _getRodsEnv(env);
+
+        try {
+            conn_pool_ = std::make_unique<connection_pool>(opts_.max_files,
+                                                           (*conn_)->host,
+                                                           (*conn_)->portNum,
+                                                           env.rodsUserName,
+                                                           env.rodsZone,
+                                                           env.irodsConnectionPoolRefreshTime);
+        }
+        catch (const std::exception& e) {
+            rodsLog(LOG_NOTICE, "transfer_scheduler: cannot connect workers, transferring one file at a time [%s]", e.what());
+            return;
+        }
+
+        std::vector<rcComm_t*> workers;
+        workers.reserve(opts_.max_files);
+
+        try {
+            // The pool has exactly one connection per worker. Each worker keeps its
+            // connection until the scheduler is destroyed.
+            for (int i = 0; i < opts_.max_files; ++i) {
+                auto& proxy = conn_proxies_.emplace_back(conn_pool_->get_connection());
+                rcComm_t& conn = proxy;
+
+                if (_on_connect) {
+                    _on_connect(conn);
+                }
+
+                workers.push_back(&conn);
+            }
+        }
+        catch (const std::exception& e) {
+            rodsLog(LOG_NOTICE, "transfer_scheduler: cannot connect workers, transferring one file at a time [%s]", e.what());
+            conn_proxies_.clear();
+            conn_pool_.reset();
+            return;
+        }
+
+        start(std::move(workers));
+    } // transfer_scheduler
+
+    transfer_scheduler::transfer_scheduler(rcComm_t** _conn, std::vector<rcComm_t*> _workers, const options& _opts)
+        : conn_{_conn}
+        , opts_{_opts}
+        , conn_pool_{}
+        , conn_proxies_{}
+        , thread_pool_{}
+        , mutex_{}
+        , cv_{}
+        , queue_{}
+        , results_{}
+        , next_sequence_{}
+        , first_result_sequence_{}
+        , available_threads_{}
+        , error_{}
+        , commits_stopped_{}
+        , stopping_{}
+        , next_start_{}
+        , saved_progress_callback_{}
+    {
+        if (!_workers.empty()) {
+            opts_.max_files = static_cast<int>(_workers.size());
+            start(std::move(_workers));
+        }
+    } // transfer_scheduler
+
+    transfer_scheduler::~transfer_scheduler()
+    {
+        if (!concurrent()) {
+            return;
+        }
+
+        wait();
+
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            stopping_ = true;
+        }
+
+        cv_.notify_all();
+        thread_pool_->join();
+
+        if (saved_progress_callback_) {
+            std::lock_guard<std::mutex> lock{progress_mutex};
+            gGuiProgressCB = saved_progress_callback_;
+            user_progress_callback = nullptr;
+            aggregate_progress = nullptr;
+        }
+    } // ~transfer_scheduler
+
+    auto transfer_scheduler::concurrent() const noexcept -> bool
+    {
+        return static_cast<bool>(thread_pool_);
+    } // concurrent
+
+    auto transfer_scheduler::schedule(rodsLong_t _size, transfer_function _transfer, commit_function _commit) -> int
+    {
+        if (!concurrent()) {
+            const int status = _transfer(**conn_, opts_.requested_threads);
+
+            if (status < 0 || !_commit) {
+                return status;
+            }
+
+            return _commit();
+        }
+
+        std::unique_lock<std::mutex> lock{mutex_};
+
+        for (;;) {
+            run_commits(lock);
+
+            if (opts_.stop_on_error && error_ < 0) {
+                return error_;
+            }
+
+            if (queue_.size() < queued_jobs_per_worker * opts_.max_files) {
+                break;
+            }
+
+            cv_.wait(lock);
+        }
+
+        results_.push_back({_size, std::move(_commit), false, 0});
+        queue_.push_back({next_sequence_++, _size, std::move(_transfer)});
+
+        lock.unlock();
+        cv_.notify_all();
+
+        return 0;
+    } // schedule
+
+    auto transfer_scheduler::wait() -> int
+    {
+        if (!concurrent()) {
+            return 0;
+        }
+
+        std::unique_lock<std::mutex> lock{mutex_};
+
+        for (;;) {
+            run_commits(lock);
+
+            if (results_.empty()) {
+                break;
+            }
+
+            cv_.wait(lock);
+        }
+
+        const int status = error_;
+        error_ = 0;
+        commits_stopped_ = false;
+
+        return status;
+    } // wait
+
+    auto transfer_scheduler::start(std::vector<rcComm_t*> _workers) -> void
+    {
+        available_threads_ = std::max(opts_.max_threads, opts_.max_files);
+
+        if (gGuiProgressCB && report_progress != gGuiProgressCB) {
+            std::lock_guard<std::mutex> lock{progress_mutex};
+            saved_progress_callback_ = gGuiProgressCB;
+            user_progress_callback = gGuiProgressCB;
+            aggregate_progress = &(*conn_)->operProgress;
+            gGuiProgressCB = report_progress;
+        }
+
+        thread_pool_ = std::make_unique<thread_pool>(static_cast<int>(_workers.size()));
+
+        for (auto* conn : _workers) {
+            thread_pool::post(*thread_pool_, [this, conn] { run_worker(*conn); });
+        }
+    } // start
+
+    auto transfer_scheduler::run_worker(rcComm_t& _conn) -> void
+    {
+        for (;;) {
+            job j;
+            int granted = 0;
+            std::chrono::steady_clock::time_point start_time;
+
+            {
+                std::unique_lock<std::mutex> lock{mutex_};
+
+                cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+
+                if (queue_.empty()) {
+                    return;
+                }
+
+                j = std::move(queue_.front());
+                queue_.pop_front();
+                cv_.notify_all();
+
+                if (opts_.stop_on_error && error_ < 0) {
+                    // Not counted as a failure. The commits stopped at the transfer that
+                    // failed, which was scheduled before this one.
+                    auto& r = results_[j.sequence - first_result_sequence_];
+                    r.done = true;
+                    cv_.notify_all();
+                    continue;
+                }
+
+                const int cost = thread_cost(opts_, j.size);
+                cv_.wait(lock, [this] { return available_threads_ > 0; });
+                granted = std::min(cost, available_threads_);
+                available_threads_ -= granted;
+
+                start_time = reserve_bandwidth(j.size);
+            }
+
+            std::this_thread::sleep_until(start_time);
+
+            const int status = run_job(_conn, j, num_threads_for(j.size, granted));
+
+            if (status >= 0 && saved_progress_callback_) {
+                std::lock_guard<std::mutex> lock{progress_mutex};
+                aggregate_progress->totalNumFilesDone++;
+                aggregate_progress->totalFileSizeDone += j.size;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+
+                available_threads_ += granted;
+
+                auto& r = results_[j.sequence - first_result_sequence_];
+                r.done = true;
+                r.status = status;
+
+                if (status < 0 && 0 == error_) {
+                    error_ = status;
+                }
+            }
+
+            cv_.notify_all();
+        }
+    } // run_worker
+
+    auto transfer_scheduler::run_job(rcComm_t& _conn, job& _job, int _num_threads) -> int
+    {
+        try {
+            return _job.transfer(_conn, _num_threads);
+        }
+        catch (const irods::exception& e) {
+            rodsLog(LOG_ERROR, "transfer_scheduler: %s", e.client_display_what());
+            return e.code();
+        }
+        catch (const std::exception& e) {
+            rodsLog(LOG_ERROR, "transfer_scheduler: %s", e.what());
+            return SYS_INTERNAL_ERR;
+        }
+    } // run_job
+
+    auto transfer_scheduler::num_threads_for(rodsLong_t _size, int _granted) const noexcept -> int
+    {
+        // Small files and files the user asked not to split keep the requested value so
+        // the server behaves exactly as it would without the scheduler.
+        if (NO_THREADING == opts_.requested_threads || _size <= opts_.max_size_for_single_buffer) {
+            return opts_.requested_threads;
+        }
+
+        return _granted;
+    } // num_threads_for
+
+    auto transfer_scheduler::reserve_bandwidth(rodsLong_t _size) -> std::chrono::steady_clock::time_point
+    {
+        const auto now = std::chrono::steady_clock::now();
+
+        if (opts_.max_bytes_per_second <= 0) {
+            return now;
+        }
+
+        // Each file reserves the time it takes to send it at the maximum rate. A file
+        // starts when the files before it have used up their reservations, so the
+        // average rate over any run of files does not exceed the limit.
+        const auto start_time = std::max(now, next_start_);
+        const std::chrono::duration<double> duration{static_cast<double>(_size) / opts_.max_bytes_per_second};
+        next_start_ = start_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration);
+
+        return start_time;
+    } // reserve_bandwidth
+
+    auto transfer_scheduler::run_commits(std::unique_lock<std::mutex>& _lock) -> void
+    {
+        while (!results_.empty() && results_.front().done) {
+            auto r = std::move(results_.front());
+            results_.pop_front();
+            ++first_result_sequence_;
+
+            if (r.status < 0) {
+                commits_stopped_ = true;
+            }
+
+            if (commits_stopped_ || !r.commit) {
+                continue;
+            }
+
+            _lock.unlock();
+            const int status = r.commit();
+            _lock.lock();
+
+            if (status < 0) {
+                commits_stopped_ = true;
+
+                if (0 == error_) {
+                    error_ = status;
+                }
+            }
+        }
+    } // run_commits
+} // namespace irods::experimental
+
@@ -46,6 +46,7 @@
 
 #define DEF_UDP_SEND_RATE       600000
 #define DEF_UDP_PACKET_SIZE     8192
+#define RBUDP_BATCH_SIZE        64	/* packets per sendmmsg()/recvmmsg() call */
 #define	ONE_GIGA		(1610612736)	/* 1.5 g */
 
 #define USEC(st, fi) (((fi)->tv_sec-(st)->tv_sec)*1000000+((fi)->tv_usec-(st)->tv_usec))
@@ -126,6 +127,18 @@ typedef struct  QUANTAnet_rbudpBase_c {
     FILE *progress;
     struct _endOfUdp endOfUdp;
 
+    // In-process loss simulation so that transfers can be tested over the
+    // loopback interface.  The receiver drops arriving packets at random
+    // with probability simLossRate (like netem "loss"), and, if
+    // simBottleneckRate (Kbps) is set, drops packets arriving faster than a
+    // link of that rate with a queue of simQueuePackets packets can carry.
+    double simLossRate;
+    int simBottleneckRate;
+    int simQueuePackets;
+    unsigned int simSeed;
+    double simTokens;
+    struct timeval simLastArrival;
+
 } rbudpBase_t;
 
 int reportTime( struct timeval *curTime );
@@ -163,6 +176,8 @@ void initErrorBitmap( rbudpBase_t *rbudpBase );
 void updateErrorBitmap( rbudpBase_t *rbudpBase, long long seq );
 /// Update the hash table of need-to-send UDP packets.  Should be called when a new bitmap is received.
 int updateHashTable( rbudpBase_t *rbudpBase );
+/// Returns RB_TRUE if the loss simulation drops the packet that just arrived
+int simulatePacketLoss( rbudpBase_t *rbudpBase );
 /// convert peer's sequence numbers to our internal form (maybe byteswapped)
 int ptohseq( rbudpBase_t *rbudpBase, int seq );
 
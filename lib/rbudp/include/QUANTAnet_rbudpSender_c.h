@@ -31,6 +31,17 @@
 #define MAX_SEND_ERR_CNT	1000
 #define MAX_NO_PROGRESS_CNT	10
 
+/* Rate adaptation.  After every round the sending rate is cut back to what
+ * the receiver actually got if more than RBUDP_HIGH_LOSS_RATE of the round
+ * was lost, and raised by a quarter if less than RBUDP_LOW_LOSS_RATE was. */
+#define RBUDP_HIGH_LOSS_RATE	0.02
+#define RBUDP_LOW_LOSS_RATE	0.002
+#define RBUDP_BACKOFF_FACTOR	0.9
+#define RBUDP_MIN_ADAPT_PACKETS	64	/* smaller rounds say little about the path */
+#define RBUDP_MIN_SEND_RATE	10000	/* Kbps */
+#define RBUDP_MAX_RATE_FACTOR	4	/* default ceiling, as a multiple of the requested rate */
+#define RBUDP_MAX_STREAMS	16
+
 /**
 RBUDP Sender class.   This class implements the sender part of RBUDP protocol. First, instantiate the QUANTAnet_rbudpSender_c class. Then
 call this object's init() method with the host name or IP address of the
@@ -47,6 +58,18 @@ typedef struct  QUANTAnet_rbudpSender_c {
     struct msghdr msgSend;
     struct iovec iovSend[2];
     struct _rbudpHeader sendHeader;
+
+    // Number of threads blasting over the UDP socket, each one paced at an
+    // equal share of the rate.  0 or 1 sends from the calling thread.
+    int numStreams;
+
+    // Ceiling in Kbps for rate increases.  0 means RBUDP_MAX_RATE_FACTOR
+    // times the rate passed to sendBuf().
+    int maxSendRate;
+
+    // The adapted rate in Kbps, carried over from one buffer to the next.
+    // 0 means start at the rate passed to sendBuf().
+    int pacedRate;
 } rbudpSender_t;
 
 void udpSendWritev();
@@ -54,6 +77,16 @@ int udpSend( rbudpSender_t *rbudpSender );
 int initSendRudp( rbudpSender_t *rbudpSender, void* buffer,
                   int bufSize, int sRate, int pSize );
 
+/** Compute the sending rate for the next round from the last one.
+	@param rate the rate in Kbps the last round was paced at.
+	@param achievedRate the rate in Kbps the last round was actually sent at, or 0 if unknown.
+	@param minRate the lower bound in Kbps.
+	@param maxRate the upper bound in Kbps.
+	@param lossRate the fraction of the last round the receiver reported missing.
+*/
+int adaptSendRate( int rate, int achievedRate, int minRate, int maxRate,
+                   double lossRate );
+
 /** Constructor by telling which TCP and UDP ports we are going to use.
         @ param port the TCP server port and UDP local and remote ports will be calculated based on it.
 */
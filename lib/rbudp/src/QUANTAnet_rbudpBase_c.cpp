@@ -25,6 +25,9 @@
 #include <stdarg.h>
 #include "rcMisc.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 // inline void TRACE_DEBUG( char *format, ...)
 void TRACE_DEBUG( char *format, ... ) {
     va_list arglist;
@@ -331,6 +334,40 @@ int ptohseq( rbudpBase_t *rbudpBase, int origseq ) {
     return seq;
 }
 
+int simulatePacketLoss( rbudpBase_t *rbudpBase ) {
+    if ( rbudpBase->simLossRate > 0 &&
+            rand_r( &rbudpBase->simSeed ) < rbudpBase->simLossRate * ( ( double ) RAND_MAX + 1 ) ) {
+        return RB_TRUE;
+    }
+
+    if ( rbudpBase->simBottleneckRate > 0 ) {
+        // Token bucket in bits: the link drains simBottleneckRate Kbps and
+        // the queue in front of it holds simQueuePackets packets.
+        const int queuePackets = rbudpBase->simQueuePackets > 0 ?
+                                 rbudpBase->simQueuePackets : RBUDP_BATCH_SIZE;
+        const double packetBits = 8.0 * rbudpBase->packetSize;
+        const double capacity = queuePackets * packetBits;
+        struct timeval now;
+
+        gettimeofday( &now, NULL );
+        if ( rbudpBase->simLastArrival.tv_sec == 0 ) {
+            rbudpBase->simTokens = capacity;
+        }
+        else {
+            rbudpBase->simTokens = std::min( capacity, rbudpBase->simTokens +
+                                             USEC( &rbudpBase->simLastArrival, &now ) *
+                                             ( double ) rbudpBase->simBottleneckRate / 1000 );
+        }
+        rbudpBase->simLastArrival = now;
+
+        if ( rbudpBase->simTokens < packetBits ) {
+            return RB_TRUE;
+        }
+        rbudpBase->simTokens -= packetBits;
+    }
+
+    return RB_FALSE;
+}
 
 void updateErrorBitmap( rbudpBase_t *rbudpBase, long long seq ) {
     long long index_in_list, offset_in_index;
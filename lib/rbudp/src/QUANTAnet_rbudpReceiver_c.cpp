@@ -120,15 +120,113 @@ int  receiveBuf( rbudpReceiver_t *rbudpReceiver, void * buffer, int bufSize,
     return 0;
 }
 
+/* Receive the packets that are waiting on the UDP socket, up to
+ * RBUDP_BATCH_SIZE of them, into consecutive packetSize slots of buf.  The
+ * length of each packet is stored in lens.  Returns the number of packets. */
+static int udpReceiveBatch( rbudpReceiver_t *rbudpReceiver, char *buf, int *lens ) {
+    rbudpBase_t *rbudpBase = &rbudpReceiver->rbudpBase;
+    // made connect already if the address is not set
+    const bool connected = rbudpBase->udpServerAddr.sin_addr.s_addr == htonl( INADDR_ANY );
+#ifdef __linux__
+    struct mmsghdr msgs[RBUDP_BATCH_SIZE];
+    struct iovec iov[RBUDP_BATCH_SIZE];
+
+    memset( msgs, 0, sizeof( msgs ) );
+    for ( int i = 0; i < RBUDP_BATCH_SIZE; i++ ) {
+        iov[i].iov_base = buf + i * rbudpBase->packetSize;
+        iov[i].iov_len = rbudpBase->packetSize;
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        if ( !connected ) {
+            msgs[i].msg_hdr.msg_name = ( char * ) &rbudpBase->udpServerAddr;
+            msgs[i].msg_hdr.msg_namelen = sizeof( rbudpBase->udpServerAddr );
+        }
+    }
+
+    const int n = recvmmsg( rbudpBase->udpSockfd, msgs, RBUDP_BATCH_SIZE, MSG_WAITFORONE, NULL );
+    if ( n < 0 ) {
+        perror( "recvmmsg" );
+        return errno ? ( -1 * errno ) : -1;
+    }
+    for ( int i = 0; i < n; i++ ) {
+        lens[i] = msgs[i].msg_len;
+    }
+    return n;
+#else
+    ssize_t len;
+    if ( connected ) {
+        len = recv( rbudpBase->udpSockfd, buf, rbudpBase->packetSize, 0 );
+    }
+    else {
+        socklen_t fromlen = sizeof( rbudpBase->udpServerAddr );
+        len = recvfrom( rbudpBase->udpSockfd, buf, rbudpBase->packetSize, 0,
+                        ( struct sockaddr * )&rbudpBase->udpServerAddr, &fromlen );
+    }
+    if ( len < 0 ) {
+        perror( "recv" );
+        return errno ? ( -1 * errno ) : -1;
+    }
+    lens[0] = len;
+    return 1;
+#endif
+}
+
+/* Copy a received packet into place and mark it in the error bitmap. */
+static void processPacket( rbudpReceiver_t *rbudpReceiver, const char *msg,
+                           int len, int *oldprog ) {
+    if ( len < rbudpReceiver->rbudpBase.headerSize ) {
+        return;
+    }
+    if ( simulatePacketLoss( &rbudpReceiver->rbudpBase ) ) {
+        return;
+    }
+
+    bcopy( msg, &rbudpReceiver->recvHeader, sizeof( struct _rbudpHeader ) );
+    const long long seqno = ptohseq( &rbudpReceiver->rbudpBase, rbudpReceiver->recvHeader.seq );
+
+    // If the packet is the last one,
+    int actualPayloadSize = 0;
+    if ( seqno < rbudpReceiver->rbudpBase.totalNumberOfPackets - 1 ) {
+        actualPayloadSize = rbudpReceiver->rbudpBase.payloadSize;
+    }
+    else {
+        actualPayloadSize = rbudpReceiver->rbudpBase.lastPayloadSize;
+    }
+
+    bcopy( msg + rbudpReceiver->rbudpBase.headerSize,
+           ( char * )rbudpReceiver->rbudpBase.mainBuffer +
+           ( seqno * rbudpReceiver->rbudpBase.payloadSize ) ,
+           actualPayloadSize );
+
+    updateErrorBitmap( &rbudpReceiver->rbudpBase, seqno );
+
+    rbudpReceiver->rbudpBase.receivedNumberOfPackets ++;
+    const float prog = ( float )
+                       rbudpReceiver->rbudpBase.receivedNumberOfPackets /
+                       ( float ) rbudpReceiver->rbudpBase.totalNumberOfPackets
+                       * 100;
+    if ( ( int )prog > *oldprog ) {
+        *oldprog = ( int )prog;
+        if ( *oldprog > 100 ) {
+            *oldprog = 100;
+        }
+        if ( rbudpReceiver->rbudpBase.progress != 0 ) {
+            fseek( rbudpReceiver->rbudpBase.progress,
+                   0, SEEK_SET );
+            fprintf( rbudpReceiver->rbudpBase.progress,
+                     "%d\n", *oldprog );
+        }
+    }
+}
+
 int udpReceive( rbudpReceiver_t *rbudpReceiver ) {
-    std::vector<char> msg( rbudpReceiver->rbudpBase.packetSize );
+    std::vector<char> msg( RBUDP_BATCH_SIZE * rbudpReceiver->rbudpBase.packetSize );
+    int lens[RBUDP_BATCH_SIZE];
     struct timeval timeout;
     fd_set rset;
     int oldprog = 0;
     bool done = false;
 
-    timeout.tv_sec = 10;
-    timeout.tv_usec = 0;
 #define QMAX(x, y) ((x)>(y)?(x):(y))
     const int maxfdpl = QMAX( rbudpReceiver->rbudpBase.udpSockfd,
                               rbudpReceiver->rbudpBase.tcpSockfd ) + 1;
@@ -137,68 +235,24 @@ int udpReceive( rbudpReceiver_t *rbudpReceiver ) {
         // These two FD_SET cannot be put outside the while, don't why though
         FD_SET( rbudpReceiver->rbudpBase.udpSockfd, &rset );
         FD_SET( rbudpReceiver->rbudpBase.tcpSockfd, &rset );
+        // select() may modify the timeout, so it is reset on every call.
+        timeout.tv_sec = 10;
+        timeout.tv_usec = 0;
         const int retval = select( maxfdpl, &rset, NULL, NULL, &timeout );
         if ( retval <= 0 ) {
             irods::log( ERROR( retval, boost::format("select failed. retval [%d]") % retval ) );
         }
-        // receiving a packet
+        // receiving packets
         if ( FD_ISSET( rbudpReceiver->rbudpBase.udpSockfd, &rset ) ) {
-            if ( rbudpReceiver->rbudpBase.udpServerAddr.sin_addr.s_addr == htonl( INADDR_ANY ) ) {
-                // made connect already
-                if ( recv( rbudpReceiver->rbudpBase.udpSockfd, &msg[0],
-                           rbudpReceiver->rbudpBase.packetSize, 0 ) < 0 ) {
-                    perror( "recv" );
-                    return errno ? ( -1 * errno ) : -1;
-                }
-            }
-            else {
-                socklen_t fromlen = sizeof( rbudpReceiver->rbudpBase.udpServerAddr );
-                if ( recvfrom( rbudpReceiver->rbudpBase.udpSockfd,
-                               &msg[0], rbudpReceiver->rbudpBase.packetSize, 0,
-                               ( struct sockaddr * )&rbudpReceiver->rbudpBase.udpServerAddr,
-                               &fromlen ) < 0 ) {
-                    perror( "recvfrom" );
-                    return errno ? ( -1 * errno ) : -1;
-                }
-            }
-
-            bcopy( &msg[0], &rbudpReceiver->recvHeader, sizeof( struct _rbudpHeader ) );
-            const long long seqno = ptohseq( &rbudpReceiver->rbudpBase, rbudpReceiver->recvHeader.seq );
-
-            // If the packet is the last one,
-            int actualPayloadSize = 0;
-            if ( seqno < rbudpReceiver->rbudpBase.totalNumberOfPackets - 1 ) {
-                actualPayloadSize = rbudpReceiver->rbudpBase.payloadSize;
-            }
-            else {
-                actualPayloadSize = rbudpReceiver->rbudpBase.lastPayloadSize;
+            const int n = udpReceiveBatch( rbudpReceiver, &msg[0], lens );
+            if ( n < 0 ) {
+                return n;
             }
-
-            bcopy( &msg[0] + rbudpReceiver->rbudpBase.headerSize,
-                   ( char * )rbudpReceiver->rbudpBase.mainBuffer +
-                   ( seqno * rbudpReceiver->rbudpBase.payloadSize ) ,
-                   actualPayloadSize );
-
-            updateErrorBitmap( &rbudpReceiver->rbudpBase, seqno );
-
-            rbudpReceiver->rbudpBase.receivedNumberOfPackets ++;
-            const float prog = ( float )
-                               rbudpReceiver->rbudpBase.receivedNumberOfPackets /
-                               ( float ) rbudpReceiver->rbudpBase.totalNumberOfPackets
-                               * 100;
-            if ( ( int )prog > oldprog ) {
-                oldprog = ( int )prog;
-                if ( oldprog > 100 ) {
-                    oldprog = 100;
-                }
-                if ( rbudpReceiver->rbudpBase.progress != 0 ) {
-                    fseek( rbudpReceiver->rbudpBase.progress,
-                           0, SEEK_SET );
-                    fprintf( rbudpReceiver->rbudpBase.progress,
-                             "%d\n", oldprog );
-                }
+            for ( int i = 0; i < n; i++ ) {
+                processPacket( rbudpReceiver,
+                               &msg[0] + i * rbudpReceiver->rbudpBase.packetSize,
+                               lens[i], &oldprog );
             }
-
         }
         //receive end of UDP signal
         else if ( FD_ISSET( rbudpReceiver->rbudpBase.tcpSockfd, &rset ) ) {
@@ -24,10 +24,16 @@
 #include "rodsErrorTable.h"
 #include "rodsLog.h"
 
+#include <algorithm>
+#include <climits>
 #include <cstdlib>
 #include <stdarg.h>
 #include <string>
 #include <limits>
+#include <thread>
+#include <vector>
+
+#include <time.h>
 
 // If you want to output debug info on terminals when running, put
 //  fprintf(stderr, __VA_ARGS__);
@@ -53,6 +59,9 @@ QUANTAnet_rbudpSender_c( rbudpSender_t *rbudpSender, int port ) {
     rbudpSender->rbudpBase.udpLocalPort = port;
     rbudpSender->rbudpBase.udpRemotePort = port + 1;
     rbudpSender->rbudpBase.hasTcpSock = 0;
+    rbudpSender->numStreams = 0;
+    rbudpSender->maxSendRate = 0;
+    rbudpSender->pacedRate = 0;
 }
 
 void QUANTAnet_rbudpSender_reuse( rbudpSender_t *rbudpSender,
@@ -74,21 +83,29 @@ int  sendBuf( rbudpSender_t *rbudpSender, void * buffer, int bufSize,
     startTime = curTime;
     int lastRemainNumberOfPackets = 0;
     int noProgressCnt = 0;
-    initSendRudp( rbudpSender, buffer, bufSize, sendRate, packetSize );
+    const int minRate = std::min( sendRate, RBUDP_MIN_SEND_RATE );
+    const int maxRate = rbudpSender->maxSendRate > 0 ? rbudpSender->maxSendRate :
+                        ( int ) std::min( ( long long ) INT_MAX, ( long long ) sendRate * RBUDP_MAX_RATE_FACTOR );
+    if ( rbudpSender->pacedRate < 1 ) {
+        rbudpSender->pacedRate = sendRate;
+    }
+    initSendRudp( rbudpSender, buffer, bufSize, rbudpSender->pacedRate, packetSize );
     while ( !done ) {
         // blast UDP packets
         if ( rbudpSender->rbudpBase.verbose > 1 ) {
             TRACE_DEBUG( "sending UDP packets" );
         }
+        const int sentNumberOfPackets = rbudpSender->rbudpBase.remainNumberOfPackets;
         reportTime( &curTime );
         status = udpSend( rbudpSender );
         if ( status < 0 ) {
             return status;
         }
 
-        srate = ( double ) rbudpSender->rbudpBase.remainNumberOfPackets *
+        const int usecs = reportTime( &curTime );
+        srate = ( double ) sentNumberOfPackets *
                 rbudpSender->rbudpBase.payloadSize * 8 /
-                ( double ) reportTime( &curTime );
+                ( double )( usecs > 0 ? usecs : 1 );
         if ( rbudpSender->rbudpBase.verbose > 1 ) {
             TRACE_DEBUG( "real sending rate in this send is %f", srate );
         }
@@ -154,13 +171,31 @@ int  sendBuf( rbudpSender_t *rbudpSender, void * buffer, int bufSize,
             }
         }
 
+        // Pace the next round (and the next buffer) by what the receiver
+        // reported missing from this one.
+        if ( sentNumberOfPackets >= RBUDP_MIN_ADAPT_PACKETS ) {
+            const double roundLossRate =
+                ( double )rbudpSender->rbudpBase.remainNumberOfPackets /
+                ( double )sentNumberOfPackets;
+            const int achievedRate = ( int ) std::min( ( double ) INT_MAX, srate * 1000 );
+            const int rate = adaptSendRate( rbudpSender->rbudpBase.sendRate, achievedRate,
+                                            minRate, maxRate, roundLossRate );
+            if ( rate != rbudpSender->rbudpBase.sendRate ) {
+                rbudpSender->rbudpBase.sendRate = rate;
+                rbudpSender->rbudpBase.usecsPerPacket =
+                    8 * rbudpSender->rbudpBase.payloadSize * 1000 / rate;
+                rbudpSender->pacedRate = rate;
+                if ( rbudpSender->rbudpBase.verbose > 1 )
+                    TRACE_DEBUG( "round loss rate %f, sendRate updated to %d Kbps",
+                                 roundLossRate, rate );
+            }
+        }
+
         if ( rbudpSender->rbudpBase.isFirstBlast ) {
             rbudpSender->rbudpBase.isFirstBlast = 0;
             double lossRate =
                 ( double )rbudpSender->rbudpBase.remainNumberOfPackets /
                 ( double )rbudpSender->rbudpBase.totalNumberOfPackets;
-            //	if (rbudpSender->rbudpBase.remainNumberOfPackets > 0)
-            //	    usecsPerPacket = (int) ((double)usecsPerPacket / (1.0 - lossRate - 0.05));
             if ( rbudpSender->rbudpBase.verbose > 0 ) {
                 float dt = ( curTime.tv_sec - startTime.tv_sec )
                            + 1e-6 * ( curTime.tv_usec - startTime.tv_usec );
@@ -178,81 +213,179 @@ int  sendBuf( rbudpSender_t *rbudpSender, void * buffer, int bufSize,
     return 0;
 }
 
-/* XXXXX need to handle status */
-int
-udpSend( rbudpSender_t *rbudpSender ) {
-    int i, done, actualPayloadSize;
-    struct timeval start, now;
-    char *msg = ( char * ) malloc( rbudpSender->rbudpBase.packetSize );
-    int sendErrCnt = 0;
+int adaptSendRate( int rate, int achievedRate, int minRate, int maxRate,
+                   double lossRate ) {
+    long long newRate = rate;
 
-    done = 0;
-    i = 0;
-    gettimeofday( &start, NULL );
-    while ( !done ) {
-        gettimeofday( &now, NULL );
-        if ( USEC( &start, &now ) < rbudpSender->rbudpBase.usecsPerPacket * i ) {
-            // busy wait or sleep
-            //		usleep(1);
-        }
-        else {
-            // last packet is probably smaller than regular packets
-            // we have to pad the last packet, make it the same length
-            // as regular packets
-            if ( rbudpSender->rbudpBase.hashTable[i] <
-                    rbudpSender->rbudpBase.totalNumberOfPackets - 1 ) {
-                actualPayloadSize =
-                    rbudpSender->rbudpBase.payloadSize;
-            }
-            else {
-                actualPayloadSize =
-                    rbudpSender->rbudpBase.lastPayloadSize;
-            }
-            rbudpSender->sendHeader.seq =
-                rbudpSender->rbudpBase.hashTable[i];
-            bcopy( &rbudpSender->sendHeader, msg,
-                   rbudpSender->rbudpBase.headerSize );
-            bcopy( ( char* )( ( char* )rbudpSender->rbudpBase.mainBuffer +
-                              ( rbudpSender->sendHeader.seq *
-                                rbudpSender->rbudpBase.payloadSize ) ),
-                   msg + rbudpSender->rbudpBase.headerSize,
-                   actualPayloadSize );
-
-            //TRACE_DEBUG("sent %d, packet size: %d",
-            // sendHeader.seq, actualPayloadSize+headerSize);
-            if ( rbudpSender->rbudpBase.udpServerAddr.sin_addr.s_addr			  == htonl( INADDR_ANY ) ) {
-                if ( send( rbudpSender->rbudpBase.udpSockfd, msg,
-                           actualPayloadSize +
-                           rbudpSender->rbudpBase.headerSize, 0 ) < 0 ) {
-                    perror( "send" );
-                    sendErrCnt++;
-                    if ( sendErrCnt > MAX_SEND_ERR_CNT ) {
-                        return SYS_UDP_TRANSFER_ERR - errno;
-                    }
-                }
-            }
-            else {
-                if ( sendto( rbudpSender->rbudpBase.udpSockfd, msg,
-                             actualPayloadSize +
-                             rbudpSender->rbudpBase.headerSize, 0,
-                             ( const struct sockaddr * )
-                             &rbudpSender->rbudpBase.udpServerAddr,
-                             sizeof( rbudpSender->rbudpBase.udpServerAddr ) )
-                        < 0 ) {
-                    perror( "sendto" );
-                    sendErrCnt++;
-                    if ( sendErrCnt > MAX_SEND_ERR_CNT ) {
-                        return SYS_UDP_TRANSFER_ERR - errno;
-                    }
-                }
+    if ( lossRate > RBUDP_HIGH_LOSS_RATE ) {
+        // Back off to what got through, leaving room for queues to drain.
+        // If the sender could not keep up with its own pacing, what it
+        // actually sent is the better estimate of what was offered.
+        const int offeredRate = ( achievedRate > 0 && achievedRate < rate ) ? achievedRate : rate;
+        newRate = ( long long )( offeredRate * ( 1.0 - lossRate ) * RBUDP_BACKOFF_FACTOR );
+    }
+    else if ( lossRate < RBUDP_LOW_LOSS_RATE ) {
+        newRate = ( long long ) rate + rate / 4;
+    }
+
+    if ( newRate > maxRate ) {
+        newRate = maxRate;
+    }
+    if ( newRate < minRate ) {
+        newRate = minRate;
+    }
+    return ( int ) newRate;
+}
+
+static double monotonicNsec() {
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Send the batch of packets described by msgs.  A packet the kernel refuses
+ * is counted against MAX_SEND_ERR_CNT and skipped; the receiver will ask for
+ * it again in the next round. */
+#ifdef __linux__
+static int udpSendBatch( int udpSockfd, struct mmsghdr *msgs, int count,
+                         int *sendErrCnt ) {
+    int sent = 0;
+    while ( sent < count ) {
+        const int n = sendmmsg( udpSockfd, msgs + sent, count - sent, 0 );
+        if ( n >= 0 ) {
+            sent += n;
+            continue;
+        }
+        if ( errno == EINTR ) {
+            continue;
+        }
+        perror( "sendmmsg" );
+        ( *sendErrCnt )++;
+        if ( *sendErrCnt > MAX_SEND_ERR_CNT ) {
+            return SYS_UDP_TRANSFER_ERR - errno;
+        }
+        sent++;
+    }
+    return 0;
+}
+#else
+static int udpSendBatch( int udpSockfd, struct msghdr *msgs, int count,
+                         int *sendErrCnt ) {
+    for ( int i = 0; i < count; i++ ) {
+        if ( sendmsg( udpSockfd, &msgs[i], 0 ) < 0 ) {
+            perror( "sendmsg" );
+            ( *sendErrCnt )++;
+            if ( *sendErrCnt > MAX_SEND_ERR_CNT ) {
+                return SYS_UDP_TRANSFER_ERR - errno;
             }
-            i++;
-            if ( i >= rbudpSender->rbudpBase.remainNumberOfPackets ) {
-                done = 1;
+        }
+    }
+    return 0;
+}
+#endif
+
+/* Send hashTable[first], hashTable[first + stride], ... one packet every
+ * nsecsPerPacket.  Packets that are due are sent together, up to
+ * RBUDP_BATCH_SIZE at a time, straight out of mainBuffer. */
+static int udpSendStream( rbudpSender_t *rbudpSender, int first, int stride,
+                          double nsecsPerPacket ) {
+    rbudpBase_t *rbudpBase = &rbudpSender->rbudpBase;
+    struct _rbudpHeader headers[RBUDP_BATCH_SIZE];
+    struct iovec iov[RBUDP_BATCH_SIZE][2];
+#ifdef __linux__
+    struct mmsghdr msgs[RBUDP_BATCH_SIZE];
+#else
+    struct msghdr msgs[RBUDP_BATCH_SIZE];
+#endif
+    // See udpReceive(); an unset address means the socket is connected.
+    const bool connected = rbudpBase->udpServerAddr.sin_addr.s_addr == htonl( INADDR_ANY );
+    int sendErrCnt = 0;
+    long long sent = 0;
+    int i = first;
+
+    memset( msgs, 0, sizeof( msgs ) );
+    const double start = monotonicNsec();
+    while ( i < rbudpBase->remainNumberOfPackets ) {
+        const double elapsed = monotonicNsec() - start;
+        const long long due = ( long long )( elapsed / nsecsPerPacket ) + 1 - sent;
+        if ( due <= 0 ) {
+            // Sleep until the next packet is due.  The last few microseconds
+            // are spun away because the timer slack would overshoot them.
+            const double wait = sent * nsecsPerPacket - elapsed - 50000;
+            if ( wait > 0 ) {
+                struct timespec ts;
+                ts.tv_sec = ( time_t )( wait / 1e9 );
+                ts.tv_nsec = ( long )( wait - ts.tv_sec * 1e9 );
+                nanosleep( &ts, NULL );
             }
+            continue;
+        }
+
+        int count = 0;
+        while ( count < due && count < RBUDP_BATCH_SIZE &&
+                i < rbudpBase->remainNumberOfPackets ) {
+            const long long seq = rbudpBase->hashTable[i];
+            // last packet is probably smaller than regular packets
+            const int actualPayloadSize = seq < rbudpBase->totalNumberOfPackets - 1 ?
+                                          rbudpBase->payloadSize : rbudpBase->lastPayloadSize;
+            headers[count].seq = ( int ) seq;
+            iov[count][0].iov_base = ( char * ) &headers[count];
+            iov[count][0].iov_len = rbudpBase->headerSize;
+            iov[count][1].iov_base = rbudpBase->mainBuffer + seq * rbudpBase->payloadSize;
+            iov[count][1].iov_len = actualPayloadSize;
+#ifdef __linux__
+            struct msghdr *msg = &msgs[count].msg_hdr;
+#else
+            struct msghdr *msg = &msgs[count];
+#endif
+            msg->msg_name = connected ? NULL : ( char * ) &rbudpBase->udpServerAddr;
+            msg->msg_namelen = connected ? 0 : sizeof( rbudpBase->udpServerAddr );
+            msg->msg_iov = iov[count];
+            msg->msg_iovlen = 2;
+            count++;
+            i += stride;
+        }
+        sent += count;
+
+        const int status = udpSendBatch( rbudpBase->udpSockfd, msgs, count, &sendErrCnt );
+        if ( status < 0 ) {
+            return status;
+        }
+    }
+    return 0;
+}
+
+int
+udpSend( rbudpSender_t *rbudpSender ) {
+    const int numStreams = std::max( 1, std::min( { rbudpSender->numStreams,
+                                                    RBUDP_MAX_STREAMS,
+                                                    rbudpSender->rbudpBase.remainNumberOfPackets } ) );
+    // sendRate is in Kbps
+    const double nsecsPerPacket = 8.0 * rbudpSender->rbudpBase.payloadSize * 1e6 /
+                                  rbudpSender->rbudpBase.sendRate;
+
+    if ( numStreams == 1 ) {
+        return udpSendStream( rbudpSender, 0, 1, nsecsPerPacket );
+    }
+
+    // Each stream takes every numStreams-th packet of the round at an equal
+    // share of the rate, so together they are paced at sendRate.
+    std::vector<int> status( numStreams, 0 );
+    std::vector<std::thread> streams;
+    for ( int k = 0; k < numStreams; k++ ) {
+        streams.emplace_back( [rbudpSender, k, numStreams, nsecsPerPacket, &status] {
+            status[k] = udpSendStream( rbudpSender, k, numStreams, nsecsPerPacket * numStreams );
+        } );
+    }
+    for ( auto& t : streams ) {
+        t.join();
+    }
+
+    for ( const int s : status ) {
+        if ( s < 0 ) {
+            return s;
         }
     }
-    free( msg );
     return 0;
 }
 
@@ -30,6 +30,7 @@
 #include "irods_get_full_path_for_config_file.hpp"
 #include "irods_logger.hpp"
 #include "miscServerFunct.hpp"
+#include "access_verdict_cache.hpp"
 
 #define IRODS_QUERY_ENABLE_SERVER_SIDE_API
 #include "irods_query.hpp"
@@ -53,6 +54,7 @@ namespace
     // clang-format off
     namespace fs    = irods::experimental::filesystem;
     namespace ic    = irods::experimental::catalog;
+    namespace avc   = irods::experimental::access_verdict_cache;
 
     using log       = irods::experimental::log;
     using json      = nlohmann::json;
@@ -589,6 +591,9 @@ namespace
 
                 _trans.commit();
 
+                // Permissions may have been removed or lowered.
+                avc::invalidate();
+
                 *_output = to_bytes_buffer("{}");
 
                 return 0;
@@ -42,12 +42,17 @@
 #include "fmt/format.h"
 #include "nanodbc/nanodbc.h"
 
+#include <algorithm>
 #include <cstdlib>
+#include <deque>
+#include <map>
+#include <set>
 #include <string>
 #include <string_view>
 #include <tuple>
 #include <chrono>
 #include <system_error>
+#include <vector>
 
 namespace
 {
@@ -61,6 +66,123 @@ namespace
     using id_type   = std::int64_t;
     // clang-format on
 
+    // The number of rows each set-based statement operates on. Keeps the number of bind
+    // parameters well below the limits of the supported databases.
+    constexpr std::size_t rows_per_statement = 100;
+
+    // A validated metadata operation.
+    struct pending_operation
+    {
+        const json* op;
+        int op_index;
+        int entity_index;
+        id_type object_id;
+        fs::metadata metadata;
+        bool add;
+    }; // struct pending_operation
+
+    // Attribute, value and units.
+    using avu_key = std::tuple<std::string, std::string, std::string>;
+
+    struct avu
+    {
+        id_type meta_id;
+
+        // The operation reported if a statement involving this AVU fails.
+        const pending_operation* first_operation;
+
+        bool insert_if_missing;
+    }; // struct avu
+
+    using avu_map = std::map<avu_key, avu>;
+
+    // A row of R_OBJT_METAMAP to insert or delete.
+    struct mapping
+    {
+        id_type object_id;
+        id_type meta_id;
+        const pending_operation* op;
+    }; // struct mapping
+
+    // Binds parameters to a statement in order and keeps the bound values alive until
+    // the statement is executed. Oracle expects identifiers as strings.
+    class parameter_list
+    {
+    public:
+        parameter_list(nanodbc::statement& _stmt, const std::string_view _db_instance_name)
+            : stmt_{_stmt}
+            , oracle_{"oracle" == _db_instance_name}
+            , index_{}
+            , strings_{}
+            , ids_{}
+        {
+        }
+
+        // The string must outlive the execution of the statement.
+        auto bind(const std::string& _value) -> void
+        {
+            stmt_.bind(index_++, _value.c_str());
+        }
+
+        auto bind(id_type _value) -> void
+        {
+            if (oracle_) {
+                stmt_.bind(index_++, strings_.emplace_back(std::to_string(_value)).c_str());
+            }
+            else {
+                stmt_.bind(index_++, &ids_.emplace_back(_value));
+            }
+        }
+
+    private:
+        nanodbc::statement& stmt_;
+        const bool oracle_;
+        short index_;
+        std::deque<std::string> strings_;
+        std::deque<id_type> ids_;
+    }; // class parameter_list
+
+    // Calls _run for the rows [0, _count) in chunks of _rows_per_statement rows, with _current
+    // set to the operation of the first row of each chunk. If the database rejects a chunk, the
+    // chunk is rolled back and run again one row at a time, so that _current names the
+    // operation which actually failed.
+    template <typename OperationAt, typename Run>
+    auto execute_in_chunks(nanodbc::connection& _db_conn,
+                           std::size_t _count,
+                           std::size_t _rows_per_statement,
+                           OperationAt _operation_at,
+                           Run _run,
+                           const pending_operation*& _current) -> void
+    {
+        for (std::size_t i = 0; i < _count; i += _rows_per_statement) {
+            const auto end = std::min(_count, i + _rows_per_statement);
+
+            _current = _operation_at(i);
+
+            if (end - i == 1) {
+                _run(i, end);
+                continue;
+            }
+
+            nanodbc::just_execute(_db_conn, "savepoint metadata_chunk");
+
+            try {
+                _run(i, end);
+            }
+            catch (const nanodbc::database_error&) {
+                nanodbc::just_execute(_db_conn, "rollback to savepoint metadata_chunk");
+
+                for (auto j = i; j < end; ++j) {
+                    _current = _operation_at(j);
+                    _run(j, j + 1);
+                }
+
+                // Every row succeeded on its own, so the chunk is reported as a whole.
+                _current = _operation_at(i);
+                throw;
+            }
+        }
+    }
     //
     // Function Prototypes
     //
@@ -73,40 +195,43 @@ namespace
 
     auto get_file_descriptor(const bytesBuf_t& _buf) -> int;
 
-    auto make_error_object(const json& _op, int _op_index, const std::string& _error_msg) -> json;
+    auto make_error_object(const json& _op, int _op_index, const std::string& _error_msg, int _entity_index = -1) -> json;
 
     auto get_object_id(rsComm_t& _comm,
                        const std::string& _entity_name,
                        const ic::entity_type _entity_type) -> id_type;
 
-    auto get_meta_id(nanodbc::connection& _db_conn,
-                     const std::string_view _db_instance_name,
-                     const fs::metadata& _metadata) -> id_type;
+    auto make_timestamp() -> std::string;
 
-    auto is_metadata_attached_to_object(nanodbc::connection& _db_conn,
-                                        const std::string_view _db_instance_name,
-                                        id_type _object_id,
-                                        id_type _meta_id) -> bool;
+    auto to_pending_operation(const json& _op,
+                              int _op_index,
+                              int _entity_index,
+                              id_type _object_id,
+                              pending_operation& _pending) -> std::tuple<int, bytesBuf_t*>;
+
+    auto lookup_meta_ids(nanodbc::connection& _db_conn,
+                         const std::string_view _db_instance_name,
+                         avu_map& _avus,
+                         const pending_operation*& _current) -> void;
 
     auto insert_metadata(nanodbc::connection& _db_conn,
                          const std::string_view _db_instance_name,
-                         const fs::metadata& _metadata) -> id_type;
+                         const std::vector<const avu_map::value_type*>& _avus,
+                         const pending_operation*& _current) -> void;
 
-    auto attach_metadata_to_object(nanodbc::connection& _db_conn,
-                                   const std::string_view _db_instance_name,
-                                   id_type _object_id,
-                                   id_type _meta_id) -> void;
+    auto attach_metadata_to_objects(nanodbc::connection& _db_conn,
+                                    const std::string_view _db_instance_name,
+                                    const std::vector<mapping>& _mappings,
+                                    const pending_operation*& _current) -> void;
 
-    auto detach_metadata_from_object(nanodbc::connection& _db_conn,
-                                     const std::string_view _db_instance_name,
-                                     id_type _object_id,
-                                     id_type _meta_id) -> void;
+    auto detach_metadata_from_objects(nanodbc::connection& _db_conn,
+                                      const std::string_view _db_instance_name,
+                                      const std::vector<mapping>& _mappings,
+                                      const pending_operation*& _current) -> void;
 
-    auto execute_metadata_operation(nanodbc::connection& _db_conn,
-                                    std::string_view _db_instance_name,
-                                    id_type _object_id,
-                                    const json& _operation,
-                                    int _op_index) -> std::tuple<int, bytesBuf_t*>;
+    auto execute_metadata_operations(nanodbc::connection& _db_conn,
+                                     std::string_view _db_instance_name,
+                                     const std::vector<pending_operation>& _ops) -> std::tuple<int, bytesBuf_t*>;
 
     auto rs_atomic_apply_metadata_operations(rsComm_t*, bytesBuf_t*, bytesBuf_t**) -> int;
 
@@ -158,13 +283,20 @@ namespace
         return bbp;
     }
 
-    auto make_error_object(const json& _op, int _op_index, const std::string& _error_msg) -> json
+    auto make_error_object(const json& _op, int _op_index, const std::string& _error_msg, int _entity_index) -> json
     {
-        return json{
+        auto err = json{
             {"operation", _op},
             {"operation_index", _op_index},
             {"error_message", _error_msg}
         };
+
+        // Only set for requests that list many entities.
+        if (_entity_index > -1) {
+            err["entity_index"] = _entity_index;
+        }
+
+        return err;
     }
 
     auto get_object_id(rsComm_t& _comm,
@@ -205,248 +337,361 @@ namespace
         throw std::runtime_error{fmt::format("Entity does not exist [entity_name={}]", _entity_name)};
     }
 
-    auto get_meta_id(nanodbc::connection& _db_conn,
-                     const std::string_view _db_instance_name,
-                     const fs::metadata& _metadata) -> id_type
+    auto make_timestamp() -> std::string
     {
-        nanodbc::statement stmt{_db_conn};
+        using std::chrono::system_clock;
+        using std::chrono::duration_cast;
+        using std::chrono::seconds;
 
-        if (_db_instance_name == "oracle" && _metadata.units.empty()) {
-            prepare(stmt, "select meta_id from R_META_MAIN "
-                          "where"
-                          " meta_attr_name = ? and"
-                          " meta_attr_value = ? and"
-                          " meta_attr_unit is null");
+        return fmt::format("{:011}", duration_cast<seconds>(system_clock::now().time_since_epoch()).count());
+    }
 
-            stmt.bind(0, _metadata.attribute.c_str());
-            stmt.bind(1, _metadata.value.c_str());
-        }
-        else {
-            prepare(stmt, "select meta_id from R_META_MAIN "
-                          "where"
-                          " meta_attr_name = ? and"
-                          " meta_attr_value = ? and"
-                          " meta_attr_unit = ?");
+    auto to_pending_operation(const json& _op,
+                              int _op_index,
+                              int _entity_index,
+                              id_type _object_id,
+                              pending_operation& _pending) -> std::tuple<int, bytesBuf_t*>
+    {
+        try {
+            _pending.op = &_op;
+            _pending.op_index = _op_index;
+            _pending.entity_index = _entity_index;
+            _pending.object_id = _object_id;
 
-            stmt.bind(0, _metadata.attribute.c_str());
-            stmt.bind(1, _metadata.value.c_str());
-            stmt.bind(2, _metadata.units.c_str());
-        }
+            auto& md = _pending.metadata;
 
-        if (auto row = execute(stmt); row.next()) {
-            return row.get<id_type>(0);
-        }
+            md.attribute = _op.at("attribute").get<std::string>();
+            md.value = _op.at("value").get<std::string>();
+
+            if (md.attribute.empty() || md.value.empty()) {
+                const auto msg = fmt::format("Empty metadata attribute name or value [attribute={}, value={}]", md.attribute, md.value);
+                rodsLog(LOG_ERROR, msg.data());
+                return {SYS_INVALID_INPUT_PARAM, to_bytes_buffer(make_error_object(_op, _op_index, msg, _entity_index).dump())};
+            }
+
+            // "units" are optional.
+            if (_op.count("units")) {
+                md.units = _op.at("units").get<std::string>();
+            }
+
+            if (const auto op_code = _op.at("operation").get<std::string>(); op_code == "add" || op_code == "remove") {
+                _pending.add = (op_code == "add");
+            }
+            else {
+                // clang-format off
+                log::api::error({{"log_message", "Invalid metadata operation"},
+                                 {"metadata_operation", _op.dump()}});
+                // clang-format on
 
-        return -1;
+                return {INVALID_OPERATION, to_bytes_buffer(make_error_object(_op, _op_index, "Invalid metadata operation.", _entity_index).dump())};
+            }
+
+            return {0, nullptr};
+        }
+        catch (const json::out_of_range& e) {
+            log::api::error({{"log_message", e.what()}, {"metadata_operation", _op.dump()}});
+            return {JSON_VALIDATION_ERROR, to_bytes_buffer(make_error_object(_op, _op_index, e.what(), _entity_index).dump())};
+        }
+        catch (const json::type_error& e) {
+            log::api::error({{"log_message", e.what()}, {"metadata_operation", _op.dump()}});
+            return {JSON_VALIDATION_ERROR, to_bytes_buffer(make_error_object(_op, _op_index, e.what(), _entity_index).dump())};
+        }
     }
 
-    auto is_metadata_attached_to_object(nanodbc::connection& _db_conn,
-                                        const std::string_view _db_instance_name,
-                                        id_type _object_id,
-                                        id_type _meta_id) -> bool
+    auto lookup_meta_ids(nanodbc::connection& _db_conn,
+                         const std::string_view _db_instance_name,
+                         avu_map& _avus,
+                         const pending_operation*& _current) -> void
     {
-        nanodbc::statement stmt{_db_conn};
+        std::vector<const avu_map::value_type*> unresolved;
 
-        prepare(stmt, "select count(*) from R_OBJT_METAMAP where object_id = ? and meta_id = ?");
+        for (const auto& entry : _avus) {
+            if (entry.second.meta_id < 0) {
+                unresolved.push_back(&entry);
+            }
+        }
+
+        const auto operation_at = [&unresolved](std::size_t _i) { return unresolved[_i]->second.first_operation; };
 
-        if ("oracle" == _db_instance_name) {
-            const auto object_id_string = std::to_string(_object_id);
-            const auto meta_id_string = std::to_string(_meta_id);
+        execute_in_chunks(_db_conn, unresolved.size(), rows_per_statement, operation_at, [&](std::size_t i, std::size_t end) {
+            std::string sql = "select meta_id, meta_attr_name, meta_attr_value, meta_attr_unit from R_META_MAIN where ";
 
-            stmt.bind(0, object_id_string.data());
-            stmt.bind(1, meta_id_string.data());
+            for (auto j = i; j < end; ++j) {
+                if (j > i) {
+                    sql += " or ";
+                }
 
-            if (auto row = execute(stmt); row.next()) {
-                return row.get<std::int64_t>(0) > 0;
+                if (_db_instance_name == "oracle" && std::get<2>(unresolved[j]->first).empty()) {
+                    sql += "(meta_attr_name = ? and meta_attr_value = ? and meta_attr_unit is null)";
+                }
+                else {
+                    sql += "(meta_attr_name = ? and meta_attr_value = ? and meta_attr_unit = ?)";
+                }
             }
-        }
-        else {
-            stmt.bind(0, &_object_id);
-            stmt.bind(1, &_meta_id);
 
-            if (auto row = execute(stmt); row.next()) {
-                return row.get<std::int64_t>(0) > 0;
+            nanodbc::statement stmt{_db_conn};
+            prepare(stmt, sql);
+
+            parameter_list params{stmt, _db_instance_name};
+
+            for (auto j = i; j < end; ++j) {
+                const auto& [attribute, value, units] = unresolved[j]->first;
+
+                params.bind(attribute);
+                params.bind(value);
+
+                if (_db_instance_name != "oracle" || !units.empty()) {
+                    params.bind(units);
+                }
             }
-        }
 
-        return false;
+            for (auto row = execute(stmt); row.next();) {
+                const avu_key key{row.get<std::string>(1), row.get<std::string>(2), row.get<std::string>(3, "")};
+
+                // R_META_MAIN may hold the same AVU more than once. Use the first one found.
+                if (auto iter = _avus.find(key); iter != std::end(_avus) && iter->second.meta_id < 0) {
+                    iter->second.meta_id = row.get<id_type>(0);
+                }
+            }
+        }, _current);
     }
 
     auto insert_metadata(nanodbc::connection& _db_conn,
                          const std::string_view _db_instance_name,
-                         const fs::metadata& _metadata) -> id_type
+                         const std::vector<const avu_map::value_type*>& _avus,
+                         const pending_operation*& _current) -> void
     {
-        nanodbc::statement stmt{_db_conn};
+        std::string_view next_id;
 
         if (_db_instance_name == "oracle") {
-            prepare(stmt, "insert into R_META_MAIN (meta_id, meta_attr_name, meta_attr_value, meta_attr_unit, create_ts, modify_ts) "
-                          "values (R_OBJECTID.nextval, ?, ?, ?, ?, ?)");
+            next_id = "R_OBJECTID.nextval";
         }
         else if (_db_instance_name == "mysql") {
-            prepare(stmt, "insert into R_META_MAIN (meta_id, meta_attr_name, meta_attr_value, meta_attr_unit, create_ts, modify_ts) "
-                          "values (R_OBJECTID_nextval(), ?, ?, ?, ?, ?)");
+            next_id = "R_OBJECTID_nextval()";
         }
         else if (_db_instance_name == "postgres") {
-            prepare(stmt, "insert into R_META_MAIN (meta_id, meta_attr_name, meta_attr_value, meta_attr_unit, create_ts, modify_ts) "
-                          "values (nextval('R_OBJECTID'), ?, ?, ?, ?, ?)");
+            next_id = "nextval('R_OBJECTID')";
         }
         else {
             throw std::runtime_error{"Invalid database plugin configuration"};
         }
 
-        using std::chrono::system_clock;
-        using std::chrono::duration_cast;
-        using std::chrono::seconds;
+        const auto timestamp = make_timestamp();
+
+        // Oracle evaluates nextval once per statement for multi-row inserts, so each AVU
+        // needs its own insert there.
+        const std::size_t rows = (_db_instance_name == "oracle") ? 1 : rows_per_statement;
 
-        const auto timestamp = fmt::format("{:011}", duration_cast<seconds>(system_clock::now().time_since_epoch()).count());
+        const auto operation_at = [&_avus](std::size_t _i) { return _avus[_i]->second.first_operation; };
+
+        execute_in_chunks(_db_conn, _avus.size(), rows, operation_at, [&](std::size_t i, std::size_t end) {
+            std::string sql = "insert into R_META_MAIN (meta_id, meta_attr_name, meta_attr_value, meta_attr_unit, create_ts, modify_ts) values ";
+
+            for (auto j = i; j < end; ++j) {
+                sql += fmt::format("{}({}, ?, ?, ?, ?, ?)", (j > i) ? ", " : "", next_id);
+            }
 
-        stmt.bind(0, _metadata.attribute.c_str());
-        stmt.bind(1, _metadata.value.c_str());
-        stmt.bind(2, _metadata.units.c_str());
-        stmt.bind(3, timestamp.c_str());
-        stmt.bind(4, timestamp.c_str());
+            nanodbc::statement stmt{_db_conn};
+            prepare(stmt, sql);
 
-        execute(stmt);
+            parameter_list params{stmt, _db_instance_name};
 
-        return get_meta_id(_db_conn, _db_instance_name, _metadata);
+            for (auto j = i; j < end; ++j) {
+                const auto& [attribute, value, units] = _avus[j]->first;
+
+                params.bind(attribute);
+                params.bind(value);
+                params.bind(units);
+                params.bind(timestamp);
+                params.bind(timestamp);
+            }
+
+            execute(stmt);
+        }, _current);
     }
 
-    auto attach_metadata_to_object(nanodbc::connection& _db_conn,
-                                   const std::string_view _db_instance_name,
-                                   id_type _object_id,
-                                   id_type _meta_id) -> void
+    auto attach_metadata_to_objects(nanodbc::connection& _db_conn,
+                                    const std::string_view _db_instance_name,
+                                    const std::vector<mapping>& _mappings,
+                                    const pending_operation*& _current) -> void
     {
-        nanodbc::statement stmt{_db_conn};
+        std::set<std::pair<id_type, id_type>> attached;
 
-        prepare(stmt, "insert into R_OBJT_METAMAP (object_id, meta_id, create_ts, modify_ts) "
-                      "values (?, ?, ?, ?)");
+        const auto mapping_operation_at = [&_mappings](std::size_t _i) { return _mappings[_i].op; };
 
-        using std::chrono::system_clock;
-        using std::chrono::duration_cast;
-        using std::chrono::seconds;
+        execute_in_chunks(_db_conn, _mappings.size(), rows_per_statement, mapping_operation_at, [&](std::size_t i, std::size_t end) {
+            std::string sql = "select object_id, meta_id from R_OBJT_METAMAP where ";
 
-        const auto timestamp = fmt::format("{:011}", duration_cast<seconds>(system_clock::now().time_since_epoch()).count());
+            for (auto j = i; j < end; ++j) {
+                sql += (j > i) ? " or (object_id = ? and meta_id = ?)" : "(object_id = ? and meta_id = ?)";
+            }
 
-        stmt.bind(2, timestamp.c_str());
-        stmt.bind(3, timestamp.c_str());
+            nanodbc::statement stmt{_db_conn};
+            prepare(stmt, sql);
 
-        if ("oracle" == _db_instance_name) {
-            const auto object_id_string = std::to_string(_object_id);
-            const auto meta_id_string = std::to_string(_meta_id);
+            parameter_list params{stmt, _db_instance_name};
 
-            stmt.bind(0, object_id_string.data());
-            stmt.bind(1, meta_id_string.data());
+            for (auto j = i; j < end; ++j) {
+                params.bind(_mappings[j].object_id);
+                params.bind(_mappings[j].meta_id);
+            }
 
-            execute(stmt);
+            for (auto row = execute(stmt); row.next();) {
+                attached.emplace(row.get<id_type>(0), row.get<id_type>(1));
+            }
+        }, _current);
+
+        std::vector<const mapping*> missing;
+
+        for (const auto& m : _mappings) {
+            if (attached.emplace(m.object_id, m.meta_id).second) {
+                missing.push_back(&m);
+            }
         }
-        else {
-            stmt.bind(0, &_object_id);
-            stmt.bind(1, &_meta_id);
+
+        const auto timestamp = make_timestamp();
+
+        const auto missing_operation_at = [&missing](std::size_t _i) { return missing[_i]->op; };
+
+        execute_in_chunks(_db_conn, missing.size(), rows_per_statement, missing_operation_at, [&](std::size_t i, std::size_t end) {
+            std::string sql;
+
+            // Oracle does not support multi-row VALUES clauses.
+            if (_db_instance_name == "oracle") {
+                sql = "insert all";
+
+                for (auto j = i; j < end; ++j) {
+                    sql += " into R_OBJT_METAMAP (object_id, meta_id, create_ts, modify_ts) values (?, ?, ?, ?)";
+                }
+
+                sql += " select * from dual";
+            }
+            else {
+                sql = "insert into R_OBJT_METAMAP (object_id, meta_id, create_ts, modify_ts) values ";
+
+                for (auto j = i; j < end; ++j) {
+                    sql += (j > i) ? ", (?, ?, ?, ?)" : "(?, ?, ?, ?)";
+                }
+            }
+
+            nanodbc::statement stmt{_db_conn};
+            prepare(stmt, sql);
+
+            parameter_list params{stmt, _db_instance_name};
+
+            for (auto j = i; j < end; ++j) {
+                params.bind(missing[j]->object_id);
+                params.bind(missing[j]->meta_id);
+                params.bind(timestamp);
+                params.bind(timestamp);
+            }
 
             execute(stmt);
-        }
+        }, _current);
     }
 
-    auto detach_metadata_from_object(nanodbc::connection& _db_conn,
-                                     const std::string_view _db_instance_name,
-                                     id_type _object_id,
-                                     id_type _meta_id) -> void
+    auto detach_metadata_from_objects(nanodbc::connection& _db_conn,
+                                      const std::string_view _db_instance_name,
+                                      const std::vector<mapping>& _mappings,
+                                      const pending_operation*& _current) -> void
     {
-        nanodbc::statement stmt{_db_conn};
+        const auto operation_at = [&_mappings](std::size_t _i) { return _mappings[_i].op; };
 
-        prepare(stmt, "delete from R_OBJT_METAMAP where object_id = ? and meta_id = ?");
+        execute_in_chunks(_db_conn, _mappings.size(), rows_per_statement, operation_at, [&](std::size_t i, std::size_t end) {
+            std::string sql = "delete from R_OBJT_METAMAP where ";
 
-        if ("oracle" == _db_instance_name) {
-            const auto object_id_string = std::to_string(_object_id);
-            const auto meta_id_string = std::to_string(_meta_id);
+            for (auto j = i; j < end; ++j) {
+                sql += (j > i) ? " or (object_id = ? and meta_id = ?)" : "(object_id = ? and meta_id = ?)";
+            }
 
-            stmt.bind(0, object_id_string.data());
-            stmt.bind(1, meta_id_string.data());
+            nanodbc::statement stmt{_db_conn};
+            prepare(stmt, sql);
 
-            execute(stmt);
-        }
-        else {
-            stmt.bind(0, &_object_id);
-            stmt.bind(1, &_meta_id);
+            parameter_list params{stmt, _db_instance_name};
+
+            for (auto j = i; j < end; ++j) {
+                params.bind(_mappings[j].object_id);
+                params.bind(_mappings[j].meta_id);
+            }
 
             execute(stmt);
-        }
+        }, _current);
     }
 
-    auto execute_metadata_operation(nanodbc::connection& _db_conn,
-                                    std::string_view _db_instance_name,
-                                    id_type _object_id,
-                                    const json& _op,
-                                    int _op_index) -> std::tuple<int, bytesBuf_t*>
+    auto execute_metadata_operations(nanodbc::connection& _db_conn,
+                                     std::string_view _db_instance_name,
+                                     const std::vector<pending_operation>& _ops) -> std::tuple<int, bytesBuf_t*>
     {
-        try {
-            fs::metadata md;
+        if (_ops.empty()) {
+            return {0, to_bytes_buffer("{}")};
+        }
 
-            md.attribute = _op.at("attribute").get<std::string>();
-            md.value = _op.at("value").get<std::string>();
+        // Adding and removing metadata are both idempotent, so only the last operation on
+        // an AVU of an object determines the outcome.
+        std::map<std::tuple<id_type, avu_key>, const pending_operation*> last_operations;
 
-            if (md.attribute.empty() || md.value.empty()) {
-                const auto msg = fmt::format("Empty metadata attribute name or value [attribute={}, value={}]", md.attribute, md.value);
-                rodsLog(LOG_ERROR, msg.data());
-                return {SYS_INVALID_INPUT_PARAM, to_bytes_buffer(make_error_object(_op, _op_index, msg).dump())};
-            }
+        for (const auto& op : _ops) {
+            const auto& md = op.metadata;
+            last_operations.insert_or_assign({op.object_id, avu_key{md.attribute, md.value, md.units}}, &op);
+        }
 
-            // "units" are optional.
-            if (_op.count("units")) {
-                md.units = _op.at("units").get<std::string>();
+        avu_map avus;
+
+        for (const auto& [key, op] : last_operations) {
+            auto [iter, inserted] = avus.try_emplace(std::get<1>(key), avu{-1, op, false});
+            iter->second.insert_if_missing = iter->second.insert_if_missing || op->add;
+        }
+
+        const pending_operation* current = &_ops.front();
+
+        try {
+            lookup_meta_ids(_db_conn, _db_instance_name, avus, current);
+
+            std::vector<const avu_map::value_type*> missing;
+
+            for (const auto& entry : avus) {
+                if (entry.second.meta_id < 0 && entry.second.insert_if_missing) {
+                    missing.push_back(&entry);
+                }
             }
 
-            if (const auto op_code = _op.at("operation").get<std::string>(); op_code == "add") {
-                if (auto meta_id = get_meta_id(_db_conn, _db_instance_name, md); meta_id > -1) {
-                    if (!is_metadata_attached_to_object(_db_conn, _db_instance_name, _object_id, meta_id)) {
-                        attach_metadata_to_object(_db_conn, _db_instance_name, _object_id, meta_id);
+            if (!missing.empty()) {
+                insert_metadata(_db_conn, _db_instance_name, missing, current);
+                lookup_meta_ids(_db_conn, _db_instance_name, avus, current);
+
+                for (const auto* entry : missing) {
+                    if (entry->second.meta_id < 0) {
+                        const auto& [attribute, value, units] = entry->first;
+                        const auto* op = entry->second.first_operation;
+                        const auto msg = fmt::format("Failed to insert metadata [attribute={}, value={}, units={}]", attribute, value, units);
+                        rodsLog(LOG_ERROR, msg.data());
+                        return {SYS_INTERNAL_ERR, to_bytes_buffer(make_error_object(*op->op, op->op_index, msg, op->entity_index).dump())};
                     }
                 }
-                else if (meta_id = insert_metadata(_db_conn, _db_instance_name, md); meta_id > -1) {
-                    attach_metadata_to_object(_db_conn, _db_instance_name, _object_id, meta_id);
-                }
-                else {
-                    const auto msg = fmt::format("Failed to insert metadata [attribute={}, value={}, units={}]",
-                                                 md.attribute, md.value, md.units);
-                    rodsLog(LOG_ERROR, msg.data());
-                    return {SYS_INTERNAL_ERR, to_bytes_buffer(make_error_object(_op, _op_index, msg).dump())};
-                }
             }
-            else if (op_code == "remove") {
-                if (const auto meta_id = get_meta_id(_db_conn, _db_instance_name, md); meta_id > -1) {
-                    detach_metadata_from_object(_db_conn, _db_instance_name, _object_id, meta_id);
+
+            std::vector<mapping> to_attach;
+            std::vector<mapping> to_detach;
+
+            for (const auto& [key, op] : last_operations) {
+                // Removing metadata that does not exist is not an error.
+                if (const auto meta_id = avus.at(std::get<1>(key)).meta_id; meta_id > -1) {
+                    (op->add ? to_attach : to_detach).push_back({op->object_id, meta_id, op});
                 }
             }
-            else {
-                // clang-format off
-                log::api::error({{"log_message", "Invalid metadata operation"},
-                                 {"metadata_operation", _op.dump()}});
-                // clang-format on
 
-                return {INVALID_OPERATION, to_bytes_buffer(make_error_object(_op, _op_index, "Invalid metadata operation.").dump())};
-            }
+            attach_metadata_to_objects(_db_conn, _db_instance_name, to_attach, current);
+            detach_metadata_from_objects(_db_conn, _db_instance_name, to_detach, current);
 
             return {0, to_bytes_buffer("{}")};
         }
         catch (const nanodbc::database_error& e) {
-            rodsLog(LOG_ERROR, "%s [metadata_operation=%s]", e.what(), _op.dump().c_str());
-            return {SYS_LIBRARY_ERROR, to_bytes_buffer(make_error_object(_op, _op_index, e.what()).dump())};
-        }
-        catch (const fs::filesystem_error& e) {
-            log::api::error({{"log_message", e.what()}, {"metadata_operation", _op.dump()}});
-            return {e.code().value(), to_bytes_buffer(make_error_object(_op, _op_index, e.what()).dump())};
-        }
-        catch (const json::out_of_range& e) {
-            log::api::error({{"log_message", e.what()}, {"metadata_operation", _op.dump()}});
-            return {JSON_VALIDATION_ERROR, to_bytes_buffer(make_error_object(_op, _op_index, e.what()).dump())};
-        }
-        catch (const json::type_error& e) {
-            log::api::error({{"log_message", e.what()}, {"metadata_operation", _op.dump()}});
-            return {JSON_VALIDATION_ERROR, to_bytes_buffer(make_error_object(_op, _op_index, e.what()).dump())};
+            rodsLog(LOG_ERROR, "%s [metadata_operation=%s]", e.what(), current->op->dump().c_str());
+            return {SYS_LIBRARY_ERROR, to_bytes_buffer(make_error_object(*current->op, current->op_index, e.what(), current->entity_index).dump())};
         }
         catch (const std::system_error& e) {
-            log::api::error({{"log_message", e.what()}, {"metadata_operation", _op.dump()}});
-            return {e.code().value(), to_bytes_buffer(make_error_object(_op, _op_index, e.what()).dump())};
+            log::api::error({{"log_message", e.what()}, {"metadata_operation", current->op->dump()}});
+            return {e.code().value(), to_bytes_buffer(make_error_object(*current->op, current->op_index, e.what(), current->entity_index).dump())};
         }
     }
 
@@ -498,20 +743,53 @@ namespace
             return INPUT_ARG_NOT_WELL_FORMED_ERR;
         }
 
-        std::string entity_name;
-        ic::entity_type entity_type;
-        id_type object_id = -1;
+        struct entity
+        {
+            const json* input;
+            std::string name;
+            ic::entity_type type;
+            id_type object_id;
+        };
+
+        // The input either describes a single entity or lists many under "entities".
+        const bool bulk = input.count("entities") > 0;
+        std::vector<entity> entities;
 
         try {
-            entity_name = input.at("entity_name").get<std::string>();
-            entity_type = ic::entity_type_map.at(input.at("entity_type").get<std::string>());
-            object_id = get_object_id(*_comm, entity_name, entity_type);
+            if (bulk) {
+                const auto& entity_list = input.at("entities");
+
+                if (!entity_list.is_array()) {
+                    throw std::runtime_error{"Property [entities] must be an array"};
+                }
+
+                for (const auto& e : entity_list) {
+                    entities.push_back({&e, {}, {}, -1});
+                }
+            }
+            else {
+                entities.push_back({&input, {}, {}, -1});
+            }
         }
         catch (const std::exception& e) {
             *_output = to_bytes_buffer(make_error_object(json{}, 0, e.what()).dump());
             return SYS_INVALID_INPUT_PARAM;
         }
 
+        for (std::size_t i = 0; i < entities.size(); ++i) {
+            auto& e = entities[i];
+
+            try {
+                e.name = e.input->at("entity_name").get<std::string>();
+                e.type = ic::entity_type_map.at(e.input->at("entity_type").get<std::string>());
+                e.object_id = get_object_id(*_comm, e.name, e.type);
+            }
+            catch (const std::exception& ex) {
+                *_output = to_bytes_buffer(make_error_object(json{}, 0, ex.what(), bulk ? static_cast<int>(i) : -1).dump());
+                return SYS_INVALID_INPUT_PARAM;
+            }
+        }
+
         std::string db_instance_name;
         nanodbc::connection db_conn;
 
@@ -523,41 +801,59 @@ namespace
             return SYS_CONFIG_FILE_ERR;
         }
 
-        if (!ic::user_has_permission_to_modify_entity(*_comm, db_conn, db_instance_name, object_id, entity_type)) {
-            log::api::error("User not allowed to modify metadata [entity_name={}, entity_type={}, object_id={}]",
-                            entity_name, input.at("entity_type").get<std::string>(), object_id);
-            *_output = to_bytes_buffer(make_error_object(json{}, 0, "User not allowed to modify metadata").dump());
-            return CAT_NO_ACCESS_PERMISSION;
+        for (std::size_t i = 0; i < entities.size(); ++i) {
+            const auto& e = entities[i];
+
+            if (!ic::user_has_permission_to_modify_entity(*_comm, db_conn, db_instance_name, e.object_id, e.type)) {
+                log::api::error("User not allowed to modify metadata [entity_name={}, entity_type={}, object_id={}]",
+                                e.name, e.input->at("entity_type").get<std::string>(), e.object_id);
+                *_output = to_bytes_buffer(make_error_object(json{}, 0, "User not allowed to modify metadata", bulk ? static_cast<int>(i) : -1).dump());
+                return CAT_NO_ACCESS_PERMISSION;
+            }
         }
 
-        return ic::execute_transaction(db_conn, [&](auto& _trans) -> int
-        {
+        // Validate every operation before touching the catalog.
+        std::vector<pending_operation> pending_ops;
+
+        for (std::size_t i = 0; i < entities.size(); ++i) {
+            const auto entity_index = bulk ? static_cast<int>(i) : -1;
+
             try {
-                const auto& operations = input.at("operations");
+                const auto& operations = entities[i].input->at("operations");
 
-                for (json::size_type i = 0; i < operations.size(); ++i) {
-                    const auto [ec, bbuf] = execute_metadata_operation(_trans.connection(),
-                                                                       db_instance_name,
-                                                                       object_id,
-                                                                       operations[i],
-                                                                       i);
+                for (json::size_type j = 0; j < operations.size(); ++j) {
+                    auto& pending = pending_ops.emplace_back();
 
-                    if (ec != 0) {
+                    if (const auto [ec, bbuf] = to_pending_operation(operations[j], j, entity_index, entities[i].object_id, pending); ec != 0) {
                         *_output = bbuf;
                         return ec;
                     }
                 }
-
-                _trans.commit();
-
-                *_output = to_bytes_buffer("{}");
-
-                return 0;
+            }
+            catch (const json::out_of_range& e) {
+                *_output = to_bytes_buffer(make_error_object(json{}, 0, e.what(), entity_index).dump());
+                return SYS_INVALID_INPUT_PARAM;
             }
             catch (const json::type_error& e) {
-                *_output = to_bytes_buffer(make_error_object(json{}, 0, e.what()).dump());
+                *_output = to_bytes_buffer(make_error_object(json{}, 0, e.what(), entity_index).dump());
                 return SYS_INTERNAL_ERR;
             }
+        }
+
+        return ic::execute_transaction(db_conn, [&](auto& _trans) -> int
+        {
+            const auto [ec, bbuf] = execute_metadata_operations(_trans.connection(), db_instance_name, pending_ops);
+
+            if (ec != 0) {
+                *_output = bbuf;
+                return ec;
+            }
+
+            _trans.commit();
+
+            *_output = bbuf;
+
+            return 0;
         });
     }
 
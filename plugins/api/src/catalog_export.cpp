@@ -0,0 +1,723 @@
+#include "api_plugin_number.h"
+#include "rodsDef.h"
+#include "rcConnect.h"
+#include "rodsErrorTable.h"
+#include "rodsPackInstruct.h"
+#include "client_api_whitelist.hpp"
+
+#include "apiHandler.hpp"
+
+#include <functional>
+
+#ifdef RODS_SERVER
+
+//
+// Server-side Implementation
+//
+
+#include "catalog_export.h"
+
+#include "catalog.hpp"
+#include "catalog_utilities.hpp"
+#include "irods_at_scope_exit.hpp"
+#include "irods_exception.hpp"
+#include "irods_logger.hpp"
+#include "irods_rs_comm_query.hpp"
+
+#include "archive.h"
+#include "archive_entry.h"
+
+#include "json.hpp"
+#include "fmt/format.h"
+#include "nanodbc/nanodbc.h"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+    // clang-format off
+    namespace ic    = irods::experimental::catalog;
+
+    using log       = irods::experimental::log;
+    using json      = nlohmann::json;
+    using operation = std::function<int(rsComm_t*, bytesBuf_t*, bytesBuf_t**)>;
+    // clang-format on
+
+    // The tables an export may contain. Table names are only ever taken from this list,
+    // which makes it safe to use them in SQL statements.
+    const std::vector<std::string> exportable_tables{
+        "R_COLL_MAIN",
+        "R_DATA_MAIN",
+        "R_META_MAIN",
+        "R_OBJT_METAMAP",
+        "R_OBJT_ACCESS"
+    };
+
+    // Marks a NULL value in a column entry.
+    constexpr std::uint32_t null_length = 0xFFFFFFFF;
+
+    constexpr std::int64_t default_rows_per_row_group = 65536;
+
+    // The number of rows requested from the database per round trip.
+    constexpr std::int64_t rows_per_fetch = 10000;
+
+    struct export_options
+    {
+        std::string output_path;
+        std::vector<std::string> tables;
+        std::int64_t number_of_threads;
+        std::int64_t rows_per_row_group;
+        bool overwrite;
+    }; // struct export_options
+
+    struct table_summary
+    {
+        std::vector<std::string> columns;
+        std::int64_t rows = 0;
+        std::int64_t row_groups = 0;
+    }; // struct table_summary
+
+    class archive_writer;
+
+    //
+    // Function Prototypes
+    //
+
+    auto call_catalog_export(irods::api_entry*, rsComm_t*, bytesBuf_t*, bytesBuf_t**) -> int;
+
+    auto rs_catalog_export(rsComm_t*, bytesBuf_t*, bytesBuf_t**) -> int;
+
+    auto to_bytes_buffer(const std::string& _s) -> bytesBuf_t*;
+
+    auto make_error_object(const std::string& _error_msg) -> json;
+
+    auto parse_options(const bytesBuf_t& _input) -> export_options;
+
+    auto isolation_statement(const std::string& _db_instance_name) -> std::string;
+
+    auto export_tables_in_parallel(nanodbc::connection& _leader_conn,
+                                   const export_options& _options,
+                                   archive_writer& _writer,
+                                   std::vector<table_summary>& _summaries) -> void;
+
+    auto export_tables_sequentially(const std::string& _db_instance_name,
+                                    nanodbc::connection& _db_conn,
+                                    const export_options& _options,
+                                    archive_writer& _writer,
+                                    std::vector<table_summary>& _summaries) -> void;
+
+    //
+    // Classes
+    //
+
+    // Writes _data to _archive as a single regular file named _name.
+    auto write_entry(struct archive* _archive, const std::string& _name, const std::string& _data) -> bool
+    {
+        auto* entry = archive_entry_new();
+        archive_entry_set_pathname(entry, _name.c_str());
+        archive_entry_set_size(entry, _data.size());
+        archive_entry_set_filetype(entry, AE_IFREG);
+        archive_entry_set_perm(entry, 0600);
+        archive_entry_set_mtime(entry, std::time(nullptr), 0);
+
+        const auto header_written = archive_write_header(_archive, entry) == ARCHIVE_OK;
+        archive_entry_free(entry);
+
+        return header_written &&
+               archive_write_data(_archive, _data.data(), _data.size()) == static_cast<la_ssize_t>(_data.size());
+    }
+
+    // Compresses a column entry on its own. Each entry can then be read without
+    // decompressing the rest of the export, and readers compress in parallel before
+    // handing the entry to the archive_writer.
+    auto gzip_compress(const std::string& _name, const std::string& _data) -> std::string
+    {
+        std::string compressed;
+
+        auto* archive = archive_write_new();
+
+        if (!archive) {
+            THROW(SYS_MALLOC_ERR, "Cannot allocate compressor for catalog export.");
+        }
+
+        irods::at_scope_exit free_archive{[archive] { archive_write_free(archive); }};
+
+        const auto append = [](struct archive*, void* _out, const void* _buffer, std::size_t _length) -> la_ssize_t {
+            static_cast<std::string*>(_out)->append(static_cast<const char*>(_buffer), _length);
+            return static_cast<la_ssize_t>(_length);
+        };
+
+        if (archive_write_set_format_raw(archive) != ARCHIVE_OK ||
+            archive_write_add_filter_gzip(archive) != ARCHIVE_OK ||
+            archive_write_set_bytes_in_last_block(archive, 1) != ARCHIVE_OK ||
+            archive_write_open(archive, &compressed, nullptr, append, nullptr) != ARCHIVE_OK ||
+            !write_entry(archive, _name, _data) ||
+            archive_write_close(archive) != ARCHIVE_OK)
+        {
+            THROW(SYS_LIBRARY_ERROR, fmt::format("Cannot compress [{}] for catalog export [error={}].",
+                                                 _name, archive_error_string(archive)));
+        }
+
+        return compressed;
+    }
+
+    // Serializes writes to a zip archive. Entries are stored as they are given, so the lock
+    // is only held while their bytes are copied. The central directory of the zip archive
+    // indexes every entry, so readers can open any entry without reading the ones before it.
+    class archive_writer
+    {
+    public:
+        explicit archive_writer(const std::string& _path)
+            : archive_{archive_write_new()}
+        {
+            if (!archive_) {
+                THROW(SYS_MALLOC_ERR, "Cannot allocate archive for catalog export.");
+            }
+
+            if (archive_write_set_format_zip(archive_) != ARCHIVE_OK ||
+                archive_write_set_format_option(archive_, "zip", "compression", "store") != ARCHIVE_OK ||
+                archive_write_set_bytes_in_last_block(archive_, 1) != ARCHIVE_OK ||
+                archive_write_open_filename(archive_, _path.c_str()) != ARCHIVE_OK)
+            {
+                const auto msg = fmt::format("Cannot open archive for catalog export [path={}, error={}].",
+                                             _path, archive_error_string(archive_));
+                archive_write_free(archive_);
+                THROW(SYS_LIBRARY_ERROR, msg);
+            }
+        }
+
+        archive_writer(const archive_writer&) = delete;
+        auto operator=(const archive_writer&) -> archive_writer& = delete;
+
+        ~archive_writer()
+        {
+            archive_write_free(archive_);
+        }
+
+        auto write(const std::string& _name, const std::string& _data) -> void
+        {
+            std::lock_guard<std::mutex> lk{mutex_};
+
+            if (!write_entry(archive_, _name, _data)) {
+                THROW(SYS_LIBRARY_ERROR, fmt::format("Cannot write [{}] to catalog export [error={}].",
+                                                     _name, archive_error_string(archive_)));
+            }
+        }
+
+        auto close() -> void
+        {
+            std::lock_guard<std::mutex> lk{mutex_};
+
+            if (archive_write_close(archive_) != ARCHIVE_OK) {
+                THROW(SYS_LIBRARY_ERROR, fmt::format("Cannot close catalog export [error={}].",
+                                                     archive_error_string(archive_)));
+            }
+        }
+
+    private:
+        struct archive* archive_;
+        std::mutex mutex_;
+    }; // class archive_writer
+
+    // Accumulates the rows of a table column by column and writes each row group to the
+    // archive once it is full.
+    class row_group_builder
+    {
+    public:
+        row_group_builder(const std::string& _table,
+                          std::int64_t _rows_per_row_group,
+                          archive_writer& _writer,
+                          table_summary& _summary)
+            : table_{_table}
+            , rows_per_row_group_{_rows_per_row_group}
+            , writer_{_writer}
+            , summary_{_summary}
+            , columns_{}
+            , rows_in_group_{}
+        {
+        }
+
+        auto add_rows(nanodbc::result& _result) -> std::int64_t
+        {
+            if (summary_.columns.empty()) {
+                for (short i = 0; i < _result.columns(); ++i) {
+                    summary_.columns.push_back(_result.column_name(i));
+                }
+
+                columns_.resize(summary_.columns.size());
+            }
+
+            std::int64_t rows = 0;
+
+            while (_result.next()) {
+                for (short i = 0; i < static_cast<short>(columns_.size()); ++i) {
+                    // Some drivers only report NULL once the value has been fetched.
+                    auto value = _result.get<std::string>(i, std::string{});
+
+                    if (_result.is_null(i)) {
+                        append_length(columns_[i], null_length);
+                    }
+                    else {
+                        append_length(columns_[i], static_cast<std::uint32_t>(value.size()));
+                        columns_[i].append(value);
+                    }
+                }
+
+                ++rows;
+                ++summary_.rows;
+
+                if (++rows_in_group_ == rows_per_row_group_) {
+                    flush();
+                }
+            }
+
+            return rows;
+        }
+
+        auto flush() -> void
+        {
+            if (rows_in_group_ == 0) {
+                return;
+            }
+
+            for (std::size_t i = 0; i < columns_.size(); ++i) {
+                const auto name = fmt::format("{}/{:06d}/{}.gz", table_, summary_.row_groups, summary_.columns[i]);
+                writer_.write(name, gzip_compress(name, columns_[i]));
+                columns_[i].clear();
+            }
+
+            ++summary_.row_groups;
+            rows_in_group_ = 0;
+        }
+
+    private:
+        static auto append_length(std::string& _column, std::uint32_t _length) -> void
+        {
+            for (int shift = 0; shift < 32; shift += 8) {
+                _column.push_back(static_cast<char>((_length >> shift) & 0xFF));
+            }
+        }
+
+        const std::string& table_;
+        const std::int64_t rows_per_row_group_;
+        archive_writer& writer_;
+        table_summary& summary_;
+        std::vector<std::string> columns_;
+        std::int64_t rows_in_group_;
+    }; // class row_group_builder
+
+    //
+    // Function Implementations
+    //
+
+    auto call_catalog_export(irods::api_entry* _api,
+                             rsComm_t* _comm,
+                             bytesBuf_t* _input,
+                             bytesBuf_t** _output) -> int
+    {
+        return _api->call_handler<bytesBuf_t*, bytesBuf_t**>(_comm, _input, _output);
+    }
+
+    auto to_bytes_buffer(const std::string& _s) -> bytesBuf_t*
+    {
+        constexpr auto allocate = [](const auto bytes) noexcept
+        {
+            return std::memset(std::malloc(bytes), 0, bytes);
+        };
+
+        const auto buf_size = _s.length() + 1;
+
+        auto* buf = static_cast<char*>(allocate(sizeof(char) * buf_size));
+        std::strncpy(buf, _s.c_str(), _s.length());
+
+        auto* bbp = static_cast<bytesBuf_t*>(allocate(sizeof(bytesBuf_t)));
+        bbp->len = buf_size;
+        bbp->buf = buf;
+
+        return bbp;
+    }
+
+    auto make_error_object(const std::string& _error_msg) -> json
+    {
+        return json{{"error_message", _error_msg}};
+    }
+
+    auto parse_options(const bytesBuf_t& _input) -> export_options
+    {
+        if (_input.len <= 0 || !_input.buf) {
+            THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, "Missing input buffer.");
+        }
+
+        json input;
+
+        try {
+            input = json::parse(std::string(static_cast<const char*>(_input.buf), _input.len));
+        }
+        catch (const json::exception& e) {
+            THROW(INPUT_ARG_NOT_WELL_FORMED_ERR, fmt::format("Cannot parse input into JSON [error={}].", e.what()));
+        }
+
+        try {
+            export_options options{};
+
+            options.output_path = input.at("output_path").get<std::string>();
+
+            if (options.output_path.empty() || options.output_path.front() != '/') {
+                THROW(SYS_INVALID_INPUT_PARAM, "[output_path] must be an absolute path.");
+            }
+
+            if (input.contains("tables")) {
+                for (auto&& t : input.at("tables")) {
+                    auto table = t.get<std::string>();
+
+                    if (std::find(std::begin(exportable_tables), std::end(exportable_tables), table) == std::end(exportable_tables)) {
+                        THROW(SYS_INVALID_INPUT_PARAM, fmt::format("Table [{}] cannot be exported.", table));
+                    }
+
+                    if (std::find(std::begin(options.tables), std::end(options.tables), table) == std::end(options.tables)) {
+                        options.tables.push_back(std::move(table));
+                    }
+                }
+
+                if (options.tables.empty()) {
+                    THROW(SYS_INVALID_INPUT_PARAM, "[tables] cannot be empty.");
+                }
+            }
+            else {
+                options.tables = exportable_tables;
+            }
+
+            options.number_of_threads = input.value("number_of_threads", static_cast<std::int64_t>(options.tables.size()));
+            options.rows_per_row_group = input.value("rows_per_row_group", default_rows_per_row_group);
+            options.overwrite = input.value("overwrite", false);
+
+            if (options.number_of_threads < 1 || options.rows_per_row_group < 1) {
+                THROW(SYS_INVALID_INPUT_PARAM, "[number_of_threads] and [rows_per_row_group] must be greater than zero.");
+            }
+
+            options.number_of_threads = std::min<std::int64_t>(options.number_of_threads, options.tables.size());
+
+            return options;
+        }
+        catch (const json::exception& e) {
+            THROW(SYS_INVALID_INPUT_PARAM, fmt::format("Invalid input [error={}].", e.what()));
+        }
+    }
+
+    auto isolation_statement(const std::string& _db_instance_name) -> std::string
+    {
+        // Oracle reads consistently for the whole of a read-only transaction.
+        if (_db_instance_name == "oracle") {
+            return "set transaction read only";
+        }
+
+        return "set transaction isolation level repeatable read, read only";
+    }
+
+    // PostgreSQL only. A leader transaction exports its snapshot and every reader imports it,
+    // so that all tables are read as of the same instant while being read in parallel.
+    auto export_tables_in_parallel(nanodbc::connection& _leader_conn,
+                                   const export_options& _options,
+                                   archive_writer& _writer,
+                                   std::vector<table_summary>& _summaries) -> void
+    {
+        nanodbc::transaction leader_trans{_leader_conn};
+        nanodbc::just_execute(_leader_conn, isolation_statement("postgres"));
+
+        // The snapshot can only be imported while the leader transaction is open.
+        auto snapshot = nanodbc::execute(_leader_conn, "select pg_export_snapshot()");
+
+        if (!snapshot.next()) {
+            THROW(SYS_LIBRARY_ERROR, "Cannot export the snapshot of the catalog.");
+        }
+
+        const auto snapshot_id = snapshot.get<std::string>(0);
+
+        std::atomic<std::size_t> next_table{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        const auto read_tables = [&] {
+            try {
+                auto [name, conn] = ic::new_database_connection();
+
+                for (auto i = next_table++; i < _options.tables.size() && !failed; i = next_table++) {
+                    const auto& table = _options.tables[i];
+
+                    log::api::trace("Exporting table [{}] ...", table);
+
+                    nanodbc::transaction trans{conn};
+                    nanodbc::just_execute(conn, isolation_statement(name));
+                    nanodbc::just_execute(conn, fmt::format("set transaction snapshot '{}'", snapshot_id));
+
+                    // A server-side cursor keeps memory bounded regardless of the size of the table.
+                    nanodbc::just_execute(conn, fmt::format("declare catalog_export_cursor no scroll cursor for select * from {}", table));
+
+                    row_group_builder builder{table, _options.rows_per_row_group, _writer, _summaries[i]};
+
+                    while (!failed) {
+                        auto result = nanodbc::execute(conn, fmt::format("fetch forward {} from catalog_export_cursor", rows_per_fetch));
+
+                        if (builder.add_rows(result) < rows_per_fetch) {
+                            break;
+                        }
+                    }
+
+                    builder.flush();
+
+                    nanodbc::just_execute(conn, "close catalog_export_cursor");
+                    trans.commit();
+                }
+            }
+            catch (...) {
+                failed = true;
+
+                std::lock_guard<std::mutex> lk{error_mutex};
+
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        };
+
+        std::vector<std::thread> readers;
+        readers.reserve(_options.number_of_threads);
+
+        for (std::int64_t i = 0; i < _options.number_of_threads; ++i) {
+            readers.emplace_back(read_tables);
+        }
+
+        for (auto&& r : readers) {
+            r.join();
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+
+        leader_trans.commit();
+    }
+
+    // Other databases cannot share a snapshot between connections, so the tables are read one
+    // after the other in a single transaction.
+    //
+    // Rows are fetched rows_per_fetch at a time. Oracle ODBC drivers fetch them from the server
+    // as they are needed. MySQL Connector/ODBC reads the whole result of a query into memory on
+    // the catalog service provider unless the data source sets NO_CACHE=1 (option 1048576), so
+    // memory use grows with the largest exported table.
+    auto export_tables_sequentially(const std::string& _db_instance_name,
+                                    nanodbc::connection& _db_conn,
+                                    const export_options& _options,
+                                    archive_writer& _writer,
+                                    std::vector<table_summary>& _summaries) -> void
+    {
+        nanodbc::transaction trans{_db_conn};
+        nanodbc::just_execute(_db_conn, isolation_statement(_db_instance_name));
+
+        for (std::size_t i = 0; i < _options.tables.size(); ++i) {
+            const auto& table = _options.tables[i];
+
+            log::api::trace("Exporting table [{}] ...", table);
+
+            row_group_builder builder{table, _options.rows_per_row_group, _writer, _summaries[i]};
+            auto result = nanodbc::execute(_db_conn, fmt::format("select * from {}", table), rows_per_fetch);
+            builder.add_rows(result);
+            builder.flush();
+        }
+
+        trans.commit();
+    }
+
+    auto rs_catalog_export(rsComm_t* _comm, bytesBuf_t* _input, bytesBuf_t** _output) -> int
+    {
+        namespace bfs = boost::filesystem;
+
+        if (!irods::is_privileged_client(*_comm)) {
+            log::api::error("Catalog export requires rodsadmin level privileges.");
+            *_output = to_bytes_buffer(make_error_object("Catalog export requires rodsadmin level privileges.").dump());
+            return CAT_INSUFFICIENT_PRIVILEGE_LEVEL;
+        }
+
+        std::string partial_path;
+
+        const auto remove_partial_export = [&partial_path] {
+            if (!partial_path.empty()) {
+                boost::system::error_code ec;
+                bfs::remove(partial_path, ec);
+            }
+        };
+
+        try {
+            if (!ic::connected_to_catalog_provider(*_comm)) {
+                log::api::trace("Redirecting request to catalog service provider ...");
+
+                auto host_info = ic::redirect_to_catalog_provider(*_comm);
+
+                std::string_view json_input(static_cast<const char*>(_input->buf), _input->len);
+                char* json_output = nullptr;
+
+                const auto ec = rc_catalog_export(host_info.conn, json_input.data(), &json_output);
+                *_output = to_bytes_buffer(json_output ? json_output : "{}");
+                std::free(json_output);
+
+                return ec;
+            }
+
+            ic::throw_if_catalog_provider_service_role_is_invalid();
+
+            const auto options = parse_options(*_input);
+
+            if (!options.overwrite && bfs::exists(options.output_path)) {
+                THROW(OVERWRITE_WITHOUT_FORCE_FLAG, fmt::format("[{}] already exists.", options.output_path));
+            }
+
+            // Readers of the file never see a partial export.
+            partial_path = options.output_path + ".part";
+
+            const auto start = std::chrono::steady_clock::now();
+
+            auto [db_instance_name, db_conn] = ic::new_database_connection();
+
+            std::vector<table_summary> summaries(options.tables.size());
+            archive_writer writer{partial_path};
+
+            if (db_instance_name == "postgres") {
+                export_tables_in_parallel(db_conn, options, writer, summaries);
+            }
+            else {
+                export_tables_sequentially(db_instance_name, db_conn, options, writer, summaries);
+            }
+
+            json manifest{
+                {"format", "irods_catalog_export"},
+                {"format_version", 1},
+                {"entry_compression", "gzip"},
+                {"database", db_instance_name},
+                {"exported_at", std::time(nullptr)},
+                {"tables", json::object()}
+            };
+
+            json result{
+                {"output_path", options.output_path},
+                {"tables", json::object()}
+            };
+
+            std::int64_t total_rows = 0;
+
+            for (std::size_t i = 0; i < options.tables.size(); ++i) {
+                const auto& s = summaries[i];
+
+                manifest["tables"][options.tables[i]] = {
+                    {"columns", s.columns},
+                    {"rows", s.rows},
+                    {"row_groups", s.row_groups}
+                };
+
+                result["tables"][options.tables[i]] = {{"rows", s.rows}};
+                total_rows += s.rows;
+            }
+
+            writer.write("manifest.json", manifest.dump(4));
+            writer.close();
+
+            bfs::rename(partial_path, options.output_path);
+
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+            result["rows"] = total_rows;
+            result["seconds"] = elapsed.count();
+            result["rows_per_second"] = elapsed.count() > 0 ? total_rows / elapsed.count() : 0.0;
+
+            log::api::info("Exported {} catalog rows to [{}] in {:.3f} seconds.", total_rows, options.output_path, elapsed.count());
+
+            *_output = to_bytes_buffer(result.dump());
+
+            return 0;
+        }
+        catch (const irods::exception& e) {
+            log::api::error(e.what());
+            *_output = to_bytes_buffer(make_error_object(e.client_display_what()).dump());
+            remove_partial_export();
+            return e.code();
+        }
+        catch (const nanodbc::database_error& e) {
+            log::api::error(e.what());
+            *_output = to_bytes_buffer(make_error_object(e.what()).dump());
+            remove_partial_export();
+            return SYS_LIBRARY_ERROR;
+        }
+        catch (const std::exception& e) {
+            log::api::error(e.what());
+            *_output = to_bytes_buffer(make_error_object(e.what()).dump());
+            remove_partial_export();
+            return SYS_INTERNAL_ERR;
+        }
+    }
+
+    const operation op = rs_catalog_export;
+    #define CALL_CATALOG_EXPORT call_catalog_export
+} // anonymous namespace
+
+#else // RODS_SERVER
+
+//
+// Client-side Implementation
+//
+
+namespace
+{
+    using operation = std::function<int(rsComm_t*, bytesBuf_t*, bytesBuf_t**)>;
+    const operation op{};
+    #define CALL_CATALOG_EXPORT nullptr
+} // anonymous namespace
+
+#endif // RODS_SERVER
+
+// The plugin factory function must always be defined.
+extern "C"
+auto plugin_factory(const std::string& _instance_name,
+                    const std::string& _context) -> irods::api_entry*
+{
+#ifdef RODS_SERVER
+    irods::client_api_whitelist::instance().add(CATALOG_EXPORT_APN);
+#endif // RODS_SERVER
+
+    // clang-format off
+    irods::apidef_t def{CATALOG_EXPORT_APN,             // API number
+                        RODS_API_VERSION,               // API version
+                        LOCAL_PRIV_USER_AUTH,           // Client auth
+                        LOCAL_PRIV_USER_AUTH,           // Proxy auth
+                        "BinBytesBuf_PI", 0,            // In PI / bs flag
+                        "BinBytesBuf_PI", 0,            // Out PI / bs flag
+                        op,                             // Operation
+                        "api_catalog_export",           // Operation name
+                        nullptr,                        // Null clear function
+                        (funcPtr) CALL_CATALOG_EXPORT};
+    // clang-format on
+
+    auto* api = new irods::api_entry{def};
+
+    api->in_pack_key = "BinBytesBuf_PI";
+    api->in_pack_value = BytesBuf_PI;
+
+    api->out_pack_key = "BinBytesBuf_PI";
+    api->out_pack_value = BytesBuf_PI;
+
+    return api;
+}
@@ -48,6 +48,8 @@
 #include "nanodbc/nanodbc.h"
 
 #include <cstdlib>
+#include <ctime>
+#include <map>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -67,6 +69,9 @@ namespace
     using log       = irods::experimental::log;
     using json      = nlohmann::json;
     using operation = std::function<int(RsComm*, BytesBuf*, BytesBuf**)>;
+
+    // Bytes used by each (user_id, resc_id).
+    using quota_usage_map = std::map<std::pair<std::int64_t, std::int64_t>, std::int64_t>;
     // clang-format on
 
     const auto& cmap = ic::data_objects::column_mapping_operators;
@@ -227,6 +232,108 @@ namespace
         }
     } // set_replica_state
 
+    // Binds an integer to the statement. As in set_replica_state, Oracle requires
+    // 64-bit integers to be bound as strings, so _string must outlive the execution.
+    auto bind_integer(
+        nanodbc::statement& _statement,
+        const short _index,
+        const std::string_view _db_instance_name,
+        const std::int64_t& _value,
+        std::string& _string) -> void
+    {
+        if ("oracle" == _db_instance_name) {
+            _string = std::to_string(_value);
+            _statement.bind(_index, _string.c_str());
+        }
+        else {
+            _statement.bind(_index, &_value);
+        }
+    } // bind_integer
+
+    // Adds the sizes of the replicas of the data object, multiplied by _sign, to
+    // the usage of their owners. Called with -1 before and +1 after the update,
+    // _usage holds the change in usage.
+    auto get_quota_usage(
+        nanodbc::connection& _db_conn,
+        const std::string_view _db_instance_name,
+        const std::int64_t _data_id,
+        const int _sign,
+        quota_usage_map& _usage) -> void
+    {
+        nanodbc::statement statement{_db_conn};
+        prepare(statement, "select UM.user_id, DM.resc_id, sum(DM.data_size) "
+                           "from R_DATA_MAIN DM, R_USER_MAIN UM "
+                           "where DM.data_id = ? and"
+                           " UM.user_name = DM.data_owner_name and"
+                           " UM.zone_name = DM.data_owner_zone "
+                           "group by UM.user_id, DM.resc_id");
+
+        std::string data_id_string;
+        bind_integer(statement, 0, _db_instance_name, _data_id, data_id_string);
+
+        for (auto row = execute(statement); row.next();) {
+            const auto key = std::make_pair(std::stoll(row.get<std::string>(0)), std::stoll(row.get<std::string>(1)));
+            _usage[key] += _sign * std::stoll(row.get<std::string>(2));
+        }
+    } // get_quota_usage
+
+    // Adds the change in usage to R_QUOTA_USAGE and to the over_quota values of the
+    // quotas it counts towards, as the database plugin does for the other operations
+    // which change the size or owner of a replica.
+    auto add_quota_usage(
+        nanodbc::connection& _db_conn,
+        const std::string_view _db_instance_name,
+        const quota_usage_map& _usage) -> void
+    {
+        const auto now = fmt::format("{:011}", std::time(nullptr));
+
+        for (auto&& [key, bytes] : _usage) {
+            if (0 == bytes) {
+                continue;
+            }
+
+            const auto& [user_id, resc_id] = key;
+            std::string strings[3];
+
+            nanodbc::statement upsert{_db_conn};
+
+            if ("oracle" == _db_instance_name) {
+                prepare(upsert, "merge into R_QUOTA_USAGE QU "
+                                "using (select ? user_id, ? resc_id, ? quota_usage, ? modify_ts from DUAL) D "
+                                "on (QU.user_id = D.user_id and QU.resc_id = D.resc_id) "
+                                "when matched then update set QU.quota_usage = QU.quota_usage + D.quota_usage, QU.modify_ts = D.modify_ts "
+                                "when not matched then insert (user_id, resc_id, quota_usage, modify_ts) "
+                                "values (D.user_id, D.resc_id, D.quota_usage, D.modify_ts)");
+            }
+            else if ("mysql" == _db_instance_name) {
+                prepare(upsert, "insert into R_QUOTA_USAGE (user_id, resc_id, quota_usage, modify_ts) values (?, ?, ?, ?) "
+                                "on duplicate key update quota_usage = quota_usage + values(quota_usage), modify_ts = values(modify_ts)");
+            }
+            else {
+                prepare(upsert, "insert into R_QUOTA_USAGE (user_id, resc_id, quota_usage, modify_ts) values (?, ?, ?, ?) "
+                                "on conflict (user_id, resc_id) do update "
+                                "set quota_usage = R_QUOTA_USAGE.quota_usage + excluded.quota_usage, modify_ts = excluded.modify_ts");
+            }
+
+            bind_integer(upsert, 0, _db_instance_name, user_id, strings[0]);
+            bind_integer(upsert, 1, _db_instance_name, resc_id, strings[1]);
+            bind_integer(upsert, 2, _db_instance_name, bytes, strings[2]);
+            upsert.bind(3, now.c_str());
+            execute(upsert);
+
+            nanodbc::statement over{_db_conn};
+            prepare(over, "update R_QUOTA_MAIN set quota_over = quota_over + ?, modify_ts = ? "
+                          "where (resc_id = ? or resc_id = 0) and"
+                          " user_id in (select group_user_id from R_USER_GROUP where user_id = ?)");
+
+            bind_integer(over, 0, _db_instance_name, bytes, strings[2]);
+            over.bind(1, now.c_str());
+            bind_integer(over, 2, _db_instance_name, resc_id, strings[1]);
+            bind_integer(over, 3, _db_instance_name, user_id, strings[0]);
+            execute(over);
+        }
+    } // add_quota_usage
+
     auto set_data_object_state(
         nanodbc::connection& _db_conn,
         const std::string_view _db_instance_name,
@@ -234,6 +341,11 @@ namespace
         json& _replicas) -> void
     {
         try {
+            const auto data_id = std::stoll(_replicas.front().at("before").at("data_id").get<std::string>());
+
+            quota_usage_map usage;
+            get_quota_usage(_db_conn, _db_instance_name, data_id, -1, usage);
+
             for (auto& r : _replicas) {
                 auto& after = r.at("after");
                 validate_values(after);
@@ -241,6 +353,9 @@ namespace
                 set_replica_state(_db_conn, _db_instance_name, r.at("before"), after);
             }
 
+            get_quota_usage(_db_conn, _db_instance_name, data_id, 1, usage);
+            add_quota_usage(_db_conn, _db_instance_name, usage);
+
             irods::log(LOG_DEBUG10, "committing transaction");
             _trans.commit();
         }
@@ -12,6 +12,7 @@
 #include "miscServerFunct.hpp"
 #include "authPluginRequest.h"
 #include "icatHighLevelRoutines.hpp"
+#include "pam_auth_helper.hpp"
 
 // =-=-=-=-=-=-=-
 #include "irods_auth_plugin.hpp"
@@ -410,13 +411,21 @@ irods::error pam_auth_agent_request(
     }
 
     // =-=-=-=-=-=-=-
-    // Normal mode, fork/exec setuid program to do the Pam check
-    status = run_pam_auth_check( user_name, password );
-    if ( status == 256 ) {
+    // ask the persistent helper first, if the server started one
+    status = irods::experimental::pam_auth_helper::authenticate( user_name, password );
+    if ( status == PAM_AUTH_PASSWORD_FAILED ) {
         return ERROR( PAM_AUTH_PASSWORD_FAILED, "pam auth check failed" );
     }
-    else if ( status ) {
-        return ERROR( status, "pam auth check failed" );
+    else if ( status < 0 ) {
+        // =-=-=-=-=-=-=-
+        // Normal mode, fork/exec setuid program to do the Pam check
+        status = run_pam_auth_check( user_name, password );
+        if ( status == 256 ) {
+            return ERROR( PAM_AUTH_PASSWORD_FAILED, "pam auth check failed" );
+        }
+        else if ( status ) {
+            return ERROR( status, "pam auth check failed" );
+        }
     }
 
     // =-=-=-=-=-=-=-
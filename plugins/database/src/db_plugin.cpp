@@ -33,6 +33,8 @@
 #include "modAccessControl.h"
 #include "checksum.h"
 #include "key_value_proxy.hpp"
+#include "access_verdict_cache.hpp"
+#include "irods_at_scope_exit.hpp"
 
 // =-=-=-=-=-=-=-
 // irods includes
@@ -43,11 +45,13 @@
 
 // =-=-=-=-=-=-=-
 // stl includes
+#include <algorithm>
 #include <cstring>
 #include <sstream>
 #include <string>
 #include <string_view>
 #include <iostream>
+#include <map>
 #include <vector>
 #include <boost/regex.hpp>
 #include <boost/lexical_cast.hpp>
@@ -211,6 +215,20 @@ int _rollback( const char *functionName ) {
 
 } // _rollback
 
+// =-=-=-=-=-=-=-
+//  Set when cached access verdicts were discarded during the current
+//  transaction.  They are discarded again on commit, because a verdict
+//  computed in between may still reflect the old permissions.
+static bool access_verdicts_changed = false;
+
+// =-=-=-=-=-=-=-
+//  Called by operations that change permissions, group membership,
+//  users or tickets.
+static void invalidate_access_verdicts() {
+    irods::experimental::access_verdict_cache::invalidate();
+    access_verdicts_changed = true;
+} // invalidate_access_verdicts
+
 // =-=-=-=-=-=-=-
 //  Internal function to return the local zone (which is the default
 //  zone).  The first time it's called, it gets the zone from the DB and
@@ -639,6 +657,35 @@ irods::error _updateChildParent(
 
 } // _updateChildParent
 
+// Gives the resource hierarchy a new version so that servers caching it notice the
+// change. Catalogs that have not been upgraded yet have no version to update.
+irods::error _updateResourceHierarchyVersion() {
+    irods::sql_logger logger( "_updateResourceHierarchyVersion", logSQL );
+
+    const rodsLong_t seq_num = cmlGetNextSeqVal( &icss );
+    if ( seq_num < 0 ) {
+        _rollback( "_updateResourceHierarchyVersion" );
+        return ERROR( seq_num, "cmlGetNextSeqVal failed" );
+    }
+
+    const std::string version = std::to_string( seq_num );
+    cllBindVarCount = 0;
+    cllBindVars[cllBindVarCount++] = version.c_str();
+    logger.log();
+
+    const int status = cmlExecuteNoAnswerSql(
+                           "update R_GRID_CONFIGURATION set option_value=? "
+                           "where namespace='resource_hierarchy' and option_name='version'",
+                           &icss );
+    if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+        _rollback( "_updateResourceHierarchyVersion" );
+        return ERROR( status, "cmlExecuteNoAnswerSql failed" );
+    }
+
+    return SUCCESS();
+
+} // _updateResourceHierarchyVersion
+
 /**
  * @brief Returns true if the specified resource has associated data objects
  */
@@ -789,6 +836,79 @@ irods::error validate_zone_name(
 
 } // validate_zone_name
 
+/*
+ R_COLL_HIERARCHY holds a row for every collection and each of its
+ ancestors (including the collection itself, at depth 0), so that the
+ collections under a collection can be found through an index rather than
+ by matching the names of every collection in the zone.
+*/
+
+/* Add a new collection below the collection with id parentCollId.
+   Does not do the commit. */
+static int addCollToHierarchy( const char *collName, const char *parentCollId ) {
+    int status;
+
+    cllBindVars[cllBindVarCount++] = collName;
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "addCollToHierarchy SQL 1" );
+    }
+    status = cmlExecuteNoAnswerSql(
+                 "insert into R_COLL_HIERARCHY (ancestor_id, coll_id, depth) select coll_id, coll_id, 0 from R_COLL_MAIN where coll_name = ?",
+                 &icss );
+    if ( status != 0 ) {
+        return status;
+    }
+
+    cllBindVars[cllBindVarCount++] = parentCollId;
+    cllBindVars[cllBindVarCount++] = collName;
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "addCollToHierarchy SQL 2" );
+    }
+    status = cmlExecuteNoAnswerSql(
+                 "insert into R_COLL_HIERARCHY (ancestor_id, coll_id, depth) select H.ancestor_id, C.coll_id, H.depth + 1 from R_COLL_HIERARCHY H, R_COLL_MAIN C where H.coll_id = ? and C.coll_name = ?",
+                 &icss );
+    if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+        /* the parent is not in the hierarchy, e.g. the root collection */
+        status = 0;
+    }
+    return status;
+}
+
+/* Move the subtree of the collection with id collId below the collection
+   with id newParentId: the links to the old ancestors are removed and
+   links to the new ones are added. The links within the subtree do not
+   change. Does not do the commit. */
+static int moveCollInHierarchy( const char *collId, const char *newParentId ) {
+    int status;
+
+    /* The subtree is selected through a derived table as MySQL does not
+       allow a subquery on the table being modified. */
+    cllBindVars[cllBindVarCount++] = collId;
+    cllBindVars[cllBindVarCount++] = collId;
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "moveCollInHierarchy SQL 1" );
+    }
+    status = cmlExecuteNoAnswerSql(
+                 "delete from R_COLL_HIERARCHY where coll_id in (select S.coll_id from (select coll_id from R_COLL_HIERARCHY where ancestor_id = ?) S) and ancestor_id not in (select S.coll_id from (select coll_id from R_COLL_HIERARCHY where ancestor_id = ?) S)",
+                 &icss );
+    if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+        return status;
+    }
+
+    cllBindVars[cllBindVarCount++] = newParentId;
+    cllBindVars[cllBindVarCount++] = collId;
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "moveCollInHierarchy SQL 2" );
+    }
+    status = cmlExecuteNoAnswerSql(
+                 "insert into R_COLL_HIERARCHY (ancestor_id, coll_id, depth) select A.ancestor_id, S.coll_id, A.depth + S.depth + 1 from R_COLL_HIERARCHY A, R_COLL_HIERARCHY S where A.coll_id = ? and S.ancestor_id = ?",
+                 &icss );
+    if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+        status = 0;
+    }
+    return status;
+}
+
 /* delCollection (internally called),
    does not do the commit.
 */
@@ -889,6 +1009,23 @@ static int _delColl( rsComm_t *rsComm, collInfo_t *collInfo ) {
         return status;
     }
 
+    /* remove it from the hierarchy; as it is empty, it is only the
+       descendant in these rows */
+    cllBindVars[cllBindVarCount++] = collIdNum;
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "_delColl SQL 6" );
+    }
+    status =  cmlExecuteNoAnswerSql(
+                  "delete from R_COLL_HIERARCHY where coll_id=?",
+                  &icss );
+    if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+        rodsLog( LOG_NOTICE,
+                 "_delColl cmlExecuteNoAnswerSql delete hierarchy failure %d",
+                 status );
+        _rollback( "_delColl" );
+        return status;
+    }
+
     /* remove any access rows */
     cllBindVars[cllBindVarCount++] = collIdNum;
     if ( logSQL != 0 ) {
@@ -1373,15 +1510,9 @@ findOrInsertAVU( const char *attribute, const char *value, const char *units ) {
 }
 
 
-/* create a path name with escaped SQL special characters (% and _) */
-std::string
-makeEscapedPath( const std::string &inPath ) {
-    return boost::regex_replace( inPath, boost::regex( "[%_\\\\]" ), "\\\\$&" );
-}
-
 /* Internal routine to modify inheritance */
 /* inheritFlag =1 to set, 2 to remove */
-int _modInheritance( int inheritFlag, int recursiveFlag, const char *collIdStr, const char *pathName ) {
+int _modInheritance( int inheritFlag, int recursiveFlag, const char *collIdStr ) {
 
     const char* newValue = inheritFlag == 1 ? "1" : "0";
 
@@ -1404,25 +1535,16 @@ int _modInheritance( int inheritFlag, int recursiveFlag, const char *collIdStr,
                       &icss );
     }
     else {
-        /* Recursive mode */
-        std::string pathStart = makeEscapedPath( pathName ) + "/%";
-
+        /* Recursive mode: the collection and everything below it */
         cllBindVars[cllBindVarCount++] = newValue;
         cllBindVars[cllBindVarCount++] = myTime;
-        cllBindVars[cllBindVarCount++] = pathName;
-        cllBindVars[cllBindVarCount++] = pathStart.c_str();
+        cllBindVars[cllBindVarCount++] = collIdStr;
         if ( logSQL != 0 ) {
             rodsLog( LOG_SQL, "_modInheritance SQL 2" );
         }
-#ifdef ORA_ICAT
-        status =  cmlExecuteNoAnswerSql(
-                      "update R_COLL_MAIN set coll_inheritance=?, modify_ts=? where coll_name = ? or coll_name like ? ESCAPE '\\'",
-                      &icss );
-#else
         status =  cmlExecuteNoAnswerSql(
-                      "update R_COLL_MAIN set coll_inheritance=?, modify_ts=? where coll_name = ? or coll_name like ?",
+                      "update R_COLL_MAIN set coll_inheritance=?, modify_ts=? where coll_id in (select coll_id from R_COLL_HIERARCHY where ancestor_id=?)",
                       &icss );
-#endif
     }
     if ( status != 0 ) {
         _rollback( "_modInheritance" );
@@ -1645,6 +1767,120 @@ int setOverQuota( rsComm_t *rsComm ) {
     return status;
 }
 
+/*
+  Incremental usage accounting.  Rather than recomputing R_QUOTA_USAGE
+  from all of R_DATA_MAIN, the operations that register, modify or
+  unregister replicas add the change in the size of those replicas to
+  the usage rows of their owners, and to the over_quota values of the
+  quotas that usage counts towards.  chlCalcUsageAndQuota reconciles
+  the counters with R_DATA_MAIN to correct any drift.
+*/
+
+/* Bytes used by each (user_id, resc_id) */
+typedef std::map<std::pair<std::string, std::string>, rodsLong_t> quotaUsageMap;
+
+/*
+  Add the sizes of the replicas matching condition (on R_DATA_MAIN DM),
+  multiplied by sign, to the usage of their owners.  Called with -1
+  before and +1 after a change, the map holds the change in usage.
+*/
+int getReplicaQuotaUsage( const char *condition,
+                          std::vector<std::string> &bindVars,
+                          int sign,
+                          quotaUsageMap &usage ) {
+    char mySQL[MAX_SQL_SIZE];
+    int statementNum = UNINITIALIZED_STATEMENT_NUMBER;
+    int status;
+
+    snprintf( mySQL, sizeof mySQL,
+              "select UM.user_id, DM.resc_id, sum(DM.data_size) from R_DATA_MAIN DM, R_USER_MAIN UM where %s and UM.user_name = DM.data_owner_name and UM.zone_name = DM.data_owner_zone group by UM.user_id, DM.resc_id",
+              condition );
+
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "getReplicaQuotaUsage SQL 1" );
+    }
+    for ( int rowsFound = 0;; rowsFound++ ) {
+        if ( rowsFound == 0 ) {
+            status = cmlGetFirstRowFromSqlBV( mySQL, bindVars, &statementNum, &icss );
+        }
+        else {
+            status = cmlGetNextRowFromStatement( statementNum, &icss );
+        }
+        if ( status != 0 ) {
+            break;
+        }
+        std::pair<std::string, std::string> key( icss.stmtPtr[statementNum]->resultValue[0],
+                                                 icss.stmtPtr[statementNum]->resultValue[1] );
+        usage[key] += sign * atoll( icss.stmtPtr[statementNum]->resultValue[2] );
+    }
+    cmlFreeStatement( statementNum, &icss );
+
+    if ( status == CAT_NO_ROWS_FOUND ) {
+        return 0;
+    }
+    return status;
+}
+
+/*
+  Add the changes in usage to R_QUOTA_USAGE, and to the over_quota values
+  of the quotas they count towards: those of the user and of the groups
+  the user is a member of (every user is a member of its own group), on
+  the resource and in total.  This keeps over_quota as setOverQuota
+  would compute it, so chlCheckQuota only needs to read it.
+*/
+int addQuotaUsage( const quotaUsageMap &usage ) {
+    char myTime[50];
+    int status;
+
+    getNowStr( myTime );
+
+    for ( quotaUsageMap::const_iterator it = usage.begin(); it != usage.end(); ++it ) {
+        if ( it->second == 0 ) {
+            continue;
+        }
+        std::string delta = std::to_string( it->second );
+
+        cllBindVars[cllBindVarCount++] = it->first.first.c_str();
+        cllBindVars[cllBindVarCount++] = it->first.second.c_str();
+        cllBindVars[cllBindVarCount++] = delta.c_str();
+        cllBindVars[cllBindVarCount++] = myTime;
+        if ( logSQL != 0 ) {
+            rodsLog( LOG_SQL, "addQuotaUsage SQL 1" );
+        }
+        status = cmlExecuteNoAnswerSql(
+#if ORA_ICAT
+                     "merge into R_QUOTA_USAGE QU using (select ? user_id, ? resc_id, ? quota_usage, ? modify_ts from DUAL) D on (QU.user_id = D.user_id and QU.resc_id = D.resc_id) when matched then update set QU.quota_usage = QU.quota_usage + D.quota_usage, QU.modify_ts = D.modify_ts when not matched then insert (user_id, resc_id, quota_usage, modify_ts) values (D.user_id, D.resc_id, D.quota_usage, D.modify_ts)",
+#elif MY_ICAT
+                     "insert into R_QUOTA_USAGE (user_id, resc_id, quota_usage, modify_ts) values (?, ?, ?, ?) on duplicate key update quota_usage = quota_usage + values(quota_usage), modify_ts = values(modify_ts)",
+#else
+                     "insert into R_QUOTA_USAGE (user_id, resc_id, quota_usage, modify_ts) values (?, ?, ?, ?) on conflict (user_id, resc_id) do update set quota_usage = R_QUOTA_USAGE.quota_usage + excluded.quota_usage, modify_ts = excluded.modify_ts",
+#endif
+                     &icss );
+        if ( status != 0 ) {
+            return status;
+        }
+
+        cllBindVars[cllBindVarCount++] = delta.c_str();
+        cllBindVars[cllBindVarCount++] = myTime;
+        cllBindVars[cllBindVarCount++] = it->first.second.c_str();
+        cllBindVars[cllBindVarCount++] = it->first.first.c_str();
+        if ( logSQL != 0 ) {
+            rodsLog( LOG_SQL, "addQuotaUsage SQL 2" );
+        }
+        status = cmlExecuteNoAnswerSql(
+                     "update R_QUOTA_MAIN set quota_over = quota_over + ?, modify_ts = ? where (resc_id = ? or resc_id = '0') and user_id in (select group_user_id from R_USER_GROUP where user_id = ?)",
+                     &icss );
+        if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+            status = 0;    /* no quotas apply */
+        }
+        if ( status != 0 ) {
+            return status;
+        }
+    }
+
+    return 0;
+}
+
 int
 icatGetTicketUserId( irods::plugin_property_map& _prop_map, const char *userName, char *userIdStr ) {
 
@@ -2072,6 +2308,16 @@ irods::error db_mod_data_obj_meta_op(
                    "null parameter" );
     }
 
+    // moving the object to another collection may take it out of the
+    // collection of a ticket whose verdict is cached
+    const bool moves_object = getValByKey( _reg_param, COLL_ID_KW ) ||
+                              getValByKey( _reg_param, DATA_NAME_KW );
+    irods::at_scope_exit invalidate_verdicts{[moves_object] {
+        if ( moves_object ) {
+            invalidate_access_verdicts();
+        }
+    }};
+
     // =-=-=-=-=-=-=-
     // get a postgres object from the context
     /*irods::postgres_object_ptr pg;
@@ -2158,6 +2404,8 @@ irods::error db_mod_data_obj_meta_op(
     };
 
     int doingDataSize = 0;
+    bool doingQuotaUsage = false;
+    quotaUsageMap quotaUsage;
     char dataSizeString[NAME_LEN] = "";
     char objIdString[MAX_NAME_LEN];
     char *neededAccess = 0;
@@ -2228,6 +2476,13 @@ irods::error db_mod_data_obj_meta_op(
                     }
                 }
             }
+            if(regParamNames[i] == DATA_SIZE_KW ||
+               regParamNames[i] == DATA_OWNER_KW ||
+               regParamNames[i] == DATA_OWNER_ZONE_KW ||
+               colNames[i] == "resc_id" || colNames[i] == "resc_hier") {
+                doingQuotaUsage = true; /* changes the usage of the owner(s) */
+            }
+
             if(regParamNames[i] == DATA_SIZE_KW) {
                 doingDataSize = 1; /* flag to check size */
                 snprintf( dataSizeString, sizeof( dataSizeString ), "%s", theVal );
@@ -2427,6 +2682,16 @@ irods::error db_mod_data_obj_meta_op(
         return PASS( ret );
     }
 
+    if ( doingQuotaUsage ) {
+        std::vector<std::string> bindVars;
+        bindVars.push_back( objIdString );
+        status = getReplicaQuotaUsage( "DM.data_id = ?", bindVars, -1, quotaUsage );
+        if ( status != 0 ) {
+            _rollback( "chlModDataObjMeta" );
+            return ERROR( status, "getReplicaQuotaUsage failure" );
+        }
+    }
+
     if (!getValByKey(_reg_param, ALL_REPL_STATUS_KW)) {
         if ( logSQL != 0 ) {
             rodsLog( LOG_SQL, "chlModDataObjMeta SQL 4" );
@@ -2545,6 +2810,19 @@ irods::error db_mod_data_obj_meta_op(
                    "cmlModifySingleTable failure" );
     }
 
+    if ( doingQuotaUsage ) {
+        std::vector<std::string> bindVars;
+        bindVars.push_back( objIdString );
+        status = getReplicaQuotaUsage( "DM.data_id = ?", bindVars, 1, quotaUsage );
+        if ( status == 0 ) {
+            status = addQuotaUsage( quotaUsage );
+        }
+        if ( status != 0 ) {
+            _rollback( "chlModDataObjMeta" );
+            return ERROR( status, "quota usage update failure" );
+        }
+    }
+
     if ( !( _data_obj_info->flags & NO_COMMIT_FLAG ) ) {
         status =  cmlExecuteNoAnswerSql( "commit", &icss );
         if ( status != 0 ) {
@@ -2789,6 +3067,22 @@ irods::error db_reg_data_obj_op(
         }
     }
 
+    {
+        quotaUsageMap usage;
+        std::vector<std::string> bindVars;
+        bindVars.push_back( dataIdNum );
+        status = getReplicaQuotaUsage( "DM.data_id = ?", bindVars, 1, usage );
+        if ( status == 0 ) {
+            status = addQuotaUsage( usage );
+        }
+        if ( status != 0 ) {
+            rodsLog( LOG_NOTICE,
+                     "chlRegDataObj quota usage update failure %d", status );
+            _rollback( "chlRegDataObj" );
+            return ERROR( status, "quota usage update failure" );
+        }
+    }
+
     if ( !( _data_obj_info->flags & NO_COMMIT_FLAG ) ) {
         status =  cmlExecuteNoAnswerSql( "commit", &icss );
         if ( status != 0 ) {
@@ -3064,6 +3358,23 @@ irods::error db_reg_replica_op(
         return ERROR( status, "cmlFreeStatement failure" );
     }
 
+    {
+        quotaUsageMap usage;
+        std::vector<std::string> bindVars;
+        bindVars.push_back( objIdString );
+        bindVars.push_back( nextRepl );
+        status = getReplicaQuotaUsage( "DM.data_id = ? and DM.data_repl_num = ?", bindVars, 1, usage );
+        if ( status == 0 ) {
+            status = addQuotaUsage( usage );
+        }
+        if ( status != 0 ) {
+            rodsLog( LOG_NOTICE,
+                     "chlRegReplica quota usage update failure %d", status );
+            _rollback( "chlRegReplica" );
+            return ERROR( status, "quota usage update failure" );
+        }
+    }
+
     status =  cmlExecuteNoAnswerSql( "commit", &icss );
     if ( status != 0 ) {
         rodsLog( LOG_NOTICE,
@@ -3240,6 +3551,31 @@ irods::error db_unreg_replica_op(
         resc_hier = std::string( _data_obj_info->rescHier );
     }
 
+    /* Subtract the replicas about to be removed from their owners' usage */
+    {
+        quotaUsageMap usage;
+        std::vector<std::string> bindVars;
+        bindVars.push_back( logicalDirName );
+        bindVars.push_back( logicalFileName );
+        if ( _data_obj_info->replNum >= 0 ) {
+            snprintf( replNumber, sizeof replNumber, "%d", _data_obj_info->replNum );
+            bindVars.push_back( replNumber );
+            status = getReplicaQuotaUsage( "DM.coll_id = (select coll_id from R_COLL_MAIN where coll_name = ?) and DM.data_name = ? and DM.data_repl_num = ?",
+                                           bindVars, -1, usage );
+        }
+        else {
+            status = getReplicaQuotaUsage( "DM.coll_id = (select coll_id from R_COLL_MAIN where coll_name = ?) and DM.data_name = ?",
+                                           bindVars, -1, usage );
+        }
+        if ( status == 0 ) {
+            status = addQuotaUsage( usage );
+        }
+        if ( status != 0 ) {
+            _rollback( "chlUnregDataObj" );
+            return ERROR( status, "quota usage update failure" );
+        }
+    }
+
     cllBindVars[0] = logicalDirName;
     cllBindVars[1] = logicalFileName;
     if ( _data_obj_info->replNum >= 0 ) {
@@ -3308,6 +3644,179 @@ irods::error db_unreg_replica_op(
 
 } // db_unreg_replica_op
 
+/*
+  Unregister whole data objects (all of their replicas) by id, in one
+  transaction.  Used by the bulk recursive delete, which has already
+  removed the physical files.  Unless in admin mode, the user must have
+  delete permission on every object, otherwise nothing is unregistered.
+  The ids are handled in groups to bound the number of bind variables.
+*/
+static const std::size_t unregDataObjsGroupSize = 500;
+
+irods::error db_unreg_data_objs_op(
+    irods::plugin_context&          _ctx,
+    const std::vector<rodsLong_t>*  _data_ids,
+    keyValPair_t*                   _cond_input ) {
+    // =-=-=-=-=-=-=-
+    // check the context
+    irods::error ret = _ctx.valid();
+    if ( !ret.ok() ) {
+        return PASS( ret );
+    }
+
+    // =-=-=-=-=-=-=-
+    // check the params
+    if ( !_data_ids ) {
+        return ERROR( CAT_INVALID_ARGUMENT, "null parameter" );
+    }
+
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "chlUnregDataObjs" );
+    }
+
+    if ( !icss.status ) {
+        return ERROR( CATALOG_NOT_CONNECTED, "catalog not connected" );
+    }
+
+    int adminMode = 0;
+    int trashMode = 0;
+    if ( _cond_input != NULL ) {
+        if ( getValByKey( _cond_input, ADMIN_KW ) != NULL ) {
+            adminMode = 1;
+        }
+        if ( getValByKey( _cond_input, ADMIN_RMTRASH_KW ) != NULL ) {
+            adminMode = 1;
+            trashMode = 1;
+        }
+    }
+
+    if ( adminMode && _ctx.comm()->clientUser.authInfo.authFlag != LOCAL_PRIV_USER_AUTH ) {
+        return ERROR( CAT_INSUFFICIENT_PRIVILEGE_LEVEL, "insufficient privilege" );
+    }
+
+    std::string trashPattern;
+    if ( trashMode ) {
+        std::string zone;
+        ret = getLocalZone( _ctx.prop_map(), &icss, zone );
+        if ( !ret.ok() ) {
+            return PASS( ret );
+        }
+        trashPattern = "/" + zone + "/trash/%";
+    }
+
+    char tSQL[MAX_SQL_SIZE];
+    rodsLong_t status;
+
+    for ( std::size_t first = 0; first < _data_ids->size(); first += unregDataObjsGroupSize ) {
+        const std::size_t last = std::min( first + unregDataObjsGroupSize, _data_ids->size() );
+
+        std::vector<std::string> ids;
+        std::string inList;
+        for ( std::size_t i = first; i < last; i++ ) {
+            ids.push_back( std::to_string( ( *_data_ids )[i] ) );
+            inList += ( i == first ) ? "?" : ",?";
+        }
+        const rodsLong_t idCount = ids.size();
+
+        if ( adminMode == 0 ) {
+            /* Every object must exist and be deletable by the user */
+            std::vector<std::string> bindVars = ids;
+            bindVars.push_back( _ctx.comm()->clientUser.userName );
+            bindVars.push_back( _ctx.comm()->clientUser.rodsZone );
+            bindVars.push_back( ACCESS_DELETE_OBJECT );
+            snprintf( tSQL, MAX_SQL_SIZE,
+                      "select count(distinct DM.data_id) from R_DATA_MAIN DM, R_OBJT_ACCESS OA, R_USER_GROUP UG, R_USER_MAIN UM, R_TOKN_MAIN TM where DM.data_id in (%s) and UM.user_name=? and UM.zone_name=? and UM.user_type_name!='rodsgroup' and UM.user_id = UG.user_id and OA.object_id = DM.data_id and UG.group_user_id = OA.user_id and OA.access_type_id >= TM.token_id and TM.token_namespace ='access_type' and TM.token_name = ?",
+                      inList.c_str() );
+            if ( logSQL != 0 ) {
+                rodsLog( LOG_SQL, "chlUnregDataObjs SQL 1" );
+            }
+            rodsLong_t permitted = 0;
+            status = cmlGetIntegerValueFromSql( tSQL, &permitted, bindVars, &icss );
+            if ( status != 0 && status != CAT_NO_ROWS_FOUND ) {
+                _rollback( "chlUnregDataObjs" );
+                return ERROR( status, "access check failed" );
+            }
+            if ( permitted != idCount ) {
+                _rollback( "chlUnregDataObjs" );
+                return ERROR( CAT_NO_ACCESS_PERMISSION, "no delete permission on all data objects" );
+            }
+        }
+        else if ( trashMode ) {
+            std::vector<std::string> bindVars = ids;
+            bindVars.push_back( trashPattern );
+            snprintf( tSQL, MAX_SQL_SIZE,
+                      "select count(distinct DM.data_id) from R_DATA_MAIN DM, R_COLL_MAIN CM where DM.data_id in (%s) and DM.coll_id = CM.coll_id and CM.coll_name like ?",
+                      inList.c_str() );
+            if ( logSQL != 0 ) {
+                rodsLog( LOG_SQL, "chlUnregDataObjs SQL 2" );
+            }
+            rodsLong_t inTrash = 0;
+            status = cmlGetIntegerValueFromSql( tSQL, &inTrash, bindVars, &icss );
+            if ( status != 0 && status != CAT_NO_ROWS_FOUND ) {
+                _rollback( "chlUnregDataObjs" );
+                return ERROR( status, "trash path check failed" );
+            }
+            if ( inTrash != idCount ) {
+                _rollback( "chlUnregDataObjs" );
+                addRErrorMsg( &_ctx.comm()->rError, 0,
+                              "TRASH_KW but not zone/trash path" );
+                return ERROR( CAT_INVALID_ARGUMENT, "TRASH_KW but not zone/trash path" );
+            }
+        }
+
+        /* Subtract the replicas about to be removed from their owners' usage */
+        {
+            quotaUsageMap usage;
+            std::vector<std::string> bindVars = ids;
+            const std::string condition = "DM.data_id in (" + inList + ")";
+            status = getReplicaQuotaUsage( condition.c_str(), bindVars, -1, usage );
+            if ( status == 0 ) {
+                status = addQuotaUsage( usage );
+            }
+            if ( status != 0 ) {
+                _rollback( "chlUnregDataObjs" );
+                return ERROR( status, "quota usage update failure" );
+            }
+        }
+
+        const char *tables[] = { "R_DATA_MAIN where data_id",
+                                 "R_OBJT_ACCESS where object_id",
+                                 "R_OBJT_METAMAP where object_id"
+                               };
+        for ( std::size_t t = 0; t < sizeof( tables ) / sizeof( tables[0] ); t++ ) {
+            for ( const auto& id : ids ) {
+                cllBindVars[cllBindVarCount++] = id.c_str();
+            }
+            snprintf( tSQL, MAX_SQL_SIZE, "delete from %s in (%s)", tables[t], inList.c_str() );
+            if ( logSQL != 0 ) {
+                rodsLog( LOG_SQL, "chlUnregDataObjs SQL %d", static_cast<int>( t ) + 3 );
+            }
+            status = cmlExecuteNoAnswerSql( tSQL, &icss );
+            if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO && t > 0 ) {
+                status = 0;    /* no ACLs or AVUs */
+            }
+            if ( status != 0 ) {
+                _rollback( "chlUnregDataObjs" );
+                if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+                    return ERROR( CAT_UNKNOWN_FILE, "data objects unknown" );
+                }
+                return ERROR( status, "cmlExecuteNoAnswerSql failed" );
+            }
+        }
+    }
+
+    status = cmlExecuteNoAnswerSql( "commit", &icss );
+    if ( status != 0 ) {
+        rodsLog( LOG_NOTICE,
+                 "chlUnregDataObjs cmlExecuteNoAnswerSql commit failure %d",
+                 status );
+        return ERROR( status, "cmlExecuteNoAnswerSql commit failure" );
+    }
+
+    return SUCCESS();
+
+} // db_unreg_data_objs_op
+
 // =-=-=-=-=-=-=-
 //
 irods::error db_reg_rule_exec_op(
@@ -3814,6 +4323,11 @@ irods::error db_add_child_resc_op(
         return PASS(ret);
     }
 
+    ret = _updateResourceHierarchyVersion();
+    if(!ret.ok()) {
+        return PASS(ret);
+    }
+
     status = cmlExecuteNoAnswerSql( "commit", &icss );
     if(status != 0) {
         return ERROR(
@@ -3982,6 +4496,11 @@ irods::error db_reg_resc_op(
         return ERROR( status, "cmlExectuteNoAnswerSql(insert) failure" );
     }
 
+    ret = _updateResourceHierarchyVersion();
+    if ( !ret.ok() ) {
+        return PASS( ret );
+    }
+
     status =  cmlExecuteNoAnswerSql( "commit", &icss );
     if ( status != 0 ) {
         rodsLog( LOG_NOTICE,
@@ -4071,6 +4590,11 @@ irods::error db_del_child_resc_op(
         return PASS(ret);
     }
 
+    ret = _updateResourceHierarchyVersion();
+    if(!ret.ok()) {
+        return PASS(ret);
+    }
+
     status = cmlExecuteNoAnswerSql( "commit", &icss );
     if(status != 0) {
         return ERROR(
@@ -4238,6 +4762,11 @@ irods::error db_del_resc_op(
         return CODE( status );
     }
 
+    ret = _updateResourceHierarchyVersion();
+    if ( !ret.ok() ) {
+        return PASS( ret );
+    }
+
     status =  cmlExecuteNoAnswerSql( "commit", &icss );
     if ( status != 0 ) {
         rodsLog( LOG_NOTICE,
@@ -4317,6 +4846,10 @@ irods::error db_commit_op(
         rodsLog( LOG_SQL, "chlCommit - SQL 1 " );
     }
     int status =  cmlExecuteNoAnswerSql( "commit", &icss );
+    if ( access_verdicts_changed ) {
+        irods::experimental::access_verdict_cache::invalidate();
+        access_verdicts_changed = false;
+    }
     if ( status != 0 ) {
         rodsLog( LOG_NOTICE,
                  "chlCommit cmlExecuteNoAnswerSql failure %d",
@@ -4340,6 +4873,9 @@ irods::error db_del_user_re_op(
         return PASS( ret );
     }
 
+    // cached access verdicts may no longer hold once this returns
+    irods::at_scope_exit invalidate_verdicts{[] { invalidate_access_verdicts(); }};
+
     // =-=-=-=-=-=-=-
     // check the params
     if (
@@ -4676,6 +5212,14 @@ irods::error db_reg_coll_by_admin_op(
         return ERROR( status, "cmlExecuteNoAnswerSQL(insert) failure" );
     }
 
+    status = addCollToHierarchy( _coll_info->collName, collIdNum );
+    if ( status != 0 ) {
+        rodsLog( LOG_NOTICE,
+                 "chlRegCollByAdmin addCollToHierarchy failure %d", status );
+        _rollback( "chlRegCollByAdmin" );
+        return ERROR( status, "addCollToHierarchy failure" );
+    }
+
     /* String to get current sequence item for objects */
     cllCurrentValueString( "R_ObjectID", currStr, MAX_NAME_LEN );
     snprintf( currStr2, MAX_SQL_SIZE, " %s ", currStr );
@@ -4837,6 +5381,14 @@ irods::error db_reg_coll_op(
         return ERROR( status, "cmlExecuteNoAnswerSql(insert) failure" );
     }
 
+    status = addCollToHierarchy( _coll_info->collName, collIdNum );
+    if ( status != 0 ) {
+        rodsLog( LOG_NOTICE,
+                 "chlRegColl addCollToHierarchy failure %d", status );
+        _rollback( "chlRegColl" );
+        return ERROR( status, "addCollToHierarchy failure" );
+    }
+
     /* String to get current sequence item for objects */
     cllCurrentValueString( "R_ObjectID", currStr, MAX_NAME_LEN );
     snprintf( currStr2, MAX_SQL_SIZE, " %s ", currStr );
@@ -5395,6 +5947,10 @@ irods::error db_rename_coll_op(
                    "null parameter" );
     }
 
+    // tickets on a collection cover the objects under it, so a cached ticket
+    // verdict may no longer hold once this returns
+    irods::at_scope_exit invalidate_verdicts{[] { invalidate_access_verdicts(); }};
+
     // =-=-=-=-=-=-=-
     // get a postgres object from the context
     /*irods::postgres_object_ptr pg;
@@ -5451,6 +6007,9 @@ irods::error db_mod_zone_coll_acl_op(
         return PASS( ret );
     }
 
+    // cached access verdicts may no longer hold once this returns
+    irods::at_scope_exit invalidate_verdicts{[] { invalidate_access_verdicts(); }};
+
     // =-=-=-=-=-=-=-
     // check the params
     if (
@@ -5509,6 +6068,9 @@ irods::error db_rename_local_zone_op(
         return PASS( ret );
     }
 
+    // cached access verdicts may no longer hold once this returns
+    irods::at_scope_exit invalidate_verdicts{[] { invalidate_access_verdicts(); }};
+
     // =-=-=-=-=-=-=-
     // check the params
     if (
@@ -6218,6 +6780,21 @@ irods::error db_del_coll_by_admin_op(
     snprintf( collIdNum, MAX_NAME_LEN, "%lld", iVal );
     removeMetaMapAndAVU( collIdNum );
 
+    cllBindVars[cllBindVarCount++] = collIdNum;
+    cllBindVars[cllBindVarCount++] = collIdNum;
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "chlDelCollByAdmin SQL 5" );
+    }
+    status =  cmlExecuteNoAnswerSql( "delete from R_COLL_HIERARCHY where coll_id=? or ancestor_id=?",
+                                     &icss );
+    if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+        rodsLog( LOG_NOTICE,
+                 "chlDelCollByAdmin delete hierarchy failure %d",
+                 status );
+        _rollback( "chlDelCollByAdmin" );
+        return ERROR( status, "delete hierarchy failure" );
+    }
+
     /* delete the row if it exists */
     cllBindVars[cllBindVarCount++] = _coll_info->collName;
     if ( logSQL != 0 ) {
@@ -7352,6 +7929,9 @@ irods::error db_mod_user_op(
         return PASS( ret );
     }
 
+    // cached access verdicts may no longer hold once this returns
+    irods::at_scope_exit invalidate_verdicts{[] { invalidate_access_verdicts(); }};
+
     // =-=-=-=-=-=-=-
     // check the params
     if (
@@ -7696,6 +8276,9 @@ irods::error db_mod_group_op(
         return PASS( ret );
     }
 
+    // cached access verdicts may no longer hold once this returns
+    irods::at_scope_exit invalidate_verdicts{[] { invalidate_access_verdicts(); }};
+
     // =-=-=-=-=-=-=-
     // check the params
     if (
@@ -7870,6 +8453,13 @@ irods::error db_mod_group_op(
         return ERROR( CAT_INVALID_ARGUMENT, "invalid option" );
     }
 
+    /* The user's usage now counts towards different group quotas */
+    status = setOverQuota( _ctx.comm() );
+    if ( status != 0 ) {
+        _rollback( "chlModGroup" );
+        return ERROR( status, "setOverQuota failed" );
+    }
+
     status =  cmlExecuteNoAnswerSql( "commit", &icss );
     if ( status != 0 ) {
         rodsLog( LOG_NOTICE,
@@ -8295,6 +8885,11 @@ irods::error db_mod_resc_op(
         return ERROR( CAT_INVALID_ARGUMENT, "invalid option" );
     }
 
+    ret = _updateResourceHierarchyVersion();
+    if ( !ret.ok() ) {
+        return PASS( ret );
+    }
+
     status =  cmlExecuteNoAnswerSql( "commit", &icss );
     if ( status != 0 ) {
         rodsLog( LOG_NOTICE,
@@ -10142,6 +10737,9 @@ irods::error db_mod_access_control_op(
         return PASS( ret );
     }
 
+    // cached access verdicts may no longer hold once this returns
+    irods::at_scope_exit invalidate_verdicts{[] { invalidate_access_verdicts(); }};
+
     if ( logSQL != 0 ) {
         rodsLog( LOG_SQL, "chlModAccessControl" );
     }
@@ -10347,7 +10945,7 @@ irods::error db_mod_access_control_op(
 
     /* Doing inheritance */
     if ( inheritFlag != 0 ) {
-        int status = _modInheritance( inheritFlag, _recursive_flag, collIdStr, _path_name );
+        int status = _modInheritance( inheritFlag, _recursive_flag, collIdStr );
         return ERROR( status, "_modInheritance failed" );
     }
 
@@ -10480,102 +11078,19 @@ irods::error db_mod_access_control_op(
     }
 
 
-    std::string pathStart = makeEscapedPath( _path_name ) + "/%";
-    int status;
-
-#if (defined ORA_ICAT || defined MY_ICAT)
-#else
-    /* The temporary table created and used below has been found to
-       greatly speed up the execution of subsequent deletes and
-       updates.  We did a lot of testing and 'explain' SQL using a copy
-       (minus passwords) of the large iPlant ICAT DB to find this.  It
-       makes sense that using a table like this will speed it up,
-       except for the constraints aspect (further below).
-
-       It is very likely that the same temporary table would also speed
-       up Oracle and MySQL ICATs but we didn't have time to test that
-       so this is only for Postgres for now.  The SQL for creating the
-       table is probably a bit different for Oracle and MySQL but
-       otherwise I expect this would work for them.
-
-       Before this change the SQL could take minutes on a very large
-       instance.  With this, it can take less than a second on a
-       'ichmod -r' on a small sub-collection, and is fairly fast on
-       moderate sized ones.  I expect it will perform somewhat better
-       than the old SQL on large ones, but I was unable to reliably
-       test this on our fairly modest hardware.
-
-       Since these SQL statements are only for Postgres, we can't add
-       rodsLog(LOG_SQL, ...) calls (so 'devtest' will verify it is
-       called), but since the later postgres SQL depends on this table,
-       we can be sure this is exercised if "chlModAccessControl SQL 8" is.
-    */
-    status =  cmlExecuteNoAnswerSql( "create temporary table R_MOD_ACCESS_TEMP1 (coll_id bigint not null, coll_name varchar(2700) not null) on commit drop",
-                                     &icss );
-    if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
-        status = 0;
-    }
-    if ( status != 0 ) {
-        rodsLog( LOG_NOTICE,
-                 "chlModAccessControl cmlExecuteNoAnswerSql create temp table failure %d",
-                 status );
-        _rollback( "chlModAccessControl" );
-        return ERROR( status, "chlModAccessControl cmlExecuteNoAnswerSql create temp table failure" );
-    }
-
-    status =  cmlExecuteNoAnswerSql( "create unique index idx_r_mod_access_temp1 on R_MOD_ACCESS_TEMP1 (coll_name)",
-                                     &icss );
-    if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
-        status = 0;
-    }
-    if ( status != 0 ) {
-        rodsLog( LOG_NOTICE,
-                 "chlModAccessControl cmlExecuteNoAnswerSql create index failure %d",
-                 status );
-        _rollback( "chlModAccessControl" );
-        return ERROR( status, "chlModAccessControl cmlExecuteNoAnswerSql create index failure" );
-    }
-
-    cllBindVars[cllBindVarCount++] = _path_name;
-    cllBindVars[cllBindVarCount++] = pathStart.c_str();
-    status =  cmlExecuteNoAnswerSql( "insert into R_MOD_ACCESS_TEMP1 (coll_id, coll_name) select  coll_id, coll_name from R_COLL_MAIN where coll_name = ? or coll_name like ?",
-                                     &icss );
-    if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
-        status = 0;
-    }
-    if ( status != 0 ) {
-        rodsLog( LOG_NOTICE,
-                 "chlModAccessControl cmlExecuteNoAnswerSql insert failure %d",
-                 status );
-        _rollback( "chlModAccessControl" );
-        return ERROR( status, "chlModAccessControl cmlExecuteNoAnswerSql insert failure" );
-    }
-#endif
-
+    /* The collection and the collections below it are found through
+       R_COLL_HIERARCHY, which is indexed by ancestor, so the cost of these
+       statements depends on the size of the subtree rather than on the
+       number of collections in the zone. */
     cllBindVars[cllBindVarCount++] = userIdStr;
-    cllBindVars[cllBindVarCount++] = _path_name;
-    cllBindVars[cllBindVarCount++] = pathStart.c_str();
+    cllBindVars[cllBindVarCount++] = collIdStr;
 
     if ( logSQL != 0 ) {
         rodsLog( LOG_SQL, "chlModAccessControl SQL 8" );
     }
-    status =  cmlExecuteNoAnswerSql(
-#if defined ORA_ICAT
-                  "delete from R_OBJT_ACCESS where user_id=? and object_id = ANY (select data_id from R_DATA_MAIN where coll_id in (select coll_id from R_COLL_MAIN where coll_name = ? or coll_name like ? ESCAPE '\\'))",
-#elif defined MY_ICAT
-                  "delete from R_OBJT_ACCESS where user_id=? and object_id = ANY (select data_id from R_DATA_MAIN where coll_id in (select coll_id from R_COLL_MAIN where coll_name = ? or coll_name like ?))",
-#else
-                  /*  Use the temporary table to greatly speed up this operation
-                  (and similar ones below).  The last constraint, the 'where
-                  coll_name = ? or coll_name like ?' isn't really needed (since
-                  that table was populated via constraints like those) but,
-                  oddly, does seem to make it run much faster.  Using 'explain'
-                  SQL and test runs confirmed that it is faster with those
-                  constraints.
-                  */
-                  "delete from R_OBJT_ACCESS where user_id=? and object_id = ANY(ARRAY(select data_id from R_DATA_MAIN where coll_id in (select coll_id from R_MOD_ACCESS_TEMP1 where coll_name = ? or coll_name like ?)))",
-#endif
-                  & icss );
+    int status =  cmlExecuteNoAnswerSql(
+                      "delete from R_OBJT_ACCESS where user_id=? and object_id in (select data_id from R_DATA_MAIN where coll_id in (select coll_id from R_COLL_HIERARCHY where ancestor_id=?))",
+                      &icss );
 
     if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
         _rollback( "chlModAccessControl" );
@@ -10583,21 +11098,14 @@ irods::error db_mod_access_control_op(
     }
 
     cllBindVars[cllBindVarCount++] = userIdStr;
-    cllBindVars[cllBindVarCount++] = _path_name;
-    cllBindVars[cllBindVarCount++] = pathStart.c_str();
+    cllBindVars[cllBindVarCount++] = collIdStr;
 
     if ( logSQL != 0 ) {
         rodsLog( LOG_SQL, "chlModAccessControl SQL 9" );
     }
     status =  cmlExecuteNoAnswerSql(
-#if defined ORA_ICAT
-                  "delete from R_OBJT_ACCESS where user_id=? and object_id = ANY (select coll_id from R_COLL_MAIN where coll_name = ? or coll_name like ? ESCAPE '\\')",
-#elif defined MY_ICAT
-                  "delete from R_OBJT_ACCESS where user_id=? and object_id = ANY (select coll_id from R_COLL_MAIN where coll_name = ? or coll_name like ?)",
-#else
-                  "delete from R_OBJT_ACCESS where user_id=? and object_id = ANY(ARRAY(select coll_id from R_MOD_ACCESS_TEMP1 where coll_name = ? or coll_name like ?))",
-#endif
-                  & icss );
+                  "delete from R_OBJT_ACCESS where user_id=? and object_id in (select coll_id from R_COLL_HIERARCHY where ancestor_id=?)",
+                  &icss );
     if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
         _rollback( "chlModAccessControl" );
         return ERROR( status, "delete failure" );
@@ -10613,24 +11121,22 @@ irods::error db_mod_access_control_op(
     cllBindVars[cllBindVarCount++] = myAccessLev;
     cllBindVars[cllBindVarCount++] = myTime;
     cllBindVars[cllBindVarCount++] = myTime;
-    cllBindVars[cllBindVarCount++] = _path_name;
-    cllBindVars[cllBindVarCount++] = pathStart.c_str();
+    cllBindVars[cllBindVarCount++] = collIdStr;
     if ( logSQL != 0 ) {
         rodsLog( LOG_SQL, "chlModAccessControl SQL 10" );
     }
 #if ORA_ICAT
     /* For Oracle cast is to integer, for Postgres to bigint,for MySQL no cast*/
     status =  cmlExecuteNoAnswerSql(
-                  "insert into R_OBJT_ACCESS (object_id, user_id, access_type_id, create_ts, modify_ts)  (select distinct data_id, cast(? as integer), (select token_id from R_TOKN_MAIN where token_namespace = 'access_type' and token_name = ?), ?, ? from R_DATA_MAIN where coll_id in (select coll_id from R_COLL_MAIN where coll_name = ? or coll_name like ? ESCAPE '\\'))",
+                  "insert into R_OBJT_ACCESS (object_id, user_id, access_type_id, create_ts, modify_ts)  (select distinct data_id, cast(? as integer), (select token_id from R_TOKN_MAIN where token_namespace = 'access_type' and token_name = ?), ?, ? from R_DATA_MAIN where coll_id in (select coll_id from R_COLL_HIERARCHY where ancestor_id=?))",
                   &icss );
 #elif MY_ICAT
     status =  cmlExecuteNoAnswerSql(
-                  "insert into R_OBJT_ACCESS (object_id, user_id, access_type_id, create_ts, modify_ts)  (select distinct data_id, ?, (select token_id from R_TOKN_MAIN where token_namespace = 'access_type' and token_name = ?), ?, ? from R_DATA_MAIN where coll_id in (select coll_id from R_COLL_MAIN where coll_name = ? or coll_name like ?))",
+                  "insert into R_OBJT_ACCESS (object_id, user_id, access_type_id, create_ts, modify_ts)  (select distinct data_id, ?, (select token_id from R_TOKN_MAIN where token_namespace = 'access_type' and token_name = ?), ?, ? from R_DATA_MAIN where coll_id in (select coll_id from R_COLL_HIERARCHY where ancestor_id=?))",
                   &icss );
 #else
-    /* For Postgres, also use the temporary R_MOD_ACCESS_TEMP1 table */
     status =  cmlExecuteNoAnswerSql(
-                  "insert into R_OBJT_ACCESS (object_id, user_id, access_type_id, create_ts, modify_ts)  (select distinct data_id, cast(? as bigint), (select token_id from R_TOKN_MAIN where token_namespace = 'access_type' and token_name = ?), ?, ? from R_DATA_MAIN where coll_id in (select coll_id from R_MOD_ACCESS_TEMP1 where coll_name = ? or coll_name like ?))",
+                  "insert into R_OBJT_ACCESS (object_id, user_id, access_type_id, create_ts, modify_ts)  (select distinct data_id, cast(? as bigint), (select token_id from R_TOKN_MAIN where token_namespace = 'access_type' and token_name = ?), ?, ? from R_DATA_MAIN where coll_id in (select coll_id from R_COLL_HIERARCHY where ancestor_id=?))",
                   &icss );
 #endif
     if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
@@ -10647,23 +11153,22 @@ irods::error db_mod_access_control_op(
     cllBindVars[cllBindVarCount++] = myAccessLev;
     cllBindVars[cllBindVarCount++] = myTime;
     cllBindVars[cllBindVarCount++] = myTime;
-    cllBindVars[cllBindVarCount++] = _path_name;
-    cllBindVars[cllBindVarCount++] = pathStart.c_str();
+    cllBindVars[cllBindVarCount++] = collIdStr;
     if ( logSQL != 0 ) {
         rodsLog( LOG_SQL, "chlModAccessControl SQL 11" );
     }
 #if ORA_ICAT
     /* For Oracle cast is to integer, for Postgres to bigint,for MySQL no cast*/
     status =  cmlExecuteNoAnswerSql(
-                  "insert into R_OBJT_ACCESS (object_id, user_id, access_type_id, create_ts, modify_ts)  (select distinct coll_id, cast(? as integer), (select token_id from R_TOKN_MAIN where token_namespace = 'access_type' and token_name = ?), ?, ? from R_COLL_MAIN where coll_name = ? or coll_name like ? ESCAPE '\\')",
+                  "insert into R_OBJT_ACCESS (object_id, user_id, access_type_id, create_ts, modify_ts)  (select distinct coll_id, cast(? as integer), (select token_id from R_TOKN_MAIN where token_namespace = 'access_type' and token_name = ?), ?, ? from R_COLL_HIERARCHY where ancestor_id=?)",
                   &icss );
 #elif MY_ICAT
     status =  cmlExecuteNoAnswerSql(
-                  "insert into R_OBJT_ACCESS (object_id, user_id, access_type_id, create_ts, modify_ts)  (select distinct coll_id, ?, (select token_id from R_TOKN_MAIN where token_namespace = 'access_type' and token_name = ?), ?, ? from R_COLL_MAIN where coll_name = ? or coll_name like ?)",
+                  "insert into R_OBJT_ACCESS (object_id, user_id, access_type_id, create_ts, modify_ts)  (select distinct coll_id, ?, (select token_id from R_TOKN_MAIN where token_namespace = 'access_type' and token_name = ?), ?, ? from R_COLL_HIERARCHY where ancestor_id=?)",
                   &icss );
 #else
     status =  cmlExecuteNoAnswerSql(
-                  "insert into R_OBJT_ACCESS (object_id, user_id, access_type_id, create_ts, modify_ts)  (select distinct coll_id, cast(? as bigint), (select token_id from R_TOKN_MAIN where token_namespace = 'access_type' and token_name = ?), ?, ? from R_COLL_MAIN where coll_name = ? or coll_name like ?)",
+                  "insert into R_OBJT_ACCESS (object_id, user_id, access_type_id, create_ts, modify_ts)  (select distinct coll_id, cast(? as bigint), (select token_id from R_TOKN_MAIN where token_namespace = 'access_type' and token_name = ?), ?, ? from R_COLL_HIERARCHY where ancestor_id=?)",
                   &icss );
 #endif
     if ( status != 0 ) {
@@ -10690,6 +11195,10 @@ irods::error db_rename_object_op(
         return PASS( ret );
     }
 
+    // tickets on a collection cover the objects under it, so a cached ticket
+    // verdict may no longer hold once this returns
+    irods::at_scope_exit invalidate_verdicts{[] { invalidate_access_verdicts(); }};
+
     // =-=-=-=-=-=-=-
     // get a postgres object from the context
     /*irods::postgres_object_ptr pg;
@@ -10713,7 +11222,7 @@ irods::error db_rename_object_op(
     char collName[MAX_NAME_LEN] = "";
     char *cVal[3];
     int iVal[3];
-    int pLen, cLen, len;
+    int pLen, cLen;
     int isRootDir = 0;
     char objIdString[MAX_NAME_LEN];
     char collIdString[MAX_NAME_LEN];
@@ -10721,8 +11230,6 @@ irods::error db_rename_object_op(
 
     char pLenStr[MAX_NAME_LEN];
     char cLenStr[MAX_NAME_LEN];
-    char collNameSlash[MAX_NAME_LEN];
-    char collNameSlashLen[20];
     char slashNewName[MAX_NAME_LEN];
 
     if ( logSQL != 0 ) {
@@ -10907,9 +11414,6 @@ irods::error db_rename_object_op(
                                                        correct, makes a difference in Oracle, and works
                                                        in postgres too. */
         snprintf( cLenStr, MAX_NAME_LEN, "%d", cLen + 1 );
-        snprintf( collNameSlash, MAX_NAME_LEN, "%s/", collName );
-        len = strlen( collNameSlash );
-        snprintf( collNameSlashLen, 10, "%d", len );
         snprintf( slashNewName, MAX_NAME_LEN, "/%s", _new_name );
         if ( isRootDir ) {
             snprintf( slashNewName, MAX_NAME_LEN, "%s", _new_name );
@@ -10917,14 +11421,12 @@ irods::error db_rename_object_op(
         cllBindVars[cllBindVarCount++] = pLenStr;
         cllBindVars[cllBindVarCount++] = slashNewName;
         cllBindVars[cllBindVarCount++] = cLenStr;
-        cllBindVars[cllBindVarCount++] = collNameSlashLen;
-        cllBindVars[cllBindVarCount++] = collNameSlash;
-        cllBindVars[cllBindVarCount++] = collName;
+        cllBindVars[cllBindVarCount++] = objIdString;
         if ( logSQL != 0 ) {
             rodsLog( LOG_SQL, "chlRenameObject SQL 9" );
         }
         status =  cmlExecuteNoAnswerSql(
-                      "update R_COLL_MAIN set coll_name = substr(coll_name,1,?) || ? || substr(coll_name, ?) where substr(parent_coll_name,1,?) = ? or parent_coll_name  = ?",
+                      "update R_COLL_MAIN set coll_name = substr(coll_name,1,?) || ? || substr(coll_name, ?) where coll_id in (select coll_id from R_COLL_HIERARCHY where ancestor_id = ? and depth > 0)",
                       &icss );
         if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
             rodsLog( LOG_NOTICE,
@@ -10938,14 +11440,12 @@ irods::error db_rename_object_op(
         cllBindVars[cllBindVarCount++] = pLenStr;
         cllBindVars[cllBindVarCount++] = slashNewName;
         cllBindVars[cllBindVarCount++] = cLenStr;
-        cllBindVars[cllBindVarCount++] = collNameSlashLen;
-        cllBindVars[cllBindVarCount++] = collNameSlash;
-        cllBindVars[cllBindVarCount++] = collName;
+        cllBindVars[cllBindVarCount++] = objIdString;
         if ( logSQL != 0 ) {
             rodsLog( LOG_SQL, "chlRenameObject SQL 10" );
         }
         status =  cmlExecuteNoAnswerSql(
-                      "update R_COLL_MAIN set parent_coll_name = substr(parent_coll_name,1,?) || ? || substr(parent_coll_name, ?) where substr(parent_coll_name,1,?) = ? or parent_coll_name  = ?",
+                      "update R_COLL_MAIN set parent_coll_name = substr(parent_coll_name,1,?) || ? || substr(parent_coll_name, ?) where coll_id in (select coll_id from R_COLL_HIERARCHY where ancestor_id = ? and depth > 0)",
                       &icss );
         if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
             rodsLog( LOG_NOTICE,
@@ -11031,6 +11531,10 @@ irods::error db_move_object_op(
         return PASS( ret );
     }
 
+    // tickets on a collection cover the objects under it, so a cached ticket
+    // verdict may no longer hold once this returns
+    irods::at_scope_exit invalidate_verdicts{[] { invalidate_access_verdicts(); }};
+
     // =-=-=-=-=-=-=-
     // get a postgres object from the context
     /*irods::postgres_object_ptr pg;
@@ -11063,14 +11567,12 @@ irods::error db_move_object_op(
     char parentTargetCollName[MAX_NAME_LEN] = "";
     char newCollName[MAX_NAME_LEN] = "";
     int pLen, ocLen;
-    int i, OK, len;
+    int i, OK;
     char *cp;
     char objIdString[MAX_NAME_LEN];
     char collIdString[MAX_NAME_LEN];
     char nameTmp[MAX_NAME_LEN];
     char ocLenStr[MAX_NAME_LEN];
-    char collNameSlash[MAX_NAME_LEN];
-    char collNameSlashLen[20];
 
     if ( logSQL != 0 ) {
         rodsLog( LOG_SQL, "chlMoveObject" );
@@ -11340,21 +11842,16 @@ irods::error db_move_object_op(
            tailing part of the name.
            (In the sql substr function, the index for sql is 1 origin.) */
         snprintf( ocLenStr, MAX_NAME_LEN, "%d", ocLen + 1 );
-        snprintf( collNameSlash, MAX_NAME_LEN, "%s/", oldCollName );
-        len = strlen( collNameSlash );
-        snprintf( collNameSlashLen, 10, "%d", len );
         cllBindVars[cllBindVarCount++] = newCollName;
         cllBindVars[cllBindVarCount++] = ocLenStr;
         cllBindVars[cllBindVarCount++] = newCollName;
         cllBindVars[cllBindVarCount++] = ocLenStr;
-        cllBindVars[cllBindVarCount++] = collNameSlashLen;
-        cllBindVars[cllBindVarCount++] = collNameSlash;
-        cllBindVars[cllBindVarCount++] = oldCollName;
+        cllBindVars[cllBindVarCount++] = objIdString;
         if ( logSQL != 0 ) {
             rodsLog( LOG_SQL, "chlMoveObject SQL 13" );
         }
         status =  cmlExecuteNoAnswerSql(
-                      "update R_COLL_MAIN set parent_coll_name = ? || substr(parent_coll_name, ?), coll_name = ? || substr(coll_name, ?) where substr(parent_coll_name,1,?) = ? or parent_coll_name = ?",
+                      "update R_COLL_MAIN set parent_coll_name = ? || substr(parent_coll_name, ?), coll_name = ? || substr(coll_name, ?) where coll_id in (select coll_id from R_COLL_HIERARCHY where ancestor_id = ? and depth > 0)",
                       &icss );
         if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
             status = 0;
@@ -11367,6 +11864,15 @@ irods::error db_move_object_op(
             return ERROR( status, "cmlExecuteNoAnswerSql update failure" );
         }
 
+        status = moveCollInHierarchy( objIdString, collIdString );
+        if ( status != 0 ) {
+            rodsLog( LOG_NOTICE,
+                     "chlMoveObject moveCollInHierarchy failure %d",
+                     status );
+            _rollback( "chlMoveObject" );
+            return ERROR( status, "moveCollInHierarchy failure" );
+        }
+
         return CODE( status );
     }
 
@@ -11959,7 +12465,6 @@ irods::error db_calc_usage_and_quota_op(
 //        icatSessionStruct icss;
 //        _ctx.prop_map().get< icatSessionStruct >( ICSS_PROP, icss );
     int status;
-    char myTime[50];
 
     if ( _ctx.comm()->clientUser.authInfo.authFlag < LOCAL_PRIV_USER_AUTH ) {
         return ERROR( CAT_INSUFFICIENT_PRIVILEGE_LEVEL, "insufficient privilege" );
@@ -11968,35 +12473,102 @@ irods::error db_calc_usage_and_quota_op(
     rodsLog( LOG_NOTICE,
              "chlCalcUsageAndQuota called" );
 
+    /*
+      The usage counters are maintained incrementally as replicas are
+      registered, modified and unregistered, so this only corrects
+      drift (e.g. from changes made outside of the server).  Rather than
+      aggregating all of R_DATA_MAIN in one statement, the data objects
+      that existed when the reconciliation started are summed in slices
+      of data ids.  The difference between the sums and the counters as
+      read at the start is then added to the counters, which preserves
+      the changes made by other agents in the meantime.  Changes to
+      existing objects in slices not yet read may be counted twice;
+      the next reconciliation corrects them.
+    */
+    const rodsLong_t sliceSize = 1000000;
+    rodsLong_t minDataId = 0;
+    rodsLong_t maxDataId = -1;
+    quotaUsageMap correction;
 
-    getNowStr( myTime );
-
-    /* Delete the old rows from R_QUOTA_USAGE */
+    /* Start from the negated counters */
     if ( logSQL != 0 ) {
         rodsLog( LOG_SQL, "chlCalcUsageAndQuota SQL 1" );
     }
-    cllBindVars[cllBindVarCount++] = myTime;
-    status =  cmlExecuteNoAnswerSql(
-                  "delete from R_QUOTA_USAGE where modify_ts < ?", &icss );
-    if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+    {
+        int statementNum = UNINITIALIZED_STATEMENT_NUMBER;
+        for ( int rowsFound = 0;; rowsFound++ ) {
+            if ( rowsFound == 0 ) {
+                status = cmlGetFirstRowFromSql( "select user_id, resc_id, sum(quota_usage) from R_QUOTA_USAGE group by user_id, resc_id",
+                                                &statementNum, 0, &icss );
+            }
+            else {
+                status = cmlGetNextRowFromStatement( statementNum, &icss );
+            }
+            if ( status != 0 ) {
+                break;
+            }
+            std::pair<std::string, std::string> key( icss.stmtPtr[statementNum]->resultValue[0],
+                                                     icss.stmtPtr[statementNum]->resultValue[1] );
+            correction[key] -= atoll( icss.stmtPtr[statementNum]->resultValue[2] );
+        }
+        cmlFreeStatement( statementNum, &icss );
+    }
+    if ( status != 0 && status != CAT_NO_ROWS_FOUND ) {
         _rollback( "chlCalcUsageAndQuota" );
-        return ERROR( status, "delete failed" );
+        return ERROR( status, "select usage failed" );
     }
 
-    /* Add a row to R_QUOTA_USAGE for each user's usage on each resource */
     if ( logSQL != 0 ) {
         rodsLog( LOG_SQL, "chlCalcUsageAndQuota SQL 2" );
     }
-    cllBindVars[cllBindVarCount++] = myTime;
-    status =  cmlExecuteNoAnswerSql(
-                  "insert into R_QUOTA_USAGE (quota_usage, resc_id, user_id, modify_ts) (select sum(R_DATA_MAIN.data_size), R_RESC_MAIN.resc_id, R_USER_MAIN.user_id, ? from R_DATA_MAIN, R_USER_MAIN, R_RESC_MAIN where R_USER_MAIN.user_name = R_DATA_MAIN.data_owner_name and R_USER_MAIN.zone_name = R_DATA_MAIN.data_owner_zone and R_RESC_MAIN.resc_id = R_DATA_MAIN.resc_id group by R_RESC_MAIN.resc_id, user_id)",
-                  &icss );
-    if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+    {
+        std::vector<std::string> emptyBindVars;
+        status = cmlGetIntegerValueFromSql( "select min(data_id) from R_DATA_MAIN",
+                                            &minDataId, emptyBindVars, &icss );
+        if ( status == 0 ) {
+            status = cmlGetIntegerValueFromSql( "select max(data_id) from R_DATA_MAIN",
+                                                &maxDataId, emptyBindVars, &icss );
+        }
+    }
+    if ( status == CAT_NO_ROWS_FOUND ) {
         status = 0;    /* no files, OK */
     }
     if ( status != 0 ) {
         _rollback( "chlCalcUsageAndQuota" );
-        return ERROR( status, "insert failed" );
+        return ERROR( status, "select data_id range failed" );
+    }
+
+    /* Add the actual usage, one slice at a time */
+    for ( rodsLong_t firstId = minDataId; firstId <= maxDataId; firstId += sliceSize ) {
+        std::vector<std::string> bindVars;
+        bindVars.push_back( std::to_string( firstId ) );
+        bindVars.push_back( std::to_string( std::min( firstId + sliceSize, maxDataId + 1 ) ) );
+        status = getReplicaQuotaUsage( "DM.data_id >= ? and DM.data_id < ?", bindVars, 1, correction );
+        if ( status != 0 ) {
+            _rollback( "chlCalcUsageAndQuota" );
+            return ERROR( status, "select usage of data objects failed" );
+        }
+    }
+
+    /* Bring the counters to the actual usage */
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "chlCalcUsageAndQuota SQL 3" );
+    }
+    status = addQuotaUsage( correction );
+    if ( status != 0 ) {
+        _rollback( "chlCalcUsageAndQuota" );
+        return ERROR( status, "update usage failed" );
+    }
+
+    /* Remove the rows of users and resources which no longer use any space */
+    if ( logSQL != 0 ) {
+        rodsLog( LOG_SQL, "chlCalcUsageAndQuota SQL 4" );
+    }
+    status = cmlExecuteNoAnswerSql(
+                 "delete from R_QUOTA_USAGE where quota_usage = 0", &icss );
+    if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+        _rollback( "chlCalcUsageAndQuota" );
+        return ERROR( status, "delete failed" );
     }
 
     /* Set the over_quota flags where appropriate */
@@ -12233,26 +12805,28 @@ irods::error db_check_quota_op(
        A single query is done which gets the four possible types of quotas
        for this user on this resource (and ordered so the first row is the
        result).  The types of quotas are: user per-resource, user global,
-       group per-resource, and group global.
+       group per-resource, and group global.  Since the over_quota values
+       are kept current as usage changes, this is all that is needed; as
+       every user is a member of its own group, the user's quotas are
+       found through R_USER_GROUP along with those of its groups.
     */
     int status;
     int statementNum = UNINITIALIZED_STATEMENT_NUMBER;
 
-    char mySQL[] = "select distinct QM.user_id, QM.resc_id, QM.quota_limit, QM.quota_over from R_QUOTA_MAIN QM, R_USER_MAIN UM, R_RESC_MAIN RM, R_USER_GROUP UG, R_USER_MAIN UM2 where ( (QM.user_id = UM.user_id and UM.user_name = ?) or (QM.user_id = UG.group_user_id and UM2.user_name = ? and UG.user_id = UM2.user_id) ) and ((QM.resc_id = RM.resc_id and RM.resc_name = ?) or QM.resc_id = '0') order by quota_over desc";
+    char mySQL[] = "select QM.user_id, QM.resc_id, QM.quota_limit, QM.quota_over from R_QUOTA_MAIN QM where QM.user_id in (select UG.group_user_id from R_USER_GROUP UG, R_USER_MAIN UM where UG.user_id = UM.user_id and UM.user_name = ?) and (QM.resc_id in (select resc_id from R_RESC_MAIN where resc_name = ?) or QM.resc_id = '0') order by quota_over desc";
 
     *_user_quota = 0;
     if ( logSQL != 0 ) {
         rodsLog( LOG_SQL, "chlCheckQuota SQL 1" );
     }
     cllBindVars[cllBindVarCount++] = _user_name;
-    cllBindVars[cllBindVarCount++] = _user_name;
     cllBindVars[cllBindVarCount++] = _resc_name;
 
     status = cmlGetFirstRowFromSql( mySQL, &statementNum,
                                     0, &icss );
 
     if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
-        rodsLog( LOG_NOTICE,
+        rodsLog( LOG_DEBUG,
                  "chlCheckQuota - CAT_SUCCESS_BUT_WITH_NO_INFO" );
         *_quota_status = QUOTA_UNRESTRICTED;
         cmlFreeStatement(statementNum, &icss);
@@ -12260,7 +12834,7 @@ irods::error db_check_quota_op(
     }
 
     if ( status == CAT_NO_ROWS_FOUND ) {
-        rodsLog( LOG_NOTICE,
+        rodsLog( LOG_DEBUG,
                  "chlCheckQuota - CAT_NO_ROWS_FOUND" );
         *_quota_status = QUOTA_UNRESTRICTED;
         cmlFreeStatement(statementNum, &icss);
@@ -12273,7 +12847,7 @@ irods::error db_check_quota_op(
     }
 
     /* For now, log it */
-    rodsLog( LOG_NOTICE, "checkQuota: inUser:%s inResc:%s RescId:%s Quota:%s",
+    rodsLog( LOG_DEBUG, "checkQuota: inUser:%s inResc:%s RescId:%s Quota:%s",
              _user_name, _resc_name,
              icss.stmtPtr[statementNum]->resultValue[1],  /* resc_id column */
              icss.stmtPtr[statementNum]->resultValue[3] ); /* quota_over column */
@@ -13637,6 +14211,7 @@ irods::error db_get_repl_list_for_leaf_bundles_op(
     size_t                      _child_index,
     const std::vector<leaf_bundle_t>* _bundles,
     const std::string*          _invocation_timestamp,
+    rodsLong_t                  _data_id_lower_bound,
     dist_child_result_t*        _results ) {
 
     // =-=-=-=-=-=-=-
@@ -13686,25 +14261,27 @@ irods::error db_get_repl_list_for_leaf_bundles_op(
     }
     not_child_array.pop_back(); // trim last ','
 
+    // results are ordered by data id so that callers can page through them
+    // by passing the last data id seen as the lower bound of the next call
 #ifdef ORA_ICAT
-    const std::string query = (boost::format("select data_id from (select distinct data_id from R_DATA_MAIN where data_id in (select data_id from R_DATA_MAIN where resc_id in (%s)) and data_id not in (select data_id from R_DATA_MAIN where resc_id in (%s)) and modify_ts <= '%s') where rownum <= %d") % not_child_array % child_array % _invocation_timestamp->c_str() % _count).str();
+    const std::string query = (boost::format("select data_id from (select distinct data_id from R_DATA_MAIN where data_id > %lld and data_id in (select data_id from R_DATA_MAIN where resc_id in (%s)) and data_id not in (select data_id from R_DATA_MAIN where resc_id in (%s)) and modify_ts <= '%s' order by data_id) where rownum <= %d") % _data_id_lower_bound % not_child_array % child_array % _invocation_timestamp->c_str() % _count).str();
 #elif MY_ICAT
     /* MySQL (MariaDB doesn't get 'except' until v10.3)*/
     const std::string query = (boost::format(
         "select distinct data_id from R_DATA_MAIN "
-        "  where resc_id in (%s) and data_id not in ( "
+        "  where data_id > %lld and resc_id in (%s) and data_id not in ( "
         "    select data_id from R_DATA_MAIN "
         "      where resc_id in (%s) "
-        "  ) and modify_ts <= '%s' limit %d") % not_child_array % child_array % _invocation_timestamp->c_str() % _count).str();
+        "  ) and modify_ts <= '%s' order by data_id limit %d") % _data_id_lower_bound % not_child_array % child_array % _invocation_timestamp->c_str() % _count).str();
 #else
     /* Postgres */
     const std::string query = (boost::format(
         "select distinct data_id from R_DATA_MAIN "
-        "  where resc_id in (%s) and modify_ts <= '%s' "
+        "  where data_id > %lld and resc_id in (%s) and modify_ts <= '%s' "
         "except "
         "  select data_id from R_DATA_MAIN "
         "    where resc_id in (%s) "
-        "limit %d") % not_child_array % _invocation_timestamp->c_str() % child_array % _count).str();
+        "order by data_id limit %d") % _data_id_lower_bound % not_child_array % _invocation_timestamp->c_str() % child_array % _count).str();
 #endif
 
     _results->reserve(_count);
@@ -13849,6 +14426,9 @@ irods::error db_mod_ticket_op(
         return PASS( ret );
     }
 
+    // cached access verdicts may no longer hold once this returns
+    irods::at_scope_exit invalidate_verdicts{[] { invalidate_access_verdicts(); }};
+
     // =-=-=-=-=-=-=-
     // get a postgres object from the context
     /*irods::postgres_object_ptr pg;
@@ -14868,6 +15448,10 @@ irods::database* plugin_factory(
         DATABASE_OP_UNREG_REPLICA,
         function<error(plugin_context&,dataObjInfo_t*,keyValPair_t*)>(
             db_unreg_replica_op ) );
+    pg->add_operation<const std::vector<rodsLong_t>*,keyValPair_t*>(
+        DATABASE_OP_UNREG_DATA_OBJS,
+        function<error(plugin_context&,const std::vector<rodsLong_t>*,keyValPair_t*)>(
+            db_unreg_data_objs_op ) );
     pg->add_operation<ruleExecSubmitInp_t*>(
         DATABASE_OP_REG_RULE_EXEC,
         function<error(plugin_context&,ruleExecSubmitInp_t*)>(
@@ -15156,9 +15740,9 @@ irods::database* plugin_factory(
         DATABASE_OP_GET_DISTINCT_DATA_OBJS_MISSING_FROM_CHILD_GIVEN_PARENT,
         function<error(plugin_context&,const string*, const string*, int, dist_child_result_t*)>(
             db_get_distinct_data_objs_missing_from_child_given_parent_op ) );
-    pg->add_operation<rodsLong_t,size_t,const std::vector<leaf_bundle_t>*,const std::string*,dist_child_result_t*>(
+    pg->add_operation<rodsLong_t,size_t,const std::vector<leaf_bundle_t>*,const std::string*,rodsLong_t,dist_child_result_t*>(
         DATABASE_OP_GET_REPL_LIST_FOR_LEAF_BUNDLES,
-        function<error(plugin_context&,rodsLong_t,size_t,const std::vector<leaf_bundle_t>*,const std::string*,dist_child_result_t*)>(
+        function<error(plugin_context&,rodsLong_t,size_t,const std::vector<leaf_bundle_t>*,const std::string*,rodsLong_t,dist_child_result_t*)>(
             db_get_repl_list_for_leaf_bundles_op));
     pg->add_operation<const rodsLong_t>(
         DATABASE_OP_CHECK_PERMISSION_TO_MODIFY_DATA_OBJECT,
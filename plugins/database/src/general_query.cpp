@@ -33,6 +33,7 @@
 
 #include <string>
 #include <algorithm>
+#include <vector>
 
 extern int logSQLGenQuery;
 
@@ -909,6 +910,91 @@ handleMultiCollAVUConditions( int nConditions ) {
     }
 }
 
+/*
+ Rewrite the 2nd through Nth AVU conditions on data objects or
+ collections (an attribute name condition and the conditions on the
+ value, units, etc. that directly follow it) into a subquery each:
+   <objectIdColumn> in (select object_id ... where <conditions>)
+ Each subquery looks up the matching AVUs and their objects through
+ the indexes on R_META_MAIN and R_OBJT_METAMAP, and the database
+ intersects the results, instead of planning a join with another pair
+ of those tables per condition.  The first condition stays joined so
+ that its AVU columns can be selected.  The conditions keep their
+ place in whereSQL, so the bind variables keep their order.
+ Returns 1 if done, or 0 if the conditions are not grouped that way,
+ in which case handleMultiDataAVUConditions or
+ handleMultiCollAVUConditions is used.
+ */
+int
+rewriteMultiAVUConditions( genQueryInp_t *genQueryInp,
+                           const std::vector<int>& condStart,
+                           const std::vector<int>& condEnd,
+                           int nameColumn,
+                           const char *prefix,
+                           const char *objectIdColumn ) {
+    std::vector<std::pair<int, int> > groups; /* first and last condition */
+
+    for ( int i = 0; i < genQueryInp->sqlCondInp.len; i++ ) {
+        int col = genQueryInp->sqlCondInp.inx[i];
+        if ( col == nameColumn ) {
+            groups.push_back( std::make_pair( i, i ) );
+        }
+        else if ( col > nameColumn && col < nameColumn + 10 ) {
+            if ( groups.empty() || groups.back().second != i - 1 ) {
+                return 0;
+            }
+            groups.back().second = i;
+        }
+    }
+    if ( groups.size() < 2 ) {
+        return 0;
+    }
+
+    char aliasMain[NAME_LEN];
+    snprintf( aliasMain, sizeof aliasMain, "%s_meta_main.", prefix );
+
+    std::string newWhere( whereSQL, condStart[groups[1].first] );
+    for ( size_t g = 1; g < groups.size(); g++ ) {
+        std::string conditions( whereSQL + condStart[groups[g].first],
+                                condEnd[groups[g].second] - condStart[groups[g].first] );
+        boost::algorithm::trim_left( conditions );
+        if ( boost::algorithm::starts_with( conditions, "AND" ) ) {
+            conditions.erase( 0, 3 );
+        }
+
+        char aliasMap[NAME_LEN];
+        char aliasMeta[NAME_LEN];
+        snprintf( aliasMap, sizeof aliasMap, "%s_metamap%d", prefix, ( int )g + 1 );
+        snprintf( aliasMeta, sizeof aliasMeta, "%s_meta_mn%2.2d", prefix, ( int )g + 1 );
+        boost::algorithm::replace_all( conditions, aliasMain, std::string( aliasMeta ) + "." );
+
+        newWhere += " AND ";
+        newWhere += objectIdColumn;
+        newWhere += " in (select ";
+        newWhere += aliasMap;
+        newWhere += ".object_id from R_OBJT_METAMAP ";
+        newWhere += aliasMap;
+        newWhere += ", R_META_MAIN ";
+        newWhere += aliasMeta;
+        newWhere += " where ";
+        newWhere += aliasMap;
+        newWhere += ".meta_id = ";
+        newWhere += aliasMeta;
+        newWhere += ".meta_id AND";
+        newWhere += conditions;
+        newWhere += ") ";
+
+        int nextStart = ( g + 1 < groups.size() ) ? condStart[groups[g + 1].first] : ( int )strlen( whereSQL );
+        newWhere.append( whereSQL + condEnd[groups[g].second], nextStart - condEnd[groups[g].second] );
+    }
+
+    if ( newWhere.size() >= MAX_SQL_SIZE_GQ ) {
+        return 0;
+    }
+    snprintf( whereSQL, MAX_SQL_SIZE_GQ, "%s", newWhere.c_str() );
+    return 1;
+}
+
 /*
  Check if this is a compound condition, that is if there is a && or ||
  outside of single quotes.  Previously the corresponding test was just
@@ -1449,6 +1535,31 @@ addBetweenClauseToWhere( char *inArg ) {
     return 0;
 }
 
+/*
+ Return whether the condition just added to whereSQL selects the
+ collections below a collection, i.e. is "R_COLL_MAIN.coll_name like
+ 'parent/%'" where parent has no wildcards.
+ */
+static bool
+isCollectionSubtreeCondition( const char *condition, const char *bindVar ) {
+    const char *column = "R_COLL_MAIN.coll_name";
+    int whereLen = strlen( whereSQL );
+    int columnLen = strlen( column );
+    int bindLen = strlen( bindVar );
+
+    if ( strcmp( condition, " like " ) != 0 ) {
+        return false;
+    }
+    if ( whereLen < columnLen + 1 || whereSQL[whereLen - columnLen - 1] != ' ' ||
+            strcmp( whereSQL + whereLen - columnLen, column ) != 0 ) {
+        return false;
+    }
+    if ( bindLen < 3 || strcmp( bindVar + bindLen - 2, "/%" ) != 0 ) {
+        return false;
+    }
+    return strcspn( bindVar, "%_\\" ) == ( size_t )( bindLen - 1 );
+}
+
 /*
 insert a new where clause using bind-variables
  */
@@ -1590,6 +1701,14 @@ insertWhere( char *condition, int option ) {
                 return ( status );   // JMC - backport 4848
             }
         }
+        else if ( isCollectionSubtreeCondition( myCondition, thisBindVar ) ) {
+            /* Replace "R_COLL_MAIN.coll_name like 'parent/%'" with a lookup
+               of the collections below parent in R_COLL_HIERARCHY; the
+               collection names need not be scanned for the prefix. */
+            whereSQL[strlen( whereSQL ) - strlen( "R_COLL_MAIN.coll_name" )] = '\0';
+            thisBindVar[strlen( thisBindVar ) - 2] = '\0';
+            if ( !rstrcat( whereSQL, "R_COLL_MAIN.coll_id in (select CH.coll_id from R_COLL_HIERARCHY CH, R_COLL_MAIN CA where CA.coll_name = ? and CH.ancestor_id = CA.coll_id and CH.depth > 0) ", MAX_SQL_SIZE_GQ ) ) { return USER_STRLEN_TOOLONG; }
+        }
         else {
             tmpStr[i++] = '?';
             tmpStr[i++] = ' ';
@@ -1894,6 +2013,8 @@ generateSQL( genQueryInp_t genQueryInp, char *resultingSQL,
     }
 
     handleCompoundCondition( "", -1 ); /* reinitialize */
+    std::vector<int> condStart( genQueryInp.sqlCondInp.len );
+    std::vector<int> condEnd( genQueryInp.sqlCondInp.len );
     for ( i = 0; i < genQueryInp.sqlCondInp.len; i++ ) {
         int prevWhereLen;
         int castOption;
@@ -1955,7 +2076,8 @@ generateSQL( genQueryInp_t genQueryInp, char *resultingSQL,
                 return status;
             }
         }
-
+        condStart[i] = prevWhereLen;
+        condEnd[i] = strlen( whereSQL );
     }
 
     keepVal = tScan( startingTable, -1 );
@@ -1969,12 +2091,21 @@ generateSQL( genQueryInp_t genQueryInp, char *resultingSQL,
         }
     }
 
+    /* A rewrite moves the conditions after it, so do at most one */
+    int avuRewritten = 0;
     if ( N_col_meta_data_attr_name > 1 ) {
+        avuRewritten = rewriteMultiAVUConditions( &genQueryInp, condStart, condEnd,
+                       COL_META_DATA_ATTR_NAME, "r_data", "R_DATA_MAIN.data_id" );
+    }
+    if ( N_col_meta_data_attr_name > 1 && !avuRewritten ) {
         /* Make some special changes & additions for multi AVU query - data */
         handleMultiDataAVUConditions( N_col_meta_data_attr_name );
     }
 
-    if ( N_col_meta_coll_attr_name > 1 ) {
+    if ( N_col_meta_coll_attr_name > 1 &&
+            ( avuRewritten ||
+              !rewriteMultiAVUConditions( &genQueryInp, condStart, condEnd,
+                                          COL_META_COLL_ATTR_NAME, "r_coll", "R_COLL_MAIN.coll_id" ) ) ) {
         /* Make some special changes & additions for multi AVU query - collections */
         handleMultiCollAVUConditions( N_col_meta_coll_attr_name );
     }
@@ -25,6 +25,7 @@ drop table R_RULE_DVM_MAP;
 drop table R_RULE_FNM_MAP;
 drop table R_QUOTA_MAIN;
 drop table R_QUOTA_USAGE;
+drop table R_COLL_HIERARCHY;
 drop table R_MICROSRVC_MAIN;
 drop table R_MICROSRVC_VER;
 drop table R_SPECIFIC_QUERY;
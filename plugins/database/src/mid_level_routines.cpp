@@ -19,6 +19,7 @@
 #include "irods_stacktrace.hpp"
 #include "irods_log.hpp"
 #include "irods_virtual_path.hpp"
+#include "access_verdict_cache.hpp"
 
 #include "rcMisc.h"
 
@@ -32,6 +33,8 @@
 
 extern int logSQL_CML;
 
+namespace avc = irods::experimental::access_verdict_cache;
+
 int checkObjIdByTicket( const char *dataId, const char *accessLevel,
                         const char *ticketStr, const char *ticketHost,
                         const char *userName, const char *userZone,
@@ -916,16 +919,39 @@ cmlCheckDirAndGetInheritFlag( const char *dirName, const char *userName, const c
                                         cVal, cValSize, 2, bindVars, icss );
     }
     else {
-        if ( logSQL_CML != 0 ) {
-            rodsLog( LOG_SQL, "cmlCheckDirAndGetInheritFlag SQL 2 " );
+        const auto subject = avc::user_subject( userName, userZone );
+        const auto generation = avc::generation();
+        bool granted = false;
+
+        if ( avc::enabled() ) {
+            /* Looking up the collection alone is cheap; reuse a recent
+               verdict for its id instead of joining the access tables. */
+            if ( logSQL_CML != 0 ) {
+                rodsLog( LOG_SQL, "cmlCheckDirAndGetInheritFlag SQL 4 " );
+            }
+            std::vector<std::string> bindVars;
+            bindVars.push_back( dirName );
+            status = cmlGetOneRowFromSqlBV( "select coll_id, coll_inheritance from R_COLL_MAIN where coll_name=?",
+                                            cVal, cValSize, 2, bindVars, icss );
+            granted = status == 2 && *cVal[0] != '\0' &&
+                      avc::contains( { subject, strtoll( cValStr1, NULL, 0 ), accessLevel } );
+        }
+
+        if ( !granted ) {
+            if ( logSQL_CML != 0 ) {
+                rodsLog( LOG_SQL, "cmlCheckDirAndGetInheritFlag SQL 2 " );
+            }
+            std::vector<std::string> bindVars;
+            bindVars.push_back( dirName );
+            bindVars.push_back( userName );
+            bindVars.push_back( userZone );
+            bindVars.push_back( accessLevel );
+            status = cmlGetOneRowFromSqlBV( "select coll_id, coll_inheritance from R_COLL_MAIN CM, R_OBJT_ACCESS OA, R_USER_GROUP UG, R_USER_MAIN UM, R_TOKN_MAIN TM where CM.coll_name=? and UM.user_name=? and UM.zone_name=? and UM.user_type_name!='rodsgroup' and UM.user_id = UG.user_id and OA.object_id = CM.coll_id and UG.group_user_id = OA.user_id and OA.access_type_id >= TM.token_id and  TM.token_namespace ='access_type' and TM.token_name = ?",
+                                            cVal, cValSize, 2, bindVars, icss );
+            if ( status == 2 && *cVal[0] != '\0' ) {
+                avc::insert( { subject, strtoll( cValStr1, NULL, 0 ), accessLevel }, generation );
+            }
         }
-        std::vector<std::string> bindVars;
-        bindVars.push_back( dirName );
-        bindVars.push_back( userName );
-        bindVars.push_back( userZone );
-        bindVars.push_back( accessLevel );
-        status = cmlGetOneRowFromSqlBV( "select coll_id, coll_inheritance from R_COLL_MAIN CM, R_OBJT_ACCESS OA, R_USER_GROUP UG, R_USER_MAIN UM, R_TOKN_MAIN TM where CM.coll_name=? and UM.user_name=? and UM.zone_name=? and UM.user_type_name!='rodsgroup' and UM.user_id = UG.user_id and OA.object_id = CM.coll_id and UG.group_user_id = OA.user_id and OA.access_type_id >= TM.token_id and  TM.token_namespace ='access_type' and TM.token_name = ?",
-                                        cVal, cValSize, 2, bindVars, icss );
     }
     if ( status == 2 ) {
         if ( *cVal[0] == '\0' ) {
@@ -984,6 +1010,13 @@ cmlCheckDirId( const char *dirId, const char *userName, const char *userZone,
     int status;
     rodsLong_t iVal;
 
+    const auto subject = avc::user_subject( userName, userZone );
+    const avc::key verdict{ subject, strtoll( dirId, NULL, 0 ), accessLevel };
+    const auto generation = avc::generation();
+    if ( avc::contains( verdict ) ) {
+        return 0;
+    }
+
     if ( logSQL_CML != 0 ) {
         rodsLog( LOG_SQL, "cmlCheckDirId S-Q-L 1 " );
     }
@@ -1015,6 +1048,8 @@ cmlCheckDirId( const char *dirId, const char *userName, const char *userZone,
         return CAT_NO_ACCESS_PERMISSION;
     }
 
+    avc::insert( verdict, generation );
+
     return 0;
 }
 
@@ -1057,6 +1092,30 @@ cmlCheckDataObjOnly( const char *dirName, const char *dataName,
     int status;
     rodsLong_t iVal{};
 
+    const auto subject = avc::user_subject( userName, userZone );
+    const auto generation = avc::generation();
+
+    if ( avc::enabled() ) {
+        /* Looking up the data object alone is cheap; reuse a recent
+           verdict for its id instead of joining the access tables. */
+        if ( logSQL_CML != 0 ) {
+            rodsLog( LOG_SQL, "cmlCheckDataObjOnly SQL 3 " );
+        }
+
+        std::vector<std::string> bindVars;
+        bindVars.push_back( dataName );
+        bindVars.push_back( dirName );
+        status = cmlGetIntegerValueFromSql(
+                     "select data_id from R_DATA_MAIN DM, R_COLL_MAIN CM where DM.data_name=? and DM.coll_id=CM.coll_id and CM.coll_name=?",
+                     &iVal, bindVars, icss );
+        if ( status ) {
+            return CAT_UNKNOWN_FILE;
+        }
+        if ( avc::contains( { subject, iVal, accessLevel } ) ) {
+            return iVal;
+        }
+    }
+
     if ( logSQL_CML != 0 ) {
         rodsLog( LOG_SQL, "cmlCheckDataObjOnly SQL 1 " );
     }
@@ -1090,6 +1149,8 @@ cmlCheckDataObjOnly( const char *dirName, const char *dataName,
         return CAT_NO_ACCESS_PERMISSION;
     }
 
+    avc::insert( { subject, iVal, accessLevel }, generation );
+
     return iVal;
 
 }
@@ -1320,6 +1381,13 @@ int checkObjIdByTicket( const char *dataId, const char *accessLevel,
                         const char *userName, const char *userZone,
                         icatSessionStruct *icss ) {
 
+    const auto subject = avc::ticket_subject( ticketStr, ticketHost ? ticketHost : "", userName, userZone );
+    const avc::key verdict{ subject, strtoll( dataId, NULL, 0 ), accessLevel };
+    const auto generation = avc::generation();
+    if ( avc::contains( verdict ) ) {
+        return 0;
+    }
+
     char original_collection_name[MAX_NAME_LEN];
     std::vector<std::string> bindVars;
     bindVars.push_back( dataId );
@@ -1517,6 +1585,11 @@ int checkObjIdByTicket( const char *dataId, const char *accessLevel,
         }
         previousDataId2 = intDataId;
     }
+
+    /* Tickets that count their uses have to be checked on every access */
+    if ( iUsesLimit <= 0 && iWriteFileLimit <= 0 && iWriteByteLimit <= 0 ) {
+        avc::insert( verdict, generation, atoll( ticketExpiry ) );
+    }
     return 0;
 }
 
@@ -1636,6 +1709,13 @@ int cmlCheckDataObjId( const char *dataId, const char *userName,  const char *zo
         }
     }
     else {
+        const auto subject = avc::user_subject( userName, zoneName );
+        const avc::key verdict{ subject, strtoll( dataId, NULL, 0 ), accessLevel };
+        const auto generation = avc::generation();
+        if ( avc::contains( verdict ) ) {
+            return 0;
+        }
+
         if ( logSQL_CML != 0 ) {
             rodsLog( LOG_SQL, "cmlCheckDataObjId SQL 1 " );
         }
@@ -1652,6 +1732,9 @@ int cmlCheckDataObjId( const char *dataId, const char *userName,  const char *zo
         if ( iVal == 0 ) {
             return CAT_NO_ACCESS_PERMISSION;
         }
+        if ( status == 0 ) {
+            avc::insert( verdict, generation );
+        }
     }
     if ( status != 0 ) {
         return CAT_NO_ACCESS_PERMISSION;
@@ -0,0 +1,118 @@
+/// \file
+
+#include "irods_ms_plugin.hpp"
+#include "irods_re_structs.hpp"
+#include "msParam.h"
+#include "rodsErrorTable.h"
+#include "rs_catalog_export.hpp"
+#include "irods_error.hpp"
+#include "irods_logger.hpp"
+
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <exception>
+
+namespace
+{
+    using log = irods::experimental::log;
+
+    auto to_string(msParam_t& _p) -> const char*
+    {
+        const auto* s = parseMspForStr(&_p);
+
+        if (!s) {
+            THROW(SYS_INVALID_INPUT_PARAM, "Failed to convert microservice argument to string.");
+        }
+
+        return s;
+    }
+
+    auto msi_impl(msParam_t* _json_input, msParam_t* _json_output, ruleExecInfo_t* _rei) -> int
+    {
+        if (!_json_input || !_json_output) {
+            log::microservice::error("Invalid input argument.");
+            return SYS_INVALID_INPUT_PARAM;
+        }
+
+        try {
+            const auto* json_input = to_string(*_json_input);
+            char* json_output{};
+
+            const auto ec = rs_catalog_export(_rei->rsComm, json_input, &json_output);
+
+            // The output describes the error on failure, so it is returned either way.
+            if (json_output) {
+                fillStrInMsParam(_json_output, json_output);
+                std::free(json_output);
+            }
+
+            if (ec != 0) {
+                log::microservice::error("Failed to export catalog [error_code={}]", ec);
+            }
+
+            return ec;
+        }
+        catch (const irods::exception& e) {
+            log::microservice::error("{} [error_code={}]", e.what(), e.code());
+            return e.code();
+        }
+        catch (const std::exception& e) {
+            log::microservice::error(e.what());
+            return SYS_INTERNAL_ERR;
+        }
+        catch (...) {
+            log::microservice::error("An unknown error occurred while processing the request.");
+            return SYS_UNKNOWN_ERROR;
+        }
+    }
+
+    template <typename... Args, typename Function>
+    auto make_msi(const std::string& _name, Function _func) -> irods::ms_table_entry*
+    {
+        auto* msi = new irods::ms_table_entry{sizeof...(Args)};
+        msi->add_operation<Args..., ruleExecInfo_t*>(_name, std::function<int(Args..., ruleExecInfo_t*)>(_func));
+        return msi;
+    }
+} // anonymous namespace
+
+extern "C"
+auto plugin_factory() -> irods::ms_table_entry*
+{
+    return make_msi<msParam_t*, msParam_t*>("msi_catalog_export", msi_impl);
+}
+
+#ifdef IRODS_FOR_DOXYGEN
+/// \brief Writes a consistent snapshot of catalog tables to a columnar zip archive.
+///
+/// The file is written by the catalog service provider, to a path on its local filesystem.
+/// Requires rodsadmin level privileges. See rc_catalog_export() for the file format.
+///
+/// \p _json_input must have the following JSON structure:
+/// \code{.js}
+/// {
+///   "output_path": string,
+///   "tables": [string],
+///   "number_of_threads": integer,
+///   "rows_per_row_group": integer,
+///   "overwrite": boolean
+/// }
+/// \endcode
+///
+/// Only \p output_path is required.
+///
+/// On success, \p _json_output holds the number of rows exported per table, in total and per
+/// second. On error, it holds an object with an \p error_message.
+///
+/// \param[in]     _json_input  A JSON string describing the export.
+/// \param[in,out] _json_output A JSON string describing the result.
+/// \param[in,out] _rei         A ::RuleExecInfo object that is automatically handled by the
+///                             rule engine plugin framework. Users must ignore this parameter.
+///
+/// \return An integer.
+/// \retval 0        On success.
+/// \retval non-zero On failure.
+///
+/// \since 4.3.0
+auto msi_catalog_export(msParam_t* _json_input, msParam_t* _json_output, ruleExecInfo_t* _rei) -> int;
+#endif // IRODS_FOR_DOXYGEN
@@ -1933,6 +1933,8 @@ void replace_archive_for_replica(
     get_archive(ctx, arch_resc);
     std::string archive_resc_name{};
     arch_resc->get_property<std::string>(irods::RESOURCE_NAME, archive_resc_name);
+    rodsLong_t archive_resc_id{};
+    arch_resc->get_property<rodsLong_t>(irods::RESOURCE_ID, archive_resc_id);
 
     irods::file_object_ptr file_obj = boost::dynamic_pointer_cast<irods::file_object>(ctx.fco());
     for (auto& r : file_obj->replicas()) {
@@ -1943,7 +1945,7 @@ void replace_archive_for_replica(
             voted_hier.str().c_str(),
             r.resc_hier().c_str(),
             archive_resc_name.c_str());
-        if (irods::hierarchy_parser{r.resc_hier()}.last_resc() == archive_resc_name) {
+        if (r.resc_id() == archive_resc_id) {
             r.resc_hier(voted_hier.str());
             break;
         }
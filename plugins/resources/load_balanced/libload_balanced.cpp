@@ -16,6 +16,7 @@
 #include "irods_resource_redirect.hpp"
 #include "irods_stacktrace.hpp"
 #include "irods_kvp_string_parser.hpp"
+#include "server_load_table.hpp"
 
 // =-=-=-=-=-=-=-
 // stl includes
@@ -23,6 +24,9 @@
 #include <sstream>
 #include <vector>
 #include <string>
+#include <chrono>
+#include <limits>
+#include <algorithm>
 
 // =-=-=-=-=-=-=-
 // boost includes
@@ -40,6 +44,25 @@ const std::string DEFER_POLICY_KEY( "defer_policy" );
 /// @brief string specifying the prefer localhost deferral policy
 const std::string DEFER_POLICY_LOCALHOST( "localhost_defer_policy" );
 
+/// =-=-=-=-=-=-=-
+/// @brief key for the source of the load information.  the live samples
+///        published by the servers are used unless the catalog is requested
+const std::string LOAD_SOURCE_KEY( "load_source" );
+const std::string LOAD_SOURCE_CATALOG( "catalog" );
+
+/// =-=-=-=-=-=-=-
+/// @brief keys for the weights applied to each metric of a live load sample
+const std::string AGENT_WEIGHT_KEY( "agent_weight" );
+const std::string IO_WEIGHT_KEY( "io_weight" );
+const std::string QUEUE_WEIGHT_KEY( "queue_weight" );
+const std::string FREE_SPACE_WEIGHT_KEY( "free_space_weight" );
+const double      DEFAULT_LOAD_WEIGHT = 1.0;
+
+/// =-=-=-=-=-=-=-
+/// @brief key for the age in seconds beyond which a live load sample is ignored
+const std::string MAX_SAMPLE_AGE_KEY( "max_sample_age_in_seconds" );
+const int         DEFAULT_MAX_SAMPLE_AGE = 60;
+
 /// =-=-=-=-=-=-=-
 /// @brief Check the general parameters passed in to most plugin functions
 template< typename DEST_TYPE >
@@ -692,13 +715,11 @@ irods::error get_load_lists(
 
 
 /// =-=-=-=-=-=-=-
-/// @brief
-irods::error load_balanced_redirect_for_create_operation(
+/// @brief select the child with the lowest load recorded in the catalog
+///        by the server monitoring rules
+irods::error select_child_by_catalog_load(
     irods::plugin_context& _ctx,
-    const std::string*              _opr,
-    const std::string*              _curr_host,
-    irods::hierarchy_parser*        _out_parser,
-    float*                          _out_vote ) {
+    irods::resource_ptr&   _selected_resource ) {
     // =-=-=-=-=-=-=-
     // capture the name, time and load lists from the DB
     std::vector< std::string > names;
@@ -731,7 +752,6 @@ irods::error load_balanced_redirect_for_create_operation(
 
     bool resc_found = false;
 
-    irods::resource_ptr selected_resource;
     irods::resource_child_map::iterator itr = cmap_ref->begin();
     for ( ; itr != cmap_ref->end(); ++itr ) {
         // =-=-=-=-=-=-=-
@@ -755,7 +775,7 @@ irods::error load_balanced_redirect_for_create_operation(
                         ( time_now - times[ i ] ) < MAX_ELAPSE_TIME ) {
                     resc_found = true;
                     min_load = loads[i];
-                    selected_resource = resc;
+                    _selected_resource = resc;
                 }
 
             } // if match
@@ -772,6 +792,136 @@ irods::error load_balanced_redirect_for_create_operation(
                    "failed to find child resc in load list" );
     }
 
+    return SUCCESS();
+
+} // select_child_by_catalog_load
+
+/// =-=-=-=-=-=-=-
+/// @brief fetch a load weight from the property map, falling back to the
+///        default weight if it was not configured
+double get_load_weight(
+    irods::plugin_context& _ctx,
+    const std::string&     _key ) {
+    double weight = DEFAULT_LOAD_WEIGHT;
+    if ( !_ctx.prop_map().get< double >( _key, weight ).ok() ) {
+        return DEFAULT_LOAD_WEIGHT;
+    }
+
+    return weight;
+
+} // get_load_weight
+
+/// =-=-=-=-=-=-=-
+/// @brief select the child with the lowest weighted load according to the
+///        live samples published by the servers hosting the children.
+///        each metric is normalized against the largest value reported by
+///        any candidate so that the weights are independent of units.
+irods::error select_child_by_live_load(
+    irods::plugin_context& _ctx,
+    irods::resource_ptr&   _selected_resource ) {
+    namespace slt = irods::experimental::server_load_table;
+
+    int max_age = DEFAULT_MAX_SAMPLE_AGE;
+    _ctx.prop_map().get< int >( MAX_SAMPLE_AGE_KEY, max_age );
+
+    irods::resource_child_map* cmap_ref;
+    _ctx.prop_map().get< irods::resource_child_map* >(
+            irods::RESC_CHILD_MAP_PROP,
+            cmap_ref );
+
+    // =-=-=-=-=-=-=-
+    // gather the children which have a fresh sample
+    std::vector< std::pair< irods::resource_ptr, slt::load_sample > > candidates;
+    slt::load_sample max_sample{};
+    irods::resource_child_map::iterator itr = cmap_ref->begin();
+    for ( ; itr != cmap_ref->end(); ++itr ) {
+        irods::resource_ptr resc = itr->second.second;
+
+        std::string resc_name;
+        irods::error ret = resc->get_property< std::string >( irods::RESOURCE_NAME, resc_name );
+        if ( !ret.ok() ) {
+            return PASS( ret );
+        }
+
+        const auto sample = slt::lookup( resc_name, std::chrono::seconds( max_age ) );
+        if ( !sample ) {
+            continue;
+        }
+
+        max_sample.active_agents       = std::max( max_sample.active_agents,       sample->active_agents );
+        max_sample.io_bytes_per_second = std::max( max_sample.io_bytes_per_second, sample->io_bytes_per_second );
+        max_sample.disk_queue_depth    = std::max( max_sample.disk_queue_depth,    sample->disk_queue_depth );
+        max_sample.free_space          = std::max( max_sample.free_space,          sample->free_space );
+
+        candidates.emplace_back( resc, *sample );
+
+    } // for itr
+
+    if ( candidates.empty() ) {
+        return ERROR(
+                   CHILD_NOT_FOUND,
+                   "no live load samples for any child resc" );
+    }
+
+    const auto normalize = []( std::int64_t _value, std::int64_t _max ) -> double {
+        return _max > 0 ? static_cast< double >( _value ) / _max : 0.0;
+    };
+
+    const double agent_weight      = get_load_weight( _ctx, AGENT_WEIGHT_KEY );
+    const double io_weight         = get_load_weight( _ctx, IO_WEIGHT_KEY );
+    const double queue_weight      = get_load_weight( _ctx, QUEUE_WEIGHT_KEY );
+    const double free_space_weight = get_load_weight( _ctx, FREE_SPACE_WEIGHT_KEY );
+
+    // =-=-=-=-=-=-=-
+    // the lowest score wins, ties go to the first child in the map
+    double min_score = std::numeric_limits< double >::max();
+    for ( const auto& [resc, sample] : candidates ) {
+        const double score =
+            agent_weight      * normalize( sample.active_agents,       max_sample.active_agents ) +
+            io_weight         * normalize( sample.io_bytes_per_second, max_sample.io_bytes_per_second ) +
+            queue_weight      * normalize( sample.disk_queue_depth,    max_sample.disk_queue_depth ) +
+            free_space_weight * ( 1.0 - normalize( sample.free_space,  max_sample.free_space ) );
+        if ( score < min_score ) {
+            min_score = score;
+            _selected_resource = resc;
+        }
+    }
+
+    return SUCCESS();
+
+} // select_child_by_live_load
+
+/// =-=-=-=-=-=-=-
+/// @brief
+irods::error load_balanced_redirect_for_create_operation(
+    irods::plugin_context& _ctx,
+    const std::string*              _opr,
+    const std::string*              _curr_host,
+    irods::hierarchy_parser*        _out_parser,
+    float*                          _out_vote ) {
+    // =-=-=-=-=-=-=-
+    // prefer the live samples, servers without a control plane still
+    // have their load recorded in the catalog by the monitoring rules
+    std::string load_source;
+    _ctx.prop_map().get< std::string >( LOAD_SOURCE_KEY, load_source );
+
+    irods::resource_ptr selected_resource;
+    irods::error ret = ERROR( CHILD_NOT_FOUND, "live load samples disabled" );
+    if ( LOAD_SOURCE_CATALOG != load_source ) {
+        ret = select_child_by_live_load( _ctx, selected_resource );
+    }
+
+    if ( !ret.ok() ) {
+        rodsLog(
+            LOG_DEBUG,
+            "load_balanced node - %s, falling back to catalog load",
+            ret.result().c_str() );
+        ret = select_child_by_catalog_load( _ctx, selected_resource );
+        if ( !ret.ok() ) {
+            return PASS( ret );
+        }
+    }
+
     // =-=-=-=-=-=-=-
     // forward the redirect call to the child for assertion of the whole operation,
     // there may be more than a leaf beneath us
@@ -1026,6 +1176,46 @@ class load_balanced_resource : public irods::resource {
                     "load_balanced_resource :: using localhost policy, none specified" );
             }
 
+            if ( kvp.end() != kvp.find( LOAD_SOURCE_KEY ) ) {
+                properties_.set< std::string >(
+                    LOAD_SOURCE_KEY,
+                    kvp[ LOAD_SOURCE_KEY ] );
+            }
+
+            // =-=-=-=-=-=-=-
+            // extract the weighting of the live load samples
+            for ( const auto& key : { AGENT_WEIGHT_KEY, IO_WEIGHT_KEY, QUEUE_WEIGHT_KEY, FREE_SPACE_WEIGHT_KEY } ) {
+                if ( kvp.end() == kvp.find( key ) ) {
+                    continue;
+                }
+
+                try {
+                    properties_.set< double >( key, boost::lexical_cast< double >( kvp[ key ] ) );
+                }
+                catch ( const boost::bad_lexical_cast& ) {
+                    rodsLog(
+                        LOG_ERROR,
+                        "libload_balanced: invalid value [%s] for [%s], using [%f]",
+                        kvp[ key ].c_str(),
+                        key.c_str(),
+                        DEFAULT_LOAD_WEIGHT );
+                }
+            }
+
+            if ( kvp.end() != kvp.find( MAX_SAMPLE_AGE_KEY ) ) {
+                try {
+                    properties_.set< int >( MAX_SAMPLE_AGE_KEY, boost::lexical_cast< int >( kvp[ MAX_SAMPLE_AGE_KEY ] ) );
+                }
+                catch ( const boost::bad_lexical_cast& ) {
+                    rodsLog(
+                        LOG_ERROR,
+                        "libload_balanced: invalid value [%s] for [%s], using [%d]",
+                        kvp[ MAX_SAMPLE_AGE_KEY ].c_str(),
+                        MAX_SAMPLE_AGE_KEY.c_str(),
+                        DEFAULT_MAX_SAMPLE_AGE );
+                }
+            }
+
         }
 
         // =-=-=-=-=-=-
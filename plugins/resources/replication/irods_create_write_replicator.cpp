@@ -4,6 +4,9 @@
 #include "irods_repl_retry.hpp"
 #include "irods_stacktrace.hpp"
 
+#include <string>
+#include <vector>
+
 namespace irods {
 
     create_write_replicator::create_write_replicator(
@@ -36,26 +39,35 @@ namespace irods {
             child_parser.str( sub_hier, current_resource_ );
 
             file_object object = _object_oper.object();
+            std::vector<std::string> hierarchies;
             child_list_t::const_iterator it;
             for ( it = _siblings.begin(); it != _siblings.end(); ++it ) {
                 hierarchy_parser sibling = *it;
                 std::string hierarchy_string;
                 error ret = sibling.str( hierarchy_string );
                 if ( ( result = ASSERT_PASS( ret, "Failed to get the hierarchy string from the sibling hierarchy parser." ) ).ok() ) {
-                    dataObjInp_t dataObjInp;
-                    bzero( &dataObjInp, sizeof( dataObjInp ) );
-                    rstrcpy( dataObjInp.objPath, object.logical_path().c_str(), MAX_NAME_LEN );
-                    dataObjInp.createMode = object.mode();
-
-                    copyKeyVal( ( keyValPair_t* )&object.cond_input(), &dataObjInp.condInput );
-                    addKeyVal( &dataObjInp.condInput, RESC_HIER_STR_KW, child_.c_str() );
-                    addKeyVal( &dataObjInp.condInput, DEST_RESC_HIER_STR_KW, hierarchy_string.c_str() );
-                    addKeyVal( &dataObjInp.condInput, RESC_NAME_KW, root_resource_.c_str() );
-                    addKeyVal( &dataObjInp.condInput, DEST_RESC_NAME_KW, root_resource_.c_str() );
-                    addKeyVal( &dataObjInp.condInput, IN_PDMO_KW, sub_hier.c_str() );
-
-                    try {
-                        const auto status = data_obj_repl_with_retry( _ctx, dataObjInp );
+                    hierarchies.push_back( hierarchy_string );
+                } // if hier str
+
+            } // for it
+
+            if ( !hierarchies.empty() ) {
+                // All siblings are replicated in turn from one open of the child's replica
+                dataObjInp_t dataObjInp;
+                bzero( &dataObjInp, sizeof( dataObjInp ) );
+                rstrcpy( dataObjInp.objPath, object.logical_path().c_str(), MAX_NAME_LEN );
+                dataObjInp.createMode = object.mode();
+
+                copyKeyVal( ( keyValPair_t* )&object.cond_input(), &dataObjInp.condInput );
+                addKeyVal( &dataObjInp.condInput, RESC_HIER_STR_KW, child_.c_str() );
+                addKeyVal( &dataObjInp.condInput, RESC_NAME_KW, root_resource_.c_str() );
+                addKeyVal( &dataObjInp.condInput, DEST_RESC_NAME_KW, root_resource_.c_str() );
+                addKeyVal( &dataObjInp.condInput, IN_PDMO_KW, sub_hier.c_str() );
+
+                try {
+                    const auto statuses = data_obj_repl_to_many_with_retry( _ctx, dataObjInp, hierarchies );
+                    for ( std::size_t i = 0; i < statuses.size(); ++i ) {
+                        const auto status = statuses[i];
                         if (status < 0) {
                             // Replications which failed simply because they were not allowed need not be reported.
                             // Such failures should be fixed with a rebalance or some tree surgery.
@@ -67,7 +79,7 @@ namespace irods {
                             auto rods_error = rodsErrorName( status, &sys_error );
                             result = ERROR(status, fmt::format(
                                 "Failed to replicate the data object: \"{}\" from resource: \"{}\" to sibling: \"{}\" - {} {}.",
-                                object.logical_path(), child_, hierarchy_string, rods_error, sys_error));
+                                object.logical_path(), child_, hierarchies[i], rods_error, sys_error));
                             free( sys_error );
 
                             // cache last error to return, log it and add it to the
@@ -81,13 +93,13 @@ namespace irods {
                             result = SUCCESS();
                         }
                     }
-                    catch ( const irods::exception& e ) {
-                        irods::log( irods::error( e ) );
-                    }
-
-                } // if hier str
+                }
+                catch ( const irods::exception& e ) {
+                    irods::log( irods::error( e ) );
+                }
 
-            } // for it
+                clearKeyVal( &dataObjInp.condInput );
+            }
 
         } // if ok
 
@@ -5,18 +5,38 @@
 #include "irods_virtual_path.hpp"
 #include "irods_repl_retry.hpp"
 #include "irods_repl_types.hpp"
+#include "irods_kvp_string_parser.hpp"
+#include "irods_at_scope_exit.hpp"
 #include "icatHighLevelRoutines.hpp"
+#include "connection_pool.hpp"
+#include "thread_pool.hpp"
 #include "dataObjRepl.h"
 #include "genQuery.h"
+#include "modAVUMetadata.h"
 #include "rsGenQuery.hpp"
+#include "rsModAVUMetadata.hpp"
 #include "boost/format.hpp"
 #include "boost/lexical_cast.hpp"
 #include "rodsError.h"
 
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
 
 namespace {
-    irods::error repl_for_rebalance(
-        irods::plugin_context& _ctx,
+    const std::string UPDATE_OUT_OF_DATE_REPLICAS_PHASE{"update_out_of_date_replicas"};
+    const std::string CREATE_MISSING_REPLICAS_PHASE{"create_missing_replicas"};
+
+    void make_rebalance_inp(
+        dataObjInp_t&      _data_obj_inp,
         const std::string& _obj_path,
         const std::string& _current_resc,
         const std::string& _src_hier,
@@ -31,15 +51,27 @@ namespace {
         std::string sub_hier;
         parser.str( sub_hier, _current_resc );
 
+        rstrcpy( _data_obj_inp.objPath, _obj_path.c_str(), MAX_NAME_LEN );
+        _data_obj_inp.createMode = _mode;
+        addKeyVal( &_data_obj_inp.condInput, RESC_HIER_STR_KW,      _src_hier.c_str() );
+        addKeyVal( &_data_obj_inp.condInput, DEST_RESC_HIER_STR_KW, _dst_hier.c_str() );
+        addKeyVal( &_data_obj_inp.condInput, RESC_NAME_KW,          _src_resc.c_str() );
+        addKeyVal( &_data_obj_inp.condInput, DEST_RESC_NAME_KW,     _dst_resc.c_str() );
+        addKeyVal( &_data_obj_inp.condInput, IN_PDMO_KW,             sub_hier.c_str() );
+        addKeyVal( &_data_obj_inp.condInput, ADMIN_KW,              "" );
+    }
+
+    irods::error repl_for_rebalance(
+        irods::plugin_context& _ctx,
+        const std::string& _obj_path,
+        const std::string& _current_resc,
+        const std::string& _src_hier,
+        const std::string& _dst_hier,
+        const std::string& _src_resc,
+        const std::string& _dst_resc,
+        const int          _mode ) {
         dataObjInp_t data_obj_inp{};
-        rstrcpy( data_obj_inp.objPath, _obj_path.c_str(), MAX_NAME_LEN );
-        data_obj_inp.createMode = _mode;
-        addKeyVal( &data_obj_inp.condInput, RESC_HIER_STR_KW,      _src_hier.c_str() );
-        addKeyVal( &data_obj_inp.condInput, DEST_RESC_HIER_STR_KW, _dst_hier.c_str() );
-        addKeyVal( &data_obj_inp.condInput, RESC_NAME_KW,          _src_resc.c_str() );
-        addKeyVal( &data_obj_inp.condInput, DEST_RESC_NAME_KW,     _dst_resc.c_str() );
-        addKeyVal( &data_obj_inp.condInput, IN_PDMO_KW,             sub_hier.c_str() );
-        addKeyVal( &data_obj_inp.condInput, ADMIN_KW,              "" );
+        make_rebalance_inp( data_obj_inp, _obj_path, _current_resc, _src_hier, _dst_hier, _src_resc, _dst_resc, _mode );
 
         try {
             // =-=-=-=-=-=-=-
@@ -76,6 +108,7 @@ namespace {
         std::string object_path;
         std::string resource_hierarchy;
         int data_mode;
+        rodsLong_t data_size;
     };
 
     // throws irods::exception
@@ -106,6 +139,7 @@ namespace {
         addInxIval(&genquery_inp_wrapped.get().selectInp, COL_DATA_NAME, 1);
         addInxIval(&genquery_inp_wrapped.get().selectInp, COL_COLL_NAME, 1);
         addInxIval(&genquery_inp_wrapped.get().selectInp, COL_DATA_MODE, 1);
+        addInxIval(&genquery_inp_wrapped.get().selectInp, COL_DATA_SIZE, 1);
         addInxIval(&genquery_inp_wrapped.get().selectInp, COL_D_RESC_ID, 1);
 
         irods::GenQueryOutPtrWrapper genquery_out_ptr_wrapped;
@@ -152,6 +186,9 @@ namespace {
         sqlResult_t *data_mode_result = extract_sql_result(genquery_inp_wrapped.get(), genquery_out_ptr_wrapped.get(), COL_DATA_MODE);
         const int data_mode = cast_genquery_result(&data_mode_result->value[0]);
 
+        sqlResult_t *data_size_result = extract_sql_result(genquery_inp_wrapped.get(), genquery_out_ptr_wrapped.get(), COL_DATA_SIZE);
+        const rodsLong_t data_size = cast_genquery_result(&data_size_result->value[0]);
+
         ReplicationSourceInfo ret;
         ret.object_path = (boost::format("%s%s%s") % coll_name % irods::get_virtual_path_separator() % data_name).str();
         irods::error err = resc_mgr.leaf_id_to_hier(resc_id, ret.resource_hierarchy);
@@ -162,6 +199,7 @@ namespace {
                   genquery_inp_to_diagnostic_string(&genquery_inp_wrapped.get()));
         }
         ret.data_mode = data_mode;
+        ret.data_size = data_size;
         return ret;
     }
 
@@ -293,6 +331,375 @@ namespace {
         return ss.str();
     }
 
+    // throws irods::exception
+    void modify_resource_avu(
+        rsComm_t*          _comm,
+        const std::string& _operation,
+        const std::string& _resource_name,
+        const std::string& _attribute,
+        const std::string& _value,
+        const std::string& _units) {
+        modAVUMetadataInp_t mod_avu_inp{};
+        const irods::at_scope_exit free_mod_avu_inp{[&mod_avu_inp] {
+            free( mod_avu_inp.arg0 );
+            free( mod_avu_inp.arg1 );
+            free( mod_avu_inp.arg2 );
+            free( mod_avu_inp.arg3 );
+            free( mod_avu_inp.arg4 );
+            free( mod_avu_inp.arg5 );
+        }};
+        mod_avu_inp.arg0 = strdup( _operation.c_str() );
+        mod_avu_inp.arg1 = strdup( "-R" );
+        mod_avu_inp.arg2 = strdup( _resource_name.c_str() );
+        mod_avu_inp.arg3 = strdup( _attribute.c_str() );
+        mod_avu_inp.arg4 = strdup( _value.c_str() );
+        mod_avu_inp.arg5 = strdup( _units.c_str() );
+
+        const int status = rsModAVUMetadata( _comm, &mod_avu_inp );
+        if (status < 0) {
+            THROW(status,
+                  boost::format("failed to [%s] attribute [%s] on resource [%s]") %
+                  _operation %
+                  _attribute %
+                  _resource_name);
+        }
+    }
+
+    // throws irods::exception
+    void write_rebalance_checkpoint(
+        rsComm_t*                           _comm,
+        const std::string&                  _resource_name,
+        const irods::rebalance_checkpoint& _checkpoint) {
+        modify_resource_avu(
+            _comm,
+            "set",
+            _resource_name,
+            irods::REBALANCE_CHECKPOINT_ATTR,
+            fmt::format("{}:{}:{}", _checkpoint.phase, _checkpoint.child_name, _checkpoint.data_id),
+            fmt::format("replicas={},bytes={}", _checkpoint.replica_count, _checkpoint.byte_count));
+    }
+
+    // A single replication performed on behalf of the rebalance.
+    struct replication_request {
+        std::string object_path;
+        std::string source_hierarchy;
+        std::string destination_hierarchy;
+        std::string root_resource;
+        int         data_mode;
+        rodsLong_t  data_size;
+    };
+
+    // The replications needed by one data object.  They are performed in order
+    // because a data object may only be opened for replication once at a time.
+    // data_size is the total of all of its requests.
+    struct replication_job {
+        rodsLong_t                       data_id;
+        rodsLong_t                       data_size;
+        std::set<std::string>            children;
+        std::vector<replication_request> requests;
+    };
+
+    // Feeds replication jobs to a bounded set of workers.
+    //
+    // With a single worker, jobs are run synchronously within the agent performing
+    // the rebalance, exactly as before.  With more than one, each worker owns a
+    // connection back to the local server and replicates through rcDataObjRepl, so
+    // that the catalog scan and hierarchy resolution (which must stay on the agent's
+    // own rsComm) overlap with the data movement.
+    class rebalance_scheduler {
+    public:
+        rebalance_scheduler(
+            irods::plugin_context&          _ctx,
+            const irods::rebalance_options& _options,
+            const std::string&              _resource_name,
+            const std::string&              _phase)
+            : ctx_{_ctx}
+            , options_{_options}
+            , resource_name_{_resource_name}
+            , phase_{_phase}
+            , start_time_{std::chrono::steady_clock::now()}
+        {
+            if (options_.worker_count <= 1) {
+                return;
+            }
+
+            irods::error err = ctx_.prop_map().get<decltype(retry_attempts_)>(irods::RETRY_ATTEMPTS_KW, retry_attempts_);
+            if (!err.ok()) {
+                THROW(err.code(), err.result());
+            }
+            err = ctx_.prop_map().get<decltype(retry_delay_in_seconds_)>(irods::RETRY_FIRST_DELAY_IN_SECONDS_KW, retry_delay_in_seconds_);
+            if (!err.ok()) {
+                THROW(err.code(), err.result());
+            }
+            err = ctx_.prop_map().get<decltype(retry_backoff_multiplier_)>(irods::RETRY_BACKOFF_MULTIPLIER_KW, retry_backoff_multiplier_);
+            if (!err.ok()) {
+                THROW(err.code(), err.result());
+            }
+
+            try {
+                connection_pool_ = irods::make_connection_pool(options_.worker_count);
+            }
+            catch (const std::exception& e) {
+                THROW(SYS_SOCK_CONNECT_ERR,
+                      boost::format("failed to create rebalance connection pool for resource [%s]: %s") %
+                      resource_name_ %
+                      e.what());
+            }
+
+            thread_pool_ = std::make_unique<irods::thread_pool>(options_.worker_count);
+        }
+
+        rebalance_scheduler(const rebalance_scheduler&) = delete;
+        rebalance_scheduler& operator=(const rebalance_scheduler&) = delete;
+
+        ~rebalance_scheduler()
+        {
+            if (thread_pool_) {
+                thread_pool_->join();
+            }
+        }
+
+        // Blocks until the throughput and concurrency limits allow the job to start.
+        void submit(replication_job&& _job)
+        {
+            throttle(_job.data_size);
+
+            if (!thread_pool_) {
+                run_in_agent(_job);
+                return;
+            }
+
+            {
+                std::unique_lock<std::mutex> lock{mutex_};
+                cv_.wait(lock, [this, &_job] { return has_capacity_for(_job); });
+                ++in_flight_;
+                for (const auto& child : _job.children) {
+                    ++in_flight_per_child_[child];
+                }
+            }
+
+            irods::thread_pool::post(*thread_pool_, [this, job = std::move(_job)] {
+                run_over_connection(job);
+
+                {
+                    std::lock_guard<std::mutex> lock{mutex_};
+                    --in_flight_;
+                    for (const auto& child : job.children) {
+                        --in_flight_per_child_[child];
+                    }
+                }
+
+                cv_.notify_all();
+            });
+        }
+
+        // Waits for all submitted jobs to finish and reports their failures to
+        // the client.  Returns the first failure, if any.
+        irods::error wait_for_completion()
+        {
+            std::vector<irods::error> failures;
+
+            {
+                std::unique_lock<std::mutex> lock{mutex_};
+                cv_.wait(lock, [this] { return 0 == in_flight_; });
+                failures.swap(failures_);
+            }
+
+            for (const auto& failure : failures) {
+                irods::log(failure);
+                if (ctx_.comm()->rError.len < MAX_ERROR_MESSAGES) {
+                    addRErrorMsg(&ctx_.comm()->rError, failure.code(), failure.result().c_str());
+                }
+            }
+
+            return failures.empty() ? SUCCESS() : failures.front();
+        }
+
+        rodsLong_t replica_count() const noexcept { return replica_count_.load(); }
+        rodsLong_t byte_count() const noexcept { return byte_count_.load(); }
+
+        void log_progress() const
+        {
+            using seconds = std::chrono::duration<double>;
+            const auto elapsed = std::chrono::duration_cast<seconds>(std::chrono::steady_clock::now() - start_time_).count();
+            const double mb_per_second = elapsed > 0 ? byte_count() / elapsed / (1024 * 1024) : 0;
+
+            irods::log(LOG_NOTICE, fmt::format(
+                "rebalance of resource [{}] phase [{}]: replicated [{}] replicas totaling [{}] bytes in [{:.1f}] seconds ([{:.2f}] MiB/s) using [{}] worker(s)",
+                resource_name_, phase_, replica_count(), byte_count(), elapsed, mb_per_second, options_.worker_count));
+        }
+
+    private:
+        bool has_capacity_for(const replication_job& _job) const
+        {
+            if (in_flight_ >= options_.worker_count) {
+                return false;
+            }
+
+            if (options_.max_replicas_per_child > 0) {
+                for (const auto& child : _job.children) {
+                    const auto iter = in_flight_per_child_.find(child);
+                    if (iter != std::end(in_flight_per_child_) && iter->second >= options_.max_replicas_per_child) {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        // Delays the caller so that bytes are scheduled no faster than the configured rate.
+        void throttle(const rodsLong_t _bytes)
+        {
+            if (options_.max_bytes_per_second <= 0) {
+                return;
+            }
+
+            bytes_scheduled_ += _bytes;
+            const std::chrono::duration<double> offset{static_cast<double>(bytes_scheduled_) / options_.max_bytes_per_second};
+            std::this_thread::sleep_until(start_time_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(offset));
+        }
+
+        void run_in_agent(const replication_job& _job)
+        {
+            for (const auto& request : _job.requests) {
+                const irods::error err = repl_for_rebalance(
+                    ctx_,
+                    request.object_path,
+                    resource_name_,
+                    request.source_hierarchy,
+                    request.destination_hierarchy,
+                    request.root_resource,
+                    request.root_resource,
+                    request.data_mode);
+                if (!err.ok()) {
+                    rodsLog(LOG_ERROR, "%s: repl_for_rebalance failed. object path [%s] parent resc [%s] source hier [%s] dest hier [%s] root resc [%s] data mode [%d]",
+                            __FUNCTION__, request.object_path.c_str(), resource_name_.c_str(), request.source_hierarchy.c_str(),
+                            request.destination_hierarchy.c_str(), request.root_resource.c_str(), request.data_mode);
+                    failures_.push_back(PASS(err));
+                    return;
+                }
+
+                ++replica_count_;
+                byte_count_ += request.data_size;
+            }
+        }
+
+        void run_over_connection(const replication_job& _job)
+        {
+            for (const auto& request : _job.requests) {
+                irods::error err = SUCCESS();
+
+                try {
+                    auto conn = connection_pool_->get_connection();
+                    err = replicate_over_connection(static_cast<rcComm_t&>(conn), request);
+                }
+                catch (const std::exception& e) {
+                    err = ERROR(SYS_INTERNAL_ERR, e.what());
+                }
+
+                if (!err.ok()) {
+                    // Remaining replicas of this data object are left for the next rebalance.
+                    std::lock_guard<std::mutex> lock{mutex_};
+                    failures_.push_back(err);
+                    return;
+                }
+
+                ++replica_count_;
+                byte_count_ += request.data_size;
+            }
+        }
+
+        // Mirrors data_obj_repl_with_retry for replications issued over a client connection.
+        irods::error replicate_over_connection(rcComm_t& _conn, const replication_request& _request)
+        {
+            dataObjInp_t data_obj_inp{};
+            const irods::at_scope_exit clear_cond_input{[&data_obj_inp] { clearKeyVal(&data_obj_inp.condInput); }};
+            make_rebalance_inp(
+                data_obj_inp,
+                _request.object_path,
+                resource_name_,
+                _request.source_hierarchy,
+                _request.destination_hierarchy,
+                _request.root_resource,
+                _request.root_resource,
+                _request.data_mode);
+
+            auto retry_attempts = retry_attempts_;
+            auto delay_in_seconds = static_cast<double>(retry_delay_in_seconds_);
+
+            int status = rcDataObjRepl(&_conn, &data_obj_inp);
+            while (status < 0 && SYS_NOT_ALLOWED != status && retry_attempts-- > 0) {
+                irods::log(LOG_DEBUG, fmt::format(
+                    "[{}:{}] - replication of [{}] failed with [{}], retries remaining:[{}]",
+                    __FUNCTION__, __LINE__, _request.object_path, status, retry_attempts));
+                std::this_thread::sleep_for(std::chrono::duration<double>(delay_in_seconds));
+                delay_in_seconds *= retry_backoff_multiplier_;
+                status = rcDataObjRepl(&_conn, &data_obj_inp);
+            }
+
+            if (_conn.rError) {
+                freeRErrorContent(_conn.rError);
+            }
+
+            if (status < 0) {
+                return ERROR(status, boost::format(
+                             "%s: failed to replicate the data object [%s] from [%s] to [%s]") %
+                             __FUNCTION__ %
+                             _request.object_path %
+                             _request.source_hierarchy %
+                             _request.destination_hierarchy);
+            }
+
+            return SUCCESS();
+        }
+
+        irods::plugin_context&           ctx_;
+        const irods::rebalance_options   options_;
+        const std::string                resource_name_;
+        const std::string                phase_;
+        const std::chrono::steady_clock::time_point start_time_;
+
+        uint32_t retry_attempts_{irods::DEFAULT_RETRY_ATTEMPTS};
+        uint32_t retry_delay_in_seconds_{irods::DEFAULT_RETRY_FIRST_DELAY_IN_SECONDS};
+        double   retry_backoff_multiplier_{irods::DEFAULT_RETRY_BACKOFF_MULTIPLIER};
+
+        rodsLong_t bytes_scheduled_{};
+        std::atomic<rodsLong_t> replica_count_{};
+        std::atomic<rodsLong_t> byte_count_{};
+
+        std::mutex                 mutex_;
+        std::condition_variable    cv_;
+        int                        in_flight_{};
+        std::map<std::string, int> in_flight_per_child_;
+        std::vector<irods::error>  failures_;
+
+        std::shared_ptr<irods::connection_pool> connection_pool_;
+        std::unique_ptr<irods::thread_pool>     thread_pool_;
+    };
+
+    // throws irods::exception
+    int parse_rebalance_option(
+        const irods::kvp_map_t& _kvp,
+        const std::string&      _key,
+        const int               _minimum,
+        const int               _default) {
+        const auto it = _kvp.find(_key);
+        if (it == _kvp.end()) {
+            return _default;
+        }
+
+        try {
+            const int value = boost::lexical_cast<int>(it->second);
+            if (value < _minimum) {
+                THROW(SYS_INVALID_INPUT_PARAM, boost::format("[%s] must be at least [%d], found [%d]") % _key % _minimum % value);
+            }
+            return value;
+        } catch (const boost::bad_lexical_cast&) {
+            THROW(SYS_INVALID_INPUT_PARAM, boost::format("failed to cast string [%s] to integer") % it->second);
+        }
+    }
+
     // throws irods::exception
     void proc_results_for_rebalance(
         irods::plugin_context&           _ctx,
@@ -300,7 +707,8 @@ namespace {
         const std::string&               _child_resc_name,
         const size_t                     _bun_idx,
         const std::vector<leaf_bundle_t> _bundles,
-        const dist_child_result_t&       _data_ids_to_replicate) {
+        const dist_child_result_t&       _data_ids_to_replicate,
+        rebalance_scheduler&             _scheduler) {
         if (!_ctx.comm()) {
             THROW(SYS_INVALID_INPUT_PARAM,
                   boost::format("null comm pointer. resource [%s]. child resource [%s]. bundle index [%d]. bundles [%s]") %
@@ -319,9 +727,6 @@ namespace {
                   leaf_bundles_to_string(_bundles));
         }
 
-        //irods::file_object_ptr file_obj{boost::dynamic_pointer_cast<irods::file_object>(_ctx.fco())};
-
-        irods::error first_rebalance_error = SUCCESS();
         for (auto data_id_to_replicate : _data_ids_to_replicate) {
             const ReplicationSourceInfo source_info = get_source_data_object_attributes(_ctx.comm(), data_id_to_replicate, _bundles);
 
@@ -378,28 +783,12 @@ namespace {
             const std::string dst_hier = parser.str();
             rodsLog(LOG_NOTICE, "%s: creating new replica for data id [%lld] from [%s] on [%s]", __FUNCTION__, data_id_to_replicate, source_info.resource_hierarchy.c_str(), dst_hier.c_str());
 
-            const irods::error err_rebalance = repl_for_rebalance(
-                _ctx,
-                source_info.object_path,
-                _parent_resc_name,
-                source_info.resource_hierarchy,
-                dst_hier,
-                root_resc,
-                root_resc,
-                source_info.data_mode);
-            if (!err_rebalance.ok()) {
-                if (first_rebalance_error.ok()) {
-                    first_rebalance_error = err_rebalance;
-                }
-                rodsLog(LOG_ERROR, "%s: repl_for_rebalance failed. object path [%s] parent resc [%s] source hier [%s] dest hier [%s] root resc [%s] data mode [%d]",
-                        __FUNCTION__, source_info.object_path.c_str(), _parent_resc_name.c_str(), source_info.resource_hierarchy.c_str(), dst_hier.c_str(), root_resc.c_str(), source_info.data_mode);
-                irods::log(PASS(err_rebalance));
-                if (_ctx.comm()->rError.len < MAX_ERROR_MESSAGES) {
-                    addRErrorMsg(&_ctx.comm()->rError, err_rebalance.code(), err_rebalance.result().c_str());
-                }
-            }
+            replication_job job{data_id_to_replicate, source_info.data_size, {_child_resc_name}, {}};
+            job.requests.push_back({source_info.object_path, source_info.resource_hierarchy, dst_hier, root_resc, source_info.data_mode, source_info.data_size});
+            _scheduler.submit(std::move(job));
         }
 
+        const irods::error first_rebalance_error = _scheduler.wait_for_completion();
         if (!first_rebalance_error.ok()) {
             THROW(first_rebalance_error.code(),
                   boost::format("%s: repl_for_rebalance failed. child_resc [%s] parent resc [%s]. rebalance message [%s]") %
@@ -412,21 +801,150 @@ namespace {
 }
 
 namespace irods {
+    // throws irods::exception
+    rebalance_options get_rebalance_options(
+        irods::plugin_context& _ctx) {
+        kvp_map_t kvp;
+
+        std::string context;
+        if (_ctx.prop_map().get<std::string>(RESOURCE_CONTEXT, context).ok() && !context.empty()) {
+            const error kvp_err = parse_kvp_string(context, kvp);
+            if (!kvp_err.ok()) {
+                THROW(kvp_err.code(), kvp_err.result());
+            }
+        }
+
+        // values provided by pep_resource_rebalance_pre override the context string
+        if (!_ctx.rule_results().empty()) {
+            kvp_map_t rule_results_kvp;
+            const error kvp_err = parse_kvp_string(_ctx.rule_results(), rule_results_kvp);
+            if (!kvp_err.ok()) {
+                THROW(kvp_err.code(), kvp_err.result());
+            }
+
+            for (auto&& [key, value] : rule_results_kvp) {
+                kvp[key] = value;
+            }
+        }
+
+        rebalance_options options;
+        options.batch_size = parse_rebalance_option(kvp, REPL_LIMIT_KEY, 1, DEFAULT_REBALANCE_BATCH_SIZE);
+        options.worker_count = parse_rebalance_option(kvp, REBALANCE_WORKER_COUNT_KW, 1, DEFAULT_REBALANCE_WORKER_COUNT);
+        options.max_replicas_per_child = parse_rebalance_option(kvp, REBALANCE_MAX_REPLICAS_PER_CHILD_KW, 0, 0);
+
+        if (const auto it = kvp.find(REBALANCE_MAX_BYTES_PER_SECOND_KW); it != kvp.end()) {
+            try {
+                options.max_bytes_per_second = boost::lexical_cast<rodsLong_t>(it->second);
+            } catch (const boost::bad_lexical_cast&) {
+                THROW(SYS_INVALID_INPUT_PARAM, boost::format("failed to cast string [%s] to integer") % it->second);
+            }
+        }
+
+        return options;
+    }
+
+    // throws irods::exception
+    rebalance_checkpoint read_rebalance_checkpoint(
+        rsComm_t* _comm,
+        const std::string& _resource_name) {
+        irods::GenQueryInpWrapper genquery_inp_wrapped;
+        genquery_inp_wrapped.get().maxRows = 1;
+        addInxVal(&genquery_inp_wrapped.get().sqlCondInp, COL_R_RESC_NAME, ("= '" + _resource_name + "'").c_str());
+        addInxVal(&genquery_inp_wrapped.get().sqlCondInp, COL_META_RESC_ATTR_NAME, ("= '" + REBALANCE_CHECKPOINT_ATTR + "'").c_str());
+        addInxIval(&genquery_inp_wrapped.get().selectInp, COL_META_RESC_ATTR_VALUE, 1);
+        addInxIval(&genquery_inp_wrapped.get().selectInp, COL_META_RESC_ATTR_UNITS, 1);
+
+        irods::GenQueryOutPtrWrapper genquery_out_ptr_wrapped;
+        const int status_rsGenQuery = rsGenQuery(_comm, &genquery_inp_wrapped.get(), &genquery_out_ptr_wrapped.get());
+
+        rebalance_checkpoint ret;
+        if (CAT_NO_ROWS_FOUND == status_rsGenQuery) {
+            return ret;
+        } else if (status_rsGenQuery < 0 || !genquery_out_ptr_wrapped.get()) {
+            THROW(
+                status_rsGenQuery < 0 ? status_rsGenQuery : SYS_INTERNAL_NULL_INPUT_ERR,
+                boost::format("rsGenQuery failed. genquery_inp contents:\n%s\npossible iquest [%s]") %
+                genquery_inp_to_diagnostic_string(&genquery_inp_wrapped.get()) %
+                genquery_inp_to_iquest_string(&genquery_inp_wrapped.get()));
+        }
+
+        const std::string value = &extract_sql_result(genquery_inp_wrapped.get(), genquery_out_ptr_wrapped.get(), COL_META_RESC_ATTR_VALUE)->value[0];
+        const std::string units = &extract_sql_result(genquery_inp_wrapped.get(), genquery_out_ptr_wrapped.get(), COL_META_RESC_ATTR_UNITS)->value[0];
+
+        // value is "<phase>:<child resource>:<data id>"
+        const auto first = value.find(':');
+        const auto last = value.rfind(':');
+        if (std::string::npos == first || first == last) {
+            rodsLog(LOG_WARNING, "%s: ignoring malformed rebalance checkpoint [%s] on resource [%s]", __FUNCTION__, value.c_str(), _resource_name.c_str());
+            return ret;
+        }
+
+        // units is "replicas=<count>,bytes=<count>"
+        const auto replicas_pos = units.find("replicas=");
+        const auto bytes_pos = units.find(",bytes=");
+
+        try {
+            ret.data_id = boost::lexical_cast<rodsLong_t>(value.substr(last + 1));
+            if (std::string::npos != replicas_pos && std::string::npos != bytes_pos) {
+                ret.replica_count = boost::lexical_cast<rodsLong_t>(units.substr(replicas_pos + 9, bytes_pos - replicas_pos - 9));
+                ret.byte_count = boost::lexical_cast<rodsLong_t>(units.substr(bytes_pos + 7));
+            }
+        } catch (const boost::bad_lexical_cast&) {
+            rodsLog(LOG_WARNING, "%s: ignoring malformed rebalance checkpoint [%s] on resource [%s]", __FUNCTION__, value.c_str(), _resource_name.c_str());
+            return ret;
+        }
+
+        ret.phase = value.substr(0, first);
+        ret.child_name = value.substr(first + 1, last - first - 1);
+
+        rodsLog(LOG_NOTICE, "%s: resuming rebalance of resource [%s] at phase [%s] child [%s] data id [%lld]",
+                __FUNCTION__, _resource_name.c_str(), ret.phase.c_str(), ret.child_name.c_str(), ret.data_id);
+
+        return ret;
+    }
+
+    // throws irods::exception
+    void remove_rebalance_checkpoint(
+        rsComm_t* _comm,
+        const std::string& _resource_name) {
+        try {
+            modify_resource_avu(_comm, "rmw", _resource_name, REBALANCE_CHECKPOINT_ATTR, "%", "%");
+        }
+        catch (const irods::exception& e) {
+            // nothing was checkpointed if every batch was empty
+            if (CAT_SUCCESS_BUT_WITH_NO_INFO != e.code()) {
+                throw;
+            }
+        }
+    }
+
     // throws irods::exception
     void update_out_of_date_replicas(
         irods::plugin_context& _ctx,
         const std::vector<leaf_bundle_t>& _leaf_bundles,
-        const int _batch_size,
+        const rebalance_options& _options,
         const std::string& _invocation_timestamp,
-        const std::string& _resource_name) {
+        const std::string& _resource_name,
+        rebalance_checkpoint& _checkpoint) {
+
+        // replicas are brought up to date in place, so an interrupted run resumes
+        // naturally.  only skip this phase if a later one was already reached.
+        if (!_checkpoint.phase.empty() && UPDATE_OUT_OF_DATE_REPLICAS_PHASE != _checkpoint.phase) {
+            return;
+        }
+
+        _checkpoint.phase = UPDATE_OUT_OF_DATE_REPLICAS_PHASE;
+        rebalance_scheduler scheduler{_ctx, _options, _resource_name, _checkpoint.phase};
+        const rebalance_checkpoint initial_checkpoint = _checkpoint;
 
         while (true) {
-            const std::vector<ReplicaAndRescId> replicas_to_update = get_out_of_date_replicas_batch(_ctx.comm(), _leaf_bundles, _invocation_timestamp, _batch_size);
+            const std::vector<ReplicaAndRescId> replicas_to_update = get_out_of_date_replicas_batch(_ctx.comm(), _leaf_bundles, _invocation_timestamp, _options.batch_size);
             if (replicas_to_update.empty()) {
                 break;
             }
 
-            error first_error = SUCCESS();
+            // a data object may have several stale replicas; they are updated by the same job
+            std::map<rodsLong_t, replication_job> jobs;
             for (const auto& replica_to_update : replicas_to_update) {
                 std::string destination_hierarchy;
                 const error err_dst_hier = resc_mgr.leaf_id_to_hier(replica_to_update.resource_id, destination_hierarchy);
@@ -458,37 +976,37 @@ namespace irods {
                         source_info.object_path);
                 }
 
+                std::string destination_child;
+                const error err_child = irods::hierarchy_parser{destination_hierarchy}.next(_resource_name, destination_child);
+                if (!err_child.ok()) {
+                    THROW(err_child.code(), err_child.result());
+                }
+
                 rodsLog(LOG_NOTICE, "update_out_of_date_replicas: updating out-of-date replica for data id [%ji] from [%s] to [%s]",
                         static_cast<intmax_t>(replica_to_update.data_id),
                         source_info.resource_hierarchy.c_str(),
                         destination_hierarchy.c_str());
-                const error err_repl = repl_for_rebalance(
-                    _ctx,
-                    source_info.object_path,
-                    _resource_name,
-                    source_info.resource_hierarchy,
-                    destination_hierarchy,
-                    root_resc,
-                    root_resc,
-                    source_info.data_mode);
-
-                if (!err_repl.ok()) {
-                    if (first_error.ok()) {
-                        first_error = err_repl;
-                    }
-                    const error error_to_log = PASS(err_repl);
-                    if (_ctx.comm()->rError.len < MAX_ERROR_MESSAGES) {
-                        addRErrorMsg(&_ctx.comm()->rError, error_to_log.code(), error_to_log.result().c_str());
-                    }
-                    rodsLog(LOG_ERROR,
-                            "update_out_of_date_replicas: repl_for_rebalance failed with code [%ji] and message [%s]. object [%s] source hierarchy [%s] data id [%ji] destination repl num [%ji] destination hierarchy [%s]",
-                            static_cast<intmax_t>(err_repl.code()), err_repl.result().c_str(), source_info.object_path.c_str(), source_info.resource_hierarchy.c_str(),
-                            static_cast<intmax_t>(replica_to_update.data_id), static_cast<intmax_t>(replica_to_update.replica_number), destination_hierarchy.c_str());
-                }
+
+                auto& job = jobs[replica_to_update.data_id];
+                job.data_id = replica_to_update.data_id;
+                job.data_size += source_info.data_size;
+                job.children.insert(destination_child);
+                job.requests.push_back({source_info.object_path, source_info.resource_hierarchy, destination_hierarchy, root_resc, source_info.data_mode, source_info.data_size});
             }
+
+            for (auto&& [data_id, job] : jobs) {
+                scheduler.submit(std::move(job));
+            }
+
+            const error first_error = scheduler.wait_for_completion();
+            scheduler.log_progress();
             if (!first_error.ok()) {
                 THROW(first_error.code(), first_error.result());
             }
+
+            _checkpoint.replica_count = initial_checkpoint.replica_count + scheduler.replica_count();
+            _checkpoint.byte_count = initial_checkpoint.byte_count + scheduler.byte_count();
+            write_rebalance_checkpoint(_ctx.comm(), _resource_name, _checkpoint);
         }
     }
 
@@ -496,14 +1014,41 @@ namespace irods {
     void create_missing_replicas(
         irods::plugin_context& _ctx,
         const std::vector<leaf_bundle_t>& _leaf_bundles,
-        const int _batch_size,
+        const rebalance_options& _options,
         const std::string& _invocation_timestamp,
-        const std::string& _resource_name) {
+        const std::string& _resource_name,
+        rebalance_checkpoint& _checkpoint) {
+        // visit children in name order so that a checkpoint identifies the same
+        // position in the sequence across invocations
+        std::vector<std::pair<std::string, size_t>> children;
         for (size_t i=0; i<_leaf_bundles.size(); ++i) {
-            const std::string child_name = get_child_name_that_is_ancestor_of_bundle(_resource_name, _leaf_bundles[i]);
+            children.emplace_back(get_child_name_that_is_ancestor_of_bundle(_resource_name, _leaf_bundles[i]), i);
+        }
+        std::sort(children.begin(), children.end());
+
+        const bool resuming = CREATE_MISSING_REPLICAS_PHASE == _checkpoint.phase;
+        if (!resuming) {
+            _checkpoint.phase = CREATE_MISSING_REPLICAS_PHASE;
+            _checkpoint.child_name.clear();
+            _checkpoint.data_id = 0;
+        }
+
+        for (const auto& [child_name, i] : children) {
+            if (resuming && child_name < _checkpoint.child_name) {
+                continue;
+            }
+
+            if (child_name != _checkpoint.child_name) {
+                _checkpoint.child_name = child_name;
+                _checkpoint.data_id = 0;
+            }
+
+            rebalance_scheduler scheduler{_ctx, _options, _resource_name, _checkpoint.phase};
+            const rebalance_checkpoint initial_checkpoint = _checkpoint;
+
             while (true) {
                 dist_child_result_t data_ids_needing_new_replicas;
-                const int status_chlGetReplListForLeafBundles = chlGetReplListForLeafBundles(_batch_size, i, &_leaf_bundles, &_invocation_timestamp, &data_ids_needing_new_replicas);
+                const int status_chlGetReplListForLeafBundles = chlGetReplListForLeafBundles(_options.batch_size, i, &_leaf_bundles, &_invocation_timestamp, _checkpoint.data_id, &data_ids_needing_new_replicas);
                 if (status_chlGetReplListForLeafBundles != 0) {
                     THROW(status_chlGetReplListForLeafBundles,
                           boost::format("failed to get data objects needing new replicas for resource [%s] bundle index [%d] bundles [%s]")
@@ -515,7 +1060,14 @@ namespace irods {
                     break;
                 }
 
-                proc_results_for_rebalance(_ctx, _resource_name, child_name, i, _leaf_bundles, data_ids_needing_new_replicas);
+                proc_results_for_rebalance(_ctx, _resource_name, child_name, i, _leaf_bundles, data_ids_needing_new_replicas, scheduler);
+                scheduler.log_progress();
+
+                // results are ordered by data id, so everything up to the last one has been handled
+                _checkpoint.data_id = data_ids_needing_new_replicas.back();
+                _checkpoint.replica_count = initial_checkpoint.replica_count + scheduler.replica_count();
+                _checkpoint.byte_count = initial_checkpoint.byte_count + scheduler.byte_count();
+                write_rebalance_checkpoint(_ctx.comm(), _resource_name, _checkpoint);
             }
         }
     }
@@ -12,20 +12,78 @@
 namespace irods {
     using leaf_bundle_t = resource_manager::leaf_bundle_t;
 
+    // Keys recognized in the replication resource context string and in the
+    // rule results of pep_resource_rebalance_pre.  Values in the rule results
+    // take precedence over those in the context string.
+    const std::string REBALANCE_WORKER_COUNT_KW{ "rebalance_worker_count" };
+    const std::string REBALANCE_MAX_BYTES_PER_SECOND_KW{ "rebalance_max_bytes_per_second" };
+    const std::string REBALANCE_MAX_REPLICAS_PER_CHILD_KW{ "rebalance_max_replicas_per_child" };
+
+    const int DEFAULT_REBALANCE_BATCH_SIZE{ 500 };
+    const int DEFAULT_REBALANCE_WORKER_COUNT{ 1 };
+
+    // Name of the resource AVU which records how far an interrupted rebalance
+    // progressed.  Its value is "<phase>:<child resource>:<data id>" and its
+    // units hold the replica and byte counts accumulated so far.
+    const std::string REBALANCE_CHECKPOINT_ATTR{ "rebalance_checkpoint" };
+
+    struct rebalance_options {
+        // maximum number of data objects fetched from the catalog per query
+        int batch_size{ DEFAULT_REBALANCE_BATCH_SIZE };
+
+        // number of concurrent replications.  a value of 1 replicates serially
+        // within the agent which invoked the rebalance.  larger values replicate
+        // through a pool of connections back to the local server.
+        int worker_count{ DEFAULT_REBALANCE_WORKER_COUNT };
+
+        // maximum number of concurrent replications targeting any single child
+        // of the replication resource.  0 means bounded only by worker_count.
+        int max_replicas_per_child{ 0 };
+
+        // upper bound on the rate at which replica bytes are scheduled for
+        // replication.  0 means unthrottled.
+        rodsLong_t max_bytes_per_second{ 0 };
+    };
+
+    struct rebalance_checkpoint {
+        // empty when there is nothing to resume
+        std::string phase;
+        std::string child_name;
+        rodsLong_t  data_id{ 0 };
+        rodsLong_t  replica_count{ 0 };
+        rodsLong_t  byte_count{ 0 };
+    };
+
+    // throws irods::exception
+    rebalance_options get_rebalance_options(
+        irods::plugin_context& _ctx);
+
+    // throws irods::exception
+    rebalance_checkpoint read_rebalance_checkpoint(
+        rsComm_t* _comm,
+        const std::string& _resource_name);
+
+    // throws irods::exception
+    void remove_rebalance_checkpoint(
+        rsComm_t* _comm,
+        const std::string& _resource_name);
+
     // throws irods::exception
     void update_out_of_date_replicas(
         irods::plugin_context& _ctx,
         const std::vector<leaf_bundle_t>& _leaf_bundles,
-        const int _batch_size,
+        const rebalance_options& _options,
         const std::string& _invocation_timestamp,
-        const std::string& resource_name);
+        const std::string& resource_name,
+        rebalance_checkpoint& _checkpoint);
 
     // throws irods::exception
     void create_missing_replicas(
         irods::plugin_context& _ctx,
         const std::vector<leaf_bundle_t>& _leaf_bundles,
-        const int _batch_size,
+        const rebalance_options& _options,
         const std::string& _invocation_timestamp,
-        const std::string& resource_name);
+        const std::string& resource_name,
+        rebalance_checkpoint& _checkpoint);
 }
 #endif // _IRODS_REPL_REBALANCE_HPP_
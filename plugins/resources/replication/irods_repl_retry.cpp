@@ -74,3 +74,37 @@ int irods::data_obj_repl_with_retry(
     free( trans_stat );
     return status;
 }
+
+// Replicates a data object to several destinations in turn from one open of the source replica
+// Destinations which fail are replicated again individually with the retry mechanism
+std::vector<int> irods::data_obj_repl_to_many_with_retry(
+        irods::plugin_context& _ctx,
+        dataObjInp_t& dataObjInp,
+        const std::vector<std::string>& _destination_hierarchies ) {
+
+    std::vector<int> statuses;
+    rmKeyVal(&dataObjInp.condInput, ALL_KW);
+    dataObjReplToMany( _ctx.comm(), &dataObjInp, _destination_hierarchies, statuses );
+
+    for ( std::size_t i = 0; i < statuses.size(); ++i ) {
+        if ( 0 == statuses[i] ) {
+            continue;
+        }
+        else if (SYS_NOT_ALLOWED == statuses[i]) {
+            const auto error = irods::pop_error_message(_ctx.comm()->rError);
+            irods::log(LOG_NOTICE, fmt::format("[{}:{}] - [{}]",
+                __FUNCTION__, __LINE__, error));
+            continue;
+        }
+
+        irods::log(LOG_DEBUG, fmt::format(
+            "[{}:{}] - replication to [{}] failed with [{}], replicating individually...",
+            __FUNCTION__, __LINE__, _destination_hierarchies[i], statuses[i]));
+
+        addKeyVal( &dataObjInp.condInput, DEST_RESC_HIER_STR_KW, _destination_hierarchies[i].c_str() );
+        statuses[i] = data_obj_repl_with_retry( _ctx, dataObjInp );
+        rmKeyVal( &dataObjInp.condInput, DEST_RESC_HIER_STR_KW );
+    }
+
+    return statuses;
+}
@@ -4,6 +4,7 @@
 #include "dataObjInpOut.h"
 #include "irods_plugin_context.hpp"
 #include <string>
+#include <vector>
 
 namespace irods {
     // throws irods::exception
@@ -11,6 +12,14 @@ namespace irods {
         irods::plugin_context& _ctx,
         dataObjInp_t& dataObjInp );
 
+    // Replicates to each destination hierarchy in turn, opening the source replica
+    // once. Destinations which fail are retried individually.
+    // throws irods::exception
+    std::vector<int> data_obj_repl_to_many_with_retry(
+        irods::plugin_context& _ctx,
+        dataObjInp_t& dataObjInp,
+        const std::vector<std::string>& _destination_hierarchies );
+
     const std::string RETRY_ATTEMPTS_KW{ "retry_attempts" };
     const std::string RETRY_FIRST_DELAY_IN_SECONDS_KW{ "first_retry_delay_in_seconds" };
     const std::string RETRY_BACKOFF_MULTIPLIER_KW{ "backoff_multiplier" };
@@ -96,8 +96,6 @@ irods::error replCheckParams(
     return result;
 }
 
-const int DEFAULT_REBALANCE_BATCH_SIZE = 500;
-
 // =-=-=-=-=-=-=-
 // 2. Define operations which will be called by the file*
 //    calls declared in server/driver/include/fileDriver.h
@@ -1498,27 +1496,6 @@ irods::error call_rebalance_on_children(irods::plugin_context& _ctx) {
     return SUCCESS();
 }
 
-// throws irods::exception
-int get_rebalance_batch_size(irods::plugin_context& _ctx) {
-    if (!_ctx.rule_results().empty()) {
-        irods::kvp_map_t kvp;
-        irods::error kvp_err = irods::parse_kvp_string(_ctx.rule_results(), kvp);
-        if (!kvp_err.ok()) {
-            THROW(kvp_err.code(), kvp_err.result());
-        }
-
-        const auto it = kvp.find(irods::REPL_LIMIT_KEY);
-        if (it != kvp.end()) {
-            try {
-                return boost::lexical_cast<int>(it->second);
-            } catch (const boost::bad_lexical_cast&) {
-                THROW(SYS_INVALID_INPUT_PARAM, boost::format("failed to cast string [%s] to integer") % it->second);
-            }
-        }
-    }
-    return DEFAULT_REBALANCE_BATCH_SIZE;
-}
-
 // repl_file_rebalance - code which would rebalance the subtree
 irods::error repl_file_rebalance(
     irods::plugin_context& _ctx ) {
@@ -1540,10 +1517,15 @@ irods::error repl_file_rebalance(
     }
 
     try {
-        const int batch_size = get_rebalance_batch_size(_ctx);
+        const irods::rebalance_options options = irods::get_rebalance_options(_ctx);
         const std::vector<leaf_bundle_t> leaf_bundles = resc_mgr.gather_leaf_bundles_for_resc(resource_name);
-        irods::update_out_of_date_replicas(_ctx, leaf_bundles, batch_size, invocation_timestamp, resource_name);
-        irods::create_missing_replicas(_ctx, leaf_bundles, batch_size, invocation_timestamp, resource_name);
+
+        // a checkpoint left behind by an interrupted rebalance lets this one
+        // pick up where the previous one stopped rather than rescanning
+        irods::rebalance_checkpoint checkpoint = irods::read_rebalance_checkpoint(_ctx.comm(), resource_name);
+        irods::update_out_of_date_replicas(_ctx, leaf_bundles, options, invocation_timestamp, resource_name, checkpoint);
+        irods::create_missing_replicas(_ctx, leaf_bundles, options, invocation_timestamp, resource_name, checkpoint);
+        irods::remove_rebalance_checkpoint(_ctx.comm(), resource_name);
     } catch (const irods::exception& e) {
         return irods::error(e);
     }
@@ -19,6 +19,7 @@
 #include "irods_kvp_string_parser.hpp"
 #include "irods_logger.hpp"
 #include "voting.hpp"
+#include "local_file_copy.hpp"
 
 // =-=-=-=-=-=-=-
 // stl includes
@@ -134,9 +135,15 @@ static irods::error unix_file_copy(
             destFileName, err_status));
     }
 
+    // Let the kernel copy (or clone) the data, then copy whatever it could not.
+    rodsLong_t bytesCopied = irods::experimental::local_file_copy::copy( inFd, outFd, statbuf.st_size );
+    if ( bytesCopied == statbuf.st_size ) {
+        return SUCCESS();
+    }
+
     size_t trans_buff_size;
     try {
-        trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS) * 1024 * 1024;
+        trans_buff_size = irods::get_server_config_snapshot()->advanced_settings.transfer_buffer_size_for_parallel_transfer_in_megabytes.get() * 1024 * 1024;
     }
     catch ( const irods::exception& e ) {
         return irods::error(e);
@@ -144,7 +151,6 @@ static irods::error unix_file_copy(
 
     std::vector<char> myBuf( trans_buff_size );
     int bytesRead{};
-    rodsLong_t bytesCopied = 0;
     while ( ( bytesRead = read( inFd, ( void * ) myBuf.data(), trans_buff_size ) ) > 0 ) {
         int bytesWritten = write( outFd, ( void * ) myBuf.data(), bytesRead );
         err_status = UNIX_FILE_WRITE_ERR - errno;
@@ -7,6 +7,7 @@
 #include "rules.hpp"
 #include "index.hpp"
 #include "cache.hpp"
+#include "expression_cache.hpp"
 #include "locks.hpp"
 #include "region.h"
 #include "functions.hpp"
@@ -75,6 +76,7 @@ void clearRuleEngineConfig() {
   clearRegion (EXT, ext);
   free(ruleEngineConfig.address);
   memset (&ruleEngineConfig, 0, sizeof(Cache));
+  clearExpressionCache();
 }
 
 void removeRuleFromExtIndex( char *ruleName, int i ) {
@@ -0,0 +1,111 @@
+/* For copyright information please refer to files in the COPYRIGHT directory
+ */
+
+#include "expression_cache.hpp"
+#include "configuration.hpp"
+#include "utils.hpp"
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+    struct cached_expression {
+        std::string expr;
+        Region *region;
+        Node *node;
+    };
+
+    // most recently used entries are at the front
+    using lru_list = std::list<cached_expression>;
+
+    lru_list entries;
+    std::unordered_map<std::string, lru_list::iterator> entry_index;
+
+    // identifies the rule base the cached entries were typed against
+    std::string cached_generation;
+
+    std::string current_generation() {
+        std::string generation = ruleEngineConfig.hash;
+        generation += ':';
+        generation += std::to_string( ruleEngineConfig.coreRuleSet == NULL ? 0 : ruleEngineConfig.coreRuleSet->len );
+        generation += ':';
+        generation += std::to_string( ruleEngineConfig.appRuleSet == NULL ? 0 : ruleEngineConfig.appRuleSet->len );
+        return generation;
+    }
+
+    // discards the cached entries if the rule base has changed since they were typed
+    void validateGeneration() {
+        std::string generation = current_generation();
+        if ( generation != cached_generation ) {
+            clearExpressionCache();
+            cached_generation = std::move( generation );
+        }
+    }
+
+    Node *copyNode( Node *node, Region *r ) {
+        Hashtable *objectMap = newHashTable( 100 );
+        Node *copy = regionCpNode( node, r, objectMap );
+        deleteHashTable( objectMap, nop );
+        return copy;
+    }
+
+} // anonymous namespace
+
+int isExpressionCacheable() {
+    return ruleEngineConfig.ruleEngineStatus == INITIALIZED &&
+           ( ruleEngineConfig.extRuleSet == NULL || ruleEngineConfig.extRuleSet->len == 0 );
+}
+
+Node *lookupExpressionCache( const char *expr, Region *r ) {
+    if ( !isExpressionCacheable() ) {
+        return NULL;
+    }
+    validateGeneration();
+
+    auto itr = entry_index.find( expr );
+    if ( itr == entry_index.end() ) {
+        return NULL;
+    }
+    entries.splice( entries.begin(), entries, itr->second );
+
+    return copyNode( itr->second->node, r );
+}
+
+void insertIntoExpressionCache( const char *expr, Node *node ) {
+    if ( !isExpressionCacheable() ) {
+        return;
+    }
+    validateGeneration();
+
+    if ( entry_index.count( expr ) != 0 ) {
+        return;
+    }
+
+    Region *region = make_region( 0, NULL );
+    Node *copy = copyNode( node, region );
+    if ( copy == NULL ) {
+        region_free( region );
+        return;
+    }
+
+    if ( entries.size() >= EXPRESSION_CACHE_SIZE ) {
+        cached_expression& lru = entries.back();
+        entry_index.erase( lru.expr );
+        region_free( lru.region );
+        entries.pop_back();
+    }
+
+    entries.push_front( cached_expression{ expr, region, copy } );
+    entry_index[entries.front().expr] = entries.begin();
+}
+
+void clearExpressionCache() {
+    for ( auto& entry : entries ) {
+        region_free( entry.region );
+    }
+    entries.clear();
+    entry_index.clear();
+}
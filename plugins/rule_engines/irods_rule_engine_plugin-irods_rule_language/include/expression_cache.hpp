@@ -0,0 +1,34 @@
+/* For copyright information please refer to files in the COPYRIGHT directory
+ */
+
+#ifndef IRODS_NREP_EXPRESSION_CACHE_HPP
+#define IRODS_NREP_EXPRESSION_CACHE_HPP
+
+#include "restructs.hpp"
+#include "region.h"
+
+/* The maximum number of expressions held by the cache of an agent. */
+#define EXPRESSION_CACHE_SIZE 512
+
+/*
+ * Parsed and typed ASTs of rule expressions, keyed by expression text.
+ *
+ * Expressions are only cached while no ext rules are defined, because the
+ * types assigned to an expression depend on the rules in scope. Entries are
+ * discarded when the rule base changes and the least recently used entry is
+ * evicted when the cache is full.
+ */
+
+/* Returns non-zero if expressions may be looked up in or inserted into the cache. */
+int isExpressionCacheable();
+
+/* Returns a copy of the cached AST of expr allocated in r, or NULL if expr is not cached. */
+Node *lookupExpressionCache( const char *expr, Region *r );
+
+/* Caches a copy of the AST of expr. The AST must have been typed. */
+void insertIntoExpressionCache( const char *expr, Node *node );
+
+/* Discards all cached expressions. */
+void clearExpressionCache();
+
+#endif // IRODS_NREP_EXPRESSION_CACHE_HPP
@@ -9,6 +9,7 @@
 #include "arithmetics.hpp"
 #include "configuration.hpp"
 #include "filesystem.hpp"
+#include "expression_cache.hpp"
 #include "rcMisc.h"
 #include "irods_log.hpp"
 #include "irods_re_plugin.hpp"
@@ -508,6 +509,10 @@ Res *parseAndComputeExpression( char *expr, Env *env, ruleExecInfo_t *rei, int r
         addRErrorMsg( errmsg, RE_BUFFER_OVERFLOW, "error: potential buffer overflow" );
         return newErrorRes( r, RE_BUFFER_OVERFLOW );
     }
+    /* repeated expressions, such as delayed rules, skip parsing and typing */
+    if ( ( node = lookupExpressionCache( expr, r ) ) != NULL ) {
+        return computeNode( node, NULL, env, rei, reiSaveFlag, errmsg, r );
+    }
     Pointer *e = newPointer2( expr );
     ParserContext *pc = newParserContext( errmsg, r );
     if ( e == NULL ) {
@@ -561,6 +566,16 @@ Res *parseAndComputeExpression( char *expr, Env *env, ruleExecInfo_t *rei, int r
             RETURN;
         }
     }
+    if ( isExpressionCacheable() ) {
+        /* type the node before caching it so that hits skip typing as well */
+        Node *errnode;
+        int errorcode = typeNode( node, newHashTable2( 10, r ), errmsg, &errnode, r );
+        if ( errorcode != 0 ) {
+            res = newErrorRes( r, errorcode );
+            RETURN;
+        }
+        insertIntoExpressionCache( expr, node );
+    }
     res = computeNode( node, NULL, env, rei, reiSaveFlag, errmsg, r );
 ret:
     deleteParserContext( pc );
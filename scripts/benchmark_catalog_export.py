@@ -0,0 +1,69 @@
+#!/usr/bin/python
+from __future__ import print_function
+import json
+import optparse
+import os
+import subprocess
+import sys
+import tempfile
+import zipfile
+
+# Measures exporting the catalog with msi_catalog_export, in rows per second.
+# The export is written by the catalog service provider, so run this on that
+# host against the local database, with the environment of an iRODS
+# administrator.  Tables are only read in parallel on PostgreSQL, so the
+# database named in the manifest of the export is reported, e.g.
+#
+#   python scripts/benchmark_catalog_export.py --threads 1 --threads 5
+#
+# Populate the catalog first (e.g. with scripts/benchmark_directory_registration.py
+# --keep) so the export has something to read.
+
+REP_NAME = 'irods_rule_engine_plugin-irods_rule_language-instance'
+
+def export(output_path, threads, rows_per_row_group):
+    json_input = json.dumps({
+        'output_path': output_path,
+        'number_of_threads': threads,
+        'rows_per_row_group': rows_per_row_group,
+        'overwrite': True
+    })
+    rule = "msi_catalog_export('{0}', *out); writeLine('stdout', *out)".format(json_input)
+    out = subprocess.check_output(['irule', '-r', REP_NAME, rule, 'null', 'ruleExecOut'])
+    return json.loads(out.decode('utf-8'))
+
+def main():
+    parser = optparse.OptionParser()
+    parser.add_option('--threads', type='int', action='append', help='number of table readers (repeatable)')
+    parser.add_option('--rows-per-row-group', type='int', default=65536, help='rows per row group')
+    parser.add_option('--rounds', type='int', default=3, help='number of exports per configuration')
+    options, _ = parser.parse_args()
+
+    output_dir = tempfile.mkdtemp(prefix='irods_catalog_export_benchmark_')
+    output_path = os.path.join(output_dir, 'catalog.zip')
+
+    try:
+        database = None
+        for threads in options.threads or [1, 5]:
+            best = None
+            for _ in range(options.rounds):
+                result = export(output_path, threads, options.rows_per_row_group)
+                if best is None or result['rows_per_second'] > best['rows_per_second']:
+                    best = result
+            if database is None:
+                with zipfile.ZipFile(output_path) as archive:
+                    database = json.loads(archive.read('manifest.json').decode('utf-8'))['database']
+                print('database: {0}'.format(database))
+                if database != 'postgres':
+                    print('    tables are read one after the other on this database')
+            print('{0} thread(s): {1} rows in {2:.3f} s ({3:.0f} rows per second, {4} bytes)'.format(
+                threads, best['rows'], best['seconds'], best['rows_per_second'], os.path.getsize(output_path)))
+            for name in sorted(best['tables']):
+                print('    {0}: {1} rows'.format(name, best['tables'][name]['rows']))
+    finally:
+        if os.path.exists(output_path):
+            os.remove(output_path)
+        os.rmdir(output_dir)
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,95 @@
+#!/usr/bin/python
+from __future__ import print_function
+import optparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+# Generates a synthetic directory tree and measures registering it in place
+# with ireg -C.  Compare runs with bulk registration disabled and enabled in
+# server_config.json:
+#
+#   "advanced_settings": {
+#       "bulk_registration_batch_size_in_data_objects": 500,
+#       "bulk_registration_number_of_threads": 8
+#   }
+#
+# The tree must be readable by the service account and the resource must be a
+# standalone unixfilesystem resource on this host.  Run with the environment of
+# an iRODS administrator, e.g.
+#
+#   python scripts/benchmark_directory_registration.py --resource demoResc --fanout 10 --depth 3 --files 100
+
+def run(args, **kwargs):
+    return subprocess.check_output(args, **kwargs).decode('utf-8')
+
+def timed(function):
+    start = time.time()
+    function()
+    return time.time() - start
+
+def generate_tree(root, fanout, depth, files, file_size):
+    # Creates fanout subdirectories per level down to depth, each with files
+    # files.  Returns the number of files created.
+    count = 0
+    directories = [root]
+    for level in range(depth + 1):
+        next_level = []
+        for d in directories:
+            if not os.path.isdir(d):
+                os.makedirs(d)
+            for i in range(files):
+                with open(os.path.join(d, 'file_{0:06d}'.format(i)), 'wb') as f:
+                    if file_size > 0:
+                        f.truncate(file_size)
+            count += files
+            if level < depth:
+                next_level.extend(os.path.join(d, 'dir_{0:04d}'.format(i)) for i in range(fanout))
+        directories = next_level
+    return count
+
+def main():
+    parser = optparse.OptionParser()
+    parser.add_option('--resource', default='demoResc', help='the unixfilesystem resource to register into')
+    parser.add_option('--directory', help='where to generate the tree (default: a temporary directory)')
+    parser.add_option('--fanout', type='int', default=10, help='subdirectories per directory')
+    parser.add_option('--depth', type='int', default=2, help='levels of subdirectories')
+    parser.add_option('--files', type='int', default=100, help='files per directory')
+    parser.add_option('--file-size', type='int', default=0, help='size of each file in bytes')
+    parser.add_option('--generate-only', action='store_true', default=False, help='only generate the tree and keep it')
+    parser.add_option('--keep', action='store_true', default=False, help='keep the tree and its data objects')
+    options, _ = parser.parse_args()
+
+    work_dir = options.directory or tempfile.mkdtemp(prefix='irods_registration_benchmark_')
+    tree = os.path.join(os.path.abspath(work_dir), 'tree')
+    collection = None
+
+    try:
+        count = [0]
+        def generate():
+            count[0] = generate_tree(tree, options.fanout, options.depth, options.files, options.file_size)
+        seconds = timed(generate)
+        print('generated {0} files in {1:.3f} s under {2}'.format(count[0], seconds, tree))
+
+        if options.generate_only:
+            return 0
+
+        collection = '{0}/benchmark_directory_registration'.format(run(['ipwd']).strip())
+        seconds = timed(lambda: run(['ireg', '-C', '-R', options.resource, tree, collection]))
+        registered = run(['iquest', '%s', "select count(DATA_ID) where COLL_NAME like '{0}%'".format(collection)]).strip()
+        print('registered {0} data objects in {1:.3f} s ({2:.1f} per second)'.format(
+            registered, seconds, int(registered) / seconds if seconds > 0 else 0))
+    finally:
+        if not options.keep and not options.generate_only:
+            if collection:
+                subprocess.call(['iunreg', '-r', collection])
+            if options.directory:
+                shutil.rmtree(tree, ignore_errors=True)
+            else:
+                shutil.rmtree(work_dir, ignore_errors=True)
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,100 @@
+#!/usr/bin/python
+from __future__ import print_function
+import optparse
+import os
+import shutil
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+
+# Measures replication between two unixfilesystem resources whose vaults live
+# on a loopback XFS image created with reflink support, which is the case the
+# server copies with FICLONE / copy_file_range instead of read and write.  For
+# reference, the same file is also copied in user space with the transfer
+# buffer size and with cp --reflink=always.
+#
+# Must run as root (to create and mount the image) with the environment of an
+# iRODS administrator whose server runs on this host, e.g.
+#
+#   sudo -E python scripts/benchmark_local_file_copy.py --owner irods
+
+def run(args, **kwargs):
+    return subprocess.check_output(args, **kwargs).decode('utf-8')
+
+def timed(function):
+    start = time.time()
+    function()
+    return time.time() - start
+
+def user_space_copy(src, dst, buffer_size):
+    with open(src, 'rb') as i:
+        with open(dst, 'wb') as o:
+            shutil.copyfileobj(i, o, buffer_size)
+            o.flush()
+            os.fsync(o.fileno())
+
+def make_file(path, size):
+    chunk = os.urandom(1024 * 1024)
+    with open(path, 'wb') as f:
+        remaining = size
+        while remaining > 0:
+            f.write(chunk[:min(len(chunk), remaining)])
+            remaining -= len(chunk)
+
+def report(name, seconds, size):
+    print('{0:<28} {1:8.3f} s {2:10.1f} MiB/s'.format(name, seconds, size / seconds / (1024 * 1024)))
+
+def main():
+    parser = optparse.OptionParser()
+    parser.add_option('--image-size', type='int', default=8, help='size of the XFS image in GiB')
+    parser.add_option('--file-size', type='int', default=1024, help='size of the test file in MiB')
+    parser.add_option('--buffer-size', type='int', default=4, help='user space copy buffer in MiB')
+    parser.add_option('--owner', default='irods', help='the service account that owns the vaults')
+    options, _ = parser.parse_args()
+
+    if os.geteuid() != 0:
+        parser.error('must run as root to create the loopback image')
+
+    size = options.file_size * 1024 * 1024
+    work_dir = tempfile.mkdtemp(prefix='irods_copy_benchmark_')
+    image = os.path.join(work_dir, 'xfs.img')
+    mount_point = os.path.join(work_dir, 'mnt')
+    hostname = socket.gethostname()
+    resources = ['benchmark_xfs_a', 'benchmark_xfs_b']
+    logical_path = None
+
+    try:
+        with open(image, 'wb') as f:
+            f.truncate(options.image_size * 1024 ** 3)
+        run(['mkfs.xfs', '-q', '-m', 'reflink=1', image])
+        os.mkdir(mount_point)
+        run(['mount', '-o', 'loop', image, mount_point])
+        run(['chown', options.owner, mount_point])
+
+        local_file = os.path.join(mount_point, 'source')
+        make_file(local_file, size)
+
+        report('user space copy', timed(lambda: user_space_copy(
+            local_file, os.path.join(mount_point, 'copy'), options.buffer_size * 1024 * 1024)), size)
+        report('cp --reflink=always', timed(lambda: run(
+            ['cp', '--reflink=always', local_file, os.path.join(mount_point, 'reflink')])), size)
+
+        for r in resources:
+            run(['iadmin', 'mkresc', r, 'unixfilesystem', '{0}:{1}'.format(hostname, os.path.join(mount_point, r))])
+
+        logical_path = '{0}/benchmark_local_file_copy'.format(run(['ipwd']).strip())
+        run(['iput', '-f', '-R', resources[0], local_file, logical_path])
+        report('irepl (same filesystem)', timed(lambda: run(['irepl', '-R', resources[1], logical_path])), size)
+    finally:
+        if logical_path:
+            subprocess.call(['irm', '-f', logical_path])
+        for r in resources:
+            subprocess.call(['iadmin', 'rmresc', r])
+        if os.path.ismount(mount_point):
+            subprocess.call(['umount', mount_point])
+        shutil.rmtree(work_dir, ignore_errors=True)
+
+if __name__ == '__main__':
+    sys.exit(main())
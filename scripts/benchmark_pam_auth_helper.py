@@ -0,0 +1,103 @@
+#!/usr/bin/python
+from __future__ import print_function
+import optparse
+import os
+import shutil
+import socket
+import struct
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+from irods import paths
+
+# Measures PAM authentications per second through the persistent helper
+# (irodsPamAuthCheck --daemon) and through the fork/exec path used when the
+# helper is disabled.  Both paths use the 'irods' PAM service, so point
+# /etc/pam.d/irods at pam_permit.so on a test machine to measure the overhead
+# of the two paths rather than the speed of the authentication backend.
+
+def authenticate_with_helper(socket_path, username, password):
+    s = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    try:
+        s.connect(socket_path)
+        for field in [username, password]:
+            data = field.encode('utf-8')
+            s.sendall(struct.pack('!I', len(data)) + data)
+        reply = b''
+        while len(reply) < 4:
+            chunk = s.recv(4 - len(reply))
+            if not chunk:
+                raise RuntimeError('helper closed the connection')
+            reply += chunk
+        return struct.unpack('!I', reply)[0] == 0
+    finally:
+        s.close()
+
+def authenticate_with_exec(program, username, password):
+    p = subprocess.Popen([program, username], stdin=subprocess.PIPE, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    p.communicate(password.encode('utf-8'))
+    return p.returncode == 0
+
+def run(count, concurrency, function):
+    failures = []
+    lock = threading.Lock()
+
+    def worker(n):
+        for _ in range(n):
+            if not function():
+                with lock:
+                    failures.append(1)
+
+    per_thread = [count // concurrency + (1 if i < count % concurrency else 0) for i in range(concurrency)]
+    threads = [threading.Thread(target=worker, args=(n,)) for n in per_thread]
+    start = time.time()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    elapsed = time.time() - start
+    return count / elapsed, len(failures)
+
+def wait_for_socket(path, timeout):
+    deadline = time.time() + timeout
+    while not os.path.exists(path):
+        if time.time() > deadline:
+            raise RuntimeError('helper did not create [{0}]'.format(path))
+        time.sleep(0.05)
+
+def main():
+    parser = optparse.OptionParser(usage='%prog [options] username password')
+    parser.add_option('--count', type='int', default=1000, help='authentications per path')
+    parser.add_option('--concurrency', type='int', default=8, help='concurrent clients')
+    parser.add_option('--workers', type='int', default=8, help='helper worker processes')
+    parser.add_option('--program', default=os.path.join(paths.server_bin_directory(), 'irodsPamAuthCheck'),
+                      help='path to irodsPamAuthCheck')
+    parser.add_option('--skip-exec', action='store_true', default=False, help='only measure the helper')
+    options, args = parser.parse_args()
+    if len(args) != 2:
+        parser.error('username and password are required')
+    username, password = args
+
+    socket_dir = tempfile.mkdtemp(prefix='irods_pam_benchmark_')
+    socket_path = os.path.join(socket_dir, 'helper')
+    helper = subprocess.Popen([options.program, '--daemon', socket_path, str(options.workers)])
+    try:
+        wait_for_socket(socket_path, 10)
+        rate, failures = run(options.count, options.concurrency,
+                             lambda: authenticate_with_helper(socket_path, username, password))
+        print('helper:    {0:10.1f} authentications/s ({1} rejected)'.format(rate, failures))
+    finally:
+        helper.terminate()
+        helper.wait()
+        shutil.rmtree(socket_dir, ignore_errors=True)
+
+    if not options.skip_exec:
+        rate, failures = run(options.count, options.concurrency,
+                             lambda: authenticate_with_exec(options.program, username, password))
+        print('fork/exec: {0:10.1f} authentications/s ({1} rejected)'.format(rate, failures))
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,91 @@
+#!/usr/bin/python
+from __future__ import print_function
+import optparse
+import os
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+
+# Measures opening a data object whose replicas live below a deep resource
+# hierarchy: a chain of passthru resources ending in a replication resource
+# with many unixfilesystem children.  Every open resolves the hierarchy of
+# each replica and votes through every level of the chain, so this is the
+# case that benefits from handling hierarchies as resource IDs.  Hierarchies
+# deeper than resource_hierarchy::max_depth (16, so --depth above 14) fall back
+# to hierarchy strings.  For the CPU cost per open without the client, run the
+# "resource hierarchy replica check cost" case of irods_resource_hierarchy.
+#
+# Must run with the environment of an iRODS administrator whose server runs
+# on this host, e.g.
+#
+#   python scripts/benchmark_resource_hierarchy_open.py --depth 8 --leaves 16
+
+def run(args, **kwargs):
+    return subprocess.check_output(args, **kwargs).decode('utf-8')
+
+def timed(function):
+    start = time.time()
+    function()
+    return time.time() - start
+
+def main():
+    parser = optparse.OptionParser()
+    parser.add_option('--depth', type='int', default=6, help='number of passthru resources above the replication resource')
+    parser.add_option('--leaves', type='int', default=8, help='number of unixfilesystem resources below the replication resource')
+    parser.add_option('--opens', type='int', default=200, help='number of times the data object is opened')
+    parser.add_option('--vault', default='/tmp', help='directory that holds the vaults of the leaf resources')
+    options, _ = parser.parse_args()
+
+    hostname = socket.gethostname()
+    passthrus = ['benchmark_pt_{0}'.format(i) for i in range(options.depth)]
+    replication = 'benchmark_repl'
+    leaves = ['benchmark_ufs_{0}'.format(i) for i in range(options.leaves)]
+    created = []
+    logical_path = None
+    local_file = None
+
+    try:
+        for r in passthrus:
+            run(['iadmin', 'mkresc', r, 'passthru'])
+            created.append(r)
+        run(['iadmin', 'mkresc', replication, 'replication'])
+        created.append(replication)
+        for r in leaves:
+            run(['iadmin', 'mkresc', r, 'unixfilesystem', '{0}:{1}'.format(hostname, os.path.join(options.vault, r))])
+            created.append(r)
+
+        for parent, child in zip(passthrus, passthrus[1:] + [replication]):
+            run(['iadmin', 'addchildtoresc', parent, child])
+        for r in leaves:
+            run(['iadmin', 'addchildtoresc', replication, r])
+
+        fd, local_file = tempfile.mkstemp(prefix='irods_hierarchy_benchmark_')
+        os.write(fd, b'benchmark')
+        os.close(fd)
+
+        logical_path = '{0}/benchmark_resource_hierarchy_open'.format(run(['ipwd']).strip())
+        run(['iput', '-f', '-R', passthrus[0], local_file, logical_path])
+
+        def open_repeatedly():
+            for _ in range(options.opens):
+                run(['istream', 'read', logical_path])
+
+        seconds = timed(open_repeatedly)
+        print('hierarchy depth {0}, {1} replicas'.format(options.depth + 2, options.leaves))
+        print('{0} opens in {1:.3f} s ({2:.2f} ms per open)'.format(options.opens, seconds, seconds * 1000 / options.opens))
+    finally:
+        if logical_path:
+            subprocess.call(['irm', '-f', logical_path])
+        if local_file:
+            os.remove(local_file)
+        for r in leaves:
+            subprocess.call(['iadmin', 'rmchildfromresc', replication, r])
+        for parent, child in zip(passthrus, passthrus[1:] + [replication]):
+            subprocess.call(['iadmin', 'rmchildfromresc', parent, child])
+        for r in reversed(created):
+            subprocess.call(['iadmin', 'rmresc', r])
+
+if __name__ == '__main__':
+    sys.exit(main())
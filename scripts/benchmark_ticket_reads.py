@@ -0,0 +1,104 @@
+#!/usr/bin/python
+from __future__ import print_function
+import json
+import optparse
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+from irods import lib, paths
+from irods.controller import IrodsController
+
+# Measures reading many small data objects through a read ticket, the access
+# pattern of a public dataset served to anonymous clients.  Every read checks
+# the ticket, its restrictions and the object in the catalog.
+#
+# With --compare, the reads are timed with the access verdict cache disabled
+# and then enabled.  This edits server_config.json and restarts the server, so
+# run it as the service account on the catalog service provider, e.g.
+#
+#   python scripts/benchmark_ticket_reads.py --compare --objects 50 --rounds 4
+#
+# Without --compare, the reads are timed once with the current configuration,
+# and any user owning the data can run it.
+
+CACHE_CONFIGURATIONS = [
+    ('cache disabled', {'time_to_live_in_seconds': 0}),
+    ('cache enabled', {
+        'shared_memory_size_in_bytes': 10000000,
+        'time_to_live_in_seconds': 30,
+        'maximum_entries_per_agent': 10000
+    })
+]
+
+def run(args, **kwargs):
+    return subprocess.check_output(args, **kwargs).decode('utf-8')
+
+def timed(function):
+    start = time.time()
+    function()
+    return time.time() - start
+
+def main():
+    parser = optparse.OptionParser()
+    parser.add_option('--objects', type='int', default=50, help='number of data objects in the collection')
+    parser.add_option('--rounds', type='int', default=4, help='number of times every data object is read')
+    parser.add_option('--ticket', default='benchmark_ticket_reads', help='the string of the read ticket')
+    parser.add_option('--compare', action='store_true', default=False, help='time the reads with the cache disabled and enabled')
+    options, _ = parser.parse_args()
+
+    collection = '{0}/benchmark_ticket_reads'.format(run(['ipwd']).strip())
+    ticket_created = False
+    local_dir = tempfile.mkdtemp(prefix='irods_ticket_benchmark_')
+
+    try:
+        for i in range(options.objects):
+            with open(os.path.join(local_dir, 'file_{0:06d}'.format(i)), 'wb') as f:
+                f.write(b'benchmark')
+        run(['iput', '-r', local_dir, collection])
+
+        run(['iticket', 'create', 'read', collection, options.ticket])
+        ticket_created = True
+
+        logical_paths = ['{0}/file_{1:06d}'.format(collection, i) for i in range(options.objects)]
+
+        def read_all():
+            for _ in range(options.rounds):
+                for p in logical_paths:
+                    run(['iget', '-t', options.ticket, p, '-'])
+
+        reads = options.objects * options.rounds
+
+        def report(label):
+            seconds = timed(read_all)
+            print('{0}: {1} ticket reads in {2:.3f} s ({3:.2f} ms per read)'.format(
+                label, reads, seconds, seconds * 1000 / reads))
+
+        if not options.compare:
+            report('current configuration')
+            return 0
+
+        server_config_filename = paths.server_config_path()
+        with lib.file_backed_up(server_config_filename):
+            for label, settings in CACHE_CONFIGURATIONS:
+                with open(server_config_filename) as f:
+                    server_config = json.load(f)
+                server_config['advanced_settings']['access_verdict_cache'] = settings
+                with open(server_config_filename, 'w') as f:
+                    json.dump(server_config, f, sort_keys=True, indent=4, separators=(',', ': '))
+                IrodsController().restart()
+                report(label)
+
+        IrodsController().restart()
+    finally:
+        if ticket_created:
+            subprocess.call(['iticket', 'delete', options.ticket])
+        subprocess.call(['irm', '-rf', collection])
+        for name in os.listdir(local_dir):
+            os.remove(os.path.join(local_dir, name))
+        os.rmdir(local_dir)
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -101,6 +101,54 @@ def run_update(irods_config, cursor):
             # TEXT has no upper limit on the number of bytes it can hold.
             database_connect.execute_sql_statement(cursor, "alter table R_RULE_EXEC add column exe_context text;")
 
+    elif new_schema_version == 9:
+        # Usage is now added to R_QUOTA_USAGE incrementally, which requires a single row
+        # per user and resource. Rows left by concurrent recalculations describe the same
+        # usage, so keep the largest.
+        sql = ("select user_id, resc_id, max(quota_usage), max(modify_ts) from R_QUOTA_USAGE "
+               "group by user_id, resc_id having count(*) > 1;")
+        rows = database_connect.execute_sql_statement(cursor, sql).fetchall()
+        for row in rows:
+            database_connect.execute_sql_statement(cursor, "delete from R_QUOTA_USAGE where user_id = ? and resc_id = ?;", row[0], row[1])
+            database_connect.execute_sql_statement(cursor, "insert into R_QUOTA_USAGE (user_id, resc_id, quota_usage, modify_ts) values (?,?,?,?);", row[0], row[1], row[2], row[3])
+        database_connect.execute_sql_statement(cursor, "create unique index idx_quota_usage1 on R_QUOTA_USAGE (user_id, resc_id);")
+
+    elif new_schema_version == 10:
+        # R_COLL_HIERARCHY links every collection to itself (at depth 0) and to each of its
+        # ancestors, so that subtrees can be found without matching collection names.
+        if irods_config.catalog_database_type == 'oracle':
+            database_connect.execute_sql_statement(cursor, "create table R_COLL_HIERARCHY (ancestor_id integer not null, coll_id integer not null, depth integer not null);")
+        else:
+            database_connect.execute_sql_statement(cursor, "create table R_COLL_HIERARCHY (ancestor_id bigint not null, coll_id bigint not null, depth integer not null);")
+        database_connect.execute_sql_statement(cursor, "insert into R_COLL_HIERARCHY (ancestor_id, coll_id, depth) select coll_id, coll_id, 0 from R_COLL_MAIN;")
+        depth = 0
+        while database_connect.execute_sql_statement(cursor, "select count(*) from R_COLL_HIERARCHY where depth = ?;", depth).fetchone()[0] > 0:
+            depth += 1
+            database_connect.execute_sql_statement(cursor,
+                "insert into R_COLL_HIERARCHY (ancestor_id, coll_id, depth) "
+                "select H.ancestor_id, C.coll_id, ? from R_COLL_HIERARCHY H, R_COLL_MAIN P, R_COLL_MAIN C "
+                "where H.depth = ? and H.coll_id = P.coll_id and C.parent_coll_name = P.coll_name and C.coll_id != P.coll_id;",
+                depth, depth - 1)
+        database_connect.execute_sql_statement(cursor, "create unique index idx_coll_hierarchy1 on R_COLL_HIERARCHY (ancestor_id, coll_id);")
+        database_connect.execute_sql_statement(cursor, "create index idx_coll_hierarchy2 on R_COLL_HIERARCHY (coll_id);")
+
+    elif new_schema_version == 11:
+        # Maps the AVUs found through idx_meta_main2 and idx_meta_main3 to their objects without
+        # reading the table, which is how GenQuery evaluates the second and later AVU conditions
+        # of a query. R_META_MAIN gets no composite (name, value) index: the two varchar(2700)
+        # columns together exceed the btree entry size limit of PostgreSQL and Oracle.
+        database_connect.execute_sql_statement(cursor, "create index idx_objt_metamap4 on R_OBJT_METAMAP (meta_id, object_id);")
+
+    elif new_schema_version == 12:
+        # The resource hierarchy version changes whenever a resource is added, modified or
+        # removed. Servers compare it against the version of their cached hierarchy.
+        database_connect.execute_sql_statement(cursor, "insert into R_GRID_CONFIGURATION values ('resource_hierarchy', 'version', '0');")
+        sql = ("insert into R_SPECIFIC_QUERY (alias, sqlStr, create_ts) "
+               "values ('resourceHierarchyVersion', "
+                        "'select option_value from R_GRID_CONFIGURATION where namespace = ''resource_hierarchy'' and option_name = ''version''', "
+                        "'1388534400');")
+        database_connect.execute_sql_statement(cursor, sql)
+
     else:
         raise IrodsError('Upgrade to schema version %d is unsupported.' % (new_schema_version))
 
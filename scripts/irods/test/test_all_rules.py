@@ -6,6 +6,9 @@ import sys
 import getpass
 import tempfile
 import json
+import struct
+import zipfile
+import zlib
 
 if sys.version_info >= (2, 7):
     import unittest
@@ -1089,6 +1092,73 @@ OUTPUT ruleExecOut
             # Show that even though no data object was created, the PEPs fired correctly.
             self.admin.assert_icommand(['imeta', 'ls', '-d', data_object], 'STDOUT', ['touch_pre_fired', 'touch_post_fired'])
 
+    @unittest.skipIf(test.settings.RUN_IN_TOPOLOGY, "Skip for Topology Testing")
+    @unittest.skipUnless(plugin_name == 'irods_rule_engine_plugin-irods_rule_language', 'only applicable for irods_rule_language REP')
+    def test_msi_catalog_export_writes_a_snapshot_of_the_catalog(self):
+        def read_column(archive, table, column, row_groups):
+            # Each value is a little-endian 32-bit length followed by its bytes.
+            values = []
+            for group in range(row_groups):
+                # Each column entry is a gzip stream of its own.
+                data = zlib.decompress(archive.read('{0}/{1:06d}/{2}.gz'.format(table, group, column)), 16 + zlib.MAX_WBITS)
+                offset = 0
+                while offset < len(data):
+                    length = struct.unpack_from('<I', data, offset)[0]
+                    offset += 4
+                    if length == 0xFFFFFFFF:
+                        values.append(None)
+                    else:
+                        values.append(data[offset:offset + length].decode('utf-8'))
+                        offset += length
+            return values
+
+        data_object = os.path.join(self.admin.session_collection, 'catalog_export_object')
+        self.admin.assert_icommand(['istream', 'write', data_object], input='catalog export')
+        self.admin.assert_icommand(['imeta', 'add', '-d', data_object, 'catalog_export_attr', 'catalog_export_value'])
+
+        output_dir = tempfile.mkdtemp()
+        output_path = os.path.join(output_dir, 'catalog.zip')
+
+        try:
+            rep_name = 'irods_rule_engine_plugin-irods_rule_language-instance'
+            json_input = json.dumps({'output_path': output_path, 'number_of_threads': 2, 'rows_per_row_group': 2})
+            rule = "msi_catalog_export('{0}', *out); writeLine('stdout', *out)".format(json_input)
+            _, out, _ = self.admin.assert_icommand(['irule', '-r', rep_name, rule, 'null', 'ruleExecOut'], 'STDOUT', ['rows_per_second'])
+            result = json.loads(out)
+            self.assertEqual(result['output_path'], output_path)
+
+            with zipfile.ZipFile(output_path) as archive:
+                manifest = json.loads(archive.read('manifest.json').decode('utf-8'))
+                tables = manifest['tables']
+                self.assertEqual(sorted(tables.keys()), ['R_COLL_MAIN', 'R_DATA_MAIN', 'R_META_MAIN', 'R_OBJT_ACCESS', 'R_OBJT_METAMAP'])
+
+                for name, table in tables.items():
+                    self.assertEqual(table['rows'], result['tables'][name]['rows'])
+                    for column in table['columns']:
+                        self.assertEqual(len(read_column(archive, name, column, table['row_groups'])), table['rows'])
+
+                data_names = read_column(archive, 'R_DATA_MAIN', 'data_name', tables['R_DATA_MAIN']['row_groups'])
+                self.assertIn(os.path.basename(data_object), data_names)
+
+                attribute_names = read_column(archive, 'R_META_MAIN', 'meta_attr_name', tables['R_META_MAIN']['row_groups'])
+                self.assertIn('catalog_export_attr', attribute_names)
+
+            # An existing file is only replaced when asked to.
+            self.admin.assert_icommand(['irule', '-r', rep_name, rule, 'null', 'ruleExecOut'], 'STDERR', ['OVERWRITE_WITHOUT_FORCE_FLAG'])
+
+            json_input = json.dumps({'output_path': output_path, 'tables': ['R_COLL_MAIN'], 'overwrite': True})
+            rule = "msi_catalog_export('{0}', *out); writeLine('stdout', *out)".format(json_input)
+            self.admin.assert_icommand(['irule', '-r', rep_name, rule, 'null', 'ruleExecOut'], 'STDOUT', ['R_COLL_MAIN'])
+
+            with zipfile.ZipFile(output_path) as archive:
+                manifest = json.loads(archive.read('manifest.json').decode('utf-8'))
+                self.assertEqual(list(manifest['tables'].keys()), ['R_COLL_MAIN'])
+
+            # Only administrators can export the catalog.
+            self.user0.assert_icommand(['irule', '-r', rep_name, rule, 'null', 'ruleExecOut'], 'STDERR', ['CAT_INSUFFICIENT_PRIVILEGE_LEVEL'])
+        finally:
+            shutil.rmtree(output_dir, ignore_errors=True)
+
     @unittest.skipIf(test.settings.RUN_IN_TOPOLOGY, "Skip for Topology Testing")
     @unittest.skipIf(plugin_name == 'irods_rule_engine_plugin-python', 'Skip for PREP and Topology Testing')
     def test_msiExit_prints_user_provided_error_information_on_client_side__issue_4463(self):
@@ -190,6 +190,70 @@ class Test_Auth(resource_suite.ResourceBase, unittest.TestCase):
 
         IrodsController().restart()
 
+    @unittest.skipIf(test.settings.TOPOLOGY_FROM_RESOURCE_SERVER or test.settings.USE_SSL, 'Topo from resource or SSL')
+    def test_authentication_PAM_with_persistent_helper(self):
+        irods_config = IrodsConfig()
+        server_key_path = os.path.join(irods_config.irods_directory, 'test', 'server.key')
+        server_csr_path = os.path.join(irods_config.irods_directory, 'test', 'server.csr')
+        chain_pem_path = os.path.join(irods_config.irods_directory, 'test', 'chain.pem')
+        dhparams_pem_path = os.path.join(irods_config.irods_directory, 'test', 'dhparams.pem')
+        lib.execute_command(['openssl', 'genrsa', '-out', server_key_path, '1024'])
+        lib.execute_command(['openssl', 'req', '-batch', '-new', '-key', server_key_path, '-out', server_csr_path])
+        lib.execute_command(['openssl', 'req', '-batch', '-new', '-x509', '-key', server_key_path, '-out', chain_pem_path, '-days', '365'])
+        lib.execute_command(['openssl', 'dhparam', '-2', '-out', dhparams_pem_path, '1024'])  # normally 2048, but smaller size here for speed
+
+        service_account_environment_file_path = os.path.join(os.path.expanduser('~'), '.irods', 'irods_environment.json')
+        with lib.file_backed_up(service_account_environment_file_path):
+            irods_config = IrodsConfig()
+            server_update = {
+                'irods_ssl_certificate_chain_file': chain_pem_path,
+                'irods_ssl_certificate_key_file': server_key_path,
+                'irods_ssl_dh_params_file': dhparams_pem_path,
+                'irods_ssl_verify_server': 'none',
+            }
+            lib.update_json_file_from_dict(service_account_environment_file_path, server_update)
+
+            client_update = {
+                'irods_ssl_certificate_chain_file': chain_pem_path,
+                'irods_ssl_certificate_key_file': server_key_path,
+                'irods_ssl_dh_params_file': dhparams_pem_path,
+                'irods_ssl_verify_server': 'none',
+                'irods_authentication_scheme': 'PaM',
+                'irods_client_server_policy': 'CS_NEG_REQUIRE',
+            }
+
+            auth_session_env_backup = copy.deepcopy(self.auth_session.environment_file_contents)
+            self.auth_session.environment_file_contents.update(client_update)
+
+            with lib.file_backed_up(irods_config.server_config_path):
+                server_config_update = {
+                    'authentication' : {
+                        'pam' : {
+                            'password_length': 20,
+                            'no_extend': False,
+                            'password_min_time': 121,
+                            'password_max_time': 1209600,
+                            'helper_worker_count': 4,
+                            }
+                        }
+                    }
+                lib.update_json_file_from_dict(irods_config.server_config_path, server_config_update)
+
+                IrodsController().restart()
+
+                # the test
+                self.auth_session.assert_icommand(['iinit', self.auth_session.password])
+                self.auth_session.assert_icommand("icd")
+                self.auth_session.assert_icommand("ils -L", 'STDOUT_SINGLELINE', "home")
+                self.auth_session.assert_icommand(['iinit', 'not_the_password'], 'STDERR_SINGLELINE', 'PAM_AUTH_PASSWORD_FAILED')
+
+        self.auth_session.environment_file_contents = auth_session_env_backup
+        irods_config = IrodsConfig()
+        for filename in [chain_pem_path, server_key_path, dhparams_pem_path, server_csr_path]:
+            os.unlink(filename)
+
+        IrodsController().restart()
+
     def test_iinit_repaving_2646(self):
         l = logging.getLogger(__name__)
         initial_contents = copy.deepcopy(self.admin.environment_file_contents)
@@ -418,6 +418,56 @@ class Test_ImetaQu(ResourceBase, unittest.TestCase):
                 'STDOUT_MULTILINE', ['collection: .*%s$' % object_name],
                 use_regex=True)
 
+    def test_iquest_multiple_avu_conditions_match_each_avu_as_a_whole(self):
+        # Each attribute condition must be matched together with the value condition
+        # following it, by the same AVU.
+        avus = {
+            'multi_avu_0': [('target', '1'), ('study_id', '4616'), ('type', 'fastq')],
+            'multi_avu_1': [('target', '1'), ('study_id', '4617'), ('type', 'fastq')],
+            'multi_avu_2': [('target', '4616'), ('study_id', '1'), ('type', 'fastq')],
+            'multi_avu_3': [('target', '1'), ('study_id', '4616'), ('type', 'bam')],
+        }
+        for object_name, pairs in avus.items():
+            self.admin.assert_icommand(['iput', self.testfile, object_name])
+            for attribute, value in pairs:
+                self.admin.assert_icommand(['imeta', 'add', '-d', object_name, attribute, value])
+
+        def find(conditions, columns='DATA_NAME'):
+            query = "select {0} where COLL_NAME = '{1}' and {2}".format(columns, self.admin.session_collection, conditions)
+            out, _, _ = self.admin.run_icommand(['iquest', '--no-page', '%s', query])
+            return sorted(out.split())
+
+        self.assertEqual(['multi_avu_0'],
+                         find("META_DATA_ATTR_NAME = 'target' and META_DATA_ATTR_VALUE = '1' and "
+                              "META_DATA_ATTR_NAME = 'study_id' and META_DATA_ATTR_VALUE = '4616' and "
+                              "META_DATA_ATTR_NAME = 'type' and META_DATA_ATTR_VALUE = 'fastq'"))
+        self.assertEqual(['multi_avu_0', 'multi_avu_1'],
+                         find("META_DATA_ATTR_NAME = 'target' and META_DATA_ATTR_VALUE = '1' and "
+                              "META_DATA_ATTR_NAME = 'type' and META_DATA_ATTR_VALUE = 'fastq'"))
+        self.assertEqual(['multi_avu_0', 'multi_avu_1', 'multi_avu_3'],
+                         find("META_DATA_ATTR_NAME = 'target' and META_DATA_ATTR_VALUE = '1' and "
+                              "META_DATA_ATTR_NAME = 'type' and META_DATA_ATTR_VALUE = 'fastq' || = 'bam'"))
+
+        # The AVU of the first condition can still be selected.
+        self.assertEqual(['4616', '4617'],
+                         find("META_DATA_ATTR_NAME = 'study_id' and META_DATA_ATTR_VALUE like '461%' and "
+                              "META_DATA_ATTR_NAME = 'type' and META_DATA_ATTR_VALUE = 'fastq'",
+                              columns='META_DATA_ATTR_VALUE'))
+
+    def test_iquest_multiple_avu_conditions_match_avus_with_long_attribute_names_and_values(self):
+        # Together, the attribute name and value exceed the size of a btree index entry.
+        attribute = 'a' * 2000
+        value = 'v' * 2000
+        object_name = 'long_avu_object'
+        self.admin.assert_icommand(['iput', self.testfile, object_name])
+        self.admin.assert_icommand(['imeta', 'add', '-d', object_name, attribute, value])
+        self.admin.assert_icommand(['imeta', 'add', '-d', object_name, 'type', 'fastq'])
+
+        query = ("select DATA_NAME where COLL_NAME = '{0}' and "
+                 "META_DATA_ATTR_NAME = 'type' and META_DATA_ATTR_VALUE = 'fastq' and "
+                 "META_DATA_ATTR_NAME = '{1}' and META_DATA_ATTR_VALUE = '{2}'").format(self.admin.session_collection, attribute, value)
+        self.admin.assert_icommand(['iquest', '--no-page', '%s', query], 'STDOUT_SINGLELINE', object_name)
+
 # See issue #5111
 class Test_ImetaLsLongmode(session.make_sessions_mixin([('otherrods', 'rods')], []), unittest.TestCase):
 
@@ -54,3 +54,34 @@ class Test_Imv(session.make_sessions_mixin([('otherrods', 'rods')], []), unittes
         self.assertTrue('-814000 CAT_UNKNOWN_COLLECTION' in stderr)
         self.assertTrue(ec != 0)
 
+
+    def test_imv_and_rename_of_collection_tree_keeps_subtree_queries_consistent(self):
+        def count_under(path):
+            _, out, _ = self.admin.assert_icommand(['iquest', '%s', "select count(COLL_ID) where COLL_NAME like '{0}/%'".format(path)], 'STDOUT')
+            return int(out.strip())
+
+        top = os.path.join(self.admin.session_collection, 'tree')
+        children = [os.path.join(top, 'a_{0}'.format(i)) for i in range(20)]
+        self.admin.assert_icommand(['imkdir', '-p'] + [os.path.join(c, 'b', 'c') for c in children])
+        self.assertEqual(count_under(top), 60)
+        self.assertEqual(count_under(children[0]), 2)
+
+        # Rename the top of the tree and move it under another collection.
+        self.admin.assert_icommand(['imkdir', 'dest'])
+        dest = os.path.join(self.admin.session_collection, 'dest')
+        self.admin.assert_icommand(['imv', top, os.path.join(dest, 'moved')])
+        moved = os.path.join(dest, 'moved')
+        self.assertEqual(count_under(top), 0)
+        self.assertEqual(count_under(moved), 60)
+        self.assertEqual(count_under(dest), 61)
+        self.assertEqual(count_under(os.path.join(moved, 'a_0')), 2)
+
+        # Recursive operations on the moved tree reach every collection in it.
+        self.admin.assert_icommand(['ichmod', '-r', 'inherit', moved])
+        self.admin.assert_icommand(['iquest', '%s', "select count(COLL_ID) where COLL_NAME like '{0}/%' and COLL_INHERITANCE = '1'".format(moved)], 'STDOUT_SINGLELINE', '60')
+
+        # Removing part of the tree leaves the rest intact.
+        self.admin.assert_icommand(['irm', '-rf', os.path.join(moved, 'a_0')])
+        self.assertEqual(count_under(moved), 57)
+        self.admin.assert_icommand(['irm', '-rf', dest])
+        self.assertEqual(count_under(dest), 0)
@@ -8,13 +8,16 @@ else:
     import unittest2 as unittest
 import os
 import datetime
+import json
 import socket
 
 from .. import test
 from . import settings
 from .. import lib
+from .. import paths
 from . import resource_suite
 from ..configuration import IrodsConfig
+from ..controller import IrodsController
 
 
 @unittest.skipIf(test.settings.TOPOLOGY_FROM_RESOURCE_SERVER, 'Registers files on remote resources')
@@ -215,6 +218,49 @@ class Test_Ireg(resource_suite.ResourceBase, unittest.TestCase):
         # Remove the files from iRODS.
         self.admin.assert_icommand('irm -rf {0}'.format(dst_dir))
 
+    @unittest.skipIf(test.settings.RUN_IN_TOPOLOGY, "Skip for Topology Testing")
+    def test_ireg_recursive_bulk_registration(self):
+        server_config_filename = paths.server_config_path()
+        with open(server_config_filename) as f:
+            svr_cfg = json.load(f)
+        svr_cfg['advanced_settings']['bulk_registration_batch_size_in_data_objects'] = 7
+        svr_cfg['advanced_settings']['bulk_registration_number_of_threads'] = 3
+        new_server_config = json.dumps(svr_cfg, sort_keys=True, indent=4, separators=(',', ': '))
+
+        local_dir = os.path.join(self.testing_tmp_dir, 'bulk_registration')
+        directories = lib.make_deep_local_tmp_dir(local_dir, depth=4, files_per_level=20, file_size=10)
+        file_count = sum(len(files) for files in directories.values())
+
+        collection = os.path.join(self.admin.session_collection, 'bulk_registration')
+        count_query = "select count(DATA_ID) where COLL_NAME like '{0}%'".format(collection)
+
+        with lib.file_backed_up(server_config_filename):
+            with open(server_config_filename, 'w') as f:
+                f.write(new_server_config)
+            IrodsController().restart(test_mode=True)
+
+            try:
+                self.admin.assert_icommand(['ireg', '-C', '-R', self.testresc, local_dir, collection])
+                self.admin.assert_icommand(['iquest', '%s', count_query], 'STDOUT_SINGLELINE', str(file_count))
+                self.admin.assert_icommand(['ils', '-L', collection + '/sub0/sub1'], 'STDOUT_SINGLELINE',
+                                           os.path.join(local_dir, 'sub0', 'sub1', 'junk0000'))
+
+                # A forced rerun only registers the files that are not registered yet, including
+                # files in directories whose names contain quotes.
+                lib.make_file(os.path.join(local_dir, 'sub0', 'added'), 10)
+                quoted_dir = os.path.join(local_dir, 'sub0', "it's")
+                os.mkdir(quoted_dir)
+                lib.make_file(os.path.join(quoted_dir, 'added'), 10)
+                self.admin.assert_icommand(['ireg', '-f', '-C', '-R', self.testresc, local_dir, collection])
+                self.admin.assert_icommand(['iquest', '%s', count_query], 'STDOUT_SINGLELINE', str(file_count + 2))
+
+                self.admin.assert_icommand(['ireg', '-f', '-C', '-R', self.testresc, local_dir, collection])
+                self.admin.assert_icommand(['iquest', '%s', count_query], 'STDOUT_SINGLELINE', str(file_count + 2))
+            finally:
+                self.admin.run_icommand(['iunreg', '-r', collection])
+
+        IrodsController().restart(test_mode=True)
+
     def test_ireg_file_with_unresolvable_owner__issue_4040(self):
         filename = '/tmp/irods_unresolvable_uid_testfile__issue_4040'
         fullpath = os.path.abspath(filename)
@@ -1,4 +1,5 @@
 from __future__ import print_function
+import filecmp
 import os
 import sys
 import json
@@ -511,6 +512,38 @@ class test_irepl_with_two_basic_ufs_resources(session.make_sessions_mixin([('oth
         finally:
             user0.run_icommand(['irm', '-f', logical_path])
 
+    def test_irepl_and_icp_between_resources_on_the_same_filesystem_preserve_data(self):
+        # Both vaults live in the same directory tree, so the server copies the data in the kernel.
+        user0 = self.user_sessions[0]
+
+        filename = 'test_irepl_and_icp_between_resources_on_the_same_filesystem_preserve_data'
+        physical_path = os.path.join(user0.local_session_dir, filename)
+        logical_path = os.path.join(user0.session_collection, filename)
+        copied_logical_path = logical_path + '_copy'
+        get_path = physical_path + '_get'
+
+        try:
+            lib.make_file(physical_path, 34603008, contents='random')
+
+            user0.assert_icommand(['iput', '-K', '-R', self.resource_1, physical_path, logical_path])
+            user0.assert_icommand(['irepl', '-R', self.resource_2, logical_path])
+            user0.assert_icommand(['icp', '-K', '-R', self.resource_2, logical_path, copied_logical_path])
+
+            # Verify the checksums of every replica against the data in the vaults.
+            user0.assert_icommand(['ichksum', '-a', '-K', logical_path], 'STDOUT', 'sha2:')
+            user0.assert_icommand(['ichksum', '-K', copied_logical_path], 'STDOUT', 'sha2:')
+
+            for path, resource in [(logical_path, self.resource_2), (copied_logical_path, self.resource_2)]:
+                user0.assert_icommand(['iget', '-f', '-R', resource, path, get_path])
+                self.assertTrue(filecmp.cmp(physical_path, get_path, shallow=False))
+
+        finally:
+            user0.run_icommand(['irm', '-f', logical_path])
+            user0.run_icommand(['irm', '-f', copied_logical_path])
+            for f in [physical_path, get_path]:
+                if os.path.exists(f):
+                    os.unlink(f)
+
 class test_invalid_parameters(session.make_sessions_mixin([('otherrods', 'rods')], [('alice', 'apass')]), unittest.TestCase):
     def setUp(self):
         super(test_invalid_parameters, self).setUp()
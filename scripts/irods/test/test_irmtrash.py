@@ -1,4 +1,5 @@
 from __future__ import print_function
+import json
 import os
 import sys
 
@@ -10,6 +11,8 @@ else:
 from . import session
 from .. import test
 from .. import lib
+from .. import paths
+from ..controller import IrodsController
 
 admins = [('otherrods', 'rods')]
 users  = []
@@ -40,3 +43,46 @@ class Test_Irmtrash(session.make_sessions_mixin(admins, users), unittest.TestCas
         self.admin.assert_icommand(['irmtrash'])
         self.assertTrue(os.path.exists(filepath))
 
+    @unittest.skipIf(test.settings.RUN_IN_TOPOLOGY, "Skip for Topology Testing")
+    def test_bulk_delete_removes_collection_trees(self):
+        server_config_filename = paths.server_config_path()
+        with open(server_config_filename) as f:
+            svr_cfg = json.load(f)
+        svr_cfg['advanced_settings']['bulk_delete_batch_size_in_data_objects'] = 7
+        svr_cfg['advanced_settings']['bulk_delete_number_of_threads'] = 3
+        new_server_config = json.dumps(svr_cfg, sort_keys=True, indent=4, separators=(',', ': '))
+
+        local_dir = os.path.join(self.admin.local_session_dir, 'bulk_delete')
+        lib.make_deep_local_tmp_dir(local_dir, depth=3, files_per_level=20, file_size=10)
+
+        # A file outside of the vault must be left on disk, as with the per-object path.
+        registered_file = os.path.join(self.admin.local_session_dir, 'registered')
+        lib.make_file(registered_file, 1024, 'arbitrary')
+
+        with lib.file_backed_up(server_config_filename):
+            with open(server_config_filename, 'w') as f:
+                f.write(new_server_config)
+            IrodsController().restart(test_mode=True)
+
+            try:
+                for remove in [['irm', '-rf'], ['irm', '-r']]:
+                    collection = os.path.join(self.admin.session_collection, 'bulk_delete')
+                    vault_dir = os.path.join(self.admin.get_vault_session_path(), 'bulk_delete')
+
+                    self.admin.assert_icommand(['iput', '-r', local_dir, collection])
+                    self.admin.assert_icommand(['ireg', registered_file, collection + '/registered'])
+                    self.assertTrue(os.path.exists(vault_dir))
+
+                    self.admin.assert_icommand(remove + [collection])
+                    if '-f' not in remove:
+                        self.admin.assert_icommand(['irmtrash'])
+
+                    self.admin.assert_icommand(['ils', collection], 'STDERR_SINGLELINE', 'does not exist')
+                    self.admin.assert_icommand(['iquest', '%s', "select count(DATA_ID) where COLL_NAME like '%/bulk_delete%'"],
+                                               'STDOUT_SINGLELINE', '0')
+                    self.assertFalse(any(files for _, _, files in os.walk(vault_dir)))
+                    self.assertTrue(os.path.exists(registered_file))
+            finally:
+                self.admin.run_icommand(['irm', '-rf', os.path.join(self.admin.session_collection, 'bulk_delete')])
+
+        IrodsController().restart(test_mode=True)
@@ -106,6 +106,19 @@ class Test_iRsync(ResourceBase, unittest.TestCase):
                             msg="Files missing:\n" + str(local_files - rods_files) + "\n\n" +
                             "Extra files:\n" + str(rods_files - local_files))
 
+    def test_irsync_r_dir_to_coll_with_quote_in_name(self):
+        # The collection name must not change the queries which build the manifest
+        base_name = "it's a test_irsync_r_dir_to_coll and more"
+        local_dir = os.path.join(self.testing_tmp_dir, base_name)
+        lib.make_large_local_tmp_dir(local_dir, 5, 100)
+        lib.make_large_local_tmp_dir(os.path.join(local_dir, "sub'dir"), 5, 100)
+
+        self.user0.assert_icommand(['irsync', '-r', local_dir, 'i:' + base_name], 'STDOUT_SINGLELINE', ustrings.recurse_ok_string())
+        self.user0.assert_icommand(['ils', base_name + "/sub'dir"], 'STDOUT_SINGLELINE', 'junk0004')
+
+        out, _, _ = self.user0.run_icommand(['irsync', '-v', '-r', '-l', local_dir, 'i:' + base_name])
+        self.assertEqual(10, out.count('a match no sync required'))
+
     def test_irsync_r_nested_dir_to_coll_large_files(self):
         # test settings
         depth = 4
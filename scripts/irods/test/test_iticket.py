@@ -1,3 +1,4 @@
+import json
 import os
 import re
 import sys
@@ -10,8 +11,10 @@ else:
     import unittest
 
 from .. import lib
+from .. import paths
 from . import session
 from .. import test
+from ..controller import IrodsController
 
 SessionsMixin = session.make_sessions_mixin([('otherrods', 'apass')], [('alice', 'password'), ('anonymous', None)])
 
@@ -455,3 +458,61 @@ class Test_Iticket(SessionsMixin, unittest.TestCase):
         do_test_write_byte_count_updated(self, 1024) # 1 KiB
         do_test_write_byte_count_updated(self, 40 * 1024 * 1024) #40 MiB
 
+    @unittest.skipIf(test.settings.TOPOLOGY_FROM_RESOURCE_SERVER, 'Changes server_config.json of the catalog service provider')
+    def test_cached_access_verdicts_are_invalidated_by_ticket_permission_and_path_changes(self):
+        server_config_filename = paths.server_config_path()
+        with open(server_config_filename) as f:
+            svr_cfg = json.load(f)
+        svr_cfg['advanced_settings']['access_verdict_cache'] = {
+            'shared_memory_size_in_bytes': 1000000,
+            'time_to_live_in_seconds': 600,
+            'maximum_entries_per_agent': 1000
+        }
+        new_server_config = json.dumps(svr_cfg, sort_keys=True, indent=4, separators=(',', ': '))
+
+        filename = 'verdict_cache_file'
+        filepath = os.path.join(self.admin.local_session_dir, filename)
+        lib.make_file(filepath, 1)
+        data_obj = self.admin.session_collection + '/' + filename
+        ticket = 'verdict_cache_ticket'
+        ticket_coll = self.admin.session_collection + '/verdict_cache_coll'
+        moved_data_obj = ticket_coll + '/' + filename
+
+        with lib.file_backed_up(server_config_filename):
+            with open(server_config_filename, 'w') as f:
+                f.write(new_server_config)
+            IrodsController().restart(test_mode=True)
+
+            try:
+                self.admin.assert_icommand(['iput', filepath, data_obj])
+
+                # Repeated reads through a ticket reuse the verdict until the ticket changes.
+                self.admin.assert_icommand(['iticket', 'create', 'read', data_obj, ticket])
+                self.user.assert_icommand(['iget', '-t', ticket, data_obj, '-'], 'STDOUT')
+                self.user.assert_icommand(['iget', '-t', ticket, data_obj, '-'], 'STDOUT')
+                self.admin.assert_icommand(['iticket', 'mod', ticket, 'add', 'host', '192.0.2.1'])
+                self.user.assert_icommand(['iget', '-t', ticket, data_obj, '-'], 'STDERR')
+                self.admin.assert_icommand(['iticket', 'delete', ticket])
+
+                # Repeated reads through a permission reuse the verdict until it is removed.
+                self.admin.assert_icommand(['ichmod', 'read', self.user.username, data_obj])
+                self.user.assert_icommand(['iget', data_obj, '-'], 'STDOUT')
+                self.user.assert_icommand(['iget', data_obj, '-'], 'STDOUT')
+                self.admin.assert_icommand(['ichmod', 'null', self.user.username, data_obj])
+                self.user.assert_icommand(['iget', data_obj, '-'], 'STDERR')
+
+                # Moving the data object out of the collection of a ticket ends access through the ticket.
+                self.admin.assert_icommand(['imkdir', ticket_coll])
+                self.admin.assert_icommand(['imv', data_obj, ticket_coll])
+                self.admin.assert_icommand(['iticket', 'create', 'read', ticket_coll, ticket])
+                self.user.assert_icommand(['iget', '-t', ticket, moved_data_obj, '-'], 'STDOUT')
+                self.user.assert_icommand(['iget', '-t', ticket, moved_data_obj, '-'], 'STDOUT')
+                self.admin.assert_icommand(['imv', moved_data_obj, data_obj])
+                self.user.assert_icommand(['iget', '-t', ticket, data_obj, '-'], 'STDERR')
+            finally:
+                self.admin.run_icommand(['iticket', 'delete', ticket])
+                self.admin.run_icommand(['irm', '-f', data_obj])
+                self.admin.run_icommand(['irm', '-rf', ticket_coll])
+                os.unlink(filepath)
+
+        IrodsController().restart(test_mode=True)
@@ -26,7 +26,7 @@ class Test_LoadBalanced_Resource(resource_suite.ResourceBase, unittest.TestCase)
         with session.make_session_for_existing_admin() as admin_session:
             context_prefix = lib.get_hostname() + ':' + IrodsConfig().irods_directory
             admin_session.assert_icommand('iadmin modresc demoResc name origResc', 'STDOUT_SINGLELINE', 'rename', input='yes\n')
-            admin_session.assert_icommand('iadmin mkresc demoResc load_balanced', 'STDOUT_SINGLELINE', 'load_balanced')
+            admin_session.assert_icommand("iadmin mkresc demoResc load_balanced '' 'load_source=catalog'", 'STDOUT_SINGLELINE', 'load_balanced')
             admin_session.assert_icommand('iadmin mkresc rescA "unixfilesystem" ' + context_prefix + '/rescAVault', 'STDOUT_SINGLELINE', 'unixfilesystem')
             admin_session.assert_icommand('iadmin mkresc rescB "unixfilesystem" ' + context_prefix + '/rescBVault', 'STDOUT_SINGLELINE', 'unixfilesystem')
             admin_session.assert_icommand('iadmin mkresc rescC "unixfilesystem" ' + context_prefix + '/rescCVault', 'STDOUT_SINGLELINE', 'unixfilesystem')
@@ -112,3 +112,41 @@ class Test_LoadBalanced_Resource(resource_suite.ResourceBase, unittest.TestCase)
                     self.admin.assert_icommand("irm -f " + test_file)
         else:
             raise RuntimeError('unsupported database type {0}'.format(cfg.catalog_database_type))
+
+    @unittest.skipIf(test.settings.TOPOLOGY_FROM_RESOURCE_SERVER, "Skip for topology testing from resource server")
+    def test_load_balanced_prefers_live_load_samples(self):
+        # the catalog seeds rescA as the least loaded child, but the live
+        # samples take precedence once the catalog is no longer requested.
+        # rescD lives on a separate file system, so weighting only by free
+        # space selects whichever of the two file systems has more room.
+        shm_vault = '/dev/shm/rescDVault'
+        with session.make_session_for_existing_admin() as admin_session:
+            admin_session.assert_icommand('iadmin mkresc rescD "unixfilesystem" ' + lib.get_hostname() + ':' + shm_vault, 'STDOUT_SINGLELINE', 'unixfilesystem')
+            admin_session.assert_icommand('iadmin addchildtoresc demoResc rescD')
+            admin_session.assert_icommand('iadmin modresc demoResc context "agent_weight=0;io_weight=0;queue_weight=0;free_space_weight=1"')
+
+        try:
+            # wait for the server to publish samples for the new resources
+            time.sleep(35)
+
+            local_filepath = os.path.join(self.admin.local_session_dir, 'things.txt')
+            lib.make_file(local_filepath, 500, 'arbitrary')
+            test_file = self.admin.session_collection + "/test_file.txt"
+
+            irods_directory_stat = os.statvfs(IrodsConfig().irods_directory)
+            shm_stat = os.statvfs('/dev/shm')
+            irods_directory_free_space = irods_directory_stat.f_bavail * irods_directory_stat.f_frsize
+            shm_free_space = shm_stat.f_bavail * shm_stat.f_frsize
+
+            self.admin.assert_icommand("iput -f %s %s" % (local_filepath, test_file))
+            if shm_free_space > irods_directory_free_space:
+                self.admin.assert_icommand("ils -L " + test_file, 'STDOUT_SINGLELINE', "rescD")
+            else:
+                self.admin.assert_icommand_fail("ils -L " + test_file, 'STDOUT_SINGLELINE', "rescD")
+            self.admin.assert_icommand("irm -f " + test_file)
+
+        finally:
+            with session.make_session_for_existing_admin() as admin_session:
+                admin_session.assert_icommand("iadmin rmchildfromresc demoResc rescD")
+                admin_session.assert_icommand("iadmin rmresc rescD")
+            shutil.rmtree(shm_vault, ignore_errors=True)
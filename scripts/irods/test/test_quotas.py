@@ -82,6 +82,21 @@ class Test_Quotas(resource_suite.ResourceBase, unittest.TestCase):
         # When fixed, will show the actual value, and so the string below will not match and the assert will fail
         self.admin.assert_icommand_fail(['iquota', '-u', self.admin.username], 'STDOUT_SINGLELINE', 'Over:  -10,000,000 (-10 million) bytes')
 
+    def test_usage_is_updated_without_recalculation(self):
+        filename = 'test_usage_is_updated_without_recalculation'
+        lib.make_file(filename, 1024, contents='arbitrary')
+        try:
+            for quotatype in [['suq', self.admin.username], ['sgq', 'public']]: # user and group
+                self.admin.assert_icommand(['iadmin', quotatype[0], quotatype[1], self.testresc, '40'])
+                self.admin.assert_icommand(['iquota'], 'STDOUT_SINGLELINE', 'Nearing quota') # not over yet
+                self.admin.assert_icommand(['iput', '-R', self.testresc, filename])
+                self.admin.assert_icommand(['iquota'], 'STDOUT_SINGLELINE', 'OVER QUOTA') # no 'iadmin cu' needed
+                self.admin.assert_icommand(['irm', '-f', filename])
+                self.admin.assert_icommand(['iquota'], 'STDOUT_SINGLELINE', 'Nearing quota') # usage removed
+                self.admin.assert_icommand(['iadmin', quotatype[0], quotatype[1], self.testresc, '0'])
+        finally:
+            os.unlink(filename)
+
     def test_filter_out_groups_when_selecting_user__issue_3507(self):
         self.admin.assert_icommand(['igroupadmin', 'mkgroup', 'test_group_3507'])
 
@@ -3290,6 +3290,34 @@ class Test_Resource_Replication(ChunkyDevTest, ResourceSuite, unittest.TestCase)
         shutil.rmtree(irods_config.irods_directory + "/unix2RescVault", ignore_errors=True)
         shutil.rmtree(irods_config.irods_directory + "/unix3RescVault", ignore_errors=True)
 
+    def test_put_replicates_to_every_child_from_one_source_replica(self):
+        data_object = 'foo'
+        local_file = os.path.join(tempfile.gettempdir(), 'test_put_replicates_to_every_child_from_one_source_replica')
+        retrieved_file = local_file + '.get'
+
+        # The second size exceeds maximum_size_for_single_buffer_in_megabytes (32 MB).
+        for file_size_in_bytes in [1024, 40 * 1024 * 1024]:
+            try:
+                lib.make_file(local_file, file_size_in_bytes, 'random')
+                self.admin.assert_icommand(['iput', '-f', local_file, data_object])
+
+                gql = "select DATA_REPL_NUM, DATA_SIZE, DATA_REPL_STATUS where COLL_NAME = '{0}' and DATA_NAME = '{1}'"
+                _, out, _ = self.admin.assert_icommand(['iquest', '%s:%s:%s', gql.format(self.admin.session_collection, data_object)], 'STDOUT')
+                replicas = sorted(out.split())
+                self.assertEqual(replicas, ['{0}:{1}:1'.format(i, file_size_in_bytes) for i in range(self.child_replication_count)])
+
+                # Every replica holds the contents of the local file.
+                digest = lib.file_digest(local_file, 'sha256')
+                for replica_number in range(self.child_replication_count):
+                    self.admin.assert_icommand(['iget', '-f', '-n', str(replica_number), data_object, retrieved_file])
+                    self.assertEqual(digest, lib.file_digest(retrieved_file, 'sha256'))
+
+            finally:
+                self.admin.run_icommand(['irm', '-f', data_object])
+                for path in [local_file, retrieved_file]:
+                    if os.path.exists(path):
+                        os.unlink(path)
+
     def test_checksums_are_erased_or_replaced_on_overwrite__issue_5496(self):
         def get_checksum(data_object):
             gql = "select DATA_CHECKSUM where COLL_NAME = '{0}' and DATA_NAME = '{1}'"
@@ -3925,7 +3953,7 @@ OUTPUT ruleExecOut
 
     def test_rebalance_batching_replica_creation__3570(self):
         filename = 'test_rebalance_batching_replica_creation__3570'
-        default_rebalance_batch_size = 500 # from librepl.cpp
+        default_rebalance_batch_size = 500 # from irods_repl_rebalance.hpp
         num_data_objects_to_use = default_rebalance_batch_size + 10
         file_size = 400
         lib.make_file(filename, file_size)
@@ -3942,7 +3970,7 @@ OUTPUT ruleExecOut
 
     def test_rebalance_batching_replica_update__3570(self):
         filename = 'test_rebalance_batching_replica_update__3570'
-        default_rebalance_batch_size = 500 # from librepl.cpp
+        default_rebalance_batch_size = 500 # from irods_repl_rebalance.hpp
         num_data_objects_to_use = default_rebalance_batch_size + 10
         file_size = 327
         lib.make_file(filename, file_size)
@@ -3975,6 +4003,50 @@ OUTPUT ruleExecOut
         self.assertEqual(num_out_of_date, 0)
         os.unlink(filename)
 
+    def test_rebalance_with_worker_pool_and_throttle(self):
+        filename = 'test_rebalance_with_worker_pool_and_throttle'
+        num_data_objects_to_use = 25
+        file_size = 4096
+        lib.make_file(filename, file_size)
+        for i in range(num_data_objects_to_use):
+            self.admin.assert_icommand(['iput', filename, filename + '_' + str(i)])
+            self.admin.assert_icommand(['itrim', '-S', 'demoResc', '-N1', filename + '_' + str(i)], 'STDOUT_SINGLELINE', 'Number of files trimmed = 1.')
+
+        context = 'rebalance_worker_count=4;rebalance_max_replicas_per_child=2;rebalance_max_bytes_per_second=1048576;replication_rebalance_limit=10'
+        self.admin.assert_icommand(['iadmin', 'modresc', 'demoResc', 'context', context])
+        self.admin.assert_icommand(['iadmin', 'modresc', 'demoResc', 'rebalance'])
+
+        _, out, _ = self.admin.assert_icommand(['ils', '-l'], 'STDOUT_SINGLELINE', filename)
+        self.assertEqual(len(out.split('\n')), 3*num_data_objects_to_use + 6)
+
+        # a completed rebalance leaves no checkpoint behind
+        self.admin.assert_icommand_fail(['imeta', 'ls', '-R', 'demoResc'], 'STDOUT_SINGLELINE', 'rebalance_checkpoint')
+        os.unlink(filename)
+
+    def test_rebalance_resumes_from_checkpoint(self):
+        filename = 'test_rebalance_resumes_from_checkpoint'
+        num_data_objects_to_use = 10
+        lib.make_file(filename, 400)
+        for i in range(num_data_objects_to_use):
+            self.admin.assert_icommand(['iput', filename, filename + '_' + str(i)])
+            self.admin.assert_icommand(['itrim', '-S', 'demoResc', '-N1', filename + '_' + str(i)], 'STDOUT_SINGLELINE', 'Number of files trimmed = 1.')
+
+        # pretend a previous rebalance was interrupted after handling every data object on every child
+        _, out, _ = self.admin.assert_icommand(['iquest', '%s', "select DATA_ID where DATA_NAME = '{0}_{1}'".format(filename, num_data_objects_to_use - 1)], 'STDOUT')
+        self.admin.assert_icommand(['imeta', 'set', '-R', 'demoResc', 'rebalance_checkpoint', 'create_missing_replicas:unix3Resc:{0}'.format(out.strip()), 'replicas=0,bytes=0'])
+        self.admin.assert_icommand(['iadmin', 'modresc', 'demoResc', 'rebalance'])
+
+        # nothing past the checkpoint needed replicating, and the checkpoint is consumed
+        _, out, _ = self.admin.assert_icommand(['ils', '-l'], 'STDOUT_SINGLELINE', filename)
+        self.assertEqual(len(out.split('\n')), num_data_objects_to_use + 6)
+        self.admin.assert_icommand_fail(['imeta', 'ls', '-R', 'demoResc'], 'STDOUT_SINGLELINE', 'rebalance_checkpoint')
+
+        # without a checkpoint the whole resource is scanned again
+        self.admin.assert_icommand(['iadmin', 'modresc', 'demoResc', 'rebalance'])
+        _, out, _ = self.admin.assert_icommand(['ils', '-l'], 'STDOUT_SINGLELINE', filename)
+        self.assertEqual(len(out.split('\n')), 3*num_data_objects_to_use + 6)
+        os.unlink(filename)
+
     def test_irepl_to_consumer_repl_hier_from_provider__4319(self):
         filename = 'test_irepl_to_consumer_repl_hier_from_provider__4319'
         lib.make_file(filename, 1 * 1024 * 1024 + 1)
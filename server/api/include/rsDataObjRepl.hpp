@@ -5,8 +5,17 @@
 #include "dataObjInpOut.h"
 #include "objInfo.h"
 
+#include <string>
+#include <vector>
+
 int rsDataObjRepl( rsComm_t *rsComm, dataObjInp_t *dataObjInp, transferStat_t **transferStat );
 int dataObjCopy( rsComm_t *rsComm, int l1descInx );
+
+// Replicates a data object in the local zone to each of the destination hierarchies, one
+// after another. The source replica is opened once and read again for each destination. The
+// result of each destination is stored in the corresponding element of statuses. Returns the
+// first error encountered.
+int dataObjReplToMany( rsComm_t *rsComm, dataObjInp_t *dataObjInp, const std::vector<std::string>& destinationHierarchies, std::vector<int>& statuses );
 int replToCacheRescOfCompObj( rsComm_t *rsComm, dataObjInp_t *dataObjInp, dataObjInfo_t *srcDataObjInfoHead, dataObjInfo_t *compObjInfo, dataObjInfo_t *oldDataObjInfo, dataObjInfo_t **outDestDataObjInfo );
 int unbunAndStageBunfileObj(rsComm_t* rsComm, const char* bunfileObjPath, char** outCacheRescName);
 int _unbunAndStageBunfileObj( rsComm_t *rsComm, dataObjInfo_t **bunfileObjInfoHead, keyValPair_t* condInput, char **outCacheRescName, int rmBunCopyFlag );
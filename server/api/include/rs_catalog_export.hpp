@@ -0,0 +1,31 @@
+#ifndef IRODS_RS_CATALOG_EXPORT_HPP
+#define IRODS_RS_CATALOG_EXPORT_HPP
+
+/// \file
+
+struct RsComm;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Writes a consistent snapshot of catalog tables to a compressed columnar file.
+///
+/// See rc_catalog_export() for the JSON structures and the file format.
+///
+/// \param[in]  _comm        A pointer to a RsComm.
+/// \param[in]  _json_input  A JSON string describing the export.
+/// \param[out] _json_output A JSON string describing the result.
+///
+/// \return An integer.
+/// \retval 0        On success.
+/// \retval non-zero On failure.
+///
+/// \since 4.3.0
+int rs_catalog_export(RsComm* _comm, const char* _json_input, char** _json_output);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // IRODS_RS_CATALOG_EXPORT_HPP
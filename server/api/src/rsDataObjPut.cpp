@@ -91,6 +91,13 @@ namespace
         return {};
     } // calculate_checksum
 
+    auto start_inline_checksum_if_required(const l1desc& _l1desc) -> void
+    {
+        if (REG_CHKSUM == _l1desc.chksumFlag || VERIFY_CHKSUM == _l1desc.chksumFlag) {
+            irods::start_inline_checksum(_l1desc);
+        }
+    } // start_inline_checksum_if_required
+
     auto finalize_on_failure(RsComm& _comm, DataObjInfo& _info, l1desc& _l1desc) -> int
     {
         const auto admin_op = irods::experimental::make_key_value_proxy(_l1desc.dataObjInp->condInput).contains(ADMIN_KW);
@@ -267,6 +274,8 @@ namespace
         auto opened_replica = irods::experimental::replica::make_replica_proxy(*l1desc.dataObjInfo);
         const std::string hier = opened_replica.hierarchy().data();
 
+        start_inline_checksum_if_required(l1desc);
+
         OpenedDataObjInp write_inp{};
         write_inp.len = _bbuf.len;
         write_inp.l1descInx = fd;
@@ -432,6 +441,13 @@ namespace
             return ec;
         }
 
+        // Only a single portal thread writes through the L3 descriptor of this replica. Any
+        // other threads open their own, so the inline checksum would not see their segments
+        // and the replica would be read back anyway.
+        if ((*portalOprOut)->numThreads <= 1) {
+            start_inline_checksum_if_required(l1desc);
+        }
+
         const bool all_replicas = getValByKey(&dataObjInp->condInput, ALL_KW);
         dataObjInp_t replDataObjInp{};
 
@@ -22,6 +22,7 @@
 #include "rsDataObjClose.hpp"
 #include "rsDataObjCreate.hpp"
 #include "rsDataObjGet.hpp"
+#include "rsDataObjLseek.hpp"
 #include "rsDataObjOpen.hpp"
 #include "rsDataObjPut.hpp"
 #include "rsDataObjRead.hpp"
@@ -63,6 +64,7 @@
 #include "logical_locking.hpp"
 
 #include <algorithm>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -471,7 +473,19 @@ namespace
         _inp.oprType = REPLICATE_DEST;
         _inp.openFlags = O_CREAT | O_WRONLY | O_TRUNC;
 
-        return rsDataObjOpen(&_comm, &_inp);
+        const int fd = rsDataObjOpen(&_comm, &_inp);
+
+        // Finalizing the destination replica computes its checksum if either replica has one.
+        if (fd >= 3) {
+            const auto& destination = L1desc[fd];
+            if (destination.chksumFlag ||
+                std::string_view{L1desc[_source_fd].dataObjInfo->chksum}.length() > 0 ||
+                std::string_view{destination.dataObjInfo->chksum}.length() > 0) {
+                irods::start_inline_checksum(destination);
+            }
+        }
+
+        return fd;
     } // open_destination_replica
 
     int replicate_data(RsComm& _comm, DataObjInp& _source_inp, DataObjInp& _destination_inp, transferStat_t** _stat)
@@ -658,22 +672,236 @@ namespace
         return status;
     } // replicate_data
 
-    int replicate_data_object(RsComm& _comm, DataObjInp& _inp, transferStat_t** _stat)
+    int rewind_replica(RsComm& _comm, const int _l1descInx)
     {
-        const auto cond_input = irods::experimental::make_key_value_proxy(_inp.condInput);
+        OpenedDataObjInp input{};
+        input.l1descInx = _l1descInx;
+        input.offset = 0;
+        input.whence = SEEK_SET;
+
+        FileLseekOut* output{};
+        const irods::at_scope_exit free_output{[&output] { free(output); }};
+
+        return rsDataObjLseek(&_comm, &input, &output);
+    } // rewind_replica
+
+    // The source replica is only opened for read, so the data object may be modified by another
+    // agent between the finalization of one destination replica and the open of the next one.
+    // Opening a destination replica inserts the current catalog state of the data object into the
+    // replica state table, which is compared with the state of the source replica when it was opened.
+    auto source_replica_is_unchanged(const DataObjInfo& _source_info) -> bool
+    {
+        if (!rst::contains(_source_info.dataId, _source_info.replNum)) {
+            return false;
+        }
 
-        // get information about source replica
-        auto source_inp = init_source_replica_input(_comm, _inp);
-        const irods::at_scope_exit free_source_cond_input{[&source_inp]() { clearKeyVal(&source_inp.condInput); }};
-        auto source_cond_input = irods::experimental::make_key_value_proxy(source_inp.condInput);
-        auto source_obj = resolve_hierarchy_and_get_data_object_info(_comm, source_inp, irods::OPEN_OPERATION);
-        auto& source_replica = get_replica_with_hierarchy(
-            _comm, source_obj, source_cond_input.at(RESC_HIER_STR_KW).value(),
-            irods::replication::log_errors::yes);
+        const auto source = rst::at(_source_info.dataId, _source_info.replNum, rst::state_type::before);
+
+        return source.at("data_size").get<std::string>() == std::to_string(_source_info.dataSize) &&
+               source.at("data_checksum").get<std::string>() == _source_info.chksum &&
+               source.at("modify_ts").get<std::string>() == _source_info.dataModify;
+    } // source_replica_is_unchanged
+
+    int replicate_data_to_destination(RsComm& _comm, const int _source_l1descInx, DataObjInp& _destination_inp)
+    {
+        const int destination_l1descInx = open_destination_replica(_comm, _destination_inp, _source_l1descInx);
+        if (destination_l1descInx < 0) {
+            return destination_l1descInx;
+        }
+
+        auto& source_data_obj_info = *L1desc[_source_l1descInx].dataObjInfo;
+        auto& destination_data_obj_info = *L1desc[destination_l1descInx].dataObjInfo;
+
+        irods::log(LOG_DEBUG8, fmt::format(
+            "[{}:{}] - source:[{}], destination:[{}]",
+            __FUNCTION__, __LINE__,
+            source_data_obj_info.rescHier,
+            destination_data_obj_info.rescHier));
+
+        L1desc[destination_l1descInx].srcL1descInx = _source_l1descInx;
+        L1desc[destination_l1descInx].dataSize = source_data_obj_info.dataSize;
+        L1desc[destination_l1descInx].dataObjInp->dataSize = source_data_obj_info.dataSize;
+
+        int status = 0;
+
+        if (!source_replica_is_unchanged(source_data_obj_info)) {
+            irods::log(LOG_ERROR, fmt::format(
+                "[{}:{}] - source replica [{}] on [{}] was modified during replication",
+                __FUNCTION__, __LINE__, _destination_inp.objPath, source_data_obj_info.rescHier));
+
+            status = SYS_REPLICA_INACCESSIBLE;
+        }
+        else if (status = rewind_replica(_comm, _source_l1descInx); status >= 0) {
+            L1desc[destination_l1descInx].dataObjInp->numThreads = getNumThreads(
+                &_comm,
+                source_data_obj_info.dataSize,
+                L1desc[destination_l1descInx].dataObjInp->numThreads,
+                NULL,
+                destination_data_obj_info.rescHier,
+                source_data_obj_info.rescHier,
+                0);
+
+            status = dataObjCopy(&_comm, destination_l1descInx);
+        }
+
+        if (status < 0) {
+            irods::log(LOG_ERROR, fmt::format(
+                "[{}:{}] - copy failed for [{}], src:[{}], dest:[{}]; ec:[{}]",
+                __FUNCTION__, __LINE__,
+                _destination_inp.objPath,
+                source_data_obj_info.rescHier,
+                destination_data_obj_info.rescHier,
+                status));
+
+            L1desc[destination_l1descInx].bytesWritten = status;
+        }
+        else {
+            status = 0;
+            L1desc[destination_l1descInx].bytesWritten = destination_data_obj_info.dataSize;
+        }
+
+        const auto token = L1desc[destination_l1descInx].replica_token;
+
+        auto destination_fd = irods::duplicate_l1_descriptor(L1desc[destination_l1descInx]);
+        irods::at_scope_exit free_fd{[&destination_fd] { freeL1desc_struct(destination_fd); }};
+
+        auto [source_replica, source_replica_lm] = ir::duplicate_replica(source_data_obj_info);
+        auto [destination_replica, destination_replica_lm] = ir::duplicate_replica(destination_data_obj_info);
+        constexpr auto preserve_rst = true;
+
+        if (const int ec = irods::close_replica_without_catalog_update(_comm, destination_l1descInx, preserve_rst); ec < 0) {
+            irods::log(LOG_ERROR, fmt::format(
+                "[{}:{}] - closing destination replica [{}] failed with [{}]",
+                __FUNCTION__, __LINE__, _destination_inp.objPath, ec));
+
+            if (status >= 0) {
+                status = ec;
+            }
+
+            irods::experimental::replica_access_table::erase_pid(token, getpid());
+        }
+
+        if (destination_fd.bytesWritten < 0) {
+            if (const auto ec = finalize_destination_replica_on_failure(_comm, destination_fd, destination_replica); ec < 0) {
+                irods::log(LOG_ERROR, fmt::format(
+                    "[{}] - failed while finalizing object [{}]; ec:[{}]",
+                    __FUNCTION__, destination_replica.logical_path(), ec));
+            }
+
+            return destination_fd.bytesWritten;
+        }
+
+        try {
+            if (const int ec = finalize_destination_replica(_comm, destination_fd, source_replica, destination_replica); ec < 0) {
+                irods::log(LOG_ERROR, fmt::format(
+                    "[{}:{}] - closing destination replica [{}] failed with [{}]",
+                    __FUNCTION__, __LINE__, destination_replica.logical_path(), ec));
+
+                if (status >= 0) {
+                    status = ec;
+                }
+            }
+        }
+        catch (const irods::exception& e) {
+            irods::log(LOG_ERROR, fmt::format(
+                "[{}:{}] - error finalizing replica; [{}], ec:[{}]",
+                __FUNCTION__, __LINE__, e.client_display_what(), e.code()));
+
+            if (status >= 0) {
+                status = e.code();
+            }
+        }
+
+        if (destination_fd.purgeCacheFlag > 0) {
+            irods::purge_cache(_comm, *destination_replica.get());
+        }
+
+        if (status >= 0) {
+            apply_static_peps(_comm, destination_fd, status);
+        }
+
+        return status;
+    } // replicate_data_to_destination
+
+    // Replicates the source replica to each destination from a single open of the source replica.
+    //
+    // Logical locking allows only one replica of a data object to be open for write at a time,
+    // so the destination replicas are written one after another. For each destination, the source
+    // replica is rewound and streamed with dataObjCopy, so no more than the transfer buffers are
+    // held in memory regardless of the size of the replica.
+    //
+    // Destinations with a non-zero entry in _statuses are skipped. The result for each destination
+    // is stored in _statuses and a failure for one destination does not affect the others.
+    auto replicate_data_to_many(
+        RsComm& _comm,
+        DataObjInp& _source_inp,
+        std::vector<DataObjInp>& _destination_inps,
+        std::vector<int>& _statuses) -> void
+    {
+        const int source_l1descInx = open_source_replica(_comm, _source_inp);
+        if (source_l1descInx < 0) {
+            std::replace(std::begin(_statuses), std::end(_statuses), 0, source_l1descInx);
+            return;
+        }
+
+        for (std::size_t i = 0; i < _destination_inps.size(); ++i) {
+            if (0 != _statuses[i]) {
+                continue;
+            }
+
+            try {
+                _statuses[i] = replicate_data_to_destination(_comm, source_l1descInx, _destination_inps[i]);
+            }
+            catch (const irods::exception& e) {
+                irods::log(LOG_ERROR, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, e.client_display_what()));
+                _statuses[i] = e.code();
+            }
+            catch (const std::exception& e) {
+                irods::log(LOG_ERROR, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, e.what()));
+                _statuses[i] = SYS_INTERNAL_ERR;
+            }
+        }
+
+        auto source_fd = irods::duplicate_l1_descriptor(L1desc[source_l1descInx]);
+        irods::at_scope_exit free_fd{[&source_fd] { freeL1desc_struct(source_fd); }};
+
+        auto [source_replica, source_replica_lm] = ir::duplicate_replica(*L1desc[source_l1descInx].dataObjInfo);
+        constexpr auto preserve_rst = true;
+
+        if (const int ec = irods::close_replica_without_catalog_update(_comm, source_l1descInx, preserve_rst); ec < 0) {
+            irods::log(LOG_ERROR, fmt::format(
+                "[{}:{}] - closing source replica [{}] failed with [{}]",
+                __FUNCTION__, __LINE__, _source_inp.objPath, ec));
+        }
+
+        try {
+            if (const int ec = finalize_source_replica(_comm, source_fd, source_replica); ec < 0) {
+                irods::log(LOG_ERROR, fmt::format(
+                    "[{}:{}] - closing source replica [{}] failed with [{}]",
+                    __FUNCTION__, __LINE__, source_replica.logical_path(), ec));
+            }
+        }
+        catch (const irods::exception& e) {
+            irods::log(LOG_ERROR, fmt::format(
+                "[{}:{}] - error finalizing replica; [{}], ec:[{}]",
+                __FUNCTION__, __LINE__, e.client_display_what(), e.code()));
+        }
+
+        if (source_fd.purgeCacheFlag > 0) {
+            irods::purge_cache(_comm, *source_replica.get());
+        }
+    } // replicate_data_to_many
+
+    // If the resolved resource hierarchy does not contain the specified
+    // resource name or replica number, that means the vote for that resource
+    // returned as 0.0. Either the replica is inaccessible or it does not exist.
+    auto verify_resolved_source_replica(
+        const DataObjInp& _inp,
+        DataObjInp& _source_inp,
+        const irods::physical_object& _source_replica) -> void
+    {
+        auto source_cond_input = irods::experimental::make_key_value_proxy(_source_inp.condInput);
 
-        // If the resolved resource hierarchy does not contain the specified
-        // resource name or replica number, that means the vote for that resource
-        // returned as 0.0. Either the replica is inaccessible or it does not exist.
         if (irods::experimental::keyword_has_a_value(_inp.condInput, RESC_NAME_KW)) {
             const auto resolved_hierarchy = source_cond_input.at(RESC_HIER_STR_KW).value();
             const auto resource_name = source_cond_input.at(RESC_NAME_KW).value();
@@ -686,21 +914,27 @@ namespace
         }
         else if (irods::experimental::keyword_has_a_value(_inp.condInput, REPL_NUM_KW)) {
             if (const auto replica_number = std::stoi(source_cond_input.at(REPL_NUM_KW).value().data());
-                replica_number != source_replica.repl_num()) {
+                replica_number != _source_replica.repl_num()) {
                 THROW(SYS_REPLICA_INACCESSIBLE, fmt::format(
                     "specified source replica number [{}] does not exist "
                     "or the replica is inaccessible at this time",
                     replica_number));
             }
         }
+    } // verify_resolved_source_replica
+
+    auto destination_replica_is_allowed(
+        RsComm& _comm,
+        const DataObjInp& _inp,
+        DataObjInp& _destination_inp,
+        irods::file_object_ptr _destination_obj,
+        irods::physical_object& _source_replica) -> bool
+    {
+        const auto cond_input = irods::experimental::make_key_value_proxy(_inp.condInput);
+        auto destination_cond_input = irods::experimental::make_key_value_proxy(_destination_inp.condInput);
 
-        // get information about destination replica
-        auto destination_inp = init_destination_replica_input(_comm, _inp);
-        const irods::at_scope_exit free_destination_cond_input{[&destination_inp]() { clearKeyVal(&destination_inp.condInput); }};
-        auto destination_cond_input = irods::experimental::make_key_value_proxy(destination_inp.condInput);
-        auto destination_obj = resolve_hierarchy_and_get_data_object_info(_comm, destination_inp, irods::CREATE_OPERATION);
         try {
-            if (irods::experimental::keyword_has_a_value(destination_inp.condInput, DEST_RESC_NAME_KW)) {
+            if (irods::experimental::keyword_has_a_value(_destination_inp.condInput, DEST_RESC_NAME_KW)) {
                 const auto resolved_hierarchy = destination_cond_input.at(DEST_RESC_HIER_STR_KW).value();
                 const auto resource_name = destination_cond_input.at(DEST_RESC_NAME_KW).value();
                 if (!irods::hierarchy_parser{resolved_hierarchy.data()}.resc_in_hier(resource_name.data())) {
@@ -713,13 +947,11 @@ namespace
             }
 
             const auto& destination_replica = get_replica_with_hierarchy(
-                _comm, destination_obj, destination_cond_input.at(DEST_RESC_HIER_STR_KW).value(),
+                _comm, _destination_obj, destination_cond_input.at(DEST_RESC_HIER_STR_KW).value(),
                 irods::replication::log_errors::no);
 
             const auto log_errors = cond_input.contains(RECURSIVE_OPR__KW) ? irods::replication::log_errors::no : irods::replication::log_errors::yes;
-            if (!irods::replication::is_allowed(_comm, source_replica, destination_replica, log_errors)) {
-                return SYS_NOT_ALLOWED;
-            }
+            return irods::replication::is_allowed(_comm, _source_replica, destination_replica, log_errors);
         }
         catch (const irods::exception& e) {
             // If the destination replica doesn't exist, replication is always allowed.
@@ -728,6 +960,31 @@ namespace
             }
         }
 
+        return true;
+    } // destination_replica_is_allowed
+
+    int replicate_data_object(RsComm& _comm, DataObjInp& _inp, transferStat_t** _stat)
+    {
+        // get information about source replica
+        auto source_inp = init_source_replica_input(_comm, _inp);
+        const irods::at_scope_exit free_source_cond_input{[&source_inp]() { clearKeyVal(&source_inp.condInput); }};
+        auto source_cond_input = irods::experimental::make_key_value_proxy(source_inp.condInput);
+        auto source_obj = resolve_hierarchy_and_get_data_object_info(_comm, source_inp, irods::OPEN_OPERATION);
+        auto& source_replica = get_replica_with_hierarchy(
+            _comm, source_obj, source_cond_input.at(RESC_HIER_STR_KW).value(),
+            irods::replication::log_errors::yes);
+
+        verify_resolved_source_replica(_inp, source_inp, source_replica);
+
+        // get information about destination replica
+        auto destination_inp = init_destination_replica_input(_comm, _inp);
+        const irods::at_scope_exit free_destination_cond_input{[&destination_inp]() { clearKeyVal(&destination_inp.condInput); }};
+        auto destination_cond_input = irods::experimental::make_key_value_proxy(destination_inp.condInput);
+        auto destination_obj = resolve_hierarchy_and_get_data_object_info(_comm, destination_inp, irods::CREATE_OPERATION);
+        if (!destination_replica_is_allowed(_comm, _inp, destination_inp, destination_obj, source_replica)) {
+            return SYS_NOT_ALLOWED;
+        }
+
         irods::log(LOG_DEBUG8, fmt::format(
             "[{}:{}] - source:[{}],destination:[{}]",
             __FUNCTION__, __LINE__,
@@ -757,28 +1014,7 @@ namespace
             _comm, source_obj, source_cond_input.at(RESC_HIER_STR_KW).value(),
             irods::replication::log_errors::yes);
 
-        // If the resolved resource hierarchy does not contain the specified
-        // resource name or replica number, that means the vote for that resource
-        // returned as 0.0. Either the replica is inaccessible or it does not exist.
-        if (irods::experimental::keyword_has_a_value(_inp.condInput, RESC_NAME_KW)) {
-            const auto resolved_hierarchy = source_cond_input.at(RESC_HIER_STR_KW).value();
-            const auto resource_name = source_cond_input.at(RESC_NAME_KW).value();
-            if (!irods::hierarchy_parser{resolved_hierarchy.data()}.resc_in_hier(resource_name.data())) {
-                THROW(SYS_REPLICA_INACCESSIBLE, fmt::format(
-                    "hierarchy descending from specified source resource name [{}] "
-                    "does not have a replica or the replica is inaccessible at this time",
-                    resource_name));
-            }
-        }
-        else if (irods::experimental::keyword_has_a_value(_inp.condInput, REPL_NUM_KW)) {
-            if (const auto replica_number = std::stoi(source_cond_input.at(REPL_NUM_KW).value().data());
-                replica_number != source_replica.repl_num()) {
-                THROW(SYS_REPLICA_INACCESSIBLE, fmt::format(
-                    "specified source replica number [{}] does not exist "
-                    "or the replica is inaccessible at this time",
-                    replica_number));
-            }
-        }
+        verify_resolved_source_replica(_inp, source_inp, source_replica);
 
         // only good replica can be used as a source to update all other replicas
         if (GOOD_REPLICA != source_replica.replica_status()) {
@@ -820,11 +1056,87 @@ namespace
         return status;
     } // update_all_existing_replicas
 
+    auto replicate_data_object_to_many(
+        RsComm& _comm,
+        DataObjInp& _inp,
+        const std::vector<std::string>& _destination_hierarchies,
+        std::vector<int>& _statuses) -> void
+    {
+        // get information about source replica
+        auto source_inp = init_source_replica_input(_comm, _inp);
+        const irods::at_scope_exit free_source_cond_input{[&source_inp]() { clearKeyVal(&source_inp.condInput); }};
+        auto source_cond_input = irods::experimental::make_key_value_proxy(source_inp.condInput);
+        auto source_obj = resolve_hierarchy_and_get_data_object_info(_comm, source_inp, irods::OPEN_OPERATION);
+        auto& source_replica = get_replica_with_hierarchy(
+            _comm, source_obj, source_cond_input.at(RESC_HIER_STR_KW).value(),
+            irods::replication::log_errors::yes);
+
+        verify_resolved_source_replica(_inp, source_inp, source_replica);
+
+        // get information about destination replicas
+        std::vector<DataObjInp> destination_inps;
+        destination_inps.reserve(_destination_hierarchies.size());
+        const irods::at_scope_exit free_destination_cond_inputs{[&destination_inps]() {
+            for (auto& inp : destination_inps) {
+                clearKeyVal(&inp.condInput);
+            }
+        }};
+
+        for (std::size_t i = 0; i < _destination_hierarchies.size(); ++i) {
+            auto& destination_inp = destination_inps.emplace_back(init_destination_replica_input(_comm, _inp));
+            auto destination_cond_input = irods::experimental::make_key_value_proxy(destination_inp.condInput);
+            destination_cond_input[DEST_RESC_HIER_STR_KW] = _destination_hierarchies[i];
+
+            try {
+                auto destination_obj = resolve_hierarchy_and_get_data_object_info(_comm, destination_inp, irods::CREATE_OPERATION);
+                if (!destination_replica_is_allowed(_comm, _inp, destination_inp, destination_obj, source_replica)) {
+                    _statuses[i] = SYS_NOT_ALLOWED;
+                }
+            }
+            catch (const irods::exception& e) {
+                irods::log(LOG_ERROR, fmt::format(
+                    "[{}:{}] - cannot replicate [{}] to [{}]; [{}]",
+                    __FUNCTION__, __LINE__, _inp.objPath, _destination_hierarchies[i], e.client_display_what()));
+
+                _statuses[i] = e.code();
+            }
+        }
+
+        irods::log(LOG_DEBUG8, fmt::format(
+            "[{}:{}] - source:[{}], destination count:[{}]",
+            __FUNCTION__, __LINE__,
+            source_cond_input.at(RESC_HIER_STR_KW).value(),
+            _destination_hierarchies.size()));
+
+        // replicate!
+        replicate_data_to_many(_comm, source_inp, destination_inps, _statuses);
+    } // replicate_data_object_to_many
+
+    // Replicas of data objects in special collections cannot be replicated, except for those in
+    // linked collections. The path of a data object in a linked collection is replaced with the
+    // path of the data object it links to.
+    int resolve_path_in_linked_collection(RsComm& _comm, DataObjInp& _inp)
+    {
+        dataObjInfo_t *dataObjInfo{};
+        const irods::at_scope_exit free_data_obj_info{[&dataObjInfo]() {
+            freeAllDataObjInfo(dataObjInfo);
+        }};
+        const int status = resolvePathInSpecColl(&_comm, _inp.objPath, READ_COLL_PERM, 0, &dataObjInfo);
+        if (status == DATA_OBJ_T && dataObjInfo && dataObjInfo->specColl) {
+            if (dataObjInfo->specColl->collClass != LINKED_COLL) {
+                return SYS_REG_OBJ_IN_SPEC_COLL;
+            }
+            rstrcpy(_inp.objPath, dataObjInfo->objPath, MAX_NAME_LEN);
+        }
+
+        return 0;
+    } // resolve_path_in_linked_collection
+
     int singleL1Copy(rsComm_t *rsComm, dataCopyInp_t& dataCopyInp)
     {
         int trans_buff_size;
         try {
-            trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS) * 1024 * 1024;
+            trans_buff_size = irods::get_server_config_snapshot()->advanced_settings.transfer_buffer_size_for_parallel_transfer_in_megabytes.get() * 1024 * 1024;
         } catch ( const irods::exception& e ) {
             irods::log(e);
             return e.code();
@@ -904,17 +1216,9 @@ int rsDataObjRepl( rsComm_t *rsComm, dataObjInp_t *dataObjInp, transferStat_t **
     }
 
     // Resolve path in linked collection if applicable
-    dataObjInfo_t *dataObjInfo{};
-    const irods::at_scope_exit free_data_obj_info{[dataObjInfo]() {
-        freeAllDataObjInfo(dataObjInfo);
-    }};
-    int status = resolvePathInSpecColl( rsComm, dataObjInp->objPath,
-                                    READ_COLL_PERM, 0, &dataObjInfo );
-    if (status == DATA_OBJ_T && dataObjInfo && dataObjInfo->specColl) {
-        if (dataObjInfo->specColl->collClass != LINKED_COLL) {
-            return SYS_REG_OBJ_IN_SPEC_COLL;
-        }
-        rstrcpy(dataObjInp->objPath, dataObjInfo->objPath, MAX_NAME_LEN);
+    int status = resolve_path_in_linked_collection(*rsComm, *dataObjInp);
+    if (status < 0) {
+        return status;
     }
 
     rodsServerHost_t *rodsServerHost{};
@@ -962,6 +1266,81 @@ int rsDataObjRepl( rsComm_t *rsComm, dataObjInp_t *dataObjInp, transferStat_t **
     return (status == DIRECT_ARCHIVE_ACCESS) ? 0 : status;
 } // rsDataObjRepl
 
+int dataObjReplToMany(
+    rsComm_t* rsComm,
+    dataObjInp_t* dataObjInp,
+    const std::vector<std::string>& _destination_hierarchies,
+    std::vector<int>& _statuses)
+{
+    _statuses.assign(_destination_hierarchies.size(), 0);
+
+    if (!rsComm || !dataObjInp) {
+        _statuses.assign(_destination_hierarchies.size(), SYS_INTERNAL_NULL_INPUT_ERR);
+        return SYS_INTERNAL_NULL_INPUT_ERR;
+    }
+
+    auto cond_input = irods::experimental::make_key_value_proxy(dataObjInp->condInput);
+
+    // Resolve path in linked collection if applicable
+    int status = resolve_path_in_linked_collection(*rsComm, *dataObjInp);
+    if (status < 0) {
+        _statuses.assign(_destination_hierarchies.size(), status);
+        return status;
+    }
+
+    rodsServerHost_t *rodsServerHost{};
+    const int remoteFlag = getAndConnRemoteZone(rsComm, dataObjInp, &rodsServerHost, REMOTE_OPEN);
+    if (remoteFlag < 0) {
+        _statuses.assign(_destination_hierarchies.size(), remoteFlag);
+        return remoteFlag;
+    }
+    else if (remoteFlag == REMOTE_HOST) {
+        // The zone holding the data object replicates to each destination on its own.
+        for (std::size_t i = 0; i < _destination_hierarchies.size(); ++i) {
+            cond_input[DEST_RESC_HIER_STR_KW] = _destination_hierarchies[i];
+
+            transferStat_t* transStat{};
+            _statuses[i] = _rcDataObjRepl(rodsServerHost->conn, dataObjInp, &transStat);
+            free(transStat);
+        }
+
+        cond_input.erase(DEST_RESC_HIER_STR_KW);
+
+        const auto failed = std::find_if(std::begin(_statuses), std::end(_statuses), [](const int _ec) { return _ec < 0; });
+        return std::end(_statuses) == failed ? 0 : *failed;
+    }
+
+    try {
+        cond_input[IN_REPL_KW] = "";
+
+        const irods::at_scope_exit remove_in_repl{[&cond_input] { cond_input.erase(IN_REPL_KW); }};
+
+        replicate_data_object_to_many(*rsComm, *dataObjInp, _destination_hierarchies, _statuses);
+    }
+    catch (const irods::exception& e) {
+        irods::log(LOG_ERROR, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, e.client_display_what()));
+        addRErrorMsg(&rsComm->rError, e.code(), e.client_display_what());
+        status = e.code();
+    }
+    catch (const std::exception& e) {
+        irods::log(LOG_ERROR, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, e.what()));
+        status = SYS_INTERNAL_ERR;
+    }
+    catch (...) {
+        irods::log(LOG_ERROR, fmt::format("[{}:{}] - unknown error occurred", __FUNCTION__, __LINE__));
+        status = SYS_UNKNOWN_ERROR;
+    }
+
+    // Failures before any destination was processed apply to all of them.
+    if (status < 0) {
+        _statuses.assign(_destination_hierarchies.size(), status);
+        return status;
+    }
+
+    const auto failed = std::find_if(std::begin(_statuses), std::end(_statuses), [](const int _ec) { return _ec < 0; });
+    return std::end(_statuses) == failed ? 0 : *failed;
+} // dataObjReplToMany
+
 int dataObjCopy(rsComm_t* rsComm, int _destination_l1descInx)
 {
     int source_l1descInx = L1desc[_destination_l1descInx].srcL1descInx;
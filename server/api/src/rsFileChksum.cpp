@@ -104,10 +104,8 @@ int fileChksum(rsComm_t* rsComm,
 {
     // =-=-=-=-=-=-=-
     // capture server hashing settings
-    std::string hash_scheme( irods::MD5_NAME );
-    try {
-        hash_scheme = irods::get_server_property<const std::string>(irods::CFG_DEFAULT_HASH_SCHEME_KW);
-    } catch ( const irods::exception& ) {}
+    const auto config = irods::get_server_config_snapshot();
+    std::string hash_scheme = config->default_hash_scheme.value_or( irods::MD5_NAME );
 
     // make sure the read parameter is lowercased
     std::transform(
@@ -116,10 +114,7 @@ int fileChksum(rsComm_t* rsComm,
         hash_scheme.begin(),
         ::tolower );
 
-    std::string hash_policy;
-    try {
-        hash_policy = irods::get_server_property<const std::string>(irods::CFG_MATCH_HASH_POLICY_KW);
-    } catch ( const irods::exception& ) {}
+    const std::string hash_policy = config->match_hash_policy.value_or( "" );
 
     // =-=-=-=-=-=-=-
     // extract scheme from checksum string
@@ -269,20 +264,13 @@ int file_checksum(RsComm* _comm,
                   char* _calculated_checksum)
 {
     // Capture server hashing settings.
-    std::string hash_scheme = irods::MD5_NAME;
-    try {
-        hash_scheme = irods::get_server_property<const std::string&>(irods::CFG_DEFAULT_HASH_SCHEME_KW);
-    }
-    catch (const irods::exception&) {}
+    const auto config = irods::get_server_config_snapshot();
+    std::string hash_scheme = config->default_hash_scheme.value_or(irods::MD5_NAME);
 
     // Make sure the read parameter is lowercased.
     std::transform(hash_scheme.begin(), hash_scheme.end(), hash_scheme.begin(), ::tolower);
 
-    std::string_view hash_policy;
-    try {
-        hash_policy = irods::get_server_property<const std::string&>(irods::CFG_MATCH_HASH_POLICY_KW);
-    }
-    catch (const irods::exception&) {}
+    const std::string hash_policy = config->match_hash_policy.value_or("");
 
     // Extract scheme from checksum string.
     std::string chkstr_scheme;
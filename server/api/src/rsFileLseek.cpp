@@ -7,6 +7,7 @@
 #include "miscServerFunct.hpp"
 #include "rsGlobalExtern.hpp"
 #include "rsFileLseek.hpp"
+#include "inline_checksum_table.hpp"
 
 // =-=-=-=-=-=-=-
 #include "irods_log.hpp"
@@ -22,6 +23,9 @@ rsFileLseek( rsComm_t *rsComm, fileLseekInp_t *fileLseekInp,
 
     *fileLseekOut = NULL;
 
+    // remoteFileLseek replaces the index with the one of the remote server.
+    const int fileInx = fileLseekInp->fileInx;
+
     remoteFlag = getServerHostByFileInx( fileLseekInp->fileInx,
                                          &rodsServerHost );
 
@@ -44,7 +48,10 @@ rsFileLseek( rsComm_t *rsComm, fileLseekInp_t *fileLseekInp,
         }
     }
 
-    /* Manually insert call-specific code here */
+    if ( retVal >= 0 && *fileLseekOut != NULL ) {
+        irods::experimental::inline_checksum_table::seek(
+            fileInx, ( *fileLseekOut )->offset );
+    }
 
     return retVal;
 }
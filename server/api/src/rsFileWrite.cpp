@@ -9,6 +9,7 @@
 #include "miscServerFunct.hpp"
 #include "rsGlobalExtern.hpp"
 #include "rsFileWrite.hpp"
+#include "inline_checksum_table.hpp"
 #include <sstream>
 
 // =-=-=-=-=-=-=-
@@ -47,6 +48,8 @@ rsFileWrite( rsComm_t *rsComm, const fileWriteInp_t *fileWriteInp,
 
     if ( retVal >= 0 ) {
         FileDesc[fileWriteInp->fileInx].writtenFlag = 1;
+        irods::experimental::inline_checksum_table::update(
+            fileWriteInp->fileInx, fileWriteInpBBuf->buf, retVal );
     }
 
     return retVal;
@@ -31,6 +31,7 @@
 #include "irods_at_scope_exit.hpp"
 #include "irods_hierarchy_parser.hpp"
 #include "irods_logger.hpp"
+#include "resource_hierarchy_cache.hpp"
 
 using logger = irods::experimental::log;
 
@@ -228,6 +229,14 @@ rsGeneralAdmin( rsComm_t *rsComm, generalAdminInp_t *generalAdminInp ) {
         rodsLog( LOG_NOTICE,
                  "rsGeneralAdmin: rcGeneralAdmin error %d", status );
     }
+    else if ( generalAdminInp->arg1 &&
+              ( strcmp( generalAdminInp->arg1, "resource" ) == 0 ||
+                strcmp( generalAdminInp->arg1, "childtoresc" ) == 0 ||
+                strcmp( generalAdminInp->arg1, "childfromresc" ) == 0 ) ) {
+        // Agents started from now on must not attach to the old hierarchy. Other servers
+        // notice the new catalog version when they next verify their cache.
+        irods::experimental::resource_hierarchy_cache::invalidate();
+    }
     return status;
 }
 
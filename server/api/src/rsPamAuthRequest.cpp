@@ -14,6 +14,7 @@
 #include "irods_log.hpp"
 #include "sslSockComm.h"
 #include "miscServerFunct.hpp"
+#include "pam_auth_helper.hpp"
 
 
 int
@@ -139,16 +140,22 @@ _rsPamAuthRequest( rsComm_t *rsComm, pamAuthRequestInp_t *pamAuthRequestInp,
 
     result = *pamAuthRequestOut;
 
-    /* Normal mode, fork/exec setuid program to do the Pam check */
-    status = runPamAuthCheck( pamAuthRequestInp->pamUser,
-                              pamAuthRequestInp->pamPassword );
-    if ( status == 256 ) {
-        status = PAM_AUTH_PASSWORD_FAILED;
-    }
-    else {
-        /* the exec failed or something (irodsPamAuthCheck not built perhaps) */
-        if ( status != 0 ) {
-            status = PAM_AUTH_NOT_BUILT_INTO_SERVER;
+    /* Ask the persistent helper first, if the server started one */
+    status = irods::experimental::pam_auth_helper::authenticate(
+                 pamAuthRequestInp->pamUser,
+                 pamAuthRequestInp->pamPassword );
+    if ( status < 0 && status != PAM_AUTH_PASSWORD_FAILED ) {
+        /* Normal mode, fork/exec setuid program to do the Pam check */
+        status = runPamAuthCheck( pamAuthRequestInp->pamUser,
+                                  pamAuthRequestInp->pamPassword );
+        if ( status == 256 ) {
+            status = PAM_AUTH_PASSWORD_FAILED;
+        }
+        else {
+            /* the exec failed or something (irodsPamAuthCheck not built perhaps) */
+            if ( status != 0 ) {
+                status = PAM_AUTH_NOT_BUILT_INTO_SERVER;
+            }
         }
     }
 
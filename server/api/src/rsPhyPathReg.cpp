@@ -32,6 +32,7 @@
 #include "rsRegColl.hpp"
 #include "rsSubStructFileStat.hpp"
 #include "rsSyncMountedColl.hpp"
+#include "rsBulkDataObjReg.hpp"
 #include "rsFileOpen.hpp"
 #include "rsFileRead.hpp"
 #include "rsFileClose.hpp"
@@ -40,7 +41,10 @@
 #include "irods_hierarchy_parser.hpp"
 #include "irods_resource_backport.hpp"
 #include "irods_resource_redirect.hpp"
-#include "key_value_proxy.hpp"
+#include "irods_configuration_keywords.hpp"
+#include "irods_server_properties.hpp"
+#include "irods_default_paths.hpp"
+#include "directory_scanner.hpp"
 
 #define IRODS_QUERY_ENABLE_SERVER_SIDE_API
 #include "irods_query.hpp"
@@ -51,10 +55,16 @@
 #define IRODS_REPLICA_ENABLE_SERVER_SIDE_API
 #include "replica_proxy.hpp"
 
+#include "boost/filesystem.hpp"
 #include "boost/lexical_cast.hpp"
 #include "fmt/format.h"
 
+#include <cstdint>
+#include <fstream>
 #include <iostream>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 /* holds a struct that describes pathname match patterns
    to exclude from registration. Needs to be global due
@@ -595,6 +605,432 @@ namespace {
         return status;
     } // dirPathReg
 
+    // Remembers the directories of a recursive registration whose files were all
+    // registered, so that rerunning an interrupted registration with the force flag
+    // does not read and check their files again.
+    class registration_checkpoint
+    {
+    public:
+        registration_checkpoint(const std::string& _collection,
+                                const std::string& _directory,
+                                const std::string& _resc_hier,
+                                bool _resume)
+            : path_{make_path(_collection, _directory, _resc_hier)}
+            , completed_{}
+            , stream_{}
+        {
+            boost::system::error_code ec;
+
+            if (_resume) {
+                std::ifstream in{path_.string()};
+                for (std::string line; std::getline(in, line);) {
+                    completed_.insert(line);
+                }
+            }
+            else {
+                boost::filesystem::remove(path_, ec);
+            }
+
+            boost::filesystem::create_directories(path_.parent_path(), ec);
+            stream_.open(path_.string(), std::ios::app);
+
+            if (!stream_) {
+                rodsLog(LOG_NOTICE, "registration_checkpoint: cannot write %s. Progress is not saved.", path_.c_str());
+            }
+        }
+
+        // Not modified after construction, so the scanner may call this concurrently.
+        auto contains(const std::string& _directory) const -> bool
+        {
+            return completed_.count(_directory) > 0;
+        }
+
+        auto add(const std::string& _directory) -> void
+        {
+            if (stream_) {
+                stream_ << _directory << '\n';
+            }
+        }
+
+        auto flush() -> void
+        {
+            if (stream_) {
+                stream_.flush();
+            }
+        }
+
+        auto remove() -> void
+        {
+            stream_.close();
+
+            boost::system::error_code ec;
+            boost::filesystem::remove(path_, ec);
+        }
+
+    private:
+        static auto make_path(const std::string& _collection,
+                              const std::string& _directory,
+                              const std::string& _resc_hier) -> boost::filesystem::path
+        {
+            // FNV-1a, so that the name of the checkpoint does not change between builds.
+            std::uint64_t hash = 14695981039346656037ULL;
+            for (const auto& s : {_collection, std::string{"\n"}, _directory, std::string{"\n"}, _resc_hier}) {
+                for (const unsigned char c : s) {
+                    hash = (hash ^ c) * 1099511628211ULL;
+                }
+            }
+
+            return irods::get_irods_home_directory() / "registration_checkpoints" / fmt::format("{:016x}", hash);
+        }
+
+        const boost::filesystem::path path_;
+        std::unordered_set<std::string> completed_;
+        std::ofstream stream_;
+    }; // class registration_checkpoint
+
+    // Allocates the columns rsBulkDataObjReg expects (see initBulkDataObjRegInp) for
+    // _rows rows instead of MAX_NUM_BULK_OPR_FILES.
+    void initBulkRegistrationInp(genQueryOut_t& _inp, int _rows)
+    {
+        const std::pair<int, int> columns[] = {{COL_DATA_NAME, MAX_NAME_LEN},
+                                               {COL_DATA_TYPE_NAME, NAME_LEN},
+                                               {COL_DATA_SIZE, NAME_LEN},
+                                               {COL_D_RESC_NAME, NAME_LEN},
+                                               {COL_D_DATA_PATH, MAX_NAME_LEN},
+                                               {COL_DATA_MODE, NAME_LEN},
+                                               {OPR_TYPE_INX, NAME_LEN},
+                                               {COL_DATA_REPL_NUM, NAME_LEN},
+                                               {COL_D_DATA_CHECKSUM, NAME_LEN},
+                                               {COL_D_RESC_ID, MAX_NAME_LEN}};
+
+        std::memset(&_inp, 0, sizeof(_inp));
+
+        for (const auto& [index, len] : columns) {
+            auto& column = _inp.sqlResult[_inp.attriCnt++];
+            column.attriInx = index;
+            column.len = len;
+            column.value = static_cast<char*>(std::calloc(_rows, len));
+        }
+
+        _inp.continueInx = -1;
+    } // initBulkRegistrationInp
+
+    void setBulkRegistrationValue(genQueryOut_t& _inp, int _column, const char* _value)
+    {
+        auto& column = _inp.sqlResult[_column];
+        rstrcpy(&column.value[column.len * _inp.rowCnt], _value, column.len);
+    } // setBulkRegistrationValue
+
+    void addRegistrationError(rsComm_t* rsComm, const char* _func_name, const std::string& _path, int _status)
+    {
+        if (rsComm->rError.len < MAX_ERROR_MESSAGES) {
+            const auto msg = fmt::format("dirPathReg: {} failed for {}, status = {}", _func_name, _path, _status);
+            addRErrorMsg(&rsComm->rError, _status, msg.c_str());
+        }
+    } // addRegistrationError
+
+    int createCollectionForDirectory(rsComm_t* rsComm, const std::string& _collection)
+    {
+        collInp_t collCreateInp{};
+        rstrcpy(collCreateInp.collName, _collection.c_str(), MAX_NAME_LEN);
+        addKeyVal(&collCreateInp.condInput, TRANSLATED_PATH_KW, "");
+
+        const int status = rsCollCreate(rsComm, &collCreateInp);
+        clearKeyVal(&collCreateInp.condInput);
+
+        return CATALOG_ALREADY_HAS_ITEM_BY_THAT_NAME == status ? 0 : status;
+    } // createCollectionForDirectory
+
+    // Returns the names of the data objects in _collection. The collection is queried by ID,
+    // so quotes in its name cannot change the query.
+    //
+    // \throws irods::exception If the collection or its data objects cannot be queried.
+    std::unordered_set<std::string> getDataObjectNamesInCollection(rsComm_t* rsComm, const std::string& _collection)
+    {
+        dataObjInp_t collStatInp{};
+        rstrcpy(collStatInp.objPath, _collection.c_str(), MAX_NAME_LEN);
+
+        rodsObjStat_t* rodsObjStatOut = nullptr;
+        const int status = collStat(rsComm, &collStatInp, &rodsObjStatOut);
+        irods::at_scope_exit free_stat{[&rodsObjStatOut] { freeRodsObjStat(rodsObjStatOut); }};
+
+        if (status < 0 || !rodsObjStatOut) {
+            THROW(status < 0 ? status : SYS_INTERNAL_NULL_INPUT_ERR, fmt::format("collStat failed for [{}]", _collection));
+        }
+
+        std::unordered_set<std::string> names;
+
+        const auto gql = fmt::format("select DATA_NAME where DATA_COLL_ID = '{}'", rodsObjStatOut->dataId);
+        for (auto&& row : irods::query{rsComm, gql}) {
+            names.insert(row[0]);
+        }
+
+        return names;
+    } // getDataObjectNamesInCollection
+
+    // Returns whether dirPathReg can be replaced by bulkDirPathReg, and its settings.
+    //
+    // Only trees registered into a single local unixfilesystem resource are scanned
+    // directly. Registering in bulk notifies the resource of every new data object,
+    // which coordinating resources would act on. Requests that need per-file work
+    // (checksums, replicas, modification times) also keep the per-file path.
+    bool canRegisterInBulk(
+        dataObjInp_t *phyPathRegInp,
+        const char *_resc_name,
+        rodsServerHost_t *rodsServerHost,
+        int& _batch_size,
+        int& _threads)
+    {
+        _batch_size = 0;
+        _threads = 4;
+
+        try {
+            _batch_size = irods::get_advanced_setting<const int>(irods::CFG_BULK_REGISTRATION_BATCH_SIZE);
+        }
+        catch (const irods::exception&) {
+            // Not configured. Bulk registration is disabled by default.
+        }
+
+        if (_batch_size <= 0) {
+            return false;
+        }
+
+        try {
+            _threads = irods::get_advanced_setting<const int>(irods::CFG_BULK_REGISTRATION_NUMBER_OF_THREADS);
+        }
+        catch (const irods::exception&) {}
+
+        auto* condInput = &phyPathRegInp->condInput;
+        if (getValByKey(condInput, REG_REPL_KW) ||
+            getValByKey(condInput, REG_CHKSUM_KW) ||
+            getValByKey(condInput, VERIFY_CHKSUM_KW) ||
+            getValByKey(condInput, DATA_MODIFY_KW) ||
+            getValByKey(condInput, REGISTER_AS_INTERMEDIATE_KW))
+        {
+            return false;
+        }
+
+        if (!rodsServerHost || LOCAL_HOST != rodsServerHost->localFlag) {
+            return false;
+        }
+
+        const char* resc_hier = getValByKey(condInput, RESC_HIER_STR_KW);
+        if (!resc_hier || std::strcmp(resc_hier, _resc_name) != 0) {
+            return false;
+        }
+
+        rodsLong_t resc_id = 0;
+        std::string type;
+        if (const auto ret = resc_mgr.hier_to_leaf_id(resc_hier, resc_id); !ret.ok()) {
+            irods::log(PASS(ret));
+            return false;
+        }
+
+        if (const auto ret = irods::get_resource_property<std::string>(resc_id, irods::RESOURCE_TYPE, type); !ret.ok()) {
+            irods::log(PASS(ret));
+            return false;
+        }
+
+        return "unixfilesystem" == type;
+    } // canRegisterInBulk
+
+    // Registers a directory tree like dirPathReg, with the directories read in parallel
+    // by directory_scanner and the data objects registered through rsBulkDataObjReg,
+    // one catalog transaction per batch.
+    //
+    // acPostProcForFilePathReg is not invoked for data objects registered in bulk.
+    // If a batch fails, its files are registered one by one by filePathReg, so that
+    // every failure is reported as before.
+    int bulkDirPathReg(
+        rsComm_t *rsComm,
+        dataObjInp_t *phyPathRegInp,
+        char *filePath,
+        const char *_resc_name,
+        int _batch_size,
+        int _threads)
+    {
+        namespace ds = irods::experimental::directory_scanner;
+
+        const std::string resc_hier = getValByKey(&phyPathRegInp->condInput, RESC_HIER_STR_KW);
+        const bool force = getValByKey(&phyPathRegInp->condInput, FORCE_FLAG_KW) != nullptr;
+
+        rodsObjStat_t *rodsObjStatOut = NULL;
+        int status = collStat( rsComm, phyPathRegInp, &rodsObjStatOut );
+        if ( status < 0 || NULL == rodsObjStatOut ) {
+            if ( ( status = createCollectionForDirectory( rsComm, phyPathRegInp->objPath ) ) < 0 ) {
+                freeRodsObjStat( rodsObjStatOut );
+                return status;
+            }
+        }
+        else if ( rodsObjStatOut->specColl != NULL ) {
+            freeRodsObjStat( rodsObjStatOut );
+            rodsLog( LOG_ERROR,
+                     "mountFileDir: %s already mounted", phyPathRegInp->objPath );
+            return SYS_MOUNT_MOUNTED_COLL_ERR;
+        }
+        freeRodsObjStat( rodsObjStatOut );
+
+        std::string directory = filePath;
+        while (directory.size() > 1 && '/' == directory.back()) {
+            directory.pop_back();
+        }
+
+        registration_checkpoint checkpoint{phyPathRegInp->objPath, directory, resc_hier, force};
+
+        ds::options options{_threads, static_cast<std::size_t>(_batch_size), static_cast<std::size_t>(2 * std::max(1, _threads)), nullptr, nullptr};
+
+        if (ExcludePatterns) {
+            options.exclude = [](const char* _name, const std::string& _dir) {
+                return matchPathname(ExcludePatterns, const_cast<char*>(_name), const_cast<char*>(_dir.c_str())) != 0;
+            };
+        }
+
+        if (force) {
+            options.skip_files = [&checkpoint](const std::string& _dir) { return checkpoint.contains(_dir); };
+        }
+
+        genQueryOut_t bulkDataObjRegInp;
+        initBulkRegistrationInp(bulkDataObjRegInp, _batch_size);
+        irods::at_scope_exit free_inp{[&bulkDataObjRegInp] { clearGenQueryOut(&bulkDataObjRegInp); }};
+
+        const char* data_type = getValByKey(&phyPathRegInp->condInput, DATA_TYPE_KW);
+        const auto data_mode = std::to_string(phyPathRegInp->createMode);
+        const auto resc_id = std::to_string(resc_mgr.resc_name_to_id(_resc_name));
+
+        // The names of the data objects in the collection of the current batch, for the
+        // force flag. A directory spans multiple batches when it has many files. If the
+        // names cannot be queried, each file of the collection is checked with isData.
+        std::string existing_collection;
+        std::unordered_set<std::string> existing_names;
+        bool existing_names_known = false;
+
+        // Directories with failed entries are not added to the checkpoint.
+        std::unordered_set<std::string> failed_directories;
+
+        bool all_registered = true;
+        rodsLong_t registered = 0;
+
+        const auto register_file = [&](const ds::entry& _e) {
+            dataObjInp_t subPhyPathRegInp = *phyPathRegInp;
+            rstrcpy(subPhyPathRegInp.objPath, _e.logical_path.c_str(), MAX_NAME_LEN);
+            subPhyPathRegInp.dataSize = _e.size;
+            addKeyVal(&subPhyPathRegInp.condInput, FILE_PATH_KW, _e.physical_path.c_str());
+
+            if (const int ec = filePathReg(rsComm, &subPhyPathRegInp, _resc_name); ec < 0) {
+                addRegistrationError(rsComm, "filePathReg", _e.logical_path, ec);
+                failed_directories.insert(_e.physical_path.substr(0, _e.physical_path.rfind('/')));
+                all_registered = false;
+            }
+            else {
+                ++registered;
+            }
+        };
+
+        ds::scanner scanner{directory, phyPathRegInp->objPath, std::move(options)};
+
+        while (auto batch = scanner.next()) {
+            std::vector<const ds::entry*> files;
+            bulkDataObjRegInp.rowCnt = 0;
+
+            for (const auto& e : batch->entries) {
+                const auto slash = e.logical_path.rfind('/');
+
+                if (e.is_directory) {
+                    if (const int ec = createCollectionForDirectory(rsComm, e.logical_path); ec < 0) {
+                        addRegistrationError(rsComm, "rsCollCreate", e.logical_path, ec);
+                        failed_directories.insert(e.physical_path.substr(0, e.physical_path.rfind('/')));
+                        all_registered = false;
+                    }
+
+                    continue;
+                }
+
+                if (force) {
+                    const auto collection = e.logical_path.substr(0, slash);
+
+                    if (collection != existing_collection) {
+                        existing_names.clear();
+                        existing_names_known = false;
+
+                        try {
+                            existing_names = getDataObjectNamesInCollection(rsComm, collection);
+                            existing_names_known = true;
+                        }
+                        catch (const irods::exception& e) {
+                            irods::log(LOG_NOTICE, fmt::format(
+                                "[{}:{}] - registering files of [{}] one by one [error_code={}]",
+                                __FUNCTION__, __LINE__, collection, e.code()));
+                        }
+
+                        existing_collection = collection;
+                    }
+
+                    if (!existing_names_known) {
+                        if (isData(rsComm, const_cast<char*>(e.logical_path.c_str()), nullptr) < 0) {
+                            register_file(e);
+                        }
+
+                        continue;
+                    }
+
+                    if (existing_names.count(e.logical_path.substr(slash + 1)) > 0) {
+                        continue;
+                    }
+                }
+
+                setBulkRegistrationValue(bulkDataObjRegInp, 0, e.logical_path.c_str());
+                setBulkRegistrationValue(bulkDataObjRegInp, 1, data_type ? data_type : "generic");
+                setBulkRegistrationValue(bulkDataObjRegInp, 2, std::to_string(e.size).c_str());
+                setBulkRegistrationValue(bulkDataObjRegInp, 3, _resc_name);
+                setBulkRegistrationValue(bulkDataObjRegInp, 4, e.physical_path.c_str());
+                setBulkRegistrationValue(bulkDataObjRegInp, 5, data_mode.c_str());
+                setBulkRegistrationValue(bulkDataObjRegInp, 6, REGISTER_OPR);
+                setBulkRegistrationValue(bulkDataObjRegInp, 7, "0");
+                setBulkRegistrationValue(bulkDataObjRegInp, 8, "");
+                setBulkRegistrationValue(bulkDataObjRegInp, 9, resc_id.c_str());
+                ++bulkDataObjRegInp.rowCnt;
+
+                files.push_back(&e);
+            }
+
+            if (!files.empty()) {
+                genQueryOut_t *bulkDataObjRegOut = NULL;
+                const int ec = rsBulkDataObjReg(rsComm, &bulkDataObjRegInp, &bulkDataObjRegOut);
+                freeGenQueryOut(&bulkDataObjRegOut);
+
+                if (ec >= 0) {
+                    registered += files.size();
+                }
+                else {
+                    // The whole batch was rolled back.
+                    for (const auto* e : files) {
+                        register_file(*e);
+                    }
+                }
+            }
+
+            for (const auto& d : batch->completed_directories) {
+                if (failed_directories.count(d) == 0) {
+                    checkpoint.add(d);
+                }
+            }
+
+            checkpoint.flush();
+        }
+
+        rodsLog(LOG_DEBUG, "bulkDirPathReg: registered %lld data objects under %s", registered, phyPathRegInp->objPath);
+
+        if (const int ec = scanner.status(); ec < 0) {
+            return ec;
+        }
+
+        if (all_registered) {
+            checkpoint.remove();
+        }
+
+        return 0;
+    } // bulkDirPathReg
+
     int mountFileDir(
         rsComm_t*     rsComm,
         dataObjInp_t* phyPathRegInp,
@@ -1167,7 +1603,14 @@ namespace {
                                   resc_hier );
             }
 
-            status = dirPathReg( rsComm, phyPathRegInp, filePath, _resc_name );
+            int batch_size = 0;
+            int threads = 0;
+            if ( canRegisterInBulk( phyPathRegInp, _resc_name, rodsServerHost, batch_size, threads ) ) {
+                status = bulkDirPathReg( rsComm, phyPathRegInp, filePath, _resc_name, batch_size, threads );
+            }
+            else {
+                status = dirPathReg( rsComm, phyPathRegInp, filePath, _resc_name );
+            }
             if ( excludePatternFile != NULL ) {
                 freePathnamePatterns( ExcludePatterns );
                 ExcludePatterns = NULL;
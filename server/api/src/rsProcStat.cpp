@@ -18,10 +18,7 @@
 
 // =-=-=-=-=-=-=-
 #include "irods_resource_backport.hpp"
-
-#include <boost/filesystem/operations.hpp>
-#include <boost/filesystem/convenience.hpp>
-using namespace boost::filesystem;
+#include "agent_registry.hpp"
 
 
 
@@ -186,12 +183,12 @@ _rsProcStatAll( rsComm_t *rsComm,
 int
 localProcStat( procStatInp_t *procStatInp,
                genQueryOut_t **procStatOut ) {
-    int numProc, status = 0;
+    namespace ar = irods::experimental::agent_registry;
+
     procLog_t procLog;
-    char childPath[MAX_NAME_LEN];
-    int count = 0;
 
-    numProc = getNumFilesInDir( ProcLogDir ) + 2; /* add 2 to give some room */
+    const auto agents = ar::list();
+    const int numProc = static_cast<int>( agents.size() );
 
     bzero( &procLog, sizeof( procLog ) );
     /* init serverAddr */
@@ -211,47 +208,17 @@ localProcStat( procStatInp_t *procStatInp,
         initProcStatOut( procStatOut, numProc );
     }
 
-    /* loop through the directory */
-    path srcDirPath( ProcLogDir );
-    if ( !exists( srcDirPath ) || !is_directory( srcDirPath ) ) {
-        status = USER_INPUT_PATH_ERR - errno;
-        rodsLogError( LOG_ERROR, status,
-                      "localProcStat: opendir local dir error for %s", ProcLogDir );
-        return status;
-    }
-    directory_iterator end_itr; // default construction yields past-the-end
-    for ( directory_iterator itr( srcDirPath ); itr != end_itr; ++itr ) {
-        path p = itr->path();
-        path cp = p.filename();
-        if ( !isdigit( *cp.c_str() ) ) {
-            continue;    /* not a pid */
-        }
-        snprintf( childPath, MAX_NAME_LEN, "%s",
-                  p.c_str() );
-        if ( !exists( p ) ) {
-            rodsLogError( LOG_ERROR, status,
-                          "localProcStat: stat error for %s", childPath );
-            continue;
-        }
-        if ( is_regular_file( p ) ) {
-            if ( count >= numProc ) {
-                rodsLog( LOG_ERROR,
-                         "localProcStat: proc count %d exceeded", numProc );
-                break;
-            }
-            procLog.pid = atoi( cp.c_str() );
-            if ( readProcLog( procLog.pid, &procLog ) < 0 ) {
-                continue;
-            }
-            status = addProcToProcStatOut( &procLog, *procStatOut );
-            if ( status < 0 ) {
-                continue;
-            }
-            count++;
-        }
-        else {
-            continue;
-        }
+    /* loop through the registered agents */
+    for ( const auto& agent : agents ) {
+        procLog.pid = agent.pid;
+        procLog.startTime = static_cast<unsigned int>( agent.start_time );
+        rstrcpy( procLog.clientName, agent.client_name, NAME_LEN );
+        rstrcpy( procLog.clientZone, agent.client_zone, NAME_LEN );
+        rstrcpy( procLog.proxyName, agent.proxy_name, NAME_LEN );
+        rstrcpy( procLog.proxyZone, agent.proxy_zone, NAME_LEN );
+        rstrcpy( procLog.progName, agent.program_name, NAME_LEN );
+        rstrcpy( procLog.remoteAddr, agent.remote_address, NAME_LEN );
+        addProcToProcStatOut( &procLog, *procStatOut );
     }
     return 0;
 }
@@ -28,20 +28,520 @@
 #include "rsDataObjRename.hpp"
 #include "rsGenQuery.hpp"
 
+#include "rsFileUnlink.hpp"
+#include "fileUnlink.h"
+#include "rodsPath.h"
+
 #include "irods_resource_backport.hpp"
+#include "irods_resource_manager.hpp"
 #include "irods_configuration_keywords.hpp"
+#include "irods_server_properties.hpp"
+#include "irods_at_scope_exit.hpp"
 #include "scoped_privileged_client.hpp"
 #include "irods_logger.hpp"
+#include "connection_pool.hpp"
+#include "thread_pool.hpp"
 
 #define IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
 #include "filesystem.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
 
 namespace ix = irods::experimental;
 
+extern irods::resource_manager resc_mgr;
+
 namespace
 {
+    // Set in the input of the collections under the one being removed once the bulk
+    // delete has handled their data objects, so that it does not run again for each of them.
+    const char* const BULK_DELETE_DONE_KW = "irods_bulk_delete_done";
+
+    // Removes the data objects in a collection and its subcollections in batches.
+    //
+    // The data objects are streamed from the catalog in order of their ids. For each
+    // batch, the physical replicas are unlinked in parallel over pooled connections (the
+    // agent's connection cannot be shared between threads), grouped by resource, and then
+    // the batch is unregistered in a single catalog transaction. Data objects the bulk
+    // delete cannot handle like the per-object path would (locked or intermediate
+    // replicas, tar bundles, replicas outside of a vault or on unavailable resources) are
+    // left alone, as are those whose replicas could not be unlinked. They are removed
+    // afterwards by the per-object path, which reports any errors.
+    //
+    // The per-object PEPs (acDataDeletePolicy, acPostProcForDelete and the
+    // data_obj_unlink API PEPs) are not invoked for the data objects removed here.
+    class bulk_remover
+    {
+    public:
+        bulk_remover(rsComm_t& _comm, collInp_t& _input, collOprStat_t** _stat, int _batch_size, int _threads)
+            : comm_{_comm}
+            , input_{_input}
+            , stat_{_stat}
+            , batch_size_{std::max(1, _batch_size)}
+            , threads_{std::max(1, _threads)}
+            , admin_mode_{nullptr != getValByKey(&_input.condInput, ADMIN_KW) ||
+                          nullptr != getValByKey(&_input.condInput, ADMIN_RMTRASH_KW)}
+            , connection_pool_{}
+            , resources_{}
+            , current_{}
+            , batch_{}
+            , client_gone_{false}
+        {
+        }
+
+        // Returns zero or the last error. Errors for individual batches do not stop the
+        // removal of the remaining data objects.
+        auto run() -> int
+        {
+            genQueryInp_t input{};
+            irods::at_scope_exit clear_input{[&input] { clearGenQueryInp(&input); }};
+
+            if (const auto ec = make_query(input); ec < 0) {
+                return CAT_NO_ROWS_FOUND == ec ? 0 : ec;
+            }
+
+            if (threads_ > 1) {
+                try {
+                    connection_pool_ = irods::make_connection_pool(threads_);
+                }
+                catch (const std::exception& e) {
+                    rodsLog(LOG_NOTICE, "bulk_remover: unlinking serially, connection pool unavailable: %s", e.what());
+                }
+            }
+
+            int saved_status = 0;
+            genQueryOut_t* output = nullptr;
+            int status = 0;
+
+            while ((status = rsGenQuery(&comm_, &input, &output)) >= 0 && output) {
+                if (const auto ec = add_rows(*output); ec < 0) {
+                    saved_status = ec;
+                }
+
+                input.continueInx = output->continueInx;
+                freeGenQueryOut(&output);
+
+                if (0 == input.continueInx || client_gone_) {
+                    break;
+                }
+            }
+
+            // Close the statement if the loop ended early.
+            if (input.continueInx > 0) {
+                input.maxRows = 0;
+                if (0 == rsGenQuery(&comm_, &input, &output)) {
+                    freeGenQueryOut(&output);
+                }
+            }
+
+            freeGenQueryOut(&output);
+
+            if (status < 0 && CAT_NO_ROWS_FOUND != status) {
+                return status;
+            }
+
+            if (!client_gone_) {
+                finish_object();
+
+                if (const auto ec = flush_batch(); ec < 0) {
+                    saved_status = ec;
+                }
+            }
+
+            return saved_status;
+        } // run
+
+    private:
+        struct replica
+        {
+            rodsLong_t resource_id;
+            std::string physical_path;
+        }; // struct replica
+
+        struct data_object
+        {
+            rodsLong_t id;
+            std::string logical_path;
+            bool eligible;
+            std::vector<replica> replicas;
+        }; // struct data_object
+
+        struct resource_info
+        {
+            bool usable;
+            std::string hierarchy;
+            std::string location;
+            std::string vault_path;
+            bool skip_vault_path_check;
+        }; // struct resource_info
+
+        // Returns the values of the only column selected by _input.
+        auto query_values(genQueryInp_t& _input) -> std::vector<std::string>
+        {
+            std::vector<std::string> values;
+            genQueryOut_t* output = nullptr;
+
+            _input.maxRows = MAX_SQL_ROWS;
+
+            if (rsGenQuery(&comm_, &_input, &output) >= 0 && output && output->attriCnt > 0) {
+                const auto& column = output->sqlResult[0];
+                for (int i = 0; i < output->rowCnt; ++i) {
+                    values.emplace_back(column.value + i * column.len);
+                }
+            }
+
+            freeGenQueryOut(&output);
+            clearGenQueryInp(&_input);
+
+            return values;
+        } // query_values
+
+        auto make_query(genQueryInp_t& _input) -> int
+        {
+            char condition[MAX_NAME_LEN * 2];
+            genAllInCollQCond(input_.collName, condition);
+            addInxVal(&_input.sqlCondInp, COL_COLL_NAME, condition);
+
+            // Without admin mode, only stream the data objects the client may delete. The
+            // catalog checks the permissions again when unregistering.
+            if (!admin_mode_) {
+                genQueryInp_t groups{};
+                snprintf(condition, sizeof(condition), "= '%s'", comm_.clientUser.userName);
+                addInxVal(&groups.sqlCondInp, COL_USER_NAME, condition);
+                snprintf(condition, sizeof(condition), "= '%s'", comm_.clientUser.rodsZone);
+                addInxVal(&groups.sqlCondInp, COL_USER_ZONE, condition);
+                addInxIval(&groups.selectInp, COL_USER_GROUP_ID, 1);
+                const auto group_ids = query_values(groups);
+
+                genQueryInp_t token{};
+                addInxVal(&token.sqlCondInp, COL_TOKEN_NAMESPACE, "= 'access_type'");
+                snprintf(condition, sizeof(condition), "= '%s'", ACCESS_DELETE_OBJECT);
+                addInxVal(&token.sqlCondInp, COL_TOKEN_NAME, condition);
+                addInxIval(&token.selectInp, COL_TOKEN_ID, 1);
+                const auto token_ids = query_values(token);
+
+                if (group_ids.empty() || token_ids.empty()) {
+                    return CAT_NO_ROWS_FOUND;
+                }
+
+                std::string in_groups = "in (";
+                for (const auto& id : group_ids) {
+                    in_groups += (&id == &group_ids.front() ? "'" : ",'") + id + "'";
+                }
+                in_groups += ")";
+                addInxVal(&_input.sqlCondInp, COL_DATA_ACCESS_USER_ID, in_groups.c_str());
+
+                snprintf(condition, sizeof(condition), ">= '%s'", token_ids.front().c_str());
+                addInxVal(&_input.sqlCondInp, COL_DATA_ACCESS_TYPE, condition);
+            }
+
+            addInxIval(&_input.selectInp, COL_D_DATA_ID, ORDER_BY);
+            addInxIval(&_input.selectInp, COL_COLL_NAME, 1);
+            addInxIval(&_input.selectInp, COL_DATA_NAME, 1);
+            addInxIval(&_input.selectInp, COL_DATA_REPL_NUM, 1);
+            addInxIval(&_input.selectInp, COL_D_RESC_ID, 1);
+            addInxIval(&_input.selectInp, COL_D_DATA_PATH, 1);
+            addInxIval(&_input.selectInp, COL_DATA_TYPE_NAME, 1);
+            addInxIval(&_input.selectInp, COL_D_REPL_STATUS, 1);
+
+            _input.maxRows = MAX_SQL_ROWS;
+
+            return 0;
+        } // make_query
+
+        auto resource(rodsLong_t _id) -> const resource_info&
+        {
+            if (const auto iter = resources_.find(_id); iter != resources_.end()) {
+                return iter->second;
+            }
+
+            resource_info info{false, {}, {}, {}, false};
+
+            std::string resc_class;
+            if (irods::get_resource_property<std::string>(_id, irods::RESOURCE_CLASS, resc_class).ok() &&
+                irods::RESOURCE_CLASS_BUNDLE != resc_class &&
+                resc_mgr.leaf_id_to_hier(_id, info.hierarchy).ok() &&
+                irods::get_loc_for_hier_string(info.hierarchy, info.location).ok() &&
+                irods::is_hier_live(info.hierarchy).ok())
+            {
+                if (!irods::get_resource_property<bool>(_id, irods::RESOURCE_SKIP_VAULT_PATH_CHECK_ON_UNLINK, info.skip_vault_path_check).ok()) {
+                    info.skip_vault_path_check = false;
+                }
+
+                info.usable = info.skip_vault_path_check ||
+                              irods::get_vault_path_for_hier_string(info.hierarchy, info.vault_path).ok();
+            }
+
+            return resources_.emplace(_id, std::move(info)).first->second;
+        } // resource
+
+        auto add_rows(const genQueryOut_t& _output) -> int
+        {
+            const auto* data_id = getSqlResultByInx(const_cast<genQueryOut_t*>(&_output), COL_D_DATA_ID);
+            const auto* coll_name = getSqlResultByInx(const_cast<genQueryOut_t*>(&_output), COL_COLL_NAME);
+            const auto* data_name = getSqlResultByInx(const_cast<genQueryOut_t*>(&_output), COL_DATA_NAME);
+            const auto* resc_id = getSqlResultByInx(const_cast<genQueryOut_t*>(&_output), COL_D_RESC_ID);
+            const auto* data_path = getSqlResultByInx(const_cast<genQueryOut_t*>(&_output), COL_D_DATA_PATH);
+            const auto* data_type = getSqlResultByInx(const_cast<genQueryOut_t*>(&_output), COL_DATA_TYPE_NAME);
+            const auto* repl_status = getSqlResultByInx(const_cast<genQueryOut_t*>(&_output), COL_D_REPL_STATUS);
+
+            if (!data_id || !coll_name || !data_name || !resc_id || !data_path || !data_type || !repl_status) {
+                return SYS_INTERNAL_NULL_INPUT_ERR;
+            }
+
+            int saved_status = 0;
+
+            for (int i = 0; i < _output.rowCnt; ++i) {
+                const auto id = std::strtoll(data_id->value + i * data_id->len, nullptr, 10);
+
+                // Rows are ordered by data id, but the replicas of a data object may
+                // span pages, so it is only complete once a row of another one is seen.
+                if (!current_ || current_->id != id) {
+                    finish_object();
+
+                    if (static_cast<int>(batch_.size()) >= batch_size_) {
+                        if (const auto ec = flush_batch(); ec < 0) {
+                            saved_status = ec;
+                        }
+
+                        if (client_gone_) {
+                            return saved_status;
+                        }
+                    }
+
+                    current_ = data_object{id,
+                                           std::string{coll_name->value + i * coll_name->len} + '/' + (data_name->value + i * data_name->len),
+                                           0 != std::strcmp(data_type->value + i * data_type->len, TAR_BUNDLE_DT_STR),
+                                           {}};
+                }
+
+                const auto status = std::atoi(repl_status->value + i * repl_status->len);
+                const auto resource_id = std::strtoll(resc_id->value + i * resc_id->len, nullptr, 10);
+                const std::string physical_path = data_path->value + i * data_path->len;
+                const auto& info = resource(resource_id);
+
+                if ((GOOD_REPLICA != status && STALE_REPLICA != status) ||
+                    !info.usable ||
+                    (!info.skip_vault_path_check && !has_prefix(physical_path.c_str(), info.vault_path.c_str())))
+                {
+                    current_->eligible = false;
+                }
+
+                current_->replicas.push_back({resource_id, physical_path});
+            }
+
+            return saved_status;
+        } // add_rows
+
+        auto finish_object() -> void
+        {
+            if (current_ && current_->eligible) {
+                batch_.push_back(std::move(*current_));
+            }
+
+            current_.reset();
+        } // finish_object
+
+        // Unlinks the replicas of the batch and returns the ids of the data objects for
+        // which this failed.
+        auto unlink_batch() -> std::set<rodsLong_t>
+        {
+            std::map<rodsLong_t, std::vector<std::pair<rodsLong_t, fileUnlinkInp_t>>> by_resource;
+
+            for (const auto& object : batch_) {
+                for (const auto& r : object.replicas) {
+                    const auto& info = resource(r.resource_id);
+
+                    fileUnlinkInp_t input{};
+                    rstrcpy(input.fileName, r.physical_path.c_str(), MAX_NAME_LEN);
+                    rstrcpy(input.rescHier, info.hierarchy.c_str(), MAX_NAME_LEN);
+                    rstrcpy(input.addr.hostAddr, info.location.c_str(), NAME_LEN);
+                    rstrcpy(input.objPath, object.logical_path.c_str(), MAX_NAME_LEN);
+
+                    by_resource[r.resource_id].emplace_back(object.id, input);
+                }
+            }
+
+            std::set<rodsLong_t> failed;
+            std::mutex mutex;
+
+            const auto unlink = [&failed, &mutex](auto _first, auto _last, auto&& _unlink_one) {
+                for (; _first != _last; ++_first) {
+                    // ENOENT and EACCES are tolerated, as in dataObjUnlinkS.
+                    if (const auto ec = _unlink_one(_first->second); ec < 0 && ENOENT != getErrno(ec) && EACCES != getErrno(ec)) {
+                        rodsLog(LOG_NOTICE, "bulk_remover: failed to unlink [%s] of [%s], status = %d",
+                                _first->second.fileName, _first->second.objPath, ec);
+                        std::lock_guard<std::mutex> lock{mutex};
+                        failed.insert(_first->first);
+                    }
+                }
+            };
+
+            if (!connection_pool_) {
+                for (auto& [id, inputs] : by_resource) {
+                    unlink(inputs.begin(), inputs.end(), [this](fileUnlinkInp_t& _input) { return rsFileUnlink(&comm_, &_input); });
+                }
+
+                return failed;
+            }
+
+            // Each resource's replicas are split into one chunk per thread so that a
+            // single large resource still keeps every connection busy.
+            irods::thread_pool pool{threads_};
+
+            for (auto& [id, inputs] : by_resource) {
+                const auto chunk_size = (inputs.size() + threads_ - 1) / threads_;
+
+                for (std::size_t first = 0; first < inputs.size(); first += chunk_size) {
+                    const auto last = std::min(first + chunk_size, inputs.size());
+
+                    irods::thread_pool::post(pool, [this, &unlink, &failed, &mutex, first = inputs.begin() + first, last = inputs.begin() + last] {
+                        try {
+                            auto conn = connection_pool_->get_connection();
+                            unlink(first, last, [&conn](fileUnlinkInp_t& _input) {
+                                return rcFileUnlink(static_cast<rcComm_t*>(conn), &_input);
+                            });
+                        }
+                        catch (const std::exception& e) {
+                            rodsLog(LOG_ERROR, "bulk_remover: %s", e.what());
+                            std::lock_guard<std::mutex> lock{mutex};
+                            std::for_each(first, last, [&failed](const auto& _p) { failed.insert(_p.first); });
+                        }
+                    });
+                }
+            }
+
+            pool.join();
+
+            return failed;
+        } // unlink_batch
+
+        auto flush_batch() -> int
+        {
+            if (batch_.empty()) {
+                return 0;
+            }
+
+            irods::at_scope_exit clear_batch{[this] { batch_.clear(); }};
+
+            const auto failed = unlink_batch();
+
+            std::vector<rodsLong_t> ids;
+            ids.reserve(batch_.size());
+            for (const auto& object : batch_) {
+                if (0 == failed.count(object.id)) {
+                    ids.push_back(object.id);
+                }
+            }
+
+            if (ids.empty()) {
+                return 0;
+            }
+
+            if (const auto ec = chlUnregDataObjs(&comm_, &ids, &input_.condInput); ec < 0) {
+                rodsLog(LOG_ERROR, "bulk_remover: chlUnregDataObjs failed for %zu data objects under [%s], status = %d",
+                        ids.size(), input_.collName, ec);
+                return ec;
+            }
+
+            return report_progress(ids.size(), batch_.back().logical_path);
+        } // flush_batch
+
+        auto report_progress(std::size_t _count, const std::string& _last_path) -> int
+        {
+            if (!stat_ || !*stat_) {
+                return 0;
+            }
+
+            ( *stat_ )->filesCnt += _count;
+
+            if (( *stat_ )->filesCnt < FILE_CNT_PER_STAT_OUT) {
+                return 0;
+            }
+
+            rstrcpy(( *stat_ )->lastObjPath, _last_path.c_str(), MAX_NAME_LEN);
+
+            if (const auto ec = svrSendCollOprStat(&comm_, *stat_); ec < 0) {
+                rodsLogError(LOG_ERROR, ec, "bulk_remover: svrSendCollOprStat failed for %s. status = %d", input_.collName, ec);
+                *stat_ = nullptr;
+                client_gone_ = true;
+                return ec;
+            }
+
+            *stat_ = static_cast<collOprStat_t*>(malloc(sizeof(collOprStat_t)));
+            memset(*stat_, 0, sizeof(collOprStat_t));
+
+            return 0;
+        } // report_progress
+
+        rsComm_t& comm_;
+        collInp_t& input_;
+        collOprStat_t** stat_;
+        const int batch_size_;
+        const int threads_;
+        const bool admin_mode_;
+        std::shared_ptr<irods::connection_pool> connection_pool_;
+        std::map<rodsLong_t, resource_info> resources_;
+        std::optional<data_object> current_;
+        std::vector<data_object> batch_;
+
+        // Set once reporting progress fails, after which nothing more is removed.
+        bool client_gone_;
+    }; // class bulk_remover
+
+    // Runs the bulk delete for the data objects under the collection, if it is enabled
+    // and the removal is one it handles.
+    auto bulk_remove_data_objects(rsComm_t* rsComm,
+                                  collInp_t* rmCollInp,
+                                  const dataObjInfo_t* dataObjInfo,
+                                  collOprStat_t** collOprStat) -> int
+    {
+        if (getValByKey(&rmCollInp->condInput, BULK_DELETE_DONE_KW) ||
+            getValByKey(&rmCollInp->condInput, AGE_KW) ||
+            getValByKey(&rmCollInp->condInput, EMPTY_BUNDLE_ONLY_KW) ||
+            UNREG_OPR == rmCollInp->oprType ||
+            isHomeColl(rmCollInp->collName) ||
+            (dataObjInfo && dataObjInfo->specColl))
+        {
+            return 0;
+        }
+
+        int batch_size = 0;
+        int threads = 4;
+
+        try {
+            batch_size = irods::get_advanced_setting<const int>(irods::CFG_BULK_DELETE_BATCH_SIZE);
+        }
+        catch (const irods::exception&) {
+            // Not configured. The bulk delete is disabled by default.
+        }
+
+        if (batch_size <= 0) {
+            return 0;
+        }
+
+        try {
+            threads = irods::get_advanced_setting<const int>(irods::CFG_BULK_DELETE_NUMBER_OF_THREADS);
+        }
+        catch (const irods::exception&) {}
+
+        std::string svc_role;
+        if (const auto ret = get_catalog_service_role(svc_role); !ret.ok() || irods::CFG_SERVICE_ROLE_PROVIDER != svc_role) {
+            return 0;
+        }
+
+        return bulk_remover{*rsComm, *rmCollInp, collOprStat, batch_size, threads}.run();
+    } // bulk_remove_data_objects
+
     int rsRmColl_impl(rsComm_t* rsComm,
                       collInp_t* rmCollInp,
                       collOprStat_t** collOprStat)
@@ -354,6 +854,21 @@ _rsPhyRmColl( rsComm_t *rsComm, collInp_t *rmCollInp,
         addKeyVal( &dataObjInp.condInput, EMPTY_BUNDLE_ONLY_KW, "" );
     }
     // =-=-=-=-=-=-=-
+    /* remove the data objects of the whole subtree in batches first. the
+     * loop below then removes whatever is left and the collections */
+    status = bulk_remove_data_objects( rsComm, rmCollInp, dataObjInfo, collOprStat );
+    if ( status < 0 ) {
+        savedStatus = status;
+        if ( collOprStat != NULL && *collOprStat == NULL ) {
+            /* could not send the progress to the client */
+            rsCloseCollection( rsComm, &handleInx );
+            clearKeyVal( &tmpCollInp.condInput );
+            clearKeyVal( &dataObjInp.condInput );
+            return savedStatus;
+        }
+    }
+    addKeyVal( &tmpCollInp.condInput, BULK_DELETE_DONE_KW, "" );
+
     collEnt_t *collEnt = NULL;
     while ( ( status = rsReadCollection( rsComm, &handleInx, &collEnt ) ) >= 0 ) {
         if ( entCnt == 0 ) {
@@ -13,6 +13,25 @@
   Authenticated
   $
 
+  When started with --daemon, this program instead stays resident and serves
+  authentication requests from the iRODS agents over a Unix domain socket,
+  avoiding a fork and exec per login.  The iRODS server starts it this way
+  when authentication.pam.helper_worker_count is greater than zero.
+
+  $ ./irodsPamAuthCheck --daemon /path/to/socket worker_count
+
+  Every request on a connection is framed as a 32-bit big-endian length
+  followed by the username, then a 32-bit big-endian length followed by the
+  password.  Each request is answered with a 32-bit big-endian status: 0 when
+  authenticated, 1 when not authenticated, and 2 when PAM could not be
+  started.  Only the user which started the daemon may connect.
+
+  The daemon creates its socket with the privileges of the user which
+  started it, not with those of the set UID owner.  PAM modules are not
+  thread-safe, so the daemon forks worker_count worker processes once at
+  startup, which accept and serve connections on the shared socket.  A worker
+  which exits is replaced.
+
   You may need to install PAM libraries, such as libpam0g-dev:
   sudo apt-get install libpam0g-dev
 
@@ -36,6 +55,15 @@
 #include <map>
 #include <string>
 
+#include <arpa/inet.h>
+#include <signal.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
 namespace {
     const char pam_service[] = "irods";
 
@@ -87,14 +115,248 @@ namespace {
     }
 }
 
+namespace {
+    // status codes returned by check_password and sent by the daemon
+    const uint32_t STATUS_AUTHENTICATED     = 0;
+    const uint32_t STATUS_NOT_AUTHENTICATED = 1;
+    const uint32_t STATUS_PAM_ERROR         = 2;
+    const uint32_t STATUS_RELEASE_ERROR     = 3; // reported to daemon clients as STATUS_PAM_ERROR
+
+    // bounds on the lengths accepted from a daemon client
+    const uint32_t MAX_USERNAME_LENGTH = 1024;
+    const uint32_t MAX_PASSWORD_LENGTH = 4096;
+
+    // a client which stalls mid-request releases its worker after this long
+    const int CLIENT_TIMEOUT_IN_SECONDS = 10;
+
+    uint32_t check_password(
+        const char* _username,
+        AppData&    _appdata ) {
+        pam_conv conv = { null_conv, &_appdata };
+        pam_handle_t *pamh = NULL;
+        const int retval_pam_start = pam_start( pam_service, _username, &conv, &pamh );
+        if ( _appdata.debug_mode ) {
+            printf( "retval_pam_start: %d\n", retval_pam_start );
+        }
+
+        if ( retval_pam_start != PAM_SUCCESS ) {
+            fprintf( stderr, "irodsPamAuthCheck: pam_start error\n" );
+            return STATUS_PAM_ERROR;
+        }
+
+        // check username-password
+        const int retval_pam_authenticate = pam_authenticate( pamh, 0 );
+        if ( _appdata.debug_mode ) {
+            printf( "retval_pam_authenticate: %d\n", retval_pam_authenticate );
+        }
+
+        // close Linux-PAM
+        if ( pam_end( pamh, retval_pam_authenticate ) != PAM_SUCCESS ) {
+            pamh = NULL;
+            fprintf( stderr, "irodsPamAuthCheck: failed to release authenticator\n" );
+            return STATUS_RELEASE_ERROR;
+        }
+
+        return retval_pam_authenticate == PAM_SUCCESS ? STATUS_AUTHENTICATED : STATUS_NOT_AUTHENTICATED;
+    }
+
+    bool read_exactly( int _fd, void* _buf, size_t _len ) {
+        char* ptr = static_cast<char*>( _buf );
+        while ( _len > 0 ) {
+            const ssize_t n = read( _fd, ptr, _len );
+            if ( n <= 0 ) {
+                return false;
+            }
+            ptr  += n;
+            _len -= n;
+        }
+        return true;
+    }
+
+    bool write_exactly( int _fd, const void* _buf, size_t _len ) {
+        const char* ptr = static_cast<const char*>( _buf );
+        while ( _len > 0 ) {
+            const ssize_t n = write( _fd, ptr, _len );
+            if ( n <= 0 ) {
+                return false;
+            }
+            ptr  += n;
+            _len -= n;
+        }
+        return true;
+    }
+
+    bool read_field( int _fd, uint32_t _max_length, std::string& _field ) {
+        uint32_t length = 0;
+        if ( !read_exactly( _fd, &length, sizeof( length ) ) ) {
+            return false;
+        }
+
+        length = ntohl( length );
+        if ( length > _max_length ) {
+            return false;
+        }
+
+        _field.assign( length, '\0' );
+        return read_exactly( _fd, &_field[0], length );
+    }
+
+    // answers requests on a client connection until it is closed
+    void serve_client( int _fd ) {
+        while ( true ) {
+            std::string username;
+            AppData appdata;
+            appdata.debug_mode = false;
+            if ( !read_field( _fd, MAX_USERNAME_LENGTH, username ) ||
+                 !read_field( _fd, MAX_PASSWORD_LENGTH, appdata.password ) ) {
+                break;
+            }
+
+            uint32_t status = check_password( username.c_str(), appdata );
+            if ( status == STATUS_RELEASE_ERROR ) {
+                status = STATUS_PAM_ERROR;
+            }
+            status = htonl( status );
+            std::fill( appdata.password.begin(), appdata.password.end(), '\0' );
+            if ( !write_exactly( _fd, &status, sizeof( status ) ) ) {
+                break;
+            }
+        }
+
+        close( _fd );
+    }
+
+    // accepts and serves connections until the daemon goes away
+    void run_worker( int _listen_fd, pid_t _daemon_pid, uid_t _owner_uid, uid_t _privileged_uid ) {
+        prctl( PR_SET_PDEATHSIG, SIGTERM );
+        if ( getppid() != _daemon_pid ) {
+            _exit( 0 );
+        }
+
+        if ( seteuid( _privileged_uid ) < 0 ) {
+            perror( "irodsPamAuthCheck: seteuid" );
+        }
+
+        while ( true ) {
+            const int fd = accept( _listen_fd, NULL, NULL );
+            if ( fd < 0 ) {
+                continue;
+            }
+
+            ucred cred{};
+            socklen_t cred_len = sizeof( cred );
+            if ( getsockopt( fd, SOL_SOCKET, SO_PEERCRED, &cred, &cred_len ) < 0 ||
+                 ( cred.uid != _owner_uid && cred.uid != 0 ) ) {
+                close( fd );
+                continue;
+            }
+
+            timeval timeout{};
+            timeout.tv_sec = CLIENT_TIMEOUT_IN_SECONDS;
+            setsockopt( fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof( timeout ) );
+            setsockopt( fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof( timeout ) );
+
+            serve_client( fd );
+        }
+    }
+
+    int run_daemon( const char* _socket_path, int _worker_count ) {
+        // the server which started us owns our lifetime
+        prctl( PR_SET_PDEATHSIG, SIGTERM );
+        if ( getppid() == 1 ) {
+            return 5;
+        }
+
+        // a client closing its connection early must not kill the daemon
+        signal( SIGPIPE, SIG_IGN );
+
+        // The socket path comes from the command line, so it is only ever touched
+        // with the privileges of the user which started the daemon.  The set UID
+        // privileges are regained in the workers, for PAM only.
+        const uid_t privileged_uid = geteuid();
+        if ( setegid( getgid() ) < 0 || seteuid( getuid() ) < 0 ) {
+            perror( "irodsPamAuthCheck: seteuid" );
+            return 6;
+        }
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if ( strlen( _socket_path ) >= sizeof( addr.sun_path ) ) {
+            fprintf( stderr, "irodsPamAuthCheck: socket path too long\n" );
+            return 6;
+        }
+        strncpy( addr.sun_path, _socket_path, sizeof( addr.sun_path ) - 1 );
+
+        const int listen_fd = socket( AF_UNIX, SOCK_STREAM, 0 );
+        if ( listen_fd < 0 ) {
+            perror( "irodsPamAuthCheck: socket" );
+            return 6;
+        }
+
+        unlink( _socket_path );
+        if ( bind( listen_fd, reinterpret_cast<sockaddr*>( &addr ), sizeof( addr ) ) < 0 ) {
+            perror( "irodsPamAuthCheck: bind" );
+            return 6;
+        }
+
+        // only the account which started the daemon may use it
+        const uid_t owner_uid = getuid();
+        if ( chmod( _socket_path, S_IRUSR | S_IWUSR ) < 0 ) {
+            perror( "irodsPamAuthCheck: chmod" );
+            return 6;
+        }
+
+        if ( listen( listen_fd, SOMAXCONN ) < 0 ) {
+            perror( "irodsPamAuthCheck: listen" );
+            return 6;
+        }
+
+        // the workers are forked once; this process only replaces those which exit
+        const pid_t daemon_pid = getpid();
+        int active_workers = 0;
+        while ( true ) {
+            if ( active_workers < _worker_count ) {
+                const pid_t pid = fork();
+                if ( pid == 0 ) {
+                    run_worker( listen_fd, daemon_pid, owner_uid, privileged_uid );
+                    _exit( 0 );
+                }
+
+                if ( pid < 0 ) {
+                    perror( "irodsPamAuthCheck: fork" );
+                    sleep( 1 );
+                }
+                else {
+                    ++active_workers;
+                }
+                continue;
+            }
+
+            if ( waitpid( -1, NULL, 0 ) > 0 ) {
+                --active_workers;
+            }
+        }
+    }
+}
+
 int main( int argc, char *argv[] ) {
 
+    if ( argc == 4 && std::string( argv[1] ) == "--daemon" ) {
+        const int worker_count = atoi( argv[3] );
+        if ( worker_count < 1 ) {
+            fprintf( stderr, "irodsPamAuthCheck: worker_count must be positive\n" );
+            return 2;
+        }
+        return run_daemon( argv[2], worker_count );
+    }
+
     const char *username = NULL;
     if ( argc == 2 || argc == 3 ) {
         username = argv[1];
     }
     else {
         fprintf( stderr, "Usage: irodsPamAuthCheck username [extra-arg-activates-debug-mode]\n" );
+        fprintf( stderr, "       irodsPamAuthCheck --daemon socket_path worker_count\n" );
         return 2;
     }
 
@@ -107,38 +369,21 @@ int main( int argc, char *argv[] ) {
         printf( "password bytes: %ju\n", ( uintmax_t )appdata.password.size() );
     }
 
-    pam_conv conv = { null_conv, &appdata };
-    pam_handle_t *pamh = NULL;
-    const int retval_pam_start = pam_start( pam_service, username, &conv, &pamh );
-    if ( appdata.debug_mode ) {
-        printf( "retval_pam_start: %d\n", retval_pam_start );
-    }
-
-    if ( retval_pam_start != PAM_SUCCESS ) {
-        fprintf( stderr, "irodsPamAuthCheck: pam_start error\n" );
+    const uint32_t status = check_password( username, appdata );
+    if ( status == STATUS_PAM_ERROR ) {
         return 3;
     }
-
-    // check username-password
-    const int retval_pam_authenticate = pam_authenticate( pamh, 0 );
-    if ( appdata.debug_mode ) {
-        printf( "retval_pam_authenticate: %d\n", retval_pam_authenticate );
+    if ( status == STATUS_RELEASE_ERROR ) {
+        return 4;
     }
 
-    if ( retval_pam_authenticate == PAM_SUCCESS ) {
+    if ( status == STATUS_AUTHENTICATED ) {
         fprintf( stdout, "Authenticated\n" );
     }
     else {
         fprintf( stdout, "Not Authenticated\n" );
     }
 
-    // close Linux-PAM
-    if ( pam_end( pamh, retval_pam_authenticate ) != PAM_SUCCESS ) {
-        pamh = NULL;
-        fprintf( stderr, "irodsPamAuthCheck: failed to release authenticator\n" );
-        return 4;
-    }
-
     // indicate success (valid username and password) or not
-    return retval_pam_authenticate == PAM_SUCCESS ? 0 : 1;
+    return status == STATUS_AUTHENTICATED ? 0 : 1;
 }
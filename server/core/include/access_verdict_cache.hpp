@@ -0,0 +1,117 @@
+#ifndef IRODS_ACCESS_VERDICT_CACHE_HPP
+#define IRODS_ACCESS_VERDICT_CACHE_HPP
+
+/// \file
+
+#include "rodsType.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace irods::experimental::access_verdict_cache
+{
+    /// Identifies a verdict: a subject (a user or a ticket used by a user from a host)
+    /// holding an access level on a data object or collection.
+    ///
+    /// Only granted verdicts are cached. Object IDs are never reused, so removing objects
+    /// does not require invalidation. Renaming or moving objects does, because a ticket on a
+    /// collection only covers the objects under it.
+    ///
+    /// \since 4.3.0
+    struct key
+    {
+        std::string_view subject;
+        rodsLong_t object_id;
+        std::string_view access_level;
+    }; // struct key
+
+    /// Returns the subject of a user for use in a key.
+    ///
+    /// \since 4.3.0
+    auto user_subject(std::string_view _user_name, std::string_view _zone_name) -> std::string;
+
+    /// Returns the subject of a ticket used by a user from a host for use in a key.
+    ///
+    /// \since 4.3.0
+    auto ticket_subject(std::string_view _ticket,
+                        std::string_view _host,
+                        std::string_view _user_name,
+                        std::string_view _zone_name) -> std::string;
+
+    /// Initializes the shared state of the cache.
+    ///
+    /// This function should only be called on startup of the server. Agents forked from the
+    /// calling process inherit the cache and share invalidations through it. Without it,
+    /// invalidations only affect the agent that made the change.
+    ///
+    /// \param[in] _shm_name The name of the shared memory to create.
+    /// \param[in] _shm_size The size of the shared memory to allocate in bytes. If it only
+    ///                      fits the invalidation counter, each agent keeps its own verdicts.
+    ///
+    /// \since 4.3.0
+    auto init(const std::string_view _shm_name = "irods_access_verdict_cache",
+              std::size_t _shm_size = 0) -> void;
+
+    /// Cleans up any resources created via init().
+    ///
+    /// This function must be called from the same process that called init().
+    ///
+    /// \since 4.3.0
+    auto deinit() noexcept -> void;
+
+    /// Sets how long verdicts are kept and how many verdicts an agent keeps when they are
+    /// not shared.
+    ///
+    /// If this function is not called, both are read from server_config.json on first use.
+    ///
+    /// \param[in] _time_to_live The lifetime of a verdict. Zero disables the cache.
+    /// \param[in] _max_entries  The maximum number of verdicts kept by this agent.
+    ///
+    /// \since 4.3.0
+    auto configure(std::chrono::seconds _time_to_live, std::size_t _max_entries) -> void;
+
+    /// Returns whether verdicts are cached.
+    ///
+    /// \since 4.3.0
+    auto enabled() -> bool;
+
+    /// Returns the number of invalidations so far.
+    ///
+    /// Read this before querying the catalog and pass it to insert(), so that a verdict
+    /// computed while permissions were being changed is never cached.
+    ///
+    /// \since 4.3.0
+    auto generation() noexcept -> std::uint64_t;
+
+    /// Returns whether the access described by \p _key was granted recently.
+    ///
+    /// \since 4.3.0
+    auto contains(const key& _key) -> bool;
+
+    /// Records that the access described by \p _key was granted.
+    ///
+    /// \param[in] _key        The verdict.
+    /// \param[in] _generation The value returned by generation() before the catalog was
+    ///                        queried.
+    /// \param[in] _expires_at Seconds since the epoch after which the verdict no longer
+    ///                        holds (e.g. the expiry of a ticket), or zero.
+    ///
+    /// \since 4.3.0
+    auto insert(const key& _key, std::uint64_t _generation, std::int64_t _expires_at = 0) -> void;
+
+    /// Discards all verdicts in this agent and, if the cache is shared, in all agents of
+    /// this server. Called after permissions, group memberships, users or tickets change.
+    ///
+    /// \since 4.3.0
+    auto invalidate() noexcept -> void;
+
+    /// Returns the number of verdicts held for this agent.
+    ///
+    /// \since 4.3.0
+    auto size() -> std::size_t;
+} // namespace irods::experimental::access_verdict_cache
+
+#endif // IRODS_ACCESS_VERDICT_CACHE_HPP
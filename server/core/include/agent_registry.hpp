@@ -0,0 +1,131 @@
+#ifndef IRODS_AGENT_REGISTRY_HPP
+#define IRODS_AGENT_REGISTRY_HPP
+
+/// \file
+
+#include "rodsDef.h"
+
+#include <sys/types.h>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace irods::experimental::agent_registry
+{
+    /// Describes an agent and what it has done since it started.
+    ///
+    /// \since 4.3.0
+    struct agent_info
+    {
+        pid_t pid;
+        char client_name[NAME_LEN];
+        char client_zone[NAME_LEN];
+        char proxy_name[NAME_LEN];
+        char proxy_zone[NAME_LEN];
+        char program_name[NAME_LEN];
+        char remote_address[NAME_LEN];
+        std::int64_t start_time;                       // Seconds since epoch at which the agent registered.
+        std::int64_t api_number;                       // The API being executed, or zero if idle.
+        std::int64_t api_start_time;                   // Milliseconds since epoch at which the current API call started.
+        std::int64_t api_calls;                        // Number of API calls started.
+        std::int64_t bytes_read;                       // Bytes read from storage resources.
+        std::int64_t bytes_written;                    // Bytes written to storage resources.
+        std::int64_t catalog_operations;               // Number of calls into the database plugin.
+        std::int64_t rule_engine_time_microseconds;    // Time spent in rule engine plugins.
+    }; // struct agent_info
+
+    /// Initializes the agent registry.
+    ///
+    /// This function should only be called on startup of the server. Agents forked from
+    /// the calling process inherit the registry.
+    ///
+    /// \param[in] _shm_name   The name of the shared memory to create.
+    /// \param[in] _max_agents The number of agents that can be registered at the same time.
+    ///
+    /// \since 4.3.0
+    auto init(const std::string_view _shm_name = "irods_agent_registry", std::size_t _max_agents = 4096) -> void;
+
+    /// Cleans up any resources created via init().
+    ///
+    /// This function must be called from the same process that called init().
+    ///
+    /// \since 4.3.0
+    auto deinit() noexcept -> void;
+
+    /// Registers the calling process with the identity in \p _info.
+    ///
+    /// The counters of \p _info are ignored and start at zero. The pid and start time
+    /// are set by this function.
+    ///
+    /// \return A boolean value.
+    /// \retval true  If the process was registered.
+    /// \retval false If the registry is full or has not been initialized.
+    ///
+    /// \since 4.3.0
+    auto register_agent(const agent_info& _info) -> bool;
+
+    /// Removes the entry of \p _pid. Called for agents that have exited.
+    ///
+    /// \since 4.3.0
+    auto unregister_agent(pid_t _pid) noexcept -> void;
+
+    /// Records that the calling agent started executing \p _api_number.
+    ///
+    /// This and the other update functions are cheap enough to call on every API call
+    /// and I/O operation. They do nothing if the calling process is not registered.
+    ///
+    /// \since 4.3.0
+    auto begin_api(int _api_number) noexcept -> void;
+
+    /// Records that the calling agent finished executing its current API.
+    ///
+    /// \since 4.3.0
+    auto end_api() noexcept -> void;
+
+    /// \since 4.3.0
+    auto add_bytes_read(std::int64_t _bytes) noexcept -> void;
+
+    /// \since 4.3.0
+    auto add_bytes_written(std::int64_t _bytes) noexcept -> void;
+
+    /// \since 4.3.0
+    auto increment_catalog_operations() noexcept -> void;
+
+    /// Measures the time spent in the rule engine by the calling thread while it exists.
+    ///
+    /// Timers created while another timer exists on the same thread (i.e. rules invoked
+    /// by rules) are not counted twice.
+    ///
+    /// \since 4.3.0
+    class scoped_rule_engine_timer
+    {
+    public:
+        scoped_rule_engine_timer() noexcept;
+        ~scoped_rule_engine_timer();
+
+        scoped_rule_engine_timer(const scoped_rule_engine_timer&) = delete;
+        auto operator=(const scoped_rule_engine_timer&) -> scoped_rule_engine_timer& = delete;
+
+    private:
+        bool outermost_;
+        std::chrono::steady_clock::time_point start_;
+    }; // class scoped_rule_engine_timer
+
+    /// Returns the entry of \p _pid.
+    ///
+    /// \since 4.3.0
+    auto lookup(pid_t _pid) -> std::optional<agent_info>;
+
+    /// Returns the entries of all registered agents.
+    ///
+    /// Returns an empty list if the registry has not been initialized by this process or
+    /// one of its ancestors.
+    ///
+    /// \since 4.3.0
+    auto list() -> std::vector<agent_info>;
+} // namespace irods::experimental::agent_registry
+
+#endif // IRODS_AGENT_REGISTRY_HPP
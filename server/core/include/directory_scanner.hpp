@@ -0,0 +1,123 @@
+#ifndef IRODS_DIRECTORY_SCANNER_HPP
+#define IRODS_DIRECTORY_SCANNER_HPP
+
+/// \file
+
+#include "rodsType.h"
+#include "thread_pool.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace irods::experimental::directory_scanner
+{
+    /// A regular file or subdirectory found by the scanner.
+    struct entry
+    {
+        std::string physical_path;
+        std::string logical_path;
+        rodsLong_t size;
+        bool is_directory;
+    }; // struct entry
+
+    /// A group of entries handed to the consumer at once.
+    ///
+    /// Every entry of a batch belongs to the same directory. A subdirectory is always
+    /// delivered in an earlier batch than any of its own entries.
+    struct batch
+    {
+        std::vector<entry> entries;
+
+        /// Physical paths of the directories whose entries were all delivered in this
+        /// batch or an earlier one.
+        std::vector<std::string> completed_directories;
+    }; // struct batch
+
+    struct options
+    {
+        /// The number of threads reading directories.
+        int number_of_threads;
+
+        /// The maximum number of entries in a batch.
+        std::size_t batch_size;
+
+        /// The maximum number of batches waiting for the consumer. Scanning threads wait
+        /// for the consumer once this limit is reached.
+        std::size_t max_pending_batches;
+
+        /// Returns true if an entry must be ignored. Receives the name of the entry and
+        /// the physical path of its directory. May be called concurrently.
+        std::function<bool(const char*, const std::string&)> exclude;
+
+        /// Returns true if only the subdirectories of a directory are needed, e.g. because
+        /// its files were handled by an earlier scan. Receives the physical path of the
+        /// directory. May be called concurrently.
+        std::function<bool(const std::string&)> skip_files;
+    }; // struct options
+
+    /// Scans a physical directory tree in parallel.
+    ///
+    /// Each directory is read by one thread in large getdents64(2) batches. Only regular
+    /// files are stat'ed (with statx(2) restricted to the type and size when available),
+    /// because the type of other entries is usually known from the directory itself.
+    /// Symbolic links are followed.
+    ///
+    /// Memory is bounded by the number of pending batches plus one batch per thread. The
+    /// directories waiting to be read are queued without limit.
+    ///
+    /// \since 4.3.0
+    class scanner
+    {
+    public:
+        /// Starts scanning \p _directory, which maps to \p _collection.
+        scanner(const std::string& _directory, const std::string& _collection, options _options);
+
+        scanner(const scanner&) = delete;
+        auto operator=(const scanner&) -> scanner& = delete;
+
+        /// Stops scanning and waits for the scanning threads.
+        ~scanner();
+
+        /// Waits for the next batch.
+        ///
+        /// \return The next batch, or std::nullopt once the whole tree has been delivered.
+        auto next() -> std::optional<batch>;
+
+        /// Returns the last error (an iRODS error code) encountered, or zero.
+        ///
+        /// Directories and entries that could not be read are skipped.
+        auto status() const -> int;
+
+    private:
+        using directory_list = std::vector<std::pair<std::string, std::string>>;
+
+        auto visit(const std::string& _directory, const std::string& _collection) -> void;
+
+        auto read_directory(const std::string& _directory, const std::string& _collection) -> void;
+
+        auto push(batch&& _batch) -> bool;
+
+        auto schedule(directory_list& _directories) -> void;
+
+        auto set_status(int _status) -> void;
+
+        const options options_;
+        mutable std::mutex mutex_;
+        std::condition_variable batch_available_;
+        std::condition_variable space_available_;
+        std::deque<batch> batches_;
+        std::size_t pending_directories_;
+        bool cancelled_;
+        int status_;
+        irods::thread_pool pool_;
+    }; // class scanner
+} // namespace irods::experimental::directory_scanner
+
+#endif // IRODS_DIRECTORY_SCANNER_HPP
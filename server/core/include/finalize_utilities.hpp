@@ -3,6 +3,8 @@
 
 #include "rodsType.h"
 
+#include <optional>
+#include <string>
 #include <string_view>
 
 struct RsComm;
@@ -91,6 +93,28 @@ namespace irods
     /// \since 4.2.9
     auto apply_static_post_pep(RsComm& _comm, l1desc& _l1desc, const int _operation_status, std::string_view _pep_name) -> int;
 
+    /// \brief Computes the checksum of the replica opened in _l1desc as its data is written
+    ///
+    /// Nothing is computed for special collections, replicas in remote zones, or replicas
+    /// that are not written sequentially through the physical descriptor of _l1desc.
+    ///
+    /// \param[in] _l1desc
+    ///
+    /// \since 4.3.0
+    auto start_inline_checksum(const l1desc& _l1desc) -> void;
+
+    /// \brief Returns the checksum computed while the replica described by _info was written
+    ///
+    /// The hash scheme is resolved the same way rsFileChksum resolves it, including the
+    /// ORIG_CHKSUM_KW in the condInput of _info and the configured hash policy.
+    ///
+    /// \param[in] _info
+    ///
+    /// \returns std::nullopt if no checksum is available for the replica in the resolved scheme
+    ///
+    /// \since 4.3.0
+    auto find_inline_checksum(const DataObjInfo& _info) -> std::optional<std::string>;
+
     // TODO: ...remove this.
     auto purge_cache(RsComm& _comm, DataObjInfo& _info) -> int;
 
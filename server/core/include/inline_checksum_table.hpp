@@ -0,0 +1,80 @@
+#ifndef IRODS_INLINE_CHECKSUM_TABLE_HPP
+#define IRODS_INLINE_CHECKSUM_TABLE_HPP
+
+/// \file
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace irods::experimental::inline_checksum_table
+{
+    /// Starts computing a checksum over the bytes written through a physical file descriptor.
+    ///
+    /// The checksum remains valid for as long as every byte is written sequentially from
+    /// offset zero. Seeking anywhere other than the end of the hashed data invalidates it.
+    /// Any entries for the same physical file that were released earlier are discarded.
+    ///
+    /// This table is local to the agent and is safe to use from multiple threads.
+    ///
+    /// \param[in] _l3_index           The index of the physical file descriptor (FileDesc).
+    /// \param[in] _resource_hierarchy The resource hierarchy of the replica being written.
+    /// \param[in] _physical_path      The physical path of the replica being written.
+    /// \param[in] _scheme             The name of the hash scheme (e.g. "md5", "sha256").
+    ///
+    /// \return A boolean value.
+    /// \retval true  If the hash scheme is supported and the entry was created.
+    /// \retval false Otherwise.
+    ///
+    /// \since 4.3.0
+    auto start(int _l3_index,
+               const std::string_view _resource_hierarchy,
+               const std::string_view _physical_path,
+               const std::string_view _scheme) -> bool;
+
+    /// Adds bytes written through a physical file descriptor to its checksum.
+    ///
+    /// Does nothing if start() was not called for \p _l3_index.
+    ///
+    /// \since 4.3.0
+    auto update(int _l3_index, const void* _buffer, std::int64_t _length) -> void;
+
+    /// Records that the offset of a physical file descriptor changed.
+    ///
+    /// The checksum is invalidated unless \p _offset is the number of bytes hashed so far.
+    ///
+    /// \since 4.3.0
+    auto seek(int _l3_index, std::int64_t _offset) -> void;
+
+    /// Marks the physical file descriptor as closed.
+    ///
+    /// The checksum remains available to find() until erase_released_entries() is called.
+    ///
+    /// \since 4.3.0
+    auto release(int _l3_index) -> void;
+
+    /// Returns the checksum of a closed physical file if it was computed while writing it.
+    ///
+    /// Returns std::nullopt if no valid checksum covering exactly \p _size bytes in
+    /// \p _scheme is available.
+    ///
+    /// \param[in] _resource_hierarchy The resource hierarchy of the replica.
+    /// \param[in] _physical_path      The physical path of the replica.
+    /// \param[in] _size               The size of the replica in bytes.
+    /// \param[in] _scheme             The name of the hash scheme.
+    ///
+    /// \since 4.3.0
+    auto find(const std::string_view _resource_hierarchy,
+              const std::string_view _physical_path,
+              std::int64_t _size,
+              const std::string_view _scheme) -> std::optional<std::string>;
+
+    /// Discards all entries whose physical file descriptor has been released.
+    ///
+    /// \since 4.3.0
+    auto erase_released_entries() -> void;
+} // namespace irods::experimental::inline_checksum_table
+
+#endif // IRODS_INLINE_CHECKSUM_TABLE_HPP
+
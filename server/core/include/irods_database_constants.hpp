@@ -20,6 +20,7 @@ namespace irods {
     const std::string DATABASE_OP_REG_DATA_OBJ( "database_reg_data_obj" );
     const std::string DATABASE_OP_REG_REPLICA( "database_reg_replica" );
     const std::string DATABASE_OP_UNREG_REPLICA( "database_unreg_replica" );
+    const std::string DATABASE_OP_UNREG_DATA_OBJS( "database_unreg_data_objs" );
     const std::string DATABASE_OP_REG_RULE_EXEC( "database_reg_rule_exec" );
     const std::string DATABASE_OP_MOD_RULE_EXEC( "database_mod_rule_exec" );
     const std::string DATABASE_OP_DEL_RULE_EXEC( "database_del_rule_exec" );
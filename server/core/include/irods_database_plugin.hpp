@@ -5,6 +5,7 @@
 // irods includes
 #include "irods_plugin_base.hpp"
 #include "irods_database_types.hpp"
+#include "agent_registry.hpp"
 
 #include <iostream>
 
@@ -44,6 +45,18 @@ namespace irods {
                 return *this;
             }
 
+            // =-=-=-=-=-=-=-
+            /// @brief Invokes an operation, counting it in the agent registry
+            template< typename... types_t >
+            error call(
+                rsComm_t*                     _comm,
+                const std::string&            _operation_name,
+                irods::first_class_object_ptr _fco,
+                types_t...                    _t ) {
+                irods::experimental::agent_registry::increment_catalog_operations();
+                return plugin_base::call< types_t... >( _comm, _operation_name, _fco, _t... );
+            }
+
     }; // class database
 
 
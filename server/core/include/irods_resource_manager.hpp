@@ -5,8 +5,11 @@
 #include "rods.h"
 #include "irods_resource_plugin.hpp"
 #include "irods_first_class_object.hpp"
+#include "resource_hierarchy.hpp"
+#include "resource_hierarchy_cache.hpp"
 
 #include <functional>
+#include <memory>
 
 namespace irods
 {
@@ -167,6 +170,46 @@ namespace irods
             /// \since 4.2.9
             std::string resc_id_to_name(std::string_view _id);
 
+            /// \brief get the resc id of the resource given a name
+            ///
+            /// \param[in] _resource_name
+            ///
+            /// \retval resource id for given resource name
+            ///
+            /// \throws irods::exception
+            ///
+            /// \since 4.3.0
+            rodsLong_t resc_name_to_id(std::string_view _resource_name);
+
+            /// \brief get the hierarchy from the root resource to the provided leaf resource
+            ///
+            /// \param[in] _leaf_resource_id
+            ///
+            /// \retval resource hierarchy for given leaf resource ID
+            ///
+            /// \throws irods::exception
+            ///
+            /// \since 4.3.0
+            experimental::resource_hierarchy leaf_id_to_resource_hierarchy(rodsLong_t _leaf_resource_id);
+
+            /// \brief convert a resource hierarchy string into a resource_hierarchy
+            ///
+            /// \param[in] _hierarchy
+            ///
+            /// \throws irods::exception
+            ///
+            /// \since 4.3.0
+            experimental::resource_hierarchy to_resource_hierarchy(std::string_view _hierarchy);
+
+            /// \brief convert a resource_hierarchy into a resource hierarchy string
+            ///
+            /// \param[in] _hierarchy
+            ///
+            /// \throws irods::exception
+            ///
+            /// \since 4.3.0
+            std::string to_hierarchy_string(const experimental::resource_hierarchy& _hierarchy);
+
             // =-=-=-=-=-=-=-
             /// @brief check whether the specified resource name is a coordinating resource
             error is_coordinating_resource( const std::string&, bool& );
@@ -256,8 +299,26 @@ namespace irods
                 const std::string);
 
             // =-=-=-=-=-=-=-
-            /// @brief take results from genQuery, extract values and create resources
-            error process_init_results( genQueryOut_t* );
+            /// @brief take results from genQuery and extract the values describing each resource
+            error process_init_results( genQueryOut_t*, std::vector<experimental::resource_hierarchy_cache::resource_info>& );
+
+            // =-=-=-=-=-=-=-
+            /// @brief query the catalog for all resources
+            error query_resources( rsComm_t*, std::vector<experimental::resource_hierarchy_cache::resource_info>& );
+
+            // =-=-=-=-=-=-=-
+            /// @brief return the resource hierarchy shared by other agents or read it from the catalog
+            error load_hierarchy_snapshot( rsComm_t*, std::shared_ptr<const experimental::resource_hierarchy_cache::snapshot>& );
+
+            // =-=-=-=-=-=-=-
+            /// @brief create a resource for each entry of the snapshot and add it to the maps
+            error create_resources( std::shared_ptr<const experimental::resource_hierarchy_cache::snapshot> );
+
+            // =-=-=-=-=-=-=-
+            /// @brief return the position of the named resource in the snapshot, or -1 if the
+            //         resource did not come from the snapshot
+            int snapshot_index_of( std::string_view ) const;
+            int snapshot_index_of( rodsLong_t ) const;
 
             // =-=-=-=-=-=-=-
             /// @brief Initialize the child map from the resources lookup table
@@ -293,6 +354,7 @@ namespace irods
             lookup_table< resource_ptr >                        resource_name_map_;
             lookup_table< resource_ptr, long, std::hash<long> > resource_id_map_;
             std::vector< std::vector< pdmo_type > > maintenance_operations_;
+            std::shared_ptr<const experimental::resource_hierarchy_cache::snapshot> hierarchy_snapshot_;
 
     }; // class resource_manager
 } // namespace irods
@@ -96,6 +96,10 @@ namespace irods {
     /// \param[in] ctx - Plugin context from which resource name will be extracted
     /// \throws irods::exception - thrown if the error object returned by get() is not ok()
     auto get_resource_name(plugin_context& ctx) -> std::string;
+    /// \brief Convenience function for getting resource id from plugin context
+    /// \param[in] ctx - Plugin context from which resource id will be extracted
+    /// \throws irods::exception - thrown if the error object returned by get() is not ok()
+    auto get_resource_id(plugin_context& ctx) -> rodsLong_t;
     /// \brief Convenience function for getting resource status from plugin context
     /// \param[in] ctx - Plugin context from which resource status will be extracted
     /// \throws irods::exception - thrown if the error object returned by get() is not ok()
@@ -22,6 +22,8 @@ namespace irods {
     const std::string SERVER_CONTROL_RESUME( "server_control_resume" );
     const std::string SERVER_CONTROL_STATUS( "server_control_status" );
     const std::string SERVER_CONTROL_PING( "server_control_ping" );
+    const std::string SERVER_CONTROL_LOAD( "server_control_load" );
+    const std::string SERVER_CONTROL_METRICS( "server_control_metrics" );
 
     const std::string SERVER_CONTROL_ALL_OPT( "all" );
     const std::string SERVER_CONTROL_HOSTS_OPT( "hosts" );
@@ -37,6 +39,14 @@ namespace irods {
     // derived from above - used to wait for the server to shut down or resume
     static const size_t SERVER_CONTROL_FWD_SLEEP_TIME_MILLI_SEC = SERVER_CONTROL_POLLING_TIME_MILLI_SEC / 4.0;
 
+    // @brief sends a command to the control plane of another server and
+    //        appends its response to the output
+    error forward_server_control_command(
+        const std::string&, // command name
+        const std::string&, // host
+        const std::string&, // port keyword
+        std::string& );     // output
+
     class server_control_executor {
         public:
             // @brief constructor
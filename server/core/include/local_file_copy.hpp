@@ -0,0 +1,41 @@
+#ifndef IRODS_LOCAL_FILE_COPY_HPP
+#define IRODS_LOCAL_FILE_COPY_HPP
+
+/// \file
+
+#include <cstdint>
+
+namespace irods::experimental::local_file_copy
+{
+    /// Returns whether two open files are regular files on the same filesystem.
+    ///
+    /// \param[in] _in_fd  A file descriptor open for reading.
+    /// \param[in] _out_fd A file descriptor open for writing.
+    ///
+    /// \since 4.3.0
+    auto same_filesystem(int _in_fd, int _out_fd) noexcept -> bool;
+
+    /// Copies bytes between two open files without moving them through user space.
+    ///
+    /// Copying starts at the current offset of each file descriptor and advances both
+    /// offsets by the number of bytes copied. The following methods are tried in order,
+    /// moving on to the next one whenever the kernel or filesystem does not support it:
+    /// - FICLONE, if the whole source file is copied into an empty destination file
+    /// - copy_file_range(2)
+    /// - sendfile(2)
+    ///
+    /// This function never fails. If fewer than \p _size bytes are copied, the caller is
+    /// expected to copy the remainder (and report any error) using read(2) and write(2).
+    ///
+    /// \param[in] _in_fd  A file descriptor open for reading.
+    /// \param[in] _out_fd A file descriptor open for writing.
+    /// \param[in] _size   The number of bytes to copy.
+    ///
+    /// \return The number of bytes copied.
+    ///
+    /// \since 4.3.0
+    auto copy(int _in_fd, int _out_fd, std::int64_t _size) noexcept -> std::int64_t;
+} // namespace irods::experimental::local_file_copy
+
+#endif // IRODS_LOCAL_FILE_COPY_HPP
+
@@ -0,0 +1,49 @@
+#ifndef IRODS_PAM_AUTH_HELPER_HPP
+#define IRODS_PAM_AUTH_HELPER_HPP
+
+/// \file
+
+#include <string>
+#include <string_view>
+
+#include <sys/types.h>
+
+namespace irods::experimental::pam_auth_helper
+{
+    /// The environment variable through which the server publishes the location of the
+    /// helper's socket to the agents.
+    ///
+    /// \since 4.3.0
+    inline const char* const SOCKET_PATH_ENV_VAR = "IRODS_PAM_AUTH_HELPER_SOCKET";
+
+    /// Starts the persistent PAM authentication helper (irodsPamAuthCheck --daemon).
+    ///
+    /// The helper must be launched from the server's working directory. It exits when the
+    /// launching process exits.
+    ///
+    /// \param[in] _socket_path  The path of the Unix domain socket the helper will listen on.
+    /// \param[in] _worker_count The number of PAM conversations the helper may run concurrently.
+    ///
+    /// \return The process id of the helper, or -1 if it could not be started.
+    ///
+    /// \since 4.3.0
+    auto launch(const std::string_view _socket_path, int _worker_count) -> pid_t;
+
+    /// Checks a username and password through the persistent PAM authentication helper.
+    ///
+    /// Callers are expected to fall back to executing irodsPamAuthCheck when the helper is
+    /// not available, which is indicated by any error other than PAM_AUTH_PASSWORD_FAILED.
+    ///
+    /// \param[in] _username The name of the user to authenticate.
+    /// \param[in] _password The password of \p _username.
+    ///
+    /// \return An integer.
+    /// \retval 0                        If PAM authenticated the user.
+    /// \retval PAM_AUTH_PASSWORD_FAILED If PAM rejected the user.
+    /// \retval <0                       If the helper could not be reached or failed.
+    ///
+    /// \since 4.3.0
+    auto authenticate(const std::string& _username, const std::string& _password) -> int;
+} // namespace irods::experimental::pam_auth_helper
+
+#endif // IRODS_PAM_AUTH_HELPER_HPP
@@ -0,0 +1,122 @@
+#ifndef IRODS_RESOURCE_HIERARCHY_HPP
+#define IRODS_RESOURCE_HIERARCHY_HPP
+
+/// \file
+
+#include "irods_exception.hpp"
+#include "rodsErrorTable.h"
+#include "rodsType.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace irods::experimental
+{
+    /// A resource hierarchy stored as the IDs of its resources, from the root resource to the
+    /// leaf resource.
+    ///
+    /// Hierarchies are built, searched and compared without allocating. The resource manager
+    /// converts them from and to hierarchy strings (e.g. "root;pt;leaf"), which is only
+    /// necessary when talking to clients, the catalog or resource plugins.
+    ///
+    /// \since 4.3.0
+    class resource_hierarchy
+    {
+    public:
+        // clang-format off
+        using value_type     = rodsLong_t;
+        using size_type      = std::size_t;
+        using const_iterator = const value_type*;
+        // clang-format on
+
+        /// The maximum number of resources in a hierarchy.
+        ///
+        /// The catalog does not limit the depth of a resource tree. Callers that build a
+        /// resource_hierarchy for a deeper tree catch the exception and use the hierarchy
+        /// string instead.
+        static constexpr size_type max_depth = 16;
+
+        resource_hierarchy() noexcept = default;
+
+        auto size() const noexcept -> size_type { return size_; }
+
+        auto empty() const noexcept -> bool { return 0 == size_; }
+
+        auto begin() const noexcept -> const_iterator { return ids_.data(); }
+
+        auto end() const noexcept -> const_iterator { return ids_.data() + size_; }
+
+        /// Returns the ID of the resource at \p _level, where level 0 is the root resource.
+        auto operator[](size_type _level) const noexcept -> value_type { return ids_[_level]; }
+
+        /// \throws irods::exception If the hierarchy is empty.
+        auto root() const -> value_type
+        {
+            throw_if_empty();
+            return ids_[0];
+        }
+
+        /// \throws irods::exception If the hierarchy is empty.
+        auto leaf() const -> value_type
+        {
+            throw_if_empty();
+            return ids_[size_ - 1];
+        }
+
+        auto contains(value_type _resource_id) const noexcept -> bool
+        {
+            return std::find(begin(), end(), _resource_id) != end();
+        }
+
+        /// Appends \p _resource_id below the current leaf resource.
+        ///
+        /// \throws irods::exception If the hierarchy already holds max_depth resources.
+        auto add_child(value_type _resource_id) -> void
+        {
+            throw_if_full();
+            ids_[size_++] = _resource_id;
+        }
+
+        /// Inserts \p _resource_id above the current root resource.
+        ///
+        /// \throws irods::exception If the hierarchy already holds max_depth resources.
+        auto add_parent(value_type _resource_id) -> void
+        {
+            throw_if_full();
+            std::copy_backward(begin(), end(), ids_.data() + size_ + 1);
+            ids_[0] = _resource_id;
+            ++size_;
+        }
+
+        friend auto operator==(const resource_hierarchy& _lhs, const resource_hierarchy& _rhs) noexcept -> bool
+        {
+            return std::equal(_lhs.begin(), _lhs.end(), _rhs.begin(), _rhs.end());
+        }
+
+        friend auto operator!=(const resource_hierarchy& _lhs, const resource_hierarchy& _rhs) noexcept -> bool
+        {
+            return !(_lhs == _rhs);
+        }
+
+    private:
+        auto throw_if_empty() const -> void
+        {
+            if (empty()) {
+                THROW(HIERARCHY_ERROR, "empty resource hierarchy");
+            }
+        }
+
+        auto throw_if_full() const -> void
+        {
+            if (size_ == max_depth) {
+                THROW(HIERARCHY_ERROR, "resource hierarchy exceeds the maximum depth");
+            }
+        }
+
+        std::array<value_type, max_depth> ids_{};
+        std::uint8_t size_{};
+    }; // class resource_hierarchy
+} // namespace irods::experimental
+
+#endif // IRODS_RESOURCE_HIERARCHY_HPP
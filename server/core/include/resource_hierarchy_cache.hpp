@@ -0,0 +1,172 @@
+#ifndef IRODS_RESOURCE_HIERARCHY_CACHE_HPP
+#define IRODS_RESOURCE_HIERARCHY_CACHE_HPP
+
+/// \file
+
+#include "rodsType.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace irods::experimental::resource_hierarchy_cache
+{
+    /// The catalog information describing a resource, as stored in R_RESC_MAIN.
+    ///
+    /// \since 4.3.0
+    struct resource_info
+    {
+        rodsLong_t id;
+        std::string name;
+        std::string zone;
+        std::string type;
+        std::string class_name;
+        std::string location;
+        std::string vault_path;
+        std::string free_space;
+        std::string info;
+        std::string comments;
+        std::string create_time;
+        std::string modify_time;
+        std::string status;
+        std::string children;
+        std::string context;
+        std::string parent;          // The ID of the parent resource, or empty for roots.
+        std::string parent_context;
+    }; // struct resource_info
+
+    class snapshot;
+
+    /// Returns a copy of the published snapshot.
+    ///
+    /// Returns nullptr if no snapshot has been published since the last invalidation or if
+    /// the cache has not been initialized by this process or one of its ancestors.
+    ///
+    /// \since 4.3.0
+    auto load() -> std::shared_ptr<const snapshot>;
+
+    /// An immutable view of every resource in the zone and how they are arranged.
+    ///
+    /// Resources are identified by their position in resources(). The parent and the full
+    /// hierarchy of every resource are computed once, when the snapshot is built from the
+    /// catalog, and are shared with other agents through the cache.
+    ///
+    /// \since 4.3.0
+    class snapshot
+    {
+    public:
+        /// \param[in] _catalog_version The version of the resource hierarchy in the catalog
+        ///                             at the time \p _resources were read.
+        /// \param[in] _resources       All resources in the zone.
+        snapshot(std::int64_t _catalog_version, std::vector<resource_info> _resources);
+
+        snapshot(const snapshot&) = delete;
+        auto operator=(const snapshot&) -> snapshot& = delete;
+
+        auto catalog_version() const noexcept -> std::int64_t { return catalog_version_; }
+
+        auto resources() const noexcept -> const std::vector<resource_info>& { return resources_; }
+
+        /// Returns the position of the resource named \p _name, or -1 if it does not exist.
+        auto index_of(std::string_view _name) const -> int;
+
+        /// Returns the position of the resource with ID \p _id, or -1 if it does not exist.
+        auto index_of(rodsLong_t _id) const -> int;
+
+        /// Returns the position of the parent of the resource at \p _index, or -1 if it is a
+        /// root resource.
+        auto parent_of(int _index) const -> int { return parents_[_index]; }
+
+        /// Returns the positions of the resource at \p _index and its ancestors, ending with
+        /// its root resource.
+        auto path_to_root(int _index) const -> const std::vector<int>& { return paths_[_index]; }
+
+        /// Returns the hierarchy from the root resource to the resource at \p _index
+        /// (e.g. "root;pt;leaf").
+        auto hierarchy(int _index) const -> const std::string& { return hierarchies_[_index]; }
+
+    private:
+        snapshot(std::int64_t _catalog_version,
+                 std::vector<resource_info> _resources,
+                 std::vector<int> _parents,
+                 std::vector<std::string> _hierarchies);
+
+        auto index_resources() -> void;
+
+        friend auto load() -> std::shared_ptr<const snapshot>;
+        friend auto publish(const snapshot&, std::uint64_t) -> bool;
+
+        std::int64_t catalog_version_;
+        std::vector<resource_info> resources_;
+        std::vector<int> parents_;
+        std::vector<std::vector<int>> paths_;
+        std::vector<std::string> hierarchies_;
+        std::unordered_map<std::string_view, int> by_name_;
+        std::unordered_map<rodsLong_t, int> by_id_;
+    }; // class snapshot
+
+    /// Initializes the resource hierarchy cache.
+    ///
+    /// This function should only be called on startup of the server. Agents forked from the
+    /// calling process inherit the cache.
+    ///
+    /// \param[in] _shm_name The name of the shared memory to create.
+    /// \param[in] _shm_size The size of the shared memory to allocate in bytes. Snapshots
+    ///                      that do not fit are not shared.
+    ///
+    /// \since 4.3.0
+    auto init(const std::string_view _shm_name = "irods_resource_hierarchy_cache",
+              std::size_t _shm_size = 5'000'000) -> void;
+
+    /// Cleans up any resources created via init().
+    ///
+    /// This function must be called from the same process that called init().
+    ///
+    /// \since 4.3.0
+    auto deinit() noexcept -> void;
+
+    /// Returns the number of invalidations so far.
+    ///
+    /// Read this before querying the catalog and pass it to publish(), so that a snapshot
+    /// read while the resources were being changed is never published.
+    ///
+    /// \since 4.3.0
+    auto invalidation_count() noexcept -> std::uint64_t;
+
+    /// Shares \p _snapshot with all agents.
+    ///
+    /// \param[in] _snapshot           The snapshot to publish.
+    /// \param[in] _invalidation_count The value returned by invalidation_count() before the
+    ///                                catalog was queried.
+    ///
+    /// \return A boolean value.
+    /// \retval true  If the snapshot was published.
+    /// \retval false If the cache was invalidated in the meantime, the snapshot does not fit
+    ///               or the cache has not been initialized.
+    ///
+    /// \since 4.3.0
+    auto publish(const snapshot& _snapshot, std::uint64_t _invalidation_count) -> bool;
+
+    /// Discards the published snapshot. Called after resources are added, modified or
+    /// removed.
+    ///
+    /// \since 4.3.0
+    auto invalidate() noexcept -> void;
+
+    /// Returns the number of seconds since the published snapshot was built or last
+    /// confirmed to match the catalog.
+    ///
+    /// \since 4.3.0
+    auto seconds_since_verification() noexcept -> std::int64_t;
+
+    /// Records that the published snapshot still matches the catalog, if it was built from
+    /// version \p _catalog_version.
+    ///
+    /// \since 4.3.0
+    auto mark_verified(std::int64_t _catalog_version) -> void;
+} // namespace irods::experimental::resource_hierarchy_cache
+
+#endif // IRODS_RESOURCE_HIERARCHY_CACHE_HPP
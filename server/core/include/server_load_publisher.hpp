@@ -0,0 +1,38 @@
+#ifndef IRODS_SERVER_LOAD_PUBLISHER_HPP
+#define IRODS_SERVER_LOAD_PUBLISHER_HPP
+
+#include "json.hpp"
+
+#include <boost/thread/thread.hpp>
+
+namespace irods {
+
+    // @brief returns the most recent load samples for the storage resources
+    //        served by this server, keyed by resource name.  this is the
+    //        payload of the server_control_load control plane command.
+    nlohmann::json get_local_load_samples();
+
+    // @brief periodically samples the load of the local storage resources and
+    //        requests the samples of every peer server through its control
+    //        plane, recording both in the server load table so that agents
+    //        may choose among resources without consulting the catalog
+    class server_load_publisher {
+        public:
+            server_load_publisher();
+            ~server_load_publisher();
+
+            server_load_publisher( const server_load_publisher& ) = delete;
+            server_load_publisher& operator=( const server_load_publisher& ) = delete;
+
+        private:
+            // @brief the publishing loop, runs until the server stops
+            void run();
+
+            // @brief thread which manages the publishing loop
+            boost::thread publisher_thread_;
+
+    }; // class server_load_publisher
+
+}; // namespace irods
+
+#endif // IRODS_SERVER_LOAD_PUBLISHER_HPP
@@ -0,0 +1,82 @@
+#ifndef IRODS_SERVER_LOAD_TABLE_HPP
+#define IRODS_SERVER_LOAD_TABLE_HPP
+
+/// \file
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <optional>
+
+namespace irods::experimental::server_load_table
+{
+    /// A snapshot of the load observed on the host serving a storage resource.
+    ///
+    /// \since 4.3.0
+    struct load_sample
+    {
+        std::int64_t active_agents;       // Number of agents connected to the host's server.
+        std::int64_t io_bytes_per_second; // Bytes read and written on the vault's device per second.
+        std::int64_t disk_queue_depth;    // I/O requests in progress on the vault's device.
+        std::int64_t free_space;          // Bytes available to the service account in the vault.
+        std::int64_t timestamp;           // The seconds since epoch at which the sample was received.
+    }; // struct load_sample
+
+    /// Initializes the server load table.
+    ///
+    /// This function should only be called on startup of the server.
+    ///
+    /// \param[in] _shm_name The name of the shared memory to create.
+    /// \param[in] _shm_size The size of the shared memory to allocate in bytes.
+    ///
+    /// \since 4.3.0
+    auto init(const std::string_view _shm_name = "irods_server_load_table",
+              std::size_t _shm_size = 1'000'000) -> void;
+
+    /// Cleans up any resources created via init().
+    ///
+    /// This function must be called from the same process that called init().
+    ///
+    /// \since 4.3.0
+    auto deinit() noexcept -> void;
+
+    /// Inserts a new sample or replaces the existing sample for a resource.
+    ///
+    /// The timestamp of \p _sample is replaced with the current time.
+    ///
+    /// \param[in] _resource_name The name of the storage resource the sample describes.
+    /// \param[in] _sample        The load observed for \p _resource_name.
+    ///
+    /// \return A boolean value.
+    /// \retval true  If a new entry was inserted.
+    /// \retval false If an existing entry was updated.
+    ///
+    /// \since 4.3.0
+    auto insert_or_assign(const std::string_view _resource_name, load_sample _sample) -> bool;
+
+    /// Returns the most recent sample for a resource if it is not older than \p _max_age.
+    ///
+    /// Returns std::nullopt if the table has not been initialized by this process or one
+    /// of its ancestors.
+    ///
+    /// \param[in] _resource_name The name of the storage resource.
+    /// \param[in] _max_age       The maximum age of an acceptable sample.
+    ///
+    /// \since 4.3.0
+    auto lookup(const std::string_view _resource_name, std::chrono::seconds _max_age)
+        -> std::optional<load_sample>;
+
+    /// Removes all samples older than \p _max_age.
+    ///
+    /// \since 4.3.0
+    auto erase_expired_entries(std::chrono::seconds _max_age) -> void;
+
+    /// Returns the number of samples in the table.
+    ///
+    /// \since 4.3.0
+    auto size() -> std::size_t;
+} // namespace irods::experimental::server_load_table
+
+#endif // IRODS_SERVER_LOAD_TABLE_HPP
+
@@ -0,0 +1,382 @@
+#include "access_verdict_cache.hpp"
+
+#include "irods_server_properties.hpp"
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace
+{
+    namespace bi = boost::interprocess;
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+    // Large enough for a ticket subject made of four names plus an access level.
+    constexpr std::size_t max_key_size = 448;
+
+    // The number of consecutive slots searched for a key.
+    constexpr std::size_t probe_length = 8;
+
+    // The shared memory holds the header followed by the slots of an open-addressed table.
+    // New shared memory is zero-filled, and a slot that expired at the epoch is empty.
+    struct header
+    {
+        std::atomic<std::uint64_t> generation;
+        bi::interprocess_mutex mutex;
+        std::size_t slot_count;
+    }; // struct header
+
+    struct slot
+    {
+        std::uint64_t hash;
+        std::uint64_t generation;
+        std::int64_t expires_at;
+        std::uint32_t key_size;
+        char key[max_key_size];
+    }; // struct slot
+
+    struct local_entry
+    {
+        std::uint64_t generation;
+        std::int64_t expires_at;
+    }; // struct local_entry
+
+    //
+    // Global Variables
+    //
+
+    std::string g_shm_name;
+
+    // On initialization, holds the PID of the process that initialized the cache.
+    // This ensures that only the process that initialized the system can deinitialize it.
+    pid_t g_owner_pid;
+
+    std::unique_ptr<bi::shared_memory_object> g_shm;
+    std::unique_ptr<bi::mapped_region> g_region;
+    header* g_header;
+
+    // Used instead of the shared generation when the cache was not initialized.
+    std::atomic<std::uint64_t> g_local_generation;
+
+    // Verdicts of this agent, used when they are not shared.
+    std::mutex g_local_mutex;
+    std::unordered_map<std::string, local_entry> g_local_entries;
+
+    bool g_configured;
+    std::int64_t g_time_to_live;
+    std::size_t g_max_entries;
+
+    auto now_in_seconds() noexcept -> std::int64_t
+    {
+        using namespace std::chrono;
+        return duration_cast<seconds>(system_clock::now().time_since_epoch()).count();
+    }
+
+    auto slots() noexcept -> slot*
+    {
+        return reinterpret_cast<slot*>(g_header + 1);
+    }
+
+    auto shared_entries() noexcept -> bool
+    {
+        return g_header && g_header->slot_count > 0;
+    }
+
+    auto ensure_configured() -> void
+    {
+        if (!g_configured) {
+            g_time_to_live = irods::get_access_verdict_cache_time_to_live();
+            g_max_entries = irods::get_access_verdict_cache_maximum_entries();
+            g_configured = true;
+        }
+    }
+
+    // Subjects and access levels never contain NUL characters, so this is unambiguous.
+    auto serialize(const irods::experimental::access_verdict_cache::key& _key) -> std::string
+    {
+        std::string out;
+        out.reserve(_key.subject.size() + _key.access_level.size() + 2 + sizeof(_key.object_id));
+        out.append(_key.subject).push_back('\0');
+        out.append(_key.access_level).push_back('\0');
+        out.append(reinterpret_cast<const char*>(&_key.object_id), sizeof(_key.object_id));
+        return out;
+    }
+
+    auto is_live(const slot& _slot, std::uint64_t _generation, std::int64_t _now) noexcept -> bool
+    {
+        return _slot.generation == _generation && _slot.expires_at > _now;
+    }
+
+    auto matches(const slot& _slot, std::uint64_t _hash, const std::string& _key) noexcept -> bool
+    {
+        return _slot.hash == _hash &&
+               _slot.key_size == _key.size() &&
+               std::memcmp(_slot.key, _key.data(), _key.size()) == 0;
+    }
+
+    auto shared_contains(const std::string& _key) -> bool
+    {
+        const auto hash = std::hash<std::string>{}(_key);
+        const auto now = now_in_seconds();
+
+        bi::scoped_lock lk{g_header->mutex};
+
+        const auto generation = g_header->generation.load(std::memory_order_acquire);
+
+        for (std::size_t i = 0; i < probe_length; ++i) {
+            const auto& s = slots()[(hash + i) % g_header->slot_count];
+
+            if (matches(s, hash, _key)) {
+                return is_live(s, generation, now);
+            }
+        }
+
+        return false;
+    }
+
+    auto shared_insert(const std::string& _key, std::uint64_t _generation, std::int64_t _expires_at) -> void
+    {
+        if (_key.size() > max_key_size) {
+            return;
+        }
+
+        const auto hash = std::hash<std::string>{}(_key);
+        const auto now = now_in_seconds();
+
+        bi::scoped_lock lk{g_header->mutex};
+
+        // The verdict may have been computed from permissions that changed since.
+        if (g_header->generation.load(std::memory_order_acquire) != _generation) {
+            return;
+        }
+
+        // Reuse the slot of the key or the first dead slot. Otherwise, evict the verdict
+        // closest to expiring.
+        slot* target = nullptr;
+
+        for (std::size_t i = 0; i < probe_length; ++i) {
+            auto& s = slots()[(hash + i) % g_header->slot_count];
+
+            if (matches(s, hash, _key) || !is_live(s, _generation, now)) {
+                target = &s;
+                break;
+            }
+
+            if (!target || s.expires_at < target->expires_at) {
+                target = &s;
+            }
+        }
+
+        target->hash = hash;
+        target->generation = _generation;
+        target->expires_at = _expires_at;
+        target->key_size = static_cast<std::uint32_t>(_key.size());
+        std::memcpy(target->key, _key.data(), _key.size());
+    }
+
+    auto local_contains(const std::string& _key, std::uint64_t _generation) -> bool
+    {
+        std::lock_guard<std::mutex> lk{g_local_mutex};
+
+        const auto iter = g_local_entries.find(_key);
+
+        return iter != std::end(g_local_entries) &&
+               iter->second.generation == _generation &&
+               iter->second.expires_at > now_in_seconds();
+    }
+
+    auto local_insert(std::string&& _key, std::uint64_t _generation, std::int64_t _expires_at) -> void
+    {
+        std::lock_guard<std::mutex> lk{g_local_mutex};
+
+        if (g_local_entries.size() >= g_max_entries && g_local_entries.count(_key) == 0) {
+            const auto now = now_in_seconds();
+
+            for (auto iter = std::begin(g_local_entries); iter != std::end(g_local_entries);) {
+                if (iter->second.generation != _generation || iter->second.expires_at <= now) {
+                    iter = g_local_entries.erase(iter);
+                }
+                else {
+                    ++iter;
+                }
+            }
+
+            // Every verdict is still live. Start over rather than tracking their age.
+            if (g_local_entries.size() >= g_max_entries) {
+                g_local_entries.clear();
+            }
+        }
+
+        g_local_entries.insert_or_assign(std::move(_key), local_entry{_generation, _expires_at});
+    }
+} // anonymous namespace
+
+namespace irods::experimental::access_verdict_cache
+{
+    auto user_subject(std::string_view _user_name, std::string_view _zone_name) -> std::string
+    {
+        std::string subject{"u:"};
+        subject.append(_user_name).append("#").append(_zone_name);
+        return subject;
+    } // user_subject
+
+    auto ticket_subject(std::string_view _ticket,
+                        std::string_view _host,
+                        std::string_view _user_name,
+                        std::string_view _zone_name) -> std::string
+    {
+        // Ticket restrictions depend on the host and the user presenting the ticket.
+        std::string subject{"t:"};
+        subject.append(_ticket).append("\n").append(_host).append("\n");
+        subject.append(_user_name).append("#").append(_zone_name);
+        return subject;
+    } // ticket_subject
+
+    auto init(const std::string_view _shm_name, std::size_t _shm_size) -> void
+    {
+        if (getpid() == g_owner_pid) {
+            return;
+        }
+
+        g_shm_name = _shm_name.data();
+
+        bi::shared_memory_object::remove(g_shm_name.data());
+
+        g_owner_pid = getpid();
+        g_shm = std::make_unique<bi::shared_memory_object>(bi::create_only, g_shm_name.data(), bi::read_write);
+        g_shm->truncate(std::max(_shm_size, sizeof(header)));
+        g_region = std::make_unique<bi::mapped_region>(*g_shm, bi::read_write);
+
+        auto* address = g_region->get_address();
+        g_header = new (address) header{};
+        g_header->slot_count = (g_region->get_size() - sizeof(header)) / sizeof(slot);
+
+        // Slots are only useful if a key can be found within a probe.
+        if (g_header->slot_count < probe_length) {
+            g_header->slot_count = 0;
+        }
+    } // init
+
+    auto deinit() noexcept -> void
+    {
+        if (getpid() != g_owner_pid) {
+            return;
+        }
+
+        try {
+            g_owner_pid = 0;
+
+            if (g_header) {
+                g_header->~header();
+                g_header = nullptr;
+            }
+
+            g_region.reset();
+            g_shm.reset();
+
+            bi::shared_memory_object::remove(g_shm_name.data());
+        }
+        catch (...) {}
+    } // deinit
+
+    auto configure(std::chrono::seconds _time_to_live, std::size_t _max_entries) -> void
+    {
+        g_time_to_live = std::max<std::int64_t>(0, _time_to_live.count());
+        g_max_entries = std::max<std::size_t>(1, _max_entries);
+        g_configured = true;
+
+        std::lock_guard<std::mutex> lk{g_local_mutex};
+        g_local_entries.clear();
+    } // configure
+
+    auto enabled() -> bool
+    {
+        ensure_configured();
+        return g_time_to_live > 0;
+    } // enabled
+
+    auto generation() noexcept -> std::uint64_t
+    {
+        return g_header
+            ? g_header->generation.load(std::memory_order_acquire)
+            : g_local_generation.load(std::memory_order_acquire);
+    } // generation
+
+    auto contains(const key& _key) -> bool
+    {
+        if (!enabled()) {
+            return false;
+        }
+
+        const auto k = serialize(_key);
+
+        return shared_entries() ? shared_contains(k) : local_contains(k, generation());
+    } // contains
+
+    auto insert(const key& _key, std::uint64_t _generation, std::int64_t _expires_at) -> void
+    {
+        if (!enabled()) {
+            return;
+        }
+
+        auto expires_at = now_in_seconds() + g_time_to_live;
+
+        if (_expires_at > 0) {
+            expires_at = std::min(expires_at, _expires_at);
+        }
+
+        if (shared_entries()) {
+            shared_insert(serialize(_key), _generation, expires_at);
+        }
+        else if (_generation == generation()) {
+            local_insert(serialize(_key), _generation, expires_at);
+        }
+    } // insert
+
+    auto invalidate() noexcept -> void
+    {
+        if (g_header) {
+            g_header->generation.fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        g_local_generation.fetch_add(1, std::memory_order_acq_rel);
+
+        try {
+            std::lock_guard<std::mutex> lk{g_local_mutex};
+            g_local_entries.clear();
+        }
+        catch (...) {}
+    } // invalidate
+
+    auto size() -> std::size_t
+    {
+        if (!shared_entries()) {
+            std::lock_guard<std::mutex> lk{g_local_mutex};
+            return g_local_entries.size();
+        }
+
+        const auto now = now_in_seconds();
+
+        bi::scoped_lock lk{g_header->mutex};
+
+        const auto generation = g_header->generation.load(std::memory_order_acquire);
+
+        return std::count_if(slots(), slots() + g_header->slot_count, [generation, now](const slot& _s) {
+            return is_live(_s, generation, now);
+        });
+    } // size
+} // namespace irods::experimental::access_verdict_cache
@@ -0,0 +1,352 @@
+#include "agent_registry.hpp"
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include <pthread.h>
+#include <unistd.h>
+
+namespace
+{
+    namespace bi = boost::interprocess;
+    namespace ar = irods::experimental::agent_registry;
+
+    using counter_type = std::atomic<std::int64_t>;
+
+    static_assert(counter_type::is_always_lock_free);
+    static_assert(std::atomic<pid_t>::is_always_lock_free);
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+    // One agent's entry. The identity is written only while the generation is odd, so
+    // readers copy it and retry if the generation changed. The counters are only
+    // updated by the agent owning the entry, with relaxed atomic operations.
+    struct slot
+    {
+        std::atomic<pid_t> pid;
+        std::atomic<std::uint32_t> generation;
+        char client_name[NAME_LEN];
+        char client_zone[NAME_LEN];
+        char proxy_name[NAME_LEN];
+        char proxy_zone[NAME_LEN];
+        char program_name[NAME_LEN];
+        char remote_address[NAME_LEN];
+        counter_type start_time;
+        counter_type api_number;
+        counter_type api_start_time;
+        counter_type api_calls;
+        counter_type bytes_read;
+        counter_type bytes_written;
+        counter_type catalog_operations;
+        counter_type rule_engine_time_microseconds;
+    }; // struct slot
+
+    struct registry
+    {
+        std::size_t capacity;
+        slot slots[1];
+    }; // struct registry
+
+    //
+    // Global Variables
+    //
+
+    std::string g_shm_name;
+
+    // On initialization, holds the PID of the process that initialized the registry.
+    // This ensures that only the process that initialized the system can deinitialize it.
+    pid_t g_owner_pid;
+
+    std::unique_ptr<bi::shared_memory_object> g_shm;
+    std::unique_ptr<bi::mapped_region> g_region;
+    registry* g_registry;
+
+    // The entry of the calling process, if it is a registered agent. It is cleared in
+    // forked children so that they do not update the entry of their parent.
+    slot* g_slot;
+
+    thread_local int g_rule_engine_depth = 0;
+
+    auto now_in_milliseconds() noexcept -> std::int64_t
+    {
+        using namespace std::chrono;
+        return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+    }
+
+    auto own_slot() noexcept -> slot*
+    {
+        return g_slot;
+    }
+
+    auto copy_string(char (&_dst)[NAME_LEN], const char* _src) noexcept -> void
+    {
+        std::strncpy(_dst, _src, NAME_LEN - 1);
+        _dst[NAME_LEN - 1] = '\0';
+    }
+
+    // Returns false if the entry was free or changed while being read.
+    auto read_slot(const slot& _slot, ar::agent_info& _info) noexcept -> bool
+    {
+        const auto generation = _slot.generation.load(std::memory_order_acquire);
+
+        if (generation % 2 != 0) {
+            return false;
+        }
+
+        _info.pid = _slot.pid.load(std::memory_order_relaxed);
+
+        if (0 == _info.pid) {
+            return false;
+        }
+
+        std::memcpy(_info.client_name, _slot.client_name, NAME_LEN);
+        std::memcpy(_info.client_zone, _slot.client_zone, NAME_LEN);
+        std::memcpy(_info.proxy_name, _slot.proxy_name, NAME_LEN);
+        std::memcpy(_info.proxy_zone, _slot.proxy_zone, NAME_LEN);
+        std::memcpy(_info.program_name, _slot.program_name, NAME_LEN);
+        std::memcpy(_info.remote_address, _slot.remote_address, NAME_LEN);
+
+        _info.start_time = _slot.start_time.load(std::memory_order_relaxed);
+        _info.api_number = _slot.api_number.load(std::memory_order_relaxed);
+        _info.api_start_time = _slot.api_start_time.load(std::memory_order_relaxed);
+        _info.api_calls = _slot.api_calls.load(std::memory_order_relaxed);
+        _info.bytes_read = _slot.bytes_read.load(std::memory_order_relaxed);
+        _info.bytes_written = _slot.bytes_written.load(std::memory_order_relaxed);
+        _info.catalog_operations = _slot.catalog_operations.load(std::memory_order_relaxed);
+        _info.rule_engine_time_microseconds = _slot.rule_engine_time_microseconds.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        return _slot.generation.load(std::memory_order_relaxed) == generation;
+    } // read_slot
+
+    // Reads an entry, retrying while it is being rewritten. Returns false if the entry
+    // is free or no longer belongs to \p _pid (when non-zero).
+    auto read_slot_consistently(const slot& _slot, pid_t _pid, ar::agent_info& _info) noexcept -> bool
+    {
+        while (!read_slot(_slot, _info)) {
+            const auto owner = _slot.pid.load(std::memory_order_relaxed);
+
+            if (0 == owner || (_pid != 0 && owner != _pid)) {
+                return false;
+            }
+        }
+
+        return 0 == _pid || _info.pid == _pid;
+    } // read_slot_consistently
+} // anonymous namespace
+
+namespace irods::experimental::agent_registry
+{
+    auto init(const std::string_view _shm_name, std::size_t _max_agents) -> void
+    {
+        if (getpid() == g_owner_pid) {
+            return;
+        }
+
+        g_shm_name = _shm_name.data();
+
+        bi::shared_memory_object::remove(g_shm_name.data());
+
+        g_owner_pid = getpid();
+        g_shm = std::make_unique<bi::shared_memory_object>(bi::create_only, g_shm_name.data(), bi::read_write);
+        g_shm->truncate(sizeof(registry) + (std::max<std::size_t>(_max_agents, 1) - 1) * sizeof(slot));
+        g_region = std::make_unique<bi::mapped_region>(*g_shm, bi::read_write);
+
+        // New shared memory is zero-filled, which is what a free entry looks like.
+        g_registry = static_cast<registry*>(g_region->get_address());
+        g_registry->capacity = std::max<std::size_t>(_max_agents, 1);
+    } // init
+
+    auto deinit() noexcept -> void
+    {
+        if (getpid() != g_owner_pid) {
+            return;
+        }
+
+        try {
+            g_owner_pid = 0;
+            g_registry = nullptr;
+            g_slot = nullptr;
+            g_region.reset();
+            g_shm.reset();
+
+            bi::shared_memory_object::remove(g_shm_name.data());
+        }
+        catch (...) {}
+    } // deinit
+
+    auto register_agent(const agent_info& _info) -> bool
+    {
+        if (!g_registry) {
+            return false;
+        }
+
+        const pid_t pid = getpid();
+        slot* entry = nullptr;
+
+        // Reuse the entry of an earlier process with the same pid that was never removed.
+        for (std::size_t i = 0; i < g_registry->capacity && !entry; ++i) {
+            if (g_registry->slots[i].pid.load(std::memory_order_relaxed) == pid) {
+                entry = &g_registry->slots[i];
+            }
+        }
+
+        for (std::size_t i = 0; i < g_registry->capacity && !entry; ++i) {
+            pid_t expected = 0;
+            if (g_registry->slots[i].pid.compare_exchange_strong(expected, pid)) {
+                entry = &g_registry->slots[i];
+            }
+        }
+
+        if (!entry) {
+            return false;
+        }
+
+        auto& s = *entry;
+
+        s.generation.fetch_add(1, std::memory_order_acq_rel);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        copy_string(s.client_name, _info.client_name);
+        copy_string(s.client_zone, _info.client_zone);
+        copy_string(s.proxy_name, _info.proxy_name);
+        copy_string(s.proxy_zone, _info.proxy_zone);
+        copy_string(s.program_name, _info.program_name);
+        copy_string(s.remote_address, _info.remote_address);
+
+        s.start_time.store(now_in_milliseconds() / 1000, std::memory_order_relaxed);
+        s.api_number.store(0, std::memory_order_relaxed);
+        s.api_start_time.store(0, std::memory_order_relaxed);
+        s.api_calls.store(0, std::memory_order_relaxed);
+        s.bytes_read.store(0, std::memory_order_relaxed);
+        s.bytes_written.store(0, std::memory_order_relaxed);
+        s.catalog_operations.store(0, std::memory_order_relaxed);
+        s.rule_engine_time_microseconds.store(0, std::memory_order_relaxed);
+
+        s.generation.fetch_add(1, std::memory_order_release);
+
+        static const auto forget_slot_on_fork = pthread_atfork(nullptr, nullptr, [] { g_slot = nullptr; });
+        static_cast<void>(forget_slot_on_fork);
+
+        g_slot = &s;
+
+        return true;
+    } // register_agent
+
+    auto unregister_agent(pid_t _pid) noexcept -> void
+    {
+        if (!g_registry || _pid <= 0) {
+            return;
+        }
+
+        for (std::size_t i = 0; i < g_registry->capacity; ++i) {
+            auto& s = g_registry->slots[i];
+
+            if (s.pid.load(std::memory_order_relaxed) == _pid) {
+                if (&s == g_slot) {
+                    g_slot = nullptr;
+                }
+
+                // Keep the generation even, but make readers notice the change.
+                s.generation.fetch_add(2, std::memory_order_acq_rel);
+                s.pid.store(0, std::memory_order_release);
+            }
+        }
+    } // unregister_agent
+
+    auto begin_api(int _api_number) noexcept -> void
+    {
+        if (auto* s = own_slot(); s) {
+            s->api_start_time.store(now_in_milliseconds(), std::memory_order_relaxed);
+            s->api_number.store(_api_number, std::memory_order_relaxed);
+            s->api_calls.fetch_add(1, std::memory_order_relaxed);
+        }
+    } // begin_api
+
+    auto end_api() noexcept -> void
+    {
+        if (auto* s = own_slot(); s) {
+            s->api_number.store(0, std::memory_order_relaxed);
+        }
+    } // end_api
+
+    auto add_bytes_read(std::int64_t _bytes) noexcept -> void
+    {
+        if (auto* s = own_slot(); s && _bytes > 0) {
+            s->bytes_read.fetch_add(_bytes, std::memory_order_relaxed);
+        }
+    } // add_bytes_read
+
+    auto add_bytes_written(std::int64_t _bytes) noexcept -> void
+    {
+        if (auto* s = own_slot(); s && _bytes > 0) {
+            s->bytes_written.fetch_add(_bytes, std::memory_order_relaxed);
+        }
+    } // add_bytes_written
+
+    auto increment_catalog_operations() noexcept -> void
+    {
+        if (auto* s = own_slot(); s) {
+            s->catalog_operations.fetch_add(1, std::memory_order_relaxed);
+        }
+    } // increment_catalog_operations
+
+    scoped_rule_engine_timer::scoped_rule_engine_timer() noexcept
+        : outermost_{0 == g_rule_engine_depth++ && nullptr != own_slot()}
+        , start_{outermost_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{}}
+    {
+    }
+
+    scoped_rule_engine_timer::~scoped_rule_engine_timer()
+    {
+        --g_rule_engine_depth;
+
+        if (auto* s = own_slot(); outermost_ && s) {
+            using namespace std::chrono;
+            const auto elapsed = duration_cast<microseconds>(steady_clock::now() - start_).count();
+            s->rule_engine_time_microseconds.fetch_add(elapsed, std::memory_order_relaxed);
+        }
+    }
+
+    auto lookup(pid_t _pid) -> std::optional<agent_info>
+    {
+        if (!g_registry || _pid <= 0) {
+            return std::nullopt;
+        }
+
+        for (std::size_t i = 0; i < g_registry->capacity; ++i) {
+            const auto& s = g_registry->slots[i];
+
+            if (agent_info info{}; s.pid.load(std::memory_order_relaxed) == _pid && read_slot_consistently(s, _pid, info)) {
+                return info;
+            }
+        }
+
+        return std::nullopt;
+    } // lookup
+
+    auto list() -> std::vector<agent_info>
+    {
+        std::vector<agent_info> agents;
+
+        if (!g_registry) {
+            return agents;
+        }
+
+        for (std::size_t i = 0; i < g_registry->capacity; ++i) {
+            const auto& s = g_registry->slots[i];
+
+            if (agent_info info{}; s.pid.load(std::memory_order_relaxed) != 0 && read_slot_consistently(s, 0, info)) {
+                agents.push_back(info);
+            }
+        }
+
+        return agents;
+    } // list
+} // namespace irods::experimental::agent_registry
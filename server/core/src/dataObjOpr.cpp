@@ -30,6 +30,7 @@
 #include "irods_file_object.hpp"
 
 #include <algorithm>
+#include <cstring>
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/convenience.hpp>
@@ -38,6 +39,34 @@
 
 using namespace boost::filesystem;
 
+namespace
+{
+    // Returns 0 if the resource does not exist so that callers fall back to the hierarchy string.
+    rodsLong_t resc_id_or_zero(const char* _resc_name)
+    {
+        try {
+            return resc_mgr.resc_name_to_id(_resc_name);
+        }
+        catch (const irods::exception&) {
+            return 0;
+        }
+    } // resc_id_or_zero
+
+    // Checks the resource IDs of the replica's hierarchy when possible instead of splitting the
+    // hierarchy string for every replica.
+    bool resc_in_replica_hier(const dataObjInfo_t& _info, rodsLong_t _resc_id, const std::string& _resc_name)
+    {
+        if (_resc_id > 0 && _info.rescId > 0) {
+            try {
+                return resc_mgr.leaf_id_to_resource_hierarchy(_info.rescId).contains(_resc_id);
+            }
+            catch (const irods::exception&) {}
+        }
+
+        return irods::hierarchy_parser{_info.rescHier}.resc_in_hier(_resc_name);
+    } // resc_in_replica_hier
+} // anonymous namespace
+
 // =-=-=-=-=-=-=-
 /// @brief function which determines if a logical path is created at the root level
 irods::error validate_logical_path(
@@ -361,13 +390,8 @@ getDataObjInfo(
             irods::log(PASS(ret));
             return ret.code();
         }
-        std::string hier( tmpHierString );
-
-        irods::hierarchy_parser parser;
-        parser.set_string( tmpHierString );
-        std::string leaf;
-        parser.last_resc( leaf );
-        rstrcpy( dataObjInfo->rescName, leaf.c_str(), NAME_LEN );
+        const char* leaf = std::strrchr(tmpHierString, irods::hierarchy_parser::delimiter().front());
+        rstrcpy( dataObjInfo->rescName, leaf ? leaf + 1 : tmpHierString, NAME_LEN );
 
         rstrcpy( dataObjInfo->dataType, tmpDataType, NAME_LEN );
         dataObjInfo->dataSize = strtoll( tmpDataSize, 0, 0 );
@@ -628,16 +652,18 @@ requeDataObjInfoByResc( dataObjInfo_t **dataObjInfoHead,
         return 0;
     }
 
+    const std::string resc_name = preferredResc;
+    const rodsLong_t resc_id = resc_id_or_zero(preferredResc);
+
     dataObjInfo_t* tmpDataObjInfo = *dataObjInfoHead;
     if (!tmpDataObjInfo->next) {
         /* just one */
-        const bool resc_in_hier = irods::hierarchy_parser{tmpDataObjInfo->rescHier}.resc_in_hier(preferredResc);
-        return resc_in_hier ? 0 : -1;
+        return resc_in_replica_hier(*tmpDataObjInfo, resc_id, resc_name) ? 0 : -1;
     }
 
     dataObjInfo_t* prevDataObjInfo = NULL;
     while (tmpDataObjInfo) {
-        if (irods::hierarchy_parser{tmpDataObjInfo->rescHier}.resc_in_hier(preferredResc) &&
+        if (resc_in_replica_hier(*tmpDataObjInfo, resc_id, resc_name) &&
             (writeFlag > 0 || tmpDataObjInfo->replStatus > 0)) {
             if (prevDataObjInfo) {
                 prevDataObjInfo->next = tmpDataObjInfo->next;
@@ -672,15 +698,15 @@ matchAndTrimRescGrp( dataObjInfo_t **dataObjInfoHead,
         *trimmedDataObjInfo = NULL;
     }
 
+    const rodsLong_t resc_id = resc_id_or_zero(_resc_name.c_str());
+
     tmpDataObjInfo = *dataObjInfoHead;
     prevDataObjInfo = NULL;
 
     while ( tmpDataObjInfo != NULL ) {
         nextDataObjInfo = tmpDataObjInfo->next;
 
-        irods::hierarchy_parser h_parse;
-        h_parse.set_string(tmpDataObjInfo->rescHier);
-        if(h_parse.resc_in_hier(_resc_name)) {
+        if (resc_in_replica_hier(*tmpDataObjInfo, resc_id, _resc_name)) {
 
             if ( trimjFlag & TRIM_MATCHED_OBJ_INFO ) {
                 if ( tmpDataObjInfo == *dataObjInfoHead ) {
@@ -0,0 +1,321 @@
+#include "directory_scanner.hpp"
+
+#include "irods_at_scope_exit.hpp"
+#include "rodsErrorTable.h"
+#include "rodsLog.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace
+{
+    // Large enough to read directories with thousands of entries in one system call.
+    constexpr std::size_t dirent_buffer_size = 256 * 1024;
+
+    // The record layout of getdents64(2). glibc does not declare it before 2.30.
+    struct linux_dirent64
+    {
+        std::uint64_t d_ino;
+        std::int64_t d_off;
+        unsigned short d_reclen;
+        unsigned char d_type;
+        char d_name[1];
+    }; // struct linux_dirent64
+
+    struct file_status
+    {
+        mode_t mode;
+        rodsLong_t size;
+    }; // struct file_status
+
+    // Calls _func with the name and type of each entry of the open directory until it
+    // returns false. Returns zero or -errno.
+    template <typename Function>
+    auto for_each_entry(int _fd, Function _func) -> int
+    {
+        thread_local std::vector<char> buffer(dirent_buffer_size);
+
+        while (true) {
+            const auto n = ::syscall(SYS_getdents64, _fd, buffer.data(), buffer.size());
+
+            if (n < 0) {
+                return -errno;
+            }
+
+            if (0 == n) {
+                return 0;
+            }
+
+            for (long offset = 0; offset < n;) {
+                const auto* d = reinterpret_cast<const linux_dirent64*>(buffer.data() + offset);
+                offset += d->d_reclen;
+
+                if (!_func(d->d_name, d->d_type)) {
+                    return 0;
+                }
+            }
+        }
+    } // for_each_entry
+
+    // Stats _name relative to the open directory, following symbolic links. Only the type
+    // and size are requested when statx(2) is available. Returns zero or -errno.
+    auto stat_entry(int _dir_fd, const char* _name, file_status& _status) -> int
+    {
+#ifdef STATX_SIZE
+        struct statx stx;
+        if (statx(_dir_fd, _name, AT_STATX_DONT_SYNC, STATX_TYPE | STATX_SIZE, &stx) < 0) {
+            return -errno;
+        }
+
+        _status.mode = stx.stx_mode;
+        _status.size = static_cast<rodsLong_t>(stx.stx_size);
+#else
+        struct stat st;
+        if (fstatat(_dir_fd, _name, &st, 0) < 0) {
+            return -errno;
+        }
+
+        _status.mode = st.st_mode;
+        _status.size = st.st_size;
+#endif // STATX_SIZE
+
+        return 0;
+    } // stat_entry
+
+    auto is_dot_or_dot_dot(const char* _name) noexcept -> bool
+    {
+        return '.' == _name[0] && ('\0' == _name[1] || ('.' == _name[1] && '\0' == _name[2]));
+    } // is_dot_or_dot_dot
+} // anonymous namespace
+
+namespace irods::experimental::directory_scanner
+{
+    scanner::scanner(const std::string& _directory, const std::string& _collection, options _options)
+        : options_{[&_options] {
+            _options.number_of_threads = std::max(1, _options.number_of_threads);
+            _options.batch_size = std::max<std::size_t>(1, _options.batch_size);
+            _options.max_pending_batches = std::max<std::size_t>(1, _options.max_pending_batches);
+            return std::move(_options);
+        }()}
+        , mutex_{}
+        , batch_available_{}
+        , space_available_{}
+        , batches_{}
+        , pending_directories_{1}
+        , cancelled_{}
+        , status_{}
+        , pool_{options_.number_of_threads}
+    {
+        // Issue #3658 - Trailing slashes would otherwise be repeated in every physical path.
+        auto directory = _directory;
+        while (directory.size() > 1 && '/' == directory.back()) {
+            directory.pop_back();
+        }
+
+        irods::thread_pool::post(pool_, [this, directory, _collection] { visit(directory, _collection); });
+    }
+
+    scanner::~scanner()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            cancelled_ = true;
+        }
+
+        space_available_.notify_all();
+        pool_.join();
+    }
+
+    auto scanner::next() -> std::optional<batch>
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        batch_available_.wait(lock, [this] { return !batches_.empty() || 0 == pending_directories_; });
+
+        if (batches_.empty()) {
+            return std::nullopt;
+        }
+
+        auto b = std::move(batches_.front());
+        batches_.pop_front();
+
+        lock.unlock();
+        space_available_.notify_one();
+
+        return b;
+    } // next
+
+    auto scanner::status() const -> int
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return status_;
+    } // status
+
+    auto scanner::visit(const std::string& _directory, const std::string& _collection) -> void
+    {
+        try {
+            read_directory(_directory, _collection);
+        }
+        catch (const std::exception& e) {
+            rodsLog(LOG_ERROR, "directory_scanner: error scanning %s: %s", _directory.c_str(), e.what());
+            set_status(SYS_INTERNAL_ERR);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            if (--pending_directories_ > 0) {
+                return;
+            }
+        }
+
+        batch_available_.notify_all();
+    } // visit
+
+    auto scanner::read_directory(const std::string& _directory, const std::string& _collection) -> void
+    {
+        const bool skip_files = options_.skip_files && options_.skip_files(_directory);
+
+        batch current;
+        directory_list subdirectories;
+        bool complete = true;
+
+        const int fd = ::open(_directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) {
+            rodsLog(LOG_ERROR, "directory_scanner: cannot open %s, errno = %d", _directory.c_str(), errno);
+            set_status(UNIX_FILE_OPENDIR_ERR - errno);
+            return;
+        }
+
+        irods::at_scope_exit close_fd{[fd] { ::close(fd); }};
+
+        bool cancelled = false;
+
+        const int ec = for_each_entry(fd, [&](const char* _name, unsigned char _type) {
+            if (is_dot_or_dot_dot(_name) || (options_.exclude && options_.exclude(_name, _directory))) {
+                return true;
+            }
+
+            bool is_directory = DT_DIR == _type;
+            rodsLong_t size = 0;
+
+            if (DT_REG == _type && skip_files) {
+                return true;
+            }
+
+            // The type of symbolic links and of entries on filesystems that do not fill in
+            // d_type is only known after a stat.
+            if (DT_REG == _type || DT_LNK == _type || DT_UNKNOWN == _type) {
+                file_status st{};
+                if (const int err = stat_entry(fd, _name, st); err < 0) {
+                    rodsLog(LOG_ERROR, "directory_scanner: cannot stat %s/%s, errno = %d", _directory.c_str(), _name, -err);
+                    set_status(UNIX_FILE_STAT_ERR + err);
+                    complete = false;
+                    return true;
+                }
+
+                if (S_ISDIR(st.mode)) {
+                    is_directory = true;
+                }
+                else if (!S_ISREG(st.mode) || skip_files) {
+                    return true;
+                }
+
+                size = st.size;
+            }
+            else if (!is_directory) {
+                return true;
+            }
+
+            auto physical_path = _directory + '/' + _name;
+            auto logical_path = _collection + '/' + _name;
+
+            if (is_directory) {
+                size = 0;
+                subdirectories.emplace_back(physical_path, logical_path);
+            }
+
+            current.entries.push_back({std::move(physical_path), std::move(logical_path), size, is_directory});
+
+            if (current.entries.size() >= options_.batch_size) {
+                if (!push(std::exchange(current, {}))) {
+                    cancelled = true;
+                    return false;
+                }
+
+                schedule(subdirectories);
+            }
+
+            return true;
+        });
+
+        if (cancelled) {
+            return;
+        }
+
+        if (ec < 0) {
+            rodsLog(LOG_ERROR, "directory_scanner: cannot read %s, errno = %d", _directory.c_str(), -ec);
+            set_status(UNIX_FILE_READDIR_ERR + ec);
+            complete = false;
+        }
+
+        if (complete) {
+            current.completed_directories.push_back(_directory);
+        }
+
+        if ((!current.entries.empty() || complete) && push(std::move(current))) {
+            schedule(subdirectories);
+        }
+    } // read_directory
+
+    auto scanner::push(batch&& _batch) -> bool
+    {
+        {
+            std::unique_lock<std::mutex> lock{mutex_};
+            space_available_.wait(lock, [this] { return cancelled_ || batches_.size() < options_.max_pending_batches; });
+
+            if (cancelled_) {
+                return false;
+            }
+
+            batches_.push_back(std::move(_batch));
+        }
+
+        batch_available_.notify_one();
+
+        return true;
+    } // push
+
+    auto scanner::schedule(directory_list& _directories) -> void
+    {
+        if (_directories.empty()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            pending_directories_ += _directories.size();
+        }
+
+        for (auto& [physical_path, logical_path] : _directories) {
+            irods::thread_pool::post(pool_, [this, p = std::move(physical_path), l = std::move(logical_path)] {
+                visit(p, l);
+            });
+        }
+
+        _directories.clear();
+    } // schedule
+
+    auto scanner::set_status(int _status) -> void
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        status_ = _status;
+    } // set_status
+} // namespace irods::experimental::directory_scanner
@@ -11,6 +11,7 @@
 #include "collection.hpp"
 #include "rsChkNVPathPerm.hpp"
 #include "rsFileStat.hpp"
+#include "inline_checksum_table.hpp"
 
 // =-=-=-=-=-=-=-
 #include "irods_log.hpp"
@@ -88,6 +89,8 @@ freeFileDesc( int fileInx ) {
 
     /* don't free driverDep (dirPtr is not malloced */
 
+    irods::experimental::inline_checksum_table::release( fileInx );
+
     memset( &FileDesc[fileInx], 0, sizeof( fileDesc_t ) );
 
     return 0;
@@ -1,9 +1,13 @@
 #include "finalize_utilities.hpp"
+#include "inline_checksum_table.hpp"
 #include "irods_at_scope_exit.hpp"
 #include "irods_exception.hpp"
+#include "irods_hasher_factory.hpp"
 #include "irods_re_structs.hpp"
 #include "irods_resource_backport.hpp"
 #include "irods_serialization.hpp"
+#include "irods_server_properties.hpp"
+#include "MD5Strategy.hpp"
 #include "objDesc.hpp"
 #include "physPath.hpp"
 #include "rcMisc.h"
@@ -20,6 +24,7 @@
 
 #include "logical_locking.hpp"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -28,8 +33,19 @@
 namespace ill = irods::logical_locking;
 namespace ir = irods::experimental::replica;
 namespace rst = irods::replica_state_table;
+namespace ict = irods::experimental::inline_checksum_table;
 using json = nlohmann::json;
 
+namespace
+{
+    auto default_hash_scheme() -> std::string
+    {
+        std::string hash_scheme = irods::get_server_config_snapshot()->default_hash_scheme.value_or(irods::MD5_NAME);
+        std::transform(hash_scheme.begin(), hash_scheme.end(), hash_scheme.begin(), ::tolower);
+        return hash_scheme;
+    } // default_hash_scheme
+} // anonymous namespace
+
 namespace irods
 {
     auto apply_metadata_from_cond_input(RsComm& _comm, const DataObjInp& _inp) -> void
@@ -175,6 +191,39 @@ namespace irods
         return size_in_vault;
     } // get_size_in_vault
 
+    auto start_inline_checksum(const l1desc& _l1desc) -> void
+    {
+        const auto* info = _l1desc.dataObjInfo;
+
+        if (_l1desc.l3descInx < 3 || _l1desc.remoteZoneHost || !info || info->specColl) {
+            return;
+        }
+
+        ict::start(_l1desc.l3descInx, info->rescHier, info->filePath, default_hash_scheme());
+    } // start_inline_checksum
+
+    auto find_inline_checksum(const DataObjInfo& _info) -> std::optional<std::string>
+    {
+        auto hash_scheme = default_hash_scheme();
+
+        // Mirror the scheme resolution of rsFileChksum so that the same checksum is produced.
+        if (const char* orig_chksum = getValByKey(&_info.condInput, ORIG_CHKSUM_KW); orig_chksum) {
+            std::string chkstr_scheme;
+            irods::get_hash_scheme_from_checksum(orig_chksum, chkstr_scheme);
+
+            if (!chkstr_scheme.empty()) {
+                // Let rsFileChksum report the mismatch.
+                if (STRICT_HASH_POLICY == get_server_config_snapshot()->match_hash_policy.value_or("") && hash_scheme != chkstr_scheme) {
+                    return std::nullopt;
+                }
+
+                hash_scheme = std::move(chkstr_scheme);
+            }
+        }
+
+        return ict::find(_info.rescHier, _info.filePath, _info.dataSize, hash_scheme);
+    } // find_inline_checksum
+
     auto purge_cache(RsComm& _comm, DataObjInfo& _info) -> int
     {
         auto replica = irods::experimental::replica::make_replica_proxy(_info);
@@ -0,0 +1,183 @@
+#include "inline_checksum_table.hpp"
+
+#include "Hasher.hpp"
+#include "irods_hasher_factory.hpp"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    struct entry
+    {
+        std::mutex mutex;
+        std::string resource_hierarchy;
+        std::string physical_path;
+        std::string scheme;
+        irods::Hasher hasher;
+        std::int64_t size = 0;
+        bool valid = true;
+    }; // struct entry
+
+    using entry_pointer = std::shared_ptr<entry>;
+
+    //
+    // Global Variables
+    //
+
+    // Guards the containers below. Each entry is guarded by its own mutex so that
+    // parallel transfer threads do not serialize on the table while hashing.
+    std::mutex g_mutex;
+
+    // Entries for physical file descriptors that are still open, keyed by L3 index.
+    std::map<int, entry_pointer> g_open_entries;
+
+    // Entries for physical file descriptors that have been closed.
+    std::vector<entry_pointer> g_released_entries;
+
+    auto find_open_entry(int _l3_index) -> entry_pointer
+    {
+        std::lock_guard lock{g_mutex};
+
+        if (const auto iter = g_open_entries.find(_l3_index); iter != std::end(g_open_entries)) {
+            return iter->second;
+        }
+
+        return nullptr;
+    } // find_open_entry
+
+    auto same_file(const entry& _entry,
+                   const std::string_view _resource_hierarchy,
+                   const std::string_view _physical_path) noexcept -> bool
+    {
+        return _entry.resource_hierarchy == _resource_hierarchy && _entry.physical_path == _physical_path;
+    } // same_file
+} // anonymous namespace
+
+namespace irods::experimental::inline_checksum_table
+{
+    auto start(int _l3_index,
+               const std::string_view _resource_hierarchy,
+               const std::string_view _physical_path,
+               const std::string_view _scheme) -> bool
+    {
+        auto e = std::make_shared<entry>();
+
+        if (const auto err = irods::getHasher(std::string{_scheme}, e->hasher); !err.ok()) {
+            return false;
+        }
+
+        e->resource_hierarchy = _resource_hierarchy;
+        e->physical_path = _physical_path;
+        e->scheme = _scheme;
+
+        std::lock_guard lock{g_mutex};
+
+        // A new write supersedes whatever was computed for the file earlier.
+        const auto end = std::remove_if(std::begin(g_released_entries), std::end(g_released_entries),
+                                        [&](const entry_pointer& _e) {
+                                            return same_file(*_e, _resource_hierarchy, _physical_path);
+                                        });
+        g_released_entries.erase(end, std::end(g_released_entries));
+
+        g_open_entries.insert_or_assign(_l3_index, std::move(e));
+
+        return true;
+    } // start
+
+    auto update(int _l3_index, const void* _buffer, std::int64_t _length) -> void
+    {
+        const auto e = find_open_entry(_l3_index);
+
+        if (!e || _length <= 0) {
+            return;
+        }
+
+        std::lock_guard lock{e->mutex};
+
+        if (!e->valid) {
+            return;
+        }
+
+        if (const auto err = e->hasher.update({static_cast<const char*>(_buffer), static_cast<std::size_t>(_length)});
+            !err.ok())
+        {
+            e->valid = false;
+            return;
+        }
+
+        e->size += _length;
+    } // update
+
+    auto seek(int _l3_index, std::int64_t _offset) -> void
+    {
+        const auto e = find_open_entry(_l3_index);
+
+        if (!e) {
+            return;
+        }
+
+        std::lock_guard lock{e->mutex};
+
+        if (_offset != e->size) {
+            e->valid = false;
+        }
+    } // seek
+
+    auto release(int _l3_index) -> void
+    {
+        std::lock_guard lock{g_mutex};
+
+        if (const auto iter = g_open_entries.find(_l3_index); iter != std::end(g_open_entries)) {
+            g_released_entries.push_back(std::move(iter->second));
+            g_open_entries.erase(iter);
+        }
+    } // release
+
+    auto find(const std::string_view _resource_hierarchy,
+              const std::string_view _physical_path,
+              std::int64_t _size,
+              const std::string_view _scheme) -> std::optional<std::string>
+    {
+        entry_pointer e;
+
+        {
+            std::lock_guard lock{g_mutex};
+
+            const auto iter = std::find_if(std::rbegin(g_released_entries), std::rend(g_released_entries),
+                                           [&](const entry_pointer& _e) {
+                                               return same_file(*_e, _resource_hierarchy, _physical_path);
+                                           });
+
+            if (iter == std::rend(g_released_entries)) {
+                return std::nullopt;
+            }
+
+            e = *iter;
+        }
+
+        std::lock_guard lock{e->mutex};
+
+        if (!e->valid || e->size != _size || e->scheme != _scheme) {
+            return std::nullopt;
+        }
+
+        std::string digest;
+
+        if (const auto err = e->hasher.digest(digest); !err.ok()) {
+            return std::nullopt;
+        }
+
+        return digest;
+    } // find
+
+    auto erase_released_entries() -> void
+    {
+        std::lock_guard lock{g_mutex};
+        g_released_entries.clear();
+    } // erase_released_entries
+} // namespace irods::experimental::inline_checksum_table
+
@@ -8,6 +8,8 @@
 #include "irods_load_plugin.hpp"
 #include "irods_lexical_cast.hpp"
 #include "rsGenQuery.hpp"
+#include "specificQuery.h"
+#include "rsSpecificQuery.hpp"
 
 // =-=-=-=-=-=-=-
 // irods includes
@@ -19,6 +21,9 @@
 #include "phyBundleColl.h"
 #include "miscServerFunct.hpp"
 #include "genQuery.h"
+#include "irods_at_scope_exit.hpp"
+#include "irods_server_properties.hpp"
+#include "resource_hierarchy_cache.hpp"
 
 #include "fmt/format.h"
 
@@ -32,6 +37,39 @@
 // global singleton
 irods::resource_manager resc_mgr;
 
+namespace
+{
+    namespace rhc = irods::experimental::resource_hierarchy_cache;
+
+    // Returns the version of the resource hierarchy in the catalog, or -1 if it cannot be
+    // read (e.g. the catalog has not been upgraded yet).
+    auto read_resource_hierarchy_version(rsComm_t* _comm) -> std::int64_t
+    {
+        specificQueryInp_t input{};
+        input.maxRows = MAX_SQL_ROWS;
+        input.sql = const_cast<char*>("resourceHierarchyVersion");
+
+        genQueryOut_t* output{};
+        irods::at_scope_exit free_output{[&output] { freeGenQueryOut(&output); }};
+
+        if (const auto ec = rsSpecificQuery(_comm, &input, &output); ec < 0) {
+            rodsLog(LOG_DEBUG, "Could not read resource hierarchy version [error_code=%d].", ec);
+            return -1;
+        }
+
+        if (!output || output->rowCnt < 1) {
+            return -1;
+        }
+
+        try {
+            return std::stoll(output->sqlResult[0].value);
+        }
+        catch (...) {
+            return -1;
+        }
+    } // read_resource_hierarchy_version
+} // anonymous namespace
+
 namespace irods
 {
     const std::string EMPTY_RESC_HOST( "EMPTY_RESC_HOST" );
@@ -238,7 +276,55 @@ namespace irods
         // =-=-=-=-=-=-=-
         // clear existing resource map and initialize
         resource_name_map_.clear();
+        hierarchy_snapshot_.reset();
+
+        // =-=-=-=-=-=-=-
+        // get the resources, from another agent if possible
+        std::shared_ptr<const rhc::snapshot> snapshot;
+        error proc_ret = load_hierarchy_snapshot( _comm, snapshot );
+        if ( !proc_ret.ok() ) {
+            return PASSMSG( "load_hierarchy_snapshot failed.", proc_ret );
+        }
+
+        // =-=-=-=-=-=-=-
+        // create a resource for each entry and add it to the table
+        proc_ret = create_resources( std::move( snapshot ) );
+        if ( !proc_ret.ok() ) {
+            return PASSMSG( "create_resources failed.", proc_ret );
+        }
+
+        // =-=-=-=-=-=-=-
+        // Update child resource maps
+        proc_ret = init_child_map();
+        if ( !proc_ret.ok() ) {
+            return PASSMSG( "init_child_map failed.", proc_ret );
+        }
+
+        // =-=-=-=-=-=-=-
+        // gather the post disconnect maintenance operations
+        error op_ret = gather_operations();
+        if ( !op_ret.ok() ) {
+            return PASSMSG( "gather_operations failed.", op_ret );
+        }
+
+        // =-=-=-=-=-=-=-
+        // call start for plugins
+        error start_err = start_resource_plugins();
+        if ( !start_err.ok() ) {
+            return PASSMSG( "start_resource_plugins failed.", start_err );
+        }
 
+        // =-=-=-=-=-=-=-
+        // win!
+        return SUCCESS();
+
+    } // init_from_catalog
+
+// =-=-=-=-=-=-=-
+// private - query the catalog for all resources
+    error resource_manager::query_resources(
+        rsComm_t*                        _comm,
+        std::vector<rhc::resource_info>& _resources ) {
         // =-=-=-=-=-=-=-
         // set up data structures for a gen query
         genQueryInp_t  genQueryInp;
@@ -296,13 +382,13 @@ namespace irods
             } // if
 
             // =-=-=-=-=-=-=-
-            // given a series of rows, each being a resource, create a resource and add it to the table
-            proc_ret = process_init_results( genQueryOut );
+            // given a series of rows, each being a resource, extract the values
+            proc_ret = process_init_results( genQueryOut, _resources );
 
             // =-=-=-=-=-=-=-
             // if error is not valid, clear query and bail
             if ( !proc_ret.ok() ) {
-                irods::error log_err = PASSMSG( "init_from_catalog - process_init_results failed", proc_ret );
+                irods::error log_err = PASSMSG( "query_resources - process_init_results failed", proc_ret );
                 irods::log( log_err );
                 freeGenQueryOut( &genQueryOut );
                 break;
@@ -329,32 +415,155 @@ namespace irods
             return PASSMSG( "process_init_results failed.", proc_ret );
         }
 
+        return SUCCESS();
+
+    } // query_resources
+
+// =-=-=-=-=-=-=-
+// private - use the hierarchy published by another agent while it matches the catalog,
+//           otherwise read it from the catalog and publish it
+    error resource_manager::load_hierarchy_snapshot(
+        rsComm_t*                             _comm,
+        std::shared_ptr<const rhc::snapshot>& _snapshot ) {
+        auto snapshot = rhc::load();
+
         // =-=-=-=-=-=-=-
-        // Update child resource maps
-        proc_ret = init_child_map();
-        if ( !proc_ret.ok() ) {
-            return PASSMSG( "init_child_map failed.", proc_ret );
+        // changes made through other servers are only noticed by comparing versions
+        if ( snapshot && rhc::seconds_since_verification() >= get_resource_hierarchy_cache_refresh_interval() ) {
+            const auto version = read_resource_hierarchy_version( _comm );
+            if ( version >= 0 && version == snapshot->catalog_version() ) {
+                rhc::mark_verified( version );
+            }
+            else {
+                snapshot.reset();
+            }
         }
 
-        // =-=-=-=-=-=-=-
-        // gather the post disconnect maintenance operations
-        error op_ret = gather_operations();
-        if ( !op_ret.ok() ) {
-            return PASSMSG( "gather_operations failed.", op_ret );
+        if ( !snapshot ) {
+            // =-=-=-=-=-=-=-
+            // the version is read first, so a change committed while the resources are
+            // being read makes the snapshot look outdated rather than current
+            const auto invalidations = rhc::invalidation_count();
+            const auto version = read_resource_hierarchy_version( _comm );
+
+            std::vector<rhc::resource_info> resources;
+            error ret = query_resources( _comm, resources );
+            if ( !ret.ok() ) {
+                return PASS( ret );
+            }
+
+            snapshot = std::make_shared<const rhc::snapshot>( version, std::move( resources ) );
+
+            // =-=-=-=-=-=-=-
+            // without a version no agent could tell whether the snapshot is current
+            if ( version >= 0 ) {
+                rhc::publish( *snapshot, invalidations );
+            }
         }
 
+        _snapshot = std::move( snapshot );
+
+        return SUCCESS();
+
+    } // load_hierarchy_snapshot
+
+// =-=-=-=-=-=-=-
+// private - create a resource for each entry of the snapshot
+    error resource_manager::create_resources( std::shared_ptr<const rhc::snapshot> _snapshot ) {
+        bool all_created = true;
+
+        for ( const auto& info : _snapshot->resources() ) {
+            // =-=-=-=-=-=-=-
+            // create the resource and add properties for column values
+            resource_ptr resc;
+            error ret = load_resource_plugin( resc, info.type, info.name, info.context );
+            if ( !ret.ok() ) {
+                irods::log(PASS(ret));
+                all_created = false;
+                continue;
+            }
+
+            // =-=-=-=-=-=-=-
+            // resolve the host name into a rods server host structure
+            if ( info.location != irods::EMPTY_RESC_HOST ) {
+                rodsHostAddr_t addr;
+                rstrcpy( addr.hostAddr, info.location.c_str(), LONG_NAME_LEN );
+                rstrcpy( addr.zoneName, info.zone.c_str(), NAME_LEN );
+
+                rodsServerHost_t* tmpRodsServerHost = 0;
+                if ( resolveHost( &addr, &tmpRodsServerHost ) < 0 ) {
+                    rodsLog( LOG_NOTICE, "procAndQueRescResult: resolveHost error for %s",
+                             addr.hostAddr );
+                }
+
+                resc->set_property< rodsServerHost_t* >( RESOURCE_HOST, tmpRodsServerHost );
+
+            }
+            else {
+                resc->set_property< rodsServerHost_t* >( RESOURCE_HOST, 0 );
+            }
+
+            resc->set_property<rodsLong_t>( RESOURCE_ID, info.id );
+            resc->set_property<long>( RESOURCE_QUOTA, RESC_QUOTA_UNINIT );
+
+            resc->set_property<std::string>( RESOURCE_FREESPACE,      info.free_space );
+            resc->set_property<std::string>( RESOURCE_ZONE,           info.zone );
+            resc->set_property<std::string>( RESOURCE_NAME,           info.name );
+            resc->set_property<std::string>( RESOURCE_LOCATION,       info.location );
+            resc->set_property<std::string>( RESOURCE_TYPE,           info.type );
+            resc->set_property<std::string>( RESOURCE_CLASS,          info.class_name );
+            resc->set_property<std::string>( RESOURCE_PATH,           info.vault_path );
+            resc->set_property<std::string>( RESOURCE_INFO,           info.info );
+            resc->set_property<std::string>( RESOURCE_COMMENTS,       info.comments );
+            resc->set_property<std::string>( RESOURCE_CREATE_TS,      info.create_time );
+            resc->set_property<std::string>( RESOURCE_MODIFY_TS,      info.modify_time );
+            resc->set_property<std::string>( RESOURCE_CHILDREN,       info.children );
+            resc->set_property<std::string>( RESOURCE_CONTEXT,        info.context );
+            resc->set_property<std::string>( RESOURCE_PARENT,         info.parent );
+            resc->set_property<std::string>( RESOURCE_PARENT_CONTEXT, info.parent_context );
+
+            if ( info.status == std::string( RESC_DOWN ) ) {
+                resc->set_property<int>( RESOURCE_STATUS, INT_RESC_STATUS_DOWN );
+            }
+            else {
+                resc->set_property<int>( RESOURCE_STATUS, INT_RESC_STATUS_UP );
+            }
+
+            // =-=-=-=-=-=-=-
+            // add new resource to the map
+            resource_name_map_[ info.name ] = resc;
+            resource_id_map_[ info.id ] = resc;
+
+        } // for info
+
         // =-=-=-=-=-=-=-
-        // call start for plugins
-        error start_err = start_resource_plugins();
-        if ( !start_err.ok() ) {
-            return PASSMSG( "start_resource_plugins failed.", start_err );
+        // the hierarchies of the snapshot only describe the resource tree when every
+        // resource in it could be created
+        if ( all_created ) {
+            hierarchy_snapshot_ = std::move( _snapshot );
         }
 
-        // =-=-=-=-=-=-=-
-        // win!
         return SUCCESS();
 
-    } // init_from_catalog
+    } // create_resources
+
+    int resource_manager::snapshot_index_of( std::string_view _resource_name ) const {
+        if ( !hierarchy_snapshot_ ) {
+            return -1;
+        }
+
+        return hierarchy_snapshot_->index_of( _resource_name );
+
+    } // snapshot_index_of
+
+    int resource_manager::snapshot_index_of( rodsLong_t _resource_id ) const {
+        if ( !hierarchy_snapshot_ ) {
+            return -1;
+        }
+
+        return hierarchy_snapshot_->index_of( _resource_id );
+
+    } // snapshot_index_of
 
 // =-=-=-=-=-=-=-
 /// @brief call shutdown on resources before destruction
@@ -457,6 +666,10 @@ namespace irods
             return {};
         }
 
+        if (const auto index = snapshot_index_of(_resource_name); index >= 0) {
+            return hierarchy_snapshot_->hierarchy(index);
+        }
+
         irods::hierarchy_parser hierarchy{_resource_name.data()};
 
         for (std::string parent_name = _resource_name.data(); !parent_name.empty();) {
@@ -486,6 +699,11 @@ namespace irods
         const std::string& _resc_name,
         std::string&       _hierarchy ) {
 
+        if ( const auto index = snapshot_index_of( _resc_name ); index >= 0 ) {
+            _hierarchy = hierarchy_snapshot_->hierarchy( index );
+            return SUCCESS();
+        }
+
         _hierarchy = _resc_name;
         std::string parent_name = _resc_name;
 
@@ -589,8 +807,10 @@ namespace irods
     }
 
 // =-=-=-=-=-=-=-
-// public - take results from genQuery, extract values and create resources
-    error resource_manager::process_init_results( genQueryOut_t* _result ) {
+// private - take results from genQuery and extract values
+    error resource_manager::process_init_results(
+        genQueryOut_t*                   _result,
+        std::vector<rhc::resource_info>& _resources ) {
         // =-=-=-=-=-=-=-
         // extract results from query
         if ( !_result ) {
@@ -675,88 +895,28 @@ namespace irods
         }
 
         // =-=-=-=-=-=-=-
-        // iterate through the rows, initialize a resource for each entry
+        // iterate through the rows, extract the values of each entry
         for ( int i = 0; i < _result->rowCnt; ++i ) {
-            // =-=-=-=-=-=-=-
-            // extract row values
-            std::string tmpRescId        = &rescId->value[ rescId->len * i ];
-            std::string tmpRescLoc       = &rescLoc->value[ rescLoc->len * i ];
-            std::string tmpRescName      = &rescName->value[ rescName->len * i ];
-            std::string tmpZoneName      = &zoneName->value[ zoneName->len * i ];
-            std::string tmpRescType      = &rescType->value[ rescType->len * i ];
-            std::string tmpRescInfo      = &rescInfo->value[ rescInfo->len * i ];
-            std::string tmpFreeSpace     = &freeSpace->value[ freeSpace->len * i ];
-            std::string tmpRescClass     = &rescClass->value[ rescClass->len * i ];
-            std::string tmpRescCreate    = &rescCreate->value[ rescCreate->len * i ];
-            std::string tmpRescModify    = &rescModify->value[ rescModify->len * i ];
-            std::string tmpRescStatus    = &rescStatus->value[ rescStatus->len * i ];
-            std::string tmpRescComments  = &rescComments->value[ rescComments->len * i ];
-            std::string tmpRescVaultPath = &rescVaultPath->value[ rescVaultPath->len * i ];
-            std::string tmpRescChildren  = &rescChildren->value[ rescChildren->len * i ];
-            std::string tmpRescContext   = &rescContext->value[ rescContext->len * i ];
-            std::string tmpRescParent    = &rescParent->value[ rescParent->len * i ];
-            std::string tmpRescParentCtx = &rescParentContext->value[ rescParent->len * i ];
-
-            // =-=-=-=-=-=-=-
-            // create the resource and add properties for column values
-            resource_ptr resc;
-            error ret = load_resource_plugin( resc, tmpRescType, tmpRescName, tmpRescContext );
-            if ( !ret.ok() ) {
-                irods::log(PASS(ret));
-                continue;
-            }
-
-            // =-=-=-=-=-=-=-
-            // resolve the host name into a rods server host structure
-            if ( tmpRescLoc != irods::EMPTY_RESC_HOST ) {
-                rodsHostAddr_t addr;
-                rstrcpy( addr.hostAddr, const_cast<char*>( tmpRescLoc.c_str() ), LONG_NAME_LEN );
-                rstrcpy( addr.zoneName, const_cast<char*>( tmpZoneName.c_str() ), NAME_LEN );
-
-                rodsServerHost_t* tmpRodsServerHost = 0;
-                if ( resolveHost( &addr, &tmpRodsServerHost ) < 0 ) {
-                    rodsLog( LOG_NOTICE, "procAndQueRescResult: resolveHost error for %s",
-                             addr.hostAddr );
-                }
-
-                resc->set_property< rodsServerHost_t* >( RESOURCE_HOST, tmpRodsServerHost );
-
-            }
-            else {
-                resc->set_property< rodsServerHost_t* >( RESOURCE_HOST, 0 );
-            }
-
-            rodsLong_t resource_id = strtoll( tmpRescId.c_str(), 0, 0 );
-            resc->set_property<rodsLong_t>( RESOURCE_ID, resource_id );
-            resc->set_property<long>( RESOURCE_QUOTA, RESC_QUOTA_UNINIT );
-
-            resc->set_property<std::string>( RESOURCE_FREESPACE,      tmpFreeSpace );
-            resc->set_property<std::string>( RESOURCE_ZONE,           tmpZoneName );
-            resc->set_property<std::string>( RESOURCE_NAME,           tmpRescName );
-            resc->set_property<std::string>( RESOURCE_LOCATION,       tmpRescLoc );
-            resc->set_property<std::string>( RESOURCE_TYPE,           tmpRescType );
-            resc->set_property<std::string>( RESOURCE_CLASS,          tmpRescClass );
-            resc->set_property<std::string>( RESOURCE_PATH,           tmpRescVaultPath );
-            resc->set_property<std::string>( RESOURCE_INFO,           tmpRescInfo );
-            resc->set_property<std::string>( RESOURCE_COMMENTS,       tmpRescComments );
-            resc->set_property<std::string>( RESOURCE_CREATE_TS,      tmpRescCreate );
-            resc->set_property<std::string>( RESOURCE_MODIFY_TS,      tmpRescModify );
-            resc->set_property<std::string>( RESOURCE_CHILDREN,       tmpRescChildren );
-            resc->set_property<std::string>( RESOURCE_CONTEXT,        tmpRescContext );
-            resc->set_property<std::string>( RESOURCE_PARENT,         tmpRescParent );
-            resc->set_property<std::string>( RESOURCE_PARENT_CONTEXT, tmpRescParentCtx );
-
-            if ( tmpRescStatus == std::string( RESC_DOWN ) ) {
-                resc->set_property<int>( RESOURCE_STATUS, INT_RESC_STATUS_DOWN );
-            }
-            else {
-                resc->set_property<int>( RESOURCE_STATUS, INT_RESC_STATUS_UP );
-            }
-
-            // =-=-=-=-=-=-=-
-            // add new resource to the map
-            resource_name_map_[ tmpRescName ] = resc;
-            resource_id_map_[ resource_id ] = resc;
+            rhc::resource_info info;
+            info.id             = strtoll( &rescId->value[ rescId->len * i ], 0, 0 );
+            info.name           = &rescName->value[ rescName->len * i ];
+            info.zone           = &zoneName->value[ zoneName->len * i ];
+            info.type           = &rescType->value[ rescType->len * i ];
+            info.class_name     = &rescClass->value[ rescClass->len * i ];
+            info.location       = &rescLoc->value[ rescLoc->len * i ];
+            info.vault_path     = &rescVaultPath->value[ rescVaultPath->len * i ];
+            info.free_space     = &freeSpace->value[ freeSpace->len * i ];
+            info.info           = &rescInfo->value[ rescInfo->len * i ];
+            info.comments       = &rescComments->value[ rescComments->len * i ];
+            info.create_time    = &rescCreate->value[ rescCreate->len * i ];
+            info.modify_time    = &rescModify->value[ rescModify->len * i ];
+            info.status         = &rescStatus->value[ rescStatus->len * i ];
+            info.children       = &rescChildren->value[ rescChildren->len * i ];
+            info.context        = &rescContext->value[ rescContext->len * i ];
+            info.parent         = &rescParent->value[ rescParent->len * i ];
+            info.parent_context = &rescParentContext->value[ rescParentContext->len * i ];
+
+            _resources.push_back( std::move( info ) );
 
         } // for i
 
@@ -1136,52 +1296,24 @@ namespace irods
             THROW(HIERARCHY_ERROR, "empty hierarchy string");
         }
 
-        const std::string leaf = irods::hierarchy_parser{_hierarchy.data()}.last_resc();
-        if (!resource_name_map_.has_entry(leaf)) {
-            THROW(SYS_RESC_DOES_NOT_EXIST, leaf);
+        // Only the leaf resource is needed, so the hierarchy is not split.
+        if (const auto pos = _hierarchy.rfind(hierarchy_parser::delimiter().front()); std::string_view::npos != pos) {
+            _hierarchy.remove_prefix(pos + 1);
         }
 
-        rodsLong_t id = 0;
-        const resource_ptr resc = resource_name_map_[leaf];
-        if (const error ret = resc->get_property<rodsLong_t>(RESOURCE_ID, id); !ret.ok()) {
-            THROW(ret.code(), ret.result());
-        }
-        return id;
+        return resc_name_to_id(_hierarchy);
     } // hier_to_leaf_id
 
     error resource_manager::hier_to_leaf_id(
         const std::string& _hier,
         rodsLong_t&        _id ) {
-        if(_hier.empty()) {
-            return ERROR(
-                       HIERARCHY_ERROR,
-                       "empty hierarchy string" );
-        }
-
-        hierarchy_parser p;
-        p.set_string( _hier );
-
-        std::string leaf;
-        p.last_resc( leaf );
-
-        if( !resource_name_map_.has_entry(leaf) ) {
-            return ERROR(
-                       SYS_RESC_DOES_NOT_EXIST,
-                       leaf );
+        try {
+            _id = hier_to_leaf_id(std::string_view{_hier});
         }
-
-        resource_ptr resc = resource_name_map_[leaf];
-
-        rodsLong_t id = 0;
-        error ret = resc->get_property<rodsLong_t>(
-                        RESOURCE_ID,
-                        id );
-        if( !ret.ok() ) {
-            return PASS(ret);
+        catch (const irods::exception& e) {
+            return ERROR(e.code(), e.client_display_what());
         }
 
-        _id = id;
-
         return SUCCESS();
 
     } // hier_to_leaf_id
@@ -1192,6 +1324,10 @@ namespace irods
             THROW(SYS_RESC_DOES_NOT_EXIST, fmt::format("invalid resource id: {}", _leaf_resource_id));
         }
 
+        if (const auto index = snapshot_index_of(_leaf_resource_id); index >= 0) {
+            return hierarchy_snapshot_->hierarchy(index);
+        }
+
         resource_ptr resc = resource_id_map_[_leaf_resource_id];
 
         std::string leaf_name;
@@ -1228,6 +1364,11 @@ namespace irods
                        msg.str() );
         }
 
+        if ( const auto index = snapshot_index_of( _id ); index >= 0 ) {
+            _hier = hierarchy_snapshot_->hierarchy( index );
+            return SUCCESS();
+        }
+
         resource_ptr resc = resource_id_map_[ _id ];
 
         std::string hier;
@@ -1358,6 +1499,100 @@ namespace irods
         return resc_id_to_name(id);
     } // resc_id_to_name
 
+    rodsLong_t resource_manager::resc_name_to_id(std::string_view _resource_name)
+    {
+        if (const auto index = snapshot_index_of(_resource_name); index >= 0) {
+            return hierarchy_snapshot_->resources()[index].id;
+        }
+
+        const std::string name{_resource_name};
+        if (!resource_name_map_.has_entry(name)) {
+            THROW(SYS_RESC_DOES_NOT_EXIST, name);
+        }
+
+        rodsLong_t id = 0;
+        const resource_ptr resc = resource_name_map_[name];
+        if (const error ret = resc->get_property<rodsLong_t>(RESOURCE_ID, id); !ret.ok()) {
+            THROW(ret.code(), ret.result());
+        }
+        return id;
+    } // resc_name_to_id
+
+    experimental::resource_hierarchy resource_manager::leaf_id_to_resource_hierarchy(rodsLong_t _leaf_resource_id)
+    {
+        if (!resource_id_map_.has_entry(_leaf_resource_id)) {
+            THROW(SYS_RESC_DOES_NOT_EXIST, fmt::format("invalid resource id: {}", _leaf_resource_id));
+        }
+
+        experimental::resource_hierarchy hierarchy;
+
+        if (const auto index = snapshot_index_of(_leaf_resource_id); index >= 0) {
+            const auto& path = hierarchy_snapshot_->path_to_root(index);
+            for (auto iter = path.rbegin(); iter != path.rend(); ++iter) {
+                hierarchy.add_child(hierarchy_snapshot_->resources()[*iter].id);
+            }
+            return hierarchy;
+        }
+
+        resource_ptr resc = resource_id_map_[_leaf_resource_id];
+        while (resc.get()) {
+            rodsLong_t id = 0;
+            if (const error ret = resc->get_property<rodsLong_t>(RESOURCE_ID, id); !ret.ok()) {
+                THROW(ret.code(), ret.result());
+            }
+
+            hierarchy.add_parent(id);
+
+            resc->get_parent(resc);
+        }
+
+        return hierarchy;
+    } // leaf_id_to_resource_hierarchy
+
+    experimental::resource_hierarchy resource_manager::to_resource_hierarchy(std::string_view _hierarchy)
+    {
+        if (_hierarchy.empty()) {
+            THROW(HIERARCHY_ERROR, "empty hierarchy string");
+        }
+
+        const auto delimiter = hierarchy_parser::delimiter().front();
+
+        experimental::resource_hierarchy hierarchy;
+
+        while (!_hierarchy.empty()) {
+            const auto end = _hierarchy.find(delimiter);
+            const auto name = _hierarchy.substr(0, end);
+
+            if (!name.empty()) {
+                hierarchy.add_child(resc_name_to_id(name));
+            }
+
+            _hierarchy.remove_prefix(std::string_view::npos == end ? _hierarchy.size() : end + 1);
+        }
+
+        return hierarchy;
+    } // to_resource_hierarchy
+
+    std::string resource_manager::to_hierarchy_string(const experimental::resource_hierarchy& _hierarchy)
+    {
+        std::string hierarchy;
+
+        for (const auto id : _hierarchy) {
+            if (!hierarchy.empty()) {
+                hierarchy += hierarchy_parser::delimiter();
+            }
+
+            if (const auto index = snapshot_index_of(id); index >= 0) {
+                hierarchy += hierarchy_snapshot_->resources()[index].name;
+            }
+            else {
+                hierarchy += resc_id_to_name(id);
+            }
+        }
+
+        return hierarchy;
+    } // to_hierarchy_string
+
     error resource_manager::is_coordinating_resource(
         const std::string& _resc_name,
         bool&              _ret ) {
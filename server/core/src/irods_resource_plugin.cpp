@@ -95,6 +95,16 @@ auto get_resource_name(plugin_context& ctx) -> std::string
     return resc_name;
 } // get_resource_name
 
+auto get_resource_id(plugin_context& ctx) -> rodsLong_t
+{
+    rodsLong_t resc_id{};
+    if (error err = ctx.prop_map().get<rodsLong_t>(RESOURCE_ID, resc_id); !err.ok()) {
+        const irods::error ret = PASSMSG("Failed to get \"id\" property.", err);
+        THROW(ret.code(), ret.result());
+    }
+    return resc_id;
+} // get_resource_id
+
 auto get_resource_status(plugin_context& ctx) -> int
 {
     int resc_status{}; 
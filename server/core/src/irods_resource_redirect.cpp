@@ -18,6 +18,9 @@
 
 #include "fmt/format.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace
 {
     std::string get_keyword_from_inp(
@@ -51,12 +54,35 @@ namespace
         return key_word;
     } // get_keyword_from_inp
 
+    // Checks the resource IDs of the replica's hierarchy when possible. The hierarchy string is
+    // used when the resource is unknown or the hierarchy is deeper than resource_hierarchy::max_depth.
+    bool resc_in_hier_for_replica(
+        const irods::physical_object& _replica,
+        rodsLong_t                    _resc_id,
+        const std::string&            _resc)
+    {
+        if (_resc_id > 0) {
+            try {
+                return resc_mgr.leaf_id_to_resource_hierarchy(_replica.resc_id()).contains(_resc_id);
+            }
+            catch (const irods::exception&) {}
+        }
+
+        return irods::hierarchy_parser{_replica.resc_hier()}.resc_in_hier(_resc);
+    } // resc_in_hier_for_replica
+
     bool hier_has_replica(
         const std::string& _resc,
         const irods::file_object_ptr _file_obj)
     {
+        rodsLong_t resc_id{};
+        try {
+            resc_id = resc_mgr.resc_name_to_id(_resc);
+        }
+        catch (const irods::exception&) {}
+
         for (const auto& r : _file_obj->replicas()) {
-            if (irods::hierarchy_parser{r.resc_hier()}.resc_in_hier(_resc)) {
+            if (resc_in_hier_for_replica(r, resc_id, _resc)) {
                 return true;
             }
         }
@@ -186,10 +212,25 @@ namespace
         bool kw_match_found{};
         std::string max_hier{};
         float max_vote = -1.0;
+        // Replicas usually share a few root resources, so each root is only named once.
         std::map<std::string, float> root_map;
+        std::vector<rodsLong_t> root_ids;
         for (const auto& repl : _file_obj->replicas()) {
-            const std::string root_resc = irods::hierarchy_parser{repl.resc_hier()}.first_resc();
-            root_map[root_resc] = irv::vote::zero;
+            try {
+                const auto root_id = resc_mgr.leaf_id_to_resource_hierarchy(repl.resc_id()).root();
+                if (std::find(std::begin(root_ids), std::end(root_ids), root_id) == std::end(root_ids)) {
+                    root_ids.push_back(root_id);
+                }
+            }
+            catch (const irods::exception&) {
+                // The hierarchy is deeper than resource_hierarchy::max_depth or the leaf resource
+                // is unknown, so the root resource is taken from the hierarchy string.
+                root_map[irods::hierarchy_parser{repl.resc_hier()}.first_resc()] = irv::vote::zero;
+            }
+        }
+
+        for (const auto root_id : root_ids) {
+            root_map[resc_mgr.resc_id_to_name(root_id)] = irv::vote::zero;
         }
 
         if (root_map.empty()) {
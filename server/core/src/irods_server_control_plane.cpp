@@ -21,12 +21,16 @@
 #include "irods_server_state.hpp"
 #include "irods_exception.hpp"
 #include "irods_stacktrace.hpp"
+#include "server_load_publisher.hpp"
+#include "agent_registry.hpp"
 
 #include "boost/lexical_cast.hpp"
 
 #include "json.hpp"
 
+#include <cstdint>
 #include <ctime>
+#include <map>
 #include <unistd.h>
 
 namespace irods {
@@ -37,7 +41,7 @@ namespace irods {
         usleep( us );
     }
 
-    static error forward_server_control_command(
+    error forward_server_control_command(
         const std::string& _name,
         const std::string& _host,
         const std::string& _port_keyword,
@@ -346,37 +350,27 @@ namespace irods {
 
     } // operation_resume
 
-    static int get_pid_age(
-        pid_t _pid ) {
-        std::stringstream pid_str; pid_str << _pid;
-        std::vector<std::string> args;
-        args.push_back( pid_str.str() );
-
-        std::string pid_age;
-        irods::error ret = get_script_output_single_line(
-                               "python",
-                               "pid_age.py",
-                               args,
-                               pid_age );
-        if ( !ret.ok() ) {
-            irods::log( PASS( ret ) );
-            return 0;
-        }
-
-        double age = 0.0;
-        try {
-            age = boost::lexical_cast<double>( pid_age );
-        }
-        catch ( const boost::bad_lexical_cast& ) {
-            rodsLog(
-                LOG_ERROR,
-                "get_pid_age bad lexical cast for [%s]",
-                pid_age.c_str() );
-
-        }
-
-        return static_cast<int>( age );
-    } // get_pid_age
+    static nlohmann::json agent_statistics(
+        const experimental::agent_registry::agent_info& _agent,
+        std::time_t _now ) {
+        return nlohmann::json{
+            {"agent_pid", _agent.pid},
+            {"age", _now - _agent.start_time},
+            {"client_user", _agent.proxy_name},
+            {"client_zone", _agent.client_zone},
+            {"proxy_user", _agent.client_name},
+            {"proxy_zone", _agent.proxy_zone},
+            {"program", _agent.program_name},
+            {"remote_address", _agent.remote_address},
+            {"api_number", _agent.api_number},
+            {"api_start_time", _agent.api_number > 0 ? _agent.api_start_time : 0},
+            {"api_calls", _agent.api_calls},
+            {"bytes_read", _agent.bytes_read},
+            {"bytes_written", _agent.bytes_written},
+            {"catalog_operations", _agent.catalog_operations},
+            {"rule_engine_time_in_microseconds", _agent.rule_engine_time_microseconds}
+        };
+    } // agent_statistics
 
     static error operation_status(
         const std::string&, // _wait_option,
@@ -407,16 +401,26 @@ namespace irods {
 
         auto arr = json::array();
 
+        // agents that have not authenticated yet are not in the registry
+        std::map<pid_t, experimental::agent_registry::agent_info> agents;
+        for ( auto&& agent : experimental::agent_registry::list() ) {
+            agents.emplace( agent.pid, agent );
+        }
+
+        const auto now = std::time( nullptr );
+
         std::vector<int> pids;
         getAgentProcPIDs( pids );
         for ( size_t i = 0; i < pids.size(); ++i ) {
-            int pid = pids[i];
-            int age = get_pid_age( pids[i] );
-
-            arr.push_back(json::object({
-                {"agent_pid", pid},
-                {"age", age}
-            }));
+            if ( const auto iter = agents.find( pids[i] ); iter != agents.end() ) {
+                arr.push_back( agent_statistics( iter->second, now ) );
+            }
+            else {
+                arr.push_back(json::object({
+                    {"agent_pid", pids[i]},
+                    {"age", 0}
+                }));
+            }
         }
 
         obj["agents"] = arr;
@@ -441,6 +445,67 @@ namespace irods {
         return SUCCESS();
     }
 
+    static error operation_load(
+        const std::string&, // _wait_option,
+        const size_t, //       _wait_seconds,
+        std::string& _output ) {
+        _output += get_local_load_samples().dump();
+        _output += ",";
+
+        return SUCCESS();
+    } // operation_load
+
+    static error operation_metrics(
+        const std::string&, // _wait_option,
+        const size_t, //       _wait_seconds,
+        std::string& _output ) {
+        rodsEnv my_env;
+        _reloadRodsEnv( my_env );
+
+        using json = nlohmann::json;
+
+        const auto now = std::time( nullptr );
+
+        std::int64_t active = 0;
+        std::int64_t api_calls = 0;
+        std::int64_t bytes_read = 0;
+        std::int64_t bytes_written = 0;
+        std::int64_t catalog_operations = 0;
+        std::int64_t rule_engine_time = 0;
+
+        auto arr = json::array();
+
+        for ( auto&& agent : experimental::agent_registry::list() ) {
+            active += agent.api_number > 0 ? 1 : 0;
+            api_calls += agent.api_calls;
+            bytes_read += agent.bytes_read;
+            bytes_written += agent.bytes_written;
+            catalog_operations += agent.catalog_operations;
+            rule_engine_time += agent.rule_engine_time_microseconds;
+
+            arr.push_back( agent_statistics( agent, now ) );
+        }
+
+        json obj{
+            {"hostname", my_env.rodsHost},
+            {"totals", {
+                {"agents", arr.size()},
+                {"active_agents", active},
+                {"api_calls", api_calls},
+                {"bytes_read", bytes_read},
+                {"bytes_written", bytes_written},
+                {"catalog_operations", catalog_operations},
+                {"rule_engine_time_in_microseconds", rule_engine_time}
+            }},
+            {"agents", arr}
+        };
+
+        _output += obj.dump(4);
+        _output += ",";
+
+        return SUCCESS();
+    } // operation_metrics
+
     bool server_control_executor::compare_host_names(
         const std::string& _hn1,
         const std::string& _hn2 ) {
@@ -520,6 +585,8 @@ namespace irods {
         }
         else {
             op_map_[ SERVER_CONTROL_SHUTDOWN ] = server_operation_shutdown;
+            op_map_[ SERVER_CONTROL_LOAD ]     = operation_load;
+            op_map_[ SERVER_CONTROL_METRICS ]  = operation_metrics;
 
         }
 
@@ -1157,6 +1224,16 @@ namespace irods {
             return SUCCESS();
         }
 
+        // load samples only ever describe the receiving server and are
+        // requested by every peer each sampling interval, so answer them
+        // without the catalog lookup needed to validate host lists
+        if ( SERVER_CONTROL_LOAD == cmd_name ) {
+            return op_map_[ cmd_name ](
+                       wait_option,
+                       wait_seconds,
+                       _output );
+        }
+
         // the icat needs to be notified first in certain
         // cases such as RESUME where it is needed to capture
         // the host list for validation, etc
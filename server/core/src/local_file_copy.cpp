@@ -0,0 +1,119 @@
+#include "local_file_copy.hpp"
+
+#include <algorithm>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace
+{
+    // The largest request passed to the kernel at once. Both system calls
+    // transfer at most 0x7ffff000 bytes per call anyway.
+    constexpr std::int64_t max_chunk_size = 1 << 30;
+
+    auto clone_file(int _in_fd, int _out_fd, std::int64_t _size) noexcept -> bool
+    {
+#ifdef FICLONE
+        struct stat in_stat;
+        struct stat out_stat;
+
+        if (fstat(_in_fd, &in_stat) < 0 || fstat(_out_fd, &out_stat) < 0) {
+            return false;
+        }
+
+        // Cloning replaces the entire destination, so it is only equivalent to a
+        // copy when the whole source is copied into an empty destination.
+        if (in_stat.st_dev != out_stat.st_dev || in_stat.st_size != _size || out_stat.st_size != 0) {
+            return false;
+        }
+
+        if (lseek(_in_fd, 0, SEEK_CUR) != 0 || lseek(_out_fd, 0, SEEK_CUR) != 0) {
+            return false;
+        }
+
+        if (ioctl(_out_fd, FICLONE, _in_fd) < 0) {
+            return false;
+        }
+
+        // Leave the offsets where a copy would have left them.
+        lseek(_in_fd, _size, SEEK_SET);
+        lseek(_out_fd, _size, SEEK_SET);
+
+        return true;
+#else
+        return false;
+#endif // FICLONE
+    } // clone_file
+
+    // Calls _transfer until _size bytes are copied, the source is exhausted, or
+    // the kernel reports an error. Returns the number of bytes copied.
+    template <typename Function>
+    auto transfer_in_chunks(std::int64_t _size, Function _transfer) noexcept -> std::int64_t
+    {
+        std::int64_t copied = 0;
+
+        while (copied < _size) {
+            const auto n = _transfer(static_cast<std::size_t>(std::min(_size - copied, max_chunk_size)));
+
+            if (n > 0) {
+                copied += n;
+            }
+            else if (n < 0 && EINTR == errno) {
+                continue;
+            }
+            else {
+                break;
+            }
+        }
+
+        return copied;
+    } // transfer_in_chunks
+} // anonymous namespace
+
+namespace irods::experimental::local_file_copy
+{
+    auto same_filesystem(int _in_fd, int _out_fd) noexcept -> bool
+    {
+        struct stat in_stat;
+        struct stat out_stat;
+
+        if (fstat(_in_fd, &in_stat) < 0 || fstat(_out_fd, &out_stat) < 0) {
+            return false;
+        }
+
+        return S_ISREG(in_stat.st_mode) && S_ISREG(out_stat.st_mode) && in_stat.st_dev == out_stat.st_dev;
+    } // same_filesystem
+
+    auto copy(int _in_fd, int _out_fd, std::int64_t _size) noexcept -> std::int64_t
+    {
+        if (_size <= 0) {
+            return 0;
+        }
+
+        if (clone_file(_in_fd, _out_fd, _size)) {
+            return _size;
+        }
+
+        std::int64_t copied = 0;
+
+#ifdef SYS_copy_file_range
+        // Invoked through syscall(2) because older C libraries do not provide a wrapper.
+        copied += transfer_in_chunks(_size, [_in_fd, _out_fd](std::size_t _count) {
+            return syscall(SYS_copy_file_range, _in_fd, nullptr, _out_fd, nullptr, _count, 0U);
+        });
+#endif // SYS_copy_file_range
+
+        copied += transfer_in_chunks(_size - copied, [_in_fd, _out_fd](std::size_t _count) {
+            return sendfile(_out_fd, _in_fd, nullptr, _count);
+        });
+
+        return copied;
+    } // copy
+} // namespace irods::experimental::local_file_copy
+
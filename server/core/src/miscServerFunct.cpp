@@ -54,6 +54,7 @@ char *__loc1;
 #include "irods_stacktrace.hpp"
 #include "irods_network_factory.hpp"
 #include "irods_buffer_encryption.hpp"
+#include "irods_encrypted_frame_writer.hpp"
 #include "irods_client_server_negotiation.hpp"
 #include "irods_exception.hpp"
 #include "irods_serialization.hpp"
@@ -65,10 +66,13 @@ char *__loc1;
 #include "irods_random.hpp"
 #include "irods_resource_manager.hpp"
 #include "irods_default_paths.hpp"
+#include "irods_resource_backport.hpp"
+#include "local_file_copy.hpp"
 using leaf_bundle_t = irods::resource_manager::leaf_bundle_t;
 
 #include <iomanip>
 #include <fstream>
+#include <optional>
 
 #include <boost/filesystem.hpp>
 
@@ -686,7 +690,7 @@ partialDataPut( portalTransferInp_t *myInput ) {
 
     int chunk_size;
     try {
-        chunk_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_CHUNK_SIZE_PARA_TRANS) * 1024 * 1024;
+        chunk_size = irods::get_server_config_snapshot()->advanced_settings.transfer_chunk_size_for_parallel_transfer_in_megabytes.get() * 1024 * 1024;
     } catch ( const irods::exception& e ) {
         irods::log(e);
         return;
@@ -694,7 +698,7 @@ partialDataPut( portalTransferInp_t *myInput ) {
 
     int trans_buff_size = 0;
     try {
-        trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS) * 1024 * 1024;
+        trans_buff_size = irods::get_server_config_snapshot()->advanced_settings.transfer_buffer_size_for_parallel_transfer_in_megabytes.get() * 1024 * 1024;
     } catch ( const irods::exception& e ) {
         irods::log(e);
         return;
@@ -890,10 +894,6 @@ void partialDataGet(
 
     // =-=-=-=-=-=-=-
     // create an encryption context
-    int iv_size = 0;
-    irods::buffer_crypt::array_t iv;
-    irods::buffer_crypt::array_t cipher;
-    irods::buffer_crypt::array_t in_buf;
     irods::buffer_crypt::array_t shared_secret;
     irods::buffer_crypt crypt(
         myInput->key_size,
@@ -902,17 +902,18 @@ void partialDataGet(
         myInput->encryption_algorithm );
 
     // =-=-=-=-=-=-=-
-    // set iv size
+    // buffers are encrypted while the previous one is sent
+    std::optional<irods::encrypted_frame_writer> writer;
     if ( use_encryption_flg ) {
-        iv_size = crypt.key_size();
         shared_secret.assign(
             &myInput->shared_secret[0],
-            &myInput->shared_secret[iv_size] );
+            &myInput->shared_secret[crypt.key_size()] );
+        writer.emplace( destFd, crypt, shared_secret );
     }
 
     int trans_buff_size = 0;
     try {
-        trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS) * 1024 * 1024;
+        trans_buff_size = irods::get_server_config_snapshot()->advanced_settings.transfer_buffer_size_for_parallel_transfer_in_megabytes.get() * 1024 * 1024;
     } catch ( const irods::exception& e ) {
         irods::log(e);
         return;
@@ -925,7 +926,7 @@ void partialDataGet(
 
     int chunk_size;
     try {
-        chunk_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_CHUNK_SIZE_PARA_TRANS) * 1024 * 1024;
+        chunk_size = irods::get_server_config_snapshot()->advanced_settings.transfer_chunk_size_for_parallel_transfer_in_megabytes.get() * 1024 * 1024;
     } catch ( const irods::exception& e ) {
         irods::log(e);
         return;
@@ -974,79 +975,34 @@ void partialDataGet(
 
 
             if ( bytesRead == toread1 ) {
-                // =-=-=-=-=-=-=-
-                // compute an iv for this particular transmission and use
-                // it to encrypt this buffer
-                int new_size = bytesRead;
-                if ( use_encryption_flg ) {
-                    irods::error ret = crypt.initialization_vector( iv );
+                if ( writer ) {
+                    irods::error ret = writer->write( buf, bytesRead );
                     if ( !ret.ok() ) {
-                        ret = PASS( ret );
-                        printf( "%s", ret.result().c_str() );
-                        break;
-                    }
-
-                    // =-=-=-=-=-=-=-
-                    // encrypt
-                    in_buf.assign(
-                        &buf[0],
-                        &buf[ bytesRead ] );
-
-                    ret = crypt.encrypt(
-                              shared_secret,
-                              iv,
-                              in_buf,
-                              cipher );
-                    if ( !ret.ok() ) {
-                        ret = PASS( ret );
-                        printf( "%s", ret.result().c_str() );
+                        irods::log( PASS( ret ) );
+                        myInput->status = ret.code();
                         break;
                     }
-
-                    // =-=-=-=-=-=-=-
-                    // capture the iv with the cipher text
-                    memset( buf, 0,  buf_size );
-                    std::copy(
-                        iv.begin(),
-                        iv.end(),
-                        &buf[0] );
-                    std::copy(
-                        cipher.begin(),
-                        cipher.end(),
-                        &buf[iv_size] );
-
-                    new_size = iv_size + cipher.size();
-
-                    // =-=-=-=-=-=-=-
-                    // need to send the incoming size as encryption might change
-                    // the size of the data from the written values
+                }
+                else {
                     bytesWritten = myWrite(
                                        destFd,
-                                       &new_size,
-                                       sizeof( int ),
+                                       buf,
+                                       bytesRead,
                                        &bytesWritten );
-                }
-
-                // =-=-=-=-=-=-=-
-                // then write the actual buffer
-                bytesWritten = myWrite(
-                                   destFd,
-                                   buf,
-                                   new_size,
-                                   &bytesWritten );
 
-                if ( bytesWritten != new_size ) {
-                    rodsLog( LOG_NOTICE,
-                             "_partialDataGet:Bytes written %d don't match read %d",
-                             bytesWritten, bytesRead );
-
-                    if ( bytesWritten < 0 ) {
-                        myInput->status = bytesWritten;
-                    }
-                    else {
-                        myInput->status = SYS_COPY_LEN_ERR;
+                    if ( bytesWritten != bytesRead ) {
+                        rodsLog( LOG_NOTICE,
+                                 "_partialDataGet:Bytes written %d don't match read %d",
+                                 bytesWritten, bytesRead );
+
+                        if ( bytesWritten < 0 ) {
+                            myInput->status = bytesWritten;
+                        }
+                        else {
+                            myInput->status = SYS_COPY_LEN_ERR;
+                        }
+                        break;
                     }
-                    break;
                 }
 
                 // =-=-=-=-=-=-=-
@@ -1070,11 +1026,23 @@ void partialDataGet(
                 break;
             }
         }       /* while loop toread0 */
+
+        // =-=-=-=-=-=-=-
+        // the next header must not overtake the last frame
+        if ( writer && myInput->status >= 0 ) {
+            irods::error ret = writer->flush();
+            if ( !ret.ok() ) {
+                irods::log( PASS( ret ) );
+                myInput->status = ret.code();
+            }
+        }
+
         if ( myInput->status < 0 ) {
             break;
         }
     }           /* while loop bytesToGet */
 
+    writer.reset();
     free( buf );
 
     applyRuleForSvrPortal( destFd, GET_OPR, 1, myOffset - myInput->offset, myInput->rsComm );
@@ -1140,7 +1108,7 @@ remToLocPartialCopy( portalTransferInp_t *myInput ) {
 
     int trans_buff_size;
     try {
-        trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS) * 1024 * 1024;
+        trans_buff_size = irods::get_server_config_snapshot()->advanced_settings.transfer_buffer_size_for_parallel_transfer_in_megabytes.get() * 1024 * 1024;
     } catch ( const irods::exception& e ) {
         irods::log(e);
         return;
@@ -1497,6 +1465,30 @@ int remLocCopy(rsComm_t *rsComm, dataCopyInp_t *dataCopyInp)
     return 0;
 } // remLocCopy
 
+namespace
+{
+    // Returns true if the data of both L3 descriptors can be copied by the kernel, i.e.
+    // both are plain files opened through a unixfilesystem resource on this host.
+    bool kernel_copy_is_possible( int _src_l3descInx, int _dest_l3descInx )
+    {
+        for ( const int l3descInx : { _src_l3descInx, _dest_l3descInx } ) {
+            const auto& desc = FileDesc[l3descInx];
+            if ( desc.inuseFlag != FD_INUSE || !desc.rescHier ||
+                 !desc.rodsServerHost || desc.rodsServerHost->localFlag != LOCAL_HOST ) {
+                return false;
+            }
+
+            std::string type;
+            if ( !irods::get_resc_type_for_hier_string( desc.rescHier, type ).ok() ||
+                 irods::RESOURCE_TYPE_NATIVE != type ) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+} // anonymous namespace
+
 int
 sameHostCopy( rsComm_t *rsComm, dataCopyInp_t *dataCopyInp ) {
     dataOprInp_t *dataOprInp;
@@ -1529,6 +1521,15 @@ sameHostCopy( rsComm_t *rsComm, dataCopyInp_t *dataCopyInp ) {
         return SYS_INVALID_PORTAL_OPR;
     }
 
+    const bool kernel_copy = kernel_copy_is_possible( dataOprInp->srcL3descInx, dataOprInp->destL3descInx );
+
+    // Within a filesystem the kernel copies (or clones) faster than the threads could,
+    // and a clone requires the whole file to be copied at once.
+    if ( kernel_copy && irods::experimental::local_file_copy::same_filesystem(
+            FileDesc[dataOprInp->srcL3descInx].fd, FileDesc[dataOprInp->destL3descInx].fd ) ) {
+        numThreads = 1;
+    }
+
     memset( myInput, 0, sizeof( myInput ) );
 
     size0 = dataOprInp->dataSize / numThreads;
@@ -1544,10 +1545,14 @@ sameHostCopy( rsComm_t *rsComm, dataCopyInp_t *dataCopyInp ) {
                            dataOprInp->srcRescTypeInx, dataOprInp->destRescTypeInx,
                            0, size0, offset0, 0 );
 
+    if ( kernel_copy ) {
+        myInput[0].flags |= KERNEL_COPY_FLAG;
+    }
+
     if ( numThreads == 1 ) {
         if ( getValByKey( &dataOprInp->condInput,
                           NO_CHK_COPY_LEN_KW ) != NULL ) {
-            myInput[0].flags = NO_CHK_COPY_LEN_FLAG;
+            myInput[0].flags |= NO_CHK_COPY_LEN_FLAG;
         }
         sameHostPartialCopy( &myInput[0] );
         return myInput[0].status;
@@ -1592,6 +1597,10 @@ sameHostCopy( rsComm_t *rsComm, dataCopyInp_t *dataCopyInp ) {
                 dataOprInp->destRescTypeInx,
                 i, mySize, myOffset, 0 );
 
+            if ( kernel_copy ) {
+                myInput[i].flags |= KERNEL_COPY_FLAG;
+            }
+
             tid[i] = std::make_unique<boost::scoped_thread<>>( boost::thread( sameHostPartialCopy, &myInput[i] ) );
         }
 
@@ -1675,9 +1684,22 @@ sameHostPartialCopy( portalTransferInp_t *myInput ) {
         }
     }
 
+    toCopy = myInput->size;
+
+    if ( myInput->flags & KERNEL_COPY_FLAG ) {
+        const rodsLong_t copied = irods::experimental::local_file_copy::copy(
+            FileDesc[srcL3descInx].fd, FileDesc[destL3descInx].fd, toCopy );
+
+        if ( copied > 0 ) {
+            FileDesc[destL3descInx].writtenFlag = 1;
+            toCopy -= copied;
+            myInput->bytesWritten += copied;
+        }
+    }
+
     int trans_buff_size;
     try {
-        trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS) * 1024 * 1024;
+        trans_buff_size = irods::get_server_config_snapshot()->advanced_settings.transfer_buffer_size_for_parallel_transfer_in_megabytes.get() * 1024 * 1024;
     } catch ( const irods::exception& e ) {
         irods::log(e);
         return;
@@ -1685,8 +1707,6 @@ sameHostPartialCopy( portalTransferInp_t *myInput ) {
 
     buf = malloc( trans_buff_size );
 
-    toCopy = myInput->size;
-
     while ( toCopy > 0 ) {
         int toRead;
 
@@ -1793,7 +1813,7 @@ void locToRemPartialCopy(portalTransferInp_t *myInput)
 
     int trans_buff_size;
     try {
-        trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS) * 1024 * 1024;
+        trans_buff_size = irods::get_server_config_snapshot()->advanced_settings.transfer_buffer_size_for_parallel_transfer_in_megabytes.get() * 1024 * 1024;
     } catch ( const irods::exception& e ) {
         irods::log(e);
         return;
@@ -2157,6 +2177,9 @@ svrPortalPutGetRbudp( rsComm_t *rsComm ) {
                 ( sendRate = atoi( tmpStr ) ) < 1 ) {
             sendRate = DEF_UDP_SEND_RATE;
         }
+        if ( ( tmpStr = getValByKey( &myPortalOpr->dataOprInp.condInput, RBUDP_NUM_STREAMS_KW ) ) != NULL ) {
+            rbudpSender.numStreams = atoi( tmpStr );
+        }
 
         status = sendfileByFd(
                      &rbudpSender,
@@ -2534,7 +2557,7 @@ singleRemToLocCopy( rsComm_t *rsComm, dataCopyInp_t *dataCopyInp ) {
 
     int trans_buff_size;
     try {
-        trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS) * 1024 * 1024;
+        trans_buff_size = irods::get_server_config_snapshot()->advanced_settings.transfer_buffer_size_for_parallel_transfer_in_megabytes.get() * 1024 * 1024;
     } catch ( const irods::exception& e ) {
         irods::log(e);
         return e.code();
@@ -2598,7 +2621,7 @@ singleLocToRemCopy( rsComm_t *rsComm, dataCopyInp_t *dataCopyInp ) {
 
     int trans_buff_size;
     try {
-        trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS) * 1024 * 1024;
+        trans_buff_size = irods::get_server_config_snapshot()->advanced_settings.transfer_buffer_size_for_parallel_transfer_in_megabytes.get() * 1024 * 1024;
     } catch ( const irods::exception& e ) {
         irods::log(e);
         return e.code();
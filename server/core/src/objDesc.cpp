@@ -567,6 +567,11 @@ initDataOprInp( dataOprInp_t *dataOprInp, int l1descInx, int oprType ) {
         addKeyVal( &dataOprInp->condInput, RBUDP_PACK_SIZE_KW, tmpStr );
     }
 
+    if ( ( tmpStr = getValByKey( &dataObjInp->condInput, RBUDP_NUM_STREAMS_KW ) ) !=
+            NULL ) {
+        addKeyVal( &dataOprInp->condInput, RBUDP_NUM_STREAMS_KW, tmpStr );
+    }
+
     return 0;
 }
 
@@ -0,0 +1,145 @@
+#include "pam_auth_helper.hpp"
+
+#include "rodsErrorTable.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    // Relative to the server's working directory, as with the fork/exec fallback.
+    constexpr const char* PAM_AUTH_CHECK_PROG = "./irodsPamAuthCheck";
+
+    // The status codes sent by the helper.
+    constexpr std::uint32_t STATUS_AUTHENTICATED = 0;
+    constexpr std::uint32_t STATUS_NOT_AUTHENTICATED = 1;
+
+    // A PAM conversation may wait on a remote directory service, but an agent must
+    // not hang on a helper that stopped responding.
+    constexpr int TIMEOUT_IN_SECONDS = 30;
+
+    auto write_all(int _fd, const void* _buf, std::size_t _len) -> bool
+    {
+        const auto* ptr = static_cast<const char*>(_buf);
+        while (_len > 0) {
+            const auto n = send(_fd, ptr, _len, MSG_NOSIGNAL);
+            if (n <= 0) {
+                return false;
+            }
+            ptr += n;
+            _len -= n;
+        }
+        return true;
+    }
+
+    auto read_all(int _fd, void* _buf, std::size_t _len) -> bool
+    {
+        auto* ptr = static_cast<char*>(_buf);
+        while (_len > 0) {
+            const auto n = read(_fd, ptr, _len);
+            if (n <= 0) {
+                return false;
+            }
+            ptr += n;
+            _len -= n;
+        }
+        return true;
+    }
+
+    auto write_field(int _fd, const std::string& _field) -> bool
+    {
+        const std::uint32_t length = htonl(static_cast<std::uint32_t>(_field.size()));
+        return write_all(_fd, &length, sizeof(length)) && write_all(_fd, _field.data(), _field.size());
+    }
+} // anonymous namespace
+
+namespace irods::experimental::pam_auth_helper
+{
+    auto launch(const std::string_view _socket_path, int _worker_count) -> pid_t
+    {
+        const std::string socket_path{_socket_path};
+        const std::string worker_count = std::to_string(_worker_count);
+
+        const pid_t pid = fork();
+
+        if (pid == 0) {
+            execl(PAM_AUTH_CHECK_PROG, PAM_AUTH_CHECK_PROG, "--daemon", socket_path.c_str(), worker_count.c_str(), nullptr);
+            _exit(1);
+        }
+
+        return pid;
+    } // launch
+
+    auto authenticate(const std::string& _username, const std::string& _password) -> int
+    {
+        const char* socket_path = std::getenv(SOCKET_PATH_ENV_VAR);
+
+        if (!socket_path) {
+            return SYS_SOCK_CONNECT_ERR;
+        }
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+
+        if (std::strlen(socket_path) >= sizeof(addr.sun_path)) {
+            return SYS_SOCK_CONNECT_ERR;
+        }
+
+        std::strncpy(addr.sun_path, socket_path, sizeof(addr.sun_path) - 1);
+
+        const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+        if (fd < 0) {
+            return SYS_SOCK_OPEN_ERR;
+        }
+
+        struct close_on_exit
+        {
+            int fd;
+            ~close_on_exit() { close(fd); }
+        } closer{fd};
+
+        if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            return SYS_SOCK_CONNECT_ERR;
+        }
+
+        // Passwords are only handed to the setuid helper or to a helper run by the
+        // service account itself (e.g. when irodsPamAuthCheck is not setuid).
+        ucred cred{};
+        socklen_t cred_len = sizeof(cred);
+
+        if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &cred_len) < 0 ||
+            (cred.uid != 0 && cred.uid != getuid()))
+        {
+            return SYS_SOCK_CONNECT_ERR;
+        }
+
+        timeval timeout{};
+        timeout.tv_sec = TIMEOUT_IN_SECONDS;
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+        if (!write_field(fd, _username) || !write_field(fd, _password)) {
+            return SYS_SOCK_WRITE_ERR;
+        }
+
+        std::uint32_t status{};
+
+        if (!read_all(fd, &status, sizeof(status))) {
+            return SYS_SOCK_READ_ERR;
+        }
+
+        switch (ntohl(status)) {
+            case STATUS_AUTHENTICATED:     return 0;
+            case STATUS_NOT_AUTHENTICATED: return PAM_AUTH_PASSWORD_FAILED;
+            default:                       return SYS_INTERNAL_ERR;
+        }
+    } // authenticate
+} // namespace irods::experimental::pam_auth_helper
@@ -15,6 +15,7 @@
 #include "rodsDef.h"
 #include "rodsDef.h"
 #include "rodsPath.h"
+#include "finalize_utilities.hpp"
 #include "rsCollCreate.hpp"
 #include "rsDataObjClose.hpp"
 #include "rsFileChksum.hpp"
@@ -547,6 +548,17 @@ int _dataObjChksum(rsComm_t* rsComm, dataObjInfo_t* dataObjInfo, char** chksumSt
         rstrcpy(fileChksumInp.orig_chksum, orig_chksum, CHKSUM_LEN);
     }
 
+    // Use the checksum computed while the replica was written, if any, instead of reading it back.
+    if (const auto checksum = irods::find_inline_checksum(*dataObjInfo); checksum) {
+        if (!*chksumStr) {
+            *chksumStr = static_cast<char*>(malloc(NAME_LEN));
+        }
+
+        rstrcpy(*chksumStr, checksum->c_str(), NAME_LEN);
+
+        return 0;
+    }
+
     rodsLog(LOG_DEBUG, "[%s:%d] - performing checksum for [%s] on [%s] at location [%s]",
             __FUNCTION__, __LINE__, dataObjInfo->objPath, dataObjInfo->rescHier, dataObjInfo->filePath);
 
@@ -3,12 +3,10 @@
 #include "rsGlobalExtern.hpp"
 #include "rodsConnect.h"
 #include "rsLog.hpp"
+#include "agent_registry.hpp"
 
 #include "arpa/inet.h"
 
-#include <fstream>
-#include <boost/lexical_cast.hpp>
-
 int
 initAndClearProcLog() {
     initProcLog();
@@ -31,8 +29,8 @@ initProcLog() {
 
 int
 logAgentProc( rsComm_t *rsComm ) {
-    FILE *fptr;
-    char procPath[MAX_NAME_LEN];
+    namespace ar = irods::experimental::agent_registry;
+
     char *remoteAddr;
     char *progName;
     char *clientZone, *proxyZone;
@@ -75,33 +73,30 @@ logAgentProc( rsComm_t *rsComm ) {
         progName = rsComm->option;
     }
 
-    snprintf( procPath, MAX_NAME_LEN, "%s/%-d", ProcLogDir, getpid() );
-
-    fptr = fopen( procPath, "w" );
+    // The names are stored in the same order as the per-PID files used to be written,
+    // so ips continues to display them the same way.
+    ar::agent_info info{};
+    rstrcpy( info.client_name, rsComm->proxyUser.userName, NAME_LEN );
+    rstrcpy( info.client_zone, clientZone, NAME_LEN );
+    rstrcpy( info.proxy_name, rsComm->clientUser.userName, NAME_LEN );
+    rstrcpy( info.proxy_zone, proxyZone, NAME_LEN );
+    rstrcpy( info.program_name, progName, NAME_LEN );
+    rstrcpy( info.remote_address, remoteAddr, NAME_LEN );
 
-    if ( fptr == NULL ) {
+    if ( !ar::register_agent( info ) ) {
         rodsLog( LOG_ERROR,
-                 "logAgentProc: Cannot open input file %s. errno = %d",
-                 procPath, errno );
-        return UNIX_FILE_OPEN_ERR - errno;
+                 "logAgentProc: Cannot register agent %d. The agent registry is full or not initialized.",
+                 getpid() );
+        return SYS_MAX_CONNECT_COUNT_EXCEEDED;
     }
 
-    fprintf( fptr, "%s %s %s %s %s %s %u\n",
-             rsComm->proxyUser.userName, clientZone,
-             rsComm->clientUser.userName, proxyZone,
-             progName, remoteAddr, ( unsigned int ) time( 0 ) );
-
     rsComm->procLogFlag = PROC_LOG_DONE;
-    fclose( fptr );
     return 0;
 }
 
 int
 rmProcLog( int pid ) {
-    char procPath[MAX_NAME_LEN];
-
-    snprintf( procPath, MAX_NAME_LEN, "%s/%-d", ProcLogDir, pid );
-    unlink( procPath );
+    irods::experimental::agent_registry::unregister_agent( pid );
     return 0;
 }
 
@@ -112,39 +107,21 @@ readProcLog( int pid, procLog_t *procLog ) {
         return USER__NULL_INPUT_ERR;
     }
 
-    char procPath[MAX_NAME_LEN];
-    snprintf( procPath, MAX_NAME_LEN, "%s/%-d", ProcLogDir, pid );
+    const auto info = irods::experimental::agent_registry::lookup( pid );
 
-    std::fstream procStream( procPath, std::ios::in );
-    std::vector<std::string> procTokens;
-    while ( !procStream.eof() && procTokens.size() < 7 ) {
-        std::string token;
-        procStream >> token;
-        procTokens.push_back( token );
-    }
-
-    if ( procTokens.size() != 7 ) {
-        rodsLog( LOG_ERROR,
-                 "readProcLog: error fscanf file %s. Number of param read = %d",
-                 procPath, procTokens.size() );
-        return UNIX_FILE_READ_ERR;
+    if ( !info ) {
+        return KEY_NOT_FOUND;
     }
 
     procLog->pid = pid;
-
-    snprintf( procLog->clientName, sizeof( procLog->clientName ), "%s", procTokens[0].c_str() );
-    snprintf( procLog->clientZone, sizeof( procLog->clientZone ), "%s", procTokens[1].c_str() );
-    snprintf( procLog->proxyName, sizeof( procLog->proxyName ), "%s", procTokens[2].c_str() );
-    snprintf( procLog->proxyZone, sizeof( procLog->proxyZone ), "%s", procTokens[3].c_str() );
-    snprintf( procLog->progName, sizeof( procLog->progName ), "%s", procTokens[4].c_str() );
-    snprintf( procLog->remoteAddr, sizeof( procLog->remoteAddr ), "%s", procTokens[5].c_str() );
-    try {
-        procLog->startTime = boost::lexical_cast<unsigned int>( procTokens[6].c_str() );
-    }
-    catch ( ... ) {
-        rodsLog( LOG_ERROR, "Could not convert %s to unsigned int.", procTokens[6].c_str() );
-        return INVALID_LEXICAL_CAST;
-    }
+    procLog->startTime = static_cast<unsigned int>( info->start_time );
+
+    rstrcpy( procLog->clientName, info->client_name, sizeof( procLog->clientName ) );
+    rstrcpy( procLog->clientZone, info->client_zone, sizeof( procLog->clientZone ) );
+    rstrcpy( procLog->proxyName, info->proxy_name, sizeof( procLog->proxyName ) );
+    rstrcpy( procLog->proxyZone, info->proxy_zone, sizeof( procLog->proxyZone ) );
+    rstrcpy( procLog->progName, info->program_name, sizeof( procLog->progName ) );
+    rstrcpy( procLog->remoteAddr, info->remote_address, sizeof( procLog->remoteAddr ) );
 
     return 0;
 }
@@ -0,0 +1,425 @@
+#include "resource_hierarchy_cache.hpp"
+
+#include "irods_hierarchy_parser.hpp"
+#include "rodsLog.h"
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/sync/named_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace
+{
+    namespace bi = boost::interprocess;
+    namespace rhc = irods::experimental::resource_hierarchy_cache;
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+    static_assert(std::atomic<std::int64_t>::is_always_lock_free);
+
+    // The published snapshot is stored after the header in serialized form. It is only
+    // written while the generation is odd, so readers copy it and retry if the generation
+    // changed. Writers are serialized by a named mutex.
+    struct header
+    {
+        std::atomic<std::uint64_t> generation;
+        std::atomic<std::uint64_t> invalidations;
+        std::atomic<std::int64_t> verified_at;
+        std::uint64_t built_at_invalidation;
+        std::int64_t catalog_version;
+        std::size_t payload_size;  // Zero if no snapshot has been published.
+        std::size_t capacity;
+    }; // struct header
+
+    //
+    // Global Variables
+    //
+
+    std::string g_shm_name;
+    std::string g_mutex_name;
+
+    // On initialization, holds the PID of the process that initialized the cache.
+    // This ensures that only the process that initialized the system can deinitialize it.
+    pid_t g_owner_pid;
+
+    std::unique_ptr<bi::shared_memory_object> g_shm;
+    std::unique_ptr<bi::mapped_region> g_region;
+    std::unique_ptr<bi::named_mutex> g_mutex;
+    header* g_header;
+
+    auto now_in_seconds() noexcept -> std::int64_t
+    {
+        using namespace std::chrono;
+        return duration_cast<seconds>(system_clock::now().time_since_epoch()).count();
+    }
+
+    auto payload() noexcept -> char*
+    {
+        return reinterpret_cast<char*>(g_header + 1);
+    }
+
+    auto append(std::string& _out, std::int64_t _value) -> void
+    {
+        _out.append(reinterpret_cast<const char*>(&_value), sizeof(_value));
+    }
+
+    auto append(std::string& _out, const std::string& _value) -> void
+    {
+        append(_out, static_cast<std::int64_t>(_value.size()));
+        _out.append(_value);
+    }
+
+    // Reads values in the order they were appended. Throws if the input is truncated.
+    class reader
+    {
+    public:
+        explicit reader(std::string_view _in)
+            : in_{_in}
+        {
+        }
+
+        auto read(std::int64_t& _value) -> void
+        {
+            take(&_value, sizeof(_value));
+        }
+
+        auto read(std::string& _value) -> void
+        {
+            std::int64_t size = 0;
+            read(size);
+
+            if (size < 0 || static_cast<std::size_t>(size) > in_.size()) {
+                throw std::runtime_error{"resource_hierarchy_cache: truncated snapshot"};
+            }
+
+            _value.assign(in_.data(), size);
+            in_.remove_prefix(size);
+        }
+
+    private:
+        auto take(void* _dst, std::size_t _size) -> void
+        {
+            if (_size > in_.size()) {
+                throw std::runtime_error{"resource_hierarchy_cache: truncated snapshot"};
+            }
+
+            std::memcpy(_dst, in_.data(), _size);
+            in_.remove_prefix(_size);
+        }
+
+        std::string_view in_;
+    }; // class reader
+
+    // Visits the string members of a resource_info in serialization order.
+    template <typename ResourceInfo, typename Function>
+    auto for_each_field(ResourceInfo& _info, Function _func) -> void
+    {
+        _func(_info.name);
+        _func(_info.zone);
+        _func(_info.type);
+        _func(_info.class_name);
+        _func(_info.location);
+        _func(_info.vault_path);
+        _func(_info.free_space);
+        _func(_info.info);
+        _func(_info.comments);
+        _func(_info.create_time);
+        _func(_info.modify_time);
+        _func(_info.status);
+        _func(_info.children);
+        _func(_info.context);
+        _func(_info.parent);
+        _func(_info.parent_context);
+    } // for_each_field
+} // anonymous namespace
+
+namespace irods::experimental::resource_hierarchy_cache
+{
+    snapshot::snapshot(std::int64_t _catalog_version, std::vector<resource_info> _resources)
+        : catalog_version_{_catalog_version}
+        , resources_(std::move(_resources))
+        , parents_(resources_.size(), -1)
+        , paths_{}
+        , hierarchies_{}
+        , by_name_{}
+        , by_id_{}
+    {
+        for (int i = 0; i < static_cast<int>(resources_.size()); ++i) {
+            by_id_.emplace(resources_[i].id, i);
+        }
+
+        for (std::size_t i = 0; i < resources_.size(); ++i) {
+            if (const auto& parent = resources_[i].parent; !parent.empty()) {
+                try {
+                    if (const auto iter = by_id_.find(std::stoll(parent)); iter != std::end(by_id_)) {
+                        parents_[i] = iter->second;
+                    }
+                }
+                catch (const std::exception&) {
+                    rodsLog(LOG_ERROR, "resource_hierarchy_cache: invalid parent [%s] for resource [%s]",
+                            parent.c_str(), resources_[i].name.c_str());
+                }
+            }
+        }
+
+        hierarchies_.reserve(resources_.size());
+
+        for (std::size_t i = 0; i < resources_.size(); ++i) {
+            irods::hierarchy_parser parser{resources_[i].name};
+
+            // A cycle cannot occur in a valid catalog, but must not hang the agent.
+            std::size_t depth = 0;
+            for (int p = parents_[i]; p > -1 && depth < resources_.size(); p = parents_[p], ++depth) {
+                parser.add_parent(resources_[p].name);
+            }
+
+            hierarchies_.push_back(parser.str());
+        }
+
+        index_resources();
+    } // snapshot::snapshot
+
+    snapshot::snapshot(std::int64_t _catalog_version,
+                       std::vector<resource_info> _resources,
+                       std::vector<int> _parents,
+                       std::vector<std::string> _hierarchies)
+        : catalog_version_{_catalog_version}
+        , resources_(std::move(_resources))
+        , parents_(std::move(_parents))
+        , paths_{}
+        , hierarchies_(std::move(_hierarchies))
+        , by_name_{}
+        , by_id_{}
+    {
+        for (int i = 0; i < static_cast<int>(resources_.size()); ++i) {
+            by_id_.emplace(resources_[i].id, i);
+        }
+
+        index_resources();
+    } // snapshot::snapshot
+
+    auto snapshot::index_resources() -> void
+    {
+        paths_.resize(resources_.size());
+
+        for (int i = 0; i < static_cast<int>(resources_.size()); ++i) {
+            by_name_.emplace(resources_[i].name, i);
+
+            auto& path = paths_[i];
+            for (int p = i; p > -1 && path.size() <= resources_.size(); p = parents_[p]) {
+                path.push_back(p);
+            }
+        }
+    } // snapshot::index_resources
+
+    auto snapshot::index_of(std::string_view _name) const -> int
+    {
+        const auto iter = by_name_.find(_name);
+        return (iter != std::end(by_name_)) ? iter->second : -1;
+    } // snapshot::index_of
+
+    auto snapshot::index_of(rodsLong_t _id) const -> int
+    {
+        const auto iter = by_id_.find(_id);
+        return (iter != std::end(by_id_)) ? iter->second : -1;
+    } // snapshot::index_of
+
+    auto init(const std::string_view _shm_name, std::size_t _shm_size) -> void
+    {
+        if (getpid() == g_owner_pid) {
+            return;
+        }
+
+        g_shm_name = _shm_name.data();
+        g_mutex_name = g_shm_name + "_mutex";
+
+        bi::named_mutex::remove(g_mutex_name.data());
+        bi::shared_memory_object::remove(g_shm_name.data());
+
+        g_owner_pid = getpid();
+        g_shm = std::make_unique<bi::shared_memory_object>(bi::create_only, g_shm_name.data(), bi::read_write);
+        g_shm->truncate(std::max(_shm_size, sizeof(header)));
+        g_region = std::make_unique<bi::mapped_region>(*g_shm, bi::read_write);
+        g_mutex = std::make_unique<bi::named_mutex>(bi::create_only, g_mutex_name.data());
+
+        // New shared memory is zero-filled, which is what an empty cache looks like.
+        g_header = static_cast<header*>(g_region->get_address());
+        g_header->capacity = g_region->get_size() - sizeof(header);
+    } // init
+
+    auto deinit() noexcept -> void
+    {
+        if (getpid() != g_owner_pid) {
+            return;
+        }
+
+        try {
+            g_owner_pid = 0;
+            g_header = nullptr;
+            g_mutex.reset();
+            g_region.reset();
+            g_shm.reset();
+
+            bi::named_mutex::remove(g_mutex_name.data());
+            bi::shared_memory_object::remove(g_shm_name.data());
+        }
+        catch (...) {}
+    } // deinit
+
+    auto load() -> std::shared_ptr<const snapshot>
+    {
+        if (!g_header) {
+            return nullptr;
+        }
+
+        std::string bytes;
+        std::int64_t catalog_version = 0;
+
+        while (true) {
+            const auto generation = g_header->generation.load(std::memory_order_acquire);
+
+            if (generation % 2 != 0) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            const auto size = g_header->payload_size;
+            const auto stale = g_header->built_at_invalidation != g_header->invalidations.load(std::memory_order_acquire);
+            catalog_version = g_header->catalog_version;
+
+            if (size > 0 && !stale && size <= g_header->capacity) {
+                bytes.assign(payload(), size);
+            }
+            else {
+                bytes.clear();
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (g_header->generation.load(std::memory_order_relaxed) == generation) {
+                break;
+            }
+        }
+
+        if (bytes.empty()) {
+            return nullptr;
+        }
+
+        try {
+            reader in{bytes};
+
+            std::int64_t count = 0;
+            in.read(count);
+
+            std::vector<resource_info> resources(count);
+            std::vector<int> parents(count);
+            std::vector<std::string> hierarchies(count);
+
+            for (std::int64_t i = 0; i < count; ++i) {
+                std::int64_t value = 0;
+
+                in.read(value);
+                resources[i].id = value;
+
+                in.read(value);
+                parents[i] = (value >= 0 && value < count) ? static_cast<int>(value) : -1;
+
+                for_each_field(resources[i], [&in](std::string& _field) { in.read(_field); });
+
+                in.read(hierarchies[i]);
+            }
+
+            return std::shared_ptr<const snapshot>{
+                new snapshot{catalog_version, std::move(resources), std::move(parents), std::move(hierarchies)}};
+        }
+        catch (const std::exception& e) {
+            rodsLog(LOG_ERROR, "%s", e.what());
+            return nullptr;
+        }
+    } // load
+
+    auto invalidation_count() noexcept -> std::uint64_t
+    {
+        return g_header ? g_header->invalidations.load(std::memory_order_acquire) : 0;
+    } // invalidation_count
+
+    auto publish(const snapshot& _snapshot, std::uint64_t _invalidation_count) -> bool
+    {
+        if (!g_header) {
+            return false;
+        }
+
+        std::string bytes;
+        append(bytes, static_cast<std::int64_t>(_snapshot.resources_.size()));
+
+        for (std::size_t i = 0; i < _snapshot.resources_.size(); ++i) {
+            const auto& info = _snapshot.resources_[i];
+
+            append(bytes, static_cast<std::int64_t>(info.id));
+            append(bytes, static_cast<std::int64_t>(_snapshot.parents_[i]));
+            for_each_field(info, [&bytes](const std::string& _field) { append(bytes, _field); });
+            append(bytes, _snapshot.hierarchies_[i]);
+        }
+
+        bi::scoped_lock lock{*g_mutex};
+
+        if (g_header->invalidations.load(std::memory_order_acquire) != _invalidation_count) {
+            return false;
+        }
+
+        if (bytes.size() > g_header->capacity) {
+            rodsLog(LOG_WARNING,
+                    "resource_hierarchy_cache: snapshot of %zu bytes does not fit into %zu bytes of shared memory.",
+                    bytes.size(), g_header->capacity);
+            return false;
+        }
+
+        g_header->generation.fetch_add(1, std::memory_order_acq_rel);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        std::memcpy(payload(), bytes.data(), bytes.size());
+        g_header->payload_size = bytes.size();
+        g_header->catalog_version = _snapshot.catalog_version_;
+        g_header->built_at_invalidation = _invalidation_count;
+        g_header->verified_at.store(now_in_seconds(), std::memory_order_relaxed);
+
+        g_header->generation.fetch_add(1, std::memory_order_release);
+
+        return true;
+    } // publish
+
+    auto invalidate() noexcept -> void
+    {
+        if (g_header) {
+            g_header->invalidations.fetch_add(1, std::memory_order_acq_rel);
+        }
+    } // invalidate
+
+    auto seconds_since_verification() noexcept -> std::int64_t
+    {
+        return g_header ? now_in_seconds() - g_header->verified_at.load(std::memory_order_relaxed) : 0;
+    } // seconds_since_verification
+
+    auto mark_verified(std::int64_t _catalog_version) -> void
+    {
+        if (!g_header) {
+            return;
+        }
+
+        bi::scoped_lock lock{*g_mutex};
+
+        if (g_header->payload_size > 0 && g_header->catalog_version == _catalog_version) {
+            g_header->verified_at.store(now_in_seconds(), std::memory_order_relaxed);
+        }
+    } // mark_verified
+} // namespace irods::experimental::resource_hierarchy_cache
@@ -28,6 +28,12 @@
 #include "dns_cache.hpp"
 #include "server_utilities.hpp"
 #include "process_manager.hpp"
+#include "server_load_table.hpp"
+#include "agent_registry.hpp"
+#include "resource_hierarchy_cache.hpp"
+#include "access_verdict_cache.hpp"
+#include "server_load_publisher.hpp"
+#include "pam_auth_helper.hpp"
 
 #include <pthread.h>
 #include <sys/socket.h>
@@ -69,6 +75,9 @@ const char socket_dir_template[]{"/tmp/irods_sockets_XXXXXX"};
 char agent_factory_socket_dir[sizeof(socket_dir_template)]{};
 char agent_factory_socket_file[sizeof(local_addr.sun_path)]{};
 
+pid_t pam_auth_helper_pid{};
+char pam_auth_helper_socket_file[sizeof(local_addr.sun_path)]{};
+
 uint ServerBootTime;
 int SvrSock;
 
@@ -346,6 +355,18 @@ int main(int argc, char** argv)
     ix::replica_access_table::init();
     irods::at_scope_exit deinit_replica_access_table{[] { ix::replica_access_table::deinit(); }};
 
+    ix::server_load_table::init("irods_server_load_table", irods::get_server_load_table_shared_memory_size());
+    irods::at_scope_exit deinit_server_load_table{[] { ix::server_load_table::deinit(); }};
+
+    ix::agent_registry::init();
+    irods::at_scope_exit deinit_agent_registry{[] { ix::agent_registry::deinit(); }};
+
+    ix::resource_hierarchy_cache::init("irods_resource_hierarchy_cache", irods::get_resource_hierarchy_cache_shared_memory_size());
+    irods::at_scope_exit deinit_resource_hierarchy_cache{[] { ix::resource_hierarchy_cache::deinit(); }};
+
+    ix::access_verdict_cache::init("irods_access_verdict_cache", irods::get_access_verdict_cache_shared_memory_size());
+    irods::at_scope_exit deinit_access_verdict_cache{[] { ix::access_verdict_cache::deinit(); }};
+
     remove_leftover_rulebase_pid_files();
 
     irods::parse_and_store_hosts_configuration_file_as_json();
@@ -395,6 +416,37 @@ int main(int argc, char** argv)
     snprintf(agent_factory_socket_file, sizeof(agent_factory_socket_file), "%s/irods_factory_%s", agent_factory_socket_dir, random_suffix);
     snprintf(local_addr.sun_path, sizeof(local_addr.sun_path), "%s", agent_factory_socket_file);
 
+    // Start the persistent PAM authentication helper before the agent factory so that the
+    // agents inherit the location of its socket. Only the provider performs PAM checks.
+    if (const auto pam_workers = irods::get_pam_auth_helper_worker_count(); pam_workers > 0) {
+        std::string svc_role;
+        if (const auto ret = get_catalog_service_role(svc_role); ret.ok() && irods::CFG_SERVICE_ROLE_PROVIDER == svc_role) {
+            snprintf(pam_auth_helper_socket_file, sizeof(pam_auth_helper_socket_file), "%s/irods_pam_auth_helper", agent_factory_socket_dir);
+            setenv(ix::pam_auth_helper::SOCKET_PATH_ENV_VAR, pam_auth_helper_socket_file, 1);
+
+            ix::cron::cron_builder pam_auth_helper_watcher;
+            const auto start_pam_auth_helper = [pam_workers](std::any& _) {
+                if (pam_auth_helper_pid > 0 && waitpid(pam_auth_helper_pid, nullptr, WNOHANG) == 0) {
+                    return;
+                }
+
+                ix::log::server::info("Starting PAM authentication helper");
+                pam_auth_helper_pid = ix::pam_auth_helper::launch(pam_auth_helper_socket_file, pam_workers);
+                if (pam_auth_helper_pid < 0) {
+                    rodsLog(LOG_ERROR, "Error starting PAM authentication helper, errno = [%d]: %s", errno, strerror(errno));
+                }
+            };
+
+            std::any dummy;
+            start_pam_auth_helper(dummy);
+            pam_auth_helper_watcher.to_execute(start_pam_auth_helper).interval(5);
+            ix::cron::cron::get()->add_task(pam_auth_helper_watcher.build());
+        }
+        else if (!ret.ok()) {
+            irods::log(PASS(ret));
+        }
+    }
+
     ix::cron::cron_builder agent_watcher;
     const auto start_agent_server = [&](std::any& _) {
         int status;
@@ -560,6 +612,10 @@ int serverMain(
         irods::server_control_plane ctrl_plane(
             irods::CFG_SERVER_CONTROL_PLANE_PORT );
 
+        // =-=-=-=-=-=-=-
+        // Launch the publisher of live load samples for load_balanced
+        irods::server_load_publisher load_publisher;
+
         status = startProcConnReqThreads();
         if(status < 0) {
             rodsLog(LOG_ERROR, "[%s] - Error in startProcConnReqThreads()", __FUNCTION__);
@@ -587,6 +643,10 @@ int serverMain(
                 // Wake up the agent factory process so it can clean up and exit
                 kill( agent_spawning_pid, SIGTERM );
 
+                if ( pam_auth_helper_pid > 0 ) {
+                    kill( pam_auth_helper_pid, SIGTERM );
+                }
+
                 rodsLog( LOG_NOTICE, "iRODS Server is exiting with state [%s].", the_server_state.c_str() );
 
                 break;
@@ -709,6 +769,7 @@ int serverMain(
 
     close( agent_conn_socket );
     unlink( agent_factory_socket_file );
+    unlink( pam_auth_helper_socket_file );
     rmdir( agent_factory_socket_dir );
 
     ix::log::server::info("iRODS Server is done.");
@@ -731,11 +792,16 @@ serverExit()
 
     close( agent_conn_socket );
     unlink( agent_factory_socket_file );
+    unlink( pam_auth_helper_socket_file );
     rmdir( agent_factory_socket_dir );
 
     // Wake and terminate agent spawning process
     kill( agent_spawning_pid, SIGTERM );
 
+    if ( pam_auth_helper_pid > 0 ) {
+        kill( pam_auth_helper_pid, SIGTERM );
+    }
+
     exit( 1 );
 }
 
@@ -1142,15 +1208,11 @@ chkConnectedAgentProcQue() {
     tmpAgentProc = ConnectedAgentHead;
 
     while ( tmpAgentProc != NULL ) {
-        char procPath[MAX_NAME_LEN];
-
-        snprintf( procPath, MAX_NAME_LEN, "%s/%-d", ProcLogDir, tmpAgentProc->pid );
-        path p( procPath );
-        if ( !exists( p ) ) {
+        if ( !ix::agent_registry::lookup( tmpAgentProc->pid ) ) {
             /* the agent proc is gone */
             unmatchedAgentProc = tmpAgentProc;
             rodsLog( LOG_DEBUG,
-                     "Agent process %d in Connected queue but not in ProcLogDir",
+                     "Agent process %d in Connected queue but not in agent registry",
                      tmpAgentProc->pid );
             if ( prevAgentProc == NULL ) {
                 ConnectedAgentHead = tmpAgentProc->next;
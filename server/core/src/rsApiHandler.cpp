@@ -14,6 +14,9 @@
 #include "api_plugin_number.h"
 #include "client_api_whitelist.hpp"
 #include "key_value_proxy.hpp"
+#include "inline_checksum_table.hpp"
+#include "agent_registry.hpp"
+#include "irods_at_scope_exit.hpp"
 
 #include <boost/thread.hpp>
 #include <boost/thread/mutex.hpp>
@@ -191,6 +194,10 @@ int rsApiHandler(rsComm_t*   rsComm,
         numArg++;
     };
 
+    // publish the call in the agent registry so ips and the control plane can see it
+    irods::experimental::agent_registry::begin_api( apiNumber );
+    irods::at_scope_exit end_api{[] { irods::experimental::agent_registry::end_api(); }};
+
     int retVal = 0;
     if ( numArg == 0 ) {
         retVal = api_entry->call_wrapper(
@@ -228,6 +235,9 @@ int rsApiHandler(rsComm_t*   rsComm,
                      myArgv[3]);
     }
 
+    // checksums computed inline are only used by the request that wrote the data
+    irods::experimental::inline_checksum_table::erase_released_entries();
+
     if ( retVal != SYS_NO_HANDLER_REPLY_MSG ) {
         status = sendAndProcApiReply
                  ( rsComm, apiInx, retVal, myOutStruct, &myOutBsBBuf );
@@ -0,0 +1,323 @@
+#include "server_load_publisher.hpp"
+
+#include "client_connection.hpp"
+#include "rodsConnect.h"
+#include "rodsServer.hpp"
+#include "sockComm.h"
+#include "irods_query.hpp"
+#include "irods_log.hpp"
+#include "irods_resource_manager.hpp"
+#include "irods_server_control_plane.hpp"
+#include "irods_server_properties.hpp"
+#include "irods_server_state.hpp"
+#include "server_load_table.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <sys/sysmacros.h>
+
+namespace {
+
+    namespace slt = irods::experimental::server_load_table;
+
+    using json = nlohmann::json;
+
+    // /proc/diskstats reports transfers in 512 byte sectors regardless of
+    // the sector size of the underlying device
+    const std::int64_t DISKSTATS_SECTOR_SIZE = 512;
+
+    struct device_counters {
+        std::int64_t bytes;
+        std::chrono::steady_clock::time_point time;
+    };
+
+    // cumulative counters from the previous sample of each device, only
+    // touched by the publisher thread
+    std::map< dev_t, device_counters > previous_counters;
+
+    // the samples served to peers through the control plane
+    std::mutex local_samples_mutex;
+    json local_samples = json::object();
+
+    // @brief reads the cumulative number of bytes transferred and the number
+    //        of requests in flight for a block device
+    bool read_disk_stats(
+        dev_t         _device,
+        std::int64_t& _bytes,
+        std::int64_t& _in_flight ) {
+        std::ifstream in( "/proc/diskstats" );
+        std::string line;
+        while ( std::getline( in, line ) ) {
+            std::istringstream fields( line );
+            unsigned int major_number = 0;
+            unsigned int minor_number = 0;
+            std::string  name;
+            if ( !( fields >> major_number >> minor_number >> name ) ) {
+                continue;
+            }
+
+            if ( major( _device ) != major_number || minor( _device ) != minor_number ) {
+                continue;
+            }
+
+            // reads, reads merged, sectors read, time reading, writes,
+            // writes merged, sectors written, time writing, in flight
+            std::int64_t values[ 9 ]{};
+            for ( auto& value : values ) {
+                if ( !( fields >> value ) ) {
+                    return false;
+                }
+            }
+
+            _bytes     = ( values[ 2 ] + values[ 6 ] ) * DISKSTATS_SECTOR_SIZE;
+            _in_flight = values[ 8 ];
+            return true;
+        }
+
+        return false;
+
+    } // read_disk_stats
+
+    std::optional< slt::load_sample > sample_vault(
+        const std::string& _vault_path,
+        std::int64_t       _active_agents ) {
+        struct statvfs fs_info{};
+        struct stat    vault_info{};
+        if ( 0 != statvfs( _vault_path.c_str(), &fs_info ) ||
+             0 != stat( _vault_path.c_str(), &vault_info ) ) {
+            return std::nullopt;
+        }
+
+        slt::load_sample sample{};
+        sample.active_agents = _active_agents;
+        sample.free_space    = static_cast< std::int64_t >( fs_info.f_bavail ) * fs_info.f_frsize;
+
+        // virtual and network file systems have no entry in /proc/diskstats,
+        // in which case only the agent count and free space are reported
+        std::int64_t bytes = 0;
+        std::int64_t in_flight = 0;
+        if ( read_disk_stats( vault_info.st_dev, bytes, in_flight ) ) {
+            sample.disk_queue_depth = in_flight;
+
+            const auto now = std::chrono::steady_clock::now();
+            auto itr = previous_counters.find( vault_info.st_dev );
+            if ( previous_counters.end() != itr && bytes >= itr->second.bytes ) {
+                using std::chrono::duration_cast;
+                using std::chrono::milliseconds;
+                const auto elapsed = duration_cast< milliseconds >( now - itr->second.time ).count();
+                if ( elapsed > 0 ) {
+                    sample.io_bytes_per_second = ( bytes - itr->second.bytes ) * 1000 / elapsed;
+                }
+            }
+
+            previous_counters[ vault_info.st_dev ] = device_counters{ bytes, now };
+        }
+
+        return sample;
+
+    } // sample_vault
+
+    json to_json( const slt::load_sample& _sample ) {
+        return json{
+            {"active_agents", _sample.active_agents},
+            {"io_bytes_per_second", _sample.io_bytes_per_second},
+            {"disk_queue_depth", _sample.disk_queue_depth},
+            {"free_space", _sample.free_space}
+        };
+    } // to_json
+
+    slt::load_sample from_json( const json& _sample ) {
+        slt::load_sample sample{};
+        sample.active_agents       = _sample.at( "active_agents" ).get< std::int64_t >();
+        sample.io_bytes_per_second = _sample.at( "io_bytes_per_second" ).get< std::int64_t >();
+        sample.disk_queue_depth    = _sample.at( "disk_queue_depth" ).get< std::int64_t >();
+        sample.free_space          = _sample.at( "free_space" ).get< std::int64_t >();
+        return sample;
+    } // from_json
+
+    struct resource_location {
+        std::string name;
+        std::string vault_path;
+    };
+
+    // @brief lists the storage resources of the zone, split into those served
+    //        by this server and the hosts of all others.  the catalog is used
+    //        rather than the resource manager so that resources created after
+    //        startup are sampled without restarting the server.
+    void get_resource_locations(
+        std::vector< resource_location >& _local,
+        std::set< std::string >&          _peers ) {
+        irods::experimental::client_connection conn;
+        irods::query< rcComm_t > qobj{
+            static_cast< rcComm_t* >( conn ),
+            "select RESC_NAME, RESC_LOC, RESC_VAULT_PATH"};
+        for ( const auto& row : qobj ) {
+            const auto& name       = row[ 0 ];
+            const auto& location   = row[ 1 ];
+            const auto& vault_path = row[ 2 ];
+            if ( location.empty() ||
+                 irods::EMPTY_RESC_HOST == location ||
+                 vault_path.empty() ||
+                 irods::EMPTY_RESC_PATH == vault_path ) {
+                continue;
+            }
+
+            rodsHostAddr_t addr{};
+            rstrcpy( addr.hostAddr, location.c_str(), LONG_NAME_LEN );
+            rodsServerHost_t* host = nullptr;
+            if ( resolveHost( &addr, &host ) < 0 || !host ) {
+                continue;
+            }
+
+            if ( LOCAL_HOST == host->localFlag ) {
+                _local.push_back( resource_location{ name, vault_path } );
+            }
+            else {
+                _peers.insert( location );
+            }
+        }
+
+    } // get_resource_locations
+
+    void publish_local_samples(
+        const std::vector< resource_location >& _local ) {
+        std::vector< int > pids;
+        const std::int64_t active_agents = getAgentProcPIDs( pids );
+
+        json samples = json::object();
+        for ( const auto& resc : _local ) {
+            const auto sample = sample_vault( resc.vault_path, active_agents );
+            if ( !sample ) {
+                continue;
+            }
+
+            slt::insert_or_assign( resc.name, *sample );
+            samples[ resc.name ] = to_json( *sample );
+        }
+
+        std::lock_guard< std::mutex > lock( local_samples_mutex );
+        local_samples = std::move( samples );
+
+    } // publish_local_samples
+
+    void collect_peer_samples(
+        const std::set< std::string >& _peers ) {
+        for ( const auto& peer : _peers ) {
+            std::string output;
+            irods::error ret = irods::forward_server_control_command(
+                                   irods::SERVER_CONTROL_LOAD,
+                                   peer,
+                                   irods::CFG_SERVER_CONTROL_PLANE_PORT,
+                                   output );
+            if ( !ret.ok() ) {
+                rodsLog(
+                    LOG_DEBUG,
+                    "server_load_publisher :: no load sample from [%s] - %s",
+                    peer.c_str(),
+                    ret.result().c_str() );
+                continue;
+            }
+
+            // control plane responses are terminated with a comma
+            const auto end = output.find_last_of( '}' );
+            if ( std::string::npos == end ) {
+                continue;
+            }
+
+            try {
+                const auto samples = json::parse( output.substr( 0, end + 1 ) );
+                for ( const auto& [resc_name, sample] : samples.items() ) {
+                    slt::insert_or_assign( resc_name, from_json( sample ) );
+                }
+            }
+            catch ( const json::exception& e ) {
+                rodsLog(
+                    LOG_NOTICE,
+                    "server_load_publisher :: invalid load sample from [%s] - %s",
+                    peer.c_str(),
+                    e.what() );
+            }
+        }
+
+    } // collect_peer_samples
+
+} // anonymous namespace
+
+namespace irods {
+
+    nlohmann::json get_local_load_samples() {
+        std::lock_guard< std::mutex > lock( local_samples_mutex );
+        return local_samples;
+
+    } // get_local_load_samples
+
+    server_load_publisher::server_load_publisher() :
+        publisher_thread_( [this] { run(); } ) {
+
+    } // ctor
+
+    server_load_publisher::~server_load_publisher() {
+        try {
+            publisher_thread_.join();
+        }
+        catch ( const boost::thread_resource_error& ) {
+            rodsLog(
+                LOG_ERROR,
+                "boost encountered thread_resource_error on join in server_load_publisher destructor." );
+        }
+
+    } // dtor
+
+    void server_load_publisher::run() {
+        const size_t interval_ms = get_server_load_sample_interval() * 1000;
+
+        // samples which survive several missed rounds belong to servers
+        // which are no longer reachable
+        const std::chrono::seconds max_age( 4 * get_server_load_sample_interval() );
+
+        // publish immediately on startup
+        size_t wait_time_ms = interval_ms;
+
+        server_state& s = server_state::instance();
+        while ( server_state::STOPPED != s() &&
+                server_state::EXITED  != s() ) {
+            if ( wait_time_ms >= interval_ms ) {
+                wait_time_ms = 0;
+                try {
+                    std::vector< resource_location > local;
+                    std::set< std::string > peers;
+                    get_resource_locations( local, peers );
+
+                    publish_local_samples( local );
+                    collect_peer_samples( peers );
+                    slt::erase_expired_entries( max_age );
+                }
+                catch ( const irods::exception& e ) {
+                    irods::log( e );
+                }
+                catch ( const std::exception& e ) {
+                    rodsLog(
+                        LOG_ERROR,
+                        "server_load_publisher :: failed to publish load samples - %s",
+                        e.what() );
+                }
+            }
+
+            rodsSleep( 0, SERVER_CONTROL_POLLING_TIME_MILLI_SEC * 1000 ); // second, microseconds
+            wait_time_ms += SERVER_CONTROL_POLLING_TIME_MILLI_SEC;
+
+        } // while
+
+    } // run
+
+}; // namespace irods
@@ -0,0 +1,169 @@
+#include "server_load_table.hpp"
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/containers/map.hpp>
+#include <boost/interprocess/containers/string.hpp>
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/sync/named_sharable_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/sync/sharable_lock.hpp>
+
+#include <memory>
+#include <utility>
+
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace
+{
+    namespace bi = boost::interprocess;
+    namespace slt = irods::experimental::server_load_table;
+
+    using std::chrono::duration_cast;
+    using std::chrono::seconds;
+
+    // clang-format off
+    using segment_manager_type = bi::managed_shared_memory::segment_manager;
+    using void_allocator_type  = bi::allocator<void, segment_manager_type>;
+    using char_allocator_type  = bi::allocator<char, segment_manager_type>;
+    using key_type             = bi::basic_string<char, std::char_traits<char>, char_allocator_type>;
+    using mapped_type          = slt::load_sample;
+    using value_type           = std::pair<const key_type, mapped_type>;
+    using value_allocator_type = bi::allocator<value_type, segment_manager_type>;
+    using map_type             = bi::map<key_type, mapped_type, std::less<key_type>, value_allocator_type>;
+    using clock_type           = std::chrono::system_clock;
+    // clang-format on
+
+    //
+    // Global Variables
+    //
+
+    // The following variables define the names of shared memory objects and other properties.
+    std::string g_segment_name;
+    std::size_t g_segment_size;
+    std::string g_mutex_name;
+
+    // On initialization, holds the PID of the process that initialized the load table.
+    // This ensures that only the process that initialized the system can deinitialize it.
+    pid_t g_owner_pid;
+
+    // The following are pointers to the shared memory objects and allocator.
+    // Allocating on the heap allows us to know when the load table is constructed/destructed.
+    std::unique_ptr<bi::managed_shared_memory> g_segment;
+    std::unique_ptr<void_allocator_type> g_allocator;
+    std::unique_ptr<bi::named_sharable_mutex> g_mutex;
+    map_type* g_map;
+
+    auto current_timestamp_in_seconds() noexcept -> std::int64_t
+    {
+        return duration_cast<seconds>(clock_type::now().time_since_epoch()).count();
+    }
+} // anonymous namespace
+
+namespace irods::experimental::server_load_table
+{
+    auto init(const std::string_view _shm_name, std::size_t _shm_size) -> void
+    {
+        if (getpid() == g_owner_pid) {
+            return;
+        }
+
+        g_segment_name = _shm_name.data();
+        g_segment_size = _shm_size;
+        g_mutex_name = g_segment_name + "_mutex";
+
+        bi::named_sharable_mutex::remove(g_mutex_name.data());
+        bi::shared_memory_object::remove(g_segment_name.data());
+
+        g_owner_pid = getpid();
+        g_segment = std::make_unique<bi::managed_shared_memory>(bi::create_only, g_segment_name.data(), g_segment_size);
+        g_allocator = std::make_unique<void_allocator_type>(g_segment->get_segment_manager());
+        g_mutex = std::make_unique<bi::named_sharable_mutex>(bi::create_only, g_mutex_name.data());
+        g_map = g_segment->construct<map_type>(bi::anonymous_instance)(std::less<key_type>{}, *g_allocator);
+    } // init
+
+    auto deinit() noexcept -> void
+    {
+        if (getpid() != g_owner_pid) {
+            return;
+        }
+
+        try {
+            g_owner_pid = 0;
+
+            if (g_segment && g_map) {
+                g_segment->destroy_ptr(g_map);
+                g_map = nullptr;
+            }
+
+            // clang-format off
+            if (g_mutex)     { g_mutex.reset(); }
+            if (g_allocator) { g_allocator.reset(); }
+            if (g_segment)   { g_segment.reset(); }
+            // clang-format on
+
+            bi::named_sharable_mutex::remove(g_mutex_name.data());
+            bi::shared_memory_object::remove(g_segment_name.data());
+        }
+        catch (...) {}
+    } // deinit
+
+    auto insert_or_assign(const std::string_view _resource_name, load_sample _sample) -> bool
+    {
+        bi::scoped_lock lk{*g_mutex};
+
+        _sample.timestamp = current_timestamp_in_seconds();
+
+        const auto [iter, inserted] = g_map->insert_or_assign(
+            key_type{_resource_name.data(), _resource_name.size(), *g_allocator},
+            _sample);
+
+        return inserted;
+    } // insert_or_assign
+
+    auto lookup(const std::string_view _resource_name, std::chrono::seconds _max_age)
+        -> std::optional<load_sample>
+    {
+        // Processes which were not started by a server (e.g. unit tests and
+        // client-side tools) do not have access to the table.
+        if (!g_map) {
+            return std::nullopt;
+        }
+
+        bi::sharable_lock lk{*g_mutex};
+
+        if (auto iter = g_map->find(key_type{_resource_name.data(), _resource_name.size(), *g_allocator});
+            iter != g_map->end())
+        {
+            if (current_timestamp_in_seconds() - iter->second.timestamp <= _max_age.count()) {
+                return iter->second;
+            }
+        }
+
+        return std::nullopt;
+    } // lookup
+
+    auto erase_expired_entries(std::chrono::seconds _max_age) -> void
+    {
+        bi::scoped_lock lk{*g_mutex};
+
+        const auto now = current_timestamp_in_seconds();
+
+        for (auto iter = g_map->begin(), end = g_map->end(); iter != end;) {
+            if (now - iter->second.timestamp > _max_age.count()) {
+                iter = g_map->erase(iter);
+            }
+            else {
+                ++iter;
+            }
+        }
+    } // erase_expired_entries
+
+    auto size() -> std::size_t
+    {
+        bi::sharable_lock lk{*g_mutex};
+        return g_map->size();
+    } // size
+} // namespace irods::experimental::server_load_table
+
@@ -15,6 +15,7 @@ namespace {
         irods::file_object_ptr file_obj;
         std::string_view canonical_local_hostname;
         const irods::hierarchy_parser& parser;
+        rodsLong_t resource_id;
     };
 
     auto throw_if_resource_is_down(context& ctx)
@@ -26,13 +27,13 @@ namespace {
 
     auto find_local_replica(context& ctx)
     {
-        const auto& resc_name = irods::get_resource_name(ctx.plugin_ctx);
+        // The leaf resource of each replica is known by ID, so no hierarchy needs to be parsed.
         auto& replicas = ctx.file_obj->replicas();
         auto itr = std::find_if(
             std::begin(replicas),
             std::end(replicas),
-            [&resc_name](const auto& r) {
-                return resc_name == irods::hierarchy_parser{r.resc_hier()}.last_resc();
+            [id = ctx.resource_id](const auto& r) {
+                return id == r.resc_id();
             }
         );
         return std::cend(replicas) == itr ? std::nullopt : std::make_optional(std::ref(*itr));
@@ -233,7 +234,8 @@ float calculate(
         plugin_ctx,
         boost::dynamic_pointer_cast<irods::file_object>(plugin_ctx.fco()),
         canonical_local_hostname,
-        parser
+        parser,
+        irods::get_resource_id(plugin_ctx)
     };
 
     const auto vote = calculators.at(operation)(ctx);
@@ -11,6 +11,7 @@
 
 #include "irods_resource_constants.hpp"
 #include "irods_resource_manager.hpp"
+#include "agent_registry.hpp"
 
 // =-=-=-=-=-=-=-
 // Top Level Interface for Resource Plugin POSIX create
@@ -103,6 +104,7 @@ irods::error fileRead(
         return PASSMSG( "failed to call 'read'", ret_err );
     }
     else {
+        irods::experimental::agent_registry::add_bytes_read( ret_err.code() );
         return CODE( ret_err.code() );
     }
 
@@ -135,6 +137,7 @@ irods::error fileWrite(
         return PASSMSG( "failed to call 'write'", ret_err );
     }
     else {
+        irods::experimental::agent_registry::add_bytes_written( ret_err.code() );
         std::stringstream msg;
         msg << "Write successful.";
         return PASSMSG( msg.str(), ret_err );
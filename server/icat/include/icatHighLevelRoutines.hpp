@@ -42,6 +42,8 @@ int chlRegReplica( rsComm_t *rsComm, dataObjInfo_t *srcDataObjInfo,
                    dataObjInfo_t *dstDataObjInfo, keyValPair_t *condInput );
 int chlUnregDataObj( rsComm_t *rsComm, dataObjInfo_t *dataObjInfo,
                      keyValPair_t *condInput );
+int chlUnregDataObjs( rsComm_t *rsComm, const std::vector<rodsLong_t> *dataIds,
+                      keyValPair_t *condInput );
 int chlRegResc( rsComm_t *rsComm, std::map<std::string, std::string>& _resc_input );
 int chlAddChildResc( rsComm_t* rsComm, std::map<std::string, std::string>& _resc_input );
 int chlDelResc( rsComm_t *rsComm, const std::string& _resc_name, int _dryrun = 0 ); // JMC
@@ -225,6 +227,7 @@ int chlGetReplListForLeafBundles(
     size_t                      _child_idx,
     const std::vector<leaf_bundle_t>* _bundles,
     const std::string*          _invocation_timestamp,
+    rodsLong_t                  _data_id_lower_bound,
     dist_child_result_t*        _results );
 
 /// \brief High-level wrapper for database operation which calls cmlCheckDataObjId
@@ -650,6 +650,64 @@ int chlUnregDataObj(
 
 } // chlUnregDataObj
 
+/// =-=-=-=-=-=-=-
+/// @brief unregDataObjs - Unregister all replicas of a set of data objects
+///        in a single transaction.  The physical files must already have
+///        been removed.
+///        Input - rsComm_t *rsComm  - the server handle
+///                const std::vector<rodsLong_t> *dataIds - the data objects.
+///                keyValPair_t *condInput - used to specify a admin-mode.
+int chlUnregDataObjs(
+    rsComm_t*                       _comm,
+    const std::vector<rodsLong_t>*  _data_ids,
+    keyValPair_t*                   _cond_input ) {
+    // =-=-=-=-=-=-=-
+    // call factory for database object
+    irods::database_object_ptr db_obj_ptr;
+    irods::error ret = irods::database_factory(
+                           database_plugin_type,
+                           db_obj_ptr );
+    if ( !ret.ok() ) {
+        irods::log( PASS( ret ) );
+        return ret.code();
+    }
+
+    // =-=-=-=-=-=-=-
+    // resolve a plugin for that object
+    irods::plugin_ptr db_plug_ptr;
+    ret = db_obj_ptr->resolve(
+              irods::DATABASE_INTERFACE,
+              db_plug_ptr );
+    if ( !ret.ok() ) {
+        irods::log(
+            PASSMSG(
+                "failed to resolve database interface",
+                ret ) );
+        return ret.code();
+    }
+
+    // =-=-=-=-=-=-=-
+    // cast plugin and object to db and fco for call
+    irods::first_class_object_ptr ptr = boost::dynamic_pointer_cast <
+                                        irods::first_class_object > ( db_obj_ptr );
+    irods::database_ptr           db = boost::dynamic_pointer_cast <
+                                       irods::database > ( db_plug_ptr );
+
+    // =-=-=-=-=-=-=-
+    // call the operation on the plugin
+    ret = db->call <
+          const std::vector<rodsLong_t>*,
+          keyValPair_t* > (
+              _comm,
+              irods::DATABASE_OP_UNREG_DATA_OBJS,
+              ptr,
+              _data_ids,
+              _cond_input );
+
+    return ret.code();
+
+} // chlUnregDataObjs
+
 // =-=-=-=-=-=-=-
 // chlRegRuleExec - Register a new iRODS delayed rule execution object
 // Input - rsComm_t *rsComm  - the server handle
@@ -4664,6 +4722,7 @@ int chlGetReplListForLeafBundles(
     size_t                      _child_idx,
     const std::vector<leaf_bundle_t>* _bundles,
     const std::string*          _invocation_timestamp,
+    rodsLong_t                  _data_id_lower_bound,
     dist_child_result_t*        _results ) {
     // =-=-=-=-=-=-=-
     // call factory for database object
@@ -4702,6 +4761,7 @@ int chlGetReplListForLeafBundles(
               size_t,
               const std::vector<leaf_bundle_t>*,
               const std::string*,
+              rodsLong_t,
               dist_child_result_t* >(
                   0,
                   irods::DATABASE_OP_GET_REPL_LIST_FOR_LEAF_BUNDLES,
@@ -4710,6 +4770,7 @@ int chlGetReplListForLeafBundles(
                   _child_idx,
                   _bundles,
                   _invocation_timestamp,
+                  _data_id_lower_bound,
                   _results );
     if (!ret.ok()) {
         irods::log(PASS(ret));
@@ -23,6 +23,7 @@
 #ifdef IRODS_ENABLE_SYSLOG
     #define IRODS_SERVER_ONLY(x) x
     #include "irods_logger.hpp"
+    #include "agent_registry.hpp"
     using logger = irods::experimental::log;
 #else
     #define IRODS_SERVER_ONLY(x)
@@ -231,6 +232,7 @@ namespace irods {
 
         template<typename ...As>
         error exec_rule(const std::string& _rn, T& _re_ctx, As&&... _ps, callback _callback) {
+            IRODS_SERVER_ONLY(irods::experimental::agent_registry::scoped_rule_engine_timer timer;)
             try {
                 auto l = pack(std::forward<As>(_ps)...);
                 auto fcn = boost::any_cast<std::function<error(T&, const std::string&, std::list<boost::any> &, callback)>>( operations_["exec_rule"] );
@@ -246,6 +248,7 @@ namespace irods {
                 msParamArray_t*    _ms_params,
                 const std::string& _out_desc,
                 callback           _callback) {
+            IRODS_SERVER_ONLY(irods::experimental::agent_registry::scoped_rule_engine_timer timer;)
             try {
                 auto fcn = boost::any_cast<
                     std::function<error(T&, const std::string&, msParamArray_t*, const std::string&, callback)>>(
@@ -261,6 +264,7 @@ namespace irods {
                 const std::string& _rt,
                 msParamArray_t*    _ms_params,
                 callback           _callback) {
+            IRODS_SERVER_ONLY(irods::experimental::agent_registry::scoped_rule_engine_timer timer;)
             try {
                 auto fcn = boost::any_cast<
                     std::function<error(T&, const std::string&, msParamArray_t*, callback)>>(
@@ -890,7 +890,7 @@ int
 msiBytesBufToStr( msParam_t* buf_msp, msParam_t* str_msp, ruleExecInfo_t* ) {
     int single_buff_sz;
     try {
-        single_buff_sz = irods::get_advanced_setting<const int>(irods::CFG_MAX_SIZE_FOR_SINGLE_BUFFER) * 1024 * 1024;
+        single_buff_sz = irods::get_server_config_snapshot()->advanced_settings.maximum_size_for_single_buffer_in_megabytes.get() * 1024 * 1024;
     } catch ( const irods::exception& e ) {
         irods::log(e);
         return e.code();
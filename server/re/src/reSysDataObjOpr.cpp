@@ -681,7 +681,7 @@ msiSetNumThreads( msParam_t *xsizePerThrInMbStr, msParam_t *xmaxNumThrStr,
 
     int def_num_thr = 0;
     try {
-        def_num_thr = irods::get_advanced_setting<const int>(irods::CFG_DEF_NUMBER_TRANSFER_THREADS);
+        def_num_thr = irods::get_server_config_snapshot()->advanced_settings.default_number_of_transfer_threads.get();
     } catch ( const irods::exception& e ) {
         irods::log(e);
         return e.code();
@@ -699,7 +699,7 @@ msiSetNumThreads( msParam_t *xsizePerThrInMbStr, msParam_t *xmaxNumThrStr,
 
     int size_per_tran_thr = 0;
     try {
-        size_per_tran_thr = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS);
+        size_per_tran_thr = irods::get_server_config_snapshot()->advanced_settings.transfer_buffer_size_for_parallel_transfer_in_megabytes.get();
     } catch ( const irods::exception& e ) {
         irods::log(e);
         return e.code();
@@ -757,7 +757,7 @@ msiSetNumThreads( msParam_t *xsizePerThrInMbStr, msParam_t *xmaxNumThrStr,
 
         int trans_buff_size = 0;
         try {
-            trans_buff_size = irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS);
+            trans_buff_size = irods::get_server_config_snapshot()->advanced_settings.transfer_buffer_size_for_parallel_transfer_in_megabytes.get();
         } catch ( const irods::exception& e ) {
             irods::log(e);
             return e.code();
@@ -0,0 +1,111 @@
+#include "catch.hpp"
+
+#include "access_verdict_cache.hpp"
+#include "irods_at_scope_exit.hpp"
+
+#include <chrono>
+#include <ctime>
+#include <string>
+
+namespace avc = irods::experimental::access_verdict_cache;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    auto exercise_cache() -> void
+    {
+        const auto alice = avc::user_subject("alice", "tempZone");
+        const auto bob = avc::user_subject("bob", "tempZone");
+
+        SECTION("granted verdicts are found for the same subject, object and access level")
+        {
+            avc::insert({alice, 10001, "read_object"}, avc::generation());
+
+            REQUIRE(avc::contains({alice, 10001, "read_object"}));
+            REQUIRE_FALSE(avc::contains({alice, 10001, "modify_object"}));
+            REQUIRE_FALSE(avc::contains({alice, 10002, "read_object"}));
+            REQUIRE_FALSE(avc::contains({bob, 10001, "read_object"}));
+            REQUIRE(avc::size() == 1);
+        }
+
+        SECTION("invalidation discards every verdict")
+        {
+            avc::insert({alice, 10001, "read_object"}, avc::generation());
+            avc::insert({bob, 10001, "read_object"}, avc::generation());
+
+            avc::invalidate();
+
+            REQUIRE_FALSE(avc::contains({alice, 10001, "read_object"}));
+            REQUIRE_FALSE(avc::contains({bob, 10001, "read_object"}));
+            REQUIRE(avc::size() == 0);
+        }
+
+        SECTION("verdicts computed before an invalidation are not cached")
+        {
+            const auto generation = avc::generation();
+            avc::invalidate();
+            avc::insert({alice, 10001, "read_object"}, generation);
+
+            REQUIRE_FALSE(avc::contains({alice, 10001, "read_object"}));
+        }
+
+        SECTION("verdicts do not outlive their expiry")
+        {
+            avc::insert({alice, 10001, "read_object"}, avc::generation(), std::time(nullptr) - 1);
+
+            REQUIRE_FALSE(avc::contains({alice, 10001, "read_object"}));
+        }
+
+        SECTION("tickets are distinguished by the host and user presenting them")
+        {
+            const auto ticket = avc::ticket_subject("t1", "10.0.0.1", "anonymous", "tempZone");
+            avc::insert({ticket, 10001, "read_object"}, avc::generation());
+
+            REQUIRE(avc::contains({ticket, 10001, "read_object"}));
+            REQUIRE_FALSE(avc::contains({avc::ticket_subject("t1", "10.0.0.2", "anonymous", "tempZone"), 10001, "read_object"}));
+            REQUIRE_FALSE(avc::contains({avc::ticket_subject("t1", "10.0.0.1", "alice", "tempZone"), 10001, "read_object"}));
+            REQUIRE_FALSE(avc::contains({avc::ticket_subject("t2", "10.0.0.1", "anonymous", "tempZone"), 10001, "read_object"}));
+        }
+    }
+} // anonymous namespace
+
+TEST_CASE("access_verdict_cache")
+{
+    avc::configure(60s, 4);
+    irods::at_scope_exit clear{[] { avc::invalidate(); }};
+
+    SECTION("nothing is cached when the time to live is zero")
+    {
+        avc::configure(0s, 4);
+        avc::insert({avc::user_subject("alice", "tempZone"), 10001, "read_object"}, avc::generation());
+
+        REQUIRE_FALSE(avc::enabled());
+        REQUIRE_FALSE(avc::contains({avc::user_subject("alice", "tempZone"), 10001, "read_object"}));
+    }
+
+    SECTION("per agent")
+    {
+        exercise_cache();
+
+        SECTION("the number of verdicts is bounded")
+        {
+            const auto alice = avc::user_subject("alice", "tempZone");
+
+            for (rodsLong_t id = 1; id <= 10; ++id) {
+                avc::insert({alice, id, "read_object"}, avc::generation());
+                REQUIRE(avc::size() <= 4);
+            }
+
+            REQUIRE(avc::contains({alice, 10, "read_object"}));
+        }
+    }
+
+    SECTION("shared between agents")
+    {
+        avc::init("irods_access_verdict_cache_test", 100'000);
+        irods::at_scope_exit cleanup{[] { avc::deinit(); }};
+
+        exercise_cache();
+    }
+}
@@ -0,0 +1,197 @@
+#include "catch.hpp"
+
+#include "agent_registry.hpp"
+#include "irods_at_scope_exit.hpp"
+#include "rodsDef.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ar = irods::experimental::agent_registry;
+
+namespace
+{
+    auto make_agent_info(const char* _client_name) -> ar::agent_info
+    {
+        ar::agent_info info{};
+        std::strcpy(info.client_name, _client_name);
+        std::strcpy(info.client_zone, "tempZone");
+        std::strcpy(info.proxy_name, "rods");
+        std::strcpy(info.proxy_zone, "tempZone");
+        std::strcpy(info.program_name, "test_agent_registry");
+        std::strcpy(info.remote_address, "127.0.0.1");
+        return info;
+    }
+} // anonymous namespace
+
+TEST_CASE("agent_registry")
+{
+    // Updates and reads are harmless before the registry is initialized.
+    ar::begin_api(700);
+    REQUIRE_FALSE(ar::register_agent(make_agent_info("alice")));
+    REQUIRE(ar::list().empty());
+
+    ar::init("irods_agent_registry_test", 16);
+    irods::at_scope_exit cleanup{[] { ar::deinit(); }};
+
+    SECTION("register / lookup / unregister")
+    {
+        REQUIRE(ar::register_agent(make_agent_info("alice")));
+
+        auto info = ar::lookup(getpid());
+        REQUIRE(info);
+        REQUIRE(info->pid == getpid());
+        REQUIRE(std::string{info->client_name} == "alice");
+        REQUIRE(std::string{info->remote_address} == "127.0.0.1");
+        REQUIRE(info->start_time > 0);
+        REQUIRE(info->api_calls == 0);
+
+        // Registering again replaces the identity without using another entry.
+        REQUIRE(ar::register_agent(make_agent_info("bob")));
+        REQUIRE(ar::list().size() == 1);
+        REQUIRE(std::string{ar::lookup(getpid())->client_name} == "bob");
+
+        ar::unregister_agent(getpid());
+        REQUIRE_FALSE(ar::lookup(getpid()));
+        REQUIRE(ar::list().empty());
+    }
+
+    SECTION("counters")
+    {
+        REQUIRE(ar::register_agent(make_agent_info("alice")));
+
+        ar::begin_api(602);
+        ar::add_bytes_read(100);
+        ar::add_bytes_written(40);
+        ar::add_bytes_written(-1);
+        ar::increment_catalog_operations();
+        ar::increment_catalog_operations();
+
+        auto info = ar::lookup(getpid());
+        REQUIRE(info);
+        REQUIRE(info->api_number == 602);
+        REQUIRE(info->api_start_time > 0);
+        REQUIRE(info->api_calls == 1);
+        REQUIRE(info->bytes_read == 100);
+        REQUIRE(info->bytes_written == 40);
+        REQUIRE(info->catalog_operations == 2);
+
+        ar::end_api();
+        REQUIRE(ar::lookup(getpid())->api_number == 0);
+        REQUIRE(ar::lookup(getpid())->api_calls == 1);
+
+        ar::unregister_agent(getpid());
+    }
+
+    SECTION("nested rule engine timers are counted once")
+    {
+        REQUIRE(ar::register_agent(make_agent_info("alice")));
+
+        using namespace std::chrono;
+
+        const auto start = steady_clock::now();
+        {
+            ar::scoped_rule_engine_timer outer;
+            {
+                ar::scoped_rule_engine_timer inner;
+                while (steady_clock::now() - start < milliseconds{20});
+            }
+        }
+        const auto total = duration_cast<microseconds>(steady_clock::now() - start).count();
+
+        const auto elapsed = ar::lookup(getpid())->rule_engine_time_microseconds;
+        REQUIRE(elapsed >= 19'000);
+        REQUIRE(elapsed <= total);
+
+        ar::unregister_agent(getpid());
+    }
+
+    SECTION("entries of other processes are visible and removable")
+    {
+        const auto pid = fork();
+        REQUIRE(pid >= 0);
+
+        if (0 == pid) {
+            const bool registered = ar::register_agent(make_agent_info("child"));
+            ar::begin_api(603);
+            ar::add_bytes_read(7);
+            _exit(registered ? 0 : 1);
+        }
+
+        int status = 0;
+        REQUIRE(waitpid(pid, &status, 0) == pid);
+        REQUIRE(WIFEXITED(status));
+        REQUIRE(WEXITSTATUS(status) == 0);
+
+        // The child inherited nothing that lets this process update its entry.
+        ar::add_bytes_read(1000);
+
+        const auto agents = ar::list();
+        REQUIRE(agents.size() == 1);
+        REQUIRE(agents[0].pid == pid);
+        REQUIRE(std::string{agents[0].client_name} == "child");
+        REQUIRE(agents[0].api_number == 603);
+        REQUIRE(agents[0].bytes_read == 7);
+
+        ar::unregister_agent(pid);
+        REQUIRE(ar::list().empty());
+    }
+
+    SECTION("the registry rejects agents when full")
+    {
+        ar::deinit();
+        ar::init("irods_agent_registry_test", 1);
+
+        const auto pid = fork();
+        REQUIRE(pid >= 0);
+
+        if (0 == pid) {
+            _exit(ar::register_agent(make_agent_info("child")) ? 0 : 1);
+        }
+
+        int status = 0;
+        REQUIRE(waitpid(pid, &status, 0) == pid);
+        REQUIRE(WEXITSTATUS(status) == 0);
+
+        REQUIRE_FALSE(ar::register_agent(make_agent_info("alice")));
+
+        ar::unregister_agent(pid);
+        REQUIRE(ar::register_agent(make_agent_info("alice")));
+        ar::unregister_agent(getpid());
+    }
+
+    SECTION("update overhead is negligible")
+    {
+        REQUIRE(ar::register_agent(make_agent_info("alice")));
+
+        constexpr int iterations = 1'000'000;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < iterations; ++i) {
+            ar::begin_api(i % 1000 + 1);
+            ar::add_bytes_read(4096);
+            ar::add_bytes_written(4096);
+            ar::increment_catalog_operations();
+            ar::end_api();
+        }
+
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        const auto ns_per_call = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / iterations;
+
+        std::cout << "agent_registry: " << ns_per_call << " ns per API call of updates\n";
+
+        const auto info = ar::lookup(getpid());
+        REQUIRE(info->api_calls == iterations);
+        REQUIRE(info->bytes_read == std::int64_t{4096} * iterations);
+
+        // An API call costs at least a network round trip, i.e. tens of microseconds.
+        REQUIRE(ns_per_call < 2'000);
+
+        ar::unregister_agent(getpid());
+    }
+}
@@ -6,11 +6,13 @@
 #include "irods_at_scope_exit.hpp"
 #include "rodsErrorTable.h"
 #include "getRodsEnv.h"
+#include "irods_query.hpp"
 
 #include "json.hpp"
 
 #include <cstdlib>
 #include <string>
+#include <vector>
 
 using json = nlohmann::json;
 
@@ -354,6 +356,209 @@ TEST_CASE("atomic_apply_metadata_operations")
         REQUIRE(rc_atomic_apply_metadata_operations(conn_ptr, json_input.c_str(), &json_error_string) == SYS_INVALID_INPUT_PARAM);
         REQUIRE(contains_error_information(json_error_string));
     }
+
+    SECTION("only the last operation on an AVU takes effect")
+    {
+        const auto json_input = json{
+            {"entity_name", user_home},
+            {"entity_type", "collection"},
+            {"operations", json::array({
+                {
+                    {"operation", "remove"},
+                    {"attribute", "the_attr"},
+                    {"value", "the_val"},
+                    {"units", "the_units"}
+                },
+                {
+                    {"operation", "add"},
+                    {"attribute", "the_attr"},
+                    {"value", "the_val"},
+                    {"units", "the_units"}
+                },
+                {
+                    {"operation", "add"},
+                    {"attribute", "name"},
+                    {"value", "john doe"}
+                },
+                {
+                    {"operation", "remove"},
+                    {"attribute", "name"},
+                    {"value", "john doe"}
+                }
+            })}
+        }.dump();
+
+        char* json_error_string{};
+        irods::at_scope_exit free_memory{[&json_error_string] { std::free(json_error_string); }};
+
+        REQUIRE(rc_atomic_apply_metadata_operations(conn_ptr, json_input.c_str(), &json_error_string) == 0);
+        REQUIRE(json_error_string == "{}"s);
+
+        const auto gql = "select META_COLL_ATTR_NAME where COLL_NAME = '" + user_home + "' and META_COLL_ATTR_NAME in ('the_attr', 'name')";
+        std::vector<std::string> attribute_names;
+
+        for (auto&& row : irods::query{conn_ptr, gql}) {
+            attribute_names.push_back(row[0]);
+        }
+
+        REQUIRE(attribute_names == std::vector<std::string>{"the_attr"});
+    }
+
+    SECTION("apply many operations")
+    {
+        constexpr int avu_count = 250;
+
+        const auto make_input = [&user_home](const std::string& _op) {
+            auto operations = json::array();
+
+            for (int i = 0; i < avu_count; ++i) {
+                operations.push_back({
+                    {"operation", _op},
+                    {"attribute", "atomic_bulk_attr"},
+                    {"value", "v" + std::to_string(i)},
+                    {"units", "u"}
+                });
+            }
+
+            return json{
+                {"entity_name", user_home},
+                {"entity_type", "collection"},
+                {"operations", operations}
+            }.dump();
+        };
+
+        const auto count_avus = [conn_ptr, &user_home] {
+            const auto gql = "select count(META_COLL_ATTR_VALUE) where COLL_NAME = '" + user_home + "' and META_COLL_ATTR_NAME = 'atomic_bulk_attr'";
+
+            for (auto&& row : irods::query{conn_ptr, gql}) {
+                return std::stoi(row[0]);
+            }
+
+            return 0;
+        };
+
+        {
+            char* json_error_string{};
+            irods::at_scope_exit free_memory{[&json_error_string] { std::free(json_error_string); }};
+
+            REQUIRE(rc_atomic_apply_metadata_operations(conn_ptr, make_input("add").c_str(), &json_error_string) == 0);
+            REQUIRE(json_error_string == "{}"s);
+            REQUIRE(count_avus() == avu_count);
+        }
+
+        {
+            char* json_error_string{};
+            irods::at_scope_exit free_memory{[&json_error_string] { std::free(json_error_string); }};
+
+            REQUIRE(rc_atomic_apply_metadata_operations(conn_ptr, make_input("remove").c_str(), &json_error_string) == 0);
+            REQUIRE(json_error_string == "{}"s);
+            REQUIRE(count_avus() == 0);
+        }
+    }
+
+    SECTION("many entities")
+    {
+        const auto json_input = json{
+            {"entities", json::array({
+                {
+                    {"entity_name", user_home},
+                    {"entity_type", "collection"},
+                    {"operations", json::array({
+                        {
+                            {"operation", "add"},
+                            {"attribute", "the_attr"},
+                            {"value", "the_val"},
+                            {"units", "the_units"}
+                        }
+                    })}
+                },
+                {
+                    {"entity_name", env.rodsUserName},
+                    {"entity_type", "user"},
+                    {"operations", json::array({
+                        {
+                            {"operation", "add"},
+                            {"attribute", "renci_position"},
+                            {"value", "research_developer"}
+                        }
+                    })}
+                }
+            })}
+        }.dump();
+
+        char* json_error_string{};
+        irods::at_scope_exit free_memory{[&json_error_string] { std::free(json_error_string); }};
+
+        REQUIRE(rc_atomic_apply_metadata_operations(conn_ptr, json_input.c_str(), &json_error_string) == 0);
+        REQUIRE(json_error_string == "{}"s);
+    }
+
+    SECTION("errors identify the entity in requests with many entities")
+    {
+        const auto json_input = json{
+            {"entities", json::array({
+                {
+                    {"entity_name", user_home},
+                    {"entity_type", "collection"},
+                    {"operations", json::array({
+                        {
+                            {"operation", "add"},
+                            {"attribute", "the_attr"},
+                            {"value", "the_val"}
+                        }
+                    })}
+                },
+                {
+                    {"entity_name", user_home},
+                    {"entity_type", "collection"},
+                    {"operations", json::array({
+                        {
+                            {"operation", "update"},
+                            {"attribute", "the_attr"},
+                            {"value", "the_val"}
+                        }
+                    })}
+                }
+            })}
+        }.dump();
+
+        char* json_error_string{};
+        irods::at_scope_exit free_memory{[&json_error_string] { std::free(json_error_string); }};
+
+        REQUIRE(rc_atomic_apply_metadata_operations(conn_ptr, json_input.c_str(), &json_error_string) == INVALID_OPERATION);
+        REQUIRE(contains_error_information(json_error_string));
+        REQUIRE(json::parse(json_error_string).at("entity_index").get<int>() == 1);
+    }
+
+    SECTION("database errors identify the operation which failed")
+    {
+        constexpr int bad_op_index = 13;
+
+        auto operations = json::array();
+
+        for (int i = 0; i < 20; ++i) {
+            // The units of one AVU are longer than the catalog allows.
+            operations.push_back({
+                {"operation", "add"},
+                {"attribute", "atomic_bulk_attr"},
+                {"value", "v" + std::to_string(i)},
+                {"units", (i == bad_op_index) ? std::string(300, 'u') : "u"s}
+            });
+        }
+
+        const auto json_input = json{
+            {"entity_name", user_home},
+            {"entity_type", "collection"},
+            {"operations", operations}
+        }.dump();
+
+        char* json_error_string{};
+        irods::at_scope_exit free_memory{[&json_error_string] { std::free(json_error_string); }};
+
+        REQUIRE(rc_atomic_apply_metadata_operations(conn_ptr, json_input.c_str(), &json_error_string) == SYS_LIBRARY_ERROR);
+        REQUIRE(contains_error_information(json_error_string));
+        REQUIRE(json::parse(json_error_string).at("operation_index").get<int>() == bad_op_index);
+    }
 }
 
 auto contains_error_information(const char* _json_string) -> bool
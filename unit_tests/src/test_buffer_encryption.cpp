@@ -0,0 +1,202 @@
+#include "catch.hpp"
+
+#include "irods_buffer_encryption.hpp"
+#include "irods_encrypted_frame_writer.hpp"
+#include "rcMisc.h"
+
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <string>
+#include <thread>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+using array_t = irods::buffer_crypt::array_t;
+
+namespace
+{
+    constexpr int key_size = 32;
+
+    auto make_key() -> array_t
+    {
+        array_t key;
+        REQUIRE(irods::buffer_crypt::generate_key(key, key_size).ok());
+        return key;
+    }
+
+    auto make_plain_text(std::size_t _size) -> array_t
+    {
+        array_t plain(_size);
+
+        for (std::size_t i = 0; i < _size; ++i) {
+            plain[i] = static_cast<unsigned char>(i * 7);
+        }
+
+        return plain;
+    }
+
+    // Reads frames written by an encrypted_frame_writer the same way the receiving
+    // side of a parallel transfer does and returns the total number of plain text bytes.
+    auto read_frames(int _socket, const std::string& _algorithm, const array_t& _key, int _frames) -> std::int64_t
+    {
+        irods::buffer_crypt crypt{key_size, 8, 16, _algorithm.c_str()};
+        array_t buf;
+        array_t iv;
+        array_t cipher;
+        array_t plain;
+        std::int64_t total = 0;
+
+        for (int i = 0; i < _frames; ++i) {
+            int size = 0;
+            if (myRead(_socket, &size, sizeof(size), nullptr, nullptr) != sizeof(size)) {
+                return -1;
+            }
+
+            buf.resize(size);
+            if (myRead(_socket, buf.data(), size, nullptr, nullptr) != size) {
+                return -1;
+            }
+
+            iv.assign(buf.begin(), buf.begin() + key_size);
+            cipher.assign(buf.begin() + key_size, buf.end());
+
+            if (!crypt.decrypt(_key, iv, cipher, plain).ok()) {
+                return -1;
+            }
+
+            total += plain.size();
+        }
+
+        return total;
+    }
+} // anonymous namespace
+
+TEST_CASE("buffer_crypt round trip")
+{
+    const auto algorithm = GENERATE(as<std::string>{}, "aes-256-cbc", "aes-256-gcm", "chacha20-poly1305");
+
+    const auto key = make_key();
+    const auto plain = make_plain_text(1024 * 1024 + 3);
+
+    irods::buffer_crypt encryptor{key_size, 8, 16, algorithm.c_str()};
+    irods::buffer_crypt decryptor{key_size, 8, 16, algorithm.c_str()};
+
+    array_t iv;
+    array_t cipher;
+    array_t out;
+
+    SECTION("buffers decrypt with a different instance")
+    {
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(encryptor.initialization_vector(iv).ok());
+            REQUIRE(iv.size() == key_size);
+            REQUIRE(encryptor.encrypt(key, iv, plain, cipher).ok());
+            REQUIRE(decryptor.decrypt(key, iv, cipher, out).ok());
+            REQUIRE(out == plain);
+        }
+    }
+
+    SECTION("initialization vectors are not repeated")
+    {
+        std::set<array_t> ivs;
+
+        for (int i = 0; i < 1000; ++i) {
+            REQUIRE(encryptor.initialization_vector(iv).ok());
+            REQUIRE(ivs.insert(iv).second);
+        }
+    }
+
+    SECTION("AEAD algorithms reject modified cipher text")
+    {
+        REQUIRE(encryptor.initialization_vector(iv).ok());
+        REQUIRE(encryptor.encrypt(key, iv, plain, cipher).ok());
+
+        if (encryptor.is_aead()) {
+            REQUIRE(cipher.size() == plain.size() + irods::buffer_crypt::aead_tag_size);
+
+            cipher[100] ^= 1;
+            REQUIRE_FALSE(decryptor.decrypt(key, iv, cipher, out).ok());
+        }
+    }
+}
+
+TEST_CASE("buffer_crypt defaults to CBC")
+{
+    irods::buffer_crypt crypt;
+    REQUIRE(crypt.algorithm() == "aes-256-cbc");
+    REQUIRE_FALSE(crypt.is_aead());
+
+    irods::buffer_crypt gcm{key_size, 8, 16, "AES-256-GCM"};
+    REQUIRE(gcm.is_aead());
+}
+
+TEST_CASE("encrypted_frame_writer")
+{
+    const auto algorithm = GENERATE(as<std::string>{}, "aes-256-cbc", "aes-256-gcm");
+
+    const auto key = make_key();
+    const auto plain = make_plain_text(256 * 1024);
+    constexpr int frames = 16;
+
+    int sockets[2];
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0);
+
+    std::int64_t bytes_received = 0;
+    std::thread receiver{[&] { bytes_received = read_frames(sockets[1], algorithm, key, frames); }};
+
+    {
+        irods::buffer_crypt crypt{key_size, 8, 16, algorithm.c_str()};
+        irods::encrypted_frame_writer writer{sockets[0], crypt, key};
+
+        for (int i = 0; i < frames; ++i) {
+            REQUIRE(writer.write(plain.data(), plain.size()).ok());
+        }
+
+        REQUIRE(writer.flush().ok());
+    }
+
+    receiver.join();
+    close(sockets[0]);
+    close(sockets[1]);
+
+    REQUIRE(bytes_received == static_cast<std::int64_t>(frames) * plain.size());
+}
+
+TEST_CASE("encrypted parallel transfer benchmark", "[.][benchmark]")
+{
+    const auto key = make_key();
+    const auto plain = make_plain_text(4 * 1024 * 1024);
+    constexpr int frames = 256;
+
+    for (const std::string algorithm : {"aes-256-cbc", "aes-256-gcm", "chacha20-poly1305"}) {
+        int sockets[2];
+        REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0);
+
+        const auto start = std::chrono::steady_clock::now();
+
+        std::int64_t bytes_received = 0;
+        std::thread receiver{[&] { bytes_received = read_frames(sockets[1], algorithm, key, frames); }};
+
+        {
+            irods::buffer_crypt crypt{key_size, 8, 16, algorithm.c_str()};
+            irods::encrypted_frame_writer writer{sockets[0], crypt, key};
+
+            for (int i = 0; i < frames; ++i) {
+                REQUIRE(writer.write(plain.data(), plain.size()).ok());
+            }
+
+            REQUIRE(writer.flush().ok());
+        }
+
+        receiver.join();
+        close(sockets[0]);
+        close(sockets[1]);
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        REQUIRE(bytes_received == static_cast<std::int64_t>(frames) * plain.size());
+
+        std::cout << algorithm << ": " << bytes_received / elapsed.count() / 1e9 << " GB/s\n";
+    }
+}
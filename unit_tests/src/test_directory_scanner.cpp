@@ -0,0 +1,148 @@
+#include "catch.hpp"
+
+#include "directory_scanner.hpp"
+#include "irods_at_scope_exit.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+
+namespace fs = boost::filesystem;
+namespace ds = irods::experimental::directory_scanner;
+
+namespace
+{
+    auto make_file(const fs::path& _path, std::size_t _size) -> void
+    {
+        std::ofstream{_path.string()} << std::string(_size, 'x');
+    }
+
+    // dir/
+    //   a (1 byte), b (2 bytes), skip.tmp
+    //   sub/ c (3 bytes), deeper/ d (4 bytes)
+    //   empty/
+    //   link -> sub
+    auto make_tree(const fs::path& _root) -> void
+    {
+        fs::create_directories(_root / "sub" / "deeper");
+        fs::create_directories(_root / "empty");
+        make_file(_root / "a", 1);
+        make_file(_root / "b", 2);
+        make_file(_root / "skip.tmp", 5);
+        make_file(_root / "sub" / "c", 3);
+        make_file(_root / "sub" / "deeper" / "d", 4);
+    }
+
+    auto make_options(std::size_t _batch_size) -> ds::options
+    {
+        return {4, _batch_size, 2, nullptr, nullptr};
+    }
+} // anonymous namespace
+
+TEST_CASE("directory_scanner")
+{
+    const auto root = fs::temp_directory_path() / fs::unique_path("irods_directory_scanner_%%%%-%%%%");
+    irods::at_scope_exit remove_root{[&root] { fs::remove_all(root); }};
+    make_tree(root);
+
+    SECTION("every file and directory is delivered after its parent directory")
+    {
+        std::map<std::string, ds::entry> entries;
+        std::set<std::string> completed;
+        std::set<std::string> delivered_collections{"/tempZone/home/rods/dir"};
+
+        ds::scanner scanner{root.string() + "/", "/tempZone/home/rods/dir", make_options(1)};
+
+        while (auto batch = scanner.next()) {
+            REQUIRE(batch->entries.size() <= 1);
+
+            for (auto&& e : batch->entries) {
+                const auto parent = e.logical_path.substr(0, e.logical_path.rfind('/'));
+                REQUIRE(delivered_collections.count(parent) == 1);
+
+                if (e.is_directory) {
+                    delivered_collections.insert(e.logical_path);
+                }
+
+                entries[e.logical_path] = e;
+            }
+
+            completed.insert(batch->completed_directories.begin(), batch->completed_directories.end());
+        }
+
+        REQUIRE(scanner.status() == 0);
+        REQUIRE(entries.size() == 8);
+        REQUIRE(entries.at("/tempZone/home/rods/dir/a").size == 1);
+        REQUIRE(entries.at("/tempZone/home/rods/dir/a").physical_path == (root / "a").string());
+        REQUIRE(entries.at("/tempZone/home/rods/dir/sub/deeper/d").size == 4);
+        REQUIRE(entries.at("/tempZone/home/rods/dir/sub/deeper").is_directory);
+        REQUIRE(entries.at("/tempZone/home/rods/dir/empty").is_directory);
+        REQUIRE_FALSE(entries.at("/tempZone/home/rods/dir/b").is_directory);
+        REQUIRE(completed.size() == 4);
+        REQUIRE(completed.count(root.string()) == 1);
+        REQUIRE(completed.count((root / "sub" / "deeper").string()) == 1);
+    }
+
+    SECTION("symbolic links are followed")
+    {
+        fs::create_symlink(root / "sub", root / "link");
+
+        std::set<std::string> paths;
+        ds::scanner scanner{root.string(), "/tempZone/home/rods/dir", make_options(100)};
+
+        while (auto batch = scanner.next()) {
+            for (auto&& e : batch->entries) {
+                paths.insert(e.logical_path);
+            }
+        }
+
+        REQUIRE(paths.count("/tempZone/home/rods/dir/link") == 1);
+        REQUIRE(paths.count("/tempZone/home/rods/dir/link/c") == 1);
+        REQUIRE(paths.count("/tempZone/home/rods/dir/link/deeper/d") == 1);
+    }
+
+    SECTION("excluded entries and skipped files are not delivered")
+    {
+        auto options = make_options(100);
+        options.exclude = [](const char* _name, const std::string&) { return std::strstr(_name, ".tmp") != nullptr; };
+        options.skip_files = [&root](const std::string& _directory) { return _directory == root.string(); };
+
+        std::set<std::string> paths;
+        ds::scanner scanner{root.string(), "/tempZone/home/rods/dir", options};
+
+        while (auto batch = scanner.next()) {
+            for (auto&& e : batch->entries) {
+                paths.insert(e.logical_path);
+            }
+        }
+
+        REQUIRE(paths == std::set<std::string>{"/tempZone/home/rods/dir/sub",
+                                               "/tempZone/home/rods/dir/sub/c",
+                                               "/tempZone/home/rods/dir/sub/deeper",
+                                               "/tempZone/home/rods/dir/sub/deeper/d",
+                                               "/tempZone/home/rods/dir/empty"});
+    }
+
+    SECTION("a missing directory is reported")
+    {
+        ds::scanner scanner{(root / "missing").string(), "/tempZone/home/rods/dir", make_options(100)};
+
+        REQUIRE_FALSE(scanner.next());
+        REQUIRE(scanner.status() < 0);
+    }
+
+    SECTION("scanning stops when the scanner is destroyed early")
+    {
+        for (int i = 0; i < 100; ++i) {
+            make_file(root / ("file_" + std::to_string(i)), 1);
+        }
+
+        ds::scanner scanner{root.string(), "/tempZone/home/rods/dir", make_options(1)};
+        REQUIRE(scanner.next());
+    }
+}
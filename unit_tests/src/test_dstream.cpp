@@ -7,12 +7,15 @@
 #include "irods_query.hpp"
 #include "replica.hpp"
 #include "rodsClient.h"
+#include "transport/async_transport.hpp"
 #include "transport/default_transport.hpp"
 
 #include <boost/filesystem.hpp>
 #include <fmt/format.h>
 
 #include <chrono>
+#include <iostream>
+#include <string>
 #include <string_view>
 
 #include <unistd.h>
@@ -22,6 +25,7 @@ namespace io = irods::experimental::io;
 
 auto get_hostname() noexcept -> std::string;
 auto create_resource_vault(const std::string& _vault_name) -> boost::filesystem::path;
+auto make_test_data(std::size_t _size) -> std::string;
 
 TEST_CASE("dstream", "[iostreams]")
 {
@@ -303,6 +307,141 @@ TEST_CASE("dstream", "[iostreams]")
         ds.read(buf, 2);
         REQUIRE(std::string_view(buf, 2) == "cd");
     }
+
+    SECTION("read and write through a buffer larger than the default")
+    {
+        io::client::native_transport tp{conn};
+        io::dstream ds{tp, sandbox / "data_object.txt", std::ios::in | std::ios::out | std::ios::trunc};
+        REQUIRE(ds.rdbuf()->pubsetbuf(nullptr, 1024 * 1024));
+
+        // Many small writes are gathered in the buffer.
+        const auto data = make_test_data(3 * 1024 * 1024 + 17);
+        for (std::size_t i = 0; i < data.size(); i += 7) {
+            ds.write(data.data() + i, std::min<std::size_t>(7, data.size() - i));
+        }
+
+        REQUIRE(ds.seekg(0));
+
+        std::string contents(data.size(), '\0');
+        ds.read(contents.data(), contents.size());
+        REQUIRE(ds.gcount() == static_cast<std::streamsize>(data.size()));
+        REQUIRE(contents == data);
+
+        // Relative seeks account for bytes that were buffered but not consumed.
+        REQUIRE(ds.seekg(10));
+        char buf[4]{};
+        ds.read(buf, 2);
+        REQUIRE(ds.tellg() == 12);
+        REQUIRE(ds.seekg(3, std::ios::cur));
+        ds.read(buf, 4);
+        REQUIRE(std::string_view(buf, 4) == std::string_view(data.data() + 15, 4));
+
+        // Writing after a partial read starts where reading stopped.
+        ds.write("ZZ", 2);
+        REQUIRE(ds.seekg(17));
+        ds.read(buf, 4);
+        REQUIRE(std::string_view(buf, 4) == data.substr(17, 2) + "ZZ");
+    }
+
+    SECTION("read and write through the async transport")
+    {
+        io::client::native_transport ntp{conn};
+        io::async_transport tp{ntp, 64 * 1024, 4};
+
+        const auto data = make_test_data(1024 * 1024 + 5);
+        const auto path = sandbox / "async_data_object.txt";
+
+        {
+            io::odstream out{tp, path};
+            REQUIRE(out);
+            out.write(data.data(), data.size());
+        }
+
+        REQUIRE(fs::client::data_object_size(conn, path) == data.size());
+
+        io::dstream ds{tp, path, std::ios::in | std::ios::out};
+        REQUIRE(ds);
+
+        std::string contents(data.size(), '\0');
+        ds.read(contents.data(), contents.size());
+        REQUIRE(ds.gcount() == static_cast<std::streamsize>(data.size()));
+        REQUIRE(contents == data);
+        ds.clear();
+
+        // Seeking stops the read-ahead and returns to the caller's position.
+        REQUIRE(ds.seekg(100));
+        char buf[4]{};
+        ds.read(buf, 4);
+        REQUIRE(std::string_view(buf, 4) == std::string_view(data.data() + 100, 4));
+        REQUIRE(ds.tellg() == 104);
+
+        REQUIRE(ds.seekp(200));
+        ds.write("ZZZZ", 4);
+        REQUIRE(ds.seekg(198));
+        ds.read(buf, 4);
+        REQUIRE(std::string_view(buf, 4) == data.substr(198, 2) + "ZZ");
+    }
+}
+
+TEST_CASE("dstream buffer size benchmark", "[.][benchmark]")
+{
+    load_client_api_plugins();
+
+    auto conn_pool = irods::make_connection_pool(1);
+
+    rodsEnv env;
+    _getRodsEnv(env);
+
+    const auto sandbox = fs::path{env.rodsHome} / "unit_testing_sandbox";
+    auto conn = conn_pool->get_connection();
+
+    if (!fs::client::exists(conn, sandbox)) {
+        REQUIRE(fs::client::create_collection(conn, sandbox));
+    }
+
+    irods::at_scope_exit remove_sandbox{[&conn, &sandbox] {
+        REQUIRE(fs::client::remove_all(conn, sandbox, fs::remove_options::no_trash));
+    }};
+
+    const auto data = make_test_data(256 * 1024 * 1024);
+    const auto path = sandbox / "benchmark_data_object";
+    constexpr std::size_t io_size = 64 * 1024;
+
+    const auto run = [&](std::string_view _name, io::transport<char>& _tp, std::streamsize _buffer_size) {
+        using clock = std::chrono::steady_clock;
+
+        const auto write_start = clock::now();
+        {
+            io::odstream out{_tp, path};
+            REQUIRE(out.rdbuf()->pubsetbuf(nullptr, _buffer_size));
+            for (std::size_t i = 0; i < data.size(); i += io_size) {
+                out.write(data.data() + i, io_size);
+            }
+        }
+        const std::chrono::duration<double> write_time = clock::now() - write_start;
+
+        std::string buf(io_size, '\0');
+        const auto read_start = clock::now();
+        {
+            io::idstream in{_tp, path};
+            REQUIRE(in.rdbuf()->pubsetbuf(nullptr, _buffer_size));
+            while (in.read(buf.data(), buf.size())) {
+            }
+        }
+        const std::chrono::duration<double> read_time = clock::now() - read_start;
+
+        const auto mib = data.size() / (1024.0 * 1024.0);
+        std::cout << fmt::format("{:<6} buffer={:>9} write={:8.1f} MiB/s read={:8.1f} MiB/s\n",
+                                 _name, _buffer_size, mib / write_time.count(), mib / read_time.count());
+    };
+
+    for (const std::streamsize buffer_size : {4 * 1024, 1024 * 1024, 16 * 1024 * 1024}) {
+        io::client::native_transport tp{conn};
+        run("sync", tp, buffer_size);
+
+        io::async_transport atp{tp, buffer_size, 2};
+        run("async", atp, buffer_size);
+    }
 }
 
 auto get_hostname() noexcept -> std::string
@@ -330,3 +469,14 @@ auto create_resource_vault(const std::string& _vault_name) -> boost::filesystem:
 
     return vault;
 }
+
+auto make_test_data(std::size_t _size) -> std::string
+{
+    std::string data(_size, '\0');
+
+    for (std::size_t i = 0; i < _size; ++i) {
+        data[i] = static_cast<char>('a' + i % 26);
+    }
+
+    return data;
+}
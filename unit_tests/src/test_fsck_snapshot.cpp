@@ -0,0 +1,148 @@
+#include "catch.hpp"
+
+#include "fsck_snapshot.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <string>
+
+namespace fs = boost::filesystem;
+namespace fsck = irods::experimental::fsck;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    auto write_file(const fs::path& _path, const std::string& _contents) -> void
+    {
+        std::ofstream{_path.string()} << _contents;
+    }
+
+    struct temporary_directory
+    {
+        fs::path path = fs::temp_directory_path() / fs::unique_path("irods_fsck_snapshot_%%%%-%%%%");
+
+        temporary_directory()
+        {
+            fs::create_directories(path);
+        }
+
+        ~temporary_directory()
+        {
+            fs::remove_all(path);
+        }
+    }; // struct temporary_directory
+} // anonymous namespace
+
+TEST_CASE("fsck walk")
+{
+    temporary_directory tmp;
+    const auto& root = tmp.path;
+
+    fs::create_directories(root / "a" / "b");
+    write_file(root / "top", "0123456789");
+    write_file(root / "a" / "one", "1");
+    write_file(root / "a" / "b" / "two", "22");
+    fs::create_symlink(root / "top", root / "a" / "link");
+
+    SECTION("recursive")
+    {
+        const auto result = fsck::walk(root.string(), true, 4);
+
+        REQUIRE(result.files.size() == 3);
+        CHECK(result.files[0].path == (root / "a" / "b" / "two").string());
+        CHECK(result.files[0].size == 2);
+        CHECK(result.files[1].path == (root / "a" / "one").string());
+        CHECK(result.files[2].path == (root / "top").string());
+        CHECK(result.files[2].size == 10);
+        CHECK(result.files[2].mtime == fs::last_write_time(root / "top"));
+
+        REQUIRE(result.directories.size() == 3);
+        CHECK(result.directories[0] == root.string());
+        CHECK(result.directories[1] == (root / "a").string());
+        CHECK(result.directories[2] == (root / "a" / "b").string());
+
+        REQUIRE(result.skipped.size() == 1);
+        CHECK(result.skipped[0] == (root / "a" / "link").string());
+
+        CHECK(result.errors.empty());
+    }
+
+    SECTION("non-recursive")
+    {
+        const auto result = fsck::walk(root.string(), false, 4);
+
+        REQUIRE(result.files.size() == 1);
+        CHECK(result.files[0].path == (root / "top").string());
+
+        REQUIRE(result.directories.size() == 1);
+        REQUIRE(result.skipped.size() == 1);
+        CHECK(result.skipped[0] == (root / "a").string());
+    }
+
+    SECTION("unreadable directories are reported")
+    {
+        const auto result = fsck::walk((root / "missing").string(), true, 2);
+
+        CHECK(result.files.empty());
+        CHECK(result.directories.empty());
+        REQUIRE(result.errors.size() == 1);
+        CHECK(result.errors[0].first == (root / "missing").string());
+        CHECK(result.errors[0].second != 0);
+    }
+}
+
+TEST_CASE("fsck throttle")
+{
+    SECTION("unlimited")
+    {
+        fsck::throttle t{0};
+        const auto start = std::chrono::steady_clock::now();
+        t.acquire(1024 * 1024 * 1024);
+        t.acquire(1024 * 1024 * 1024);
+        CHECK(std::chrono::steady_clock::now() - start < 100ms);
+    }
+
+    SECTION("limited")
+    {
+        // The first file is read immediately. The third waits for the first two.
+        fsck::throttle t{1000};
+        const auto start = std::chrono::steady_clock::now();
+        t.acquire(100);
+        t.acquire(100);
+        t.acquire(100);
+        CHECK(std::chrono::steady_clock::now() - start >= 190ms);
+    }
+}
+
+TEST_CASE("fsck state file")
+{
+    temporary_directory tmp;
+    const auto path = (tmp.path / "state").string();
+
+    const fsck::local_file file{"/vault/f", 10, 1000};
+
+    {
+        fsck::state_file state{path};
+        CHECK_FALSE(state.verified(file.path, file, "sha2:abc"));
+
+        state.update(file.path, {10, 1000, "sha2:abc", "ok"});
+        state.update("/vault/g", {5, 1000, "", "size_mismatch"});
+        REQUIRE(state.save() == 0);
+    }
+
+    // Corrupt the file with a partial line. It is ignored.
+    std::ofstream{path, std::ios::app} << "{\"path\": \"/vault/h\"\n";
+
+    const fsck::state_file state{path};
+
+    CHECK(state.verified(file.path, file, "sha2:abc"));
+    CHECK_FALSE(state.verified(file.path, file, "sha2:def"));
+    CHECK_FALSE(state.verified(file.path, file, ""));
+    CHECK_FALSE(state.verified(file.path, {"/vault/f", 10, 2000}, "sha2:abc"));
+    CHECK_FALSE(state.verified(file.path, {"/vault/f", 11, 1000}, "sha2:abc"));
+    CHECK_FALSE(state.verified("/vault/g", {"/vault/g", 5, 1000}, ""));
+    CHECK_FALSE(state.verified("/vault/h", file, "sha2:abc"));
+}
@@ -0,0 +1,98 @@
+#include "catch.hpp"
+
+#include "inline_checksum_table.hpp"
+#include "irods_at_scope_exit.hpp"
+#include "irods_hasher_factory.hpp"
+#include "Hasher.hpp"
+
+#include <string>
+
+namespace ict = irods::experimental::inline_checksum_table;
+
+namespace
+{
+    constexpr const char* hierarchy = "rootResc;ufs0";
+    constexpr const char* physical_path = "/var/lib/irods/Vault/home/rods/foo";
+
+    auto checksum_of(const std::string& _data, const std::string& _scheme) -> std::string
+    {
+        irods::Hasher hasher;
+        REQUIRE(irods::getHasher(_scheme, hasher).ok());
+        REQUIRE(hasher.update(_data).ok());
+
+        std::string digest;
+        REQUIRE(hasher.digest(digest).ok());
+
+        return digest;
+    } // checksum_of
+} // anonymous namespace
+
+TEST_CASE("inline_checksum_table")
+{
+    irods::at_scope_exit cleanup{[] { ict::erase_released_entries(); }};
+
+    const std::string data = "the quick brown fox jumps over the lazy dog";
+    const auto size = static_cast<std::int64_t>(data.size());
+    constexpr int l3_index = 5;
+
+    SECTION("sequential writes produce the checksum of the whole file")
+    {
+        for (const std::string scheme : {"md5", "sha256"}) {
+            REQUIRE(ict::start(l3_index, hierarchy, physical_path, scheme));
+
+            ict::seek(l3_index, 0);
+            ict::update(l3_index, data.data(), 10);
+            ict::update(l3_index, data.data() + 10, size - 10);
+
+            // Not available until the file is closed.
+            REQUIRE_FALSE(ict::find(hierarchy, physical_path, size, scheme));
+
+            ict::release(l3_index);
+
+            const auto checksum = ict::find(hierarchy, physical_path, size, scheme);
+            REQUIRE(checksum);
+            REQUIRE(*checksum == checksum_of(data, scheme));
+
+            ict::erase_released_entries();
+            REQUIRE_FALSE(ict::find(hierarchy, physical_path, size, scheme));
+        }
+    }
+
+    SECTION("mismatched size, scheme, or location yields nothing")
+    {
+        REQUIRE(ict::start(l3_index, hierarchy, physical_path, "md5"));
+        ict::update(l3_index, data.data(), size);
+        ict::release(l3_index);
+
+        REQUIRE(ict::find(hierarchy, physical_path, size, "md5"));
+        REQUIRE_FALSE(ict::find(hierarchy, physical_path, size + 1, "md5"));
+        REQUIRE_FALSE(ict::find(hierarchy, physical_path, size, "sha256"));
+        REQUIRE_FALSE(ict::find("rootResc;ufs1", physical_path, size, "md5"));
+        REQUIRE_FALSE(ict::find(hierarchy, "/var/lib/irods/Vault/home/rods/bar", size, "md5"));
+    }
+
+    SECTION("seeking away from the end of the hashed data invalidates the checksum")
+    {
+        REQUIRE(ict::start(l3_index, hierarchy, physical_path, "md5"));
+        ict::update(l3_index, data.data(), size);
+        ict::seek(l3_index, 0);
+        ict::update(l3_index, data.data(), size);
+        ict::release(l3_index);
+
+        REQUIRE_FALSE(ict::find(hierarchy, physical_path, size, "md5"));
+        REQUIRE_FALSE(ict::find(hierarchy, physical_path, size * 2, "md5"));
+    }
+
+    SECTION("writes to untracked descriptors are ignored")
+    {
+        ict::update(l3_index + 1, data.data(), size);
+        ict::release(l3_index + 1);
+
+        REQUIRE_FALSE(ict::find(hierarchy, physical_path, size, "md5"));
+    }
+
+    SECTION("unsupported hash schemes are rejected")
+    {
+        REQUIRE_FALSE(ict::start(l3_index, hierarchy, physical_path, "no_such_scheme"));
+    }
+}
@@ -0,0 +1,230 @@
+#include "catch.hpp"
+
+#include "QUANTAnet_rbudpReceiver_c.h"
+#include "QUANTAnet_rbudpSender_c.h"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+    constexpr int packet_size = 8192;
+
+    // A sender and a receiver connected over the loopback interface the same way
+    // the portal connects them: a TCP-like control channel plus a pair of connected
+    // UDP sockets.
+    struct rbudp_pair
+    {
+        rbudpSender_t sender;
+        rbudpReceiver_t receiver;
+
+        rbudp_pair()
+        {
+            bzero(&sender, sizeof(sender));
+            bzero(&receiver, sizeof(receiver));
+
+            int control[2];
+            REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, control) == 0);
+            sender.rbudpBase.tcpSockfd = control[0];
+            receiver.rbudpBase.tcpSockfd = control[1];
+
+            sender.rbudpBase.udpSockfd = make_udp_socket();
+            receiver.rbudpBase.udpSockfd = make_udp_socket();
+            connect_to(sender.rbudpBase.udpSockfd, receiver.rbudpBase.udpSockfd);
+            connect_to(receiver.rbudpBase.udpSockfd, sender.rbudpBase.udpSockfd);
+
+            checkbuf(sender.rbudpBase.udpSockfd, UDPSOCKBUF, 0);
+            checkbuf(receiver.rbudpBase.udpSockfd, UDPSOCKBUF, 0);
+        }
+
+        ~rbudp_pair()
+        {
+            close(sender.rbudpBase.tcpSockfd);
+            close(sender.rbudpBase.udpSockfd);
+            close(receiver.rbudpBase.tcpSockfd);
+            close(receiver.rbudpBase.udpSockfd);
+        }
+
+        // Sends _in to the receiver and returns what it received.
+        auto transfer(std::vector<char>& _in, int _send_rate) -> std::vector<char>
+        {
+            std::vector<char> out(_in.size());
+
+            int receive_status = -1;
+            std::thread t{[&] {
+                receive_status = receiveBuf(&receiver, out.data(), out.size(), packet_size);
+            }};
+
+            const int send_status = sendBuf(&sender, _in.data(), _in.size(), _send_rate, packet_size);
+            t.join();
+
+            REQUIRE(send_status == 0);
+            REQUIRE(receive_status == 0);
+
+            return out;
+        }
+
+        static auto make_udp_socket() -> int
+        {
+            const int s = socket(AF_INET, SOCK_DGRAM, 0);
+            REQUIRE(s >= 0);
+
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            REQUIRE(bind(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+
+            return s;
+        }
+
+        static auto connect_to(int _from, int _to) -> void
+        {
+            sockaddr_in addr{};
+            socklen_t len = sizeof(addr);
+            REQUIRE(getsockname(_to, reinterpret_cast<sockaddr*>(&addr), &len) == 0);
+            REQUIRE(connect(_from, reinterpret_cast<sockaddr*>(&addr), len) == 0);
+        }
+    }; // struct rbudp_pair
+
+    auto make_data(std::size_t _size) -> std::vector<char>
+    {
+        std::vector<char> data(_size);
+
+        for (std::size_t i = 0; i < _size; ++i) {
+            data[i] = static_cast<char>(i * 31 + i / packet_size);
+        }
+
+        return data;
+    }
+} // anonymous namespace
+
+TEST_CASE("rbudp rate adaptation")
+{
+    SECTION("clean rounds raise the rate up to the ceiling")
+    {
+        CHECK(adaptSendRate(100000, 100000, 10000, 400000, 0.0) == 125000);
+        CHECK(adaptSendRate(390000, 390000, 10000, 400000, 0.0) == 400000);
+    }
+
+    SECTION("moderate loss keeps the rate")
+    {
+        CHECK(adaptSendRate(100000, 100000, 10000, 400000, 0.01) == 100000);
+    }
+
+    SECTION("heavy loss backs off to what got through")
+    {
+        CHECK(adaptSendRate(100000, 100000, 10000, 400000, 0.5) == 45000);
+
+        // A sender that could not keep up backs off from the rate it achieved.
+        CHECK(adaptSendRate(100000, 50000, 10000, 400000, 0.5) == 22500);
+        CHECK(adaptSendRate(100000, 100000, 10000, 400000, 0.99) == 10000);
+    }
+}
+
+TEST_CASE("rbudp loss simulation")
+{
+    rbudpBase_t base;
+    bzero(&base, sizeof(base));
+    base.packetSize = packet_size;
+
+    SECTION("no loss by default")
+    {
+        for (int i = 0; i < 1000; ++i) {
+            REQUIRE_FALSE(simulatePacketLoss(&base));
+        }
+    }
+
+    SECTION("random loss")
+    {
+        base.simLossRate = 0.1;
+        base.simSeed = 42;
+
+        int dropped = 0;
+        for (int i = 0; i < 10000; ++i) {
+            dropped += simulatePacketLoss(&base);
+        }
+
+        CHECK(dropped > 800);
+        CHECK(dropped < 1200);
+    }
+
+    SECTION("bottleneck drops bursts beyond the queue")
+    {
+        base.simBottleneckRate = 1000;
+        base.simQueuePackets = 8;
+
+        int dropped = 0;
+        for (int i = 0; i < 100; ++i) {
+            dropped += simulatePacketLoss(&base);
+        }
+
+        CHECK(dropped >= 90);
+    }
+}
+
+TEST_CASE("rbudp loopback transfer")
+{
+    auto in = make_data(4 * 1024 * 1024 + 123);
+    rbudp_pair p;
+
+    SECTION("without loss")
+    {
+        CHECK(p.transfer(in, 200000) == in);
+        CHECK(p.sender.pacedRate > 200000);
+    }
+
+    SECTION("with random loss")
+    {
+        p.receiver.rbudpBase.simLossRate = 0.1;
+        p.receiver.rbudpBase.simSeed = 1;
+
+        CHECK(p.transfer(in, 200000) == in);
+        CHECK(p.sender.pacedRate < 200000);
+    }
+
+    SECTION("through a bottleneck slower than the sending rate")
+    {
+        p.receiver.rbudpBase.simBottleneckRate = 50000;
+
+        for (int i = 0; i < 3; ++i) {
+            CHECK(p.transfer(in, 400000) == in);
+        }
+
+        CHECK(p.sender.pacedRate < 100000);
+    }
+
+    SECTION("from multiple streams")
+    {
+        p.sender.numStreams = 4;
+        p.receiver.rbudpBase.simLossRate = 0.05;
+        p.receiver.rbudpBase.simSeed = 7;
+
+        CHECK(p.transfer(in, 200000) == in);
+    }
+}
+
+TEST_CASE("rbudp loopback benchmark", "[.][benchmark]")
+{
+    auto in = make_data(256 * 1024 * 1024);
+
+    for (const int streams : {1, 4}) {
+        rbudp_pair p;
+        p.sender.numStreams = streams;
+        p.sender.maxSendRate = 20000000;
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto out = p.transfer(in, 1000000);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        REQUIRE(out == in);
+        std::cout << streams << " stream(s): " << in.size() / elapsed.count() / 1e9 * 8 << " Gbit/s, final rate "
+                  << p.sender.pacedRate << " Kbps\n";
+    }
+}
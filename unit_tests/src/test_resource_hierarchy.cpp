@@ -0,0 +1,153 @@
+#include "catch.hpp"
+
+#include "resource_hierarchy.hpp"
+#include "irods_exception.hpp"
+#include "irods_hierarchy_parser.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+using resource_hierarchy = irods::experimental::resource_hierarchy;
+
+TEST_CASE("resource_hierarchy")
+{
+    SECTION("empty hierarchies have no root or leaf")
+    {
+        const resource_hierarchy hierarchy;
+
+        REQUIRE(hierarchy.empty());
+        REQUIRE(hierarchy.size() == 0);
+        REQUIRE(hierarchy.begin() == hierarchy.end());
+        REQUIRE_FALSE(hierarchy.contains(0));
+        REQUIRE_THROWS_AS(hierarchy.root(), irods::exception);
+        REQUIRE_THROWS_AS(hierarchy.leaf(), irods::exception);
+    }
+
+    SECTION("children are added below the leaf resource")
+    {
+        resource_hierarchy hierarchy;
+        hierarchy.add_child(10);
+        hierarchy.add_child(11);
+        hierarchy.add_child(12);
+
+        REQUIRE(hierarchy.size() == 3);
+        REQUIRE(hierarchy.root() == 10);
+        REQUIRE(hierarchy.leaf() == 12);
+        REQUIRE(hierarchy[1] == 11);
+        REQUIRE(std::vector<rodsLong_t>(hierarchy.begin(), hierarchy.end()) == std::vector<rodsLong_t>{10, 11, 12});
+    }
+
+    SECTION("parents are added above the root resource")
+    {
+        resource_hierarchy hierarchy;
+        hierarchy.add_parent(12);
+        hierarchy.add_parent(11);
+        hierarchy.add_parent(10);
+
+        resource_hierarchy expected;
+        expected.add_child(10);
+        expected.add_child(11);
+        expected.add_child(12);
+
+        REQUIRE(hierarchy == expected);
+        REQUIRE(hierarchy.root() == 10);
+        REQUIRE(hierarchy.leaf() == 12);
+    }
+
+    SECTION("deep hierarchies are searched by resource id")
+    {
+        resource_hierarchy hierarchy;
+        for (rodsLong_t id = 100; id < 108; ++id) {
+            hierarchy.add_child(id);
+        }
+
+        REQUIRE(hierarchy.size() == 8);
+        REQUIRE(hierarchy.contains(100));
+        REQUIRE(hierarchy.contains(104));
+        REQUIRE(hierarchy.contains(107));
+        REQUIRE_FALSE(hierarchy.contains(108));
+    }
+
+    SECTION("hierarchies with different resources are not equal")
+    {
+        resource_hierarchy lhs;
+        lhs.add_child(10);
+        lhs.add_child(11);
+
+        resource_hierarchy rhs;
+        rhs.add_child(10);
+
+        REQUIRE(lhs != rhs);
+
+        rhs.add_child(12);
+        REQUIRE(lhs != rhs);
+    }
+
+    SECTION("hierarchies cannot exceed the maximum depth")
+    {
+        resource_hierarchy hierarchy;
+        for (std::size_t i = 0; i < resource_hierarchy::max_depth; ++i) {
+            hierarchy.add_child(i + 1);
+        }
+
+        REQUIRE_THROWS_AS(hierarchy.add_child(0), irods::exception);
+        REQUIRE_THROWS_AS(hierarchy.add_parent(0), irods::exception);
+        REQUIRE(hierarchy.size() == resource_hierarchy::max_depth);
+    }
+}
+
+TEST_CASE("resource hierarchy replica check cost", "[.][benchmark]")
+{
+    using clock_type = std::chrono::steady_clock;
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+
+    // A chain of passthru resources above a replication resource, with one replica per leaf.
+    constexpr int depth = 14;
+    constexpr int replicas = 16;
+    constexpr int opens = 100'000;
+
+    std::string chain;
+    resource_hierarchy chain_ids;
+    for (int i = 0; i < depth; ++i) {
+        chain += "pt" + std::to_string(i) + irods::hierarchy_parser::delimiter();
+        chain_ids.add_child(i + 1);
+    }
+
+    std::vector<std::string> replica_strings;
+    std::vector<resource_hierarchy> replica_ids;
+    for (int i = 0; i < replicas; ++i) {
+        replica_strings.push_back(chain + "ufs" + std::to_string(i));
+        replica_ids.push_back(chain_ids);
+        replica_ids.back().add_child(depth + 1 + i);
+    }
+
+    // Each open checks every replica for the resource the client asked for.
+    const std::string requested_name = "pt" + std::to_string(depth / 2);
+    const resource_hierarchy::value_type requested_id = depth / 2 + 1;
+
+    // Count the matches so that the checks cannot be optimized away.
+    long long matches = 0;
+
+    auto start = clock_type::now();
+    for (int i = 0; i < opens; ++i) {
+        for (const auto& r : replica_strings) {
+            matches += irods::hierarchy_parser{r}.resc_in_hier(requested_name);
+        }
+    }
+    const auto string_ns = duration_cast<nanoseconds>(clock_type::now() - start).count();
+
+    start = clock_type::now();
+    for (int i = 0; i < opens; ++i) {
+        for (const auto& r : replica_ids) {
+            matches -= r.contains(requested_id);
+        }
+    }
+    const auto id_ns = duration_cast<nanoseconds>(clock_type::now() - start).count();
+
+    REQUIRE(matches == 0);
+
+    WARN("hierarchy_parser:   " << static_cast<double>(string_ns) / opens << " ns per open");
+    WARN("resource_hierarchy: " << static_cast<double>(id_ns) / opens << " ns per open");
+}
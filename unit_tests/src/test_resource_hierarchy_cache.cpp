@@ -0,0 +1,132 @@
+#include "catch.hpp"
+
+#include "resource_hierarchy_cache.hpp"
+#include "irods_at_scope_exit.hpp"
+
+#include <string>
+#include <vector>
+
+namespace rhc = irods::experimental::resource_hierarchy_cache;
+
+namespace
+{
+    auto make_resource(rodsLong_t _id, const std::string& _name, const std::string& _parent = "") -> rhc::resource_info
+    {
+        rhc::resource_info info{};
+        info.id = _id;
+        info.name = _name;
+        info.zone = "tempZone";
+        info.type = _parent.empty() ? "passthru" : "unixfilesystem";
+        info.location = "localhost";
+        info.vault_path = "/tmp/" + _name;
+        info.parent = _parent;
+        return info;
+    }
+
+    // root (10) -> pt (11) -> ufs0 (12), root (10) -> ufs1 (13) and demoResc (14).
+    auto make_resources() -> std::vector<rhc::resource_info>
+    {
+        return {make_resource(12, "ufs0", "11"),
+                make_resource(10, "root"),
+                make_resource(11, "pt", "10"),
+                make_resource(13, "ufs1", "10"),
+                make_resource(14, "demoResc")};
+    }
+} // anonymous namespace
+
+TEST_CASE("resource_hierarchy_cache")
+{
+    // Loading is harmless before the cache is initialized.
+    REQUIRE_FALSE(rhc::load());
+
+    rhc::init("irods_resource_hierarchy_cache_test", 100'000);
+    irods::at_scope_exit cleanup{[] { rhc::deinit(); }};
+
+    REQUIRE_FALSE(rhc::load());
+
+    SECTION("snapshots compute the hierarchy of every resource")
+    {
+        const rhc::snapshot snapshot{7, make_resources()};
+
+        REQUIRE(snapshot.catalog_version() == 7);
+        REQUIRE(snapshot.resources().size() == 5);
+
+        const auto leaf = snapshot.index_of("ufs0");
+        REQUIRE(leaf > -1);
+        REQUIRE(snapshot.index_of(rodsLong_t{12}) == leaf);
+        REQUIRE(snapshot.hierarchy(leaf) == "root;pt;ufs0");
+        REQUIRE(snapshot.hierarchy(snapshot.index_of("ufs1")) == "root;ufs1");
+        REQUIRE(snapshot.hierarchy(snapshot.index_of("demoResc")) == "demoResc");
+
+        const auto pt = snapshot.index_of("pt");
+        const auto root = snapshot.index_of("root");
+        REQUIRE(snapshot.parent_of(leaf) == pt);
+        REQUIRE(snapshot.parent_of(root) == -1);
+        REQUIRE(snapshot.path_to_root(leaf) == std::vector<int>{leaf, pt, root});
+
+        REQUIRE(snapshot.index_of("missing") == -1);
+        REQUIRE(snapshot.index_of(rodsLong_t{99}) == -1);
+    }
+
+    SECTION("published snapshots are shared")
+    {
+        const rhc::snapshot snapshot{7, make_resources()};
+        REQUIRE(rhc::publish(snapshot, rhc::invalidation_count()));
+
+        const auto loaded = rhc::load();
+        REQUIRE(loaded);
+        REQUIRE(loaded->catalog_version() == 7);
+        REQUIRE(loaded->resources().size() == 5);
+
+        const auto leaf = loaded->index_of("ufs0");
+        REQUIRE(leaf > -1);
+        REQUIRE(loaded->hierarchy(leaf) == "root;pt;ufs0");
+        REQUIRE(loaded->path_to_root(leaf).size() == 3);
+
+        const auto& info = loaded->resources()[leaf];
+        REQUIRE(info.id == 12);
+        REQUIRE(info.zone == "tempZone");
+        REQUIRE(info.type == "unixfilesystem");
+        REQUIRE(info.vault_path == "/tmp/ufs0");
+        REQUIRE(info.parent == "11");
+    }
+
+    SECTION("invalidation discards the published snapshot")
+    {
+        REQUIRE(rhc::publish(rhc::snapshot{7, make_resources()}, rhc::invalidation_count()));
+        REQUIRE(rhc::load());
+
+        rhc::invalidate();
+        REQUIRE_FALSE(rhc::load());
+    }
+
+    SECTION("snapshots read before an invalidation are not published")
+    {
+        const auto invalidations = rhc::invalidation_count();
+        rhc::invalidate();
+
+        REQUIRE_FALSE(rhc::publish(rhc::snapshot{7, make_resources()}, invalidations));
+        REQUIRE_FALSE(rhc::load());
+    }
+
+    SECTION("snapshots that do not fit are not published")
+    {
+        std::vector<rhc::resource_info> resources;
+        for (int i = 0; i < 1000; ++i) {
+            resources.push_back(make_resource(i + 1, std::string(100, 'a') + std::to_string(i)));
+        }
+
+        REQUIRE_FALSE(rhc::publish(rhc::snapshot{7, std::move(resources)}, rhc::invalidation_count()));
+        REQUIRE_FALSE(rhc::load());
+    }
+
+    SECTION("verification only applies to the published catalog version")
+    {
+        REQUIRE(rhc::publish(rhc::snapshot{7, make_resources()}, rhc::invalidation_count()));
+        REQUIRE(rhc::seconds_since_verification() <= 1);
+
+        rhc::mark_verified(8);
+        rhc::mark_verified(7);
+        REQUIRE(rhc::seconds_since_verification() <= 1);
+    }
+}
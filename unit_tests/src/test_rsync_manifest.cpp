@@ -0,0 +1,106 @@
+#include "catch.hpp"
+
+#include "rodsErrorTable.h"
+#include "rsync_manifest.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <string>
+
+namespace fs = boost::filesystem;
+namespace rm = irods::experimental::rsync_manifest;
+
+namespace
+{
+    auto make_local(rodsLong_t _size, std::int64_t _mtime) -> rm::local_entry
+    {
+        return {"/tmp/f", "/tempZone/home/rods/f", _size, _mtime, 0600};
+    }
+
+    auto write_file(const fs::path& _path, const std::string& _contents) -> void
+    {
+        std::ofstream{_path.string()} << _contents;
+    }
+} // anonymous namespace
+
+TEST_CASE("rsync_manifest classify")
+{
+    const rm::remote_entry with_checksum{10, 1000, "sha2:abc"};
+    const rm::remote_entry without_checksum{10, 1000, ""};
+
+    SECTION("missing data objects are put")
+    {
+        CHECK(rm::classify(make_local(10, 500), nullptr, false) == rm::action::put);
+        CHECK(rm::classify(make_local(10, 500), nullptr, true) == rm::action::put);
+    }
+
+    SECTION("data objects of a different size are put")
+    {
+        CHECK(rm::classify(make_local(11, 500), &with_checksum, false) == rm::action::put);
+        CHECK(rm::classify(make_local(11, 500), &with_checksum, true) == rm::action::put);
+    }
+
+    SECTION("data objects not older than the local file match without hashing")
+    {
+        CHECK(rm::classify(make_local(10, 500), &with_checksum, false) == rm::action::none);
+        CHECK(rm::classify(make_local(10, 1000), &without_checksum, false) == rm::action::none);
+    }
+
+    SECTION("newer local files are compared by checksum")
+    {
+        CHECK(rm::classify(make_local(10, 2000), &with_checksum, false) == rm::action::compare_checksum);
+        CHECK(rm::classify(make_local(10, 2000), &without_checksum, false) == rm::action::sync_on_server);
+    }
+
+    SECTION("size only comparisons ignore modification times")
+    {
+        CHECK(rm::classify(make_local(10, 2000), &with_checksum, true) == rm::action::none);
+    }
+}
+
+TEST_CASE("rsync_manifest scan")
+{
+    const auto root = fs::temp_directory_path() / fs::unique_path("irods_rsync_manifest_%%%%-%%%%");
+    fs::create_directories(root / "a" / "b");
+    fs::create_directories(root / "c");
+
+    write_file(root / "top", "0123456789");
+    write_file(root / "a" / "one", "1");
+    write_file(root / "a" / "b" / "two", "22");
+    write_file(root / "c" / "three", "333");
+    fs::create_symlink(root / "top", root / "c" / "link");
+
+    rodsArguments_t args{};
+    args.recursive = True;
+
+    const auto result = rm::scan(args, root.string(), "/tempZone/home/rods/x", 4);
+
+    CHECK(result.status == 0);
+
+    REQUIRE(result.collections.size() == 3);
+    CHECK(result.collections[0] == "/tempZone/home/rods/x/a");
+    CHECK(result.collections[1] == "/tempZone/home/rods/x/a/b");
+    CHECK(result.collections[2] == "/tempZone/home/rods/x/c");
+
+    REQUIRE(result.files.size() == 5);
+    CHECK(result.files[0].logical_path == "/tempZone/home/rods/x/a/b/two");
+    CHECK(result.files[0].size == 2);
+    CHECK(result.files[1].logical_path == "/tempZone/home/rods/x/a/one");
+    CHECK(result.files[2].logical_path == "/tempZone/home/rods/x/c/link");
+    CHECK(result.files[2].path == (root / "top").string());
+    CHECK(result.files[2].size == 10);
+    CHECK(result.files[3].logical_path == "/tempZone/home/rods/x/c/three");
+    CHECK(result.files[4].logical_path == "/tempZone/home/rods/x/top");
+    CHECK(result.files[4].mtime == fs::last_write_time(root / "top"));
+
+    SECTION("symbolic links are skipped with --link")
+    {
+        args.link = True;
+
+        const auto linked = rm::scan(args, root.string(), "/tempZone/home/rods/x", 2);
+        CHECK(linked.files.size() == 4);
+    }
+
+    fs::remove_all(root);
+}
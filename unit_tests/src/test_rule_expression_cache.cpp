@@ -0,0 +1,123 @@
+#include "catch.hpp"
+
+#include "client_connection.hpp"
+#include "exec_rule_expression.h"
+#include "irods_at_scope_exit.hpp"
+#include "irods_re_structs.hpp"
+#include "msParam.h"
+#include "packStruct.h"
+#include "rcGlobalExtern.h"
+#include "rcMisc.h"
+#include "rodsClient.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace
+{
+    const char* const instance_name = "irods_rule_engine_plugin-irods_rule_language-instance";
+
+    // Resembles the body of a repeating delay rule.
+    const std::string delay_rule_text = "*count = 0;"
+                                        "for (*i = 0; *i < int(*n); *i = *i + 1) { *count = *count + 1; }"
+                                        "if (*count > 5) { fail(-130000); }";
+
+    // Packs the rule execution context sent along with every rule by the delay server.
+    auto pack_rei(const rodsEnv& _env) -> BytesBuf*
+    {
+        UserInfo user{};
+        std::strncpy(user.userName, _env.rodsUserName, sizeof(UserInfo::userName) - 1);
+        std::strncpy(user.rodsZone, _env.rodsZone, sizeof(UserInfo::rodsZone) - 1);
+
+        RuleExecInfo rei{};
+        std::strncpy(rei.pluginInstanceName, instance_name, sizeof(RuleExecInfo::pluginInstanceName) - 1);
+        rei.uoic = &user;
+        rei.uoip = &user;
+
+        RuleExecInfoAndArg rei_and_arg{&rei, {0, nullptr}};
+
+        BytesBuf* packed_rei = nullptr;
+        REQUIRE(pack_struct(&rei_and_arg, &packed_rei, "ReiAndArg_PI", RodsPackTable, 0, NATIVE_PROT, nullptr) >= 0);
+
+        return packed_rei;
+    } // pack_rei
+
+    // Executes a rule the way the delay server does, i.e. with *n bound to _n.
+    auto exec_rule_expression(RcComm& _comm, BytesBuf& _packed_rei, const std::string& _rule_text, const char* _n)
+        -> int
+    {
+        MsParamArray params{};
+        irods::at_scope_exit clear_params{[&params] { clearMsParamArray(&params, 1); }};
+        addMsParam(&params, "*n", STR_MS_T, strdup(_n), nullptr);
+
+        ExecRuleExpression input{};
+        input.rule_text_.buf = const_cast<char*>(_rule_text.c_str());
+        input.rule_text_.len = static_cast<int>(_rule_text.size()) + 1;
+        input.packed_rei_ = _packed_rei;
+        input.params_ = &params;
+
+        return rcExecRuleExpression(&_comm, &input);
+    } // exec_rule_expression
+} // anonymous namespace
+
+TEST_CASE("rule expression cache")
+{
+    load_client_api_plugins();
+
+    rodsEnv env;
+    _getRodsEnv(env);
+
+    BytesBuf* packed_rei = pack_rei(env);
+    irods::at_scope_exit free_packed_rei{[packed_rei] { freeBBuf(packed_rei); }};
+
+    // All executions must happen in the same agent to exercise the cache.
+    irods::experimental::client_connection conn;
+    RcComm& comm = static_cast<RcComm&>(conn);
+
+    SECTION("cached expressions are evaluated against the current variables")
+    {
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(exec_rule_expression(comm, *packed_rei, delay_rule_text, "3") >= 0);
+            REQUIRE(exec_rule_expression(comm, *packed_rei, delay_rule_text, "7") < 0);
+        }
+    }
+
+    SECTION("syntax errors are reported on every execution")
+    {
+        const std::string invalid_rule_text = "*count = ;";
+
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(exec_rule_expression(comm, *packed_rei, invalid_rule_text, "0") < 0);
+        }
+    }
+}
+
+TEST_CASE("rule expression cache benchmark", "[.][benchmark]")
+{
+    using std::chrono::duration_cast;
+    using std::chrono::milliseconds;
+
+    constexpr int iterations = 10'000;
+
+    load_client_api_plugins();
+
+    rodsEnv env;
+    _getRodsEnv(env);
+
+    BytesBuf* packed_rei = pack_rei(env);
+    irods::at_scope_exit free_packed_rei{[packed_rei] { freeBBuf(packed_rei); }};
+
+    irods::experimental::client_connection conn;
+    RcComm& comm = static_cast<RcComm&>(conn);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; ++i) {
+        REQUIRE(exec_rule_expression(comm, *packed_rei, delay_rule_text, "3") >= 0);
+    }
+
+    const auto elapsed = duration_cast<milliseconds>(std::chrono::steady_clock::now() - start).count();
+    WARN(iterations << " executions of a delay rule took " << elapsed << " ms");
+}
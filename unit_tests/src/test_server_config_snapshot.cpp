@@ -0,0 +1,113 @@
+#include "catch.hpp"
+
+#include "irods_at_scope_exit.hpp"
+#include "irods_configuration_keywords.hpp"
+#include "irods_configuration_parser.hpp"
+#include "irods_exception.hpp"
+#include "irods_server_properties.hpp"
+#include "rodsErrorTable.h"
+
+#include <chrono>
+#include <string>
+
+namespace
+{
+    using key_path_t = irods::configuration_parser::key_path_t;
+
+    const key_path_t trans_buffer_size_key{irods::CFG_ADVANCED_SETTINGS_KW, irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS};
+} // anonymous namespace
+
+TEST_CASE("server config snapshot")
+{
+    SECTION("snapshot matches the property map")
+    {
+        const auto snapshot = irods::get_server_config_snapshot();
+
+        REQUIRE(snapshot->advanced_settings.transfer_buffer_size_for_parallel_transfer_in_megabytes.get() ==
+                irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS));
+        REQUIRE(snapshot->advanced_settings.transfer_chunk_size_for_parallel_transfer_in_megabytes.get() ==
+                irods::get_advanced_setting<const int>(irods::CFG_TRANS_CHUNK_SIZE_PARA_TRANS));
+        REQUIRE(snapshot->advanced_settings.maximum_size_for_single_buffer_in_megabytes.get() ==
+                irods::get_advanced_setting<const int>(irods::CFG_MAX_SIZE_FOR_SINGLE_BUFFER));
+        REQUIRE(snapshot->advanced_settings.default_number_of_transfer_threads.get() ==
+                irods::get_advanced_setting<const int>(irods::CFG_DEF_NUMBER_TRANSFER_THREADS));
+        REQUIRE(snapshot->default_hash_scheme.get() ==
+                irods::get_server_property<const std::string>(irods::CFG_DEFAULT_HASH_SCHEME_KW));
+        REQUIRE(snapshot->zone_name.get() ==
+                irods::get_server_property<const std::string>(irods::CFG_ZONE_NAME));
+    }
+
+    SECTION("changing a property does not publish a new snapshot")
+    {
+        const auto original = irods::get_server_property<const int>(trans_buffer_size_key);
+        irods::at_scope_exit restore{[original] { irods::set_server_property<int>(trans_buffer_size_key, original); }};
+
+        const auto before = irods::get_server_config_snapshot();
+
+        irods::set_server_property<int>(trans_buffer_size_key, original + 1);
+
+        const auto after = irods::get_server_config_snapshot();
+        REQUIRE(after == before);
+        REQUIRE(after->advanced_settings.transfer_buffer_size_for_parallel_transfer_in_megabytes.get() == original);
+    }
+
+    SECTION("reloading the configuration publishes a new snapshot")
+    {
+        const auto before = irods::get_server_config_snapshot();
+
+        irods::server_properties::instance().capture();
+
+        const auto after = irods::get_server_config_snapshot();
+        REQUIRE(after != before);
+        REQUIRE(after->zone_name.get() == before->zone_name.get());
+
+        // Snapshots held by readers remain valid after a new one is published.
+        REQUIRE(before->advanced_settings.transfer_buffer_size_for_parallel_transfer_in_megabytes.has_value());
+    }
+
+    SECTION("missing properties report the error of the property map")
+    {
+        irods::configuration_parser empty;
+        const auto snapshot = irods::server_config_snapshot::read(empty);
+
+        REQUIRE_FALSE(snapshot.default_hash_scheme.has_value());
+        REQUIRE(snapshot.default_hash_scheme.value_or("md5") == "md5");
+
+        try {
+            snapshot.advanced_settings.transfer_buffer_size_for_parallel_transfer_in_megabytes.get();
+            FAIL("get() did not throw");
+        }
+        catch (const irods::exception& e) {
+            REQUIRE(e.code() == KEY_NOT_FOUND);
+        }
+    }
+}
+
+TEST_CASE("server config snapshot lookup cost", "[.][benchmark]")
+{
+    using clock_type = std::chrono::steady_clock;
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+
+    constexpr int iterations = 1'000'000;
+
+    // Accumulate the values so that the lookups cannot be optimized away.
+    long long sum = 0;
+
+    auto start = clock_type::now();
+    for (int i = 0; i < iterations; ++i) {
+        sum += irods::get_advanced_setting<const int>(irods::CFG_TRANS_BUFFER_SIZE_FOR_PARA_TRANS);
+    }
+    const auto property_map_ns = duration_cast<nanoseconds>(clock_type::now() - start).count();
+
+    start = clock_type::now();
+    for (int i = 0; i < iterations; ++i) {
+        sum -= irods::get_server_config_snapshot()->advanced_settings.transfer_buffer_size_for_parallel_transfer_in_megabytes.get();
+    }
+    const auto snapshot_ns = duration_cast<nanoseconds>(clock_type::now() - start).count();
+
+    REQUIRE(sum == 0);
+
+    WARN("get_advanced_setting:       " << static_cast<double>(property_map_ns) / iterations << " ns per lookup");
+    WARN("get_server_config_snapshot: " << static_cast<double>(snapshot_ns) / iterations << " ns per lookup");
+}
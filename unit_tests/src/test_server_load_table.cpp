@@ -0,0 +1,68 @@
+#include "catch.hpp"
+
+#include "server_load_table.hpp"
+#include "irods_at_scope_exit.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace slt = irods::experimental::server_load_table;
+
+using namespace std::chrono_literals;
+
+TEST_CASE("server_load_table")
+{
+    // Lookups are harmless before the table is initialized.
+    REQUIRE_FALSE(slt::lookup("rescA", 60s));
+
+    slt::init("irods_server_load_table_test", 100'000);
+    irods::at_scope_exit cleanup{[] { slt::deinit(); }};
+
+    SECTION("insert / update / lookup")
+    {
+        slt::load_sample sample{};
+        sample.active_agents = 3;
+        sample.io_bytes_per_second = 4096;
+        sample.disk_queue_depth = 2;
+        sample.free_space = 1'000'000;
+
+        REQUIRE(slt::insert_or_assign("rescA", sample));
+
+        auto result = slt::lookup("rescA", 60s);
+        REQUIRE(result);
+        REQUIRE(result->active_agents == 3);
+        REQUIRE(result->io_bytes_per_second == 4096);
+        REQUIRE(result->disk_queue_depth == 2);
+        REQUIRE(result->free_space == 1'000'000);
+        REQUIRE(result->timestamp > 0);
+
+        sample.active_agents = 7;
+        REQUIRE_FALSE(slt::insert_or_assign("rescA", sample));
+
+        result = slt::lookup("rescA", 60s);
+        REQUIRE(result);
+        REQUIRE(result->active_agents == 7);
+
+        REQUIRE_FALSE(slt::lookup("rescB", 60s));
+    }
+
+    SECTION("samples older than the maximum age are ignored and erased")
+    {
+        REQUIRE(slt::insert_or_assign("rescA", slt::load_sample{}));
+        REQUIRE(slt::insert_or_assign("rescB", slt::load_sample{}));
+        REQUIRE(slt::size() == 2);
+
+        std::this_thread::sleep_for(2s);
+        REQUIRE(slt::insert_or_assign("rescC", slt::load_sample{}));
+
+        REQUIRE_FALSE(slt::lookup("rescA", 1s));
+        REQUIRE(slt::lookup("rescA", 60s));
+        REQUIRE(slt::lookup("rescC", 1s));
+
+        slt::erase_expired_entries(1s);
+        REQUIRE(slt::size() == 1);
+        REQUIRE_FALSE(slt::lookup("rescA", 60s));
+        REQUIRE_FALSE(slt::lookup("rescB", 60s));
+        REQUIRE(slt::lookup("rescC", 60s));
+    }
+}
@@ -0,0 +1,318 @@
+#include "catch.hpp"
+
+#include "rcGlobalExtern.h"
+#include "rodsErrorTable.h"
+#include "transfer_scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace ix = irods::experimental;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    constexpr rodsLong_t mib = 1024 * 1024;
+
+    // Connections that are never used to talk to a server. The scheduler only hands
+    // them to the transfer functions.
+    struct fake_connections
+    {
+        rcComm_t main{};
+        rcComm_t* main_ptr = &main;
+        std::vector<rcComm_t> workers;
+
+        explicit fake_connections(int _count)
+            : workers(_count)
+        {
+        }
+
+        auto worker_pointers() -> std::vector<rcComm_t*>
+        {
+            std::vector<rcComm_t*> v;
+            for (auto& w : workers) {
+                v.push_back(&w);
+            }
+            return v;
+        }
+    }; // struct fake_connections
+
+    auto make_options(int _max_files, int _max_threads) -> ix::transfer_scheduler::options
+    {
+        ix::transfer_scheduler::options opts;
+        opts.max_files = _max_files;
+        opts.max_threads = _max_threads;
+        opts.max_size_for_single_buffer = 32 * mib;
+        opts.default_threads = 4;
+        return opts;
+    }
+
+    operProgress_t* reported_progress = nullptr;
+    int progress_reports = 0;
+
+    void record_progress(operProgress_t* _progress)
+    {
+        reported_progress = _progress;
+        ++progress_reports;
+    }
+} // anonymous namespace
+
+TEST_CASE("transfer_scheduler thread cost")
+{
+    auto opts = make_options(4, 16);
+
+    CHECK(ix::transfer_scheduler::thread_cost(opts, 0) == 1);
+    CHECK(ix::transfer_scheduler::thread_cost(opts, 32 * mib) == 1);
+    CHECK(ix::transfer_scheduler::thread_cost(opts, 33 * mib) == 1);
+    CHECK(ix::transfer_scheduler::thread_cost(opts, 100 * mib) == 3);
+    CHECK(ix::transfer_scheduler::thread_cost(opts, 1000 * mib) == 4);
+
+    opts.requested_threads = 8;
+    CHECK(ix::transfer_scheduler::thread_cost(opts, 100 * mib) == 8);
+
+    opts.requested_threads = NO_THREADING;
+    CHECK(ix::transfer_scheduler::thread_cost(opts, 1000 * mib) == 1);
+}
+
+TEST_CASE("transfer_scheduler runs synchronously by default")
+{
+    fake_connections conns{0};
+
+    auto opts = make_options(1, 1);
+    opts.requested_threads = 3;
+
+    ix::transfer_scheduler scheduler{&conns.main_ptr, opts};
+    REQUIRE_FALSE(scheduler.concurrent());
+
+    int commits = 0;
+    const auto status = scheduler.schedule(
+        100 * mib,
+        [&](rcComm_t& _conn, int _num_threads) {
+            CHECK(&_conn == &conns.main);
+            CHECK(_num_threads == 3);
+            return 0;
+        },
+        [&] { return ++commits; });
+
+    CHECK(status == 1);
+    CHECK(commits == 1);
+
+    SECTION("a failed transfer is not committed")
+    {
+        CHECK(scheduler.schedule(1, [](auto&, int) { return SYS_INTERNAL_ERR; }, [&] { return ++commits; }) == SYS_INTERNAL_ERR);
+        CHECK(commits == 1);
+        CHECK(scheduler.wait() == 0);
+    }
+}
+
+TEST_CASE("transfer_scheduler runs files concurrently on worker connections")
+{
+    fake_connections conns{4};
+    ix::transfer_scheduler scheduler{&conns.main_ptr, conns.worker_pointers(), make_options(4, 16)};
+    REQUIRE(scheduler.concurrent());
+
+    std::mutex mutex;
+    std::set<rcComm_t*> used;
+    std::atomic<int> in_flight{};
+    std::atomic<int> max_in_flight{};
+
+    for (int i = 0; i < 32; ++i) {
+        REQUIRE(scheduler.schedule(mib, [&](rcComm_t& _conn, int) {
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                used.insert(&_conn);
+            }
+
+            const int n = ++in_flight;
+            int max = max_in_flight.load();
+            while (n > max && !max_in_flight.compare_exchange_weak(max, n));
+
+            std::this_thread::sleep_for(5ms);
+            --in_flight;
+            return 0;
+        }) == 0);
+    }
+
+    CHECK(scheduler.wait() == 0);
+    CHECK(max_in_flight.load() > 1);
+    CHECK(max_in_flight.load() <= 4);
+    CHECK(used.count(&conns.main) == 0);
+    CHECK(used.size() > 1);
+}
+
+TEST_CASE("transfer_scheduler splits large files within the thread budget")
+{
+    fake_connections conns{4};
+    ix::transfer_scheduler scheduler{&conns.main_ptr, conns.worker_pointers(), make_options(4, 6)};
+
+    std::atomic<int> threads_in_use{};
+    std::atomic<int> max_threads_in_use{};
+    std::mutex mutex;
+    std::vector<int> granted;
+
+    for (int i = 0; i < 16; ++i) {
+        REQUIRE(scheduler.schedule(1000 * mib, [&](rcComm_t&, int _num_threads) {
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                granted.push_back(_num_threads);
+            }
+
+            const int n = threads_in_use += _num_threads;
+            int max = max_threads_in_use.load();
+            while (n > max && !max_threads_in_use.compare_exchange_weak(max, n));
+
+            std::this_thread::sleep_for(5ms);
+            threads_in_use -= _num_threads;
+            return 0;
+        }) == 0);
+    }
+
+    CHECK(scheduler.wait() == 0);
+    CHECK(max_threads_in_use.load() <= 6);
+    CHECK(granted.size() == 16);
+    CHECK(*std::max_element(granted.begin(), granted.end()) == 4);
+    CHECK(*std::min_element(granted.begin(), granted.end()) >= 1);
+
+    SECTION("small files keep the requested number of threads")
+    {
+        int num_threads = -2;
+        scheduler.schedule(mib, [&](rcComm_t&, int _num_threads) {
+            num_threads = _num_threads;
+            return 0;
+        });
+
+        CHECK(scheduler.wait() == 0);
+        CHECK(num_threads == 0);
+    }
+}
+
+TEST_CASE("transfer_scheduler commits in order up to the first failure")
+{
+    fake_connections conns{4};
+    ix::transfer_scheduler scheduler{&conns.main_ptr, conns.worker_pointers(), make_options(4, 4)};
+
+    const auto main_thread = std::this_thread::get_id();
+    std::vector<int> committed;
+
+    for (int i = 0; i < 20; ++i) {
+        scheduler.schedule(
+            mib,
+            [i](rcComm_t&, int) {
+                // Later files finish first.
+                std::this_thread::sleep_for(std::chrono::milliseconds(20 - i));
+                return 12 == i ? SYS_INTERNAL_ERR : 0;
+            },
+            [&, i] {
+                CHECK(std::this_thread::get_id() == main_thread);
+                committed.push_back(i);
+                return 0;
+            });
+    }
+
+    CHECK(scheduler.wait() == SYS_INTERNAL_ERR);
+
+    REQUIRE(committed.size() == 12);
+    for (int i = 0; i < 12; ++i) {
+        CHECK(committed[i] == i);
+    }
+
+    SECTION("the scheduler is usable after wait")
+    {
+        scheduler.schedule(mib, [](rcComm_t&, int) { return 0; }, [&] { committed.push_back(100); return 0; });
+        CHECK(scheduler.wait() == 0);
+        CHECK(committed.back() == 100);
+    }
+}
+
+TEST_CASE("transfer_scheduler stops after a failure when asked to")
+{
+    fake_connections conns{2};
+
+    auto opts = make_options(2, 2);
+    opts.stop_on_error = true;
+
+    ix::transfer_scheduler scheduler{&conns.main_ptr, conns.worker_pointers(), opts};
+
+    std::atomic<int> transfers{};
+    int status = 0;
+
+    for (int i = 0; i < 1000 && 0 == status; ++i) {
+        status = scheduler.schedule(mib, [&, i](rcComm_t&, int) {
+            ++transfers;
+            return 3 == i ? SYS_INTERNAL_ERR : 0;
+        });
+
+        if (0 == status) {
+            std::this_thread::sleep_for(1ms);
+        }
+    }
+
+    CHECK(status == SYS_INTERNAL_ERR);
+    CHECK(scheduler.wait() == SYS_INTERNAL_ERR);
+    CHECK(transfers.load() < 1000);
+}
+
+TEST_CASE("transfer_scheduler limits bandwidth")
+{
+    fake_connections conns{4};
+
+    auto opts = make_options(4, 4);
+    opts.max_bytes_per_second = 10 * mib;
+
+    ix::transfer_scheduler scheduler{&conns.main_ptr, conns.worker_pointers(), opts};
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // 5 MiB at 10 MiB/s. The first file starts immediately, so the last one starts
+    // after the first four have used up 400 ms.
+    for (int i = 0; i < 5; ++i) {
+        scheduler.schedule(mib, [](rcComm_t&, int) { return 0; });
+    }
+
+    CHECK(scheduler.wait() == 0);
+    CHECK(std::chrono::steady_clock::now() - start >= 390ms);
+}
+
+TEST_CASE("transfer_scheduler aggregates progress")
+{
+    fake_connections conns{2};
+    conns.main.operProgress.totalNumFiles = 10;
+
+    auto* saved_callback = gGuiProgressCB;
+    gGuiProgressCB = record_progress;
+    progress_reports = 0;
+
+    {
+        ix::transfer_scheduler scheduler{&conns.main_ptr, conns.worker_pointers(), make_options(2, 2)};
+        CHECK(gGuiProgressCB != record_progress);
+
+        for (int i = 0; i < 10; ++i) {
+            scheduler.schedule(100, [](rcComm_t& _conn, int) {
+                // What putFileUtil and getDataObjUtil report when a file starts.
+                std::strcpy(_conn.operProgress.curFileName, "file");
+                _conn.operProgress.curFileSize = 100;
+                gGuiProgressCB(&_conn.operProgress);
+                return 0;
+            });
+        }
+
+        CHECK(scheduler.wait() == 0);
+    }
+
+    CHECK(gGuiProgressCB == record_progress);
+    gGuiProgressCB = saved_callback;
+
+    CHECK(progress_reports == 10);
+    CHECK(reported_progress == &conns.main.operProgress);
+    CHECK(std::string{conns.main.operProgress.curFileName} == "file");
+    CHECK(conns.main.operProgress.totalNumFiles == 10);
+    CHECK(conns.main.operProgress.totalNumFilesDone == 10);
+    CHECK(conns.main.operProgress.totalFileSizeDone == 1000);
+}